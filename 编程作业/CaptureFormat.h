@@ -0,0 +1,135 @@
+//***************************************************************************************
+// CaptureFormat.h
+//
+// 帧命令流捕获文件格式。文件由一个 CaptureHeader 加上连续的命令记录组成，
+// 每条记录以 CaptureCommandHeader 开头，记录总长度按 8 字节对齐，
+// 回放时可以直接在内存映射的数据上遍历，缓冲写入的数据也直接从映射中读取。
+// 所有字段均为小端序。
+//***************************************************************************************
+
+#ifndef CAPTUREFORMAT_H
+#define CAPTUREFORMAT_H
+
+#include <cstdint>
+
+static const uint32_t kCaptureMagic = 0x50434647;      // "GFCP"
+static const uint32_t kCaptureVersion = 2;
+static const uint32_t kCaptureMinVersion = 1;          // 版本 1 没有 SetVertexFormat，整段都是 Float 格式
+static const uint32_t kCaptureMaxVertexBuffers = 4;
+static const uint32_t kCaptureMaxBuffers = 65536;      // 回放时接受的捕获句柄上限（句柄从 1 开始连续编号）
+
+struct CaptureHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frameCount;        // 记录中 Present 的次数
+    uint32_t commandCount;
+    uint64_t commandBytes;      // 文件头之后所有命令记录的总字节数
+};
+
+enum class CaptureCommandType : uint16_t
+{
+    CreateBuffer = 1,
+    WriteBuffer,
+    SetVertexBuffers,
+    SetIndexBuffer,
+    SetConstantBuffer,
+    DrawIndexedInstanced,
+    Clear,
+    Present,
+    InsertFence,
+    SetVertexFormat             // 版本 2 起
+};
+
+struct CaptureCommandHeader
+{
+    uint16_t type;              // CaptureCommandType
+    uint16_t reserved;
+    uint32_t size;              // 整条记录的字节数（含本头部），8 的倍数
+};
+
+// 紧随其后为 byteWidth 字节的初始数据（hasInitData 不为 0 时）
+struct CaptureCreateBuffer
+{
+    uint32_t handle;            // 捕获时的句柄，回放时重新映射
+    uint32_t type;              // BufferType
+    uint32_t usage;             // BufferUsage
+    uint32_t byteWidth;
+    uint32_t hasInitData;
+    uint32_t pad;
+};
+
+// 紧随其后为 writeCount 个 CaptureWriteRange，然后依次为各段数据（每段按 8 字节对齐）
+struct CaptureWriteBuffer
+{
+    uint32_t handle;
+    uint32_t mode;              // MapMode
+    uint32_t writeCount;
+    uint32_t pad;
+};
+
+struct CaptureWriteRange
+{
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct CaptureSetVertexBuffers
+{
+    uint32_t startSlot;
+    uint32_t count;
+    uint32_t handles[kCaptureMaxVertexBuffers];
+    uint32_t strides[kCaptureMaxVertexBuffers];
+    uint32_t offsets[kCaptureMaxVertexBuffers];
+};
+
+struct CaptureSetIndexBuffer
+{
+    uint32_t handle;
+    uint32_t pad;
+};
+
+struct CaptureSetConstantBuffer
+{
+    uint32_t slot;
+    uint32_t handle;
+    uint32_t firstConstant;
+    uint32_t numConstants;
+};
+
+struct CaptureSetVertexFormat
+{
+    uint32_t format;            // VertexFormat
+    uint32_t pad;
+};
+
+struct CaptureDrawIndexedInstanced
+{
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t startIndex;
+    int32_t  baseVertex;
+    uint32_t startInstance;
+    uint32_t pad;
+};
+
+struct CaptureClear
+{
+    float color[4];
+};
+
+struct CaptureInsertFence
+{
+    uint64_t fence;
+};
+
+static_assert(sizeof(CaptureHeader) == 24, "CaptureHeader 布局变化需要修改版本号");
+static_assert(sizeof(CaptureCommandHeader) == 8, "CaptureCommandHeader 布局变化需要修改版本号");
+
+// 记录长度按 8 字节对齐
+inline uint32_t CaptureAlign(uint32_t size)
+{
+    return (size + 7u) & ~7u;
+}
+
+#endif
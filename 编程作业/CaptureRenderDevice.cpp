@@ -0,0 +1,461 @@
+#include "CaptureRenderDevice.h"
+#include <cassert>
+#include <cstring>
+
+static CaptureSetVertexBuffers MakeVertexBuffersBody(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+    const uint32_t* pStrides, const uint32_t* pOffsets)
+{
+    CaptureSetVertexBuffers body{};
+    body.startSlot = startSlot;
+    body.count = count;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        body.handles[i] = pBuffers[i];
+        body.strides[i] = pStrides[i];
+        body.offsets[i] = pOffsets[i];
+    }
+    return body;
+}
+
+CaptureRenderDevice::CaptureRenderDevice(RenderDevice* pInner)
+    : m_pInner(pInner), m_VertexBuffers(), m_ConstantBuffers(), m_Header()
+{
+    assert(pInner);
+    for (uint32_t i = 0; i < kMaxConstantSlots; ++i)
+        m_ConstantBuffers[i].slot = i;
+}
+
+CaptureRenderDevice::~CaptureRenderDevice()
+{
+    EndCapture();
+}
+
+bool CaptureRenderDevice::BeginCapture(const char* path, uint32_t frameCount)
+{
+    assert(frameCount > 0);
+    EndCapture();
+
+    m_File.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_File)
+        return false;
+
+    m_Header = CaptureHeader();
+    m_Header.magic = kCaptureMagic;
+    m_Header.version = kCaptureVersion;
+    m_File.write(reinterpret_cast<const char*>(&m_Header), sizeof(m_Header));
+
+    // 先写出已创建的缓冲，再写出当前绑定状态
+    m_File.write(reinterpret_cast<const char*>(m_ResourceRecords.data()), m_ResourceRecords.size());
+    m_Header.commandCount += m_ResourceRecordCount;
+    m_Header.commandBytes += m_ResourceRecords.size();
+
+    m_Capturing = true;
+    m_FramesRemaining = frameCount;
+    RecordState();
+    return true;
+}
+
+void CaptureRenderDevice::EndCapture()
+{
+    if (!m_Capturing)
+        return;
+
+    // 回到开头写入最终的计数
+    m_File.seekp(0);
+    m_File.write(reinterpret_cast<const char*>(&m_Header), sizeof(m_Header));
+    m_File.close();
+    m_Capturing = false;
+    m_FramesRemaining = 0;
+}
+
+bool CaptureRenderDevice::IsCapturing() const
+{
+    return m_Capturing;
+}
+
+void CaptureRenderDevice::BeginRecord(CaptureCommandType type)
+{
+    CaptureCommandHeader header{};
+    header.type = static_cast<uint16_t>(type);
+    m_Record.resize(sizeof(header));
+    memcpy(m_Record.data(), &header, sizeof(header));
+}
+
+void CaptureRenderDevice::AppendRecord(const void* pData, uint32_t size)
+{
+    // 每段数据都从 8 字节边界开始
+    size_t offset = m_Record.size();
+    m_Record.resize(offset + CaptureAlign(size), 0);
+    if (size)
+        memcpy(m_Record.data() + offset, pData, size);
+}
+
+void CaptureRenderDevice::EndRecord(std::vector<uint8_t>* pTarget)
+{
+    uint32_t size = static_cast<uint32_t>(m_Record.size());
+    reinterpret_cast<CaptureCommandHeader*>(m_Record.data())->size = size;
+
+    if (pTarget)
+    {
+        pTarget->insert(pTarget->end(), m_Record.begin(), m_Record.end());
+        return;
+    }
+    m_File.write(reinterpret_cast<const char*>(m_Record.data()), size);
+    ++m_Header.commandCount;
+    m_Header.commandBytes += size;
+}
+
+// 只写出与设备初始状态不同的绑定（回放设备从初始状态开始），
+// 所以在新设备上回放一份捕获时再捕获，得到的记录与原文件相同
+void CaptureRenderDevice::RecordState()
+{
+    for (uint32_t i = 0; i < kCaptureMaxVertexBuffers; ++i)
+    {
+        if (m_VertexBuffers[i].count == 0)
+            continue;
+        BeginRecord(CaptureCommandType::SetVertexBuffers);
+        AppendRecord(&m_VertexBuffers[i], sizeof(m_VertexBuffers[i]));
+        EndRecord(nullptr);
+    }
+    if (m_IndexBuffer != kInvalidBuffer)
+    {
+        CaptureSetIndexBuffer body = { m_IndexBuffer, 0 };
+        BeginRecord(CaptureCommandType::SetIndexBuffer);
+        AppendRecord(&body, sizeof(body));
+        EndRecord(nullptr);
+    }
+    for (uint32_t i = 0; i < kMaxConstantSlots; ++i)
+    {
+        if (m_ConstantBuffers[i].handle == kInvalidBuffer)
+            continue;
+        BeginRecord(CaptureCommandType::SetConstantBuffer);
+        AppendRecord(&m_ConstantBuffers[i], sizeof(m_ConstantBuffers[i]));
+        EndRecord(nullptr);
+    }
+    if (m_VertexFormat != VertexFormat::Float)
+    {
+        CaptureSetVertexFormat format = { static_cast<uint32_t>(m_VertexFormat), 0 };
+        BeginRecord(CaptureCommandType::SetVertexFormat);
+        AppendRecord(&format, sizeof(format));
+        EndRecord(nullptr);
+    }
+}
+
+void CaptureRenderDevice::SyncStats()
+{
+    m_Stats = m_pInner->GetStats();
+}
+
+BufferHandle CaptureRenderDevice::CreateBuffer(const BufferDesc& desc, const void* pInitData)
+{
+    BufferHandle handle = m_pInner->CreateBuffer(desc, pInitData);
+    SyncStats();
+
+    CaptureCreateBuffer body{};
+    body.handle = handle;
+    body.type = static_cast<uint32_t>(desc.type);
+    body.usage = static_cast<uint32_t>(desc.usage);
+    body.byteWidth = desc.byteWidth;
+    body.hasInitData = pInitData ? 1 : 0;
+
+    BeginRecord(CaptureCommandType::CreateBuffer);
+    AppendRecord(&body, sizeof(body));
+    if (pInitData)
+        AppendRecord(pInitData, desc.byteWidth);
+    EndRecord(&m_ResourceRecords);
+    ++m_ResourceRecordCount;
+
+    // 捕获期间创建的缓冲也要出现在本次捕获中
+    if (m_Capturing)
+        EndRecord(nullptr);
+    return handle;
+}
+
+void CaptureRenderDevice::WriteBuffer(BufferHandle buffer, MapMode mode, const BufferWrite* pWrites, uint32_t writeCount)
+{
+    m_pInner->WriteBuffer(buffer, mode, pWrites, writeCount);
+    SyncStats();
+    if (!m_Capturing)
+        return;
+
+    CaptureWriteBuffer body{};
+    body.handle = buffer;
+    body.mode = static_cast<uint32_t>(mode);
+    body.writeCount = writeCount;
+
+    BeginRecord(CaptureCommandType::WriteBuffer);
+    AppendRecord(&body, sizeof(body));
+    for (uint32_t i = 0; i < writeCount; ++i)
+    {
+        CaptureWriteRange range = { pWrites[i].offset, pWrites[i].size };
+        AppendRecord(&range, sizeof(range));
+    }
+    for (uint32_t i = 0; i < writeCount; ++i)
+        AppendRecord(pWrites[i].pData, pWrites[i].size);
+    EndRecord(nullptr);
+}
+
+void CaptureRenderDevice::SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+    const uint32_t* pStrides, const uint32_t* pOffsets)
+{
+    assert(startSlot + count <= kCaptureMaxVertexBuffers);
+    m_pInner->SetVertexBuffers(startSlot, count, pBuffers, pStrides, pOffsets);
+    SyncStats();
+
+    // 按槽位记下状态，捕获开始时逐槽重放
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        CaptureSetVertexBuffers& slot = m_VertexBuffers[startSlot + i];
+        slot.startSlot = startSlot + i;
+        slot.count = 1;
+        slot.handles[0] = pBuffers[i];
+        slot.strides[0] = pStrides[i];
+        slot.offsets[0] = pOffsets[i];
+    }
+    if (!m_Capturing)
+        return;
+
+    CaptureSetVertexBuffers body = MakeVertexBuffersBody(startSlot, count, pBuffers, pStrides, pOffsets);
+    BeginRecord(CaptureCommandType::SetVertexBuffers);
+    AppendRecord(&body, sizeof(body));
+    EndRecord(nullptr);
+}
+
+void CaptureRenderDevice::SetIndexBuffer(BufferHandle buffer)
+{
+    m_pInner->SetIndexBuffer(buffer);
+    SyncStats();
+    m_IndexBuffer = buffer;
+    if (!m_Capturing)
+        return;
+
+    CaptureSetIndexBuffer body = { buffer, 0 };
+    BeginRecord(CaptureCommandType::SetIndexBuffer);
+    AppendRecord(&body, sizeof(body));
+    EndRecord(nullptr);
+}
+
+void CaptureRenderDevice::SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+    uint32_t firstConstant, uint32_t numConstants)
+{
+    assert(slot < kMaxConstantSlots);
+    m_pInner->SetConstantBuffer(slot, buffer, firstConstant, numConstants);
+    SyncStats();
+
+    CaptureSetConstantBuffer& body = m_ConstantBuffers[slot];
+    body.handle = buffer;
+    body.firstConstant = firstConstant;
+    body.numConstants = numConstants;
+    if (!m_Capturing)
+        return;
+
+    BeginRecord(CaptureCommandType::SetConstantBuffer);
+    AppendRecord(&body, sizeof(body));
+    EndRecord(nullptr);
+}
+
+void CaptureRenderDevice::SetVertexFormat(VertexFormat format)
+{
+    m_pInner->SetVertexFormat(format);
+    SyncStats();
+    m_VertexFormat = format;
+    if (!m_Capturing)
+        return;
+
+    CaptureSetVertexFormat body = { static_cast<uint32_t>(format), 0 };
+    BeginRecord(CaptureCommandType::SetVertexFormat);
+    AppendRecord(&body, sizeof(body));
+    EndRecord(nullptr);
+}
+
+void CaptureRenderDevice::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+    uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+    m_pInner->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+    SyncStats();
+    if (!m_Capturing)
+        return;
+
+    CaptureDrawIndexedInstanced body = { indexCount, instanceCount, startIndex, baseVertex, startInstance, 0 };
+    BeginRecord(CaptureCommandType::DrawIndexedInstanced);
+    AppendRecord(&body, sizeof(body));
+    EndRecord(nullptr);
+}
+
+void CaptureRenderDevice::Clear(const float color[4])
+{
+    m_pInner->Clear(color);
+    if (!m_Capturing)
+        return;
+
+    CaptureClear body;
+    memcpy(body.color, color, sizeof(body.color));
+    BeginRecord(CaptureCommandType::Clear);
+    AppendRecord(&body, sizeof(body));
+    EndRecord(nullptr);
+}
+
+void CaptureRenderDevice::Present()
+{
+    m_pInner->Present();
+    SyncStats();
+    if (!m_Capturing)
+        return;
+
+    BeginRecord(CaptureCommandType::Present);
+    EndRecord(nullptr);
+    ++m_Header.frameCount;
+    if (--m_FramesRemaining == 0)
+        EndCapture();
+}
+
+void CaptureRenderDevice::ReleaseRenderTargets()
+{
+    m_pInner->ReleaseRenderTargets();
+}
+
+void CaptureRenderDevice::InsertFence(uint64_t fence)
+{
+    m_pInner->InsertFence(fence);
+    if (!m_Capturing)
+        return;
+
+    CaptureInsertFence body = { fence };
+    BeginRecord(CaptureCommandType::InsertFence);
+    AppendRecord(&body, sizeof(body));
+    EndRecord(nullptr);
+}
+
+uint64_t CaptureRenderDevice::GetCompletedFence()
+{
+    return m_pInner->GetCompletedFence();
+}
+
+bool CaptureRenderDevice::SupportsConstantBufferOffsets() const
+{
+    return m_pInner->SupportsConstantBufferOffsets();
+}
+
+// ==== 并行录制：上下文数量与内层设备相同 ====
+uint32_t CaptureRenderDevice::GetMaxCommandContexts() const
+{
+    return m_pInner->GetMaxCommandContexts();
+}
+
+CommandContext* CaptureRenderDevice::BeginCommandContext(uint32_t index)
+{
+    while (m_Contexts.size() <= index)
+        m_Contexts.emplace_back(new Context());
+
+    Context& context = *m_Contexts[index];
+    context.pInner = m_pInner->BeginCommandContext(index);
+    assert(context.pInner);
+    context.capturing = m_Capturing;
+    context.records.clear();
+    context.recordCount = 0;
+    // 上下文的顶点格式从主上下文复制而来，回放时按顺序执行，要先恢复成录制开始时的格式
+    if (context.capturing)
+    {
+        CaptureSetVertexFormat body = { static_cast<uint32_t>(m_VertexFormat), 0 };
+        context.Record(CaptureCommandType::SetVertexFormat, &body, sizeof(body));
+    }
+    return &context;
+}
+
+void CaptureRenderDevice::EndCommandContext(uint32_t index)
+{
+    m_pInner->EndCommandContext(index);
+}
+
+void CaptureRenderDevice::ExecuteCommandContexts(uint32_t count)
+{
+    assert(count <= m_Contexts.size());
+    m_pInner->ExecuteCommandContexts(count);
+    SyncStats();
+    if (!m_Capturing)
+        return;
+
+    // 按执行顺序写入各上下文的命令，之后恢复主上下文的绑定状态
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const Context& context = *m_Contexts[i];
+        if (!context.capturing)
+            continue;
+        m_File.write(reinterpret_cast<const char*>(context.records.data()), context.records.size());
+        m_Header.commandCount += context.recordCount;
+        m_Header.commandBytes += context.records.size();
+    }
+    RecordState();
+}
+
+void CaptureRenderDevice::Context::Record(CaptureCommandType type, const void* pBody, uint32_t size)
+{
+    CaptureCommandHeader header{};
+    header.type = static_cast<uint16_t>(type);
+    header.size = static_cast<uint32_t>(sizeof(header) + CaptureAlign(size));
+
+    size_t offset = records.size();
+    records.resize(offset + header.size, 0);
+    memcpy(records.data() + offset, &header, sizeof(header));
+    memcpy(records.data() + offset + sizeof(header), pBody, size);
+    ++recordCount;
+}
+
+void CaptureRenderDevice::Context::SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+    const uint32_t* pStrides, const uint32_t* pOffsets)
+{
+    assert(startSlot + count <= kCaptureMaxVertexBuffers);
+    pInner->SetVertexBuffers(startSlot, count, pBuffers, pStrides, pOffsets);
+    if (!capturing)
+        return;
+
+    CaptureSetVertexBuffers body = MakeVertexBuffersBody(startSlot, count, pBuffers, pStrides, pOffsets);
+    Record(CaptureCommandType::SetVertexBuffers, &body, sizeof(body));
+}
+
+void CaptureRenderDevice::Context::SetIndexBuffer(BufferHandle buffer)
+{
+    pInner->SetIndexBuffer(buffer);
+    if (!capturing)
+        return;
+
+    CaptureSetIndexBuffer body = { buffer, 0 };
+    Record(CaptureCommandType::SetIndexBuffer, &body, sizeof(body));
+}
+
+void CaptureRenderDevice::Context::SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+    uint32_t firstConstant, uint32_t numConstants)
+{
+    assert(slot < kMaxConstantSlots);
+    pInner->SetConstantBuffer(slot, buffer, firstConstant, numConstants);
+    if (!capturing)
+        return;
+
+    CaptureSetConstantBuffer body{};
+    body.slot = slot;
+    body.handle = buffer;
+    body.firstConstant = firstConstant;
+    body.numConstants = numConstants;
+    Record(CaptureCommandType::SetConstantBuffer, &body, sizeof(body));
+}
+
+void CaptureRenderDevice::Context::SetVertexFormat(VertexFormat format)
+{
+    pInner->SetVertexFormat(format);
+    if (!capturing)
+        return;
+
+    CaptureSetVertexFormat body = { static_cast<uint32_t>(format), 0 };
+    Record(CaptureCommandType::SetVertexFormat, &body, sizeof(body));
+}
+
+void CaptureRenderDevice::Context::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+    uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+    pInner->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+    if (!capturing)
+        return;
+
+    CaptureDrawIndexedInstanced body = { indexCount, instanceCount, startIndex, baseVertex, startInstance, 0 };
+    Record(CaptureCommandType::DrawIndexedInstanced, &body, sizeof(body));
+}
@@ -0,0 +1,111 @@
+//***************************************************************************************
+// CaptureRenderDevice.h
+//
+// 命令流捕获设备：包装另一个 RenderDevice，所有调用照常转发，
+// 捕获期间同时把调用按 CaptureFormat.h 的格式写入文件。
+// 捕获开始时先写出已创建的全部缓冲（含不可变缓冲的初始数据）和当前绑定状态，
+// 因此捕获文件可以脱离原程序单独回放。
+// 并行录制的命令上下文各自先记入内存，执行时按上下文顺序写入，再写出主上下文的绑定状态，
+// 所以文件内容与录制线程的调度无关，回放时按顺序执行即可。
+//***************************************************************************************
+
+#ifndef CAPTURERENDERDEVICE_H
+#define CAPTURERENDERDEVICE_H
+
+#include "RenderDevice.h"
+#include "CaptureFormat.h"
+#include <fstream>
+#include <memory>
+#include <vector>
+
+class CaptureRenderDevice : public RenderDevice
+{
+public:
+    explicit CaptureRenderDevice(RenderDevice* pInner);
+    ~CaptureRenderDevice();
+
+    // 从下一条命令开始捕获，记录 frameCount 次 Present 后自动结束并写回文件头
+    bool BeginCapture(const char* path, uint32_t frameCount);
+    void EndCapture();
+    bool IsCapturing() const;
+
+    BufferHandle CreateBuffer(const BufferDesc& desc, const void* pInitData) override;
+    void WriteBuffer(BufferHandle buffer, MapMode mode, const BufferWrite* pWrites, uint32_t writeCount) override;
+    using RenderDevice::WriteBuffer;
+
+    void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+        const uint32_t* pStrides, const uint32_t* pOffsets) override;
+    void SetIndexBuffer(BufferHandle buffer) override;
+    void SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+        uint32_t firstConstant = 0, uint32_t numConstants = 0) override;
+    void SetVertexFormat(VertexFormat format) override;
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+        uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+
+    void Clear(const float color[4]) override;
+    void Present() override;
+    void ReleaseRenderTargets() override;     // 只转发，不记录（回放时窗口大小与捕获时无关）
+
+    void InsertFence(uint64_t fence) override;
+    uint64_t GetCompletedFence() override;
+
+    bool SupportsConstantBufferOffsets() const override;
+
+    uint32_t GetMaxCommandContexts() const override;
+    CommandContext* BeginCommandContext(uint32_t index) override;
+    void EndCommandContext(uint32_t index) override;
+    void ExecuteCommandContexts(uint32_t count) override;
+
+private:
+    static const uint32_t kMaxConstantSlots = 14;
+
+    // 录制上下文：转发给内层设备的上下文，捕获期间同时把命令记入 records
+    class Context : public CommandContext
+    {
+    public:
+        void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+            const uint32_t* pStrides, const uint32_t* pOffsets) override;
+        void SetIndexBuffer(BufferHandle buffer) override;
+        void SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+            uint32_t firstConstant = 0, uint32_t numConstants = 0) override;
+        void SetVertexFormat(VertexFormat format) override;
+        void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+            uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+
+        void Record(CaptureCommandType type, const void* pBody, uint32_t size);
+
+        CommandContext* pInner = nullptr;
+        bool capturing = false;
+        std::vector<uint8_t> records;
+        uint32_t recordCount = 0;
+    };
+
+    // 把一条记录拼到 m_Record 中，再写入文件或缓冲创建记录
+    void BeginRecord(CaptureCommandType type);
+    void AppendRecord(const void* pData, uint32_t size);
+    void EndRecord(std::vector<uint8_t>* pTarget);
+    void RecordState();
+    void SyncStats();
+
+    RenderDevice* m_pInner;
+
+    // 缓冲创建记录一直保留，捕获开始时整体写出
+    std::vector<uint8_t> m_ResourceRecords;
+    uint32_t m_ResourceRecordCount = 0;
+    std::vector<uint8_t> m_Record;
+
+    // 当前绑定状态
+    CaptureSetVertexBuffers m_VertexBuffers[kCaptureMaxVertexBuffers];
+    BufferHandle m_IndexBuffer = kInvalidBuffer;
+    CaptureSetConstantBuffer m_ConstantBuffers[kMaxConstantSlots];
+    VertexFormat m_VertexFormat = VertexFormat::Float;
+
+    std::ofstream m_File;
+    bool m_Capturing = false;
+    uint32_t m_FramesRemaining = 0;
+    CaptureHeader m_Header;
+
+    std::vector<std::unique_ptr<Context>> m_Contexts;
+};
+
+#endif
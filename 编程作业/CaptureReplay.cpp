@@ -0,0 +1,268 @@
+#include "CaptureReplay.h"
+#include <cassert>
+#include <cstring>
+
+CaptureReader::CaptureReader()
+    : m_Header()
+{
+}
+
+bool CaptureReader::Open(const uint8_t* pData, size_t size)
+{
+    m_pData = nullptr;
+    m_Size = 0;
+    m_Error = true;
+    if (!pData || size < sizeof(CaptureHeader))
+        return false;
+
+    memcpy(&m_Header, pData, sizeof(m_Header));
+    if (m_Header.magic != kCaptureMagic || m_Header.version < kCaptureMinVersion || m_Header.version > kCaptureVersion)
+        return false;
+    if (m_Header.commandBytes > size - sizeof(CaptureHeader))
+        return false;
+
+    m_pData = pData;
+    m_Size = sizeof(CaptureHeader) + static_cast<size_t>(m_Header.commandBytes);
+    Rewind();
+    return true;
+}
+
+void CaptureReader::Rewind()
+{
+    m_Cursor = sizeof(CaptureHeader);
+    m_CommandIndex = 0;
+    m_Error = m_pData == nullptr;
+}
+
+bool CaptureReader::Next(const CaptureCommandHeader** ppCommand)
+{
+    assert(ppCommand);
+    if (m_Error || m_Cursor >= m_Size)
+        return false;
+
+    const CaptureCommandHeader* pCommand = reinterpret_cast<const CaptureCommandHeader*>(m_pData + m_Cursor);
+    if (m_Size - m_Cursor < sizeof(CaptureCommandHeader) || pCommand->size < sizeof(CaptureCommandHeader)
+        || pCommand->size % 8 != 0 || pCommand->size > m_Size - m_Cursor)
+    {
+        m_Error = true;
+        return false;
+    }
+
+    *ppCommand = pCommand;
+    m_Cursor += pCommand->size;
+    ++m_CommandIndex;
+    return true;
+}
+
+bool CaptureReader::HasError() const
+{
+    return m_Error;
+}
+
+const CaptureHeader& CaptureReader::GetHeader() const
+{
+    return m_Header;
+}
+
+uint32_t CaptureReader::GetCommandIndex() const
+{
+    return m_CommandIndex;
+}
+
+CaptureReplayer::CaptureReplayer(RenderDevice* pDevice)
+    : m_pDevice(pDevice)
+{
+    assert(pDevice);
+}
+
+void CaptureReplayer::SetPresentEnabled(bool enabled)
+{
+    m_PresentEnabled = enabled;
+}
+
+const CaptureReplayer::Stats& CaptureReplayer::GetStats() const
+{
+    return m_Stats;
+}
+
+void CaptureReplayer::ResetStats()
+{
+    m_Stats = Stats();
+}
+
+BufferHandle CaptureReplayer::MapHandle(uint32_t captured) const
+{
+    if (captured == kInvalidBuffer || captured >= m_Handles.size())
+        return kInvalidBuffer;
+    return m_Handles[captured];
+}
+
+bool CaptureReplayer::Replay(const uint8_t* pData, size_t size)
+{
+    CaptureReader reader;
+    if (!reader.Open(pData, size))
+        return false;
+
+    const CaptureCommandHeader* pCommand = nullptr;
+    while (reader.Next(&pCommand))
+    {
+        if (!Execute(pCommand))
+            return false;
+        ++m_Stats.commands;
+    }
+    return !reader.HasError();
+}
+
+bool CaptureReplayer::Execute(const CaptureCommandHeader* pCommand)
+{
+    const uint32_t bodySize = pCommand->size - sizeof(CaptureCommandHeader);
+    const uint8_t* pBody = CaptureReader::GetBody<uint8_t>(pCommand);
+
+    switch (static_cast<CaptureCommandType>(pCommand->type))
+    {
+    case CaptureCommandType::CreateBuffer:
+    {
+        if (bodySize < sizeof(CaptureCreateBuffer))
+            return false;
+        const CaptureCreateBuffer* pCreate = reinterpret_cast<const CaptureCreateBuffer*>(pBody);
+        if (pCreate->hasInitData && bodySize < sizeof(CaptureCreateBuffer) + uint64_t(pCreate->byteWidth))
+            return false;
+        // 句柄决定映射表的大小，损坏的文件不能让它任意增长
+        if (pCreate->handle == kInvalidBuffer || pCreate->handle >= kCaptureMaxBuffers)
+            return false;
+        if (pCreate->handle >= m_Handles.size())
+            m_Handles.resize(pCreate->handle + 1, kInvalidBuffer);
+        // 重复回放时沿用已经创建的缓冲
+        if (m_Handles[pCreate->handle] != kInvalidBuffer)
+            break;
+
+        BufferDesc desc{};
+        desc.type = static_cast<BufferType>(pCreate->type);
+        desc.usage = static_cast<BufferUsage>(pCreate->usage);
+        desc.byteWidth = pCreate->byteWidth;
+        desc.debugName = "CaptureReplay";
+        m_Handles[pCreate->handle] = m_pDevice->CreateBuffer(desc,
+            pCreate->hasInitData ? pBody + sizeof(CaptureCreateBuffer) : nullptr);
+        break;
+    }
+    case CaptureCommandType::WriteBuffer:
+    {
+        if (bodySize < sizeof(CaptureWriteBuffer))
+            return false;
+        const CaptureWriteBuffer* pWrite = reinterpret_cast<const CaptureWriteBuffer*>(pBody);
+        const CaptureWriteRange* pRanges = reinterpret_cast<const CaptureWriteRange*>(pBody + sizeof(CaptureWriteBuffer));
+        if (pWrite->writeCount > (bodySize - sizeof(CaptureWriteBuffer)) / sizeof(CaptureWriteRange))
+            return false;
+        uint64_t cursor = sizeof(CaptureWriteBuffer)
+            + CaptureAlign(static_cast<uint32_t>(sizeof(CaptureWriteRange) * pWrite->writeCount));
+        if (cursor > bodySize)
+            return false;
+
+        m_Writes.resize(pWrite->writeCount);
+        for (uint32_t i = 0; i < pWrite->writeCount; ++i)
+        {
+            if (cursor + pRanges[i].size > bodySize)
+                return false;
+            m_Writes[i].offset = pRanges[i].offset;
+            m_Writes[i].pData = pBody + cursor;
+            m_Writes[i].size = pRanges[i].size;
+            cursor += CaptureAlign(pRanges[i].size);
+            m_Stats.bytesWritten += pRanges[i].size;
+        }
+        BufferHandle handle = MapHandle(pWrite->handle);
+        if (handle == kInvalidBuffer)
+            return false;
+        m_pDevice->WriteBuffer(handle, static_cast<MapMode>(pWrite->mode), m_Writes.data(), pWrite->writeCount);
+        break;
+    }
+    case CaptureCommandType::SetVertexBuffers:
+    {
+        if (bodySize < sizeof(CaptureSetVertexBuffers))
+            return false;
+        const CaptureSetVertexBuffers* pSet = reinterpret_cast<const CaptureSetVertexBuffers*>(pBody);
+        if (pSet->count > kCaptureMaxVertexBuffers)
+            return false;
+        BufferHandle handles[kCaptureMaxVertexBuffers];
+        for (uint32_t i = 0; i < pSet->count; ++i)
+            handles[i] = MapHandle(pSet->handles[i]);
+        m_pDevice->SetVertexBuffers(pSet->startSlot, pSet->count, handles, pSet->strides, pSet->offsets);
+        break;
+    }
+    case CaptureCommandType::SetIndexBuffer:
+    {
+        if (bodySize < sizeof(CaptureSetIndexBuffer))
+            return false;
+        m_pDevice->SetIndexBuffer(MapHandle(reinterpret_cast<const CaptureSetIndexBuffer*>(pBody)->handle));
+        break;
+    }
+    case CaptureCommandType::SetConstantBuffer:
+    {
+        if (bodySize < sizeof(CaptureSetConstantBuffer))
+            return false;
+        const CaptureSetConstantBuffer* pSet = reinterpret_cast<const CaptureSetConstantBuffer*>(pBody);
+        m_pDevice->SetConstantBuffer(pSet->slot, MapHandle(pSet->handle), pSet->firstConstant, pSet->numConstants);
+        break;
+    }
+    case CaptureCommandType::SetVertexFormat:
+    {
+        if (bodySize < sizeof(CaptureSetVertexFormat))
+            return false;
+        uint32_t format = reinterpret_cast<const CaptureSetVertexFormat*>(pBody)->format;
+        if (format >= static_cast<uint32_t>(VertexFormat::Count))
+            return false;
+        m_pDevice->SetVertexFormat(static_cast<VertexFormat>(format));
+        break;
+    }
+    case CaptureCommandType::DrawIndexedInstanced:
+    {
+        if (bodySize < sizeof(CaptureDrawIndexedInstanced))
+            return false;
+        const CaptureDrawIndexedInstanced* pDraw = reinterpret_cast<const CaptureDrawIndexedInstanced*>(pBody);
+        m_pDevice->DrawIndexedInstanced(pDraw->indexCount, pDraw->instanceCount,
+            pDraw->startIndex, pDraw->baseVertex, pDraw->startInstance);
+        ++m_Stats.drawCalls;
+        break;
+    }
+    case CaptureCommandType::Clear:
+    {
+        if (bodySize < sizeof(CaptureClear))
+            return false;
+        m_pDevice->Clear(reinterpret_cast<const CaptureClear*>(pBody)->color);
+        break;
+    }
+    case CaptureCommandType::Present:
+        if (m_PresentEnabled)
+            m_pDevice->Present();
+        ++m_Stats.frames;
+        break;
+    case CaptureCommandType::InsertFence:
+        // 捕获中的 fence 值只表示位置，回放设备上重新连续编号
+        m_pDevice->InsertFence(++m_Fence);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+int64_t CompareCaptures(const uint8_t* pDataA, size_t sizeA, const uint8_t* pDataB, size_t sizeB)
+{
+    CaptureReader readerA, readerB;
+    bool okA = readerA.Open(pDataA, sizeA);
+    bool okB = readerB.Open(pDataB, sizeB);
+    if (!okA || !okB)
+        return 0;
+
+    const CaptureCommandHeader* pA = nullptr;
+    const CaptureCommandHeader* pB = nullptr;
+    int64_t index = 0;
+    for (;; ++index)
+    {
+        bool hasA = readerA.Next(&pA);
+        bool hasB = readerB.Next(&pB);
+        if (!hasA && !hasB)
+            return (readerA.HasError() || readerB.HasError()) ? index : -1;
+        if (hasA != hasB || pA->size != pB->size || memcmp(pA, pB, pA->size) != 0)
+            return index;
+    }
+}
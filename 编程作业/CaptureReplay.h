@@ -0,0 +1,85 @@
+//***************************************************************************************
+// CaptureReplay.h
+//
+// 捕获文件的读取、回放与比较。数据通常来自 MappedFile，
+// 回放时缓冲写入直接引用映射中的数据，不做额外拷贝。
+//***************************************************************************************
+
+#ifndef CAPTUREREPLAY_H
+#define CAPTUREREPLAY_H
+
+#include "CaptureFormat.h"
+#include "RenderDevice.h"
+#include <cstddef>
+#include <vector>
+
+// 顺序遍历命令记录，并检查每条记录的长度是否越界
+class CaptureReader
+{
+public:
+    CaptureReader();
+
+    bool Open(const uint8_t* pData, size_t size);
+    void Rewind();
+
+    // 读取下一条记录，到末尾或数据损坏时返回 false（用 HasError 区分）
+    bool Next(const CaptureCommandHeader** ppCommand);
+    bool HasError() const;
+
+    const CaptureHeader& GetHeader() const;
+    uint32_t GetCommandIndex() const;       // 已读取的记录数
+
+    // 记录头部之后的数据
+    template <class T>
+    static const T* GetBody(const CaptureCommandHeader* pCommand)
+    {
+        return reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(pCommand) + sizeof(CaptureCommandHeader));
+    }
+
+private:
+    const uint8_t* m_pData = nullptr;
+    size_t m_Size = 0;
+    size_t m_Cursor = 0;
+    uint32_t m_CommandIndex = 0;
+    bool m_Error = false;
+    CaptureHeader m_Header;
+};
+
+// 把捕获文件中的命令重新提交到任意 RenderDevice
+class CaptureReplayer
+{
+public:
+    struct Stats
+    {
+        uint32_t commands = 0;
+        uint32_t frames = 0;
+        uint32_t drawCalls = 0;
+        uint64_t bytesWritten = 0;
+    };
+
+public:
+    explicit CaptureReplayer(RenderDevice* pDevice);
+
+    // 同一个回放器多次回放同一份捕获时，已创建过的缓冲会被复用
+    bool Replay(const uint8_t* pData, size_t size);
+
+    void SetPresentEnabled(bool enabled);   // 关闭后跳过 Present（离线测量时使用）
+    const Stats& GetStats() const;
+    void ResetStats();
+
+private:
+    BufferHandle MapHandle(uint32_t captured) const;
+    bool Execute(const CaptureCommandHeader* pCommand);
+
+    RenderDevice* m_pDevice;
+    std::vector<BufferHandle> m_Handles;    // 捕获时的句柄 -> 回放设备上的句柄
+    std::vector<BufferWrite> m_Writes;
+    uint64_t m_Fence = 0;                   // 回放设备上的 fence 需要自己连续编号
+    bool m_PresentEnabled = true;
+    Stats m_Stats;
+};
+
+// 比较两份捕获，返回第一条不同记录的序号；完全相同时返回 -1
+int64_t CompareCaptures(const uint8_t* pDataA, size_t sizeA, const uint8_t* pDataB, size_t sizeB);
+
+#endif
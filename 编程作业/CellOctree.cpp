@@ -0,0 +1,240 @@
+#include "CellOctree.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+CellOctree::CellOctree()
+{
+}
+
+void CellOctree::Build(int n)
+{
+    m_N = std::max(0, n);
+    m_Nodes.clear();
+    m_CellOrder.clear();
+    m_VisibleCells.clear();
+    if (m_N == 0)
+        return;
+
+    m_CellOrder.reserve(static_cast<size_t>(m_N) * m_N * m_N);
+    m_Nodes.push_back(Node());
+    BuildNode(0, 0, 0, 0, m_N, m_N, m_N);
+    assert(m_CellOrder.size() == GetCellCount());
+
+    m_Bounds.Resize(m_CellOrder.size());
+    m_LeafVisible.resize(m_CellOrder.size());
+}
+
+void CellOctree::BuildNode(uint32_t nodeIndex, int x0, int y0, int z0, int x1, int y1, int z1)
+{
+    const int n = m_N;
+    m_Nodes[nodeIndex].firstCell = static_cast<uint32_t>(m_CellOrder.size());
+    m_Nodes[nodeIndex].firstChild = 0;
+    m_Nodes[nodeIndex].childCount = 0;
+
+    // 各方向超过叶子大小时从中间切开
+    int xs[3] = { x0, x1, x1 }, ys[3] = { y0, y1, y1 }, zs[3] = { z0, z1, z1 };
+    int nx = 1, ny = 1, nz = 1;
+    if (x1 - x0 > kLeafSize) { xs[1] = (x0 + x1) / 2; nx = 2; }
+    if (y1 - y0 > kLeafSize) { ys[1] = (y0 + y1) / 2; ny = 2; }
+    if (z1 - z0 > kLeafSize) { zs[1] = (z0 + z1) / 2; nz = 2; }
+
+    if (nx * ny * nz == 1)
+    {
+        // 叶子：单元按编号顺序连续放入 m_CellOrder
+        for (int ix = x0; ix < x1; ++ix)
+            for (int iy = y0; iy < y1; ++iy)
+                for (int iz = z0; iz < z1; ++iz)
+                    m_CellOrder.push_back(static_cast<uint32_t>((ix * n + iy) * n + iz));
+    }
+    else
+    {
+        // 先一次分配全部子节点，保证兄弟节点连续；深度优先构建保证子树的单元范围连续
+        uint32_t firstChild = static_cast<uint32_t>(m_Nodes.size());
+        uint32_t childCount = static_cast<uint32_t>(nx * ny * nz);
+        m_Nodes[nodeIndex].firstChild = firstChild;
+        m_Nodes[nodeIndex].childCount = childCount;
+        m_Nodes.resize(m_Nodes.size() + childCount);
+
+        uint32_t child = firstChild;
+        for (int a = 0; a < nx; ++a)
+            for (int b = 0; b < ny; ++b)
+                for (int c = 0; c < nz; ++c)
+                    BuildNode(child++, xs[a], ys[b], zs[c], xs[a + 1], ys[b + 1], zs[c + 1]);
+    }
+
+    m_Nodes[nodeIndex].cellCount = static_cast<uint32_t>(m_CellOrder.size()) - m_Nodes[nodeIndex].firstCell;
+}
+
+// 包围一组球：中心取 AABB 中心，半径取到各球最远点的距离
+template <typename GetSphere>
+static void BoundSpheres(uint32_t count, GetSphere get, float& outX, float& outY, float& outZ, float& outR)
+{
+    float mn[3] = { 0, 0, 0 }, mx[3] = { 0, 0, 0 };
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float s[4];
+        get(i, s);
+        for (int k = 0; k < 3; ++k)
+        {
+            if (i == 0 || s[k] - s[3] < mn[k]) mn[k] = s[k] - s[3];
+            if (i == 0 || s[k] + s[3] > mx[k]) mx[k] = s[k] + s[3];
+        }
+    }
+    outX = (mn[0] + mx[0]) * 0.5f;
+    outY = (mn[1] + mx[1]) * 0.5f;
+    outZ = (mn[2] + mx[2]) * 0.5f;
+
+    float r = 0.0f;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float s[4];
+        get(i, s);
+        float dx = s[0] - outX, dy = s[1] - outY, dz = s[2] - outZ;
+        r = std::max(r, std::sqrt(dx * dx + dy * dy + dz * dz) + s[3]);
+    }
+    outR = r;
+}
+
+void CellOctree::Refit(const SphereSoA& cellBounds)
+{
+    assert(cellBounds.Size() == m_CellOrder.size());
+
+    // 按叶子顺序重排，叶子内的单元可以连续批量测试
+    for (size_t j = 0; j < m_CellOrder.size(); ++j)
+    {
+        uint32_t cell = m_CellOrder[j];
+        m_Bounds.x[j] = cellBounds.x[cell];
+        m_Bounds.y[j] = cellBounds.y[cell];
+        m_Bounds.z[j] = cellBounds.z[cell];
+        m_Bounds.r[j] = cellBounds.r[cell];
+    }
+
+    // 父节点总在子节点之前，逆序遍历即自底向上
+    for (size_t i = m_Nodes.size(); i-- > 0;)
+    {
+        Node& node = m_Nodes[i];
+        if (node.childCount == 0)
+        {
+            const uint32_t first = node.firstCell;
+            BoundSpheres(node.cellCount, [&](uint32_t k, float s[4]) {
+                s[0] = m_Bounds.x[first + k]; s[1] = m_Bounds.y[first + k];
+                s[2] = m_Bounds.z[first + k]; s[3] = m_Bounds.r[first + k];
+            }, node.x, node.y, node.z, node.r);
+        }
+        else
+        {
+            const Node* pChildren = &m_Nodes[node.firstChild];
+            BoundSpheres(node.childCount, [&](uint32_t k, float s[4]) {
+                s[0] = pChildren[k].x; s[1] = pChildren[k].y;
+                s[2] = pChildren[k].z; s[3] = pChildren[k].r;
+            }, node.x, node.y, node.z, node.r);
+        }
+    }
+}
+
+void CellOctree::MarkVisible(uint32_t first, uint32_t count, uint8_t* pCellVisible)
+{
+    for (uint32_t j = first; j < first + count; ++j)
+    {
+        pCellVisible[m_CellOrder[j]] = 1;
+        m_VisibleCells.push_back(m_CellOrder[j]);
+    }
+    m_Stats.cellsVisible += count;
+}
+
+void CellOctree::Cull(const FrustumCuller& frustum, float eyeX, float eyeY, float eyeZ, uint8_t* pCellVisible)
+{
+    m_Stats = CullStats();
+    m_VisibleCells.clear();
+    if (m_Nodes.empty())
+        return;
+    memset(pCellVisible, 0, GetCellCount());
+
+    m_Stack.clear();
+    m_Stack.push_back(0);
+    while (!m_Stack.empty())
+    {
+        const Node& node = m_Nodes[m_Stack.back()];
+        m_Stack.pop_back();
+
+        ++m_Stats.nodesTested;
+        FrustumCuller::Containment containment = frustum.Classify(node.x, node.y, node.z, node.r);
+        if (containment == FrustumCuller::Containment::Outside)
+        {
+            ++m_Stats.nodesRejected;
+            continue;
+        }
+        if (containment == FrustumCuller::Containment::Inside)
+        {
+            ++m_Stats.nodesAccepted;
+            MarkVisible(node.firstCell, node.cellCount, pCellVisible);
+            continue;
+        }
+
+        if (node.childCount == 0)
+        {
+            // 与边界相交的叶子：逐个单元批量测试
+            const uint32_t first = node.firstCell;
+            frustum.Cull(&m_Bounds.x[first], &m_Bounds.y[first], &m_Bounds.z[first], &m_Bounds.r[first],
+                node.cellCount, &m_LeafVisible[first]);
+            m_Stats.cellsTested += node.cellCount;
+            for (uint32_t j = first; j < first + node.cellCount; ++j)
+            {
+                if (m_LeafVisible[j])
+                {
+                    pCellVisible[m_CellOrder[j]] = 1;
+                    m_VisibleCells.push_back(m_CellOrder[j]);
+                    ++m_Stats.cellsVisible;
+                }
+            }
+            continue;
+        }
+
+        // 子节点按到相机的距离排序，远的先入栈，近的先出栈
+        uint32_t order[8];
+        float distSq[8];
+        for (uint32_t k = 0; k < node.childCount; ++k)
+        {
+            const Node& child = m_Nodes[node.firstChild + k];
+            float dx = child.x - eyeX, dy = child.y - eyeY, dz = child.z - eyeZ;
+            float d = dx * dx + dy * dy + dz * dz;
+            uint32_t pos = k;
+            while (pos > 0 && distSq[pos - 1] < d)
+            {
+                distSq[pos] = distSq[pos - 1];
+                order[pos] = order[pos - 1];
+                --pos;
+            }
+            distSq[pos] = d;
+            order[pos] = node.firstChild + k;
+        }
+        m_Stack.insert(m_Stack.end(), order, order + node.childCount);
+    }
+}
+
+int CellOctree::GetGridSize() const
+{
+    return m_N;
+}
+
+uint32_t CellOctree::GetCellCount() const
+{
+    return static_cast<uint32_t>(m_N) * m_N * m_N;
+}
+
+const std::vector<CellOctree::Node>& CellOctree::GetNodes() const
+{
+    return m_Nodes;
+}
+
+const std::vector<uint32_t>& CellOctree::GetVisibleCells() const
+{
+    return m_VisibleCells;
+}
+
+const CellOctree::CullStats& CellOctree::GetStats() const
+{
+    return m_Stats;
+}
@@ -0,0 +1,78 @@
+//***************************************************************************************
+// CellOctree.h
+//
+// 单元八叉树：按网格下标把 n×n×n 的单元递归对半划分，叶子最多 kLeafSize³ 个单元。
+// 拓扑只和 n 有关（Build），间距/子字半径变化时只需重新计算包围球（Refit）。
+// 剔除时由近到远遍历，完全在视锥外或完全在内的子树整体拒绝/接受，
+// 与视锥边界相交的叶子再用 FrustumCuller 逐个单元批量测试。
+//***************************************************************************************
+
+#ifndef CELLOCTREE_H
+#define CELLOCTREE_H
+
+#include "FrustumCuller.h"
+#include <cstdint>
+#include <vector>
+
+class CellOctree
+{
+public:
+    static const int kLeafSize = 4;         // 叶子每个方向最多的单元数
+
+    struct Node
+    {
+        float x, y, z, r;                   // 包围球
+        uint32_t firstCell;                 // 在 m_CellOrder 中的范围
+        uint32_t cellCount;
+        uint32_t firstChild;                // 子节点在 m_Nodes 中连续存放
+        uint32_t childCount;                // 0 表示叶子
+    };
+
+    struct CullStats
+    {
+        uint32_t nodesTested = 0;           // 测试过的节点包围球
+        uint32_t nodesAccepted = 0;         // 完全在视锥内而整体接受的子树
+        uint32_t nodesRejected = 0;         // 完全在视锥外而整体拒绝的子树
+        uint32_t cellsTested = 0;           // 在相交叶子中逐个测试的单元
+        uint32_t cellsVisible = 0;
+
+        uint32_t Tests() const { return nodesTested + cellsTested; }
+    };
+
+public:
+    CellOctree();
+
+    // 按单元数 n 建立拓扑，单元编号为 (ix * n + iy) * n + iz；包围球需要随后 Refit
+    void Build(int n);
+    // 用新的单元包围球（按单元编号排列）自底向上更新所有节点
+    void Refit(const SphereSoA& cellBounds);
+
+    // 剔除：pCellVisible 需要有 GetCellCount() 个元素，可见的单元写 1，其余写 0
+    // 可见单元同时按由近到远的节点顺序记录在 GetVisibleCells() 中
+    void Cull(const FrustumCuller& frustum, float eyeX, float eyeY, float eyeZ, uint8_t* pCellVisible);
+
+    int GetGridSize() const;
+    uint32_t GetCellCount() const;
+    const std::vector<Node>& GetNodes() const;
+    const std::vector<uint32_t>& GetVisibleCells() const;
+    const CullStats& GetStats() const;
+
+private:
+    void BuildNode(uint32_t nodeIndex, int x0, int y0, int z0, int x1, int y1, int z1);
+    void MarkVisible(uint32_t first, uint32_t count, uint8_t* pCellVisible);
+
+private:
+    int m_N = 0;
+    std::vector<Node> m_Nodes;              // 父节点总在子节点之前
+    std::vector<uint32_t> m_CellOrder;      // 按叶子排列的单元编号
+
+    // 按 m_CellOrder 排列的单元包围球，叶子中的单元可以连续批量测试
+    SphereSoA m_Bounds;
+    std::vector<uint8_t> m_LeafVisible;
+
+    std::vector<uint32_t> m_Stack;
+    std::vector<uint32_t> m_VisibleCells;
+    CullStats m_Stats;
+};
+
+#endif
@@ -0,0 +1,115 @@
+#include "ConstantRing.h"
+#include <cassert>
+
+ConstantRing::ConstantRing()
+{
+}
+
+void ConstantRing::Init(uint32_t capacityBytes)
+{
+    m_Capacity = capacityBytes / kSlotBytes * kSlotBytes;
+    Reset();
+}
+
+void ConstantRing::Reset()
+{
+    m_Head = 0;
+    m_Used = 0;
+    m_FrameBytes = 0;
+    m_InFlight.clear();
+}
+
+uint32_t ConstantRing::AlignSize(uint32_t size)
+{
+    return (size + kSlotBytes - 1) / kSlotBytes * kSlotBytes;
+}
+
+bool ConstantRing::Allocate(uint32_t size, uint32_t* pOffset)
+{
+    assert(pOffset);
+    uint32_t aligned = AlignSize(size);
+    if (aligned == 0 || aligned > m_Capacity)
+    {
+        ++m_Stats.failures;
+        return false;
+    }
+
+    // 已占用的区域在环上总是连续的 [tail, head)，空闲区域为剩下的部分
+    if (m_Head + aligned > m_Capacity)
+    {
+        // 尾部放不下：跳过尾部剩余空间，从缓冲开头继续
+        uint32_t waste = m_Capacity - m_Head;
+        if (m_Used + waste + aligned > m_Capacity)
+        {
+            ++m_Stats.failures;
+            return false;
+        }
+        m_Used += waste;
+        m_FrameBytes += waste;
+        m_Head = 0;
+        ++m_Stats.wraps;
+    }
+    else if (m_Used + aligned > m_Capacity)
+    {
+        ++m_Stats.failures;
+        return false;
+    }
+
+    *pOffset = m_Head;
+    m_Head += aligned;
+    m_Used += aligned;
+    m_FrameBytes += aligned;
+
+    ++m_Stats.allocations;
+    m_Stats.bytes += aligned;
+    return true;
+}
+
+void ConstantRing::EndFrame(uint64_t fence)
+{
+    assert(m_InFlight.empty() || m_InFlight.back().fence < fence);
+    FrameMarker marker;
+    marker.fence = fence;
+    marker.bytes = m_FrameBytes;
+    m_InFlight.push_back(marker);
+    m_FrameBytes = 0;
+}
+
+void ConstantRing::Retire(uint64_t completedFence)
+{
+    while (!m_InFlight.empty() && m_InFlight.front().fence <= completedFence)
+    {
+        assert(m_Used >= m_InFlight.front().bytes);
+        m_Used -= m_InFlight.front().bytes;
+        m_InFlight.pop_front();
+    }
+
+    // 没有任何在途数据时回到开头，减少不必要的回绕
+    if (m_Used == 0)
+        m_Head = 0;
+}
+
+uint32_t ConstantRing::GetCapacity() const
+{
+    return m_Capacity;
+}
+
+uint32_t ConstantRing::GetUsedBytes() const
+{
+    return m_Used;
+}
+
+size_t ConstantRing::GetFramesInFlight() const
+{
+    return m_InFlight.size();
+}
+
+const ConstantRing::Stats& ConstantRing::GetStats() const
+{
+    return m_Stats;
+}
+
+void ConstantRing::ResetStats()
+{
+    m_Stats = Stats();
+}
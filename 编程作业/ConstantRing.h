@@ -0,0 +1,65 @@
+//***************************************************************************************
+// ConstantRing.h
+//
+// 常量缓冲环形分配器：在一块大缓冲上按 256 字节槽位顺序分配每次绘制的常量，
+// 每帧结束时记录一个 fence，GPU 完成该帧后才回收对应区域。
+// 只负责偏移与回收的记账，不依赖 D3D，Map/绑定由调用方完成。
+//***************************************************************************************
+
+#ifndef CONSTANTRING_H
+#define CONSTANTRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+class ConstantRing
+{
+public:
+    // D3D11.1 的 *SetConstantBuffers1 偏移以 16 个常量（256 字节）为单位
+    static const uint32_t kSlotBytes = 256;
+
+    struct Stats
+    {
+        uint32_t allocations = 0;   // 成功分配次数
+        uint64_t bytes = 0;         // 分配的字节数（含对齐）
+        uint32_t wraps = 0;         // 回绕到缓冲开头的次数
+        uint32_t failures = 0;      // 因在途数据占满而失败的次数
+    };
+
+public:
+    ConstantRing();
+
+    void Init(uint32_t capacityBytes);      // 容量会向下对齐到槽位大小
+    void Reset();                           // 整块缓冲可用（例如 Map DISCARD 之后）
+
+    // 分配 size 字节，返回对齐到槽位的偏移；空间不足返回 false
+    bool Allocate(uint32_t size, uint32_t* pOffset);
+
+    void EndFrame(uint64_t fence);          // 把本帧分配的区域挂到 fence 上
+    void Retire(uint64_t completedFence);   // GPU 已完成 completedFence 及之前的帧
+
+    static uint32_t AlignSize(uint32_t size);
+
+    uint32_t GetCapacity() const;
+    uint32_t GetUsedBytes() const;
+    size_t GetFramesInFlight() const;
+    const Stats& GetStats() const;
+    void ResetStats();
+
+private:
+    struct FrameMarker
+    {
+        uint64_t fence;
+        uint32_t bytes;             // 该帧占用的字节数（含回绕时跳过的尾部）
+    };
+
+    uint32_t m_Capacity = 0;
+    uint32_t m_Head = 0;            // 下一次分配的位置
+    uint32_t m_Used = 0;            // 在途 + 本帧占用的字节数
+    uint32_t m_FrameBytes = 0;      // 本帧已占用的字节数
+    std::deque<FrameMarker> m_InFlight;
+    Stats m_Stats;
+};
+
+#endif
@@ -0,0 +1,405 @@
+#include "D3D11RenderDevice.h"
+#include "d3dUtil.h"
+#include "DXTrace.h"
+#include "PollBackoff.h"
+#include <cassert>
+#include <cstring>
+
+D3D11RenderDevice::D3D11RenderDevice(ID3D11Device* pDevice, ID3D11DeviceContext* pContext,
+    ID3D11DeviceContext1* pContext1, IDXGISwapChain* pSwapChain)
+    : m_pDevice(pDevice), m_pContext(pContext), m_pContext1(pContext1), m_pSwapChain(pSwapChain)
+{
+    assert(pDevice && pContext);
+
+    // 常量缓冲偏移绑定需要 D3D11.1 且驱动支持对动态常量缓冲使用 NO_OVERWRITE
+    if (m_pContext1)
+    {
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+        if (SUCCEEDED(m_pDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+            m_ConstantBufferOffsets = options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+    }
+
+    // 每帧结束时插入一个事件查询作为 fence
+    D3D11_QUERY_DESC queryDesc{};
+    queryDesc.Query = D3D11_QUERY_EVENT;
+    for (auto& query : m_pFences)
+        HR(m_pDevice->CreateQuery(&queryDesc, query.GetAddressOf()));
+
+    m_pImmediate.reset(new Context(*this, m_pContext.Get(), m_pContext1.Get(), &m_Stats));
+
+    // 交换链创建时带了可等待标志才能取可等待对象
+    DXGI_SWAP_CHAIN_DESC swapChainDesc{};
+    if (m_pSwapChain && SUCCEEDED(m_pSwapChain->GetDesc(&swapChainDesc)) &&
+        (swapChainDesc.Flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) &&
+        SUCCEEDED(m_pSwapChain.As(&m_pSwapChain2)))
+    {
+        m_FrameLatencyWaitable = m_pSwapChain2->GetFrameLatencyWaitableObject();
+    }
+}
+
+D3D11RenderDevice::~D3D11RenderDevice()
+{
+    if (m_FrameLatencyWaitable)
+        CloseHandle(m_FrameLatencyWaitable);
+}
+
+void D3D11RenderDevice::SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView,
+    ID3D11Texture2D* pResolveSource, ID3D11Texture2D* pResolveTarget)
+{
+    assert((pResolveSource == nullptr) == (pResolveTarget == nullptr));
+    m_pRenderTargetView = pRenderTargetView;
+    m_pDepthStencilView = pDepthStencilView;
+    m_pResolveSource = pResolveSource;
+    m_pResolveTarget = pResolveTarget;
+    m_ResolveFormat = DXGI_FORMAT_UNKNOWN;
+    if (pResolveTarget)
+    {
+        D3D11_TEXTURE2D_DESC desc;
+        pResolveTarget->GetDesc(&desc);
+        m_ResolveFormat = desc.Format;
+    }
+}
+
+void D3D11RenderDevice::SetVertexFormatShaders(VertexFormat format, ID3D11InputLayout* pInputLayout,
+    ID3D11VertexShader* pVertexShader)
+{
+    assert(format < VertexFormat::Count);
+    m_pInputLayouts[static_cast<size_t>(format)] = pInputLayout;
+    m_pVertexShaders[static_cast<size_t>(format)] = pVertexShader;
+}
+
+ID3D11Buffer* D3D11RenderDevice::GetBuffer(BufferHandle buffer) const
+{
+    if (buffer == kInvalidBuffer)
+        return nullptr;
+    assert(buffer <= m_Buffers.size());
+    return m_Buffers[buffer - 1].Get();
+}
+
+BufferHandle D3D11RenderDevice::CreateBuffer(const BufferDesc& desc, const void* pInitData)
+{
+    D3D11_BUFFER_DESC bd{};
+    bd.ByteWidth = desc.byteWidth;
+    switch (desc.type)
+    {
+    case BufferType::Vertex: bd.BindFlags = D3D11_BIND_VERTEX_BUFFER; break;
+    case BufferType::Index: bd.BindFlags = D3D11_BIND_INDEX_BUFFER; break;
+    case BufferType::Constant: bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER; break;
+    }
+    if (desc.usage == BufferUsage::Dynamic)
+    {
+        bd.Usage = D3D11_USAGE_DYNAMIC;
+        bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    }
+    else
+    {
+        assert(pInitData);
+        bd.Usage = D3D11_USAGE_IMMUTABLE;
+    }
+
+    D3D11_SUBRESOURCE_DATA initData{};
+    initData.pSysMem = pInitData;
+
+    ComPtr<ID3D11Buffer> pBuffer;
+    HR(m_pDevice->CreateBuffer(&bd, pInitData ? &initData : nullptr, pBuffer.GetAddressOf()));
+#if (defined(DEBUG) || defined(_DEBUG)) && (GRAPHICS_DEBUGGER_OBJECT_NAME)
+    if (desc.debugName)
+        pBuffer->SetPrivateData(WKPDID_D3DDebugObjectName, static_cast<UINT>(strlen(desc.debugName)), desc.debugName);
+#endif
+    m_Buffers.push_back(pBuffer);
+
+    ++m_Stats.bufferCreates;
+    return static_cast<BufferHandle>(m_Buffers.size());
+}
+
+void D3D11RenderDevice::WriteBuffer(BufferHandle buffer, MapMode mode, const BufferWrite* pWrites, uint32_t writeCount)
+{
+    ID3D11Buffer* pBuffer = GetBuffer(buffer);
+    assert(pBuffer);
+
+    D3D11_MAPPED_SUBRESOURCE mappedData{};
+    HR(m_pContext->Map(pBuffer, 0, mode == MapMode::Discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mappedData));
+    for (uint32_t i = 0; i < writeCount; ++i)
+    {
+        memcpy(static_cast<BYTE*>(mappedData.pData) + pWrites[i].offset, pWrites[i].pData, pWrites[i].size);
+        m_Stats.bytesWritten += pWrites[i].size;
+    }
+    m_pContext->Unmap(pBuffer, 0);
+    ++m_Stats.bufferWrites;
+}
+
+void D3D11RenderDevice::SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+    const uint32_t* pStrides, const uint32_t* pOffsets)
+{
+    m_pImmediate->SetVertexBuffers(startSlot, count, pBuffers, pStrides, pOffsets);
+}
+
+void D3D11RenderDevice::SetIndexBuffer(BufferHandle buffer)
+{
+    m_pImmediate->SetIndexBuffer(buffer);
+}
+
+void D3D11RenderDevice::SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+    uint32_t firstConstant, uint32_t numConstants)
+{
+    m_pImmediate->SetConstantBuffer(slot, buffer, firstConstant, numConstants);
+}
+
+void D3D11RenderDevice::SetVertexFormat(VertexFormat format)
+{
+    m_pImmediate->SetVertexFormat(format);
+}
+
+void D3D11RenderDevice::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+    uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+    m_pImmediate->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+}
+
+void D3D11RenderDevice::Clear(const float color[4])
+{
+    // 翻转模型的交换链在 Present 后会解除后备缓冲的绑定，每帧重新绑定
+    if (m_pRenderTargetView)
+    {
+        m_pContext->OMSetRenderTargets(1, m_pRenderTargetView.GetAddressOf(), m_pDepthStencilView.Get());
+        m_pContext->ClearRenderTargetView(m_pRenderTargetView.Get(), color);
+    }
+    if (m_pDepthStencilView)
+        m_pContext->ClearDepthStencilView(m_pDepthStencilView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+}
+
+void D3D11RenderDevice::Present()
+{
+    assert(m_pSwapChain);
+    if (m_pResolveSource)
+        m_pContext->ResolveSubresource(m_pResolveTarget.Get(), 0, m_pResolveSource.Get(), 0, m_ResolveFormat);
+    HR(m_pSwapChain->Present(0, 0));
+    ++m_Stats.presents;
+}
+
+void D3D11RenderDevice::ReleaseRenderTargets()
+{
+    // 交换链的后备缓冲还有引用（包括主上下文上的绑定）时 ResizeBuffers 返回 DXGI_ERROR_INVALID_CALL；
+    // 延迟上下文在 FinishCommandList 时已清空状态，命令列表执行后也已释放
+    m_pRenderTargetView.Reset();
+    m_pDepthStencilView.Reset();
+    m_pResolveSource.Reset();
+    m_pResolveTarget.Reset();
+    m_pContext->OMSetRenderTargets(0, nullptr, nullptr);
+}
+
+bool D3D11RenderDevice::PollFence(uint64_t fence, bool wait)
+{
+    ID3D11Query* pQuery = m_pFences[fence % kFenceCount].Get();
+    HRESULT hr = m_pContext->GetData(pQuery, nullptr, 0, wait ? 0 : D3D11_ASYNC_GETDATA_DONOTFLUSH);
+    // D3D11 的查询没有可以阻塞等待的事件，只能轮询：先短暂自旋，之后睡眠让出 CPU
+    PollBackoff backoff;
+    while (hr == S_FALSE && wait)
+    {
+        backoff.Wait();
+        hr = m_pContext->GetData(pQuery, nullptr, 0, 0);
+    }
+    return hr == S_OK;
+}
+
+void D3D11RenderDevice::InsertFence(uint64_t fence)
+{
+    // 查询对象按 fence % kFenceCount 复用，fence 需要逐帧连续递增
+    assert(fence == m_LastFence + 1);
+    // 要复用的查询对象还在途时必须先等它完成
+    while (m_CompletedFence + kFenceCount < fence && m_CompletedFence < m_LastFence)
+    {
+        if (!PollFence(m_CompletedFence + 1, true))
+            break;
+        ++m_CompletedFence;
+    }
+    m_pContext->End(m_pFences[fence % kFenceCount].Get());
+    m_LastFence = fence;
+}
+
+uint64_t D3D11RenderDevice::GetCompletedFence()
+{
+    // 只做非阻塞轮询
+    while (m_CompletedFence < m_LastFence && PollFence(m_CompletedFence + 1, false))
+        ++m_CompletedFence;
+    return m_CompletedFence;
+}
+
+bool D3D11RenderDevice::SupportsConstantBufferOffsets() const
+{
+    return m_ConstantBufferOffsets;
+}
+
+// ==== 帧延迟 ====
+void D3D11RenderDevice::SetMaximumFrameLatency(uint32_t frames)
+{
+    if (m_pSwapChain2)
+    {
+        HR(m_pSwapChain2->SetMaximumFrameLatency(frames));
+        return;
+    }
+    ComPtr<IDXGIDevice1> pDxgiDevice;
+    if (SUCCEEDED(m_pDevice.As(&pDxgiDevice)))
+        HR(pDxgiDevice->SetMaximumFrameLatency(frames));
+}
+
+bool D3D11RenderDevice::HasFrameLatencyWaitable() const
+{
+    return m_FrameLatencyWaitable != nullptr;
+}
+
+bool D3D11RenderDevice::WaitForFrameLatency(uint32_t timeoutMs)
+{
+    if (!m_FrameLatencyWaitable)
+        return false;
+    return WaitForSingleObjectEx(m_FrameLatencyWaitable, timeoutMs, TRUE) == WAIT_OBJECT_0;
+}
+
+// ==== 命令上下文：主上下文与延迟上下文的绑定和绘制 ====
+D3D11RenderDevice::Context::Context(const D3D11RenderDevice& device, ID3D11DeviceContext* pContext,
+    ID3D11DeviceContext1* pContext1, RenderDeviceStats* pStats)
+    : m_Device(device), m_pContext(pContext), m_pContext1(pContext1), m_pStats(pStats)
+{
+}
+
+void D3D11RenderDevice::Context::SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+    const uint32_t* pStrides, const uint32_t* pOffsets)
+{
+    assert(count <= kMaxVertexBuffers);
+    ID3D11Buffer* buffers[kMaxVertexBuffers] = {};
+    for (uint32_t i = 0; i < count; ++i)
+        buffers[i] = m_Device.GetBuffer(pBuffers[i]);
+    m_pContext->IASetVertexBuffers(startSlot, count, buffers, pStrides, pOffsets);
+    m_pStats->vertexBufferBinds += count;
+}
+
+void D3D11RenderDevice::Context::SetIndexBuffer(BufferHandle buffer)
+{
+    m_pContext->IASetIndexBuffer(m_Device.GetBuffer(buffer), DXGI_FORMAT_R16_UINT, 0);
+    ++m_pStats->indexBufferBinds;
+}
+
+void D3D11RenderDevice::Context::SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+    uint32_t firstConstant, uint32_t numConstants)
+{
+    ID3D11Buffer* pBuffer = m_Device.GetBuffer(buffer);
+    if (numConstants == 0)
+    {
+        m_pContext->VSSetConstantBuffers(slot, 1, &pBuffer);
+        m_pContext->PSSetConstantBuffers(slot, 1, &pBuffer);
+    }
+    else
+    {
+        assert(m_Device.m_ConstantBufferOffsets && m_pContext1);
+        // 部分运行时在只改变偏移时会忽略重新绑定，先解绑再绑定
+        ID3D11Buffer* nullBuffer = nullptr;
+        m_pContext1->VSSetConstantBuffers(slot, 1, &nullBuffer);
+        m_pContext1->PSSetConstantBuffers(slot, 1, &nullBuffer);
+        m_pContext1->VSSetConstantBuffers1(slot, 1, &pBuffer, &firstConstant, &numConstants);
+        m_pContext1->PSSetConstantBuffers1(slot, 1, &pBuffer, &firstConstant, &numConstants);
+    }
+    ++m_pStats->constantBufferBinds;
+}
+
+void D3D11RenderDevice::Context::SetVertexFormat(VertexFormat format)
+{
+    size_t index = static_cast<size_t>(format);
+    assert(index < kVertexFormatCount && m_Device.m_pInputLayouts[index]);
+    m_pContext->IASetInputLayout(m_Device.m_pInputLayouts[index].Get());
+    m_pContext->VSSetShader(m_Device.m_pVertexShaders[index].Get(), nullptr, 0);
+    ++m_pStats->vertexFormatBinds;
+}
+
+void D3D11RenderDevice::Context::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+    uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+    m_pContext->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+    ++m_pStats->drawCalls;
+    m_pStats->indicesDrawn += static_cast<uint64_t>(indexCount) * instanceCount;
+    m_pStats->instancesDrawn += instanceCount;
+}
+
+// ==== 并行录制：每个命令上下文一个延迟上下文，按需创建 ====
+uint32_t D3D11RenderDevice::GetMaxCommandContexts() const
+{
+    return kMaxDeferredContexts;
+}
+
+CommandContext* D3D11RenderDevice::BeginCommandContext(uint32_t index)
+{
+    assert(index < kMaxDeferredContexts);
+    while (m_DeferredContexts.size() <= index)
+        m_DeferredContexts.emplace_back(new DeferredContext());
+
+    DeferredContext& deferred = *m_DeferredContexts[index];
+    if (!deferred.pContext)
+    {
+        // 驱动不支持命令列表时运行时会模拟，仍然可以在多个线程上录制
+        HR(m_pDevice->CreateDeferredContext(0, deferred.pContext.GetAddressOf()));
+        if (m_pContext1)
+            HR(deferred.pContext.As(&deferred.pContext1));
+        deferred.pRecorder.reset(new Context(*this, deferred.pContext.Get(), deferred.pContext1.Get(), &deferred.stats));
+    }
+    deferred.stats.Reset();
+    deferred.pCommandList.Reset();
+    CopyPipelineState(deferred.pContext.Get());
+    return deferred.pRecorder.get();
+}
+
+void D3D11RenderDevice::EndCommandContext(uint32_t index)
+{
+    assert(index < m_DeferredContexts.size());
+    DeferredContext& deferred = *m_DeferredContexts[index];
+    HR(deferred.pContext->FinishCommandList(FALSE, deferred.pCommandList.ReleaseAndGetAddressOf()));
+}
+
+void D3D11RenderDevice::ExecuteCommandContexts(uint32_t count)
+{
+    assert(count <= m_DeferredContexts.size());
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        DeferredContext& deferred = *m_DeferredContexts[i];
+        assert(deferred.pCommandList);
+        // 保留主上下文状态，之后的绘制不需要重新设置着色器和渲染目标
+        m_pContext->ExecuteCommandList(deferred.pCommandList.Get(), TRUE);
+        deferred.pCommandList.Reset();
+        m_Stats.AddCommands(deferred.stats);
+    }
+}
+
+void D3D11RenderDevice::CopyPipelineState(ID3D11DeviceContext* pTarget)
+{
+    // 延迟上下文从默认状态开始，GameApp 在主上下文上设置的状态需要逐项复制
+    ComPtr<ID3D11InputLayout> pInputLayout;
+    m_pContext->IAGetInputLayout(pInputLayout.GetAddressOf());
+    pTarget->IASetInputLayout(pInputLayout.Get());
+    D3D11_PRIMITIVE_TOPOLOGY topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    m_pContext->IAGetPrimitiveTopology(&topology);
+    pTarget->IASetPrimitiveTopology(topology);
+
+    ComPtr<ID3D11VertexShader> pVertexShader;
+    m_pContext->VSGetShader(pVertexShader.GetAddressOf(), nullptr, nullptr);
+    pTarget->VSSetShader(pVertexShader.Get(), nullptr, 0);
+    ComPtr<ID3D11PixelShader> pPixelShader;
+    m_pContext->PSGetShader(pPixelShader.GetAddressOf(), nullptr, nullptr);
+    pTarget->PSSetShader(pPixelShader.Get(), nullptr, 0);
+
+    ComPtr<ID3D11RasterizerState> pRasterizerState;
+    m_pContext->RSGetState(pRasterizerState.GetAddressOf());
+    pTarget->RSSetState(pRasterizerState.Get());
+    D3D11_VIEWPORT viewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+    UINT viewportCount = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+    m_pContext->RSGetViewports(&viewportCount, viewports);
+    pTarget->RSSetViewports(viewportCount, viewports);
+
+    ComPtr<ID3D11DepthStencilState> pDepthStencilState;
+    UINT stencilRef = 0;
+    m_pContext->OMGetDepthStencilState(pDepthStencilState.GetAddressOf(), &stencilRef);
+    pTarget->OMSetDepthStencilState(pDepthStencilState.Get(), stencilRef);
+    ComPtr<ID3D11BlendState> pBlendState;
+    FLOAT blendFactor[4] = {};
+    UINT sampleMask = 0xffffffff;
+    m_pContext->OMGetBlendState(pBlendState.GetAddressOf(), blendFactor, &sampleMask);
+    pTarget->OMSetBlendState(pBlendState.Get(), blendFactor, sampleMask);
+    pTarget->OMSetRenderTargets(1, m_pRenderTargetView.GetAddressOf(), m_pDepthStencilView.Get());
+}
@@ -0,0 +1,146 @@
+//***************************************************************************************
+// D3D11RenderDevice.h
+//
+// RenderDevice 的 D3D11 实现：缓冲句柄对应 ID3D11Buffer，常量缓冲同时绑定到 VS/PS，
+// 帧 fence 用 D3D11_QUERY_EVENT 查询实现。顶点格式对应 GameApp 注册的输入布局和顶点着色器。
+// 命令上下文对应延迟上下文：录制时复制主上下文的着色器、输入布局、渲染目标等状态，
+// FinishCommandList 生成命令列表后在主上下文按顺序 ExecuteCommandList（保留主上下文状态）。
+// 交换链带 FRAME_LATENCY_WAITABLE_OBJECT 标志（DXGI 1.3 翻转模型）时可以等待交换链的可等待对象，
+// 否则只能通过 IDXGIDevice1::SetMaximumFrameLatency 限制驱动排队的帧数。
+//***************************************************************************************
+
+#ifndef D3D11RENDERDEVICE_H
+#define D3D11RENDERDEVICE_H
+
+#include "RenderDevice.h"
+#include <wrl/client.h>
+#include <d3d11_1.h>
+#include <dxgi1_3.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+class D3D11RenderDevice : public RenderDevice
+{
+public:
+    template <class T>
+    using ComPtr = Microsoft::WRL::ComPtr<T>;
+
+    // pContext1 可以为空（不支持 D3D11.1 时不使用常量缓冲偏移绑定）
+    D3D11RenderDevice(ID3D11Device* pDevice, ID3D11DeviceContext* pContext,
+        ID3D11DeviceContext1* pContext1, IDXGISwapChain* pSwapChain);
+    ~D3D11RenderDevice();
+
+    D3D11RenderDevice(const D3D11RenderDevice&) = delete;
+    D3D11RenderDevice& operator=(const D3D11RenderDevice&) = delete;
+
+    // 窗口大小改变后渲染目标会重建，需要重新设置
+    // 渲染目标是多重采样纹理时（翻转模型交换链 + MSAA）传入它和后备缓冲，Present 前解析过去
+    void SetRenderTargets(ID3D11RenderTargetView* pRenderTargetView, ID3D11DepthStencilView* pDepthStencilView,
+        ID3D11Texture2D* pResolveSource = nullptr, ID3D11Texture2D* pResolveTarget = nullptr);
+    // SetVertexFormat 切换到的输入布局和顶点着色器
+    void SetVertexFormatShaders(VertexFormat format, ID3D11InputLayout* pInputLayout, ID3D11VertexShader* pVertexShader);
+
+    BufferHandle CreateBuffer(const BufferDesc& desc, const void* pInitData) override;
+    void WriteBuffer(BufferHandle buffer, MapMode mode, const BufferWrite* pWrites, uint32_t writeCount) override;
+    using RenderDevice::WriteBuffer;
+
+    void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+        const uint32_t* pStrides, const uint32_t* pOffsets) override;
+    void SetIndexBuffer(BufferHandle buffer) override;
+    void SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+        uint32_t firstConstant = 0, uint32_t numConstants = 0) override;
+    void SetVertexFormat(VertexFormat format) override;
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+        uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+
+    void Clear(const float color[4]) override;
+    void Present() override;
+    void ReleaseRenderTargets() override;
+
+    void InsertFence(uint64_t fence) override;
+    uint64_t GetCompletedFence() override;
+
+    bool SupportsConstantBufferOffsets() const override;
+
+    // ==== 帧延迟：限制已提交但还没显示的帧数 ====
+    void SetMaximumFrameLatency(uint32_t frames);
+    bool HasFrameLatencyWaitable() const;
+    // 阻塞到交换链可以接受新的一帧，超时或没有可等待对象时返回 false
+    bool WaitForFrameLatency(uint32_t timeoutMs);
+
+    uint32_t GetMaxCommandContexts() const override;
+    CommandContext* BeginCommandContext(uint32_t index) override;
+    void EndCommandContext(uint32_t index) override;
+    void ExecuteCommandContexts(uint32_t count) override;
+
+    ID3D11Buffer* GetBuffer(BufferHandle buffer) const;
+
+private:
+    static const uint32_t kMaxVertexBuffers = 4;
+    static const uint32_t kFenceCount = 3;          // 同时在途的帧 fence 数
+    static const uint32_t kMaxDeferredContexts = 8;
+
+    // 绑定与绘制的实现，主上下文和延迟上下文共用，计数写入 pStats
+    class Context : public CommandContext
+    {
+    public:
+        Context(const D3D11RenderDevice& device, ID3D11DeviceContext* pContext,
+            ID3D11DeviceContext1* pContext1, RenderDeviceStats* pStats);
+
+        void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+            const uint32_t* pStrides, const uint32_t* pOffsets) override;
+        void SetIndexBuffer(BufferHandle buffer) override;
+        void SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+            uint32_t firstConstant = 0, uint32_t numConstants = 0) override;
+        void SetVertexFormat(VertexFormat format) override;
+        void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+            uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+
+    private:
+        const D3D11RenderDevice& m_Device;
+        ID3D11DeviceContext* m_pContext;
+        ID3D11DeviceContext1* m_pContext1;
+        RenderDeviceStats* m_pStats;
+    };
+
+    struct DeferredContext
+    {
+        ComPtr<ID3D11DeviceContext> pContext;
+        ComPtr<ID3D11DeviceContext1> pContext1;
+        ComPtr<ID3D11CommandList> pCommandList;
+        RenderDeviceStats stats;
+        std::unique_ptr<Context> pRecorder;
+    };
+
+    bool PollFence(uint64_t fence, bool wait);
+    // 把接口之外的管线状态从主上下文复制到延迟上下文
+    void CopyPipelineState(ID3D11DeviceContext* pTarget);
+
+    ComPtr<ID3D11Device>            m_pDevice;
+    ComPtr<ID3D11DeviceContext>     m_pContext;
+    ComPtr<ID3D11DeviceContext1>    m_pContext1;
+    ComPtr<IDXGISwapChain>          m_pSwapChain;
+    ComPtr<IDXGISwapChain2>         m_pSwapChain2;              // 仅在交换链可等待时非空
+    HANDLE                          m_FrameLatencyWaitable = nullptr;
+    ComPtr<ID3D11RenderTargetView>  m_pRenderTargetView;
+    ComPtr<ID3D11DepthStencilView>  m_pDepthStencilView;
+    ComPtr<ID3D11Texture2D>         m_pResolveSource;           // 仅在需要解析多重采样时非空
+    ComPtr<ID3D11Texture2D>         m_pResolveTarget;
+    DXGI_FORMAT                     m_ResolveFormat = DXGI_FORMAT_UNKNOWN;
+
+    std::vector<ComPtr<ID3D11Buffer>> m_Buffers;    // 句柄 - 1 即下标
+    static const size_t kVertexFormatCount = static_cast<size_t>(VertexFormat::Count);
+    std::array<ComPtr<ID3D11InputLayout>, kVertexFormatCount> m_pInputLayouts;
+    std::array<ComPtr<ID3D11VertexShader>, kVertexFormatCount> m_pVertexShaders;
+    bool m_ConstantBufferOffsets = false;
+
+    std::array<ComPtr<ID3D11Query>, kFenceCount> m_pFences;
+    uint64_t m_LastFence = 0;           // 最近插入的 fence
+    uint64_t m_CompletedFence = 0;      // GPU 已完成的最新 fence
+
+    std::unique_ptr<Context> m_pImmediate;
+    std::vector<std::unique_ptr<DeferredContext>> m_DeferredContexts;
+};
+
+#endif
@@ -0,0 +1,507 @@
+#include "ForestScene.h"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+#include "LaneMath.h"
+
+using namespace DirectX;
+
+// 小哈希，稳定随机选择 
+static inline int PickId(int x, int y, int z, int extra = 0)
+{
+    // 常用哈希技巧：互质大数混合，最后取低两位
+    unsigned int h = 2166136261u;
+    h = (h ^ (unsigned int)(x * 73856093)) * 16777619u;
+    h = (h ^ (unsigned int)(y * 19349663)) * 16777619u;
+    h = (h ^ (unsigned int)(z * 83492791)) * 16777619u;
+    h = (h ^ (unsigned int)(extra * 2654435761u));
+    return (int)(h & 3u); // 0..3
+}
+
+// 单元的子字数量
+static inline int CellOrbiterCount(const ForestParams& params, int ix, int iy, int iz)
+{
+    return params.orbitMin + ((ix * 7 + iy * 13 + iz * 17) % (std::max(1, params.orbitMax - params.orbitMin + 1)));
+}
+
+// 子字的公转角度，标量和 SIMD 两个版本共用，保证输入完全相同
+static inline void OrbiterAngles(float angle, int ix, int iy, int iz, int k, float* pYaw, float* pPitch)
+{
+    float phase = (ix * 23 + iy * 29 + iz * 31 + k * 11) * 0.37f;
+    *pYaw = angle * 1.6f + phase;
+    *pPitch = angle * 0.3f + phase * 0.2f;
+}
+
+#if defined(_XM_SSE_INTRINSICS_)
+// ==== SIMD 实例变换：4 个实例一组，lane 运算见 LaneMath.h ====
+static inline void LaneBroadcast(FXMMATRIX matrix, LaneMatrix& out)
+{
+    XMFLOAT4X4 f;
+    XMStoreFloat4x4(&f, matrix);
+    LaneBroadcast(&f.m[0][0], out);
+}
+
+// 主字和子字分别攒满 4 个再一起计算。实例在入组时就用 builder.Add 占好位置，
+// 因此输出顺序与标量版本相同；矩阵在计算完后按 (网格, 序号) 写回
+class InstanceTransformBatch
+{
+public:
+    InstanceTransformBatch(InstanceBuilder& builder, FXMMATRIX rotate, CXMMATRIX childScaleOffset)
+        : m_Builder(builder)
+    {
+        LaneBroadcast(rotate, m_Rotate);
+        LaneBroadcast(childScaleOffset, m_ChildScaleOffset);
+    }
+
+    void AddMain(int meshId, float scale, float x, float y, float z)
+    {
+        Reserve(meshId, m_MainSlots[m_MainCount]);
+        m_MainScale[m_MainCount] = scale;
+        m_MainX[m_MainCount] = x;
+        m_MainY[m_MainCount] = y;
+        m_MainZ[m_MainCount] = z;
+        if (++m_MainCount == 4)
+            FlushMain();
+    }
+
+    void AddOrbiter(int meshId, float yaw, float pitch, float scale, float x, float y, float z)
+    {
+        Reserve(meshId, m_OrbiterSlots[m_OrbiterCount]);
+        m_OrbiterYaw[m_OrbiterCount] = yaw;
+        m_OrbiterPitch[m_OrbiterCount] = pitch;
+        m_OrbiterScale[m_OrbiterCount] = scale;
+        m_OrbiterX[m_OrbiterCount] = x;
+        m_OrbiterY[m_OrbiterCount] = y;
+        m_OrbiterZ[m_OrbiterCount] = z;
+        if (++m_OrbiterCount == 4)
+            FlushOrbiters();
+    }
+
+    // 处理不足 4 个的剩余实例
+    void Flush()
+    {
+        if (m_MainCount > 0)
+            FlushMain();
+        if (m_OrbiterCount > 0)
+            FlushOrbiters();
+    }
+
+private:
+    struct Slot
+    {
+        int meshId;
+        uint32_t index;
+    };
+
+    void Reserve(int meshId, Slot& slot)
+    {
+        InstanceData& inst = m_Builder.Add(meshId);
+        inst.materialIndex = static_cast<uint32_t>(meshId);
+        slot.meshId = meshId;
+        slot.index = m_Builder.GetInstanceCount(meshId) - 1;
+    }
+
+    // 不足 4 个时用第一个实例的输入填满空 lane，避免对未初始化数据做运算
+    static void PadLanes(float* pValues, int count)
+    {
+        for (int lane = count; lane < 4; ++lane)
+            pValues[lane] = pValues[0];
+    }
+
+    // 主字：(S * R) * T
+    void FlushMain()
+    {
+        PadLanes(m_MainScale, m_MainCount);
+        PadLanes(m_MainX, m_MainCount);
+        PadLanes(m_MainY, m_MainCount);
+        PadLanes(m_MainZ, m_MainCount);
+
+        LaneMatrix scale, scaleRotate, translate, world;
+        LaneScaling(_mm_load_ps(m_MainScale), scale);
+        LaneMultiply(scale, m_Rotate, scaleRotate);
+        LaneTranslation(_mm_load_ps(m_MainX), _mm_load_ps(m_MainY), _mm_load_ps(m_MainZ), translate);
+        LaneMultiply(scaleRotate, translate, world);
+        Store(world, m_MainSlots, m_MainCount);
+        m_MainCount = 0;
+    }
+
+    // 子字：(((Sc * O) * (Ry * Rx)) * S) * T，Sc * O 对所有子字相同
+    void FlushOrbiters()
+    {
+        PadLanes(m_OrbiterYaw, m_OrbiterCount);
+        PadLanes(m_OrbiterPitch, m_OrbiterCount);
+        PadLanes(m_OrbiterScale, m_OrbiterCount);
+        PadLanes(m_OrbiterX, m_OrbiterCount);
+        PadLanes(m_OrbiterY, m_OrbiterCount);
+        PadLanes(m_OrbiterZ, m_OrbiterCount);
+
+        LaneMatrix rotateY, rotateX, rotate, a, b;
+        LaneRotationY(_mm_load_ps(m_OrbiterYaw), rotateY);
+        LaneRotationX(_mm_load_ps(m_OrbiterPitch), rotateX);
+        LaneMultiply(rotateY, rotateX, rotate);
+        LaneMultiply(m_ChildScaleOffset, rotate, a);
+        LaneScaling(_mm_load_ps(m_OrbiterScale), rotateY);
+        LaneMultiply(a, rotateY, b);
+        LaneTranslation(_mm_load_ps(m_OrbiterX), _mm_load_ps(m_OrbiterY), _mm_load_ps(m_OrbiterZ), rotateX);
+        LaneMultiply(b, rotateX, a);
+        Store(a, m_OrbiterSlots, m_OrbiterCount);
+        m_OrbiterCount = 0;
+    }
+
+    // 把每行的 4 个元素转置成 4 个实例各自的一行，直接写入实例数据。
+    // 实例缓冲按 InstanceData 逐实例排列（输入布局每实例读 4 行矩阵 + 材质索引），
+    // 所以这里在寄存器中转置后一次写成最终布局，不再经过 SoA 中间数组
+    void Store(const LaneMatrix& world, const Slot* pSlots, int count)
+    {
+        float* pDst[4];
+        for (int lane = 0; lane < count; ++lane)
+            pDst[lane] = m_Builder.GetInstances(pSlots[lane].meshId)[pSlots[lane].index].world[0];
+
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128 r0 = world.m[i][0], r1 = world.m[i][1], r2 = world.m[i][2], r3 = world.m[i][3];
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            const __m128 rows[4] = { r0, r1, r2, r3 };
+            for (int lane = 0; lane < count; ++lane)
+                _mm_storeu_ps(pDst[lane] + i * 4, rows[lane]);
+        }
+    }
+
+private:
+    InstanceBuilder& m_Builder;
+    LaneMatrix m_Rotate;                    // 主字共用的旋转
+    LaneMatrix m_ChildScaleOffset;          // 子字共用的缩放 * 偏移
+
+    alignas(16) float m_MainScale[4];
+    alignas(16) float m_MainX[4];
+    alignas(16) float m_MainY[4];
+    alignas(16) float m_MainZ[4];
+    Slot m_MainSlots[4];
+    int m_MainCount = 0;
+
+    alignas(16) float m_OrbiterYaw[4];
+    alignas(16) float m_OrbiterPitch[4];
+    alignas(16) float m_OrbiterScale[4];
+    alignas(16) float m_OrbiterX[4];
+    alignas(16) float m_OrbiterY[4];
+    alignas(16) float m_OrbiterZ[4];
+    Slot m_OrbiterSlots[4];
+    int m_OrbiterCount = 0;
+};
+#endif
+
+ForestScene::ForestScene()
+{
+}
+
+void ForestScene::Init()
+{
+    // ==== 许双博第四次作业修改：初始化材质和光照 ====
+    // 为四个汉字模型设置不同的材质颜色和高光参数
+    {
+        // 材质0：偏红色
+        m_Materials[0].ambient  = XMFLOAT3(0.3f, 0.05f, 0.05f);
+        m_Materials[0].diffuse  = XMFLOAT3(0.7f, 0.2f, 0.2f);
+        m_Materials[0].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        m_Materials[0].shininess= 32.0f;
+        // 材质1：偏绿色
+        m_Materials[1].ambient  = XMFLOAT3(0.05f, 0.3f, 0.05f);
+        m_Materials[1].diffuse  = XMFLOAT3(0.2f, 0.7f, 0.2f);
+        m_Materials[1].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        m_Materials[1].shininess= 32.0f;
+        // 材质2：偏蓝色
+        m_Materials[2].ambient  = XMFLOAT3(0.05f, 0.05f, 0.3f);
+        m_Materials[2].diffuse  = XMFLOAT3(0.2f, 0.2f, 0.7f);
+        m_Materials[2].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        m_Materials[2].shininess= 32.0f;
+        // 材质3：偏黄色
+        m_Materials[3].ambient  = XMFLOAT3(0.3f, 0.3f, 0.05f);
+        m_Materials[3].diffuse  = XMFLOAT3(0.7f, 0.7f, 0.2f);
+        m_Materials[3].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        m_Materials[3].shininess= 32.0f;
+    }
+    // 初始化光源
+    {
+        // 点光源（索引0）
+        m_Lights[0].type     = 1;
+        m_Lights[0].enabled  = 1;
+        m_Lights[0].position = XMFLOAT3(0.0f, 10.0f, 0.0f);
+        m_Lights[0].range    = 30.0f;
+        m_Lights[0].direction= XMFLOAT3(0.0f, -1.0f, 0.0f);
+        m_Lights[0].spot     = XM_PIDIV4; // unused
+        m_Lights[0].ambient  = XMFLOAT3(0.05f, 0.05f, 0.05f);
+        m_Lights[0].diffuse  = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        m_Lights[0].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        // 聚光灯（索引1）
+        m_Lights[1].type     = 2;
+        m_Lights[1].enabled  = 1;
+        m_Lights[1].position = XMFLOAT3(0.0f, 0.0f, 0.0f); // 由 SetSpotLight 每帧更新
+        m_Lights[1].direction= XMFLOAT3(0.0f, 0.0f, 1.0f);
+        m_Lights[1].range    = 80.0f;
+        m_Lights[1].spot     = XMConvertToRadians(30.0f); // 30度
+        m_Lights[1].ambient  = XMFLOAT3(0.0f, 0.0f, 0.0f);
+        m_Lights[1].diffuse  = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        m_Lights[1].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        // 方向光（索引2）
+        m_Lights[2].type     = 0;
+        m_Lights[2].enabled  = 1;
+        // 随机化方向以避免每次都一致
+        // 用自己的生成器（与 MSVC 的 rand() 算法和默认种子相同，方向与以前一致），
+        // 不受其他代码调用 rand() 的影响，每次 Init 的结果相同，仿真才能重现
+        {
+            uint32_t seed = 1;
+            auto random = [&seed]()
+            {
+                seed = seed * 214013u + 2531011u;
+                return static_cast<float>((seed >> 16) & 0x7fff) / 32767.0f;
+            };
+            float rx = random() * 2.0f - 1.0f;
+            float ry = random() * 2.0f - 1.0f;
+            float rz = random() * 2.0f - 1.0f;
+            XMVECTOR dir = XMVector3Normalize(XMVectorSet(rx, ry, rz, 0.0f));
+            XMStoreFloat3(&m_Lights[2].direction, dir);
+        }
+        m_Lights[2].position = XMFLOAT3(0.0f, 0.0f, 0.0f);
+        m_Lights[2].range    = 0.0f;
+        m_Lights[2].spot     = 0.0f;
+        m_Lights[2].ambient  = XMFLOAT3(0.1f, 0.1f, 0.1f);
+        m_Lights[2].diffuse  = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        m_Lights[2].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
+    }
+}
+
+void ForestScene::Update(float dt)
+{
+    //m_Angle += 0.5f * dt;//控制旋转
+
+    // ==== 许双博第四次作业修改：更新光源动画和方向 ====
+    // 更新累计时间
+    m_TotalTime += dt;
+    // 动画路径：萤火虫在字符森林间来回运动
+    {
+        float radius = (m_Params.n - 1) * m_Params.spacing * 0.6f;
+        float yBase  = 2.0f + (m_Params.n * 0.2f);
+        float x = static_cast<float>(std::sin(m_TotalTime * 0.7)) * radius;
+        float z = static_cast<float>(std::cos(m_TotalTime * 1.3)) * radius;
+        float y = yBase + static_cast<float>(std::sin(m_TotalTime * 2.0)) * (radius * 0.1f);
+        m_Lights[0].position = XMFLOAT3(x, y, z);
+        // 点光源颜色可以缓慢变化以模拟萤火虫色彩
+        float t = (static_cast<float>(std::sin(m_TotalTime * 0.5)) + 1.0f) * 0.5f;
+        m_Lights[0].diffuse  = XMFLOAT3(0.8f + 0.2f * t, 0.8f * (1.0f - t), 1.0f);
+        m_Lights[0].specular = m_Lights[0].diffuse;
+    }
+}
+
+void ForestScene::SetSpotLight(const XMFLOAT3& position, const XMFLOAT3& direction)
+{
+    m_Lights[1].position = position;
+    m_Lights[1].direction = direction;
+}
+
+void ForestScene::ToggleLight(int index)
+{
+    assert(index >= 0 && index < 3);
+    m_Lights[index].enabled = m_Lights[index].enabled ? 0 : 1;
+}
+
+ForestScene ForestScene::Interpolate(const ForestScene& previous, const ForestScene& current, float alpha)
+{
+    ForestScene result = current;
+    result.m_Angle = previous.m_Angle + (current.m_Angle - previous.m_Angle) * alpha;
+    result.m_TotalTime = previous.m_TotalTime + (current.m_TotalTime - previous.m_TotalTime) * alpha;
+    for (size_t i = 0; i < result.m_Lights.size(); ++i)
+    {
+        const Light& a = previous.m_Lights[i];
+        const Light& b = current.m_Lights[i];
+        Light& light = result.m_Lights[i];
+        XMStoreFloat3(&light.position, XMVectorLerp(XMLoadFloat3(&a.position), XMLoadFloat3(&b.position), alpha));
+        XMStoreFloat3(&light.diffuse, XMVectorLerp(XMLoadFloat3(&a.diffuse), XMLoadFloat3(&b.diffuse), alpha));
+        XMStoreFloat3(&light.specular, XMVectorLerp(XMLoadFloat3(&a.specular), XMLoadFloat3(&b.specular), alpha));
+        // 方向插值后重新归一化；两步方向相反时保留当前方向
+        XMVECTOR direction = XMVectorLerp(XMLoadFloat3(&a.direction), XMLoadFloat3(&b.direction), alpha);
+        if (XMVectorGetX(XMVector3LengthSq(direction)) > 1e-8f)
+            XMStoreFloat3(&light.direction, XMVector3Normalize(direction));
+    }
+    return result;
+}
+
+int ForestScene::GetCellCount() const
+{
+    return m_Params.n * m_Params.n * m_Params.n;
+}
+
+void ForestScene::BuildCellBounds(float glyphRadius, SphereSoA& bounds, int ixBegin, int ixEnd) const
+{
+    const int n = m_Params.n;
+    const float spacing = m_Params.spacing;
+    const float c = (n - 1) * 0.5f;
+    assert(bounds.Size() == static_cast<size_t>(GetCellCount()));
+    if (ixEnd < 0) ixEnd = n;
+
+    size_t cell = static_cast<size_t>(ixBegin) * n * n;
+    for (int ix = ixBegin; ix < ixEnd; ++ix)
+        for (int iy = 0; iy < n; ++iy)
+            for (int iz = 0; iz < n; ++iz, ++cell)
+            {
+                // 主字绕自身中心旋转，半径为 scale * glyphRadius；
+                // 子字中心离主字中心 scale * orbitRadius，自身再缩放 0.25
+                float scale = CellScale(ix, iy, iz);
+                float radius = glyphRadius;
+                if (CellOrbiterCount(m_Params, ix, iy, iz) > 0)
+                    radius = std::max(radius, m_Params.orbitRadius + 0.25f * glyphRadius);
+
+                bounds.x[cell] = (ix - c) * spacing;
+                bounds.y[cell] = (iy - c) * spacing;
+                bounds.z[cell] = (iz - c) * spacing;
+                bounds.r[cell] = scale * radius;
+            }
+}
+
+int ForestScene::GetCellMainGlyph(int cell, XMFLOAT4X4* pWorld) const
+{
+    const int n = m_Params.n;
+    assert(cell >= 0 && cell < GetCellCount());
+    const int ix = cell / (n * n), iy = (cell / n) % n, iz = cell % n;
+    const float c = (n - 1) * 0.5f;
+
+    float scale = CellScale(ix, iy, iz);
+    XMMATRIX mRotate = XMMatrixRotationX(m_Angle) * XMMatrixRotationY(m_Angle * 0.7f);
+    XMMATRIX mTranslate = XMMatrixTranslation((ix - c) * m_Params.spacing, (iy - c) * m_Params.spacing, (iz - c) * m_Params.spacing);
+    XMStoreFloat4x4(pWorld, XMMatrixScaling(scale, scale, scale) * mRotate * mTranslate);
+    return PickId(ix, iy, iz);
+}
+
+void ForestScene::BuildInstances(InstanceBuilder& builder, const uint8_t* pCellVisible, int ixBegin, int ixEnd) const
+{
+#if defined(_XM_SSE_INTRINSICS_)
+    const int n = m_Params.n;
+    const float spacing = m_Params.spacing;
+    const float c = (n - 1) * 0.5f;
+    XMMATRIX mRotate = XMMatrixRotationX(m_Angle) * XMMatrixRotationY(m_Angle * 0.7f);
+    XMMATRIX mChildScaleOffset = XMMatrixScaling(0.25f, 0.25f, 0.25f) * XMMatrixTranslation(m_Params.orbitRadius, 0.0f, 0.0f);
+    if (ixEnd < 0) ixEnd = n;
+
+    // 缩放按 iz 方向 4 个单元一组计算；逐单元只做标量的选字和角度计算，矩阵运算交给 4 路并行的批处理
+    InstanceTransformBatch batch(builder, mRotate, mChildScaleOffset);
+    std::vector<float> rowScales((n + 3) & ~3);
+    int cell = ixBegin * n * n;
+    for (int ix = ixBegin; ix < ixEnd; ++ix)
+        for (int iy = 0; iy < n; ++iy)
+        {
+            for (int iz = 0; iz < n; iz += 4)
+                _mm_storeu_ps(&rowScales[iz], LaneCellScale(ix, iy, iz));
+
+            for (int iz = 0; iz < n; ++iz, ++cell)
+            {
+                if (pCellVisible && !pCellVisible[cell])
+                    continue;
+
+                float scale = rowScales[iz];
+                float x = (ix - c) * spacing;
+                float y = (iy - c) * spacing;
+                float z = (iz - c) * spacing;
+                batch.AddMain(PickId(ix, iy, iz), scale, x, y, z);
+
+                int nOrbiters = CellOrbiterCount(m_Params, ix, iy, iz);
+                for (int k = 0; k < nOrbiters; ++k)
+                {
+                    float yaw, pitch;
+                    OrbiterAngles(m_Angle, ix, iy, iz, k, &yaw, &pitch);
+                    batch.AddOrbiter(PickId(ix, iy, iz, k + 12345), yaw, pitch, scale, x, y, z);
+                }
+            }
+        }
+    batch.Flush();
+#else
+    BuildInstancesReference(builder, pCellVisible, ixBegin, ixEnd);
+#endif
+}
+
+void ForestScene::BuildInstancesReference(InstanceBuilder& builder, const uint8_t* pCellVisible, int ixBegin, int ixEnd) const
+{
+    const int n = m_Params.n;
+    const float spacing = m_Params.spacing;
+    const float c = (n - 1) * 0.5f;
+    XMMATRIX mRotate = XMMatrixRotationX(m_Angle) * XMMatrixRotationY(m_Angle * 0.7f);
+    if (ixEnd < 0) ixEnd = n;
+
+    int cell = ixBegin * n * n;
+    for (int ix = ixBegin; ix < ixEnd; ++ix)
+        for (int iy = 0; iy < n; ++iy)
+            for (int iz = 0; iz < n; ++iz, ++cell)
+            {
+                // 视锥外的单元整体跳过
+                if (pCellVisible && !pCellVisible[cell])
+                    continue;
+
+                // 稳定随机选择一个主字 id 
+                int id = PickId(ix, iy, iz);
+
+                // —— 不同尺寸：伪随机缩放 ——
+                float scale = CellScale(ix, iy, iz);
+                XMMATRIX mScale = XMMatrixScaling(scale, scale, scale);
+
+                XMMATRIX mTranslate = XMMatrixTranslation(
+                    (ix - c) * spacing,
+                    (iy - c) * spacing,
+                    (iz - c) * spacing
+                );
+
+                // 主字：S * R * T（实例矩阵不转置，着色器中按行读取）
+                InstanceData& inst = builder.Add(id);
+                XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(inst.world), mScale * mRotate * mTranslate);
+                inst.materialIndex = static_cast<uint32_t>(id);
+
+                // —— 子字围绕主字公转（随机挑选字）——
+                int nOrbiters = CellOrbiterCount(m_Params, ix, iy, iz);
+
+                for (int k = 0; k < nOrbiters; ++k)
+                {
+                    int childId = PickId(ix, iy, iz, k + 12345);    // ==== 许双博改的：子字随机 id ====
+
+                    float yaw, pitch;
+                    OrbiterAngles(m_Angle, ix, iy, iz, k, &yaw, &pitch);
+                    XMMATRIX mChildRot = XMMatrixRotationY(yaw) * XMMatrixRotationX(pitch);
+                    XMMATRIX mChildScale = XMMatrixScaling(0.25f, 0.25f, 0.25f);
+                    XMMATRIX mChildOffset = XMMatrixTranslation(m_Params.orbitRadius, 0.0f, 0.0f);
+
+                    XMMATRIX worldChild = mChildScale * mChildOffset * mChildRot * mScale * mTranslate;
+                    InstanceData& child = builder.Add(childId);
+                    XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(child.world), worldChild);
+                    child.materialIndex = static_cast<uint32_t>(childId);
+                }
+            }
+}
+
+ForestParams& ForestScene::GetParams()
+{
+    return m_Params;
+}
+
+const ForestParams& ForestScene::GetParams() const
+{
+    return m_Params;
+}
+
+const std::array<Light, 3>& ForestScene::GetLights() const
+{
+    return m_Lights;
+}
+
+const std::array<Material, ForestScene::kGlyphCount>& ForestScene::GetMaterials() const
+{
+    return m_Materials;
+}
+
+bool ForestScene::IsLightEnabled(int index) const
+{
+    assert(index >= 0 && index < 3);
+    return m_Lights[index].enabled != 0;
+}
+
+double ForestScene::GetTotalTime() const
+{
+    return m_TotalTime;
+}
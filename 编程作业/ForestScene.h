@@ -0,0 +1,79 @@
+//***************************************************************************************
+// ForestScene.h
+//
+// 字符森林场景：N×N×N 的主字阵列、围绕主字公转的子字、光源动画与材质表。
+// 只负责场景状态和每帧的实例生成，不涉及窗口、输入和 D3D。
+//***************************************************************************************
+
+#ifndef FORESTSCENE_H
+#define FORESTSCENE_H
+
+#include "SceneConstants.h"
+#include "InstanceBuilder.h"
+#include "FrustumCuller.h"
+#include <array>
+
+// 阵列参数，由键盘调整
+struct ForestParams
+{
+    int     n = 10;
+    float   spacing = 4.5f;
+    float   orbitRadius = 2.5f;
+    int     orbitMin = 1;
+    int     orbitMax = 3;
+};
+
+class ForestScene
+{
+public:
+    static const int kGlyphCount = 4;       // 网格 id 0..3 为四个字
+
+public:
+    ForestScene();
+
+    void Init();                            // 初始化材质和光源
+    void Update(float dt);                  // 光源动画
+    // 聚光灯跟随相机
+    void SetSpotLight(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& direction);
+    void ToggleLight(int index);
+    // ==== 固定步长仿真：在上一步和当前步之间插值动画状态（光源、时间），其余取 current ====
+    static ForestScene Interpolate(const ForestScene& previous, const ForestScene& current, float alpha);
+
+    // 单元数量 n³，单元编号为 (ix * n + iy) * n + iz
+    int GetCellCount() const;
+    // ==== 视锥剔除：每个单元（主字及其子字）的包围球，glyphRadius 为字网格的包围半径 ====
+    // bounds 需预先调整为 GetCellCount() 个；只填写 ix 属于 [ixBegin, ixEnd) 的单元，ixEnd < 0 表示到 n
+    void BuildCellBounds(float glyphRadius, SphereSoA& bounds, int ixBegin = 0, int ixEnd = -1) const;
+    // ==== 遮挡剔除：单元主字的网格 id 和世界矩阵（与 BuildInstances 相同，行主序未转置） ====
+    int GetCellMainGlyph(int cell, DirectX::XMFLOAT4X4* pWorld) const;
+    // 把本帧所有主字/子字追加到 builder 中（网格 id 即字 id）
+    // pCellVisible 非空时跳过对应值为 0 的单元；只生成 ix 属于 [ixBegin, ixEnd) 的单元，便于按切片并行
+    // 有 SSE 时 4 个实例一组并行计算世界矩阵，乘法顺序与 DirectXMath 完全一致，结果逐位相同
+    // （由 Tests/ForestSceneTests 与 BuildInstancesReference 逐位比较，4 路运算见 LaneMath.h 与 Tests/LaneMathTests）
+    void BuildInstances(InstanceBuilder& builder, const uint8_t* pCellVisible = nullptr,
+        int ixBegin = 0, int ixEnd = -1) const;
+    // 逐实例调用 DirectXMath 的标量版本，作为 SIMD 版本的对照
+    void BuildInstancesReference(InstanceBuilder& builder, const uint8_t* pCellVisible = nullptr,
+        int ixBegin = 0, int ixEnd = -1) const;
+
+    ForestParams& GetParams();
+    const ForestParams& GetParams() const;
+    const std::array<Light, 3>& GetLights() const;
+    const std::array<Material, kGlyphCount>& GetMaterials() const;
+    bool IsLightEnabled(int index) const;
+    double GetTotalTime() const;
+
+private:
+    ForestParams m_Params;
+    float m_Angle = 0.0f;
+
+    // ==== 许双博第四次作业修改：材质与光照相关字段 ====
+    // 每个汉字模型的材质参数（Ambient/Diffuse/Specular/Shininess）
+    std::array<Material, kGlyphCount> m_Materials{};
+    // 存储三个光源（点光、聚光、方向光）
+    std::array<Light, 3> m_Lights{};
+    // 用于动画的累积时间
+    double m_TotalTime = 0.0;       // 双精度累计，长时间运行后动画仍然平滑
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "FrameLimiter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // 滑动均值的权重，约最近 10 次睡眠起主要作用
+    const double kSleepEstimateWeight = 0.1;
+}
+
+FrameLimiter::FrameLimiter(MonotonicClock& clock)
+    : m_pClock(&clock)
+{
+}
+
+void FrameLimiter::SetTargetFrameRate(double fps)
+{
+    m_TargetFrameRate = fps > 0.0 ? fps : 0.0;
+    m_PeriodNs = fps > 0.0 ? static_cast<uint64_t>(1e9 / fps) : 0;
+    Reset();
+}
+
+double FrameLimiter::GetTargetFrameRate() const
+{
+    return m_TargetFrameRate;
+}
+
+bool FrameLimiter::IsEnabled() const
+{
+    return m_PeriodNs > 0;
+}
+
+void FrameLimiter::Reset()
+{
+    m_Started = false;
+}
+
+void FrameLimiter::Wait()
+{
+    if (m_PeriodNs == 0)
+        return;
+
+    uint64_t now = m_pClock->NowNs();
+    if (!m_Started)
+    {
+        m_Started = true;
+        m_NextFrameNs = now + m_PeriodNs;
+        return;
+    }
+
+    uint64_t target = m_NextFrameNs;
+    if (now >= target)
+    {
+        // 帧本身超时：不等待；落后不到一个周期时保持节拍，否则从当前时刻重新计时
+        ++m_Stats.lateFrames;
+        m_NextFrameNs = now - target < m_PeriodNs ? target + m_PeriodNs : now + m_PeriodNs;
+        return;
+    }
+
+    // 粗睡眠：剩余时间足够一次睡眠（按估计耗时）时才睡
+    while (target - now > m_SleepEstimateNs)
+    {
+        uint64_t before = now;
+        m_pClock->SleepNs(kSleepQuantumNs);
+        now = m_pClock->NowNs();
+        UpdateSleepEstimate(now - before);
+        m_Stats.sleepNs += now - before;
+        if (now >= target)
+            break;
+    }
+
+    // 自旋补足剩余时间
+    uint64_t spinStart = now;
+    while (now < target)
+        now = m_pClock->NowNs();
+    m_Stats.spinNs += now - spinStart;
+
+    uint64_t error = now - target;
+    ++m_Stats.waitedFrames;
+    m_Stats.totalErrorNs += error;
+    m_Stats.maxErrorNs = std::max(m_Stats.maxErrorNs, error);
+    m_NextFrameNs = error < m_PeriodNs ? target + m_PeriodNs : now + m_PeriodNs;
+}
+
+void FrameLimiter::UpdateSleepEstimate(uint64_t observedNs)
+{
+    double delta = static_cast<double>(observedNs) - m_SleepMeanNs;
+    m_SleepMeanNs += kSleepEstimateWeight * delta;
+    m_SleepVarianceNs2 = (1.0 - kSleepEstimateWeight) * (m_SleepVarianceNs2 + kSleepEstimateWeight * delta * delta);
+    m_SleepEstimateNs = static_cast<uint64_t>(m_SleepMeanNs + std::sqrt(m_SleepVarianceNs2));
+}
+
+uint64_t FrameLimiter::GetSleepEstimateNs() const
+{
+    return m_SleepEstimateNs;
+}
+
+const FrameLimiter::Stats& FrameLimiter::GetStats() const
+{
+    return m_Stats;
+}
+
+void FrameLimiter::ResetStats()
+{
+    m_Stats = Stats();
+}
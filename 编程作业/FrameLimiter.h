@@ -0,0 +1,72 @@
+//***************************************************************************************
+// FrameLimiter.h
+//
+// 帧率限制：每帧结束时等到下一帧的目标时刻，避免消息循环空转占满一个核心。
+// 等待分两段：剩余时间较长时按 kSleepQuantumNs 粗睡眠，把 CPU 让给其他线程；
+// 剩余时间不足一次睡眠的估计耗时后改为自旋读时钟，保证醒来时刻的精度。
+// 睡眠的实际耗时随系统定时精度变化，按观测值的滑动均值 + 标准差自适应估计。
+// 目标时刻按固定周期递推，不随单帧误差漂移；帧本身超时时不追赶，从当前时刻重新计时。
+//***************************************************************************************
+
+#ifndef FRAMELIMITER_H
+#define FRAMELIMITER_H
+
+#include "MonotonicClock.h"
+#include <cstdint>
+
+class FrameLimiter
+{
+public:
+    static const uint64_t kSleepQuantumNs = 1000000;        // 每次粗睡眠请求的时长
+    static const uint64_t kInitialSleepEstimateNs = 2000000;
+
+    // 自上次 ResetStats 以来的统计
+    struct Stats
+    {
+        uint32_t waitedFrames = 0;      // 提前完成、等待过的帧
+        uint32_t lateFrames = 0;        // 完成时已经超过目标时刻的帧
+        uint64_t totalErrorNs = 0;      // 醒来时刻与目标时刻之差的累计
+        uint64_t maxErrorNs = 0;
+        uint64_t sleepNs = 0;           // 粗睡眠的总时长
+        uint64_t spinNs = 0;            // 自旋的总时长
+
+        double AverageErrorMs() const { return waitedFrames ? totalErrorNs / 1e6 / waitedFrames : 0.0; }
+    };
+
+public:
+    explicit FrameLimiter(MonotonicClock& clock = MonotonicClock::GetSystemClock());
+
+    // fps <= 0 时不限制
+    void SetTargetFrameRate(double fps);
+    double GetTargetFrameRate() const;
+    bool IsEnabled() const;
+
+    // 暂停恢复后调用，下一帧从当前时刻重新计时
+    void Reset();
+    // 每帧结束时调用：等到下一帧的目标时刻
+    void Wait();
+
+    // 当前对一次粗睡眠实际耗时的估计
+    uint64_t GetSleepEstimateNs() const;
+    const Stats& GetStats() const;
+    void ResetStats();
+
+private:
+    void UpdateSleepEstimate(uint64_t observedNs);
+
+private:
+    MonotonicClock* m_pClock;
+    double m_TargetFrameRate = 0.0;
+    uint64_t m_PeriodNs = 0;
+    bool m_Started = false;
+    uint64_t m_NextFrameNs = 0;         // 下一帧的目标时刻
+
+    // 粗睡眠耗时的指数滑动均值与方差
+    double m_SleepMeanNs = static_cast<double>(kInitialSleepEstimateNs);
+    double m_SleepVarianceNs2 = 0.0;
+    uint64_t m_SleepEstimateNs = kInitialSleepEstimateNs;
+
+    Stats m_Stats;
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cassert>
+
+FramePacer::FramePacer(uint32_t maxFramesInFlight)
+    : m_MaxFramesInFlight(std::max(1u, maxFramesInFlight))
+{
+}
+
+void FramePacer::SetMaxFramesInFlight(uint32_t frames)
+{
+    m_MaxFramesInFlight = std::max(1u, frames);
+}
+
+uint32_t FramePacer::GetMaxFramesInFlight() const
+{
+    return m_MaxFramesInFlight;
+}
+
+void FramePacer::BeginFrame(uint64_t nowNs)
+{
+    assert(m_State == State::Idle);
+    m_State = State::Waiting;
+    m_Throttled = false;
+    m_Current = FrameTiming();
+    m_Current.frameIndex = m_FrameIndex;
+    m_Current.beginNs = nowNs;
+}
+
+bool FramePacer::TryStart(uint64_t completedFence, uint64_t nowNs)
+{
+    assert(m_State == State::Waiting);
+    Retire(completedFence, nowNs);
+    if (m_InFlight.size() >= m_MaxFramesInFlight)
+    {
+        m_Throttled = true;
+        return false;
+    }
+
+    m_State = State::Recording;
+    m_Current.startNs = nowNs;
+    if (m_Throttled)
+        ++m_Stats.throttledFrames;
+    return true;
+}
+
+void FramePacer::EndFrame(uint64_t fence, uint64_t nowNs)
+{
+    assert(m_State == State::Recording);
+    assert(m_InFlight.empty() || fence > m_InFlight.back().fence);
+    m_Current.fence = fence;
+    m_Current.submitNs = nowNs;
+    m_Current.pendingNs = nowNs;
+    m_InFlight.push_back(m_Current);
+    m_State = State::Idle;
+    ++m_FrameIndex;
+}
+
+void FramePacer::Retire(uint64_t completedFence, uint64_t nowNs)
+{
+    while (!m_InFlight.empty() && m_InFlight.front().fence <= completedFence)
+    {
+        FrameTiming& frame = m_InFlight.front();
+        frame.completeNs = std::max(nowNs, frame.submitNs);
+
+        ++m_Stats.completedFrames;
+        m_Stats.totalLatencyNs += frame.LatencyNs();
+        m_Stats.maxLatencyNs = std::max(m_Stats.maxLatencyNs, frame.LatencyNs());
+        m_Stats.totalWaitNs += frame.WaitNs();
+        m_Stats.totalUncertaintyNs += frame.CompletionUncertaintyNs();
+
+        m_LastCompleted = frame;
+        m_InFlight.pop_front();
+    }
+    for (FrameTiming& frame : m_InFlight)
+        frame.pendingNs = std::max(frame.pendingNs, nowNs);
+}
+
+FramePacer::State FramePacer::GetState() const
+{
+    return m_State;
+}
+
+uint32_t FramePacer::GetFramesInFlight() const
+{
+    return static_cast<uint32_t>(m_InFlight.size());
+}
+
+uint64_t FramePacer::GetFrameIndex() const
+{
+    return m_FrameIndex;
+}
+
+const FramePacer::FrameTiming& FramePacer::GetLastCompletedFrame() const
+{
+    return m_LastCompleted;
+}
+
+const FramePacer::Stats& FramePacer::GetStats() const
+{
+    return m_Stats;
+}
+
+void FramePacer::ResetStats()
+{
+    m_Stats = Stats();
+}
@@ -0,0 +1,101 @@
+//***************************************************************************************
+// FramePacer.h
+//
+// 在途帧控制：限制 CPU 领先 GPU 的帧数，并统计每帧的等待时间和延迟。
+// 每帧的状态依次为 Idle → Waiting（BeginFrame）→ Recording（TryStart 成功）→ Idle（EndFrame）。
+// 只有在途（已提交但 GPU 未完成）的帧数低于上限时才允许开始录制，
+// 因此输入总是在尽量晚的时刻采样，输入到画面的延迟有上界且更稳定。
+// 时间和 fence 都由调用方传入（纳秒），不读取系统时钟，可以用假时钟驱动测试。
+// GPU 完成只能靠轮询 fence 观察：completeNs 是第一次观察到完成的时刻，pendingNs 是最后一次观察到
+// 未完成的时刻，实际完成时刻在两者之间。轮询点由调用方决定，GameApp 在以下位置轮询：
+//   1. EndFrame 之后（Present 返回时），调用 Retire
+//   2. 帧限制等待结束、下一帧 UpdateScene 开始时，调用 Retire
+//   3. BeginFrame 之后等待在途帧数降低的循环中，调用 TryStart
+// 两个轮询点之间的 CPU 工作和睡眠只体现在误差 CompletionUncertaintyNs 中，不会不加区分地计入延迟。
+//***************************************************************************************
+
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <cstdint>
+#include <deque>
+
+class FramePacer
+{
+public:
+    enum class State
+    {
+        Idle,
+        Waiting,        // 等待在途帧数降到上限以下
+        Recording       // 正在准备和提交本帧
+    };
+
+    struct FrameTiming
+    {
+        uint64_t frameIndex = 0;
+        uint64_t fence = 0;         // 本帧提交后插入的 fence
+        uint64_t beginNs = 0;       // BeginFrame
+        uint64_t startNs = 0;       // 等待结束，开始录制（此时采样输入）
+        uint64_t submitNs = 0;      // EndFrame
+        uint64_t pendingNs = 0;     // 最后一次轮询时本帧仍未完成（提交时即为 submitNs）
+        uint64_t completeNs = 0;    // 第一次轮询到 GPU 完成本帧
+
+        uint64_t WaitNs() const { return startNs - beginNs; }
+        uint64_t CpuNs() const { return submitNs - startNs; }
+        // 从采样输入到观察到 GPU 完成
+        uint64_t LatencyNs() const { return completeNs - startNs; }
+        // 实际完成时刻在 (pendingNs, completeNs] 内，延迟最多比实际多出这么多
+        uint64_t CompletionUncertaintyNs() const { return completeNs - pendingNs; }
+    };
+
+    // 自上次 ResetStats 以来已完成帧的统计
+    struct Stats
+    {
+        uint32_t completedFrames = 0;
+        uint64_t totalLatencyNs = 0;
+        uint64_t maxLatencyNs = 0;
+        uint64_t totalWaitNs = 0;
+        uint64_t totalUncertaintyNs = 0;
+        uint32_t throttledFrames = 0;   // 因在途帧数达到上限而等待过的帧
+
+        double AverageLatencyMs() const { return completedFrames ? totalLatencyNs / 1e6 / completedFrames : 0.0; }
+        double AverageUncertaintyMs() const { return completedFrames ? totalUncertaintyNs / 1e6 / completedFrames : 0.0; }
+        double AverageWaitMs() const { return completedFrames ? totalWaitNs / 1e6 / completedFrames : 0.0; }
+    };
+
+public:
+    explicit FramePacer(uint32_t maxFramesInFlight = 2);
+
+    // 至少为 1
+    void SetMaxFramesInFlight(uint32_t frames);
+    uint32_t GetMaxFramesInFlight() const;
+
+    // Idle → Waiting
+    void BeginFrame(uint64_t nowNs);
+    // Waiting：先按 completedFence 回收已完成的帧，在途帧数低于上限时进入 Recording 并返回 true
+    bool TryStart(uint64_t completedFence, uint64_t nowNs);
+    // Recording → Idle，本帧以 fence 进入在途列表
+    void EndFrame(uint64_t fence, uint64_t nowNs);
+    // 轮询点，任意状态下都可以调用：fence 不超过 completedFence 的在途帧记为在 nowNs 完成，
+    // 其余在途帧记为在 nowNs 仍未完成
+    void Retire(uint64_t completedFence, uint64_t nowNs);
+
+    State GetState() const;
+    uint32_t GetFramesInFlight() const;
+    uint64_t GetFrameIndex() const;                 // 当前（或下一）帧的编号
+    const FrameTiming& GetLastCompletedFrame() const;
+    const Stats& GetStats() const;
+    void ResetStats();
+
+private:
+    uint32_t m_MaxFramesInFlight;
+    State m_State = State::Idle;
+    uint64_t m_FrameIndex = 0;
+    bool m_Throttled = false;               // 当前帧是否因在途帧数达到上限而等待过
+    FrameTiming m_Current;
+    std::deque<FrameTiming> m_InFlight;     // 按提交顺序
+    FrameTiming m_LastCompleted;
+    Stats m_Stats;
+};
+
+#endif
@@ -0,0 +1,43 @@
+//***************************************************************************************
+// FrameStats.h
+//
+// 每帧渲染统计：绘制调用次数、上传到 GPU 的字节数等。
+//***************************************************************************************
+
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <cstdint>
+
+struct FrameStats
+{
+    uint32_t drawCalls = 0;         // 实际发出的绘制调用
+    uint32_t legacyDrawCalls = 0;   // 逐物体绘制时需要的绘制调用
+    uint32_t instanceCount = 0;     // 实例总数
+    uint32_t stateBinds = 0;        // 渲染队列实际执行的网格/材质绑定
+    uint32_t bindsAvoided = 0;      // 渲染队列跳过的重复绑定
+    uint32_t cellsVisible = 0;      // 通过视锥剔除的单元（主字及其子字）
+    uint32_t cellsCulled = 0;       // 被视锥剔除的单元
+    uint32_t cellsOccluded = 0;     // 在视锥内但被近处的字完全挡住而剔除的单元
+    uint32_t cullTests = 0;         // 八叉树节点与单元包围球的测试次数（逐单元剔除时为单元总数）
+    uint32_t commandLists = 0;      // 并行录制的命令列表数（0 表示直接在设备上提交）
+
+    uint32_t constantUploads = 0;   // 常量缓冲 Map/Unmap 次数
+    uint64_t constantBytes = 0;     // 常量缓冲上传字节数
+    uint64_t instanceBytes = 0;     // 实例缓冲上传字节数
+
+    uint64_t vertexBytes = 0;       // 绘制读取的顶点数据：网格顶点数 × 顶点步长 × 实例数
+    uint64_t floatVertexBytes = 0;  // 同样的绘制全部使用 Float 顶点格式时的字节数
+
+    void Reset() { *this = FrameStats(); }
+
+    void AddConstantUpload(uint64_t bytes)
+    {
+        ++constantUploads;
+        constantBytes += bytes;
+    }
+
+    uint64_t UploadedBytes() const { return constantBytes + instanceBytes; }
+};
+
+#endif
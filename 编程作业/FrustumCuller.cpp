@@ -0,0 +1,189 @@
+#include "FrustumCuller.h"
+#include <cassert>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define FRUSTUM_CULLER_SSE 1
+#include <xmmintrin.h>
+#if defined(__AVX__)
+#define FRUSTUM_CULLER_AVX 1
+#include <immintrin.h>
+#endif
+#endif
+
+FrustumCuller::FrustumCuller()
+{
+    // 默认所有平面都接受任意球
+    for (int i = 0; i < 6; ++i)
+    {
+        m_Planes[i][0] = m_Planes[i][1] = m_Planes[i][2] = 0.0f;
+        m_Planes[i][3] = 1.0f;
+    }
+}
+
+void FrustumCuller::SetViewProj(const float viewProj[16])
+{
+    // 行向量约定下裁剪坐标的各分量是矩阵的列：x = v·col0, y = v·col1, z = v·col2, w = v·col3
+    // 视锥内部满足 -w <= x <= w, -w <= y <= w, 0 <= z <= w
+    const float* m = viewProj;
+    float col[4][4];
+    for (int c = 0; c < 4; ++c)
+        for (int r = 0; r < 4; ++r)
+            col[c][r] = m[r * 4 + c];
+
+    for (int k = 0; k < 4; ++k)
+    {
+        m_Planes[0][k] = col[3][k] + col[0][k];     // 左
+        m_Planes[1][k] = col[3][k] - col[0][k];     // 右
+        m_Planes[2][k] = col[3][k] + col[1][k];     // 下
+        m_Planes[3][k] = col[3][k] - col[1][k];     // 上
+        m_Planes[4][k] = col[2][k];                 // 近
+        m_Planes[5][k] = col[3][k] - col[2][k];     // 远
+    }
+
+    // 归一化后平面方程的值就是到平面的有符号距离，可以直接和半径比较
+    for (int i = 0; i < 6; ++i)
+    {
+        float len = std::sqrt(m_Planes[i][0] * m_Planes[i][0] + m_Planes[i][1] * m_Planes[i][1]
+            + m_Planes[i][2] * m_Planes[i][2]);
+        if (len > 0.0f)
+        {
+            float inv = 1.0f / len;
+            for (int k = 0; k < 4; ++k)
+                m_Planes[i][k] *= inv;
+        }
+    }
+}
+
+const float* FrustumCuller::GetPlane(int index) const
+{
+    assert(index >= 0 && index < 6);
+    return m_Planes[index];
+}
+
+bool FrustumCuller::IsSphereVisible(float x, float y, float z, float r) const
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        const float* p = m_Planes[i];
+        float dist = ((p[0] * x + p[1] * y) + p[2] * z) + p[3];
+        if (!(dist >= -r))
+            return false;
+    }
+    return true;
+}
+
+FrustumCuller::Containment FrustumCuller::Classify(float x, float y, float z, float r) const
+{
+    bool intersect = false;
+    for (int i = 0; i < 6; ++i)
+    {
+        const float* p = m_Planes[i];
+        float dist = ((p[0] * x + p[1] * y) + p[2] * z) + p[3];
+        if (!(dist >= -r))
+            return Containment::Outside;
+        if (dist < r)
+            intersect = true;
+    }
+    return intersect ? Containment::Intersect : Containment::Inside;
+}
+
+uint32_t FrustumCuller::CullScalar(const float* pX, const float* pY, const float* pZ, const float* pR,
+    uint32_t begin, uint32_t end, uint8_t* pVisible) const
+{
+    uint32_t visible = 0;
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        bool inside = IsSphereVisible(pX[i], pY[i], pZ[i], pR[i]);
+        pVisible[i] = inside ? 1 : 0;
+        visible += inside ? 1 : 0;
+    }
+    return visible;
+}
+
+uint32_t FrustumCuller::Cull(const float* pX, const float* pY, const float* pZ, const float* pR,
+    uint32_t count, uint8_t* pVisible) const
+{
+    uint32_t visible = 0;
+    uint32_t i = 0;
+
+#if defined(FRUSTUM_CULLER_AVX)
+    // ==== AVX：一次 8 个球 ====
+    {
+        __m256 planes[6][4];
+        for (int p = 0; p < 6; ++p)
+            for (int k = 0; k < 4; ++k)
+                planes[p][k] = _mm256_set1_ps(m_Planes[p][k]);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(pX + i);
+            __m256 y = _mm256_loadu_ps(pY + i);
+            __m256 z = _mm256_loadu_ps(pZ + i);
+            __m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(pR + i));
+
+            __m256 inside = _mm256_cmp_ps(x, x, _CMP_EQ_OQ);
+            for (int p = 0; p < 6; ++p)
+            {
+                __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(planes[p][0], x), _mm256_mul_ps(planes[p][1], y)),
+                    _mm256_mul_ps(planes[p][2], z)), planes[p][3]);
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, negR, _CMP_GE_OQ));
+            }
+
+            int mask = _mm256_movemask_ps(inside);
+            for (int k = 0; k < 8; ++k)
+            {
+                uint8_t bit = static_cast<uint8_t>((mask >> k) & 1);
+                pVisible[i + k] = bit;
+                visible += bit;
+            }
+        }
+    }
+#endif
+
+#if defined(FRUSTUM_CULLER_SSE)
+    // ==== SSE：一次 4 个球 ====
+    {
+        __m128 planes[6][4];
+        for (int p = 0; p < 6; ++p)
+            for (int k = 0; k < 4; ++k)
+                planes[p][k] = _mm_set1_ps(m_Planes[p][k]);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(pX + i);
+            __m128 y = _mm_loadu_ps(pY + i);
+            __m128 z = _mm_loadu_ps(pZ + i);
+            __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(pR + i));
+
+            __m128 inside = _mm_cmpeq_ps(x, x);     // 全 1（NaN 分量会在比较中自然得到 0）
+            for (int p = 0; p < 6; ++p)
+            {
+                __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(planes[p][0], x), _mm_mul_ps(planes[p][1], y)),
+                    _mm_mul_ps(planes[p][2], z)), planes[p][3]);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, negR));
+            }
+
+            int mask = _mm_movemask_ps(inside);
+            for (int k = 0; k < 4; ++k)
+            {
+                uint8_t bit = static_cast<uint8_t>((mask >> k) & 1);
+                pVisible[i + k] = bit;
+                visible += bit;
+            }
+        }
+    }
+#endif
+
+    // 剩余不足一组的球（或没有 SSE 时的全部球）
+    visible += CullScalar(pX, pY, pZ, pR, i, count, pVisible);
+    return visible;
+}
+
+uint32_t FrustumCuller::Cull(const SphereSoA& spheres, uint8_t* pVisible) const
+{
+    return Cull(spheres.x.data(), spheres.y.data(), spheres.z.data(), spheres.r.data(),
+        static_cast<uint32_t>(spheres.Size()), pVisible);
+}
@@ -0,0 +1,72 @@
+//***************************************************************************************
+// FrustumCuller.h
+//
+// 视锥剔除：从 view * proj 矩阵提取六个平面，对 SoA 排列的包围球批量测试。
+// 有 SSE 时一次测试 4 个球，编译时启用 AVX 则一次 8 个，其余情况退回标量版本；
+// 各版本的运算顺序相同，结果一致。
+//***************************************************************************************
+
+#ifndef FRUSTUMCULLER_H
+#define FRUSTUMCULLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 包围球数组（SoA），便于一次加载多个球的同一分量
+struct SphereSoA
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> r;
+
+    void Resize(size_t count)
+    {
+        x.resize(count);
+        y.resize(count);
+        z.resize(count);
+        r.resize(count);
+    }
+    size_t Size() const { return r.size(); }
+};
+
+class FrustumCuller
+{
+public:
+    // 包围球与视锥的关系：完全在外、与边界相交、完全在内
+    enum class Containment
+    {
+        Outside,
+        Intersect,
+        Inside
+    };
+
+public:
+    FrustumCuller();
+
+    // viewProj 为行向量约定（clip = v * M）的 view * proj，按行主序存放（XMFLOAT4X4 布局，未转置）
+    // 深度范围按 D3D 的 [0, w] 计算近平面
+    void SetViewProj(const float viewProj[16]);
+
+    // 平面 (a, b, c, d) 已归一化，法线指向视锥内部
+    const float* GetPlane(int index) const;
+
+    // 测试单个球，与批量版本结果一致
+    bool IsSphereVisible(float x, float y, float z, float r) const;
+    // 区分“完全在内”和“相交”，供层次剔除整体接受子树
+    Containment Classify(float x, float y, float z, float r) const;
+    // 批量测试：pVisible[i] 写 1（可见）或 0（剔除），返回可见的数量
+    uint32_t Cull(const float* pX, const float* pY, const float* pZ, const float* pR,
+        uint32_t count, uint8_t* pVisible) const;
+    uint32_t Cull(const SphereSoA& spheres, uint8_t* pVisible) const;
+
+private:
+    uint32_t CullScalar(const float* pX, const float* pY, const float* pZ, const float* pR,
+        uint32_t begin, uint32_t end, uint8_t* pVisible) const;
+
+private:
+    float m_Planes[6][4];
+};
+
+#endif
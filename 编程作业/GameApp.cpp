@@ -5,6 +5,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <mmsystem.h>
 
 #ifdef max
 #undef max
@@ -25,15 +26,60 @@ const D3D11_INPUT_ELEMENT_DESC GameApp::VertexPosColor::inputLayout[3] = {
     { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0 }
 };
 
+// ==== 实例化绘制：在顶点布局后追加槽1的逐实例数据 ====
+const D3D11_INPUT_ELEMENT_DESC GameApp::VertexPosColor::instancedInputLayout[8] = {
+    { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    { "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    // 世界矩阵的四行，每行 4 * 4字节 = 16字节
+    { "WORLD",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    { "WORLD",    1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    { "WORLD",    2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    { "WORLD",    3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    // 材质索引：紧随矩阵之后
+    { "MATERIAL", 0, DXGI_FORMAT_R32_UINT,           1, 64, D3D11_INPUT_PER_INSTANCE_DATA, 1 }
+};
+static_assert(sizeof(InstanceData) == 68, "InstanceData 需要与 instancedInputLayout 保持一致");
+static_assert(sizeof(GameApp::VertexPosColor) == sizeof(FloatVertex), "VertexPosColor 需要与 FloatVertex 保持一致");
+
+// ==== 压缩顶点格式：位置 UNORM16（相对包围盒）、八面体法线 SNORM16、颜色 UNORM8，共 16 字节 ====
+const D3D11_INPUT_ELEMENT_DESC GameApp::VertexPacked::instancedInputLayout[8] = {
+    { "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    { "NORMAL",   0, DXGI_FORMAT_R16G16_SNORM,       0, 8,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    { "COLOR",    0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    { "WORLD",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    { "WORLD",    1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    { "WORLD",    2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    { "WORLD",    3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    { "MATERIAL", 0, DXGI_FORMAT_R32_UINT,           1, 64, D3D11_INPUT_PER_INSTANCE_DATA, 1 }
+};
+
+const double GameApp::kSimulationRate = 120.0;
+
+// ==== 离线烘焙的字形网格（GlyphCooker 生成），下标即网格 id：许、王、尚、秦 ====
+static const char* const kGlyphMeshPaths[4] = {
+    "Models\\xu.gmesh", "Models\\wang.gmesh", "Models\\sh.gmesh", "Models\\qin.gmesh"
+};
+
+// 在途帧控制使用的时间戳（纳秒）
+static uint64_t FramePacerNow()
+{
+    return MonotonicClock::GetSystemClock().NowNs();
+}
+
 GameApp::GameApp(HINSTANCE hInstance)
-    : D3DApp(hInstance), m_CBuffer()
+    : D3DApp(hInstance)
 {
 }
 
 GameApp::~GameApp()
 {
-    // 释放4个模型 
-    for (auto& m : m_Models) { delete m; m = nullptr; }
+    // 仿真线程访问场景和相机状态，必须在其他成员析构前停止
+    if (m_Simulation.IsRunning())
+    {
+        m_Simulation.Stop();
+        timeEndPeriod(1);
+    }
 }
 
 bool GameApp::Init()
@@ -41,97 +87,88 @@ bool GameApp::Init()
     if (!D3DApp::Init())       return false;
     if (!InitEffect())         return false;
     if (!InitResource())       return false;
+
+    if (!m_ReplayPath.empty())
+    {
+        if (!m_ReplayFile.Open(m_ReplayPath.c_str()))
+        {
+            MessageBoxW(m_hMainWnd, L"无法打开回放文件", L"回放", MB_OK | MB_ICONERROR);
+            return false;
+        }
+        m_pReplayer.reset(new CaptureReplayer(m_pRenderDevice.get()));
+        return true;
+    }
+
+    // ==== 仿真与渲染分离：先同步发布一份快照，保证渲染线程第一帧就有数据 ====
+    m_PendingAspectRatio = AspectRatio();
+    m_SceneSimulation.SetAspectRatio(AspectRatio());
+    m_PreviousScene = m_SceneSimulation.GetScene();
+    m_PreviousView = m_SceneSimulation.BuildSceneView();
+    PublishSnapshot();
+    m_Snapshots.Acquire();
+    timeBeginPeriod(1);     // 仿真线程按 ~8ms 周期休眠，需要 1ms 的系统定时精度
+    m_Simulation.Start([this](uint64_t tick, float dt) { Simulate(tick, dt); }, [this]() { PublishSnapshot(); },
+        kSimulationRate);
     return true;
 }
 
-void GameApp::OnResize()
+void GameApp::SetReplayFile(const std::string& path)
 {
-    D3DApp::OnResize();
-    UpdateProjectionMatrix();   // ==== 保持飞行相机的投影矩阵 ====
-    ApplyViewMatrix();          // ==== 视角更新 ====
+    m_ReplayPath = path;
 }
 
-void GameApp::UpdateScene(float dt)
+void GameApp::SetMaxFramesInFlight(uint32_t frames)
 {
-    if (m_KeyCooldown > 0.0f) m_KeyCooldown -= dt;
-    //angle += 0.5f * dt;//控制旋转
+    m_FramePacer.SetMaxFramesInFlight(std::min(frames, kMaxFramesInFlight));
+}
 
-#define CLAMP(v, lo, hi)  ((v) < (lo) ? (lo) : ((v) > (hi) ? (hi) : (v)))
+void GameApp::SetPackedVertices(bool enabled)
+{
+    m_PackedVertices = enabled;
+}
 
-    if (m_KeyCooldown <= 0.0f)
-    {
-        if (GetAsyncKeyState(VK_OEM_PLUS) & 0x8000) { m_N = CLAMP(m_N + 1, 1, 200); if (m_CameraMode == CameraMode::AutoFit) UpdateCameraForCube(); m_KeyCooldown = 0.20f; }
-        else if (GetAsyncKeyState(VK_OEM_MINUS) & 0x8000) { m_N = CLAMP(m_N - 1, 1, 200); if (m_CameraMode == CameraMode::AutoFit) UpdateCameraForCube(); m_KeyCooldown = 0.20f; }
-        else if (GetAsyncKeyState(VK_OEM_4) & 0x8000) { m_Spacing = std::max(1.0f, m_Spacing - 0.5f); if (m_CameraMode == CameraMode::AutoFit) UpdateCameraForCube(); m_KeyCooldown = 0.10f; }
-        else if (GetAsyncKeyState(VK_OEM_6) & 0x8000) { m_Spacing = std::min(20.0f, m_Spacing + 0.5f); if (m_CameraMode == CameraMode::AutoFit) UpdateCameraForCube(); m_KeyCooldown = 0.10f; }
-        else if (GetAsyncKeyState(VK_OEM_COMMA) & 0x8000) { m_OrbitMax = std::max(0, m_OrbitMax - 1); m_OrbitMin = std::min(m_OrbitMin, m_OrbitMax); m_KeyCooldown = 0.10f; }
-        else if (GetAsyncKeyState(VK_OEM_PERIOD) & 0x8000) { m_OrbitMax = std::min(6, m_OrbitMax + 1); m_KeyCooldown = 0.10f; }
-        // 在处理光照按键前读取 Shift 状态
-        bool shiftPressed = (GetAsyncKeyState(VK_SHIFT) & 0x8000);
-        // 光照开关：按 1/2/3 切换点光源、聚光灯、方向光
-        if ((GetAsyncKeyState('1') & 0x8000) && !shiftPressed) {
-            m_PointLightEnabled = !m_PointLightEnabled;
-            m_Lights[0].enabled = m_PointLightEnabled ? 1 : 0;
-            m_KeyCooldown = 0.20f;
-        }
-        else if ((GetAsyncKeyState('2') & 0x8000) && !shiftPressed) {
-            m_SpotLightEnabled = !m_SpotLightEnabled;
-            m_Lights[1].enabled = m_SpotLightEnabled ? 1 : 0;
-            m_KeyCooldown = 0.20f;
-        }
-        else if ((GetAsyncKeyState('3') & 0x8000) && !shiftPressed) {
-            m_DirLightEnabled = !m_DirLightEnabled;
-            m_Lights[2].enabled = m_DirLightEnabled ? 1 : 0;
-            m_KeyCooldown = 0.20f;
-        }
-        //else if (GetAsyncKeyState('1') & 0x8000) { SetCameraMode(CameraMode::FirstPerson); m_KeyCooldown = 0.20f; }
-        //else if (GetAsyncKeyState('2') & 0x8000) { SetCameraMode(CameraMode::ThirdPerson); m_KeyCooldown = 0.20f; }
-        //else if (GetAsyncKeyState('3') & 0x8000) { SetCameraMode(CameraMode::FreeFlight); m_KeyCooldown = 0.20f; }
-        //else if (GetAsyncKeyState('0') & 0x8000) { SetCameraMode(CameraMode::AutoFit); m_KeyCooldown = 0.20f; }
-        // 检查是否同时按下 Shift 键切换视角
-        if (shiftPressed)
-        {
-            if (GetAsyncKeyState('1') & 0x8000) { SetCameraMode(CameraMode::FirstPerson); m_KeyCooldown = 0.20f; }
-            else if (GetAsyncKeyState('2') & 0x8000) { SetCameraMode(CameraMode::ThirdPerson); m_KeyCooldown = 0.20f; }
-            else if (GetAsyncKeyState('3') & 0x8000) { SetCameraMode(CameraMode::FreeFlight); m_KeyCooldown = 0.20f; }
-            else if (GetAsyncKeyState('0') & 0x8000) { SetCameraMode(CameraMode::AutoFit); m_KeyCooldown = 0.20f; }
-        }
+void GameApp::OnResize()
+{
+    // 渲染设备持有后备缓冲视图的引用，先释放才能在 D3DApp::OnResize 中调整交换链大小
+    if (m_pRenderDevice)
+        m_pRenderDevice->ReleaseRenderTargets();
+    D3DApp::OnResize();
+    // 渲染目标在 D3DApp::OnResize 中重建
+    if (m_pRenderDevice)
+        m_pRenderDevice->SetRenderTargets(m_pRenderTargetView.Get(), m_pDepthStencilView.Get(),
+            m_pMsaaRenderTarget.Get(), m_pBackBuffer.Get());
+    // 仿真线程运行后投影矩阵由它在下一步中更新
+    m_PendingAspectRatio = AspectRatio();
+    if (!m_Simulation.IsRunning())
+        m_SceneSimulation.SetAspectRatio(AspectRatio());
+}
 
-    }
+// ==== 仿真与渲染分离：渲染线程上传加载完成的网格并更新标题（快照在 DrawScene 等待结束后才取） ====
+void GameApp::UpdateScene(float dt)
+{
+    if (m_pReplayer)
+        return;
 
-    // ==== 许双博第四次作业修改：更新光源动画和方向 ====
-    // 更新累计时间
-    m_TotalTime += dt;
-    // 动画路径：萤火虫在字符森林间来回运动
-    {
-        float radius = (m_N - 1) * m_Spacing * 0.6f;
-        float yBase  = 2.0f + (m_N * 0.2f);
-        float x = std::sinf(m_TotalTime * 0.7f) * radius;
-        float z = std::cosf(m_TotalTime * 1.3f) * radius;
-        float y = yBase + std::sinf(m_TotalTime * 2.0f) * (radius * 0.1f);
-        m_Lights[0].position = DirectX::XMFLOAT3(x, y, z);
-        // 点光源颜色可以缓慢变化以模拟萤火虫色彩
-        float t = (std::sinf(m_TotalTime * 0.5f) + 1.0f) * 0.5f;
-        m_Lights[0].diffuse  = DirectX::XMFLOAT3(0.8f + 0.2f * t, 0.8f * (1.0f - t), 1.0f);
-        m_Lights[0].specular = m_Lights[0].diffuse;
-    }
-    // 更新聚光灯位置和方向绑定到相机
-    {
-        // 位置跟随相机眼睛
-        m_Lights[1].position = m_CameraPos;
-        // 方向指向相机前方
-        DirectX::XMVECTOR fwd = GetForwardVector(m_CameraYaw, m_CameraPitch);
-        DirectX::XMStoreFloat3(&m_Lights[1].direction, fwd);
-    }
+    // 帧限制等待刚结束，在这里轮询一次 GPU 完成（FramePacer.h 中的轮询点 2）
+    m_FramePacer.Retire(m_pCaptureDevice->GetCompletedFence(), FramePacerNow());
+    UploadLoadedMeshes();
+    const SceneSnapshot& snapshot = m_Snapshots.GetReadBuffer();
 
     static float acc = 0.0f; static int frames = 0;
+    static uint64_t lastTick = 0;
     acc += dt; frames++;
     if (acc >= 0.5f)
     {
         float fps = frames / acc;
-        wchar_t title[256];
+        float simRate = (m_Simulation.GetTickCount() - lastTick) / acc;
+        lastTick = m_Simulation.GetTickCount();
+        const ForestParams& params = snapshot.scene.GetParams();
+        wchar_t title[448];
+        const FrameStats& stats = m_SceneRenderer.GetLastFrameStats();
+        const FramePacer::Stats& pacing = m_FramePacer.GetStats();
+        const FrameLimiter::Stats& limiter = m_FrameLimiter.GetStats();
         const wchar_t* modeName = L"自由飞行";
-        switch (m_CameraMode)
+        switch (snapshot.cameraMode)
         {
         case CameraMode::AutoFit: modeName = L"自动取景"; break;
         case CameraMode::FirstPerson: modeName = L"第一人称"; break;
@@ -139,40 +176,145 @@ void GameApp::UpdateScene(float dt)
         case CameraMode::FreeFlight: default: modeName = L"自由飞行"; break;
         }
 
-        swprintf(title, 256, L"字符立方体  |  模式:%s  |  N=%d (主字=%d)  |  spacing=%.1f  |  叶子max=%d  |  FPS=%.1f",
-            modeName, m_N, m_N * m_N * m_N, m_Spacing, m_OrbitMax, fps);
+        swprintf(title, 448, L"字符立方体  |  模式:%s  |  N=%d (主字=%d)  |  spacing=%.1f  |  叶子max=%d  |  Draw=%u (逐物体%u)  |  绑定=%u (省略%u)  |  可见=%u (剔除%u, 遮挡%u, 测试%u)  |  CB=%lluB  |  顶点=%.1fMB/帧 (浮点%.1fMB)  |  FPS=%.1f  |  仿真=%.0fHz  |  延迟=%.1fms (±%.1f, 最大%.1f, 在途≤%u)  |  限帧=%.0f (误差%.2fms)",
+            modeName, params.n, params.n * params.n * params.n, params.spacing, params.orbitMax, stats.drawCalls, stats.legacyDrawCalls,
+            stats.stateBinds, stats.bindsAvoided, stats.cellsVisible, stats.cellsCulled, stats.cellsOccluded, stats.cullTests,
+            (unsigned long long)stats.constantBytes, stats.vertexBytes / 1048576.0, stats.floatVertexBytes / 1048576.0, fps, simRate,
+            pacing.AverageLatencyMs(), pacing.AverageUncertaintyMs(), pacing.maxLatencyNs / 1e6, m_FramePacer.GetMaxFramesInFlight(),
+            m_FrameLimiter.GetTargetFrameRate(), limiter.AverageErrorMs());
         SetWindowTextW(m_hMainWnd, title);
+        m_FramePacer.ResetStats();
+        m_FrameLimiter.ResetStats();
         acc = 0.0f; frames = 0;
     }
+}
 
-    switch (m_CameraMode)
+// ==== 后台加载：把加载完成的网格替换进几何池，只上传新追加的部分 ====
+void GameApp::UploadLoadedMeshes()
+{
+    if (m_MeshLoader.GetPendingCount() == 0)
+        return;
+    m_LoadedMeshes.clear();
+    if (m_MeshLoader.PopFinished(m_LoadedMeshes) == 0)
+        return;
+    for (const MeshLoader::MeshData& mesh : m_LoadedMeshes)
     {
-    case CameraMode::AutoFit:
-        UpdateCameraForCube();
-        break;
-    case CameraMode::FirstPerson:
-        UpdateFirstPersonCamera(dt);
-        break;
-    case CameraMode::ThirdPerson:
-        UpdateThirdPersonCamera(dt);
-        break;
-    case CameraMode::FreeFlight:
-    default:
-        UpdateFlightCamera(dt);   // ==== 许双博第三次作业修改：更新飞行相机 ====
-        break;
+        // 超出预留容量时保留占位网格；烘焙文件的顶点和索引直接从映射中拷进几何池
+        m_GeometryPool.ReplaceMesh(mesh.meshId, mesh.GetVertexData(), mesh.vertexCount,
+            mesh.GetIndexData(), mesh.GetIndexCount(), mesh.format, &mesh.decode);
+
+        // 调试输出：焊接前后的顶点数与顶点数据大小（含压缩格式）、索引重排前后的顶点缓存效率
+        wchar_t report[320];
+        swprintf(report, 320, L"网格 %d：顶点 %u -> %u，顶点数据 %u -> %u 字节（%s），ACMR %.3f -> %.3f，ATVR %.3f -> %.3f，加载 %.1fms（%s）\n",
+            mesh.meshId, mesh.sourceVertexCount, mesh.vertexCount,
+            mesh.sourceVertexCount * static_cast<uint32_t>(sizeof(VertexPosColor)),
+            static_cast<uint32_t>(mesh.GetVertexBytes()), mesh.format == VertexFormat::Packed ? L"压缩" : L"浮点",
+            mesh.acmrBefore, mesh.acmrAfter, mesh.atvrBefore, mesh.atvrAfter, mesh.loadSeconds * 1000.0,
+            mesh.mappedFile ? L"映射烘焙文件" : L"启动时处理");
+        OutputDebugStringW(report);
+        if (mesh.format == VertexFormat::Packed)
+        {
+            swprintf(report, 320, L"网格 %d：压缩误差 位置 %.2e，法线 %.4f°，颜色 %.4f\n", mesh.meshId,
+                mesh.packError.position, XMConvertToDegrees(mesh.packError.normal), mesh.packError.color);
+            OutputDebugStringW(report);
+        }
     }
+    m_SceneRenderer.UpdateGeometry();
+    // 几何池已经有了自己的拷贝，释放映射
+    m_LoadedMeshes.clear();
 }
 
-// 小哈希，稳定随机选择 
-static inline int PickId(int x, int y, int z, int extra = 0)
+void GameApp::SelectVertexFormat(MeshLoader::MeshData& mesh, bool allowPacked)
 {
-    // 常用哈希技巧：互质大数混合，最后取低两位
-    unsigned int h = 2166136261u;
-    h = (h ^ (unsigned int)(x * 73856093)) * 16777619u;
-    h = (h ^ (unsigned int)(y * 19349663)) * 16777619u;
-    h = (h ^ (unsigned int)(z * 83492791)) * 16777619u;
-    h = (h ^ (unsigned int)(extra * 2654435761u));
-    return (int)(h & 3u); // 0..3
+    mesh.format = VertexFormat::Float;
+    if (!allowPacked)
+        return;
+    const FloatVertex* pVertices = reinterpret_cast<const FloatVertex*>(mesh.vertices.data());
+    std::vector<PackedVertex> packed;
+    if (!PackVertices(pVertices, mesh.vertexCount, packed, mesh.decode))
+        return;
+    mesh.packError = MeasurePackError(pVertices, packed.data(), mesh.vertexCount, mesh.decode);
+    mesh.format = VertexFormat::Packed;
+    const uint8_t* pPacked = reinterpret_cast<const uint8_t*>(packed.data());
+    mesh.vertices.assign(pPacked, pPacked + packed.size() * sizeof(PackedVertex));
+}
+
+bool GameApp::LoadGlyphMesh(const char* path, MeshLoader::MeshData& mesh, bool allowPacked)
+{
+    std::shared_ptr<GlyphMeshFile> pFile = std::make_shared<GlyphMeshFile>();
+    if (!pFile->Open(path))
+        return false;
+
+    // 文件头里已经有焊接和索引重排的统计，只读取文件头，不处理顶点
+    const GlyphMeshHeader& header = pFile->GetHeader();
+    mesh.vertexCount = header.vertexCount;
+    mesh.format = pFile->GetVertexFormat();
+    mesh.decode = header.decode;
+    mesh.packError.position = header.packError[0];
+    mesh.packError.normal = header.packError[1];
+    mesh.packError.color = header.packError[2];
+    mesh.sourceVertexCount = header.sourceVertexCount;
+    mesh.acmrBefore = header.acmrBefore;
+    mesh.acmrAfter = header.acmrAfter;
+    mesh.atvrBefore = header.atvrBefore;
+    mesh.atvrAfter = header.atvrAfter;
+
+    const bool packed = mesh.format == VertexFormat::Packed;
+    if (packed == allowPacked)
+    {
+        mesh.mappedFile = pFile;
+        return true;
+    }
+
+    // 格式与设置不一致（-floatverts 或用 -float 烘焙的文件）时拷贝出来再转换
+    mesh.indices.assign(pFile->GetIndices(), pFile->GetIndices() + header.indexCount);
+    if (packed)
+    {
+        std::vector<FloatVertex> vertices(header.vertexCount);
+        const PackedVertex* pPacked = reinterpret_cast<const PackedVertex*>(pFile->GetVertices());
+        for (uint32_t i = 0; i < header.vertexCount; ++i)
+            UnpackVertex(pPacked[i], mesh.decode, vertices[i]);
+        const uint8_t* pVertices = reinterpret_cast<const uint8_t*>(vertices.data());
+        mesh.vertices.assign(pVertices, pVertices + vertices.size() * sizeof(FloatVertex));
+        mesh.format = VertexFormat::Float;
+        mesh.decode = PositionDecode();
+        mesh.packError = PackError();
+    }
+    else
+    {
+        mesh.vertices.assign(pFile->GetVertices(), pFile->GetVertices() + header.vertexBytes);
+        SelectVertexFormat(mesh, allowPacked);
+    }
+    return true;
+}
+
+// ==== 固定步长：dt 恒为 1 / kSimulationRate，相同的逐步输入得到相同的状态 ====
+void GameApp::Simulate(uint64_t tick, float dt)
+{
+    m_PreviousScene = m_SceneSimulation.GetScene();
+    m_PreviousView = m_SceneSimulation.BuildSceneView();
+    m_SceneSimulation.SetAspectRatio(m_PendingAspectRatio.load());
+
+    // ==== 输入队列：每步开始时取出属于这一步的事件，之后只查询按键位图 ====
+    // 一次醒来补多步时，较晚的事件留在队列里等到它所属的步
+    m_Input.BeginTick();
+    m_Input.Drain(m_InputQueue, tick);
+    m_SceneSimulation.Step(m_Input, dt);
+}
+
+// 一批步执行完后发布
+void GameApp::PublishSnapshot()
+{
+    SceneSnapshot& snapshot = m_Snapshots.GetWriteBuffer();
+    snapshot.previousScene = m_PreviousScene;
+    snapshot.scene = m_SceneSimulation.GetScene();
+    snapshot.previousView = m_PreviousView;
+    snapshot.view = m_SceneSimulation.BuildSceneView();
+    snapshot.cameraMode = m_SceneSimulation.GetCameraMode();
+    snapshot.occlusionCulling = m_SceneSimulation.IsOcclusionCulling();
+    snapshot.captureRequests = m_SceneSimulation.GetCaptureRequests();
+    snapshot.tick = m_Simulation.GetTickCount();
+    m_Snapshots.Publish();
 }
 
 void GameApp::DrawScene()
@@ -180,111 +322,38 @@ void GameApp::DrawScene()
     assert(m_pd3dImmediateContext);
     assert(m_pSwapChain);
 
-    static float black[4] = { 0, 0, 0, 1 };
-    m_pd3dImmediateContext->ClearRenderTargetView(m_pRenderTargetView.Get(), reinterpret_cast<const float*>(&black));
-    m_pd3dImmediateContext->ClearDepthStencilView(m_pDepthStencilView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-
-    const float c = (m_N - 1) * 0.5f;
-    XMMATRIX mRotate = XMMatrixRotationX(angle) * XMMatrixRotationY(angle * 0.7f);
-
-    for (int ix = 0; ix < m_N; ++ix)
-        for (int iy = 0; iy < m_N; ++iy)
-            for (int iz = 0; iz < m_N; ++iz)
-            {
-                // 稳定随机选择一个主字 id 
-                int id = PickId(ix, iy, iz);
-
-                // 绑定该 id 的 VB/IB
-                UINT stride = sizeof(VertexPosColor);
-                UINT offset = 0;
-                m_pd3dImmediateContext->IASetVertexBuffers(0, 1, m_pVertexBuffers[id].GetAddressOf(), &stride, &offset);
-                m_pd3dImmediateContext->IASetIndexBuffer(m_pIndexBuffers[id].Get(), DXGI_FORMAT_R16_UINT, 0);
-
-                // —— 不同尺寸：伪随机缩放 ——
-                float h = fabsf(sinf(ix * 12.9898f + iy * 78.233f + iz * 37.719f) * 43758.5453f);
-                h -= floorf(h);
-                float scale = 0.35f + 0.35f * h;
-                XMMATRIX mScale = XMMatrixScaling(scale, scale, scale);
-
-                XMMATRIX mTranslate = XMMatrixTranslation(
-                    (ix - c) * m_Spacing,
-                    (iy - c) * m_Spacing,
-                    (iz - c) * m_Spacing
-                );
-
-                // 主字：S * R * T
-                m_CBuffer.world = XMMatrixTranspose(mScale * mRotate * mTranslate);
-                // ==== 许双博第四次作业修改：更新材质、光源和观察者位置 ====
-                m_CBuffer.material = m_ObjectMaterials[id];
-                m_CBuffer.eyePos   = m_CameraPos;
-                // 拷贝光源数组
-                for (int li = 0; li < 3; ++li) m_CBuffer.lights[li] = m_Lights[li];
-
-                D3D11_MAPPED_SUBRESOURCE mappedData{};
-                HR(m_pd3dImmediateContext->Map(m_pConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedData));
-                memcpy_s(mappedData.pData, sizeof(m_CBuffer), &m_CBuffer, sizeof(m_CBuffer));
-                m_pd3dImmediateContext->Unmap(m_pConstantBuffer.Get(), 0);
-
-                m_pd3dImmediateContext->DrawIndexed(m_IndexCounts[id], 0, 0);
-
-                // —— 子字围绕主字公转（随机挑选字）——
-                int nOrbiters = m_OrbitMin + ((ix * 7 + iy * 13 + iz * 17) % (std::max(1, m_OrbitMax - m_OrbitMin + 1)));
-
-                for (int k = 0; k < nOrbiters; ++k)
-                {
-                    int childId = PickId(ix, iy, iz, k + 12345);    // ==== 许双博改的：子字随机 id ====
-
-                    // 绑定该子字的 VB/IB
-                    m_pd3dImmediateContext->IASetVertexBuffers(0, 1, m_pVertexBuffers[childId].GetAddressOf(), &stride, &offset);
-                    m_pd3dImmediateContext->IASetIndexBuffer(m_pIndexBuffers[childId].Get(), DXGI_FORMAT_R16_UINT, 0);
-
-                    float phase = (ix * 23 + iy * 29 + iz * 31 + k * 11) * 0.37f;
-                    XMMATRIX mChildRot = XMMatrixRotationY(angle * 1.6f + phase)
-                        * XMMatrixRotationX(angle * 0.3f + phase * 0.2f);
-                    XMMATRIX mChildScale = XMMatrixScaling(0.25f, 0.25f, 0.25f);
-                    XMMATRIX mChildOffset = XMMatrixTranslation(m_OrbitRadius, 0.0f, 0.0f);
-
-                    XMMATRIX worldChild = mChildScale * mChildOffset * mChildRot * mScale * mTranslate;
-                    m_CBuffer.world = XMMatrixTranspose(worldChild);
-                    // ==== 许双博第四次作业修改：更新材质、光源和观察者位置 ====  (子字)
-                    m_CBuffer.material = m_ObjectMaterials[childId];
-                    m_CBuffer.eyePos   = m_CameraPos;
-                    for (int li = 0; li < 3; ++li) m_CBuffer.lights[li] = m_Lights[li];
-
-                    HR(m_pd3dImmediateContext->Map(m_pConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedData));
-                    memcpy_s(mappedData.pData, sizeof(m_CBuffer), &m_CBuffer, sizeof(m_CBuffer));
-                    m_pd3dImmediateContext->Unmap(m_pConstantBuffer.Get(), 0);
-
-                    m_pd3dImmediateContext->DrawIndexed(m_IndexCounts[childId], 0, 0);
-                }
-            }
-
-
-
-    if (m_CameraMode != CameraMode::FirstPerson && m_pPlayerVertexBuffer && m_pPlayerIndexBuffer && m_PlayerIndexCount > 0)
+    // 回放模式：每帧把捕获文件完整提交一遍（文件中包含 Clear 和 Present）
+    if (m_pReplayer)
+    {
+        m_pReplayer->Replay(m_ReplayFile.GetData(), m_ReplayFile.GetSize());
+        return;
+    }
+
+    // ==== 在途帧控制：GPU 还有上限数量的帧没完成时先等待，等完再取快照，输入尽量晚采样 ====
+    m_FramePacer.BeginFrame(FramePacerNow());
+    m_pRenderDevice->WaitForFrameLatency(kFrameLatencyTimeoutMs);   // 翻转模型交换链可以接受新帧
+    m_FenceBackoff.Reset();
+    while (!m_FramePacer.TryStart(m_pCaptureDevice->GetCompletedFence(), FramePacerNow()))  // 轮询点 3
+        m_FenceBackoff.Wait();
+
+    m_Snapshots.Acquire();
+    const SceneSnapshot& snapshot = m_Snapshots.GetReadBuffer();
+    m_SceneRenderer.SetOcclusionCulling(snapshot.occlusionCulling);
+    // F9：把下一帧提交的全部命令捕获到文件
+    if (snapshot.captureRequests != m_CaptureRequestsSeen)
     {
-        UINT stride = sizeof(VertexPosColor);
-        UINT offset = 0;
-        m_pd3dImmediateContext->IASetVertexBuffers(0, 1, m_pPlayerVertexBuffer.GetAddressOf(), &stride, &offset);
-        m_pd3dImmediateContext->IASetIndexBuffer(m_pPlayerIndexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0);
-
-        XMMATRIX playerScale = XMMatrixScaling(1.5f, 2.5f, 1.5f);
-        XMMATRIX playerRotation = XMMatrixRotationY(m_PlayerYaw);
-        XMMATRIX playerTranslation = XMMatrixTranslation(m_PlayerPos.x, m_PlayerPos.y + 1.25f, m_PlayerPos.z);
-        m_CBuffer.world = XMMatrixTranspose(playerScale * playerRotation * playerTranslation);
-        // ==== 许双博第四次作业修改：玩家使用默认材质并更新光照 ====
-        m_CBuffer.material = m_ObjectMaterials[0];
-        m_CBuffer.eyePos   = m_CameraPos;
-        for (int li = 0; li < 3; ++li) m_CBuffer.lights[li] = m_Lights[li];
-
-        D3D11_MAPPED_SUBRESOURCE mappedData{};
-        HR(m_pd3dImmediateContext->Map(m_pConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedData));
-        memcpy_s(mappedData.pData, sizeof(m_CBuffer), &m_CBuffer, sizeof(m_CBuffer));
-        m_pd3dImmediateContext->Unmap(m_pConstantBuffer.Get(), 0);
-
-        m_pd3dImmediateContext->DrawIndexed(m_PlayerIndexCount, 0, 0);
+        m_CaptureRequestsSeen = snapshot.captureRequests;
+        if (!m_pCaptureDevice->IsCapturing())
+            m_pCaptureDevice->BeginCapture("frame_capture.gfcp", 1);
     }
-    HR(m_pSwapChain->Present(0, 0));
+
+    // 画面比仿真晚一步：在快照的上一步和当前步之间按剩余时间插值
+    float alpha = m_Simulation.GetInterpolationAlpha(snapshot.tick);
+    m_SceneRenderer.Render(ForestScene::Interpolate(snapshot.previousScene, snapshot.scene, alpha),
+        InterpolateSceneView(snapshot.previousView, snapshot.view, alpha));
+    m_pCaptureDevice->Present();
+    m_FramePacer.EndFrame(m_SceneRenderer.GetLastFrameFence(), FramePacerNow());
+    m_FramePacer.Retire(m_pCaptureDevice->GetCompletedFence(), FramePacerNow());   // 轮询点 1
 }
 
 bool GameApp::InitEffect()
@@ -294,9 +363,15 @@ bool GameApp::InitEffect()
     HR(CreateShaderFromFile(L"HLSL\\Cube_VS.cso", L"HLSL\\Cube_VS.hlsl", "VS", "vs_5_0", blob.ReleaseAndGetAddressOf()));
     HR(m_pd3dDevice->CreateVertexShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, m_pVertexShader.GetAddressOf()));
 
-    HR(m_pd3dDevice->CreateInputLayout(VertexPosColor::inputLayout, ARRAYSIZE(VertexPosColor::inputLayout),
+    HR(m_pd3dDevice->CreateInputLayout(VertexPosColor::instancedInputLayout, ARRAYSIZE(VertexPosColor::instancedInputLayout),
         blob->GetBufferPointer(), blob->GetBufferSize(), m_pVertexLayout.GetAddressOf()));
 
+    // ==== 压缩顶点格式：顶点着色器只有输入和解码不同 ====
+    HR(CreateShaderFromFile(L"HLSL\\Cube_VS_Packed.cso", L"HLSL\\Cube_VS_Packed.hlsl", "VS", "vs_5_0", blob.ReleaseAndGetAddressOf()));
+    HR(m_pd3dDevice->CreateVertexShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, m_pPackedVertexShader.GetAddressOf()));
+    HR(m_pd3dDevice->CreateInputLayout(VertexPacked::instancedInputLayout, ARRAYSIZE(VertexPacked::instancedInputLayout),
+        blob->GetBufferPointer(), blob->GetBufferSize(), m_pPackedVertexLayout.GetAddressOf()));
+
     HR(CreateShaderFromFile(L"HLSL\\Cube_PS.cso", L"HLSL\\Cube_PS.hlsl", "PS", "ps_5_0", blob.ReleaseAndGetAddressOf()));
     HR(m_pd3dDevice->CreatePixelShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, m_pPixelShader.GetAddressOf()));
 
@@ -305,32 +380,44 @@ bool GameApp::InitEffect()
 
 bool GameApp::InitResource()
 {
-
+    // ==== 几何池：网格 id 与添加顺序一致，0..3 为四个字，kPlayerMeshId 为玩家立方体 ====
+    // 四个字在后台加载，完成前用 NameVertices 的兜底三角形占位，加载完成后替换（见 UploadLoadedMeshes）
+    // ==== 压缩顶点格式：每个网格在加载时选择格式（SelectVertexFormat），几何池中可以混合存放 ====
+    m_GeometryPool.Clear(sizeof(VertexPosColor));
+    m_GeometryPool.Reserve(kGeometryVertexCapacity, kGeometryIndexCapacity);
+    {
+        NameVertices placeholder(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST, -1);
+        MeshLoader::MeshData mesh;
+        const uint8_t* pVertices = reinterpret_cast<const uint8_t*>(placeholder.GetNameVertices());
+        mesh.vertexCount = placeholder.GetVerticesCount();
+        mesh.vertices.assign(pVertices, pVertices + mesh.vertexCount * sizeof(VertexPosColor));
+        SelectVertexFormat(mesh, m_PackedVertices);
+        for (int i = 0; i < 4; ++i)
+        {
+            m_GeometryPool.AddMesh(mesh.vertices.data(), mesh.vertexCount,
+                placeholder.GetNameIndices(), placeholder.GetIndexCount(), mesh.format, &mesh.decode);
+        }
+    }
+    const bool packedVertices = m_PackedVertices;
     for (int i = 0; i < 4; ++i)
     {
-        m_Models[i] = new NameVertices(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST, i);
-
-        // 顶点缓冲
-        D3D11_BUFFER_DESC vbd{};
-        vbd.Usage = D3D11_USAGE_IMMUTABLE;
-        vbd.ByteWidth = sizeof(VertexPosColor) * m_Models[i]->GetVerticesCount();
-        vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-        D3D11_SUBRESOURCE_DATA initVB{};
-        initVB.pSysMem = m_Models[i]->GetNameVertices();
-        HR(m_pd3dDevice->CreateBuffer(&vbd, &initVB, m_pVertexBuffers[i].GetAddressOf()));
-
-        // 索引缓冲
-        D3D11_BUFFER_DESC ibd{};
-        ibd.Usage = D3D11_USAGE_IMMUTABLE;
-        ibd.ByteWidth = sizeof(WORD) * m_Models[i]->GetIndexCount();
-        ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-
-        D3D11_SUBRESOURCE_DATA initIB{};
-        initIB.pSysMem = m_Models[i]->GetNameIndices();
-        HR(m_pd3dDevice->CreateBuffer(&ibd, &initIB, m_pIndexBuffers[i].GetAddressOf()));
-
-        m_IndexCounts[i] = m_Models[i]->GetIndexCount();
+        m_MeshLoader.Request(i, [i, packedVertices](MeshLoader::MeshData& mesh)
+        {
+            // 优先映射离线烘焙的文件，没有时退回编译进程序的 NameVertices 数据，在这里焊接和重排
+            if (LoadGlyphMesh(kGlyphMeshPaths[i], mesh, packedVertices))
+                return;
+            NameVertices model(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST, i);
+            const uint8_t* pVertices = reinterpret_cast<const uint8_t*>(model.GetNameVertices());
+            mesh.vertexCount = model.GetVerticesCount();
+            mesh.vertices.assign(pVertices, pVertices + mesh.vertexCount * sizeof(VertexPosColor));
+            mesh.indices.assign(model.GetNameIndices(), model.GetNameIndices() + model.GetIndexCount());
+            mesh.sourceVertexCount = model.GetWeldStats().inputVertices;
+            mesh.acmrBefore = model.GetCacheStatsBefore().acmr;
+            mesh.acmrAfter = model.GetCacheStatsAfter().acmr;
+            mesh.atvrBefore = model.GetCacheStatsBefore().atvr;
+            mesh.atvrAfter = model.GetCacheStatsAfter().atvr;
+            SelectVertexFormat(mesh, packedVertices);
+        });
     }
 
     // 玩家立方体网格
@@ -390,465 +477,88 @@ bool GameApp::InitResource()
             expandedIndices.push_back(baseIndex + 1);
             expandedIndices.push_back(baseIndex + 2);
         }
-        // 创建顶点缓冲
-        D3D11_BUFFER_DESC playerVbd{};
-        playerVbd.Usage = D3D11_USAGE_IMMUTABLE;
-        playerVbd.ByteWidth = static_cast<UINT>(sizeof(VertexPosColor) * expandedVerts.size());
-        playerVbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        D3D11_SUBRESOURCE_DATA playerVBData{};
-        playerVBData.pSysMem = expandedVerts.data();
-        HR(m_pd3dDevice->CreateBuffer(&playerVbd, &playerVBData, m_pPlayerVertexBuffer.ReleaseAndGetAddressOf()));
-        // 创建索引缓冲
-        D3D11_BUFFER_DESC playerIbd{};
-        playerIbd.Usage = D3D11_USAGE_IMMUTABLE;
-        playerIbd.ByteWidth = static_cast<UINT>(sizeof(WORD) * expandedIndices.size());
-        playerIbd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        D3D11_SUBRESOURCE_DATA playerIBData{};
-        playerIBData.pSysMem = expandedIndices.data();
-        HR(m_pd3dDevice->CreateBuffer(&playerIbd, &playerIBData, m_pPlayerIndexBuffer.ReleaseAndGetAddressOf()));
-        m_PlayerIndexCount = static_cast<UINT>(expandedIndices.size());
+        MeshLoader::MeshData mesh;
+        const uint8_t* pVertices = reinterpret_cast<const uint8_t*>(expandedVerts.data());
+        mesh.vertexCount = static_cast<uint32_t>(expandedVerts.size());
+        mesh.vertices.assign(pVertices, pVertices + mesh.vertexCount * sizeof(VertexPosColor));
+        SelectVertexFormat(mesh, m_PackedVertices);
+        int playerMesh = m_GeometryPool.AddMesh(mesh.vertices.data(), mesh.vertexCount,
+            expandedIndices.data(), static_cast<uint32_t>(expandedIndices.size()), mesh.format, &mesh.decode);
+        assert(playerMesh == kPlayerMeshId);
+        (void)playerMesh;
     }
 
-    // 常量缓冲
-    D3D11_BUFFER_DESC cbd{};
-    cbd.Usage = D3D11_USAGE_DYNAMIC;
-    cbd.ByteWidth = sizeof(ConstantBuffer);
-    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    HR(m_pd3dDevice->CreateBuffer(&cbd, nullptr, m_pConstantBuffer.GetAddressOf()));
-
-    // 初始化 CBuffer，UpdateCameraForCube / UpdateFlightCamera 会覆盖
-    m_CBuffer.world = XMMatrixIdentity();
-    UpdateProjectionMatrix();      // ==== 许双博第三次作业修改：初始化透视矩阵 ====
-    ApplyViewMatrix();             // ==== 视角初始化 ====
-
-    // IA 设置：拓扑 & 输入布局（VB/IB 在 Draw 时切换）
+    // ==== 渲染设备抽象：几何池、常量缓冲和实例缓冲都由 SceneRenderer 通过设备创建 ====
+    m_pRenderDevice.reset(new D3D11RenderDevice(m_pd3dDevice.Get(), m_pd3dImmediateContext.Get(),
+        m_pd3dImmediateContext1.Get(), m_pSwapChain.Get()));
+    m_pRenderDevice->SetRenderTargets(m_pRenderTargetView.Get(), m_pDepthStencilView.Get(),
+        m_pMsaaRenderTarget.Get(), m_pBackBuffer.Get());
+    m_pRenderDevice->SetVertexFormatShaders(VertexFormat::Float, m_pVertexLayout.Get(), m_pVertexShader.Get());
+    m_pRenderDevice->SetVertexFormatShaders(VertexFormat::Packed, m_pPackedVertexLayout.Get(), m_pPackedVertexShader.Get());
+    // 驱动（或可等待交换链）排队的帧数与在途帧上限一致
+    m_pRenderDevice->SetMaximumFrameLatency(m_FramePacer.GetMaxFramesInFlight());
+    m_pCaptureDevice.reset(new CaptureRenderDevice(m_pRenderDevice.get()));
+    m_SceneSimulation.Init(AspectRatio());
+    m_SceneRenderer.Init(m_pCaptureDevice.get(), &m_GeometryPool, kPlayerMeshId);
+    m_SceneRenderer.SetJobSystem(&m_JobSystem);
+
+    // IA 设置：拓扑 & 输入布局（几何池 VB/IB 和实例缓冲在 SceneRenderer::Render 中绑定，
+    // 输入布局和顶点着色器随网格的顶点格式切换，这里设置的是 Float 格式）
     m_pd3dImmediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     m_pd3dImmediateContext->IASetInputLayout(m_pVertexLayout.Get());
 
-    // VS/PS 绑定
+    // VS/PS 绑定（常量缓冲由 SceneRenderer 通过设备同时绑定到 VS 和 PS）
     m_pd3dImmediateContext->VSSetShader(m_pVertexShader.Get(), nullptr, 0);
-    m_pd3dImmediateContext->VSSetConstantBuffers(0, 1, m_pConstantBuffer.GetAddressOf());
     m_pd3dImmediateContext->PSSetShader(m_pPixelShader.Get(), nullptr, 0);
-    // 把常量缓冲同时绑定到像素着色器（很重要！）
-    m_pd3dImmediateContext->PSSetConstantBuffers(0, 1, m_pConstantBuffer.GetAddressOf());
-
 
     // 调试名
     D3D11SetDebugObjectName(m_pVertexLayout.Get(), "VertexPosColorLayout");
-    D3D11SetDebugObjectName(m_pConstantBuffer.Get(), "ConstantBuffer");
     D3D11SetDebugObjectName(m_pVertexShader.Get(), "Cube_VS");
+    D3D11SetDebugObjectName(m_pPackedVertexLayout.Get(), "VertexPackedLayout");
+    D3D11SetDebugObjectName(m_pPackedVertexShader.Get(), "Cube_VS_Packed");
     D3D11SetDebugObjectName(m_pPixelShader.Get(), "Cube_PS");
-    for (int i = 0; i < 4; ++i) {
-        char n1[32]; sprintf_s(n1, "VB_%d", i);
-        char n2[32]; sprintf_s(n2, "IB_%d", i);
-        D3D11SetDebugObjectName(m_pVertexBuffers[i].Get(), n1);
-        D3D11SetDebugObjectName(m_pIndexBuffers[i].Get(), n2);
-    }
-    D3D11SetDebugObjectName(m_pPlayerVertexBuffer.Get(), "Player_VB");
-    D3D11SetDebugObjectName(m_pPlayerIndexBuffer.Get(), "Player_IB");
-
-    // ==== 许双博第四次作业修改：初始化材质和光照 ====
-    // 为四个汉字模型设置不同的材质颜色和高光参数
-    {
-        using DirectX::XMFLOAT3;
-        // 材质0：偏红色
-        m_ObjectMaterials[0].ambient  = XMFLOAT3(0.3f, 0.05f, 0.05f);
-        m_ObjectMaterials[0].diffuse  = XMFLOAT3(0.7f, 0.2f, 0.2f);
-        m_ObjectMaterials[0].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
-        m_ObjectMaterials[0].shininess= 32.0f;
-        // 材质1：偏绿色
-        m_ObjectMaterials[1].ambient  = XMFLOAT3(0.05f, 0.3f, 0.05f);
-        m_ObjectMaterials[1].diffuse  = XMFLOAT3(0.2f, 0.7f, 0.2f);
-        m_ObjectMaterials[1].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
-        m_ObjectMaterials[1].shininess= 32.0f;
-        // 材质2：偏蓝色
-        m_ObjectMaterials[2].ambient  = XMFLOAT3(0.05f, 0.05f, 0.3f);
-        m_ObjectMaterials[2].diffuse  = XMFLOAT3(0.2f, 0.2f, 0.7f);
-        m_ObjectMaterials[2].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
-        m_ObjectMaterials[2].shininess= 32.0f;
-        // 材质3：偏黄色
-        m_ObjectMaterials[3].ambient  = XMFLOAT3(0.3f, 0.3f, 0.05f);
-        m_ObjectMaterials[3].diffuse  = XMFLOAT3(0.7f, 0.7f, 0.2f);
-        m_ObjectMaterials[3].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
-        m_ObjectMaterials[3].shininess= 32.0f;
-    }
-    // 初始化光源
-    {
-        using DirectX::XMFLOAT3;
-        // 点光源（索引0）
-        m_Lights[0].type     = 1;
-        m_Lights[0].enabled  = m_PointLightEnabled ? 1 : 0;
-        m_Lights[0].position = XMFLOAT3(0.0f, 10.0f, 0.0f);
-        m_Lights[0].range    = 30.0f;
-        m_Lights[0].direction= XMFLOAT3(0.0f, -1.0f, 0.0f);
-        m_Lights[0].spot     = DirectX::XM_PIDIV4; // unused
-        m_Lights[0].ambient  = XMFLOAT3(0.05f, 0.05f, 0.05f);
-        m_Lights[0].diffuse  = XMFLOAT3(1.0f, 1.0f, 1.0f);
-        m_Lights[0].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
-        // 聚光灯（索引1）
-        m_Lights[1].type     = 2;
-        m_Lights[1].enabled  = m_SpotLightEnabled ? 1 : 0;
-        m_Lights[1].position = m_CameraPos; // 将在绘制时更新
-        m_Lights[1].direction= XMFLOAT3(0.0f, 0.0f, 1.0f);
-        m_Lights[1].range    = 80.0f;
-        m_Lights[1].spot     = DirectX::XMConvertToRadians(30.0f); // 30度
-        m_Lights[1].ambient  = XMFLOAT3(0.0f, 0.0f, 0.0f);
-        m_Lights[1].diffuse  = XMFLOAT3(1.0f, 1.0f, 1.0f);
-        m_Lights[1].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
-        // 方向光（索引2）
-        m_Lights[2].type     = 0;
-        m_Lights[2].enabled  = m_DirLightEnabled ? 1 : 0;
-        // 随机化方向以避免每次都一致
-        {
-            float rx = static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f;
-            float ry = static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f;
-            float rz = static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f;
-            DirectX::XMVECTOR dir = DirectX::XMVector3Normalize(DirectX::XMVectorSet(rx, ry, rz, 0.0f));
-            DirectX::XMStoreFloat3(&m_Lights[2].direction, dir);
-        }
-        m_Lights[2].position = XMFLOAT3(0.0f, 0.0f, 0.0f);
-        m_Lights[2].range    = 0.0f;
-        m_Lights[2].spot     = 0.0f;
-        m_Lights[2].ambient  = XMFLOAT3(0.1f, 0.1f, 0.1f);
-        m_Lights[2].diffuse  = XMFLOAT3(1.0f, 1.0f, 1.0f);
-        m_Lights[2].specular = XMFLOAT3(1.0f, 1.0f, 1.0f);
-    }
 
     return true;
 }
 
-//
-
-void GameApp::UpdateCameraForCube()
-{
-    float halfExtent = (m_N - 1) * m_Spacing * 0.5f;
-    float radius = std::max<float>(halfExtent * 1.732051f + 8.0f, 12.0f);
-
-    XMFLOAT3 camPos(0.0f, radius * 0.45f, -radius * 1.3f);
-
-    XMVECTOR eyePos = XMLoadFloat3(&camPos);
-    XMMATRIX view = XMMatrixLookAtLH(
-        eyePos,
-        XMVectorZero(),
-        XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)
-    );
-
-    float znear = 1.0f;
-    float zfar = std::max<float>(1000.0f, radius * 6.0f);
-
-    XMMATRIX proj = XMMatrixPerspectiveFovLH(XM_PIDIV4 * 1.2f, AspectRatio(), znear, zfar);
-
-    m_CBuffer.view = XMMatrixTranspose(view);
-    m_CBuffer.proj = XMMatrixTranspose(proj);
-
-    XMStoreFloat3(&m_CameraPos, eyePos);
-    XMVECTOR direction = XMVector3Normalize(XMVectorSubtract(XMVectorZero(), eyePos));
-    m_CameraYaw = std::atan2(XMVectorGetX(direction), XMVectorGetZ(direction));
-    float dirY = XMVectorGetY(direction);
-    dirY = std::max(-1.0f, std::min(1.0f, dirY));
-    m_CameraPitch = std::asin(dirY);
-    m_CameraRoll = 0.0f;
-}
-
-// ==== 许双博第三次作业修改：根据键鼠输入更新飞行相机 ====
-void GameApp::UpdateFlightCamera(float dt)
-{
-    using namespace DirectX;
-
-    // 鼠标控制偏航和俯仰
-    if (!m_FirstMouseEvent)
-    {
-        m_CameraYaw += m_MouseDeltaX * m_MouseSensitivity;
-        m_CameraPitch += m_MouseDeltaY * m_MouseSensitivity;
-    }
-    m_MouseDeltaX = 0.0f;
-    m_MouseDeltaY = 0.0f;
-
-    // 限制俯仰角避免翻折
-    const float pitchLimit = XM_PIDIV2 - 0.01f;
-    m_CameraPitch = std::max(-pitchLimit, std::min(pitchLimit, m_CameraPitch));
-
-    // 键盘桶滚，左右滚转
-    if (GetAsyncKeyState('Q') & 0x8000)
-        m_CameraRoll -= m_RollSpeed * dt;
-    if (GetAsyncKeyState('E') & 0x8000)
-        m_CameraRoll += m_RollSpeed * dt;
-
-    // 保持角度在 [-pi, pi] 范围，避免浮点漂移
-    auto WrapAngle = [](float angle)
-    {
-        while (angle > XM_PI) angle -= XM_2PI;
-        while (angle < -XM_PI) angle += XM_2PI;
-        return angle;
-    };
-    m_CameraYaw = WrapAngle(m_CameraYaw);
-    m_CameraRoll = WrapAngle(m_CameraRoll);
-
-    XMVECTOR rotation = XMQuaternionRotationRollPitchYaw(m_CameraPitch, m_CameraYaw, m_CameraRoll);
-    XMVECTOR forward = XMVector3Rotate(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), rotation);
-    XMVECTOR right = XMVector3Rotate(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), rotation);
-    XMVECTOR up = XMVector3Normalize(XMVector3Rotate(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), rotation));
-
-    XMVECTOR position = XMLoadFloat3(&m_CameraPos);
-    float moveSpeed = m_MoveSpeed;
-
-    if (GetAsyncKeyState('W') & 0x8000)
-        position += forward * moveSpeed * dt;
-    if (GetAsyncKeyState('S') & 0x8000)
-        position -= forward * moveSpeed * dt;
-    if (GetAsyncKeyState('A') & 0x8000)
-        position -= right * moveSpeed * dt;
-    if (GetAsyncKeyState('D') & 0x8000)
-        position += right * moveSpeed * dt;
-
-    XMStoreFloat3(&m_CameraPos, position);
-
-    XMMATRIX view = XMMatrixLookToLH(position, forward, up);
-    m_CBuffer.view = XMMatrixTranspose(view);
-}
-
-
-
-void GameApp::UpdateFirstPersonCamera(float dt)
-{
-    UpdatePlayerMovement(dt);
-    UpdateFirstPersonViewMatrix();
-}
-
-void GameApp::UpdateThirdPersonCamera(float dt)
-{
-    UpdatePlayerMovement(dt);
-    UpdateThirdPersonViewMatrix();
-}
-
-void GameApp::UpdatePlayerMovement(float dt)
-{
-    using namespace DirectX;
-
-    if (!m_FirstMouseEvent)
-    {
-        m_PlayerYaw += m_MouseDeltaX * m_MouseSensitivity;
-        m_PlayerPitch += m_MouseDeltaY * m_MouseSensitivity;
-    }
-    m_MouseDeltaX = 0.0f;
-    m_MouseDeltaY = 0.0f;
-
-    const float pitchLimit = XM_PIDIV2 - 0.01f;
-    m_PlayerPitch = std::max(-pitchLimit, std::min(pitchLimit, m_PlayerPitch));
-
-    auto WrapAngle = [](float angle)
-    {
-        while (angle > XM_PI) angle -= XM_2PI;
-        while (angle < -XM_PI) angle += XM_2PI;
-        return angle;
-    };
-    m_PlayerYaw = WrapAngle(m_PlayerYaw);
-
-    XMVECTOR forward = GetForwardVector(m_PlayerYaw, m_PlayerPitch);
-    XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-    XMVECTOR right = XMVector3Normalize(XMVector3Cross(up, forward));
-
-    XMVECTOR position = XMLoadFloat3(&m_PlayerPos);
-    float moveSpeed = m_PlayerMoveSpeed;
-
-    if (GetAsyncKeyState('W') & 0x8000)
-        position += forward * moveSpeed * dt;
-    if (GetAsyncKeyState('S') & 0x8000)
-        position -= forward * moveSpeed * dt;
-    if (GetAsyncKeyState('A') & 0x8000)
-        position -= right * moveSpeed * dt;
-    if (GetAsyncKeyState('D') & 0x8000)
-        position += right * moveSpeed * dt;
-    if (GetAsyncKeyState(VK_SPACE) & 0x8000)
-        position += up * moveSpeed * dt;
-    if (GetAsyncKeyState(VK_CONTROL) & 0x8000)
-        position -= up * moveSpeed * dt;
-
-    XMStoreFloat3(&m_PlayerPos, position);
-}
-// ==== 许双博第三次作业修改：刷新飞行相机视图矩阵 ====
-void GameApp::UpdateFreeFlightViewMatrix()
-{
-    using namespace DirectX;
-    XMVECTOR position = XMLoadFloat3(&m_CameraPos);
-    XMVECTOR rotation = XMQuaternionRotationRollPitchYaw(m_CameraPitch, m_CameraYaw, m_CameraRoll);
-    XMVECTOR forward = XMVector3Rotate(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), rotation);
-    XMVECTOR up = XMVector3Normalize(XMVector3Rotate(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), rotation));
-    XMMATRIX view = XMMatrixLookToLH(position, forward, up);
-    m_CBuffer.view = XMMatrixTranspose(view);
-}
-
-
-
-void GameApp::UpdateFirstPersonViewMatrix()
-{
-    using namespace DirectX;
-    XMVECTOR basePos = XMLoadFloat3(&m_PlayerPos);
-    XMVECTOR eye = basePos + XMVectorSet(0.0f, m_PlayerEyeHeight, 0.0f, 0.0f);
-    XMVECTOR forward = GetForwardVector(m_PlayerYaw, m_PlayerPitch);
-    XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-    XMStoreFloat3(&m_FirstPersonEyePos, eye);
-    XMMATRIX view = XMMatrixLookToLH(eye, forward, up);
-    m_CBuffer.view = XMMatrixTranspose(view);
-}
-
-void GameApp::UpdateThirdPersonViewMatrix()
-{
-    using namespace DirectX;
-    XMVECTOR basePos = XMLoadFloat3(&m_PlayerPos);
-    XMVECTOR target = basePos + XMVectorSet(0.0f, m_PlayerEyeHeight, 0.0f, 0.0f);
-    XMVECTOR forward = GetForwardVector(m_PlayerYaw, m_PlayerPitch);
-    XMVECTOR cameraPos = target - forward * m_ThirdPersonDistance + XMVectorSet(0.0f, m_ThirdPersonHeight, 0.0f, 0.0f);
-    XMStoreFloat3(&m_ThirdPersonCameraPos, cameraPos);
-    XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-    XMMATRIX view = XMMatrixLookAtLH(cameraPos, target, up);
-    m_CBuffer.view = XMMatrixTranspose(view);
-}
-
-void GameApp::ApplyViewMatrix()
-{
-    switch (m_CameraMode)
-    {
-    case CameraMode::AutoFit:
-        UpdateCameraForCube();
-        break;
-    case CameraMode::FirstPerson:
-        UpdateFirstPersonViewMatrix();
-        break;
-    case CameraMode::ThirdPerson:
-        UpdateThirdPersonViewMatrix();
-        break;
-    case CameraMode::FreeFlight:
-    default:
-        UpdateFreeFlightViewMatrix();
-        break;
-    }
-}
-
-DirectX::XMVECTOR GameApp::GetForwardVector(float yaw, float pitch) const
-{
-    using namespace DirectX;
-    XMVECTOR rotation = XMQuaternionRotationRollPitchYaw(pitch, yaw, 0.0f);
-    return XMVector3Normalize(XMVector3Rotate(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), rotation));
-}
-
-void GameApp::SetCameraMode(CameraMode mode)
-{
-    if (m_CameraMode == mode)
-        return;
-
-    using namespace DirectX;
-
-    auto alignFromCurrentView = [this]()
-    {
-        XMVECTOR camPos = XMLoadFloat3(&m_CameraPos);
-        XMVECTOR forward = GetForwardVector(m_CameraYaw, m_CameraPitch);
-        XMVECTOR target = camPos + forward * m_ThirdPersonDistance;
-        target -= XMVectorSet(0.0f, m_ThirdPersonHeight, 0.0f, 0.0f);
-        target -= XMVectorSet(0.0f, m_PlayerEyeHeight, 0.0f, 0.0f);
-        XMStoreFloat3(&m_PlayerPos, target);
-        m_PlayerYaw = m_CameraYaw;
-        m_PlayerPitch = m_CameraPitch;
-    };
-
-    if (mode == CameraMode::FirstPerson)
-    {
-        if (m_CameraMode == CameraMode::FreeFlight || m_CameraMode == CameraMode::AutoFit)
-        {
-            m_PlayerYaw = m_CameraYaw;
-            m_PlayerPitch = m_CameraPitch;
-            m_PlayerPos = m_CameraPos;
-            m_PlayerPos.y -= m_PlayerEyeHeight;
-        }
-    }
-    else if (mode == CameraMode::ThirdPerson)
-    {
-        if (m_CameraMode == CameraMode::FreeFlight || m_CameraMode == CameraMode::AutoFit)
-        {
-            alignFromCurrentView();
-        }
-    }
-    else if (mode == CameraMode::FreeFlight)
-    {
-        if (m_CameraMode == CameraMode::FirstPerson)
-        {
-            m_CameraPos = m_FirstPersonEyePos;
-            m_CameraYaw = m_PlayerYaw;
-            m_CameraPitch = m_PlayerPitch;
-        }
-        else if (m_CameraMode == CameraMode::ThirdPerson)
-        {
-            m_CameraPos = m_ThirdPersonCameraPos;
-            m_CameraYaw = m_PlayerYaw;
-            m_CameraPitch = m_PlayerPitch;
-        }
-    }
-
-    if (mode != CameraMode::FreeFlight)
-    {
-        m_CameraRoll = 0.0f;
-    }
-
-    m_CameraMode = mode;
-    m_FirstMouseEvent = true;
-    m_MouseDeltaX = 0.0f;
-    m_MouseDeltaY = 0.0f;
-
-    if (mode == CameraMode::AutoFit)
-    {
-        UpdateCameraForCube();
-    }
-    else
-    {
-        UpdateProjectionMatrix();
-        ApplyViewMatrix();
-    }
-}
-
-bool GameApp::IsMouseLookEnabled() const
-{
-    return m_CameraMode != CameraMode::AutoFit;
-}
-// ==== 许双博第三次作业修改：刷新飞行相机投影矩阵 ====
-void GameApp::UpdateProjectionMatrix()
-{
-    using namespace DirectX;
-    float aspect = AspectRatio();
-    float fov = XM_PIDIV4 * 1.1f;
-    m_CBuffer.proj = XMMatrixTranspose(XMMatrixPerspectiveFovLH(fov, aspect, 0.1f, 2000.0f));
-}
-
 // ==== 许双博第三次作业修改：处理鼠标消息，记录移动增量 ====
+// ==== 输入队列：按键和鼠标事件压入队列，由仿真线程在下一步开始时处理 ====
 LRESULT GameApp::MsgProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
+    InputEvent event{};
     switch (msg)
     {
+    case WM_KEYDOWN:
+    case WM_SYSKEYDOWN:
+    case WM_KEYUP:
+    case WM_SYSKEYUP:
+        event.type = (msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN) ? InputEvent::KeyDown : InputEvent::KeyUp;
+        event.key = static_cast<uint8_t>(wParam);
+        PushInput(event);
+        break;      // 继续交给默认处理（Alt+F4 等系统按键）
     case WM_MOUSEMOVE:
-        if (IsMouseLookEnabled())
-        {
-            int x = GET_X_LPARAM(lParam);
-            int y = GET_Y_LPARAM(lParam);
-            if (m_FirstMouseEvent)
-            {
-                m_LastMousePos.x = x;
-                m_LastMousePos.y = y;
-                m_FirstMouseEvent = false;
-            }
-            else
-            {
-                m_MouseDeltaX += float(x - m_LastMousePos.x);
-                m_MouseDeltaY += float(y - m_LastMousePos.y);
-                m_LastMousePos.x = x;
-                m_LastMousePos.y = y;
-            }
-        }
+        event.type = InputEvent::MouseMove;
+        event.x = GET_X_LPARAM(lParam);
+        event.y = GET_Y_LPARAM(lParam);
+        PushInput(event);
         return 0;
     case WM_SETFOCUS:
-        m_FirstMouseEvent = true;
-        m_MouseDeltaX = 0.0f;
-        m_MouseDeltaY = 0.0f;
+        event.type = InputEvent::FocusGained;
+        PushInput(event);
         return 0;
+    case WM_KILLFOCUS:
+        event.type = InputEvent::FocusLost;
+        PushInput(event);
+        break;
     }
     return D3DApp::MsgProc(hwnd, msg, wParam, lParam);
 }
+
+void GameApp::PushInput(const InputEvent& event)
+{
+    // 标上所属的步：仿真线程补步时事件仍在它发生时对应的那一步生效
+    InputEvent stamped = event;
+    stamped.tick = m_Simulation.GetInputTick();
+    // 队列满说明仿真线程长时间没有运行（如断点），丢弃事件即可
+    m_InputQueue.Push(stamped);
+}
@@ -2,8 +2,25 @@
 #define GAMEAPP_H
 
 #include "d3dApp.h"
+#include "SceneConstants.h"
+#include "GeometryPool.h"
+#include "ForestScene.h"
+#include "SceneRenderer.h"
+#include "SceneSimulation.h"
+#include "D3D11RenderDevice.h"
+#include "CaptureRenderDevice.h"
+#include "CaptureReplay.h"
+#include "MappedFile.h"
+#include "TripleBuffer.h"
+#include "SimulationThread.h"
+#include "InputState.h"
+#include "MeshLoader.h"
+#include "FramePacer.h"
+#include "PollBackoff.h"
 #include <array>        
-#include <vector>       
+#include <atomic>
+#include <memory>
+#include <string>
 // ==== 许双博第三次作业修改：飞行相机需要用到窗口结构和鼠标宏 ====
 #include <Windows.h>
 #include <windowsx.h>
@@ -24,51 +41,14 @@ public:
         DirectX::XMFLOAT4 color;
         // 输入布局定义：位置、法线、颜色
         static const D3D11_INPUT_ELEMENT_DESC inputLayout[3];
+        // ==== 实例化绘制：槽0 为顶点流，槽1 为实例流（世界矩阵 + 材质索引） ====
+        static const D3D11_INPUT_ELEMENT_DESC instancedInputLayout[8];
     };
 
-    // ==== 许双博第四次作业修改：光照和材质参数结构 ====
-    struct Light
+    // ==== 压缩顶点格式：槽0 为 16 字节的 PackedVertex（见 VertexFormat.h），槽1 与 VertexPosColor 相同 ====
+    struct VertexPacked
     {
-        // 光源位置（方向光无效）
-        DirectX::XMFLOAT3 position;
-        float range;             // 点光源/聚光灯有效半径
-        // 光源朝向（点光源无效）
-        DirectX::XMFLOAT3 direction;
-        float spot;              // 聚光灯张角（弧度），方向光/点光源无效
-        // 光源颜色：环境光、漫反射、镜面反射
-        DirectX::XMFLOAT3 ambient;
-        float pad0;
-        DirectX::XMFLOAT3 diffuse;
-        float pad1;
-        DirectX::XMFLOAT3 specular;
-        float pad2;
-        int type;               // 0=方向光，1=点光源，2=聚光灯
-        int enabled;            // 是否启用
-        int pad3[2];            // 对齐填充
-    };
-
-    struct Material
-    {
-        DirectX::XMFLOAT3 ambient;
-        float pad0;
-        DirectX::XMFLOAT3 diffuse;
-        float pad1;
-        DirectX::XMFLOAT3 specular;
-        float shininess;
-    };
-
-    struct ConstantBuffer
-    {
-        DirectX::XMMATRIX world;
-        DirectX::XMMATRIX view;
-        DirectX::XMMATRIX proj;
-        // 三种光源（顺序：点光、聚光、方向光）
-        Light lights[3];
-        // 当前对象材质
-        Material material;
-        // 观察者位置
-        DirectX::XMFLOAT3 eyePos;
-        float padEye;
+        static const D3D11_INPUT_ELEMENT_DESC instancedInputLayout[8];
     };
 
 public:
@@ -76,7 +56,14 @@ public:
     ~GameApp();
 
     bool Init();
+    // ==== 命令流回放：在 Init 之前设置，之后每帧回放捕获文件而不绘制场景 ====
+    void SetReplayFile(const std::string& path);
+    // ==== 在途帧控制：CPU 最多领先 GPU 的帧数，在 Init 之前设置 ====
+    void SetMaxFramesInFlight(uint32_t frames);
+    // ==== 压缩顶点格式：关闭后所有网格都使用 Float 格式，在 Init 之前设置 ====
+    void SetPackedVertices(bool enabled);
     void OnResize();
+    // ==== 仿真与渲染分离：UpdateScene / DrawScene 在渲染线程上只读取仿真线程发布的快照 ====
     void UpdateScene(float dt);
     void DrawScene();
     // ==== 许双博第三次作业修改：处理鼠标消息，收集相机输入 ====
@@ -85,95 +72,82 @@ public:
 private:
     bool InitEffect();
     bool InitResource();
-    void UpdateCameraForCube();
-    // ==== 许双博第三次作业修改：飞行相机辅助函数 ====
-    void UpdateFlightCamera(float dt);
-    void UpdateProjectionMatrix();
-    // ==== 视角切换 ====
-    enum class CameraMode
+
+    // ==== 仿真线程：取出属于第 tick 步的输入，由 SceneSimulation 推进一步，一批步结束时发布快照 ====
+    void Simulate(uint64_t tick, float dt);
+    void PublishSnapshot();
+    // 消息线程：把输入事件交给仿真线程
+    void PushInput(const InputEvent& event);
+    // 渲染线程：取走加载完成的网格并上传
+    void UploadLoadedMeshes();
+    // 网格顶点为 VertexPosColor 时按设置选择顶点格式，能压缩则换成 PackedVertex（可在加载线程上调用）
+    static void SelectVertexFormat(MeshLoader::MeshData& mesh, bool allowPacked);
+    // 映射离线烘焙的字形网格文件，格式与设置一致时直接引用映射中的数据（可在加载线程上调用）
+    static bool LoadGlyphMesh(const char* path, MeshLoader::MeshData& mesh, bool allowPacked);
+
+    // 仿真线程发布给渲染线程的场景快照，发布后不再修改
+    // 同时带有上一步的状态，渲染线程按 SimulationThread::GetInterpolationAlpha 插值
+    struct SceneSnapshot
     {
-        AutoFit,
-        FirstPerson,
-        ThirdPerson,
-        FreeFlight
+        ForestScene previousScene;
+        ForestScene scene;
+        SceneView   previousView;
+        SceneView   view;
+        CameraMode  cameraMode = CameraMode::FreeFlight;
+        bool        occlusionCulling = true;
+        uint32_t    captureRequests = 0;    // 累计的捕获请求，渲染线程看到增加时开始捕获
+        uint64_t    tick = 0;               // 发布时的仿真步数
     };
-    void SetCameraMode(CameraMode mode);
-    void UpdateFirstPersonCamera(float dt);
-    void UpdateThirdPersonCamera(float dt);
-    void UpdatePlayerMovement(float dt);
-    void UpdateFreeFlightViewMatrix();
-    void UpdateFirstPersonViewMatrix();
-    void UpdateThirdPersonViewMatrix();
-    void ApplyViewMatrix();
-    DirectX::XMVECTOR GetForwardVector(float yaw, float pitch) const;
-    bool IsMouseLookEnabled() const;
 
 private:
     ComPtr<ID3D11InputLayout>   m_pVertexLayout;
-    // ==== 改成 4 组 VB/IB（四个字各一份） ====
-    std::array<ComPtr<ID3D11Buffer>, 4> m_pVertexBuffers;
-    std::array<ComPtr<ID3D11Buffer>, 4> m_pIndexBuffers;
-    std::array<UINT, 4>                 m_IndexCounts;
-
-    ComPtr<ID3D11Buffer>        m_pConstantBuffer;
+    // ==== 几何池：四个字和玩家立方体共用一个 VB/IB，按 BaseVertex/StartIndex 偏移绘制 ====
+    static const int            kPlayerMeshId = 4;      // 0..3 为四个字
+    // 几何池预留容量：网格在后台加载完成后追加进来，GPU 缓冲按容量一次创建
+    static const uint32_t       kGeometryVertexCapacity = 256 * 1024;
+    static const uint32_t       kGeometryIndexCapacity = 1024 * 1024;
+    GeometryPool                m_GeometryPool;
+    MeshLoader                  m_MeshLoader;
+    std::vector<MeshLoader::MeshData> m_LoadedMeshes;
+    bool                        m_PackedVertices = true;
+
+    // ==== 渲染设备抽象：场景状态与提交逻辑不直接访问 D3D 上下文 ====
+    std::unique_ptr<D3D11RenderDevice> m_pRenderDevice;
+    JobSystem                   m_JobSystem;   // 帧准备的工作线程，需要比 m_SceneRenderer 先构造、后析构
+    SceneRenderer               m_SceneRenderer;
+
+    // ==== 仿真与渲染分离 ====
+    static const double         kSimulationRate;        // 仿真线程每秒步数（固定步长）
+    SceneSimulation             m_SceneSimulation;      // 场景、相机与玩家，仿真线程独占
+    ForestScene                 m_PreviousScene;        // 上一步结束时的状态，用于插值
+    SceneView                   m_PreviousView;
+    TripleBuffer<SceneSnapshot> m_Snapshots;
+    SimulationThread            m_Simulation;           // 析构时最先停止（见 ~GameApp）
+    std::atomic<float>          m_PendingAspectRatio{ 1.0f };   // 窗口大小变化时由消息线程写入
+    uint32_t                    m_CaptureRequestsSeen = 0;  // 渲染线程已处理的捕获请求
+
+    // ==== 在途帧控制：渲染线程独占 ====
+    static const uint32_t       kMaxFramesInFlight = 3;    // 不超过 D3D11RenderDevice 的 fence 查询数
+    static const uint32_t       kFrameLatencyTimeoutMs = 100;
+    FramePacer                  m_FramePacer;
+    PollBackoff                 m_FenceBackoff;             // 等待在途帧完成时先短暂自旋，再逐渐加长睡眠
+
+    // ==== 命令流捕获与回放：SceneRenderer 通过捕获设备提交，按 F9 捕获下一帧 ====
+    std::unique_ptr<CaptureRenderDevice> m_pCaptureDevice;
+    std::string                 m_ReplayPath;
+    MappedFile                  m_ReplayFile;
+    std::unique_ptr<CaptureReplayer> m_pReplayer;
 
     ComPtr<ID3D11VertexShader>  m_pVertexShader;
+    ComPtr<ID3D11InputLayout>   m_pPackedVertexLayout;
+    ComPtr<ID3D11VertexShader>  m_pPackedVertexShader;
     ComPtr<ID3D11PixelShader>   m_pPixelShader;
-    ConstantBuffer              m_CBuffer;
-
-    // ==== 4 个模型对象缓存 ====
-    std::array<NameVertices*, 4> m_Models = { nullptr, nullptr, nullptr, nullptr };
-    ComPtr<ID3D11Buffer>        m_pPlayerVertexBuffer;
-    ComPtr<ID3D11Buffer>        m_pPlayerIndexBuffer;
-    UINT                        m_PlayerIndexCount = 0;
-
-    float   angle = 0.0f;
-
-    // 立方体阵列控制
-    int     m_N = 10;
-    float   m_Spacing = 4.5f;     
-    float   m_OrbitRadius = 2.5f; 
-    int     m_OrbitMin = 1;       
-    int     m_OrbitMax = 3;       
-    float   m_KeyCooldown = 0.0f;
-
-    // ==== 许双博第三次作业修改：飞行相机状态 ====
-    DirectX::XMFLOAT3 m_CameraPos = DirectX::XMFLOAT3(0.0f, 20.0f, -80.0f);
-    float   m_CameraYaw = 0.0f;
-    float   m_CameraPitch = -0.25f;
-    float   m_CameraRoll = 0.0f;
-    float   m_MoveSpeed = 15.0f;// 移动速度
-    float   m_RollSpeed = DirectX::XMConvertToRadians(30.0f);// 转动速度
-    float   m_MouseSensitivity = 0.0025f;
-    float   m_MouseDeltaX = 0.0f;
-    float   m_MouseDeltaY = 0.0f;
-    POINT   m_LastMousePos = { 0, 0 };
-    bool    m_FirstMouseEvent = true;
-
-    CameraMode m_CameraMode = CameraMode::FreeFlight;
-
-    // ==== 角色状态 ====
-    DirectX::XMFLOAT3 m_PlayerPos = DirectX::XMFLOAT3(0.0f, 0.0f, -40.0f);
-    float   m_PlayerYaw = 0.0f;
-    float   m_PlayerPitch = 0.0f;
-    float   m_PlayerMoveSpeed = 15.0f;// 移动速度
-    float   m_PlayerEyeHeight = 1.5f;
-    float   m_ThirdPersonDistance = 15.0f;
-    float   m_ThirdPersonHeight = 4.0f;
-    DirectX::XMFLOAT3 m_FirstPersonEyePos = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
-    DirectX::XMFLOAT3 m_ThirdPersonCameraPos = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
-
-    // ==== 许双博第四次作业修改：材质与光照相关字段 ====
-    // 每个汉字模型的材质参数（Ambient/Diffuse/Specular/Shininess）
-    std::array<Material, 4> m_ObjectMaterials{};
-    // 存储三个光源（点光、聚光、方向光）
-    std::array<Light, 3>    m_Lights{};
-    // 各光源是否启用
-    bool m_PointLightEnabled = true;
-    bool m_SpotLightEnabled  = true;
-    bool m_DirLightEnabled   = true;
-    // 用于动画的累积时间
-    float m_TotalTime = 0.0f;
+
+    // 立方体阵列参数保存在 m_SceneSimulation 的场景中
+
+    // ==== 输入队列：消息线程写入并标上所属的步，仿真线程每步取出属于该步的事件更新 m_Input ====
+    InputQueue                  m_InputQueue;
+    InputState                  m_Input;                // 仿真线程独占
 };
 
 #endif
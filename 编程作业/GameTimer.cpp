@@ -2,21 +2,20 @@
 // GameTimer.cpp by Frank Luna (C) 2011 All Rights Reserved.
 //***************************************************************************************
 
-#include <windows.h>
 #include "GameTimer.h"
 
-GameTimer::GameTimer()
-: m_SecondsPerCount(0.0), m_DeltaTime(-1.0), m_BaseTime(0), m_StopTime(0),
-  m_PausedTime(0), m_PrevTime(0), m_CurrTime(0), m_Stopped(false)
+GameTimer::GameTimer(MonotonicClock& clock)
+: m_pClock(&clock), m_DeltaTime(0), m_BaseTime(0), m_PausedTime(0),
+  m_StopTime(0), m_PrevTime(0), m_CurrTime(0), m_Stopped(false)
 {
-	__int64 countsPerSec;
-	QueryPerformanceFrequency((LARGE_INTEGER*)&countsPerSec);
-	m_SecondsPerCount = 1.0 / (double)countsPerSec;
+	m_BaseTime = m_pClock->NowNs();
+	m_PrevTime = m_BaseTime;
+	m_CurrTime = m_BaseTime;
 }
 
 // Returns the total time elapsed since Reset() was called, NOT counting any
 // time when the clock is stopped.
-float GameTimer::TotalTime()const
+uint64_t GameTimer::TotalNs()const
 {
 	// If we are stopped, do not count the time that has passed since we stopped.
 	// Moreover, if we previously already had a pause, the distance 
@@ -29,7 +28,7 @@ float GameTimer::TotalTime()const
 
 	if( m_Stopped )
 	{
-		return (float)(((m_StopTime - m_PausedTime)-m_BaseTime)*m_SecondsPerCount);
+		return (m_StopTime - m_PausedTime) - m_BaseTime;
 	}
 
 	// The distance m_CurrTime - m_BaseTime includes paused time,
@@ -44,31 +43,56 @@ float GameTimer::TotalTime()const
 	
 	else
 	{
-		return (float)(((m_CurrTime-m_PausedTime)-m_BaseTime)*m_SecondsPerCount);
+		return (m_CurrTime - m_PausedTime) - m_BaseTime;
 	}
 }
 
+uint64_t GameTimer::DeltaNs()const
+{
+	return m_DeltaTime;
+}
+
+double GameTimer::TotalSeconds()const
+{
+	return TotalNs() * 1e-9;
+}
+
+double GameTimer::DeltaSeconds()const
+{
+	return m_DeltaTime * 1e-9;
+}
+
+float GameTimer::TotalTime()const
+{
+	return (float)TotalSeconds();
+}
+
 float GameTimer::DeltaTime()const
 {
-	return (float)m_DeltaTime;
+	return (float)DeltaSeconds();
+}
+
+bool GameTimer::IsStopped()const
+{
+	return m_Stopped;
 }
 
 void GameTimer::Reset()
 {
-	__int64 currTime;
-	QueryPerformanceCounter((LARGE_INTEGER*)&currTime);
+	uint64_t currTime = m_pClock->NowNs();
 
 	m_BaseTime = currTime;
 	m_PrevTime = currTime;
+	m_CurrTime = currTime;
 	m_StopTime = 0;
 	m_PausedTime = 0;	// 涉及到多次Reset的话需要将其归0
+	m_DeltaTime = 0;
 	m_Stopped  = false;
 }
 
 void GameTimer::Start()
 {
-	__int64 startTime;
-	QueryPerformanceCounter((LARGE_INTEGER*)&startTime);
+	uint64_t startTime = m_pClock->NowNs();
 
 
 	// Accumulate the time elapsed between stop and start pairs.
@@ -82,6 +106,7 @@ void GameTimer::Start()
 		m_PausedTime += (startTime - m_StopTime);	
 
 		m_PrevTime = startTime;
+		m_CurrTime = startTime;
 		m_StopTime = 0;
 		m_Stopped  = false;
 	}
@@ -91,10 +116,7 @@ void GameTimer::Stop()
 {
 	if( !m_Stopped )
 	{
-		__int64 currTime;
-		QueryPerformanceCounter((LARGE_INTEGER*)&currTime);
-
-		m_StopTime = currTime;
+		m_StopTime = m_pClock->NowNs();
 		m_Stopped  = true;
 	}
 }
@@ -103,23 +125,19 @@ void GameTimer::Tick()
 {
 	if( m_Stopped )
 	{
-		m_DeltaTime = 0.0;
+		m_DeltaTime = 0;
 		return;
 	}
 
-	__int64 currTime;
-	QueryPerformanceCounter((LARGE_INTEGER*)&currTime);
+	uint64_t currTime = m_pClock->NowNs();
+	// 时钟是单调的，这里只防御时钟被替换等异常情况
+	if (currTime < m_PrevTime)
+		currTime = m_PrevTime;
 	m_CurrTime = currTime;
 
 	// Time difference between this frame and the previous.
-	m_DeltaTime = (m_CurrTime - m_PrevTime)*m_SecondsPerCount;
+	m_DeltaTime = m_CurrTime - m_PrevTime;
 
 	// Prepare for next frame.
 	m_PrevTime = m_CurrTime;
-
-	if(m_DeltaTime < 0.0)
-	{
-		m_DeltaTime = 0.0;
-	}
 }
-
@@ -5,13 +5,22 @@
 #ifndef GAMETIMER_H
 #define GAMETIMER_H
 
+#include <cstdint>
+#include "MonotonicClock.h"
+
+// ==== 时间以 64 位纳秒保存，时钟可替换（QPC / clock_gettime / FakeClock） ====
 class GameTimer
 {
 public:
-	GameTimer();
+	explicit GameTimer(MonotonicClock& clock = MonotonicClock::GetSystemClock());
 
 	float TotalTime()const;		// 总游戏时间
 	float DeltaTime()const;		// 帧间隔时间
+	double TotalSeconds()const;	// 总游戏时间（双精度，长时间运行不损失精度）
+	double DeltaSeconds()const;	// 帧间隔时间（双精度）
+	uint64_t TotalNs()const;	// 总游戏时间（纳秒，不含暂停时间）
+	uint64_t DeltaNs()const;	// 帧间隔时间（纳秒）
+	bool IsStopped()const;
 
 	void Reset();               // 在消息循环之前调用
 	void Start();               // 在取消暂停的时候调用
@@ -19,16 +28,16 @@ public:
 	void Tick();                // 在每一帧的时候调用
 
 private:
-	double m_SecondsPerCount;
-	double m_DeltaTime;
+	MonotonicClock* m_pClock;
+	uint64_t m_DeltaTime;
 
-	__int64 m_BaseTime;
-	__int64 m_PausedTime;
-	__int64 m_StopTime;
-	__int64 m_PrevTime;
-	__int64 m_CurrTime;
+	uint64_t m_BaseTime;
+	uint64_t m_PausedTime;
+	uint64_t m_StopTime;
+	uint64_t m_PrevTime;
+	uint64_t m_CurrTime;
 
 	bool m_Stopped;
 };
 
-#endif // GAMETIMER_H
\ No newline at end of file
+#endif // GAMETIMER_H
@@ -0,0 +1,185 @@
+#include "GeometryPool.h"
+#include <cassert>
+#include <cstring>
+#include <cmath>
+
+GeometryPool::GeometryPool(uint32_t vertexStride)
+    : m_VertexStride(vertexStride)
+{
+}
+
+void GeometryPool::Clear(uint32_t vertexStride)
+{
+    m_VertexStride = vertexStride;
+    m_VertexCapacity = 0;
+    m_IndexCapacity = 0;
+    m_Vertices.clear();
+    m_Indices.clear();
+    m_Meshes.clear();
+}
+
+int GeometryPool::AddMesh(const void* pVertices, uint32_t vertexCount,
+    const uint16_t* pIndices, uint32_t indexCount, VertexFormat format, const PositionDecode* pDecode)
+{
+    m_Meshes.push_back(AppendMesh(pVertices, vertexCount, pIndices, indexCount, format, pDecode));
+    return static_cast<int>(m_Meshes.size() - 1);
+}
+
+void GeometryPool::Reserve(uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+    m_VertexCapacity = vertexCapacity;
+    m_IndexCapacity = indexCapacity;
+    m_Vertices.reserve(static_cast<size_t>(vertexCapacity) * m_VertexStride);
+    m_Indices.reserve(indexCapacity);
+}
+
+uint32_t GeometryPool::GetVertexCapacity() const
+{
+    return m_VertexCapacity;
+}
+
+uint32_t GeometryPool::GetIndexCapacity() const
+{
+    return m_IndexCapacity;
+}
+
+bool GeometryPool::ReplaceMesh(int meshId, const void* pVertices, uint32_t vertexCount,
+    const uint16_t* pIndices, uint32_t indexCount, VertexFormat format, const PositionDecode* pDecode)
+{
+    assert(meshId >= 0 && meshId < (int)m_Meshes.size());
+    uint32_t stride = GetMeshStride(format);
+    size_t vertexEnd = GetAlignedVertexEnd(stride) + static_cast<size_t>(vertexCount) * stride;
+    if (vertexEnd > static_cast<size_t>(m_VertexCapacity) * m_VertexStride || GetIndexCount() + indexCount > m_IndexCapacity)
+        return false;
+    m_Meshes[meshId] = AppendMesh(pVertices, vertexCount, pIndices, indexCount, format, pDecode);
+    return true;
+}
+
+uint32_t GeometryPool::GetMeshStride(VertexFormat format) const
+{
+    return format == VertexFormat::Float ? m_VertexStride : ::GetVertexStride(format);
+}
+
+size_t GeometryPool::GetAlignedVertexEnd(uint32_t stride) const
+{
+    return (m_Vertices.size() + stride - 1) / stride * stride;
+}
+
+GeometryPool::MeshRange GeometryPool::AppendMesh(const void* pVertices, uint32_t vertexCount,
+    const uint16_t* pIndices, uint32_t indexCount, VertexFormat format, const PositionDecode* pDecode)
+{
+    assert(m_VertexStride > 0);
+    assert(pVertices && pIndices);
+    assert(format == VertexFormat::Float || pDecode);
+
+    MeshRange range{};
+    range.format = format;
+    range.vertexStride = GetMeshStride(format);
+    if (pDecode)
+        range.decode = *pDecode;
+
+    // 起始字节对齐到网格自己的步长，BaseVertexLocation 才能以该步长为单位
+    size_t begin = GetAlignedVertexEnd(range.vertexStride);
+    range.baseVertex = static_cast<uint32_t>(begin / range.vertexStride);
+    range.vertexCount = vertexCount;
+    range.startIndex = GetIndexCount();
+    range.indexCount = indexCount;
+
+    // 顶点按字节整体拷贝，索引保持网格内的局部编号
+    size_t vertexBytes = static_cast<size_t>(vertexCount) * range.vertexStride;
+    m_Vertices.resize(begin + vertexBytes);
+    memcpy(m_Vertices.data() + begin, pVertices, vertexBytes);
+
+    m_Indices.insert(m_Indices.end(), pIndices, pIndices + indexCount);
+
+#if defined(DEBUG) || defined(_DEBUG)
+    for (uint32_t i = 0; i < indexCount; ++i)
+        assert(pIndices[i] < vertexCount);
+#endif
+
+    return range;
+}
+
+int GeometryPool::GetMeshCount() const
+{
+    return static_cast<int>(m_Meshes.size());
+}
+
+const GeometryPool::MeshRange& GeometryPool::GetMesh(int meshId) const
+{
+    assert(meshId >= 0 && meshId < (int)m_Meshes.size());
+    return m_Meshes[meshId];
+}
+
+void GeometryPool::GetPositions(int meshId, std::vector<DirectX::XMFLOAT3>& positions) const
+{
+    const MeshRange& mesh = GetMesh(meshId);
+    const uint8_t* pVertex = m_Vertices.data() + static_cast<size_t>(mesh.baseVertex) * mesh.vertexStride;
+    positions.resize(mesh.vertexCount);
+    for (uint32_t i = 0; i < mesh.vertexCount; ++i, pVertex += mesh.vertexStride)
+    {
+        if (mesh.format == VertexFormat::Packed)
+        {
+            PackedVertex packed;
+            memcpy(&packed, pVertex, sizeof(packed));
+            FloatVertex vertex;
+            UnpackVertex(packed, mesh.decode, vertex);
+            positions[i] = vertex.pos;
+        }
+        else
+        {
+            assert(mesh.vertexStride >= sizeof(DirectX::XMFLOAT3));
+            memcpy(&positions[i], pVertex, sizeof(DirectX::XMFLOAT3));
+        }
+    }
+}
+
+float GeometryPool::ComputeBoundingRadius(int meshId) const
+{
+    std::vector<DirectX::XMFLOAT3> positions;
+    GetPositions(meshId, positions);
+
+    float maxSq = 0.0f;
+    for (const DirectX::XMFLOAT3& pos : positions)
+    {
+        float sq = pos.x * pos.x + pos.y * pos.y + pos.z * pos.z;
+        if (sq > maxSq)
+            maxSq = sq;
+    }
+    return std::sqrt(maxSq);
+}
+
+uint32_t GeometryPool::GetVertexStride() const
+{
+    return m_VertexStride;
+}
+
+uint32_t GeometryPool::GetVertexCount() const
+{
+    return m_VertexStride ? static_cast<uint32_t>(m_Vertices.size() / m_VertexStride) : 0;
+}
+
+uint32_t GeometryPool::GetIndexCount() const
+{
+    return static_cast<uint32_t>(m_Indices.size());
+}
+
+const void* GeometryPool::GetVertexData() const
+{
+    return m_Vertices.data();
+}
+
+const uint16_t* GeometryPool::GetIndexData() const
+{
+    return m_Indices.data();
+}
+
+uint32_t GeometryPool::GetVertexByteSize() const
+{
+    return static_cast<uint32_t>(m_Vertices.size());
+}
+
+uint32_t GeometryPool::GetIndexByteSize() const
+{
+    return static_cast<uint32_t>(m_Indices.size() * sizeof(uint16_t));
+}
@@ -0,0 +1,89 @@
+//***************************************************************************************
+// GeometryPool.h
+//
+// 几何池：把多个网格的顶点/索引依次拼接到同一份顶点数组和索引数组中，
+// 并记录每个网格的 BaseVertexLocation / StartIndexLocation。
+// 索引保持网格内的局部编号（16 位），绘制时由 BaseVertexLocation 偏移。
+// 预留容量后可以在运行中替换网格（新数据追加到末尾，网格 id 不变），
+// 渲染端只需上传新追加的部分，用于后台加载完成后替换占位网格。
+// 每个网格可以有自己的顶点格式（见 VertexFormat.h）：Float 网格的步长为池的默认步长，
+// Packed 网格为 PackedVertex。网格数据的起始字节按自己的步长对齐，
+// 绑定时以网格的步长绑定同一个顶点缓冲，BaseVertexLocation 仍以该步长为单位。
+//***************************************************************************************
+
+#ifndef GEOMETRYPOOL_H
+#define GEOMETRYPOOL_H
+
+#include "VertexFormat.h"
+#include <cstdint>
+#include <vector>
+
+class GeometryPool
+{
+public:
+    // 网格在池中的位置
+    struct MeshRange
+    {
+        uint32_t baseVertex;    // 第一个顶点在顶点数组中的位置（以 vertexStride 为单位）
+        uint32_t vertexCount;
+        uint32_t startIndex;    // 第一个索引在索引数组中的位置
+        uint32_t indexCount;
+        VertexFormat format;
+        uint32_t vertexStride;
+        PositionDecode decode;  // Packed 网格的位置反量化参数，Float 网格不用
+    };
+
+public:
+    // vertexStride 为 Float 网格的步长
+    explicit GeometryPool(uint32_t vertexStride = 0);
+
+    void Clear(uint32_t vertexStride);
+
+    // 追加一个网格，返回网格 id（按添加顺序从 0 开始）；Packed 网格需要给出 pDecode
+    int AddMesh(const void* pVertices, uint32_t vertexCount,
+        const uint16_t* pIndices, uint32_t indexCount,
+        VertexFormat format = VertexFormat::Float, const PositionDecode* pDecode = nullptr);
+
+    // ==== 运行中替换网格 ====
+    // 预留的顶点/索引容量（顶点按默认步长计），渲染端按容量创建可写的 GPU 缓冲；0 表示不预留（缓冲不可写）
+    void Reserve(uint32_t vertexCapacity, uint32_t indexCapacity);
+    uint32_t GetVertexCapacity() const;
+    uint32_t GetIndexCapacity() const;
+    // 把新数据追加到末尾并让 meshId 指向它，旧数据保留在原处不再被引用；超出预留容量时返回 false
+    bool ReplaceMesh(int meshId, const void* pVertices, uint32_t vertexCount,
+        const uint16_t* pIndices, uint32_t indexCount,
+        VertexFormat format = VertexFormat::Float, const PositionDecode* pDecode = nullptr);
+
+    int GetMeshCount() const;
+    const MeshRange& GetMesh(int meshId) const;
+    // 网格的模型空间顶点位置（Packed 网格解码后给出），要求 Float 网格每个顶点的前 12 字节为 float3 位置
+    void GetPositions(int meshId, std::vector<DirectX::XMFLOAT3>& positions) const;
+    // 网格顶点到原点的最大距离
+    float ComputeBoundingRadius(int meshId) const;
+
+    uint32_t GetVertexStride() const;
+    // 已用的顶点数据按默认步长折算的顶点数
+    uint32_t GetVertexCount() const;
+    uint32_t GetIndexCount() const;
+    const void* GetVertexData() const;
+    const uint16_t* GetIndexData() const;
+    uint32_t GetVertexByteSize() const;
+    uint32_t GetIndexByteSize() const;
+
+private:
+    MeshRange AppendMesh(const void* pVertices, uint32_t vertexCount,
+        const uint16_t* pIndices, uint32_t indexCount, VertexFormat format, const PositionDecode* pDecode);
+    // 下一个网格按 stride 对齐后的起始字节
+    size_t GetAlignedVertexEnd(uint32_t stride) const;
+    uint32_t GetMeshStride(VertexFormat format) const;
+
+private:
+    uint32_t m_VertexStride;
+    uint32_t m_VertexCapacity = 0;
+    uint32_t m_IndexCapacity = 0;
+    std::vector<uint8_t> m_Vertices;
+    std::vector<uint16_t> m_Indices;
+    std::vector<MeshRange> m_Meshes;
+};
+
+#endif
@@ -0,0 +1,89 @@
+//***************************************************************************************
+// GlyphCooker.cpp
+//
+// 离线字形网格烘焙工具：OBJ -> 字形网格文件（格式见 GlyphMeshFormat.h）。
+// 处理流程与 NameVertices 在启动时做的相同，只是提前到烘焙时完成：
+//   导入 OBJ（语义同 node/转化.py）-> 按三角形展开并用几何法线 -> 统一缩放
+//   -> 顶点焊接 -> 索引重排 -> 能压缩时转换为 Packed 格式（导入之后的步骤见 MeshCook.h）。
+// 用法：GlyphCooker [-float] [-scale s] <输入.obj> <输出.gmesh>
+//   -float    保持 40 字节的 Float 格式（默认能压缩时使用 16 字节的 Packed 格式）
+//   -scale s  位置缩放系数（默认 0.1，与 NameVertices 相同）
+//***************************************************************************************
+
+#include "../JobSystem.h"
+#include "MeshCook.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void PrintUsage()
+{
+    fprintf(stderr, "用法：GlyphCooker [-float] [-scale s] <输入.obj> <输出.gmesh>\n");
+}
+
+int main(int argc, char** argv)
+{
+    CookOptions options;
+    const char* inputPath = nullptr;
+    const char* outputPath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-float") == 0)
+            options.allowPacked = false;
+        else if (strcmp(argv[i], "-scale") == 0 && i + 1 < argc)
+            options.scale = static_cast<float>(atof(argv[++i]));
+        else if (!inputPath)
+            inputPath = argv[i];
+        else if (!outputPath)
+            outputPath = argv[i];
+        else
+            inputPath = nullptr;
+    }
+    if (!inputPath || !outputPath)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // ==== 导入 ====
+    ObjMesh obj;
+    JobSystem jobs;
+    ObjImporter importer(&jobs);
+    if (!importer.Import(inputPath, obj))
+    {
+        fprintf(stderr, "%s：%s\n", inputPath, importer.GetError().c_str());
+        return 1;
+    }
+
+    // ==== 烘焙、写出 ====
+    CookedMesh cooked;
+    std::string error;
+    if (!CookMesh(obj, options, cooked, &error))
+    {
+        fprintf(stderr, "%s：%s\n", inputPath, error.c_str());
+        return 1;
+    }
+    const GlyphMeshDesc& desc = cooked.desc;
+    if (!GlyphMeshFile::Write(outputPath, desc))
+    {
+        fprintf(stderr, "%s：写入失败\n", outputPath);
+        return 1;
+    }
+
+    const ObjImportStats& importStats = importer.GetStats();
+    const double importSeconds = importStats.parseSeconds + importStats.buildSeconds;
+    printf("%s -> %s\n", inputPath, outputPath);
+    printf("  导入 %.2f MB，%.3f 秒（解析 %.3f，三角化 %.3f），%.1f MB/s，%u 个工作线程\n",
+        importStats.bytes / (1024.0 * 1024.0), importSeconds, importStats.parseSeconds, importStats.buildSeconds,
+        importSeconds > 0.0 ? importStats.bytes / (1024.0 * 1024.0) / importSeconds : 0.0, jobs.GetWorkerCount());
+    printf("  三角形 %u，顶点 %u -> %u，格式 %s（%u 字节/顶点）\n", desc.indexCount / 3,
+        cooked.weldStats.inputVertices, desc.vertexCount, desc.format == VertexFormat::Packed ? "Packed" : "Float",
+        GetVertexStride(desc.format));
+    printf("  ACMR %.3f -> %.3f，ATVR %.3f -> %.3f\n", desc.acmrBefore, desc.acmrAfter, desc.atvrBefore, desc.atvrAfter);
+    if (desc.format == VertexFormat::Packed)
+    {
+        printf("  压缩误差 位置 %.2e，法线 %.4f°，颜色 %.4f\n", cooked.packError.position,
+            DirectX::XMConvertToDegrees(cooked.packError.normal), cooked.packError.color);
+    }
+    return 0;
+}
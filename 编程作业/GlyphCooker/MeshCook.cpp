@@ -0,0 +1,124 @@
+#include "MeshCook.h"
+#include "../MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// 三角形展开：每个三角形三个独立顶点，法线为三角形的几何法线（与 NameVertices 相同）
+static void ExpandTriangles(const ObjMesh& obj, float scale, std::vector<FloatVertex>& vertices)
+{
+    vertices.resize(obj.indices.size());
+    for (size_t i = 0; i + 2 < obj.indices.size(); i += 3)
+    {
+        float p[3][3];
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            const ObjVertex& source = obj.vertices[obj.indices[i + corner]];
+            for (int axis = 0; axis < 3; ++axis)
+                p[corner][axis] = static_cast<float>(source.pos[axis]);
+        }
+        float e1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+        float e2[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+        float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        // 退化三角形不可见，法线随便取一个单位向量，保证网格仍然可以压缩
+        if (length > 0.0f)
+        {
+            n[0] /= length;
+            n[1] /= length;
+            n[2] /= length;
+        }
+        else
+        {
+            n[0] = 0.0f;
+            n[1] = 0.0f;
+            n[2] = 1.0f;
+        }
+
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            const ObjVertex& source = obj.vertices[obj.indices[i + corner]];
+            FloatVertex& v = vertices[i + corner];
+            v.pos = DirectX::XMFLOAT3(p[corner][0] * scale, p[corner][1] * scale, p[corner][2] * scale);
+            v.normal = DirectX::XMFLOAT3(n[0], n[1], n[2]);
+            v.color = DirectX::XMFLOAT4(source.color[0], source.color[1], source.color[2], source.color[3]);
+        }
+    }
+}
+
+bool CookMesh(const ObjMesh& obj, const CookOptions& options, CookedMesh& cooked, std::string* pError)
+{
+    // ==== 展开、焊接 ====
+    std::vector<FloatVertex> expanded;
+    ExpandTriangles(obj, options.scale, expanded);
+    static const WeldAttribute attributes[] = {
+        { offsetof(FloatVertex, pos),    3, 1e-5f },
+        { offsetof(FloatVertex, normal), 3, 1e-4f },
+        { offsetof(FloatVertex, color),  4, 1.0f / 512.0f }
+    };
+    const uint32_t attributeCount = sizeof(attributes) / sizeof(attributes[0]);
+
+    // 焊接的结果用 16 位索引：展开后的顶点数不超过这个范围时焊接结果一定也不超过
+    if (expanded.empty() || expanded.size() > UINT16_MAX)
+    {
+        if (pError)
+            *pError = "三角形数 " + std::to_string(expanded.size() / 3) + " 为 0 或超过 16 位索引能表示的范围";
+        return false;
+    }
+    std::vector<uint8_t> weldedVertices;
+    cooked.weldStats = WeldVertices(expanded.data(), static_cast<uint32_t>(expanded.size()), sizeof(FloatVertex),
+        attributes, attributeCount, nullptr, static_cast<uint32_t>(expanded.size()), weldedVertices, cooked.indices);
+    const uint32_t vertexCount = cooked.weldStats.outputVertices;
+    const uint32_t indexCount = static_cast<uint32_t>(cooked.indices.size());
+    cooked.vertices.resize(vertexCount);
+    memcpy(cooked.vertices.data(), weldedVertices.data(), weldedVertices.size());
+
+    // ==== 索引重排 ====
+    VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(cooked.indices.data(), indexCount, vertexCount);
+    MeshOptimizer::OptimizeOverdraw(cooked.indices.data(), cooked.indices.data(), indexCount,
+        cooked.vertices.data(), vertexCount, sizeof(FloatVertex));
+    VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(cooked.indices.data(), indexCount, vertexCount);
+
+    // ==== 文件描述 ====
+    GlyphMeshDesc& desc = cooked.desc;
+    desc = GlyphMeshDesc();
+    desc.format = VertexFormat::Float;
+    desc.pVertices = cooked.vertices.data();
+    desc.vertexCount = vertexCount;
+    desc.pIndices = cooked.indices.data();
+    desc.indexCount = indexCount;
+    desc.sourceVertexCount = cooked.weldStats.inputVertices;
+    desc.acmrBefore = before.acmr;
+    desc.acmrAfter = after.acmr;
+    desc.atvrBefore = before.atvr;
+    desc.atvrAfter = after.atvr;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        desc.aabbMin[axis] = (&cooked.vertices[0].pos.x)[axis];
+        desc.aabbMax[axis] = desc.aabbMin[axis];
+    }
+    for (const FloatVertex& v : cooked.vertices)
+    {
+        const float pos[3] = { v.pos.x, v.pos.y, v.pos.z };
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            desc.aabbMin[axis] = std::min(desc.aabbMin[axis], pos[axis]);
+            desc.aabbMax[axis] = std::max(desc.aabbMax[axis], pos[axis]);
+        }
+    }
+
+    cooked.packed.clear();
+    cooked.packError = PackError();
+    if (options.allowPacked && PackVertices(cooked.vertices.data(), vertexCount, cooked.packed, desc.decode))
+    {
+        cooked.packError = MeasurePackError(cooked.vertices.data(), cooked.packed.data(), vertexCount, desc.decode);
+        desc.format = VertexFormat::Packed;
+        desc.pVertices = cooked.packed.data();
+        desc.packError[0] = cooked.packError.position;
+        desc.packError[1] = cooked.packError.normal;
+        desc.packError[2] = cooked.packError.color;
+    }
+    return true;
+}
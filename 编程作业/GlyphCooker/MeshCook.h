@@ -0,0 +1,42 @@
+//***************************************************************************************
+// MeshCook.h
+//
+// GlyphCooker 的烘焙流程（不含文件读写），单独拿出来供工具和测试共用：
+//   按三角形展开并用几何法线 -> 统一缩放 -> 顶点焊接 -> 索引重排 -> 能压缩时转换为 Packed 格式。
+// 结果中的 desc 可以直接交给 GlyphMeshFile::Write。
+//***************************************************************************************
+
+#ifndef MESHCOOK_H
+#define MESHCOOK_H
+
+#include "../GlyphMeshFile.h"
+#include "../MeshWelder.h"
+#include "../VertexFormat.h"
+#include "ObjImporter.h"
+#include <string>
+#include <vector>
+
+struct CookOptions
+{
+    bool allowPacked = true;        // false 时保持 40 字节的 Float 格式
+    float scale = 0.1f;             // 位置缩放系数，默认与 NameVertices 相同
+};
+
+struct CookedMesh
+{
+    std::vector<FloatVertex> vertices;      // 焊接、重排后的 Float 顶点（压缩时也保留）
+    std::vector<PackedVertex> packed;       // 压缩后的顶点，desc.format 为 Packed 时有效
+    std::vector<uint16_t> indices;
+    WeldStats weldStats;
+    PackError packError;
+    GlyphMeshDesc desc;                     // 顶点和索引指向上面的缓冲
+
+    CookedMesh() = default;
+    CookedMesh(const CookedMesh&) = delete;
+    CookedMesh& operator=(const CookedMesh&) = delete;
+};
+
+// 展开后的顶点数超过 16 位索引的范围时返回 false，原因写入 *pError
+bool CookMesh(const ObjMesh& obj, const CookOptions& options, CookedMesh& cooked, std::string* pError);
+
+#endif
@@ -0,0 +1,762 @@
+#include "ObjImporter.h"
+#include "../JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    // 与 Python random 模块相同的 MT19937：整数种子按 init_by_array 播种，
+    // random() 用两次输出拼成 53 位尾数，颜色才能与 转化.py 生成的完全一致
+    class PythonRandom
+    {
+    public:
+        explicit PythonRandom(uint32_t seed)
+        {
+            m_State[0] = 19650218u;
+            for (int i = 1; i < kN; ++i)
+                m_State[i] = 1812433253u * (m_State[i - 1] ^ (m_State[i - 1] >> 30)) + static_cast<uint32_t>(i);
+
+            // init_by_array，key 只有一个元素
+            int i = 1;
+            for (int k = kN; k > 0; --k)
+            {
+                m_State[i] = (m_State[i] ^ ((m_State[i - 1] ^ (m_State[i - 1] >> 30)) * 1664525u)) + seed;
+                if (++i >= kN) { m_State[0] = m_State[kN - 1]; i = 1; }
+            }
+            for (int k = kN - 1; k > 0; --k)
+            {
+                m_State[i] = (m_State[i] ^ ((m_State[i - 1] ^ (m_State[i - 1] >> 30)) * 1566083941u)) - static_cast<uint32_t>(i);
+                if (++i >= kN) { m_State[0] = m_State[kN - 1]; i = 1; }
+            }
+            m_State[0] = 0x80000000u;
+            m_Index = kN;
+        }
+
+        double Random()
+        {
+            uint32_t a = Next() >> 5;
+            uint32_t b = Next() >> 6;
+            return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+        }
+
+    private:
+        uint32_t Next()
+        {
+            if (m_Index >= kN)
+            {
+                for (int i = 0; i < kN; ++i)
+                {
+                    uint32_t y = (m_State[i] & 0x80000000u) | (m_State[(i + 1) % kN] & 0x7fffffffu);
+                    m_State[i] = m_State[(i + kM) % kN] ^ (y >> 1) ^ ((y & 1u) ? 0x9908b0dfu : 0u);
+                }
+                m_Index = 0;
+            }
+            uint32_t y = m_State[m_Index++];
+            y ^= y >> 11;
+            y ^= (y << 7) & 0x9d2c5680u;
+            y ^= (y << 15) & 0xefc60000u;
+            y ^= y >> 18;
+            return y;
+        }
+
+        static const int kN = 624;
+        static const int kM = 397;
+        uint32_t m_State[kN];
+        int m_Index;
+    };
+
+    const uint32_t kColorSeed = 12345;
+    const uint32_t kNoNormal = UINT32_MAX;
+    const uint32_t kBadNormal = UINT32_MAX - 1;
+    // 每段至少这么多字节，再小调度开销就比解析本身大
+    const size_t kMinSegmentBytes = 256 * 1024;
+    // 每个线程分几段，各段解析速度不均时空闲线程可以窃取剩下的段
+    const uint32_t kSegmentsPerThread = 4;
+    const uint32_t kNormalizeGrain = 64 * 1024;
+
+    // 段内的面顶点：负编号相对于段开头，合并时加上之前各段的元素数
+    const uint32_t kRelativePosition = 1;
+    const uint32_t kRelativeNormal = 2;
+    const uint32_t kHasNormal = 4;
+
+    struct RawCorner
+    {
+        int32_t position;
+        int32_t normal;
+        uint32_t flags;
+    };
+
+    // 10 的 0~22 次幂都可以用 double 精确表示
+    const double kPow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const uint64_t kMaxExactMantissa = 1ull << 53;
+    const int kMaxMantissaDigits = 19;
+    const size_t kMaxSlowTokenLength = 255;
+
+    // 与 Python 的 str.split() / strip() 相同的 ASCII 空白（换行已经在切行时去掉）
+    inline bool IsBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    inline bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // 取下一个以空白分隔的记号
+    inline bool NextToken(const char*& p, const char* end, const char*& tokenBegin, const char*& tokenEnd)
+    {
+        while (p < end && IsBlank(*p))
+            ++p;
+        if (p == end)
+            return false;
+        tokenBegin = p;
+        while (p < end && !IsBlank(*p))
+            ++p;
+        tokenEnd = p;
+        return true;
+    }
+
+    // 罕见写法（inf / nan、超过 19 位有效数字、很大的指数）交给 strtod，同样要求整个记号都是数；
+    // strtod 额外接受的十六进制和 nan(...) 写法 Python 不接受
+    bool ParseDoubleSlow(const char* p, const char* end, double& value)
+    {
+        char token[kMaxSlowTokenLength + 1];
+        const size_t length = static_cast<size_t>(end - p);
+        if (length == 0 || length > kMaxSlowTokenLength)
+            return false;
+        for (size_t i = 0; i < length; ++i)
+        {
+            if (p[i] == 'x' || p[i] == 'X' || p[i] == '(')
+                return false;
+            token[i] = p[i];
+        }
+        token[length] = '\0';
+        char* pEnd = nullptr;
+        value = strtod(token, &pEnd);
+        return pEnd == token + length;
+    }
+
+    // ==== 数值解析：整个记号必须是一个数，结果与 Python 的 float() 相同（正确舍入） ====
+    // 有效数字不超过 19 位时尾数是精确的整数；尾数不超过 2^53 且十进制指数不超过 22 时，
+    // 尾数和 10 的幂都能精确表示，一次乘法或除法只舍入一次，结果就是正确舍入的（Clinger 快速路径）
+    inline bool ParseDouble(const char* p, const char* end, double& value)
+    {
+        const char* start = p;
+        bool negative = false;
+        if (p < end && (*p == '+' || *p == '-'))
+            negative = *p++ == '-';
+
+        uint64_t mantissa = 0;
+        int digits = 0;             // 尾数中的有效数字（不含前导 0）
+        int exponent = 0;
+        bool anyDigit = false;
+        bool exact = true;
+        for (; p < end && IsDigit(*p); ++p)
+        {
+            anyDigit = true;
+            if (digits < kMaxMantissaDigits)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                digits += mantissa != 0;
+            }
+            else
+            {
+                exact = false;
+            }
+        }
+        if (p < end && *p == '.')
+        {
+            for (++p; p < end && IsDigit(*p); ++p)
+            {
+                anyDigit = true;
+                if (digits < kMaxMantissaDigits)
+                {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    digits += mantissa != 0;
+                    --exponent;
+                }
+                else
+                {
+                    exact = false;
+                }
+            }
+        }
+        if (anyDigit && p < end && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            bool negativeExponent = false;
+            if (p < end && (*p == '+' || *p == '-'))
+                negativeExponent = *p++ == '-';
+            int e = 0;
+            bool anyExponentDigit = false;
+            for (; p < end && IsDigit(*p); ++p)
+            {
+                anyExponentDigit = true;
+                if (e < 100000)
+                    e = e * 10 + (*p - '0');
+            }
+            if (!anyExponentDigit)
+                return false;
+            exponent += negativeExponent ? -e : e;
+        }
+
+        if (!anyDigit || p != end || !exact || mantissa > kMaxExactMantissa || exponent < -22 || exponent > 22)
+            return ParseDoubleSlow(start, end, value);
+
+        double result = static_cast<double>(mantissa);
+        result = exponent >= 0 ? result * kPow10[exponent] : result / kPow10[-exponent];
+        value = negative ? -result : result;
+        return true;
+    }
+
+    // 整个记号为十进制整数（可带符号），超出 int32 时失败
+    inline bool ParseInt(const char* p, const char* end, int64_t& value)
+    {
+        bool negative = false;
+        if (p < end && (*p == '+' || *p == '-'))
+            negative = *p++ == '-';
+        if (p == end)
+            return false;
+        int64_t result = 0;
+        for (; p < end; ++p)
+        {
+            if (!IsDigit(*p))
+                return false;
+            result = result * 10 + (*p - '0');
+            if (result > INT32_MAX)
+                return false;
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    // OBJ 编号从 1 开始；负数相对于段内已读到的 count 个元素，结果可能指向之前的段
+    inline bool ResolveIndex(const char* p, const char* end, size_t count, int32_t& index, bool& relative)
+    {
+        int64_t value = 0;
+        if (!ParseInt(p, end, value) || value == 0)
+            return false;
+        relative = value < 0;
+        int64_t resolved = relative ? static_cast<int64_t>(count) + value : value - 1;
+        if (resolved > INT32_MAX || resolved < INT32_MIN)
+            return false;
+        index = static_cast<int32_t>(resolved);
+        return true;
+    }
+
+    // 面的一个顶点，写法与脚本一致：含 "//" 时必须正好是 a//b 两段，否则按 '/' 取前三段
+    bool ParseCorner(const char* p, const char* end, size_t positionCount, size_t normalCount, RawCorner& corner)
+    {
+        const char* vBegin = p;
+        const char* vEnd = end;
+        const char* vtBegin = end;
+        const char* vtEnd = end;
+        const char* vnBegin = end;
+        const char* vnEnd = end;
+        corner.flags = 0;
+
+        const char* pDouble = nullptr;
+        for (const char* s = p; s + 1 < end; ++s)
+        {
+            if (s[0] == '/' && s[1] == '/')
+            {
+                pDouble = s;
+                break;
+            }
+        }
+        if (pDouble)
+        {
+            vEnd = pDouble;
+            vnBegin = pDouble + 2;
+            for (const char* s = vnBegin; s + 1 < end; ++s)
+            {
+                if (s[0] == '/' && s[1] == '/')
+                    return false;
+            }
+            corner.flags |= kHasNormal;
+        }
+        else
+        {
+            const char* slash1 = static_cast<const char*>(memchr(p, '/', end - p));
+            if (slash1)
+            {
+                vEnd = slash1;
+                vtBegin = slash1 + 1;
+                const char* slash2 = static_cast<const char*>(memchr(vtBegin, '/', end - vtBegin));
+                if (slash2)
+                {
+                    vtEnd = slash2;
+                    vnBegin = slash2 + 1;
+                    const char* slash3 = static_cast<const char*>(memchr(vnBegin, '/', end - vnBegin));
+                    vnEnd = slash3 ? slash3 : end;
+                    if (vnBegin != vnEnd)
+                        corner.flags |= kHasNormal;
+                }
+            }
+        }
+
+        bool relative = false;
+        if (!ResolveIndex(vBegin, vEnd, positionCount, corner.position, relative))
+            return false;
+        if (relative)
+            corner.flags |= kRelativePosition;
+        int64_t unused = 0;
+        if (vtBegin != vtEnd && !ParseInt(vtBegin, vtEnd, unused))
+            return false;
+        corner.normal = 0;
+        if (corner.flags & kHasNormal)
+        {
+            if (!ResolveIndex(vnBegin, vnEnd, normalCount, corner.normal, relative))
+                return false;
+            if (relative)
+                corner.flags |= kRelativeNormal;
+        }
+        return true;
+    }
+
+    // 从文件读取至多 chunkBytes 字节，放在 buffer 的前 size 字节之后，返回读到的字节数。
+    // 缓冲按实际需要增长，小文件不会分配整块
+    size_t ReadChunk(std::ifstream& file, size_t chunkBytes, uint64_t& remaining, std::vector<char>& buffer, size_t size)
+    {
+        const size_t bytes = static_cast<size_t>(std::min<uint64_t>(chunkBytes, remaining));
+        if (buffer.size() < size + bytes)
+            buffer.resize(size + bytes);
+        file.read(buffer.data() + size, static_cast<std::streamsize>(bytes));
+        const size_t readBytes = static_cast<size_t>(file.gcount());
+        // 读到的比预期少（文件被截断或读取出错）时不再继续
+        remaining = readBytes < bytes ? 0 : remaining - bytes;
+        return readBytes;
+    }
+
+    // 长度平方不超过 1e-12 时返回 (0, 0, 1)，与脚本的 normalize 相同
+    inline void Normalize(double v[3])
+    {
+        double lengthSq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+        if (lengthSq <= 1e-12)
+        {
+            v[0] = 0.0; v[1] = 0.0; v[2] = 1.0;
+            return;
+        }
+        double length = std::sqrt(lengthSq);
+        v[0] /= length; v[1] /= length; v[2] /= length;
+    }
+
+    inline void FaceNormal(const ObjVertex& a, const ObjVertex& b, const ObjVertex& c, double normal[3])
+    {
+        double e1[3] = { b.pos[0] - a.pos[0], b.pos[1] - a.pos[1], b.pos[2] - a.pos[2] };
+        double e2[3] = { c.pos[0] - a.pos[0], c.pos[1] - a.pos[1], c.pos[2] - a.pos[2] };
+        normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+        normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+        normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        Normalize(normal);
+    }
+
+    // Python 的 round(x, 2)：按 double 的精确值舍入到两位小数，恰好在中点时取偶数。
+    // x * 100 与中点 k + 0.5 的大小用 fma 比较：fma 只在最后舍入一次，结果的符号与精确差值相同
+    inline double RoundTo2(double value)
+    {
+        double k = std::floor(value * 100.0);
+        double d = std::fma(value, 100.0, -(k + 0.5));
+        if (d > 0.0 || (d == 0.0 && std::fmod(k, 2.0) != 0.0))
+            k += 1.0;
+        return k / 100.0;
+    }
+}
+
+// ==== 一段文本的解析结果，各段互不依赖，可以并行 ====
+struct ObjImporter::Segment
+{
+    const char* pBegin = nullptr;
+    const char* pEnd = nullptr;
+    std::vector<double> positions;      // 每 3 个一组
+    std::vector<double> normals;        // 已归一化，每 3 个一组
+    std::vector<RawCorner> corners;
+    std::vector<uint32_t> faceSizes;
+    uint64_t lines = 0;                 // 段内的行数；出错时为出错行之前的行数
+    std::string error;                  // 非空表示出错
+
+    void Parse();
+    bool ParseLine(const char* p, const char* end);
+};
+
+void ObjImporter::Segment::Parse()
+{
+    positions.clear();
+    normals.clear();
+    corners.clear();
+    faceSizes.clear();
+    lines = 0;
+    error.clear();
+
+    // 与 Python 的通用换行一致：\n、\r\n、单独的 \r 都是行尾。
+    // 先用 memchr 找 \n，再在这一行里找 \r，比逐字节比较两种字符快
+    const char* p = pBegin;
+    while (p < pEnd)
+    {
+        const char* pNewline = static_cast<const char*>(memchr(p, '\n', pEnd - p));
+        const char* lineEnd = pNewline ? pNewline : pEnd;
+        const char* pReturn = static_cast<const char*>(memchr(p, '\r', lineEnd - p));
+        if (pReturn)
+            lineEnd = pReturn;
+        if (!ParseLine(p, lineEnd))
+            return;
+        ++lines;
+        p = lineEnd;
+        if (p < pEnd && *p == '\r')
+            ++p;
+        if (p < pEnd && *p == '\n' && p == pNewline)
+            ++p;
+    }
+}
+
+bool ObjImporter::Segment::ParseLine(const char* p, const char* end)
+{
+    while (p < end && IsBlank(*p))
+        ++p;
+    while (end > p && IsBlank(end[-1]))
+        --end;
+    if (end - p < 2 || *p == '#')
+        return true;
+
+    const char* tokenBegin[3];
+    const char* tokenEnd[3];
+    if (p[0] == 'v' && (p[1] == ' ' || (p[1] == 'n' && end - p >= 3 && p[2] == ' ')))
+    {
+        // 少于三个分量的行与脚本一样直接跳过，多出的分量（如 w 或顶点色）不检查
+        const bool isNormal = p[1] == 'n';
+        p += isNormal ? 3 : 2;
+        int count = 0;
+        while (count < 3 && NextToken(p, end, tokenBegin[count], tokenEnd[count]))
+            ++count;
+        if (count < 3)
+            return true;
+        double v[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (!ParseDouble(tokenBegin[axis], tokenEnd[axis], v[axis]))
+            {
+                error = isNormal ? "法线无法解析" : "顶点坐标无法解析";
+                return false;
+            }
+        }
+        if (!isNormal)
+        {
+            positions.insert(positions.end(), v, v + 3);
+            return true;
+        }
+        // 脚本只把长度正好为 0 的法线换成 (0, 0, 1)
+        double length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (length == 0.0)
+        {
+            v[0] = 0.0; v[1] = 0.0; v[2] = 1.0;
+            length = 1.0;
+        }
+        normals.push_back(v[0] / length);
+        normals.push_back(v[1] / length);
+        normals.push_back(v[2] / length);
+    }
+    else if (p[0] == 'f' && p[1] == ' ')
+    {
+        p += 2;
+        const size_t faceStart = corners.size();
+        const char* cornerBegin;
+        const char* cornerEnd;
+        while (NextToken(p, end, cornerBegin, cornerEnd))
+        {
+            RawCorner corner;
+            if (!ParseCorner(cornerBegin, cornerEnd, positions.size() / 3, normals.size() / 3, corner))
+            {
+                error = "面无法解析";
+                return false;
+            }
+            corners.push_back(corner);
+        }
+        const size_t cornerCount = corners.size() - faceStart;
+        if (cornerCount >= 3)
+            faceSizes.push_back(static_cast<uint32_t>(cornerCount));
+        else
+            corners.resize(faceStart);
+    }
+    return true;
+}
+
+ObjImporter::ObjImporter(JobSystem* pJobs, size_t chunkBytes)
+    : m_pJobs(pJobs), m_ChunkBytes(std::max<size_t>(chunkBytes, 4096))
+{
+}
+
+const std::string& ObjImporter::GetError() const
+{
+    return m_Error;
+}
+
+const ObjImportStats& ObjImporter::GetStats() const
+{
+    return m_Stats;
+}
+
+bool ObjImporter::Fail(const std::string& message)
+{
+    m_Error = message;
+    return false;
+}
+
+// ==== 按块读取：最后一个换行之后的不完整行留给下一块，解析当前块的同时读取下一块 ====
+bool ObjImporter::Import(const char* path, ObjMesh& mesh)
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+
+    mesh.vertices.clear();
+    mesh.indices.clear();
+    m_Error.clear();
+    m_Stats = ObjImportStats();
+    m_Normals.clear();
+    m_Corners.clear();
+    m_FaceSizes.clear();
+    m_LineCount = 0;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return Fail("无法打开文件");
+
+    file.seekg(0, std::ios::end);
+    uint64_t remaining = static_cast<uint64_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    std::vector<char> buffer;
+    std::vector<char> nextBuffer;
+    size_t size = ReadChunk(file, m_ChunkBytes, remaining, buffer, 0);
+    std::vector<Segment> segments;
+    while (size > 0)
+    {
+        size_t cut = size;
+        if (remaining > 0)
+        {
+            const char* pData = buffer.data();
+            const char* pLast = pData + size;
+            while (pLast > pData && pLast[-1] != '\n')
+                --pLast;
+            // 一行比整块还长：扩大缓冲继续读
+            if (pLast == pData)
+            {
+                size += ReadChunk(file, m_ChunkBytes, remaining, buffer, size);
+                continue;
+            }
+            cut = static_cast<size_t>(pLast - pData);
+        }
+
+        const char* pChunkBegin = buffer.data();
+        const char* pChunkEnd = buffer.data() + cut;
+        JobSystem::JobHandle parse;
+        if (m_pJobs)
+            parse = m_pJobs->Schedule([this, pChunkBegin, pChunkEnd, &segments]() { ParseChunk(pChunkBegin, pChunkEnd, segments); });
+        else
+            ParseChunk(pChunkBegin, pChunkEnd, segments);
+
+        // 不完整的行拷到下一块开头，再接着读
+        const size_t tail = size - cut;
+        if (tail > 0)
+        {
+            if (nextBuffer.size() < tail)
+                nextBuffer.resize(tail);
+            memcpy(nextBuffer.data(), buffer.data() + cut, tail);
+        }
+        const size_t nextSize = tail + ReadChunk(file, m_ChunkBytes, remaining, nextBuffer, tail);
+
+        if (m_pJobs)
+            m_pJobs->Wait(parse);
+        m_Stats.bytes += cut;
+        ++m_Stats.chunks;
+        if (!MergeSegments(segments, mesh))
+            return false;
+
+        buffer.swap(nextBuffer);
+        size = nextSize;
+    }
+    if (file.bad())
+        return Fail("读取文件失败");
+
+    Clock::time_point parsed = Clock::now();
+    m_Stats.parseSeconds = std::chrono::duration<double>(parsed - start).count();
+    bool ok = BuildMesh(mesh);
+    m_Stats.buildSeconds = std::chrono::duration<double>(Clock::now() - parsed).count();
+
+    std::vector<double>().swap(m_Normals);
+    std::vector<Corner>().swap(m_Corners);
+    std::vector<uint32_t>().swap(m_FaceSizes);
+    return ok;
+}
+
+// 把一块切成若干段（在换行处切开）并行解析
+void ObjImporter::ParseChunk(const char* pBegin, const char* pEnd, std::vector<Segment>& segments)
+{
+    const size_t bytes = static_cast<size_t>(pEnd - pBegin);
+    const uint32_t maxSegments = m_pJobs ? (m_pJobs->GetWorkerCount() + 1) * kSegmentsPerThread : 1;
+    const uint32_t count = static_cast<uint32_t>(std::max<size_t>(1, std::min<size_t>(bytes / kMinSegmentBytes, maxSegments)));
+    segments.resize(count);
+
+    const char* p = pBegin;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const char* end = pEnd;
+        if (i + 1 < count)
+        {
+            end = std::max(p, pBegin + bytes * (i + 1) / count);
+            const char* pNewline = static_cast<const char*>(memchr(end, '\n', pEnd - end));
+            end = pNewline ? pNewline + 1 : pEnd;
+        }
+        segments[i].pBegin = p;
+        segments[i].pEnd = end;
+        p = end;
+    }
+
+    if (m_pJobs)
+    {
+        m_pJobs->ParallelFor(0, count, 1, [&segments](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+                segments[i].Parse();
+        });
+    }
+    else
+    {
+        segments[0].Parse();
+    }
+    m_Stats.segments += count;
+}
+
+// ==== 按文件顺序合并各段，换算相对编号 ====
+bool ObjImporter::MergeSegments(std::vector<Segment>& segments, ObjMesh& mesh)
+{
+    for (Segment& segment : segments)
+    {
+        if (!segment.error.empty())
+            return Fail("第 " + std::to_string(m_LineCount + segment.lines + 1) + " 行的" + segment.error);
+
+        const int64_t positionBase = static_cast<int64_t>(mesh.vertices.size());
+        const int64_t normalBase = static_cast<int64_t>(m_Normals.size() / 3);
+
+        const size_t firstVertex = mesh.vertices.size();
+        mesh.vertices.resize(firstVertex + segment.positions.size() / 3);
+        for (size_t i = 0; i < segment.positions.size() / 3; ++i)
+        {
+            ObjVertex& vertex = mesh.vertices[firstVertex + i];
+            memcpy(vertex.pos, &segment.positions[i * 3], sizeof(vertex.pos));
+            memset(vertex.normal, 0, sizeof(vertex.normal));
+        }
+        m_Normals.insert(m_Normals.end(), segment.normals.begin(), segment.normals.end());
+
+        const size_t firstCorner = m_Corners.size();
+        m_Corners.resize(firstCorner + segment.corners.size());
+        for (size_t i = 0; i < segment.corners.size(); ++i)
+        {
+            const RawCorner& raw = segment.corners[i];
+            Corner& corner = m_Corners[firstCorner + i];
+            int64_t position = raw.position + ((raw.flags & kRelativePosition) ? positionBase : 0);
+            // 上界在三角化时检查（面可以引用后面的顶点）
+            if (position < 0 || position >= UINT32_MAX)
+                return Fail("面引用的顶点编号越界");
+            corner.position = static_cast<uint32_t>(position);
+            corner.normal = kNoNormal;
+            if (raw.flags & kHasNormal)
+            {
+                int64_t normal = raw.normal + ((raw.flags & kRelativeNormal) ? normalBase : 0);
+                corner.normal = normal >= 0 && normal < kBadNormal ? static_cast<uint32_t>(normal) : kBadNormal;
+            }
+        }
+        m_FaceSizes.insert(m_FaceSizes.end(), segment.faceSizes.begin(), segment.faceSizes.end());
+        m_LineCount += segment.lines;
+    }
+    return true;
+}
+
+// ==== 颜色、扇形三角化、法线累加（累加值暂存在 normal 中），按面的顺序串行 ====
+bool ObjImporter::BuildMesh(ObjMesh& mesh)
+{
+    if (mesh.vertices.empty() || m_FaceSizes.empty())
+        return Fail("没有顶点或面");
+    const size_t vertexCount = mesh.vertices.size();
+
+    // 颜色：按顶点顺序每个顶点取三次随机数
+    PythonRandom random(kColorSeed);
+    for (ObjVertex& vertex : mesh.vertices)
+    {
+        vertex.color[0] = static_cast<float>(RoundTo2(random.Random()));
+        vertex.color[1] = static_cast<float>(RoundTo2(random.Random()));
+        vertex.color[2] = static_cast<float>(RoundTo2(random.Random()));
+        vertex.color[3] = 1.0f;
+    }
+
+    size_t triangleCount = 0;
+    for (uint32_t faceSize : m_FaceSizes)
+        triangleCount += faceSize - 2;
+    mesh.indices.reserve(triangleCount * 3);
+
+    const bool hasNormals = !m_Normals.empty();
+    const size_t normalCount = m_Normals.size() / 3;
+    const Corner* pFace = m_Corners.data();
+    for (uint32_t faceSize : m_FaceSizes)
+    {
+        for (uint32_t i = 0; i < faceSize; ++i)
+        {
+            if (pFace[i].position >= vertexCount)
+                return Fail("面引用的顶点编号越界");
+        }
+        for (uint32_t i = 1; i + 1 < faceSize; ++i)
+        {
+            const Corner* tri[3] = { &pFace[0], &pFace[i], &pFace[i + 1] };
+            bool useGeometric = true;
+            bool allValid = true;
+            for (const Corner* pCorner : tri)
+            {
+                if (pCorner->normal != kNoNormal && hasNormals)
+                    useGeometric = false;
+                allValid = allValid && pCorner->normal < normalCount;
+            }
+
+            // 几何法线只在用到时计算
+            double faceNormal[3] = { 0.0, 0.0, 0.0 };
+            if (useGeometric || !allValid)
+            {
+                FaceNormal(mesh.vertices[tri[0]->position], mesh.vertices[tri[1]->position],
+                    mesh.vertices[tri[2]->position], faceNormal);
+            }
+            for (const Corner* pCorner : tri)
+            {
+                const double* pAdd = faceNormal;
+                if (!useGeometric && pCorner->normal < normalCount)
+                    pAdd = &m_Normals[static_cast<size_t>(pCorner->normal) * 3];
+                double* pAccum = mesh.vertices[pCorner->position].normal;
+                pAccum[0] += pAdd[0];
+                pAccum[1] += pAdd[1];
+                pAccum[2] += pAdd[2];
+            }
+
+            mesh.indices.push_back(tri[2]->position);
+            mesh.indices.push_back(tri[1]->position);
+            mesh.indices.push_back(tri[0]->position);
+        }
+        pFace += faceSize;
+    }
+
+    ObjVertex* pVertices = mesh.vertices.data();
+    auto normalize = [pVertices](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+            Normalize(pVertices[i].normal);
+    };
+    if (m_pJobs && vertexCount <= UINT32_MAX)
+        m_pJobs->ParallelFor(0, static_cast<uint32_t>(vertexCount), kNormalizeGrain, normalize);
+    else
+        normalize(0, static_cast<uint32_t>(vertexCount));
+    return true;
+}
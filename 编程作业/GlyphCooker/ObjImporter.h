@@ -0,0 +1,93 @@
+//***************************************************************************************
+// ObjImporter.h
+//
+// OBJ 导入，语义与 node/转化.py 相同：
+//   - 读取 v / vn / f（vt 只解析面中的编号），支持 v、v/vt、v//vn、v/vt/vn 四种面顶点写法；
+//   - 多边形按扇形三角化，每个三角形按 (v2, v1, v0) 的顺序输出位置编号；
+//   - 顶点法线为相邻三角形法线之和再归一化：三角形的顶点都没有 vn 时用几何法线，
+//     否则有 vn 的顶点累加 vn，没有的累加几何法线；长度为 0 的结果取 (0, 0, 1)；
+//   - 顶点颜色与脚本相同，用种子 12345 的 Python random 生成并保留两位小数，alpha 为 1。
+// 负编号按 OBJ 规范相对于当前已读到的元素计数（脚本对负编号的处理不正确）。
+// 位置和法线用 double 保存，数值解析结果与 Python 的 float() 相同，便于与脚本的文本输出逐位对照。
+//
+// ==== 大文件 ====
+// 文件按块读取，每块在换行处切成若干段，由 JobSystem 并行解析；解析当前块的同时读取下一块。
+// 各段的结果按文件顺序合并，相对编号在合并时换算。三角化和法线累加按面的顺序串行执行，
+// 浮点累加的顺序与脚本相同。
+//***************************************************************************************
+
+#ifndef OBJIMPORTER_H
+#define OBJIMPORTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+struct ObjVertex
+{
+    double pos[3];
+    double normal[3];
+    float color[4];
+};
+
+struct ObjMesh
+{
+    std::vector<ObjVertex> vertices;    // 与 OBJ 中 v 的顺序相同
+    std::vector<uint32_t> indices;      // 三角形列表
+};
+
+struct ObjImportStats
+{
+    uint64_t bytes = 0;
+    uint32_t chunks = 0;
+    uint32_t segments = 0;
+    double parseSeconds = 0.0;          // 读取、解析文本并合并各段
+    double buildSeconds = 0.0;          // 三角化、法线、颜色
+};
+
+class ObjImporter
+{
+public:
+    static const size_t kDefaultChunkBytes = 16 * 1024 * 1024;
+
+public:
+    // pJobs 为空时在调用线程上解析；chunkBytes 为每次读取的字节数
+    explicit ObjImporter(JobSystem* pJobs = nullptr, size_t chunkBytes = kDefaultChunkBytes);
+
+    // 失败（文件无法读取、数值或编号无法解析、编号越界、没有顶点或面）时返回 false，原因见 GetError
+    bool Import(const char* path, ObjMesh& mesh);
+
+    const std::string& GetError() const;
+    const ObjImportStats& GetStats() const;
+
+private:
+    // 面的一个顶点：位置编号，以及法线编号（kNoNormal 表示没有写 vn，kBadNormal 表示编号越界）
+    struct Corner
+    {
+        uint32_t position;
+        uint32_t normal;
+    };
+    struct Segment;
+
+    void ParseChunk(const char* pBegin, const char* pEnd, std::vector<Segment>& segments);
+    bool MergeSegments(std::vector<Segment>& segments, ObjMesh& mesh);
+    bool BuildMesh(ObjMesh& mesh);
+    bool Fail(const std::string& message);
+
+private:
+    JobSystem* m_pJobs;
+    size_t m_ChunkBytes;
+    std::string m_Error;
+    ObjImportStats m_Stats;
+
+    // 合并后的数据，Import 结束时释放
+    std::vector<double> m_Normals;      // vn，已归一化，每 3 个一组
+    std::vector<Corner> m_Corners;      // 所有面的顶点依次存放
+    std::vector<uint32_t> m_FaceSizes;  // 每个面的顶点数（至少 3）
+    uint64_t m_LineCount = 0;
+};
+
+#endif
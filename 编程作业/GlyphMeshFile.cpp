@@ -0,0 +1,140 @@
+#include "GlyphMeshFile.h"
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+GlyphMeshFile::GlyphMeshFile()
+{
+}
+
+bool GlyphMeshFile::Open(const char* path)
+{
+    Close();
+    if (!m_File.Open(path))
+        return false;
+    if (!Validate(m_File.GetData(), m_File.GetSize(), &m_pHeader))
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void GlyphMeshFile::Close()
+{
+    m_File.Close();
+    m_pHeader = nullptr;
+}
+
+bool GlyphMeshFile::IsOpen() const
+{
+    return m_pHeader != nullptr;
+}
+
+const GlyphMeshHeader& GlyphMeshFile::GetHeader() const
+{
+    assert(m_pHeader);
+    return *m_pHeader;
+}
+
+VertexFormat GlyphMeshFile::GetVertexFormat() const
+{
+    return static_cast<VertexFormat>(GetHeader().vertexFormat);
+}
+
+const uint8_t* GlyphMeshFile::GetVertices() const
+{
+    return m_File.GetData() + GetHeader().vertexOffset;
+}
+
+const uint16_t* GlyphMeshFile::GetIndices() const
+{
+    return reinterpret_cast<const uint16_t*>(m_File.GetData() + GetHeader().indexOffset);
+}
+
+// 流必须完整落在文件内，且起始偏移对齐（映射的起始地址按页对齐，对齐的偏移也就是对齐的地址）
+static bool IsStreamValid(uint64_t offset, uint64_t bytes, size_t fileSize)
+{
+    return offset >= sizeof(GlyphMeshHeader) && offset % kGlyphMeshStreamAlignment == 0
+        && offset <= fileSize && bytes <= fileSize - offset;
+}
+
+bool GlyphMeshFile::Validate(const uint8_t* pData, size_t size, const GlyphMeshHeader** ppHeader)
+{
+    assert(ppHeader);
+    *ppHeader = nullptr;
+    if (!pData || size < sizeof(GlyphMeshHeader))
+        return false;
+
+    const GlyphMeshHeader* pHeader = reinterpret_cast<const GlyphMeshHeader*>(pData);
+    if (pHeader->magic != kGlyphMeshMagic || pHeader->version != kGlyphMeshVersion)
+        return false;
+    if (pHeader->vertexFormat >= static_cast<uint32_t>(VertexFormat::Count)
+        || pHeader->vertexStride != GetVertexStride(static_cast<VertexFormat>(pHeader->vertexFormat)))
+        return false;
+    // 16 位索引最多引用 65536 个顶点
+    if (pHeader->vertexCount == 0 || pHeader->vertexCount > UINT16_MAX + 1u
+        || pHeader->indexCount == 0 || pHeader->indexCount % 3 != 0)
+        return false;
+    if (pHeader->vertexBytes != static_cast<uint64_t>(pHeader->vertexCount) * pHeader->vertexStride
+        || pHeader->indexBytes != static_cast<uint64_t>(pHeader->indexCount) * sizeof(uint16_t))
+        return false;
+    if (!IsStreamValid(pHeader->vertexOffset, pHeader->vertexBytes, size)
+        || !IsStreamValid(pHeader->indexOffset, pHeader->indexBytes, size))
+        return false;
+
+    *ppHeader = pHeader;
+    return true;
+}
+
+// ==== 写入：文件头、对齐填充、顶点流、对齐填充、索引流，一次写出 ====
+bool GlyphMeshFile::Write(const char* path, const GlyphMeshDesc& desc)
+{
+    assert(desc.pVertices && desc.pIndices);
+    GlyphMeshHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kGlyphMeshMagic;
+    header.version = kGlyphMeshVersion;
+    header.vertexFormat = static_cast<uint32_t>(desc.format);
+    header.vertexStride = GetVertexStride(desc.format);
+    header.vertexCount = desc.vertexCount;
+    header.indexCount = desc.indexCount;
+    header.sourceVertexCount = desc.sourceVertexCount;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        header.aabbMin[axis] = desc.aabbMin[axis];
+        header.aabbMax[axis] = desc.aabbMax[axis];
+    }
+    if (desc.format == VertexFormat::Packed)
+    {
+        header.decode = desc.decode;
+        for (int i = 0; i < 3; ++i)
+            header.packError[i] = desc.packError[i];
+    }
+    header.acmrBefore = desc.acmrBefore;
+    header.acmrAfter = desc.acmrAfter;
+    header.atvrBefore = desc.atvrBefore;
+    header.atvrAfter = desc.atvrAfter;
+    header.vertexOffset = GlyphMeshAlign(sizeof(GlyphMeshHeader));
+    header.vertexBytes = static_cast<uint64_t>(desc.vertexCount) * header.vertexStride;
+    header.indexOffset = GlyphMeshAlign(header.vertexOffset + header.vertexBytes);
+    header.indexBytes = static_cast<uint64_t>(desc.indexCount) * sizeof(uint16_t);
+
+    // 字形网格只有几十 KB，拼成一块后写出；填充部分为 0
+    std::vector<uint8_t> data(static_cast<size_t>(header.indexOffset + header.indexBytes), 0);
+    memcpy(data.data(), &header, sizeof(header));
+    memcpy(data.data() + header.vertexOffset, desc.pVertices, static_cast<size_t>(header.vertexBytes));
+    memcpy(data.data() + header.indexOffset, desc.pIndices, static_cast<size_t>(header.indexBytes));
+
+    const GlyphMeshHeader* pCheck = nullptr;
+    if (!Validate(data.data(), data.size(), &pCheck))
+        return false;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    file.close();
+    return !file.fail();
+}
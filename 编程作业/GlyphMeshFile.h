@@ -0,0 +1,61 @@
+//***************************************************************************************
+// GlyphMeshFile.h
+//
+// 字形网格文件（格式见 GlyphMeshFormat.h）的读写。
+// 读取时把整个文件内存映射，只检查文件头和两个流的范围，顶点和索引直接返回映射中的指针，
+// 可以原样交给几何池或缓冲创建；索引的取值不逐个检查（越界读取在 D3D11 中返回 0，不会崩溃）。
+//***************************************************************************************
+
+#ifndef GLYPHMESHFILE_H
+#define GLYPHMESHFILE_H
+
+#include "GlyphMeshFormat.h"
+#include "MappedFile.h"
+
+// 写入时的网格描述，顶点按 format 的布局存放
+struct GlyphMeshDesc
+{
+    VertexFormat format = VertexFormat::Float;
+    const void* pVertices = nullptr;
+    uint32_t vertexCount = 0;
+    const uint16_t* pIndices = nullptr;
+    uint32_t indexCount = 0;
+    PositionDecode decode = {};     // 以下两项只在 Packed 时写入
+    float packError[3] = {};        // 位置、法线夹角（弧度）、颜色分量
+    float aabbMin[3] = {};
+    float aabbMax[3] = {};
+    uint32_t sourceVertexCount = 0;
+    float acmrBefore = 0.0f;
+    float acmrAfter = 0.0f;
+    float atvrBefore = 0.0f;
+    float atvrAfter = 0.0f;
+};
+
+class GlyphMeshFile
+{
+public:
+    GlyphMeshFile();
+
+    GlyphMeshFile(const GlyphMeshFile&) = delete;
+    GlyphMeshFile& operator=(const GlyphMeshFile&) = delete;
+
+    // 文件不存在、版本不符或范围不合法时返回 false
+    bool Open(const char* path);
+    void Close();
+
+    bool IsOpen() const;
+    const GlyphMeshHeader& GetHeader() const;
+    VertexFormat GetVertexFormat() const;
+    const uint8_t* GetVertices() const;
+    const uint16_t* GetIndices() const;
+
+    // 检查内存中的文件数据，合法时 *ppHeader 指向 pData 开头
+    static bool Validate(const uint8_t* pData, size_t size, const GlyphMeshHeader** ppHeader);
+    static bool Write(const char* path, const GlyphMeshDesc& desc);
+
+private:
+    MappedFile m_File;
+    const GlyphMeshHeader* m_pHeader = nullptr;
+};
+
+#endif
@@ -0,0 +1,53 @@
+//***************************************************************************************
+// GlyphMeshFormat.h
+//
+// 离线烘焙的字形网格文件格式（由 GlyphCooker 从 OBJ 生成）。
+// 文件由一个 GlyphMeshHeader 加上顶点流和索引流组成，两个流的起始偏移都按
+// kGlyphMeshStreamAlignment 对齐，内容与 GPU 缓冲中的布局完全相同（顶点为 VertexFormat
+// 指定的格式，索引为 16 位三角形列表），加载时直接在内存映射的数据上使用，不需要解析。
+// 顶点已经过焊接和索引重排，位置已按烘焙时的缩放系数缩放（默认与 NameVertices 相同的 0.1）。
+// 所有字段均为小端序。
+//***************************************************************************************
+
+#ifndef GLYPHMESHFORMAT_H
+#define GLYPHMESHFORMAT_H
+
+#include "VertexLayout.h"
+#include <cstdint>
+
+static const uint32_t kGlyphMeshMagic = 0x48534D47;        // "GMSH"
+static const uint32_t kGlyphMeshVersion = 1;
+static const uint32_t kGlyphMeshStreamAlignment = 64;      // 流起始偏移按缓存行对齐
+
+struct GlyphMeshHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexFormat;      // VertexFormat
+    uint32_t vertexStride;      // 与 GetVertexStride(vertexFormat) 相同
+    uint32_t vertexCount;
+    uint32_t indexCount;        // 16 位索引，3 的倍数
+    uint32_t sourceVertexCount; // 焊接前（按三角形展开）的顶点数
+    uint32_t pad;
+    float aabbMin[4];           // 模型空间包围盒（w 不用）
+    float aabbMax[4];
+    PositionDecode decode;      // Packed 时的位置反量化参数，Float 时全为 0
+    float packError[4];         // Packed 时压缩引入的最大误差：位置、法线夹角（弧度）、颜色分量（w 不用）
+    float acmrBefore;           // 索引重排前后的 ACMR / ATVR
+    float acmrAfter;
+    float atvrBefore;
+    float atvrAfter;
+    uint64_t vertexOffset;      // 顶点流相对文件开头的偏移
+    uint64_t vertexBytes;
+    uint64_t indexOffset;       // 索引流相对文件开头的偏移
+    uint64_t indexBytes;
+};
+
+static_assert(sizeof(GlyphMeshHeader) == 160, "GlyphMeshHeader 布局变化需要修改版本号");
+
+inline uint64_t GlyphMeshAlign(uint64_t offset)
+{
+    return (offset + kGlyphMeshStreamAlignment - 1) & ~static_cast<uint64_t>(kGlyphMeshStreamAlignment - 1);
+}
+
+#endif
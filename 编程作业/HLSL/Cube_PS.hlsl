@@ -23,17 +23,23 @@ struct Material
     float3 specular; float shininess;
 };
 
-cbuffer ConstantBuffer : register(b0)
+// 每帧更新一次：相机与光源
+cbuffer CBPerFrame : register(b0)
 {
-    float4x4 world;
     float4x4 view;
     float4x4 proj;
     Light    lights[3];
-    Material material;
     float3   eyePos;
     float    padEye;
 };
 
+// 每个绘制对象更新：对象世界矩阵与材质表
+cbuffer CBPerObject : register(b1)
+{
+    float4x4 world;         // 对象世界矩阵，与实例矩阵相乘
+    Material materials[4];  // 材质表，按实例的材质索引选择
+};
+
 // 与顶点着色器对应的插值输出
 struct VertexOut
 {
@@ -41,10 +47,11 @@ struct VertexOut
     float3 posW    : TEXCOORD0;
     float3 normalW : TEXCOORD1;
     float4 color   : COLOR0;
+    nointerpolation uint matIndex : TEXCOORD2;
 };
 
 // 计算方向光贡献
-float3 CalcDirLight(int idx, float3 normal, float3 viewDir)
+float3 CalcDirLight(int idx, Material material, float3 normal, float3 viewDir)
 {
     float3 L = normalize(-lights[idx].direction);
     float NdotL = saturate(dot(normal, L));
@@ -84,7 +91,7 @@ float3 CalcDirLight(int idx, float3 normal, float3 viewDir)
 //}
 // ==== 许双博第四次作业修改（加强版） ====
 // 点光源：更强中心亮度 + 快速衰减，模拟萤火虫式照明
-float3 CalcPointLight(int idx, float3 pos, float3 normal, float3 viewDir)
+float3 CalcPointLight(int idx, Material material, float3 pos, float3 normal, float3 viewDir)
 {
     float3 toLight = lights[idx].position - pos;
     float dist = length(toLight);
@@ -116,7 +123,7 @@ float3 CalcPointLight(int idx, float3 pos, float3 normal, float3 viewDir)
 }
 
 // 计算聚光灯贡献
-float3 CalcSpotLight(int idx, float3 pos, float3 normal, float3 viewDir)
+float3 CalcSpotLight(int idx, Material material, float3 pos, float3 normal, float3 viewDir)
 {
     float3 lightVec = pos - lights[idx].position;        // 光源指向像素
     float dist = length(lightVec);
@@ -150,6 +157,8 @@ float4 PS(VertexOut pin) : SV_TARGET
     float3 normal = normalize(pin.normalW);
     float3 viewDir = normalize(eyePos - pin.posW);
     float3 colorSum = float3(0.0, 0.0, 0.0);
+    // 实例的材质
+    Material material = materials[pin.matIndex];
     // 累加三个光源的贡献
     [unroll]
     for (int i = 0; i < 3; ++i)
@@ -158,15 +167,15 @@ float4 PS(VertexOut pin) : SV_TARGET
             continue;
         if (lights[i].type == 0)
         {
-            colorSum += CalcDirLight(i, normal, viewDir);
+            colorSum += CalcDirLight(i, material, normal, viewDir);
         }
         else if (lights[i].type == 1)
         {
-            colorSum += CalcPointLight(i, pin.posW, normal, viewDir);
+            colorSum += CalcPointLight(i, material, pin.posW, normal, viewDir);
         }
         else if (lights[i].type == 2)
         {
-            colorSum += CalcSpotLight(i, pin.posW, normal, viewDir);
+            colorSum += CalcSpotLight(i, material, pin.posW, normal, viewDir);
         }
     }
     // 将顶点颜色作为基色调制
@@ -23,23 +23,34 @@ struct Material
     float3 specular; float shininess; // 镜面反射系数与高光指数
 };
 
-cbuffer ConstantBuffer : register(b0)
+// 每帧更新一次：相机与光源
+cbuffer CBPerFrame : register(b0)
 {
-    float4x4 world;
     float4x4 view;
     float4x4 proj;
     Light    lights[3];
-    Material material;
     float3   eyePos;
     float    padEye;
 };
 
-// 顶点输入：位置、法线、颜色
+// 每个绘制对象更新：对象世界矩阵与材质表
+cbuffer CBPerObject : register(b1)
+{
+    float4x4 world;         // 对象世界矩阵，与实例矩阵相乘
+    Material materials[4];  // 材质表，按实例的材质索引选择
+};
+
+// 顶点输入：位置、法线、颜色（槽0），世界矩阵、材质索引（槽1，逐实例）
 struct VertexIn
 {
     float3 posL    : POSITION;
     float3 normalL : NORMAL;
     float4 color   : COLOR;
+    float4 world0  : WORLD0;
+    float4 world1  : WORLD1;
+    float4 world2  : WORLD2;
+    float4 world3  : WORLD3;
+    uint   matIndex : MATERIAL;
 };
 
 // 顶点输出：裁剪空间位置、世界空间位置、世界空间法线、颜色
@@ -49,20 +60,25 @@ struct VertexOut
     float3 posW    : TEXCOORD0;   // 世界空间位置
     float3 normalW : TEXCOORD1;   // 世界空间法线
     float4 color   : COLOR0;      // 颜色
+    nointerpolation uint matIndex : TEXCOORD2; // 材质索引
 };
 
 VertexOut VS(VertexIn vin)
 {
     VertexOut vout;
+    // 实例矩阵按行传入，先应用实例矩阵再应用对象世界矩阵
+    float4x4 instWorld = float4x4(vin.world0, vin.world1, vin.world2, vin.world3);
+    float4x4 worldFinal = mul(instWorld, world);
     // 变换到世界空间
-    float4 posW4 = mul(float4(vin.posL, 1.0f), world);
+    float4 posW4 = mul(float4(vin.posL, 1.0f), worldFinal);
     vout.posW = posW4.xyz;
     // 变换到裁剪空间
     float4 posV = mul(posW4, view);
     vout.posH = mul(posV, proj);
     // 法线只参与旋转缩放，不受平移影响
-    vout.normalW = mul(vin.normalL, (float3x3)world);
+    vout.normalW = mul(vin.normalL, (float3x3)worldFinal);
     // 保留顶点颜色
     vout.color = vin.color;
+    vout.matIndex = vin.matIndex;
     return vout;
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Vertex shader for the packed vertex format
+//
+// ==== 压缩顶点格式 ====
+// 与 Cube_VS.hlsl 相同的光照输入输出，只是顶点流为 16 字节的 PackedVertex（见 VertexFormat.h）：
+// 位置为相对网格包围盒的 UNORM16，由 CBMeshDecode 还原；法线为八面体编码的 SNORM16；颜色为 UNORM8。
+
+struct Light
+{
+    float3 position;   float range;      // 位置和作用范围（点光/聚光）
+    float3 direction;  float spot;       // 方向和聚光角度（弧度）
+    float3 ambient;    float pad0;       // 环境光颜色和填充
+    float3 diffuse;    float pad1;       // 漫反射颜色和填充
+    float3 specular;   float pad2;       // 镜面反射颜色和填充
+    int    type;       // 0=方向光 1=点光源 2=聚光灯
+    int    enabled;    // 是否启用
+    int2   pad3;       // 对齐填充
+};
+
+struct Material
+{
+    float3 ambient;  float pad0;      // 环境反射系数
+    float3 diffuse;  float pad1;      // 漫反射系数
+    float3 specular; float shininess; // 镜面反射系数与高光指数
+};
+
+// 每帧更新一次：相机与光源
+cbuffer CBPerFrame : register(b0)
+{
+    float4x4 view;
+    float4x4 proj;
+    Light    lights[3];
+    float3   eyePos;
+    float    padEye;
+};
+
+// 每个绘制对象更新：对象世界矩阵与材质表
+cbuffer CBPerObject : register(b1)
+{
+    float4x4 world;         // 对象世界矩阵，与实例矩阵相乘
+    Material materials[4];  // 材质表，按实例的材质索引选择
+};
+
+// 每个网格一份：位置反量化参数
+cbuffer CBMeshDecode : register(b2)
+{
+    float4 posScale;        // 包围盒尺寸
+    float4 posOffset;       // 包围盒最小点
+};
+
+// 顶点输入：量化位置、八面体法线、颜色（槽0），世界矩阵、材质索引（槽1，逐实例）
+struct VertexIn
+{
+    float4 posQ     : POSITION;     // [0, 1]，w 不用
+    float2 normalQ  : NORMAL;       // [-1, 1]
+    float4 color    : COLOR;
+    float4 world0   : WORLD0;
+    float4 world1   : WORLD1;
+    float4 world2   : WORLD2;
+    float4 world3   : WORLD3;
+    uint   matIndex : MATERIAL;
+};
+
+// 顶点输出：与 Cube_VS.hlsl 相同，像素着色器共用
+struct VertexOut
+{
+    float4 posH    : SV_POSITION; // 裁剪空间位置
+    float3 posW    : TEXCOORD0;   // 世界空间位置
+    float3 normalW : TEXCOORD1;   // 世界空间法线
+    float4 color   : COLOR0;      // 颜色
+    nointerpolation uint matIndex : TEXCOORD2; // 材质索引
+};
+
+// 八面体解码：上半部分直接取 z = 1 - |x| - |y|，下半部分沿对角线展开
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += n.xy >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
+VertexOut VS(VertexIn vin)
+{
+    VertexOut vout;
+    float3 posL = vin.posQ.xyz * posScale.xyz + posOffset.xyz;
+    float3 normalL = DecodeOctahedral(vin.normalQ);
+
+    // 实例矩阵按行传入，先应用实例矩阵再应用对象世界矩阵
+    float4x4 instWorld = float4x4(vin.world0, vin.world1, vin.world2, vin.world3);
+    float4x4 worldFinal = mul(instWorld, world);
+    // 变换到世界空间
+    float4 posW4 = mul(float4(posL, 1.0f), worldFinal);
+    vout.posW = posW4.xyz;
+    // 变换到裁剪空间
+    float4 posV = mul(posW4, view);
+    vout.posH = mul(posV, proj);
+    // 法线只参与旋转缩放，不受平移影响
+    vout.normalW = mul(normalL, (float3x3)worldFinal);
+    vout.color = vin.color;
+    vout.matIndex = vin.matIndex;
+    return vout;
+}
@@ -0,0 +1,96 @@
+#include "InputState.h"
+
+void InputState::BeginTick()
+{
+    m_Pressed.reset();
+    m_Released.reset();
+    m_MouseDeltaX = 0.0f;
+    m_MouseDeltaY = 0.0f;
+}
+
+void InputState::Apply(const InputEvent& event)
+{
+    switch (event.type)
+    {
+    case InputEvent::KeyDown:
+        // 按住不放时系统会重复发送 KeyDown，只有第一次算按下沿
+        if (!m_Down[event.key])
+        {
+            m_Down.set(event.key);
+            m_Pressed.set(event.key);
+        }
+        break;
+    case InputEvent::KeyUp:
+        if (m_Down[event.key])
+        {
+            m_Down.reset(event.key);
+            m_Released.set(event.key);
+        }
+        break;
+    case InputEvent::MouseMove:
+        if (m_FirstMouseEvent)
+        {
+            m_FirstMouseEvent = false;
+        }
+        else
+        {
+            m_MouseDeltaX += float(event.x - m_LastMouseX);
+            m_MouseDeltaY += float(event.y - m_LastMouseY);
+        }
+        m_LastMouseX = event.x;
+        m_LastMouseY = event.y;
+        break;
+    case InputEvent::FocusGained:
+        ResetMouse();
+        break;
+    case InputEvent::FocusLost:
+        m_Released |= m_Down;
+        m_Down.reset();
+        break;
+    }
+}
+
+uint32_t InputState::Drain(InputQueue& queue, uint64_t tick)
+{
+    uint32_t count = 0;
+    InputEvent event;
+    while (queue.Peek(event) && event.tick <= tick)
+    {
+        queue.Pop(event);
+        Apply(event);
+        ++count;
+    }
+    return count;
+}
+
+bool InputState::IsDown(uint8_t key) const
+{
+    return m_Down[key];
+}
+
+bool InputState::WasPressed(uint8_t key) const
+{
+    return m_Pressed[key];
+}
+
+bool InputState::WasReleased(uint8_t key) const
+{
+    return m_Released[key];
+}
+
+float InputState::GetMouseDeltaX() const
+{
+    return m_MouseDeltaX;
+}
+
+float InputState::GetMouseDeltaY() const
+{
+    return m_MouseDeltaY;
+}
+
+void InputState::ResetMouse()
+{
+    m_FirstMouseEvent = true;
+    m_MouseDeltaX = 0.0f;
+    m_MouseDeltaY = 0.0f;
+}
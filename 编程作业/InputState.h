@@ -0,0 +1,86 @@
+//***************************************************************************************
+// InputState.h
+//
+// 输入事件与按键状态：消息线程把按键和鼠标事件压入 SpscRing，仿真线程每步开始时
+// 一次取完并更新按键位图。除当前是否按下外还记录本步内的按下/松开沿，
+// 同一步内按下又松开的短按也不会丢失。鼠标事件带绝对位置，增量在这里计算。
+// 事件带有所属的仿真步号（SimulationThread::GetInputTick），仿真线程一次补多步时
+// 每个事件仍在它所属的那一步生效。
+// 虚拟键码使用 0..255，与 Windows 的 VK_* 相同。
+//***************************************************************************************
+
+#ifndef INPUTSTATE_H
+#define INPUTSTATE_H
+
+#include "SpscRing.h"
+#include <bitset>
+#include <cstdint>
+
+struct InputEvent
+{
+    enum Type : uint8_t
+    {
+        KeyDown,
+        KeyUp,
+        MouseMove,      // x, y 为窗口客户区坐标
+        FocusGained,    // 重新获得焦点：下一次鼠标移动只记录位置
+        FocusLost       // 失去焦点：松开所有按键，避免收不到 KeyUp 而卡住
+    };
+
+    Type     type;
+    uint8_t  key;
+    int32_t  x;
+    int32_t  y;
+    uint64_t tick;      // 所属的仿真步，0 表示下一次 Drain 时立即处理
+};
+
+// 仿真中用到的虚拟键码，取值与 Windows 的 VK_* 相同，不依赖 Windows.h
+static const uint8_t kKeyShift = 0x10;
+static const uint8_t kKeyControl = 0x11;
+static const uint8_t kKeySpace = 0x20;
+static const uint8_t kKeyF9 = 0x78;
+static const uint8_t kKeyOemPlus = 0xBB;
+static const uint8_t kKeyOemComma = 0xBC;
+static const uint8_t kKeyOemMinus = 0xBD;
+static const uint8_t kKeyOemPeriod = 0xBE;
+static const uint8_t kKeyOem4 = 0xDB;      // [
+static const uint8_t kKeyOem6 = 0xDD;      // ]
+
+typedef SpscRing<InputEvent, 1024> InputQueue;
+
+class InputState
+{
+public:
+    static const int kKeyCount = 256;
+
+public:
+    // 每步开始时调用：清除上一步的按下/松开沿和鼠标增量
+    void BeginTick();
+    void Apply(const InputEvent& event);
+    // 取出队列中所属步号不大于 tick 的事件（按顺序，遇到更晚的事件即停止），返回处理的个数
+    // 默认取完整个队列
+    uint32_t Drain(InputQueue& queue, uint64_t tick = UINT64_MAX);
+
+    bool IsDown(uint8_t key) const;
+    bool WasPressed(uint8_t key) const;     // 本步内从松开变为按下
+    bool WasReleased(uint8_t key) const;    // 本步内从按下变为松开
+
+    // 本步累积的鼠标移动量（像素）
+    float GetMouseDeltaX() const;
+    float GetMouseDeltaY() const;
+    // 丢弃累积的增量，下一次鼠标移动只记录位置（切换视角时调用）
+    void ResetMouse();
+
+private:
+    std::bitset<kKeyCount> m_Down;
+    std::bitset<kKeyCount> m_Pressed;
+    std::bitset<kKeyCount> m_Released;
+
+    int32_t m_LastMouseX = 0;
+    int32_t m_LastMouseY = 0;
+    bool    m_FirstMouseEvent = true;
+    float   m_MouseDeltaX = 0.0f;
+    float   m_MouseDeltaY = 0.0f;
+};
+
+#endif
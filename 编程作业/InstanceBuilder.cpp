@@ -0,0 +1,97 @@
+#include "InstanceBuilder.h"
+#include <cassert>
+#include <cstring>
+
+InstanceBuilder::InstanceBuilder(int meshCount)
+{
+    Reset(meshCount);
+}
+
+void InstanceBuilder::Reset(int meshCount)
+{
+    assert(meshCount >= 0);
+    if ((int)m_Buckets.size() != meshCount)
+        m_Buckets.resize(meshCount);
+    // clear 不释放容量，下一帧可以直接复用
+    for (auto& bucket : m_Buckets)
+        bucket.clear();
+    m_Batches.clear();
+    m_Stats = Stats();
+}
+
+InstanceData& InstanceBuilder::Add(int meshId)
+{
+    assert(meshId >= 0 && meshId < (int)m_Buckets.size());
+    m_Buckets[meshId].emplace_back();
+    return m_Buckets[meshId].back();
+}
+
+void InstanceBuilder::Add(int meshId, const float world[16], uint32_t materialIndex)
+{
+    InstanceData& inst = Add(meshId);
+    memcpy(inst.world, world, sizeof(inst.world));
+    inst.materialIndex = materialIndex;
+}
+
+void InstanceBuilder::Append(const InstanceBuilder& other)
+{
+    assert(other.m_Buckets.size() == m_Buckets.size());
+    for (size_t id = 0; id < m_Buckets.size(); ++id)
+        m_Buckets[id].insert(m_Buckets[id].end(), other.m_Buckets[id].begin(), other.m_Buckets[id].end());
+}
+
+void InstanceBuilder::Build(uint32_t maxInstancesPerDraw)
+{
+    assert(maxInstancesPerDraw > 0);
+    m_Batches.clear();
+    m_Stats.instanceCount = 0;
+
+    for (size_t id = 0; id < m_Buckets.size(); ++id)
+    {
+        uint32_t count = static_cast<uint32_t>(m_Buckets[id].size());
+        m_Stats.instanceCount += count;
+        // 超出实例缓冲容量的部分拆成多次绘制
+        for (uint32_t first = 0; first < count; first += maxInstancesPerDraw)
+        {
+            Batch batch;
+            batch.meshId = static_cast<uint32_t>(id);
+            batch.firstInstance = first;
+            batch.instanceCount = (count - first < maxInstancesPerDraw) ? count - first : maxInstancesPerDraw;
+            m_Batches.push_back(batch);
+        }
+    }
+
+    // 逐物体绘制时每个实例对应一次 Map/Unmap + DrawIndexed
+    m_Stats.legacyDrawCalls = m_Stats.instanceCount;
+    m_Stats.drawCalls = static_cast<uint32_t>(m_Batches.size());
+}
+
+int InstanceBuilder::GetMeshCount() const
+{
+    return static_cast<int>(m_Buckets.size());
+}
+
+const InstanceData* InstanceBuilder::GetInstances(int meshId) const
+{
+    return m_Buckets[meshId].data();
+}
+
+InstanceData* InstanceBuilder::GetInstances(int meshId)
+{
+    return m_Buckets[meshId].data();
+}
+
+uint32_t InstanceBuilder::GetInstanceCount(int meshId) const
+{
+    return static_cast<uint32_t>(m_Buckets[meshId].size());
+}
+
+const std::vector<InstanceBuilder::Batch>& InstanceBuilder::GetBatches() const
+{
+    return m_Batches;
+}
+
+const InstanceBuilder::Stats& InstanceBuilder::GetStats() const
+{
+    return m_Stats;
+}
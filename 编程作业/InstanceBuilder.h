@@ -0,0 +1,65 @@
+//***************************************************************************************
+// InstanceBuilder.h
+//
+// 实例数组构建器：把每帧要绘制的主字/子字按网格 id 分桶，
+// 每个网格生成一条连续的实例流（世界矩阵 + 材质索引），供 DrawIndexedInstanced 使用。
+//***************************************************************************************
+
+#ifndef INSTANCEBUILDER_H
+#define INSTANCEBUILDER_H
+
+#include <cstdint>
+#include <vector>
+
+// 单个实例的数据（与着色器中的实例输入布局一一对应）
+struct InstanceData
+{
+    float    world[4][4];       // 世界矩阵（行向量约定，未转置）
+    uint32_t materialIndex;     // 材质表中的索引
+};
+
+class InstanceBuilder
+{
+public:
+    // 一次实例化绘制：某个网格的一段连续实例
+    struct Batch
+    {
+        uint32_t meshId;
+        uint32_t firstInstance;     // 在该网格实例流中的起始位置
+        uint32_t instanceCount;
+    };
+
+    // 每帧统计：用于比较逐物体绘制与实例化绘制的调用次数
+    struct Stats
+    {
+        uint32_t instanceCount = 0;     // 本帧实例总数
+        uint32_t legacyDrawCalls = 0;   // 逐物体绘制需要的 DrawIndexed 次数
+        uint32_t drawCalls = 0;         // 实例化后的 DrawIndexedInstanced 次数
+    };
+
+public:
+    explicit InstanceBuilder(int meshCount = 0);
+
+    void Reset(int meshCount);                          // 每帧开始时调用，保留已分配的容量
+    InstanceData& Add(int meshId);                      // 追加一个实例并返回其引用，由调用方填写
+    void Add(int meshId, const float world[16], uint32_t materialIndex);
+    // 把另一个 builder 的实例按网格追加到末尾（用于合并各线程分别生成的实例）
+    void Append(const InstanceBuilder& other);
+
+    // 按单次绘制可容纳的最大实例数把各网格的实例流切分成批次
+    void Build(uint32_t maxInstancesPerDraw);
+
+    int GetMeshCount() const;
+    const InstanceData* GetInstances(int meshId) const;
+    InstanceData* GetInstances(int meshId);             // 先 Add 占位、稍后再批量填写时使用
+    uint32_t GetInstanceCount(int meshId) const;
+    const std::vector<Batch>& GetBatches() const;
+    const Stats& GetStats() const;
+
+private:
+    std::vector<std::vector<InstanceData>> m_Buckets;   // 每个网格一条实例流
+    std::vector<Batch> m_Batches;
+    Stats m_Stats;
+};
+
+#endif
@@ -0,0 +1,198 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+
+// 当前线程所属的任务系统和队列编号（外部线程为 nullptr / -1）
+static thread_local const JobSystem* t_pOwner = nullptr;
+static thread_local int t_WorkerIndex = -1;
+
+JobSystem::JobSystem(unsigned workerCount)
+{
+    if (workerCount == 0)
+    {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    for (unsigned i = 0; i < workerCount + 1; ++i)
+        m_Queues.emplace_back(new WorkQueue());
+
+    for (unsigned i = 0; i < workerCount; ++i)
+        m_Workers.emplace_back(&JobSystem::WorkerMain, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Quit = true;
+    }
+    m_WakeCondition.notify_all();
+    for (std::thread& worker : m_Workers)
+        worker.join();
+}
+
+JobSystem::JobHandle JobSystem::Schedule(std::function<void()> fn, const JobHandle* pDependencies, uint32_t dependencyCount)
+{
+    JobHandle job = std::make_shared<Job>();
+    job->fn = std::move(fn);
+
+    // 先多占一个计数，避免依赖在登记过程中完成时提前入队
+    job->pendingDependencies = 1;
+    for (uint32_t i = 0; i < dependencyCount; ++i)
+    {
+        const JobHandle& dependency = pDependencies[i];
+        if (!dependency)
+            continue;
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+        if (!dependency->done)
+        {
+            dependency->continuations.push_back(job);
+            ++job->pendingDependencies;
+        }
+    }
+
+    if (--job->pendingDependencies == 0)
+        Enqueue(job);
+    return job;
+}
+
+void JobSystem::Wait(const JobHandle& job)
+{
+    if (!job)
+        return;
+    const unsigned queueIndex = CurrentQueueIndex();
+    while (!job->done)
+    {
+        if (!TryRunOne(queueIndex))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(uint32_t begin, uint32_t end, uint32_t grain,
+    const std::function<void(uint32_t, uint32_t)>& body)
+{
+    if (begin >= end)
+        return;
+    grain = std::max(1u, grain);
+
+    // 只有一块或没有工作线程时直接在当前线程执行
+    if (end - begin <= grain || m_Workers.empty())
+    {
+        for (uint32_t blockBegin = begin; blockBegin < end; blockBegin += grain)
+            body(blockBegin, std::min(end, blockBegin + grain));
+        return;
+    }
+
+    std::vector<JobHandle> blocks;
+    blocks.reserve((end - begin + grain - 1) / grain);
+    for (uint32_t blockBegin = begin; blockBegin < end; blockBegin += grain)
+    {
+        uint32_t blockEnd = std::min(end, blockBegin + grain);
+        blocks.push_back(Schedule([&body, blockBegin, blockEnd]() { body(blockBegin, blockEnd); }));
+    }
+    for (const JobHandle& block : blocks)
+        Wait(block);
+}
+
+unsigned JobSystem::GetWorkerCount() const
+{
+    return static_cast<unsigned>(m_Workers.size());
+}
+
+void JobSystem::WorkerMain(unsigned index)
+{
+    t_pOwner = this;
+    t_WorkerIndex = static_cast<int>(index);
+
+    while (!m_Quit)
+    {
+        if (TryRunOne(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_WakeCondition.wait(lock, [this]() { return m_Quit || m_QueuedJobs > 0; });
+    }
+}
+
+void JobSystem::Enqueue(const JobHandle& job)
+{
+    WorkQueue& queue = *m_Queues[CurrentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    {
+        // 在锁内修改计数，保证等待中的线程不会错过唤醒
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        ++m_QueuedJobs;
+    }
+    m_WakeCondition.notify_one();
+}
+
+bool JobSystem::TryRunOne(unsigned queueIndex)
+{
+    JobHandle job = Pop(queueIndex);
+    if (!job)
+        job = Steal(queueIndex);
+    if (!job)
+        return false;
+
+    --m_QueuedJobs;
+    Execute(job);
+    return true;
+}
+
+JobSystem::JobHandle JobSystem::Pop(unsigned queueIndex)
+{
+    // 自己的队列从尾部取：刚提交的任务数据还在缓存里
+    WorkQueue& queue = *m_Queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return nullptr;
+    JobHandle job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return job;
+}
+
+JobSystem::JobHandle JobSystem::Steal(unsigned thiefIndex)
+{
+    // 从其他队列头部窃取：最早提交的任务通常是最大的一块
+    const unsigned queueCount = static_cast<unsigned>(m_Queues.size());
+    for (unsigned k = 1; k < queueCount; ++k)
+    {
+        WorkQueue& queue = *m_Queues[(thiefIndex + k) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+        JobHandle job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return job;
+    }
+    return nullptr;
+}
+
+void JobSystem::Execute(const JobHandle& job)
+{
+    job->fn();
+    job->fn = nullptr;      // 尽早释放捕获的对象
+
+    std::vector<JobHandle> continuations;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done = true;
+        continuations.swap(job->continuations);
+    }
+    for (const JobHandle& continuation : continuations)
+    {
+        if (--continuation->pendingDependencies == 0)
+            Enqueue(continuation);
+    }
+}
+
+unsigned JobSystem::CurrentQueueIndex() const
+{
+    if (t_pOwner == this && t_WorkerIndex >= 0)
+        return static_cast<unsigned>(t_WorkerIndex);
+    return static_cast<unsigned>(m_Workers.size());
+}
@@ -0,0 +1,85 @@
+//***************************************************************************************
+// JobSystem.h
+//
+// 任务调度：每个工作线程一个双端队列，自己从尾部取（后进先出，缓存友好），
+// 空闲时从其他队列头部窃取。任务可以依赖其他任务，依赖全部完成后才进入队列。
+// 等待任务的线程（包括主线程）会帮忙执行队列中的任务，不会空转。
+//***************************************************************************************
+
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem
+{
+private:
+    struct Job;
+
+public:
+    // 任务句柄，可用于等待或作为其他任务的依赖；空句柄视为已完成
+    typedef std::shared_ptr<Job> JobHandle;
+
+public:
+    // workerCount 为 0 时使用硬件线程数 - 1（调用线程在等待时也会执行任务）
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // 提交任务，pDependencies 中的任务全部完成后才会执行
+    JobHandle Schedule(std::function<void()> fn, const JobHandle* pDependencies = nullptr, uint32_t dependencyCount = 0);
+    // 等待任务完成，期间执行其他任务
+    void Wait(const JobHandle& job);
+
+    // 把 [begin, end) 按 grain 切块并行执行 body(blockBegin, blockEnd)，返回时全部完成
+    void ParallelFor(uint32_t begin, uint32_t end, uint32_t grain,
+        const std::function<void(uint32_t, uint32_t)>& body);
+
+    unsigned GetWorkerCount() const;
+
+private:
+    struct Job
+    {
+        std::function<void()> fn;
+        std::atomic<int> pendingDependencies{ 0 };
+        std::atomic<bool> done{ false };
+        std::mutex mutex;                       // 保护 continuations 与 done 的设置
+        std::vector<JobHandle> continuations;   // 依赖本任务的任务
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<JobHandle> jobs;
+    };
+
+    void WorkerMain(unsigned index);
+    void Enqueue(const JobHandle& job);
+    bool TryRunOne(unsigned queueIndex);
+    JobHandle Pop(unsigned queueIndex);
+    JobHandle Steal(unsigned thiefIndex);
+    void Execute(const JobHandle& job);
+    unsigned CurrentQueueIndex() const;
+
+private:
+    std::vector<std::thread> m_Workers;
+    // 每个工作线程一个队列，最后一个给外部线程（主线程）提交的任务使用
+    std::vector<std::unique_ptr<WorkQueue>> m_Queues;
+
+    std::atomic<int> m_QueuedJobs{ 0 };
+    std::atomic<bool> m_Quit{ false };
+    std::mutex m_SleepMutex;
+    std::condition_variable m_WakeCondition;
+};
+
+#endif
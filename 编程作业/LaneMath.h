@@ -0,0 +1,206 @@
+//***************************************************************************************
+// LaneMath.h
+//
+// 字符森林实例变换的 4 路 SSE 运算：一个 __m128 的第 i 条 lane 属于第 i 个实例。
+// 各步骤照搬 DirectXMath 的实现（XMScalarSinCos、XMMatrixRotationX/Y、XMMatrixMultiply），
+// 运算和舍入顺序相同，结果与逐个调用 DirectXMath 逐位一致。
+// 本文件不依赖 DirectXMath，常量取 DirectXMath 中的同一个 float 值，
+// 因此 SSE 版本可以在没有 DirectXMath 的测试构建中直接和标量版本逐位比较（Tests/LaneMathTests）。
+//***************************************************************************************
+
+#ifndef LANEMATH_H
+#define LANEMATH_H
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define LANE_MATH_SSE 1
+#include <emmintrin.h>
+#endif
+
+// 与 XM_PI、XM_2PI、XM_1DIV2PI、XM_PIDIV2 相同
+static const float kLanePi = 3.141592654f;
+static const float kLane2Pi = 6.283185307f;
+static const float kLane1Div2Pi = 0.159154943f;
+static const float kLanePiDiv2 = 1.570796327f;
+
+// ==== 标量版本 ====
+// 同 XMScalarSinCos：归约到 [-π, π]，再按 ±π/2 折叠，正弦 11 次、余弦 10 次多项式
+inline void ScalarSinCos(float value, float* pSin, float* pCos)
+{
+    float quotient = kLane1Div2Pi * value;
+    if (value >= 0.0f)
+        quotient = static_cast<float>(static_cast<int>(quotient + 0.5f));
+    else
+        quotient = static_cast<float>(static_cast<int>(quotient - 0.5f));
+    float y = value - kLane2Pi * quotient;
+
+    float sign;
+    if (y > kLanePiDiv2)
+    {
+        y = kLanePi - y;
+        sign = -1.0f;
+    }
+    else if (y < -kLanePiDiv2)
+    {
+        y = -kLanePi - y;
+        sign = -1.0f;
+    }
+    else
+    {
+        sign = 1.0f;
+    }
+    float y2 = y * y;
+
+    *pSin = (((((-2.3889859e-08f * y2 + 2.7525562e-06f) * y2 - 0.00019840874f) * y2 + 0.0083333310f) * y2
+        - 0.16666667f) * y2 + 1.0f) * y;
+    float p = ((((-2.6051615e-07f * y2 + 2.4760495e-05f) * y2 - 0.0013888378f) * y2 + 0.041666638f) * y2
+        - 0.5f) * y2 + 1.0f;
+    *pCos = sign * p;
+}
+
+// 单元的伪随机缩放 [0.35, 0.7)：正弦哈希取小数部分。
+// 正弦用上面的多项式而不是 sinf，使 4 路版本（LaneCellScale）能逐位复现
+inline float CellScale(int ix, int iy, int iz)
+{
+    float s, c;
+    ScalarSinCos(ix * 12.9898f + iy * 78.233f + iz * 37.719f, &s, &c);
+    float h = std::fabs(s * 43758.5453f);
+    h -= std::floor(h);
+    return 0.35f + 0.35f * h;
+}
+
+#if defined(LANE_MATH_SSE)
+struct LaneMatrix
+{
+    __m128 m[4][4];
+};
+
+inline __m128 LaneSelect(__m128 a, __m128 b, __m128 mask)
+{
+    return _mm_or_ps(_mm_andnot_ps(mask, a), _mm_and_ps(mask, b));
+}
+
+// 同 ScalarSinCos（XMScalarSinCos），四条 lane 各算一个
+inline void LaneSinCos(__m128 value, __m128* pSin, __m128* pCos)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 quotient = _mm_mul_ps(_mm_set1_ps(kLane1Div2Pi), value);
+    __m128 nonNegative = _mm_cmpge_ps(value, _mm_setzero_ps());
+    quotient = LaneSelect(_mm_sub_ps(quotient, half), _mm_add_ps(quotient, half), nonNegative);
+    quotient = _mm_cvtepi32_ps(_mm_cvttps_epi32(quotient));
+    __m128 y = _mm_sub_ps(value, _mm_mul_ps(_mm_set1_ps(kLane2Pi), quotient));
+
+    __m128 above = _mm_cmpgt_ps(y, _mm_set1_ps(kLanePiDiv2));
+    __m128 below = _mm_cmplt_ps(y, _mm_set1_ps(-kLanePiDiv2));
+    __m128 folded = LaneSelect(y, _mm_sub_ps(_mm_set1_ps(kLanePi), y), above);
+    folded = LaneSelect(folded, _mm_sub_ps(_mm_set1_ps(-kLanePi), y), below);
+    __m128 sign = LaneSelect(_mm_set1_ps(1.0f), _mm_set1_ps(-1.0f), _mm_or_ps(above, below));
+    y = folded;
+    __m128 y2 = _mm_mul_ps(y, y);
+
+    __m128 s = _mm_set1_ps(-2.3889859e-08f);
+    s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(2.7525562e-06f));
+    s = _mm_sub_ps(_mm_mul_ps(s, y2), _mm_set1_ps(0.00019840874f));
+    s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(0.0083333310f));
+    s = _mm_sub_ps(_mm_mul_ps(s, y2), _mm_set1_ps(0.16666667f));
+    s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(1.0f));
+    *pSin = _mm_mul_ps(s, y);
+
+    __m128 c = _mm_set1_ps(-2.6051615e-07f);
+    c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(2.4760495e-05f));
+    c = _mm_sub_ps(_mm_mul_ps(c, y2), _mm_set1_ps(0.0013888378f));
+    c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(0.041666638f));
+    c = _mm_sub_ps(_mm_mul_ps(c, y2), _mm_set1_ps(0.5f));
+    c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(1.0f));
+    *pCos = _mm_mul_ps(sign, c);
+}
+
+// 同 CellScale：单元 (ix, iy, iz0..iz0+3) 的缩放。
+// h 非负且远小于 2^31，截断取整即 floor
+inline __m128 LaneCellScale(int ix, int iy, int iz0)
+{
+    const __m128 x = _mm_mul_ps(_mm_set1_ps(static_cast<float>(ix)), _mm_set1_ps(12.9898f));
+    const __m128 y = _mm_mul_ps(_mm_set1_ps(static_cast<float>(iy)), _mm_set1_ps(78.233f));
+    const __m128 z = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(iz0), _mm_set_epi32(3, 2, 1, 0))),
+        _mm_set1_ps(37.719f));
+    __m128 s, c;
+    LaneSinCos(_mm_add_ps(_mm_add_ps(x, y), z), &s, &c);
+    __m128 h = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_mul_ps(s, _mm_set1_ps(43758.5453f)));
+    h = _mm_sub_ps(h, _mm_cvtepi32_ps(_mm_cvttps_epi32(h)));
+    return _mm_add_ps(_mm_set1_ps(0.35f), _mm_mul_ps(_mm_set1_ps(0.35f), h));
+}
+
+inline void LaneIdentity(LaneMatrix& out)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            out.m[i][j] = i == j ? one : zero;
+}
+
+// 同 XMMatrixRotationY：r0 = (c, 0, -s, 0)，r2 = (s, 0, c, 0)；-s 由乘 -1 得到
+inline void LaneRotationY(__m128 angle, LaneMatrix& out)
+{
+    __m128 s, c;
+    LaneSinCos(angle, &s, &c);
+    LaneIdentity(out);
+    out.m[0][0] = c;
+    out.m[0][2] = _mm_mul_ps(s, _mm_set1_ps(-1.0f));
+    out.m[2][0] = s;
+    out.m[2][2] = c;
+}
+
+// 同 XMMatrixRotationX：r1 = (0, c, s, 0)，r2 = (0, -s, c, 0)
+inline void LaneRotationX(__m128 angle, LaneMatrix& out)
+{
+    __m128 s, c;
+    LaneSinCos(angle, &s, &c);
+    LaneIdentity(out);
+    out.m[1][1] = c;
+    out.m[1][2] = s;
+    out.m[2][1] = _mm_mul_ps(s, _mm_set1_ps(-1.0f));
+    out.m[2][2] = c;
+}
+
+inline void LaneScaling(__m128 scale, LaneMatrix& out)
+{
+    LaneIdentity(out);
+    out.m[0][0] = scale;
+    out.m[1][1] = scale;
+    out.m[2][2] = scale;
+}
+
+inline void LaneTranslation(__m128 x, __m128 y, __m128 z, LaneMatrix& out)
+{
+    LaneIdentity(out);
+    out.m[3][0] = x;
+    out.m[3][1] = y;
+    out.m[3][2] = z;
+}
+
+// 所有 lane 使用同一个矩阵（行主序 16 个 float）
+inline void LaneBroadcast(const float matrix[16], LaneMatrix& out)
+{
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            out.m[i][j] = _mm_set1_ps(matrix[i * 4 + j]);
+}
+
+// 同 XMMatrixMultiply：四项乘积按 (x + z) + (y + w) 两两相加；out 不能与 a、b 相同
+inline void LaneMultiply(const LaneMatrix& a, const LaneMatrix& b, LaneMatrix& out)
+{
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+        {
+            __m128 x = _mm_mul_ps(a.m[i][0], b.m[0][j]);
+            __m128 y = _mm_mul_ps(a.m[i][1], b.m[1][j]);
+            __m128 z = _mm_mul_ps(a.m[i][2], b.m[2][j]);
+            __m128 w = _mm_mul_ps(a.m[i][3], b.m[3][j]);
+            out.m[i][j] = _mm_add_ps(_mm_add_ps(x, z), _mm_add_ps(y, w));
+        }
+}
+#endif
+
+#endif
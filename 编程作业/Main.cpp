@@ -1,4 +1,7 @@
 #include "GameApp.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
  
 
 
@@ -7,7 +10,6 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE prevInstance,
 {
 	// 这些参数不使用
 	UNREFERENCED_PARAMETER(prevInstance);
-	UNREFERENCED_PARAMETER(cmdLine);
 	UNREFERENCED_PARAMETER(showCmd);
 	// 允许在Debug版本进行运行时内存分配和泄漏检测
 #if defined(DEBUG) | defined(_DEBUG)
@@ -15,6 +17,30 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE prevInstance,
 #endif
 
 	GameApp theApp(hInstance);
+
+	// -replay <文件>：回放 F9 捕获的命令流
+	const char* replayArg = strstr(cmdLine, "-replay ");
+	if (replayArg)
+	{
+		std::string path = replayArg + strlen("-replay ");
+		// 去掉路径两侧的空格和引号
+		size_t first = path.find_first_not_of(" \"");
+		size_t last = path.find_last_not_of(" \"");
+		if (first != std::string::npos)
+			theApp.SetReplayFile(path.substr(first, last - first + 1));
+	}
+
+	// -frames <n>：CPU 最多领先 GPU 的帧数（默认 2）
+	const char* framesArg = strstr(cmdLine, "-frames ");
+	if (framesArg)
+		theApp.SetMaxFramesInFlight(static_cast<uint32_t>(atoi(framesArg + strlen("-frames "))));
+	// -fps <n>：帧率上限（默认 120，0 表示不限制）
+	const char* fpsArg = strstr(cmdLine, "-fps ");
+	if (fpsArg)
+		theApp.SetTargetFrameRate(atof(fpsArg + strlen("-fps ")));
+	// -floatverts：所有网格都使用 40 字节的浮点顶点格式（用于对比压缩格式）
+	if (strstr(cmdLine, "-floatverts"))
+		theApp.SetPackedVertices(false);
 	
 	if( !theApp.Init() )
 		return 0;
@@ -0,0 +1,41 @@
+//***************************************************************************************
+// MappedFile.h
+//
+// 只读内存映射文件：Windows 下使用 CreateFileMapping，其它平台使用 mmap。
+// 映射后的数据按需调页，读取大文件时不需要整体拷贝到内存。
+//***************************************************************************************
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+
+    bool IsOpen() const;
+    const uint8_t* GetData() const;
+    size_t GetSize() const;
+
+private:
+    const uint8_t* m_pData = nullptr;
+    size_t m_Size = 0;
+#ifdef _WIN32
+    void* m_hFile = nullptr;
+    void* m_hMapping = nullptr;
+#else
+    int m_Fd = -1;
+#endif
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "MeshLoader.h"
+#include <algorithm>
+#include <chrono>
+
+const uint8_t* MeshLoader::MeshData::GetVertexData() const
+{
+    return mappedFile ? mappedFile->GetVertices() : vertices.data();
+}
+
+size_t MeshLoader::MeshData::GetVertexBytes() const
+{
+    return mappedFile ? static_cast<size_t>(mappedFile->GetHeader().vertexBytes) : vertices.size();
+}
+
+const uint16_t* MeshLoader::MeshData::GetIndexData() const
+{
+    return mappedFile ? mappedFile->GetIndices() : indices.data();
+}
+
+uint32_t MeshLoader::MeshData::GetIndexCount() const
+{
+    return mappedFile ? mappedFile->GetHeader().indexCount : static_cast<uint32_t>(indices.size());
+}
+
+MeshLoader::MeshLoader(unsigned workerCount)
+    : m_Jobs(std::max(1u, workerCount))
+{
+}
+
+void MeshLoader::Request(int meshId, LoadFunction load)
+{
+    ++m_Pending;
+    m_Jobs.Schedule([this, meshId, load]()
+    {
+        typedef std::chrono::steady_clock Clock;
+        Clock::time_point start = Clock::now();
+
+        MeshData mesh;
+        mesh.meshId = meshId;
+        load(mesh);
+        mesh.loadSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(m_FinishedMutex);
+        m_Finished.push_back(std::move(mesh));
+    });
+}
+
+uint32_t MeshLoader::PopFinished(std::vector<MeshData>& finished)
+{
+    std::lock_guard<std::mutex> lock(m_FinishedMutex);
+    uint32_t count = static_cast<uint32_t>(m_Finished.size());
+    for (MeshData& mesh : m_Finished)
+        finished.push_back(std::move(mesh));
+    m_Finished.clear();
+    m_Pending -= count;
+    return count;
+}
+
+uint32_t MeshLoader::GetPendingCount() const
+{
+    return m_Pending;
+}
@@ -0,0 +1,74 @@
+//***************************************************************************************
+// MeshLoader.h
+//
+// 后台网格加载：加载函数（解析、处理网格数据）在独立的加载线程池上并行执行，
+// 完成的网格放入完成队列，由渲染线程每帧取走后写入几何池并上传。
+// 加载期间场景照常绘制，尚未完成的网格由调用方用占位网格代替。
+//***************************************************************************************
+
+#ifndef MESHLOADER_H
+#define MESHLOADER_H
+
+#include "GlyphMeshFile.h"
+#include "JobSystem.h"
+#include "VertexLayout.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class MeshLoader
+{
+public:
+    // 加载结果：顶点按字节存放（Float 格式的布局由加载函数和调用方约定），索引为网格内的 16 位编号
+    struct MeshData
+    {
+        int meshId = -1;
+        uint32_t vertexCount = 0;
+        std::vector<uint8_t> vertices;
+        VertexFormat format = VertexFormat::Float;
+        PositionDecode decode = {};     // Packed 时的位置反量化参数
+        PackError packError;            // Packed 时压缩引入的最大误差
+        std::vector<uint16_t> indices;
+        double loadSeconds = 0.0;       // 加载函数耗时
+        uint32_t sourceVertexCount = 0; // 加载函数处理（如焊接）前的顶点数，0 表示未处理
+        float acmrBefore = 0.0f;        // 索引重排前后的 ACMR / ATVR，0 表示未统计
+        float acmrAfter = 0.0f;
+        float atvrBefore = 0.0f;
+        float atvrAfter = 0.0f;
+        // 顶点和索引直接使用内存映射的字形网格文件时 vertices / indices 为空，
+        // 由下面的函数返回映射中的指针，文件在最后一个引用它的 MeshData 销毁时关闭
+        std::shared_ptr<const GlyphMeshFile> mappedFile;
+
+        const uint8_t* GetVertexData() const;
+        size_t GetVertexBytes() const;
+        const uint16_t* GetIndexData() const;
+        uint32_t GetIndexCount() const;
+    };
+    // 在加载线程上调用，填写 vertexCount / vertices / indices（或 mappedFile）
+    typedef std::function<void(MeshData& mesh)> LoadFunction;
+
+public:
+    // 加载线程至少一个：没有人等待加载任务，不能依赖调用线程帮忙执行
+    explicit MeshLoader(unsigned workerCount = 2);
+
+    MeshLoader(const MeshLoader&) = delete;
+    MeshLoader& operator=(const MeshLoader&) = delete;
+
+    void Request(int meshId, LoadFunction load);
+    // 取走所有已完成的网格（追加到 finished），返回取到的个数
+    uint32_t PopFinished(std::vector<MeshData>& finished);
+    // 已请求但还没被 PopFinished 取走的网格数
+    uint32_t GetPendingCount() const;
+
+private:
+    std::mutex m_FinishedMutex;
+    std::vector<MeshData> m_Finished;
+    std::atomic<uint32_t> m_Pending{ 0 };
+    // 最后声明、最先析构：先等加载线程退出，再释放完成队列
+    JobSystem m_Jobs;
+};
+
+#endif
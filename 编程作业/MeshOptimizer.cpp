@@ -0,0 +1,298 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+const float MeshOptimizer::kDefaultOverdrawThreshold = 1.05f;
+
+namespace
+{
+    // FIFO 顶点缓存模拟：每个顶点记录进入缓存时的时间戳，此后又进入了 cacheSize 个顶点即被挤出
+    // Flush 只推进时间戳，不需要清空数组
+    class FifoCache
+    {
+    public:
+        FifoCache(uint32_t vertexCount, uint32_t cacheSize)
+            : m_Stamps(vertexCount, 0), m_CacheSize(cacheSize), m_Time(cacheSize + 1)
+        {
+        }
+
+        // 返回是否未命中（需要变换）
+        bool Access(uint32_t vertex)
+        {
+            if (m_Time - m_Stamps[vertex] <= m_CacheSize)
+                return false;
+            m_Stamps[vertex] = m_Time++;
+            return true;
+        }
+
+        void Flush()
+        {
+            m_Time += m_CacheSize + 1;
+        }
+
+    private:
+        std::vector<uint32_t> m_Stamps;
+        uint32_t m_CacheSize;
+        uint32_t m_Time;
+    };
+
+    struct Float3
+    {
+        float x, y, z;
+    };
+
+    Float3 LoadPosition(const uint8_t* pVertices, uint32_t stride, uint32_t index)
+    {
+        Float3 p;
+        memcpy(&p, pVertices + static_cast<size_t>(index) * stride, sizeof(p));
+        return p;
+    }
+}
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint16_t* pIndices, uint32_t indexCount,
+    uint32_t vertexCount, uint32_t cacheSize)
+{
+    VertexCacheStats stats;
+    if (indexCount < 3)
+        return stats;
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<uint8_t> referenced(vertexCount, 0);
+    uint32_t uniqueVertices = 0;
+    for (uint32_t i = 0; i < indexCount; ++i)
+    {
+        uint32_t v = pIndices[i];
+        assert(v < vertexCount);
+        if (cache.Access(v))
+            ++stats.transformedVertices;
+        if (!referenced[v])
+        {
+            referenced[v] = 1;
+            ++uniqueVertices;
+        }
+    }
+    stats.acmr = static_cast<float>(stats.transformedVertices) / (indexCount / 3);
+    stats.atvr = static_cast<float>(stats.transformedVertices) / uniqueVertices;
+    return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(uint16_t* pDestination, const uint16_t* pIndices, uint32_t indexCount,
+    uint32_t vertexCount, uint32_t cacheSize, std::vector<uint32_t>* pClusters)
+{
+    assert(indexCount % 3 == 0);
+    uint32_t triangleCount = indexCount / 3;
+    if (pClusters)
+        pClusters->clear();
+    if (triangleCount == 0)
+        return;
+
+    // 顶点 -> 使用它的三角形（CSR 形式），live 为每个顶点还未输出的三角形数
+    std::vector<uint32_t> live(vertexCount, 0);
+    for (uint32_t i = 0; i < indexCount; ++i)
+        ++live[pIndices[i]];
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+        offsets[v + 1] = offsets[v] + live[v];
+    std::vector<uint32_t> adjacency(indexCount);
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (uint32_t i = 0; i < indexCount; ++i)
+            adjacency[fill[pIndices[i]]++] = i / 3;
+    }
+
+    std::vector<uint32_t> cacheStamps(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEnd;
+    deadEnd.reserve(indexCount);
+    std::vector<uint32_t> candidates;
+    std::vector<uint16_t> result(indexCount);
+    uint32_t written = 0;
+    uint32_t cursor = 0;
+    bool boundary = true;
+
+    // 从第一个被引用的顶点开始扇形输出
+    while (cursor < vertexCount && live[cursor] == 0)
+        ++cursor;
+    int64_t fan = cursor < vertexCount ? static_cast<int64_t>(cursor) : -1;
+
+    while (fan >= 0)
+    {
+        // 输出 fan 周围所有还未输出的三角形
+        candidates.clear();
+        for (uint32_t k = offsets[fan]; k < offsets[fan + 1]; ++k)
+        {
+            uint32_t t = adjacency[k];
+            if (emitted[t])
+                continue;
+            if (boundary && pClusters)
+                pClusters->push_back(written / 3);
+            boundary = false;
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                uint16_t v = pIndices[t * 3 + c];
+                result[written++] = v;
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+                if (time - cacheStamps[v] > cacheSize)
+                    cacheStamps[v] = time++;
+            }
+            emitted[t] = 1;
+        }
+
+        // 下一个扇形中心：在刚输出的顶点中选仍在缓存里、输出完剩余三角形后也不会被挤出、且最早进入缓存的
+        int64_t next = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates)
+        {
+            if (live[v] == 0)
+                continue;
+            int64_t priority = 0;
+            if (time - cacheStamps[v] + 2 * live[v] <= cacheSize)
+                priority = time - cacheStamps[v];
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+
+        if (next < 0)
+        {
+            // 死胡同：缓存连续性中断，先回溯最近输出过的顶点，再按编号顺序找
+            boundary = true;
+            while (!deadEnd.empty())
+            {
+                uint32_t v = deadEnd.back();
+                deadEnd.pop_back();
+                if (live[v] > 0)
+                {
+                    next = v;
+                    break;
+                }
+            }
+            while (next < 0 && cursor < vertexCount)
+            {
+                if (live[cursor] > 0)
+                    next = cursor;
+                else
+                    ++cursor;
+            }
+        }
+        fan = next;
+    }
+
+    assert(written == indexCount);
+    memcpy(pDestination, result.data(), indexCount * sizeof(uint16_t));
+}
+
+void MeshOptimizer::OptimizeOverdraw(uint16_t* pDestination, const uint16_t* pIndices, uint32_t indexCount,
+    const void* pVertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t cacheSize, float threshold)
+{
+    assert(indexCount % 3 == 0);
+    uint32_t triangleCount = indexCount / 3;
+    std::vector<uint16_t> ordered(indexCount);
+    std::vector<uint32_t> hardClusters;
+    OptimizeVertexCache(ordered.data(), pIndices, indexCount, vertexCount, cacheSize, &hardClusters);
+    if (triangleCount == 0)
+        return;
+    hardClusters.push_back(triangleCount);
+
+    // ==== 软边界：簇从冷缓存开始的 ACMR 已经不超过 threshold 倍整簇 ACMR 时就可以切开 ====
+    std::vector<uint32_t> clusters;
+    FifoCache cache(vertexCount, cacheSize);
+    for (size_t h = 0; h + 1 < hardClusters.size(); ++h)
+    {
+        uint32_t begin = hardClusters[h];
+        uint32_t end = hardClusters[h + 1];
+
+        cache.Flush();
+        uint32_t clusterMisses = 0;
+        for (uint32_t t = begin; t < end; ++t)
+            for (uint32_t c = 0; c < 3; ++c)
+                clusterMisses += cache.Access(ordered[t * 3 + c]) ? 1 : 0;
+        float clusterAcmr = static_cast<float>(clusterMisses) / (end - begin);
+
+        cache.Flush();
+        clusters.push_back(begin);
+        uint32_t segmentStart = begin;
+        uint32_t segmentMisses = 0;
+        for (uint32_t t = begin; t < end; ++t)
+        {
+            for (uint32_t c = 0; c < 3; ++c)
+                segmentMisses += cache.Access(ordered[t * 3 + c]) ? 1 : 0;
+            float segmentAcmr = static_cast<float>(segmentMisses) / (t + 1 - segmentStart);
+            if (t + 1 < end && segmentAcmr <= clusterAcmr * threshold)
+            {
+                clusters.push_back(t + 1);
+                segmentStart = t + 1;
+                segmentMisses = 0;
+                cache.Flush();
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+
+    // ==== 按簇计算面积加权的中心和法线，网格中心为所有三角形的面积加权中心 ====
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pVertices);
+    size_t clusterCount = clusters.size() - 1;
+    std::vector<Float3> centroids(clusterCount), normals(clusterCount);
+    Float3 meshCentroid = { 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+    for (size_t k = 0; k < clusterCount; ++k)
+    {
+        Float3 centroid = { 0.0f, 0.0f, 0.0f };
+        Float3 normal = { 0.0f, 0.0f, 0.0f };
+        float clusterArea = 0.0f;
+        for (uint32_t t = clusters[k]; t < clusters[k + 1]; ++t)
+        {
+            Float3 p0 = LoadPosition(pBytes, vertexStride, ordered[t * 3 + 0]);
+            Float3 p1 = LoadPosition(pBytes, vertexStride, ordered[t * 3 + 1]);
+            Float3 p2 = LoadPosition(pBytes, vertexStride, ordered[t * 3 + 2]);
+            Float3 e1 = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+            Float3 e2 = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+            Float3 n = { e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+            float area = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+            centroid.x += (p0.x + p1.x + p2.x) * area;
+            centroid.y += (p0.y + p1.y + p2.y) * area;
+            centroid.z += (p0.z + p1.z + p2.z) * area;
+            normal.x += n.x; normal.y += n.y; normal.z += n.z;
+            clusterArea += area;
+        }
+        meshCentroid.x += centroid.x; meshCentroid.y += centroid.y; meshCentroid.z += centroid.z;
+        meshArea += clusterArea;
+        float inverse = clusterArea > 0.0f ? 1.0f / (3.0f * clusterArea) : 0.0f;
+        centroids[k] = { centroid.x * inverse, centroid.y * inverse, centroid.z * inverse };
+        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        float normalScale = length > 0.0f ? 1.0f / length : 0.0f;
+        normals[k] = { normal.x * normalScale, normal.y * normalScale, normal.z * normalScale };
+    }
+    if (meshArea > 0.0f)
+    {
+        float inverse = 1.0f / (3.0f * meshArea);
+        meshCentroid = { meshCentroid.x * inverse, meshCentroid.y * inverse, meshCentroid.z * inverse };
+    }
+
+    // ==== 越朝外的簇越先画 ====
+    std::vector<float> keys(clusterCount);
+    std::vector<uint32_t> order(clusterCount);
+    for (size_t k = 0; k < clusterCount; ++k)
+    {
+        Float3 d = { centroids[k].x - meshCentroid.x, centroids[k].y - meshCentroid.y, centroids[k].z - meshCentroid.z };
+        keys[k] = d.x * normals[k].x + d.y * normals[k].y + d.z * normals[k].z;
+        order[k] = static_cast<uint32_t>(k);
+    }
+    std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] > keys[b]; });
+
+    uint32_t written = 0;
+    for (uint32_t k : order)
+    {
+        uint32_t count = (clusters[k + 1] - clusters[k]) * 3;
+        memcpy(pDestination + written, ordered.data() + clusters[k] * 3, count * sizeof(uint16_t));
+        written += count;
+    }
+    assert(written == indexCount);
+}
@@ -0,0 +1,48 @@
+//***************************************************************************************
+// MeshOptimizer.h
+//
+// 索引缓冲优化（Tipsify，Sander 等 2007）：
+// 1. OptimizeVertexCache：按顶点扇形依次输出三角形，使相邻三角形尽量共享仍在顶点缓存中的顶点；
+// 2. OptimizeOverdraw：在 1 的结果上按缓存连续性切成簇，簇内顺序不变，
+//    簇按"朝外程度"（簇中心相对网格中心在簇法线上的投影）从大到小排列，
+//    从常见视角看时先画朝向观察者的外侧面，提前深度测试能剔除更多后画的像素；
+// AnalyzeVertexCache 用 FIFO 缓存模拟统计 ACMR（每三角形变换顶点数）和 ATVR（变换次数 / 顶点数）。
+//***************************************************************************************
+
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include <cstdint>
+#include <vector>
+
+struct VertexCacheStats
+{
+    uint32_t transformedVertices = 0;   // 缓存未命中次数
+    float acmr = 0.0f;                  // 每个三角形平均变换的顶点数，理想值约 0.5~0.7，最差 3
+    float atvr = 0.0f;                  // 变换次数 / 被引用的顶点数，理想值 1
+};
+
+class MeshOptimizer
+{
+public:
+    static const uint32_t kDefaultCacheSize = 16;
+    // 切簇后 ACMR 最多比不切时变差这么多（overdraw 优化与顶点缓存之间的折中）
+    static const float kDefaultOverdrawThreshold;
+
+public:
+    // FIFO 顶点缓存模拟
+    static VertexCacheStats AnalyzeVertexCache(const uint16_t* pIndices, uint32_t indexCount,
+        uint32_t vertexCount, uint32_t cacheSize = kDefaultCacheSize);
+
+    // 三角形重排，结果写入 pDestination（可以与 pIndices 相同）
+    // pClusters 非空时写入每个簇的起始三角形编号（缓存连续性中断的位置）
+    static void OptimizeVertexCache(uint16_t* pDestination, const uint16_t* pIndices, uint32_t indexCount,
+        uint32_t vertexCount, uint32_t cacheSize = kDefaultCacheSize, std::vector<uint32_t>* pClusters = nullptr);
+
+    // 先做顶点缓存优化，再按簇排序减少 overdraw；顶点的前 12 字节为 float3 位置
+    static void OptimizeOverdraw(uint16_t* pDestination, const uint16_t* pIndices, uint32_t indexCount,
+        const void* pVertices, uint32_t vertexCount, uint32_t vertexStride,
+        uint32_t cacheSize = kDefaultCacheSize, float threshold = kDefaultOverdrawThreshold);
+};
+
+#endif
@@ -0,0 +1,98 @@
+#include "MeshWelder.h"
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    uint64_t HashKey(const int32_t* pKey, uint32_t count)
+    {
+        // FNV-1a，按 32 位分量
+        uint64_t hash = 14695981039346656037ull;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            hash ^= static_cast<uint32_t>(pKey[i]);
+            hash *= 1099511628211ull;
+        }
+        return hash ^ (hash >> 29);
+    }
+}
+
+WeldStats WeldVertices(const void* pVertices, uint32_t vertexCount, uint32_t vertexStride,
+    const WeldAttribute* pAttributes, uint32_t attributeCount,
+    const uint16_t* pIndices, uint32_t indexCount,
+    std::vector<uint8_t>& weldedVertices, std::vector<uint16_t>& weldedIndices)
+{
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pVertices);
+    uint32_t keySize = 0;
+    for (uint32_t a = 0; a < attributeCount; ++a)
+    {
+        assert(pAttributes[a].byteOffset + pAttributes[a].floatCount * sizeof(float) <= vertexStride);
+        assert(pAttributes[a].quantum > 0.0f);
+        keySize += pAttributes[a].floatCount;
+    }
+    if (!pIndices)
+        indexCount = vertexCount;
+
+    WeldStats stats;
+    stats.inputVertices = vertexCount;
+    stats.inputBytes = vertexCount * vertexStride;
+
+    // 开放寻址表，槽位存输出顶点编号 + 1（0 为空）；容量为 2 的幂且至少为顶点数的两倍
+    uint32_t tableSize = 16;
+    while (tableSize < vertexCount * 2)
+        tableSize *= 2;
+    std::vector<uint32_t> table(tableSize, 0);
+    std::vector<int32_t> keys;          // 每个输出顶点的量化键，按输出顶点编号排列
+    keys.reserve(static_cast<size_t>(vertexCount) * keySize);
+    std::vector<int32_t> key(keySize);
+    // 输入顶点已经被分配的输出编号（同一个输入顶点被多次引用时只查一次表）
+    std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+
+    weldedVertices.clear();
+    weldedIndices.clear();
+    weldedIndices.reserve(indexCount);
+
+    for (uint32_t i = 0; i < indexCount; ++i)
+    {
+        uint32_t source = pIndices ? pIndices[i] : i;
+        assert(source < vertexCount);
+        if (remap[source] == UINT32_MAX)
+        {
+            const uint8_t* pVertex = pBytes + static_cast<size_t>(source) * vertexStride;
+            uint32_t k = 0;
+            for (uint32_t a = 0; a < attributeCount; ++a)
+            {
+                const WeldAttribute& attribute = pAttributes[a];
+                float inverse = 1.0f / attribute.quantum;
+                for (uint32_t c = 0; c < attribute.floatCount; ++c)
+                {
+                    float value;
+                    memcpy(&value, pVertex + attribute.byteOffset + c * sizeof(float), sizeof(float));
+                    key[k++] = static_cast<int32_t>(std::lround(value * inverse));
+                }
+            }
+
+            uint32_t slot = static_cast<uint32_t>(HashKey(key.data(), keySize)) & (tableSize - 1);
+            while (table[slot] != 0 &&
+                memcmp(&keys[static_cast<size_t>(table[slot] - 1) * keySize], key.data(), keySize * sizeof(int32_t)) != 0)
+            {
+                slot = (slot + 1) & (tableSize - 1);
+            }
+            if (table[slot] == 0)
+            {
+                uint32_t output = static_cast<uint32_t>(weldedVertices.size() / vertexStride);
+                table[slot] = output + 1;
+                keys.insert(keys.end(), key.begin(), key.end());
+                weldedVertices.insert(weldedVertices.end(), pVertex, pVertex + vertexStride);
+            }
+            remap[source] = table[slot] - 1;
+        }
+        assert(remap[source] <= UINT16_MAX);
+        weldedIndices.push_back(static_cast<uint16_t>(remap[source]));
+    }
+
+    stats.outputVertices = static_cast<uint32_t>(weldedVertices.size() / vertexStride);
+    stats.outputBytes = static_cast<uint32_t>(weldedVertices.size());
+    return stats;
+}
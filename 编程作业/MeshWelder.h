@@ -0,0 +1,40 @@
+//***************************************************************************************
+// MeshWelder.h
+//
+// 顶点焊接：把量化后各属性都相同的顶点合并为一个，并重写索引。
+// 顶点按字节存放，每个属性由字节偏移、float 个数和量化步长描述（例如位置、法线、颜色），
+// 每个 float 先按步长取整再参与哈希和比较，因此只差浮点误差的顶点也会被合并。
+// 合并后的顶点保留第一次出现时的原始数据，三角形的个数和顺序不变，没有被索引引用的顶点会被丢弃。
+//***************************************************************************************
+
+#ifndef MESHWELDER_H
+#define MESHWELDER_H
+
+#include <cstdint>
+#include <vector>
+
+struct WeldAttribute
+{
+    uint32_t byteOffset;    // 在顶点内的字节偏移
+    uint32_t floatCount;    // 连续 float 的个数
+    float quantum;          // 量化步长，差值小于约半个步长的分量视为相同
+};
+
+struct WeldStats
+{
+    uint32_t inputVertices = 0;
+    uint32_t outputVertices = 0;
+    uint32_t inputBytes = 0;        // 顶点数据字节数（索引数不变，不计入）
+    uint32_t outputBytes = 0;
+
+    double VertexRatio() const { return inputVertices ? double(outputVertices) / inputVertices : 1.0; }
+};
+
+// 焊接 vertexCount 个步长为 vertexStride 的顶点，结果写入 weldedVertices / weldedIndices
+// pIndices 为空时按 0..vertexCount-1 的顺序处理（即未索引的三角形列表）
+WeldStats WeldVertices(const void* pVertices, uint32_t vertexCount, uint32_t vertexStride,
+    const WeldAttribute* pAttributes, uint32_t attributeCount,
+    const uint16_t* pIndices, uint32_t indexCount,
+    std::vector<uint8_t>& weldedVertices, std::vector<uint16_t>& weldedIndices);
+
+#endif
@@ -0,0 +1,93 @@
+#include "MonotonicClock.h"
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+MonotonicClock& MonotonicClock::GetSystemClock()
+{
+    static SystemClock clock;
+    return clock;
+}
+
+// ==== SystemClock ====
+#ifdef _WIN32
+
+SystemClock::SystemClock()
+{
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    m_Frequency = static_cast<uint64_t>(frequency.QuadPart);
+}
+
+uint64_t SystemClock::NowNs() const
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    uint64_t counts = static_cast<uint64_t>(counter.QuadPart);
+    // 先分整秒和余数再换算，避免 counts * 1e9 溢出
+    return counts / m_Frequency * 1000000000ull + counts % m_Frequency * 1000000000ull / m_Frequency;
+}
+
+#else
+
+SystemClock::SystemClock()
+{
+}
+
+uint64_t SystemClock::NowNs() const
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+#endif
+
+void SystemClock::SleepNs(uint64_t ns)
+{
+    std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+}
+
+// ==== FakeClock ====
+FakeClock::FakeClock(uint64_t startNs)
+    : m_NowNs(startNs)
+{
+}
+
+uint64_t FakeClock::NowNs() const
+{
+    uint64_t now = m_NowNs;
+    m_NowNs += m_ReadCostNs;
+    return now;
+}
+
+void FakeClock::SleepNs(uint64_t ns)
+{
+    m_NowNs += ns + m_SleepOvershootNs;
+    ++m_SleepCount;
+}
+
+void FakeClock::Advance(uint64_t ns)
+{
+    m_NowNs += ns;
+}
+
+void FakeClock::SetReadCost(uint64_t ns)
+{
+    m_ReadCostNs = ns;
+}
+
+void FakeClock::SetSleepOvershoot(uint64_t ns)
+{
+    m_SleepOvershootNs = ns;
+}
+
+uint32_t FakeClock::GetSleepCount() const
+{
+    return m_SleepCount;
+}
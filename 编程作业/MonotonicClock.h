@@ -0,0 +1,64 @@
+//***************************************************************************************
+// MonotonicClock.h
+//
+// 单调时钟抽象：以 64 位纳秒读取时间并按纳秒休眠。
+// SystemClock 在 Windows 上读 QueryPerformanceCounter，其他平台读 clock_gettime(CLOCK_MONOTONIC)；
+// FakeClock 由调用方手动推进，用于在 Linux 上驱动计时相关的逻辑。
+// 64 位纳秒可以表示约 584 年，长时间运行也不会损失精度。
+// 平台相关的部分只在 MonotonicClock.cpp 中。
+//***************************************************************************************
+
+#ifndef MONOTONICCLOCK_H
+#define MONOTONICCLOCK_H
+
+#include <cstdint>
+
+class MonotonicClock
+{
+public:
+    virtual ~MonotonicClock() = default;
+
+    // 单调递增的当前时间（纳秒），起点不确定，只用于求差
+    virtual uint64_t NowNs() const = 0;
+    // 至少休眠 ns 纳秒，实际时长取决于系统定时精度
+    virtual void SleepNs(uint64_t ns) = 0;
+
+    // 进程共享的系统时钟（SystemClock）
+    static MonotonicClock& GetSystemClock();
+};
+
+class SystemClock : public MonotonicClock
+{
+public:
+    SystemClock();
+
+    uint64_t NowNs() const override;
+    void SleepNs(uint64_t ns) override;
+
+private:
+    uint64_t m_Frequency = 0;       // QueryPerformanceFrequency，其他平台不使用
+};
+
+// 只有 Advance / SleepNs 会推进时间；每次 NowNs 可以额外前进 readCostNs，模拟读时钟本身的开销
+// SleepNs 实际推进 ns + sleepOvershootNs，模拟系统休眠的超时
+class FakeClock : public MonotonicClock
+{
+public:
+    explicit FakeClock(uint64_t startNs = 0);
+
+    uint64_t NowNs() const override;
+    void SleepNs(uint64_t ns) override;
+
+    void Advance(uint64_t ns);
+    void SetReadCost(uint64_t ns);
+    void SetSleepOvershoot(uint64_t ns);
+    uint32_t GetSleepCount() const;
+
+private:
+    mutable uint64_t m_NowNs;
+    uint64_t m_ReadCostNs = 0;
+    uint64_t m_SleepOvershootNs = 0;
+    uint32_t m_SleepCount = 0;
+};
+
+#endif
@@ -1366,6 +1366,32 @@ NameVertices::NameVertices(D3D11_PRIMITIVE_TOPOLOGY type, int id)
         nameVertices[i].pos.y *= 0.1f;
         nameVertices[i].pos.z *= 0.1f;
     }
+
+    // ==== 顶点焊接：上面按三角形展开后索引只是顺序编号，把位置、法线、颜色都相同的副本合并 ====
+    // 同一平面上相邻三角形的共享顶点法线相同，合并后 GPU 的顶点缓存才能命中
+    {
+        static const WeldAttribute attributes[] = {
+            { offsetof(GameApp::VertexPosColor, pos),    3, 1e-5f },
+            { offsetof(GameApp::VertexPosColor, normal), 3, 1e-4f },
+            { offsetof(GameApp::VertexPosColor, color),  4, 1.0f / 512.0f }
+        };
+        std::vector<uint8_t> weldedVertices;
+        std::vector<uint16_t> weldedIndices;
+        weldStats = WeldVertices(nameVertices, verticesCount, sizeof(GameApp::VertexPosColor),
+            attributes, _countof(attributes), nameIndices, indexCount, weldedVertices, weldedIndices);
+
+        delete[] nameVertices;
+        verticesCount = weldStats.outputVertices;
+        nameVertices = new GameApp::VertexPosColor[verticesCount];
+        memcpy(nameVertices, weldedVertices.data(), weldedVertices.size());
+        memcpy(nameIndices, weldedIndices.data(), weldedIndices.size() * sizeof(WORD));
+    }
+
+    // ==== 索引重排：三角形按顶点缓存局部性排序，再按簇由外向内排列以减少 overdraw ====
+    cacheStatsBefore = MeshOptimizer::AnalyzeVertexCache(nameIndices, indexCount, verticesCount);
+    MeshOptimizer::OptimizeOverdraw(nameIndices, nameIndices, indexCount,
+        nameVertices, verticesCount, sizeof(GameApp::VertexPosColor));
+    cacheStatsAfter = MeshOptimizer::AnalyzeVertexCache(nameIndices, indexCount, verticesCount);
 }
 
 NameVertices::~NameVertices()
@@ -1379,3 +1405,6 @@ WORD* NameVertices::GetNameIndices() { return nameIndices; }
 D3D11_PRIMITIVE_TOPOLOGY NameVertices::GetTopology() { return topology; }
 UINT NameVertices::GetVerticesCount() { return verticesCount; }
 UINT NameVertices::GetIndexCount() { return indexCount; }
+const WeldStats& NameVertices::GetWeldStats() const { return weldStats; }
+const VertexCacheStats& NameVertices::GetCacheStatsBefore() const { return cacheStatsBefore; }
+const VertexCacheStats& NameVertices::GetCacheStatsAfter() const { return cacheStatsAfter; }
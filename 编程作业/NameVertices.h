@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "GameApp.h"
+#include "MeshWelder.h"
+#include "MeshOptimizer.h"
 
 // 支持多汉字：id=0/1/2/3 对应四个不同名字
 class NameVertices
@@ -15,6 +17,11 @@ public:
     D3D11_PRIMITIVE_TOPOLOGY GetTopology();
     UINT GetVerticesCount();
     UINT GetIndexCount();
+    // 焊接前（按三角形展开）与焊接后的顶点数和顶点字节数
+    const WeldStats& GetWeldStats() const;
+    // 索引重排前后的顶点缓存统计
+    const VertexCacheStats& GetCacheStatsBefore() const;
+    const VertexCacheStats& GetCacheStatsAfter() const;
 
 private:
     GameApp::VertexPosColor* nameVertices = nullptr; // 顶点
@@ -22,4 +29,7 @@ private:
     D3D11_PRIMITIVE_TOPOLOGY topology;               // 图元类型
     UINT verticesCount = 0;                          // 顶点个数
     UINT indexCount = 0;                             // 索引个数
+    WeldStats weldStats;                             // 顶点焊接的统计
+    VertexCacheStats cacheStatsBefore;               // 索引重排前（OBJ 面顺序）
+    VertexCacheStats cacheStatsAfter;                // 索引重排后
 };
@@ -0,0 +1,240 @@
+#include "NullRenderDevice.h"
+#include <cassert>
+#include <cstring>
+
+NullRenderDevice::NullRenderDevice()
+{
+}
+
+NullRenderDevice::Buffer& NullRenderDevice::GetBuffer(BufferHandle buffer)
+{
+    assert(buffer != kInvalidBuffer && buffer <= m_Buffers.size());
+    return m_Buffers[buffer - 1];
+}
+
+BufferHandle NullRenderDevice::CreateBuffer(const BufferDesc& desc, const void* pInitData)
+{
+    Buffer buffer;
+    buffer.desc = desc;
+    buffer.desc.debugName = nullptr;    // 不保存调用方的字符串指针
+    buffer.data.resize(desc.byteWidth);
+    if (pInitData)
+        memcpy(buffer.data.data(), pInitData, desc.byteWidth);
+    m_Buffers.push_back(std::move(buffer));
+
+    ++m_Stats.bufferCreates;
+    return static_cast<BufferHandle>(m_Buffers.size());
+}
+
+void NullRenderDevice::WriteBuffer(BufferHandle buffer, MapMode mode, const BufferWrite* pWrites, uint32_t writeCount)
+{
+    Buffer& target = GetBuffer(buffer);
+    assert(target.desc.usage == BufferUsage::Dynamic);
+    (void)mode;
+
+    for (uint32_t i = 0; i < writeCount; ++i)
+    {
+        assert(pWrites[i].offset + pWrites[i].size <= target.data.size());
+        memcpy(target.data.data() + pWrites[i].offset, pWrites[i].pData, pWrites[i].size);
+        m_Stats.bytesWritten += pWrites[i].size;
+    }
+    ++m_Stats.bufferWrites;
+}
+
+// 设备和录制上下文的绑定/绘制只做计数
+static void CountDraw(RenderDeviceStats& stats, uint32_t indexCount, uint32_t instanceCount)
+{
+    ++stats.drawCalls;
+    stats.indicesDrawn += static_cast<uint64_t>(indexCount) * instanceCount;
+    stats.instancesDrawn += instanceCount;
+}
+
+void NullRenderDevice::SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+    const uint32_t* pStrides, const uint32_t* pOffsets)
+{
+    (void)startSlot; (void)pBuffers; (void)pStrides; (void)pOffsets;
+    m_Stats.vertexBufferBinds += count;
+}
+
+void NullRenderDevice::SetIndexBuffer(BufferHandle buffer)
+{
+    (void)buffer;
+    ++m_Stats.indexBufferBinds;
+}
+
+void NullRenderDevice::SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+    uint32_t firstConstant, uint32_t numConstants)
+{
+    (void)slot; (void)buffer; (void)firstConstant; (void)numConstants;
+    ++m_Stats.constantBufferBinds;
+}
+
+void NullRenderDevice::SetVertexFormat(VertexFormat format)
+{
+    (void)format;
+    ++m_Stats.vertexFormatBinds;
+}
+
+void NullRenderDevice::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+    uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+    (void)startIndex; (void)baseVertex; (void)startInstance;
+    CountDraw(m_Stats, indexCount, instanceCount);
+}
+
+void NullRenderDevice::Context::SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+    const uint32_t* pStrides, const uint32_t* pOffsets)
+{
+    (void)startSlot; (void)pBuffers; (void)pStrides; (void)pOffsets;
+    stats.vertexBufferBinds += count;
+}
+
+void NullRenderDevice::Context::SetIndexBuffer(BufferHandle buffer)
+{
+    (void)buffer;
+    ++stats.indexBufferBinds;
+}
+
+void NullRenderDevice::Context::SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+    uint32_t firstConstant, uint32_t numConstants)
+{
+    (void)slot; (void)buffer; (void)firstConstant; (void)numConstants;
+    ++stats.constantBufferBinds;
+}
+
+void NullRenderDevice::Context::SetVertexFormat(VertexFormat format)
+{
+    (void)format;
+    ++stats.vertexFormatBinds;
+}
+
+void NullRenderDevice::Context::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+    uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+    (void)startIndex; (void)baseVertex; (void)startInstance;
+    CountDraw(stats, indexCount, instanceCount);
+}
+
+void NullRenderDevice::Clear(const float color[4])
+{
+    (void)color;
+    if (!m_RenderTargets)
+        ++m_ClearsWithoutTargets;
+}
+
+void NullRenderDevice::Present()
+{
+    ++m_Stats.presents;
+}
+
+void NullRenderDevice::ReleaseRenderTargets()
+{
+    m_RenderTargets = false;
+}
+
+bool NullRenderDevice::ResizeBuffers(uint32_t width, uint32_t height)
+{
+    if (m_RenderTargets)
+    {
+        ++m_ResizeFailures;
+        return false;
+    }
+    m_Width = width;
+    m_Height = height;
+    return true;
+}
+
+void NullRenderDevice::SetRenderTargets()
+{
+    m_RenderTargets = true;
+}
+
+bool NullRenderDevice::HasRenderTargets() const
+{
+    return m_RenderTargets;
+}
+
+uint32_t NullRenderDevice::GetWidth() const
+{
+    return m_Width;
+}
+
+uint32_t NullRenderDevice::GetHeight() const
+{
+    return m_Height;
+}
+
+uint32_t NullRenderDevice::GetResizeFailures() const
+{
+    return m_ResizeFailures;
+}
+
+uint32_t NullRenderDevice::GetClearsWithoutTargets() const
+{
+    return m_ClearsWithoutTargets;
+}
+
+void NullRenderDevice::InsertFence(uint64_t fence)
+{
+    assert(fence > m_CompletedFence);
+    m_CompletedFence = fence;
+}
+
+uint64_t NullRenderDevice::GetCompletedFence()
+{
+    return m_CompletedFence;
+}
+
+bool NullRenderDevice::SupportsConstantBufferOffsets() const
+{
+    return m_ConstantBufferOffsets;
+}
+
+void NullRenderDevice::SetSupportsConstantBufferOffsets(bool supported)
+{
+    m_ConstantBufferOffsets = supported;
+}
+
+uint32_t NullRenderDevice::GetMaxCommandContexts() const
+{
+    return m_MaxCommandContexts;
+}
+
+CommandContext* NullRenderDevice::BeginCommandContext(uint32_t index)
+{
+    assert(index < m_MaxCommandContexts);
+    while (m_Contexts.size() <= index)
+        m_Contexts.emplace_back(new Context());
+    m_Contexts[index]->stats.Reset();
+    return m_Contexts[index].get();
+}
+
+void NullRenderDevice::EndCommandContext(uint32_t index)
+{
+    assert(index < m_Contexts.size());
+    (void)index;
+}
+
+void NullRenderDevice::ExecuteCommandContexts(uint32_t count)
+{
+    assert(count <= m_Contexts.size());
+    for (uint32_t i = 0; i < count; ++i)
+        m_Stats.AddCommands(m_Contexts[i]->stats);
+}
+
+void NullRenderDevice::SetMaxCommandContexts(uint32_t count)
+{
+    m_MaxCommandContexts = count;
+}
+
+const BufferDesc& NullRenderDevice::GetBufferDesc(BufferHandle buffer) const
+{
+    assert(buffer != kInvalidBuffer && buffer <= m_Buffers.size());
+    return m_Buffers[buffer - 1].desc;
+}
+
+const uint8_t* NullRenderDevice::GetBufferData(BufferHandle buffer) const
+{
+    assert(buffer != kInvalidBuffer && buffer <= m_Buffers.size());
+    return m_Buffers[buffer - 1].data.data();
+}
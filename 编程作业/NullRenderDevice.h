@@ -0,0 +1,104 @@
+//***************************************************************************************
+// NullRenderDevice.h
+//
+// 空渲染设备：不访问 GPU，只统计调用次数与字节数。
+// 缓冲内容保存在内存中（写入时照常拷贝），使 CPU 端的开销与实际提交接近。
+// fence 插入后立即视为完成。命令上下文只统计，执行时把计数合并到设备。
+// 交换链只模拟大小和渲染目标的持有：渲染目标没有释放时 ResizeBuffers 失败，与 DXGI 相同。
+//***************************************************************************************
+
+#ifndef NULLRENDERDEVICE_H
+#define NULLRENDERDEVICE_H
+
+#include "RenderDevice.h"
+#include <memory>
+#include <vector>
+
+class NullRenderDevice : public RenderDevice
+{
+public:
+    NullRenderDevice();
+
+    BufferHandle CreateBuffer(const BufferDesc& desc, const void* pInitData) override;
+    void WriteBuffer(BufferHandle buffer, MapMode mode, const BufferWrite* pWrites, uint32_t writeCount) override;
+    using RenderDevice::WriteBuffer;
+
+    void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+        const uint32_t* pStrides, const uint32_t* pOffsets) override;
+    void SetIndexBuffer(BufferHandle buffer) override;
+    void SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+        uint32_t firstConstant = 0, uint32_t numConstants = 0) override;
+    void SetVertexFormat(VertexFormat format) override;
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+        uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+
+    void Clear(const float color[4]) override;
+    void Present() override;
+    void ReleaseRenderTargets() override;
+
+    // ==== 交换链模拟 ====
+    // 渲染目标仍被持有时返回 false 并计入 GetResizeFailures，对应 DXGI_ERROR_INVALID_CALL
+    bool ResizeBuffers(uint32_t width, uint32_t height);
+    // 重新取得后备缓冲并设置为渲染目标（构造后已设置）
+    void SetRenderTargets();
+    bool HasRenderTargets() const;
+    uint32_t GetWidth() const;
+    uint32_t GetHeight() const;
+    uint32_t GetResizeFailures() const;
+    // 没有渲染目标时执行的 Clear 次数（调整大小后忘记重新设置渲染目标）
+    uint32_t GetClearsWithoutTargets() const;
+
+    void InsertFence(uint64_t fence) override;
+    uint64_t GetCompletedFence() override;
+
+    bool SupportsConstantBufferOffsets() const override;
+    void SetSupportsConstantBufferOffsets(bool supported);
+
+    uint32_t GetMaxCommandContexts() const override;
+    CommandContext* BeginCommandContext(uint32_t index) override;
+    void EndCommandContext(uint32_t index) override;
+    void ExecuteCommandContexts(uint32_t count) override;
+    void SetMaxCommandContexts(uint32_t count);     // 0 表示不支持并行录制
+
+    // 读取缓冲当前内容（用于比较不同提交方式的结果）
+    const BufferDesc& GetBufferDesc(BufferHandle buffer) const;
+    const uint8_t* GetBufferData(BufferHandle buffer) const;
+
+private:
+    struct Buffer
+    {
+        BufferDesc desc;
+        std::vector<uint8_t> data;
+    };
+
+    // 录制用的上下文：只累加自己的计数
+    class Context : public CommandContext
+    {
+    public:
+        void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+            const uint32_t* pStrides, const uint32_t* pOffsets) override;
+        void SetIndexBuffer(BufferHandle buffer) override;
+        void SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+            uint32_t firstConstant = 0, uint32_t numConstants = 0) override;
+        void SetVertexFormat(VertexFormat format) override;
+        void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+            uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+
+        RenderDeviceStats stats;
+    };
+
+    Buffer& GetBuffer(BufferHandle buffer);
+
+    std::vector<Buffer> m_Buffers;          // 句柄 - 1 即下标
+    uint64_t m_CompletedFence = 0;
+    bool m_ConstantBufferOffsets = true;
+    bool m_RenderTargets = true;
+    uint32_t m_Width = 1;
+    uint32_t m_Height = 1;
+    uint32_t m_ResizeFailures = 0;
+    uint32_t m_ClearsWithoutTargets = 0;
+    uint32_t m_MaxCommandContexts = 8;
+    std::vector<std::unique_ptr<Context>> m_Contexts;
+};
+
+#endif
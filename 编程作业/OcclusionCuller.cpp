@@ -0,0 +1,553 @@
+#include "OcclusionCuller.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define OCCLUSION_CULLER_SSE 1
+#include <xmmintrin.h>
+#endif
+
+static_assert(OcclusionCuller::kWidth % 4 == 0, "每行按 4 个像素一组处理");
+
+// 裁剪空间 w 的下限：更靠近相机的顶点视为跨越近平面
+static const float kMinW = 1e-4f;
+
+// 行向量约定：out = [x y z 1] * m
+static inline void TransformPoint(const float m[16], float x, float y, float z, float out[4])
+{
+    for (int c = 0; c < 4; ++c)
+        out[c] = x * m[c] + y * m[4 + c] + z * m[8 + c] + m[12 + c];
+}
+
+struct ScreenPoint
+{
+    float x, y;
+};
+
+// (a - o) × (b - o)，凸包中逆时针转向为正
+static inline float Cross(const ScreenPoint& o, const ScreenPoint& a, const ScreenPoint& b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+OcclusionCuller::OcclusionCuller()
+{
+    memset(m_ViewProj, 0, sizeof(m_ViewProj));
+
+    // 层次 Z 每级尺寸减半，直到 1×1
+    int offset = 0;
+    int w = kWidth, h = kHeight;
+    for (;;)
+    {
+        m_LevelOffset.push_back(offset);
+        m_LevelWidth.push_back(w);
+        m_LevelHeight.push_back(h);
+        offset += w * h;
+        if (w == 1 && h == 1)
+            break;
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    m_HiZ.assign(offset, 1.0f);
+}
+
+void OcclusionCuller::Begin(const float viewProj[16])
+{
+    memcpy(m_ViewProj, viewProj, sizeof(m_ViewProj));
+    std::fill(m_HiZ.begin(), m_HiZ.begin() + kWidth * kHeight, 1.0f);
+    m_Stats = Stats();
+}
+
+void OcclusionCuller::RasterizeMesh(const void* pPositions, uint32_t stride, uint32_t vertexCount,
+    const uint16_t* pIndices, uint32_t indexCount, const float world[16])
+{
+    float m[16];
+    ComputeWorldViewProj(world, m);
+
+    // 先把所有顶点变换到屏幕空间（像素坐标 + [0, 1] 深度）
+    m_Transformed.resize(static_cast<size_t>(vertexCount) * 3);
+    const uint8_t* pVertex = static_cast<const uint8_t*>(pPositions);
+    for (uint32_t i = 0; i < vertexCount; ++i, pVertex += stride)
+    {
+        float pos[3], clip[4];
+        memcpy(pos, pVertex, sizeof(pos));
+        TransformPoint(m, pos[0], pos[1], pos[2], clip);
+
+        float* out = &m_Transformed[i * 3];
+        if (clip[3] < kMinW || clip[2] < 0.0f)
+        {
+            out[0] = out[1] = 0.0f;
+            out[2] = -1.0f;
+            continue;
+        }
+        float invW = 1.0f / clip[3];
+        out[0] = (clip[0] * invW * 0.5f + 0.5f) * kWidth;
+        out[1] = (0.5f - clip[1] * invW * 0.5f) * kHeight;
+        out[2] = clip[2] * invW;
+    }
+
+    for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        ++m_Stats.occluderTriangles;
+        const float* v0 = &m_Transformed[pIndices[i] * 3];
+        const float* v1 = &m_Transformed[pIndices[i + 1] * 3];
+        const float* v2 = &m_Transformed[pIndices[i + 2] * 3];
+        // 跨越近平面的三角形直接跳过：少画遮挡体只会少剔除，不会出错
+        if (v0[2] < 0.0f || v1[2] < 0.0f || v2[2] < 0.0f)
+            continue;
+        RasterizeTriangle(v0, v1, v2);
+    }
+}
+
+void OcclusionCuller::ComputeWorldViewProj(const float world[16], float out[16]) const
+{
+    // world * viewProj
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c)
+            out[r * 4 + c] = world[r * 4 + 0] * m_ViewProj[0 * 4 + c] + world[r * 4 + 1] * m_ViewProj[1 * 4 + c]
+                + world[r * 4 + 2] * m_ViewProj[2 * 4 + c] + world[r * 4 + 3] * m_ViewProj[3 * 4 + c];
+}
+
+void OcclusionCuller::RasterizeTriangle(const float v0[3], const float v1[3], const float v2[3])
+{
+    float area = (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v1[1] - v0[1]) * (v2[0] - v0[0]);
+    if (std::fabs(area) < 1e-6f)
+        return;
+    // 统一成内部为正的顶点顺序，正反面都作为遮挡体
+    if (area < 0.0f)
+    {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // 包围盒，左边界按 4 像素对齐
+    int x0 = static_cast<int>(std::floor(std::min(v0[0], std::min(v1[0], v2[0]))));
+    int x1 = static_cast<int>(std::ceil(std::max(v0[0], std::max(v1[0], v2[0]))));
+    int y0 = static_cast<int>(std::floor(std::min(v0[1], std::min(v1[1], v2[1]))));
+    int y1 = static_cast<int>(std::ceil(std::max(v0[1], std::max(v1[1], v2[1]))));
+    x0 = std::max(x0, 0) & ~3;
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, kWidth - 1);
+    y1 = std::min(y1, kHeight - 1);
+    if (x0 > x1 || y0 > y1)
+        return;
+    ++m_Stats.rasterizedTriangles;
+
+    // 边函数 E(p) = A * x + B * y + C，内部为正，像素中心 E >= 0 时写入
+    // （若要求整个像素都在内部，相邻三角形的公共边上会留下一串永远不写入的像素）
+    const float* v[3] = { v0, v1, v2 };
+    float A[3], B[3], C[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        const float* a = v[k];
+        const float* b = v[(k + 1) % 3];
+        A[k] = -(b[1] - a[1]);
+        B[k] = b[0] - a[0];
+        C[k] = -(A[k] * a[0] + B[k] * a[1]);
+    }
+
+    // 深度平面，写入像素内的最大深度（且不超过三个顶点的最大深度）
+    float dzdx = ((v1[2] - v0[2]) * (v2[1] - v0[1]) - (v2[2] - v0[2]) * (v1[1] - v0[1])) / area;
+    float dzdy = ((v2[2] - v0[2]) * (v1[0] - v0[0]) - (v1[2] - v0[2]) * (v2[0] - v0[0])) / area;
+    float zBias = 0.5f * (std::fabs(dzdx) + std::fabs(dzdy));
+    float zMax = std::max(v0[2], std::max(v1[2], v2[2]));
+    float zBase = v0[2] - dzdx * v0[0] - dzdy * v0[1] + zBias;
+
+    float* pDepth = m_HiZ.data();
+    for (int y = y0; y <= y1; ++y)
+    {
+        float cy = y + 0.5f;
+        float rowE[3];
+        for (int k = 0; k < 3; ++k)
+            rowE[k] = B[k] * cy + C[k];
+        float rowZ = zBase + dzdy * cy;
+        float* pRow = pDepth + y * kWidth;
+
+#if defined(OCCLUSION_CULLER_SSE)
+        __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        __m128 vA0 = _mm_set1_ps(A[0]), vA1 = _mm_set1_ps(A[1]), vA2 = _mm_set1_ps(A[2]);
+        __m128 vE0 = _mm_set1_ps(rowE[0]), vE1 = _mm_set1_ps(rowE[1]), vE2 = _mm_set1_ps(rowE[2]);
+        __m128 zero = _mm_setzero_ps();
+        __m128 vDzdx = _mm_set1_ps(dzdx), vRowZ = _mm_set1_ps(rowZ), vZMax = _mm_set1_ps(zMax);
+        for (int x = x0; x <= x1; x += 4)
+        {
+            __m128 cx = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+            __m128 inside = _mm_and_ps(
+                _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(vA0, cx), vE0), zero),
+                           _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(vA1, cx), vE1), zero)),
+                _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(vA2, cx), vE2), zero));
+            if (_mm_movemask_ps(inside) == 0)
+                continue;
+
+            __m128 z = _mm_min_ps(_mm_add_ps(_mm_mul_ps(vDzdx, cx), vRowZ), vZMax);
+            __m128 depth = _mm_loadu_ps(pRow + x);
+            __m128 closer = _mm_min_ps(depth, z);
+            depth = _mm_or_ps(_mm_and_ps(inside, closer), _mm_andnot_ps(inside, depth));
+            _mm_storeu_ps(pRow + x, depth);
+        }
+#else
+        for (int x = x0; x <= x1; ++x)
+        {
+            float cx = x + 0.5f;
+            if (A[0] * cx + rowE[0] < 0.0f || A[1] * cx + rowE[1] < 0.0f || A[2] * cx + rowE[2] < 0.0f)
+                continue;
+            float z = std::min(dzdx * cx + rowZ, zMax);
+            pRow[x] = std::min(pRow[x], z);
+        }
+#endif
+    }
+}
+
+// ==== 内部盒子 ====
+void OcclusionCuller::BuildInnerBoxes(const void* pPositions, uint32_t stride, uint32_t vertexCount,
+    const uint16_t* pIndices, uint32_t indexCount, std::vector<Box>& boxes, int resolution, int maxBoxes)
+{
+    boxes.clear();
+    const uint32_t triangleCount = indexCount / 3;
+    if (vertexCount == 0 || triangleCount == 0 || resolution < 1 || maxBoxes < 1)
+        return;
+
+    // 展开三角形顶点，同时求被引用顶点的包围盒
+    std::vector<float> corners(static_cast<size_t>(triangleCount) * 9);
+    float lo[3] = { 1e30f, 1e30f, 1e30f }, hi[3] = { -1e30f, -1e30f, -1e30f };
+    const uint8_t* pBase = static_cast<const uint8_t*>(pPositions);
+    for (uint32_t i = 0; i < triangleCount * 3; ++i)
+    {
+        assert(pIndices[i] < vertexCount);
+        float* p = &corners[i * 3];
+        memcpy(p, pBase + static_cast<size_t>(pIndices[i]) * stride, sizeof(float) * 3);
+        for (int k = 0; k < 3; ++k)
+        {
+            lo[k] = std::min(lo[k], p[k]);
+            hi[k] = std::max(hi[k], p[k]);
+        }
+    }
+    const int n = resolution;
+    float size[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        size[k] = (hi[k] - lo[k]) / n;
+        if (!(size[k] > 0.0f))
+            return;             // 扁平网格没有内部
+    }
+    auto CellIndex = [n](int x, int y, int z) { return (static_cast<size_t>(z) * n + y) * n + x; };
+
+    // 与三角形包围盒相交的格子都算边界（比真正相交的多，只会少生成盒子）
+    std::vector<uint8_t> boundary(static_cast<size_t>(n) * n * n, 0);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        const float* v = &corners[t * 9];
+        int c0[3], c1[3];
+        for (int k = 0; k < 3; ++k)
+        {
+            const float tMin = std::min(v[k], std::min(v[3 + k], v[6 + k]));
+            const float tMax = std::max(v[k], std::max(v[3 + k], v[6 + k]));
+            c0[k] = std::max(0, static_cast<int>(std::floor((tMin - lo[k]) / size[k] - 1e-3f)));
+            c1[k] = std::min(n - 1, static_cast<int>(std::floor((tMax - lo[k]) / size[k] + 1e-3f)));
+        }
+        for (int z = c0[2]; z <= c1[2]; ++z)
+            for (int y = c0[1]; y <= c1[1]; ++y)
+                for (int x = c0[0]; x <= c1[0]; ++x)
+                    boundary[CellIndex(x, y, z)] = 1;
+    }
+
+    // 沿三个轴各发一组射线（每行格子一条，穿过格子内部），交点个数为奇数的格子在内部。
+    // 射线恰好擦过三角形的边或顶点时在格子内稍微挪动射线重试，几次都擦边则这一行不投票
+    static const float kRayOffsets[4][2] = { { 0.0f, 0.0f }, { 0.113f, 0.071f }, { -0.087f, 0.129f }, { 0.053f, -0.141f } };
+    std::vector<uint8_t> votes(boundary.size(), 0);
+    std::vector<float> hits;
+    for (int a = 0; a < 3; ++a)
+    {
+        const int b = (a + 1) % 3, c = (a + 2) % 3;
+        for (int j = 0; j < n; ++j)
+        {
+            for (int k = 0; k < n; ++k)
+            {
+                bool ambiguous = true;
+                for (int attempt = 0; attempt < 4 && ambiguous; ++attempt)
+                {
+                    const float pb = lo[b] + (j + 0.5f + kRayOffsets[attempt][0]) * size[b];
+                    const float pc = lo[c] + (k + 0.5f + kRayOffsets[attempt][1]) * size[c];
+                    hits.clear();
+                    ambiguous = false;
+                    for (uint32_t t = 0; t < triangleCount && !ambiguous; ++t)
+                    {
+                        const float* v0 = &corners[t * 9];
+                        const float* v1 = v0 + 3;
+                        const float* v2 = v0 + 6;
+                        if (std::max(v0[b], std::max(v1[b], v2[b])) < pb || std::min(v0[b], std::min(v1[b], v2[b])) > pb
+                            || std::max(v0[c], std::max(v1[c], v2[c])) < pc || std::min(v0[c], std::min(v1[c], v2[c])) > pc)
+                            continue;
+                        // 投影到 (b, c) 平面后的边函数，同号为穿过，有 0 为擦边
+                        const float e0 = (v2[b] - v1[b]) * (pc - v1[c]) - (v2[c] - v1[c]) * (pb - v1[b]);
+                        const float e1 = (v0[b] - v2[b]) * (pc - v2[c]) - (v0[c] - v2[c]) * (pb - v2[b]);
+                        const float e2 = (v1[b] - v0[b]) * (pc - v0[c]) - (v1[c] - v0[c]) * (pb - v0[b]);
+                        const float sum = e0 + e1 + e2;
+                        if (sum == 0.0f)
+                            continue;       // 三角形与射线平行
+                        const bool positive = e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f;
+                        const bool negative = e0 <= 0.0f && e1 <= 0.0f && e2 <= 0.0f;
+                        if (!positive && !negative)
+                            continue;
+                        if (e0 == 0.0f || e1 == 0.0f || e2 == 0.0f)
+                            ambiguous = true;
+                        else
+                            hits.push_back((e0 * v0[a] + e1 * v1[a] + e2 * v2[a]) / sum);
+                    }
+                }
+                if (ambiguous)
+                    continue;
+                std::sort(hits.begin(), hits.end());
+                for (int i = 0; i < n; ++i)
+                {
+                    const float center = lo[a] + (i + 0.5f) * size[a];
+                    const size_t beyond = hits.end() - std::upper_bound(hits.begin(), hits.end(), center);
+                    if (beyond % 2 == 0)
+                        continue;
+                    int cell[3];
+                    cell[a] = i;
+                    cell[b] = j;
+                    cell[c] = k;
+                    ++votes[CellIndex(cell[0], cell[1], cell[2])];
+                }
+            }
+        }
+    }
+
+    // 不与表面相交、其中一点在内部的格子整个在内部
+    std::vector<uint8_t> solid(boundary.size());
+    for (size_t i = 0; i < solid.size(); ++i)
+        solid[i] = !boundary[i] && votes[i] == 3;
+    // 每次取当前能放下的最大盒子：从每个内部格子出发轮流沿 +x、+y、+z 扩展一层，
+    // 区域是否全部在内部用求和体积表 O(1) 判断；选中后清掉这些格子再找下一个
+    const int m = n + 1;
+    std::vector<int> sum(static_cast<size_t>(m) * m * m);
+    auto SumAt = [&](int x, int y, int z) -> int& { return sum[(static_cast<size_t>(z) * m + y) * m + x]; };
+    auto SolidCount = [&](const int b[3], const int e[3])
+    {
+        return SumAt(e[0], e[1], e[2]) - SumAt(b[0], e[1], e[2]) - SumAt(e[0], b[1], e[2]) - SumAt(e[0], e[1], b[2])
+            + SumAt(b[0], b[1], e[2]) + SumAt(b[0], e[1], b[2]) + SumAt(e[0], b[1], b[2]) - SumAt(b[0], b[1], b[2]);
+    };
+    for (int found = 0; found < maxBoxes; ++found)
+    {
+        for (int z = 0; z < n; ++z)
+            for (int y = 0; y < n; ++y)
+                for (int x = 0; x < n; ++x)
+                    SumAt(x + 1, y + 1, z + 1) = solid[CellIndex(x, y, z)] + SumAt(x, y + 1, z + 1)
+                        + SumAt(x + 1, y, z + 1) + SumAt(x + 1, y + 1, z) - SumAt(x, y, z + 1) - SumAt(x, y + 1, z)
+                        - SumAt(x + 1, y, z) + SumAt(x, y, z);
+
+        int bestVolume = 0, bestBegin[3] = {}, bestEnd[3] = {};
+        for (int z = 0; z < n; ++z)
+            for (int y = 0; y < n; ++y)
+                for (int x = 0; x < n; ++x)
+                {
+                    if (!solid[CellIndex(x, y, z)])
+                        continue;
+                    const int begin[3] = { x, y, z };
+                    int end[3] = { x + 1, y + 1, z + 1 };
+                    for (bool grown = true; grown; )
+                    {
+                        grown = false;
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            if (end[k] == n)
+                                continue;
+                            int next[3] = { end[0], end[1], end[2] };
+                            ++next[k];
+                            if (SolidCount(begin, next) == (next[0] - x) * (next[1] - y) * (next[2] - z))
+                            {
+                                end[k] = next[k];
+                                grown = true;
+                            }
+                        }
+                    }
+                    const int volume = (end[0] - x) * (end[1] - y) * (end[2] - z);
+                    if (volume > bestVolume)
+                    {
+                        bestVolume = volume;
+                        memcpy(bestBegin, begin, sizeof(begin));
+                        memcpy(bestEnd, end, sizeof(end));
+                    }
+                }
+        if (bestVolume == 0)
+            break;
+
+        Box box;
+        for (int k = 0; k < 3; ++k)
+        {
+            box.min[k] = lo[k] + bestBegin[k] * size[k];
+            box.max[k] = lo[k] + bestEnd[k] * size[k];
+        }
+        boxes.push_back(box);
+        for (int z = bestBegin[2]; z < bestEnd[2]; ++z)
+            for (int y = bestBegin[1]; y < bestEnd[1]; ++y)
+                for (int x = bestBegin[0]; x < bestEnd[0]; ++x)
+                    solid[CellIndex(x, y, z)] = 0;
+    }
+}
+
+void OcclusionCuller::RasterizeBox(const Box& box, const float world[16])
+{
+    ++m_Stats.occluderBoxes;
+    float m[16];
+    ComputeWorldViewProj(world, m);
+
+    // 8 个角变换到屏幕空间；盒子是凸的，任一像素内最远的点不超过最远的角
+    ScreenPoint points[8];
+    float zFar = 0.0f;
+    for (int i = 0; i < 8; ++i)
+    {
+        float clip[4];
+        TransformPoint(m, (i & 1) ? box.max[0] : box.min[0], (i & 2) ? box.max[1] : box.min[1],
+            (i & 4) ? box.max[2] : box.min[2], clip);
+        if (clip[3] < kMinW || clip[2] < 0.0f)
+            return;
+        float invW = 1.0f / clip[3];
+        points[i].x = (clip[0] * invW * 0.5f + 0.5f) * kWidth;
+        points[i].y = (0.5f - clip[1] * invW * 0.5f) * kHeight;
+        zFar = std::max(zFar, clip[2] * invW);
+    }
+
+    // 投影区域是 8 个角的凸包（单调链），边函数内部为正
+    std::sort(points, points + 8, [](const ScreenPoint& l, const ScreenPoint& r)
+        { return l.x < r.x || (l.x == r.x && l.y < r.y); });
+    ScreenPoint hull[16];
+    int hullSize = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        while (hullSize >= 2 && Cross(hull[hullSize - 2], hull[hullSize - 1], points[i]) <= 0.0f)
+            --hullSize;
+        hull[hullSize++] = points[i];
+    }
+    for (int i = 6, lower = hullSize + 1; i >= 0; --i)
+    {
+        while (hullSize >= lower && Cross(hull[hullSize - 2], hull[hullSize - 1], points[i]) <= 0.0f)
+            --hullSize;
+        hull[hullSize++] = points[i];
+    }
+    --hullSize;             // 最后一个点与第一个相同
+    if (hullSize < 3)
+        return;
+
+    // 只写入整个像素都在凸包内的像素：像素内边函数的最小值 E(中心) - (|A| + |B|) / 2 >= 0
+    float A[8], B[8], C[8], margin[8];
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+    for (int k = 0; k < hullSize; ++k)
+    {
+        const ScreenPoint& a = hull[k];
+        const ScreenPoint& b = hull[(k + 1) % hullSize];
+        A[k] = -(b.y - a.y);
+        B[k] = b.x - a.x;
+        C[k] = -(A[k] * a.x + B[k] * a.y);
+        margin[k] = 0.5f * (std::fabs(A[k]) + std::fabs(B[k]));
+        minX = std::min(minX, a.x); maxX = std::max(maxX, a.x);
+        minY = std::min(minY, a.y); maxY = std::max(maxY, a.y);
+    }
+    const int x0 = std::max(0, static_cast<int>(std::ceil(minX)));
+    const int x1 = std::min(kWidth - 1, static_cast<int>(std::floor(maxX)) - 1);
+    const int y0 = std::max(0, static_cast<int>(std::ceil(minY)));
+    const int y1 = std::min(kHeight - 1, static_cast<int>(std::floor(maxY)) - 1);
+    if (x0 > x1 || y0 > y1)
+        return;
+    ++m_Stats.rasterizedBoxes;
+
+    float* pDepth = m_HiZ.data();
+    for (int y = y0; y <= y1; ++y)
+    {
+        const float cy = y + 0.5f;
+        float* pRow = pDepth + y * kWidth;
+        for (int x = x0; x <= x1; ++x)
+        {
+            const float cx = x + 0.5f;
+            bool inside = true;
+            for (int k = 0; k < hullSize && inside; ++k)
+                inside = A[k] * cx + B[k] * cy + C[k] >= margin[k];
+            if (inside)
+                pRow[x] = std::min(pRow[x], zFar);
+        }
+    }
+}
+
+void OcclusionCuller::BuildHiZ()
+{
+    for (size_t level = 1; level < m_LevelOffset.size(); ++level)
+    {
+        const float* pSrc = m_HiZ.data() + m_LevelOffset[level - 1];
+        float* pDst = m_HiZ.data() + m_LevelOffset[level];
+        const int srcW = m_LevelWidth[level - 1], srcH = m_LevelHeight[level - 1];
+        const int dstW = m_LevelWidth[level], dstH = m_LevelHeight[level];
+
+        // 每个像素取下一级对应 2×2（边上可能只有 1 个）的最大深度
+        for (int y = 0; y < dstH; ++y)
+            for (int x = 0; x < dstW; ++x)
+            {
+                int sx0 = x * 2, sx1 = std::min(x * 2 + 1, srcW - 1);
+                int sy0 = y * 2, sy1 = std::min(y * 2 + 1, srcH - 1);
+                float d = std::max(std::max(pSrc[sy0 * srcW + sx0], pSrc[sy0 * srcW + sx1]),
+                    std::max(pSrc[sy1 * srcW + sx0], pSrc[sy1 * srcW + sx1]));
+                pDst[y * dstW + x] = d;
+            }
+    }
+}
+
+bool OcclusionCuller::IsSphereOccluded(float x, float y, float z, float r)
+{
+    ++m_Stats.spheresTested;
+
+    // 用包围盒的 8 个角求屏幕范围和最近深度；任何一个角在近平面前都视为可见
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f, minZ = 1e30f;
+    for (int i = 0; i < 8; ++i)
+    {
+        float clip[4];
+        TransformPoint(m_ViewProj, (i & 1) ? x + r : x - r, (i & 2) ? y + r : y - r, (i & 4) ? z + r : z - r, clip);
+        if (clip[3] < kMinW || clip[2] < 0.0f)
+            return false;
+        float invW = 1.0f / clip[3];
+        float sx = (clip[0] * invW * 0.5f + 0.5f) * kWidth;
+        float sy = (0.5f - clip[1] * invW * 0.5f) * kHeight;
+        minX = std::min(minX, sx); maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy); maxY = std::max(maxY, sy);
+        minZ = std::min(minZ, clip[2] * invW);
+    }
+
+    int px0 = std::max(0, static_cast<int>(std::floor(minX)));
+    int px1 = std::min(kWidth - 1, static_cast<int>(std::floor(maxX)));
+    int py0 = std::max(0, static_cast<int>(std::floor(minY)));
+    int py1 = std::min(kHeight - 1, static_cast<int>(std::floor(maxY)));
+    if (px0 > px1 || py0 > py1)
+        return false;       // 屏幕外的物体交给视锥剔除
+
+    // 选择覆盖范围不超过 2×2 个像素的层级
+    int level = 0;
+    const int maxLevel = static_cast<int>(m_LevelOffset.size()) - 1;
+    while (level < maxLevel && ((px1 >> level) - (px0 >> level) > 1 || (py1 >> level) - (py0 >> level) > 1))
+        ++level;
+
+    const float* pLevel = m_HiZ.data() + m_LevelOffset[level];
+    const int w = m_LevelWidth[level];
+    float maxDepth = 0.0f;
+    for (int ty = py0 >> level; ty <= (py1 >> level); ++ty)
+        for (int tx = px0 >> level; tx <= (px1 >> level); ++tx)
+            maxDepth = std::max(maxDepth, pLevel[ty * w + tx]);
+
+    bool occluded = minZ > maxDepth;
+    if (occluded)
+        ++m_Stats.spheresOccluded;
+    return occluded;
+}
+
+const OcclusionCuller::Stats& OcclusionCuller::GetStats() const
+{
+    return m_Stats;
+}
+
+const float* OcclusionCuller::GetDepth(int level, int* pWidth, int* pHeight) const
+{
+    assert(level >= 0 && level < static_cast<int>(m_LevelOffset.size()));
+    if (pWidth) *pWidth = m_LevelWidth[level];
+    if (pHeight) *pHeight = m_LevelHeight[level];
+    return m_HiZ.data() + m_LevelOffset[level];
+}
@@ -0,0 +1,84 @@
+//***************************************************************************************
+// OcclusionCuller.h
+//
+// CPU 软件遮挡剔除：把少量近处的遮挡体三角形光栅化到低分辨率深度缓冲，
+// 生成层次 Z（每级取 2×2 的最大深度），再用包围球在屏幕上的范围和最近深度
+// 测试其余物体是否被完全挡住。
+// 三角形按像素中心判断覆盖，只适合大块的实心面（墙、地面）：比像素窄的缝看不到。
+// 字这样由细笔画组成的网格改用内部盒子（BuildInnerBoxes）：盒子完全在网格内部，
+// 只写入投影完全覆盖的像素，深度取盒子最远的角，笔画间的缝无论多窄都不会被当成遮挡。
+// 深度取遮挡体在像素内的最大值，被测物体必须整体比遮挡体更远才会被剔除。
+// 有 SSE 时三角形一次处理 4 个像素。
+//***************************************************************************************
+
+#ifndef OCCLUSIONCULLER_H
+#define OCCLUSIONCULLER_H
+
+#include <cstdint>
+#include <vector>
+
+class OcclusionCuller
+{
+public:
+    static const int kWidth = 256;          // 必须是 4 的倍数和 2 的幂
+    static const int kHeight = 128;
+
+    struct Stats
+    {
+        uint32_t occluderTriangles = 0;     // 提交的遮挡体三角形
+        uint32_t rasterizedTriangles = 0;   // 实际光栅化的三角形（跨越近平面或退化的会跳过）
+        uint32_t occluderBoxes = 0;         // 提交的内部盒子
+        uint32_t rasterizedBoxes = 0;       // 实际光栅化的盒子（跨越近平面的会跳过）
+        uint32_t spheresTested = 0;
+        uint32_t spheresOccluded = 0;
+    };
+
+    // 网格局部坐标中的轴对齐盒子
+    struct Box
+    {
+        float min[3];
+        float max[3];
+    };
+
+public:
+    OcclusionCuller();
+
+    // 把封闭网格体素化为 resolution³ 个格子，合并完全在内部的格子，按体积从大到小保留 maxBoxes 个。
+    // 与三角形相交的格子不算内部；三个轴向的射线奇偶性都判为内部才算，网格不封闭时只会少生成盒子
+    static void BuildInnerBoxes(const void* pPositions, uint32_t stride, uint32_t vertexCount,
+        const uint16_t* pIndices, uint32_t indexCount, std::vector<Box>& boxes,
+        int resolution = 16, int maxBoxes = 8);
+
+    // 每帧开始：清空深度缓冲。viewProj 约定同 FrustumCuller::SetViewProj（行向量、行主序、深度 [0, 1]）
+    void Begin(const float viewProj[16]);
+    // 光栅化一个遮挡网格：pPositions 每 stride 字节一个 float3 位置，索引为网格内的 16 位编号
+    // world 为行向量约定的世界矩阵（行主序）
+    void RasterizeMesh(const void* pPositions, uint32_t stride, uint32_t vertexCount,
+        const uint16_t* pIndices, uint32_t indexCount, const float world[16]);
+    // 光栅化一个内部盒子（world 同上），只写入被盒子投影完全覆盖的像素
+    void RasterizeBox(const Box& box, const float world[16]);
+    // 所有遮挡体提交完毕后生成层次 Z
+    void BuildHiZ();
+
+    // 包围球是否被已光栅化的遮挡体完全挡住
+    bool IsSphereOccluded(float x, float y, float z, float r);
+
+    const Stats& GetStats() const;
+    // 调试用：第 level 级的深度（level 0 为全分辨率）
+    const float* GetDepth(int level, int* pWidth, int* pHeight) const;
+
+private:
+    void RasterizeTriangle(const float v0[3], const float v1[3], const float v2[3]);
+    void ComputeWorldViewProj(const float world[16], float out[16]) const;
+
+private:
+    float m_ViewProj[16];
+    std::vector<float> m_HiZ;               // 各级深度依次存放
+    std::vector<int> m_LevelOffset;
+    std::vector<int> m_LevelWidth;
+    std::vector<int> m_LevelHeight;
+    std::vector<float> m_Transformed;       // 当前网格变换到屏幕空间后的顶点 (x, y, z)，无效顶点 z 为 -1
+    Stats m_Stats;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "ParallelSubmitter.h"
+#include <algorithm>
+#include <cassert>
+
+void ParallelSubmitter::Split(const uint32_t* pItemWeights, uint32_t itemCount, uint32_t maxChunks, uint32_t minWeightPerChunk,
+    std::vector<Chunk>& chunks)
+{
+    chunks.clear();
+    if (itemCount == 0)
+        return;
+
+    auto weightOf = [pItemWeights](uint32_t item) -> uint64_t { return pItemWeights ? pItemWeights[item] : 1; };
+    uint64_t totalWeight = 0;
+    for (uint32_t i = 0; i < itemCount; ++i)
+        totalWeight += weightOf(i);
+    uint64_t chunkCount = totalWeight / std::max(1u, minWeightPerChunk);
+    chunkCount = std::max<uint64_t>(1, std::min<uint64_t>(chunkCount, std::min(maxChunks, itemCount)));
+
+    // 第 k 块在累计权重最接近 totalWeight * (k + 1) / chunkCount 的位置结束，且给后面的块各留至少一项；
+    // 权重都为 1 时各块大小最多相差 1
+    uint32_t first = 0;
+    uint64_t accumulated = 0;
+    for (uint64_t k = 0; k < chunkCount; ++k)
+    {
+        uint32_t end = itemCount;
+        if (k + 1 < chunkCount)
+        {
+            const uint64_t target = totalWeight * (k + 1) / chunkCount;
+            const uint32_t lastEnd = itemCount - static_cast<uint32_t>(chunkCount - k - 1);
+            end = first + 1;
+            accumulated += weightOf(first);
+            while (end < lastEnd && 2 * accumulated + weightOf(end) <= 2 * target)
+                accumulated += weightOf(end++);
+        }
+        chunks.push_back({ first, end - first });
+        first = end;
+    }
+    assert(first == itemCount);
+}
+
+uint32_t ParallelSubmitter::GetMaxChunks(const RenderDevice& device, const JobSystem* pJobSystem)
+{
+    if (!pJobSystem)
+        return 1;
+    return std::max(1u, std::min(device.GetMaxCommandContexts(), pJobSystem->GetWorkerCount() + 1));
+}
+
+uint32_t ParallelSubmitter::Submit(RenderDevice& device, JobSystem* pJobSystem, const uint32_t* pItemWeights,
+    uint32_t itemCount, uint32_t minWeightPerChunk, const RecordFunction& record)
+{
+    Split(pItemWeights, itemCount, GetMaxChunks(device, pJobSystem), minWeightPerChunk, m_Chunks);
+
+    if (m_Chunks.size() <= 1)
+    {
+        if (!m_Chunks.empty())
+            record(0, device, m_Chunks[0]);
+        return 0;
+    }
+
+    // 上下文在设备所在线程上开始录制，之后各块互不相关，可以在任意线程上录制和结束
+    const uint32_t chunkCount = static_cast<uint32_t>(m_Chunks.size());
+    m_Contexts.resize(chunkCount);
+    for (uint32_t i = 0; i < chunkCount; ++i)
+        m_Contexts[i] = device.BeginCommandContext(i);
+
+    pJobSystem->ParallelFor(0, chunkCount, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            record(i, *m_Contexts[i], m_Chunks[i]);
+            device.EndCommandContext(i);
+        }
+    });
+
+    // 按块的顺序执行，与录制完成的先后无关
+    device.ExecuteCommandContexts(chunkCount);
+    return chunkCount;
+}
+
+const std::vector<ParallelSubmitter::Chunk>& ParallelSubmitter::GetChunks() const
+{
+    return m_Chunks;
+}
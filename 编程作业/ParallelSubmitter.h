@@ -0,0 +1,54 @@
+//***************************************************************************************
+// ParallelSubmitter.h
+//
+// 并行提交：把排序后的绘制项按顺序切成连续的块（按权重均分，SceneRenderer 中权重为实例数），
+// 每块在设备的一个命令上下文上录制
+// （在任务系统的工作线程上进行），全部录制完后按块的顺序执行，绘制顺序与单线程提交相同。
+// 切块、调度和执行顺序都在这里，每块录制什么由调用方的回调决定；
+// 搭配 NullRenderDevice / CaptureRenderDevice 可以在没有 D3D 的环境下检查顺序。
+//***************************************************************************************
+
+#ifndef PARALLELSUBMITTER_H
+#define PARALLELSUBMITTER_H
+
+#include "RenderDevice.h"
+#include "JobSystem.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class ParallelSubmitter
+{
+public:
+    // 一块连续的绘制项
+    struct Chunk
+    {
+        uint32_t firstItem;
+        uint32_t itemCount;
+    };
+
+    // 在 context 上录制一块：需要的缓冲绑定由回调自己设置（命令上下文从空绑定开始）
+    typedef std::function<void(uint32_t chunkIndex, CommandContext& context, const Chunk& chunk)> RecordFunction;
+
+public:
+    // 把 itemCount 项按顺序切成不超过 maxChunks 块，各块的权重之和尽量相等（pItemWeights 为空时每项权重为 1）。
+    // 每块至少一项、权重至少 minWeightPerChunk，总权重不足时为 1 块
+    static void Split(const uint32_t* pItemWeights, uint32_t itemCount, uint32_t maxChunks, uint32_t minWeightPerChunk,
+        std::vector<Chunk>& chunks);
+    // 最多能同时录制的块数：调用线程在等待时也会录制，所以是 工作线程数 + 1，且不超过设备的命令上下文数
+    static uint32_t GetMaxChunks(const RenderDevice& device, const JobSystem* pJobSystem);
+
+    // 切块、并行录制并按顺序执行，返回使用的命令上下文数。
+    // 没有任务系统、设备不支持命令上下文或只切出一块时直接在设备上录制（返回 0）
+    uint32_t Submit(RenderDevice& device, JobSystem* pJobSystem, const uint32_t* pItemWeights, uint32_t itemCount,
+        uint32_t minWeightPerChunk, const RecordFunction& record);
+
+    // 最近一次 Submit 的切块结果
+    const std::vector<Chunk>& GetChunks() const;
+
+private:
+    std::vector<Chunk> m_Chunks;
+    std::vector<CommandContext*> m_Contexts;
+};
+
+#endif
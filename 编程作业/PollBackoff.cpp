@@ -0,0 +1,51 @@
+#include "PollBackoff.h"
+#include <algorithm>
+
+PollBackoff::PollBackoff(MonotonicClock& clock)
+    : m_pClock(&clock)
+{
+}
+
+void PollBackoff::Reset()
+{
+    m_Started = false;
+    m_SleepNs = kMinSleepNs;
+}
+
+void PollBackoff::Wait()
+{
+    ++m_Stats.waits;
+    uint64_t now = m_pClock->NowNs();
+    if (!m_Started)
+    {
+        m_Started = true;
+        m_StartNs = now;
+    }
+
+    // 自旋阶段：等一小段再让调用方轮询
+    if (now - m_StartNs < kSpinNs)
+    {
+        uint64_t spinStart = now;
+        uint64_t target = now + kSpinStepNs;
+        while (now < target)
+            now = m_pClock->NowNs();
+        m_Stats.spinNs += now - spinStart;
+        return;
+    }
+
+    // 睡眠阶段：等待越久，每次睡得越长
+    m_pClock->SleepNs(m_SleepNs);
+    ++m_Stats.sleeps;
+    m_Stats.sleepNs += m_pClock->NowNs() - now;
+    m_SleepNs = std::min(m_SleepNs * 2, kMaxSleepNs);
+}
+
+const PollBackoff::Stats& PollBackoff::GetStats() const
+{
+    return m_Stats;
+}
+
+void PollBackoff::ResetStats()
+{
+    m_Stats = Stats();
+}
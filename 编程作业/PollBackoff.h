@@ -0,0 +1,52 @@
+//***************************************************************************************
+// PollBackoff.h
+//
+// 轮询等待的退避：等待 GPU fence 这类只能轮询的条件时，每次轮询失败后调用 Wait。
+// 开始等待后的 kSpinNs 内按 kSpinStepNs 的间隔自旋（条件通常很快满足，醒来要及时）；
+// 超过后改为睡眠，睡眠时长从 kMinSleepNs 起每次翻倍，最多 kMaxSleepNs，把 CPU 让给其他线程。
+//***************************************************************************************
+
+#ifndef POLLBACKOFF_H
+#define POLLBACKOFF_H
+
+#include "MonotonicClock.h"
+#include <cstdint>
+
+class PollBackoff
+{
+public:
+    static const uint64_t kSpinNs = 50000;          // 开始等待后先自旋的时长
+    static const uint64_t kSpinStepNs = 2000;       // 自旋阶段两次轮询的间隔
+    static const uint64_t kMinSleepNs = 250000;
+    static const uint64_t kMaxSleepNs = 1000000;    // 与 FrameLimiter::kSleepQuantumNs 相同
+
+    // 自上次 ResetStats 以来的统计
+    struct Stats
+    {
+        uint32_t waits = 0;             // Wait 的调用次数（即失败的轮询次数）
+        uint32_t sleeps = 0;
+        uint64_t spinNs = 0;
+        uint64_t sleepNs = 0;
+    };
+
+public:
+    explicit PollBackoff(MonotonicClock& clock = MonotonicClock::GetSystemClock());
+
+    // 开始一次新的等待
+    void Reset();
+    // 一次轮询失败后调用：自旋或睡眠一段时间再返回，由调用方重新轮询
+    void Wait();
+
+    const Stats& GetStats() const;
+    void ResetStats();
+
+private:
+    MonotonicClock* m_pClock;
+    bool m_Started = false;
+    uint64_t m_StartNs = 0;             // 本次等待开始的时刻
+    uint64_t m_SleepNs = kMinSleepNs;   // 下一次睡眠的时长
+
+    Stats m_Stats;
+};
+
+#endif
@@ -0,0 +1,149 @@
+//***************************************************************************************
+// RenderDevice.h
+//
+// 渲染设备接口：场景提交只通过这里的缓冲创建/写入、绑定、绘制和帧 fence 完成。
+// D3D11RenderDevice 对应实际的 D3D11 调用，NullRenderDevice 只做计数，
+// 使场景更新与提交逻辑可以在没有 GPU 的环境下运行和测量。
+// 绑定和绘制也可以录制到独立的命令上下文（D3D11 中为延迟上下文），在多个线程上并行录制后按顺序执行。
+//***************************************************************************************
+
+#ifndef RENDERDEVICE_H
+#define RENDERDEVICE_H
+
+#include "VertexLayout.h"
+#include <cstdint>
+
+// 缓冲句柄，0 表示无效
+typedef uint32_t BufferHandle;
+static const BufferHandle kInvalidBuffer = 0;
+
+enum class BufferType : uint32_t
+{
+    Vertex,
+    Index,
+    Constant
+};
+
+enum class BufferUsage : uint32_t
+{
+    Immutable,      // 创建时给出初始数据，之后不再写入
+    Dynamic         // CPU 每帧写入
+};
+
+enum class MapMode : uint32_t
+{
+    Discard,        // 整块缓冲换成新内存
+    NoOverwrite     // 追加写入 GPU 未在使用的区域
+};
+
+struct BufferDesc
+{
+    BufferType type;
+    BufferUsage usage;
+    uint32_t byteWidth;
+    const char* debugName;
+};
+
+// 一次 Map 内写入的一段数据
+struct BufferWrite
+{
+    uint32_t offset;
+    const void* pData;
+    uint32_t size;
+};
+
+// 设备层面的调用计数，由各后端累加
+struct RenderDeviceStats
+{
+    uint32_t bufferCreates = 0;
+    uint32_t bufferWrites = 0;          // Map/Unmap 次数
+    uint64_t bytesWritten = 0;
+    uint32_t vertexBufferBinds = 0;
+    uint32_t indexBufferBinds = 0;
+    uint32_t constantBufferBinds = 0;
+    uint32_t vertexFormatBinds = 0;
+    uint32_t drawCalls = 0;
+    uint64_t indicesDrawn = 0;          // 索引数 × 实例数
+    uint64_t instancesDrawn = 0;
+    uint32_t presents = 0;
+
+    void Reset() { *this = RenderDeviceStats(); }
+
+    // 合并命令上下文录制期间的绑定与绘制计数
+    void AddCommands(const RenderDeviceStats& other)
+    {
+        vertexBufferBinds += other.vertexBufferBinds;
+        indexBufferBinds += other.indexBufferBinds;
+        constantBufferBinds += other.constantBufferBinds;
+        vertexFormatBinds += other.vertexFormatBinds;
+        drawCalls += other.drawCalls;
+        indicesDrawn += other.indicesDrawn;
+        instancesDrawn += other.instancesDrawn;
+    }
+};
+
+// 命令上下文：只包含绑定和绘制，设备本身也是一个（直接执行的）命令上下文
+class CommandContext
+{
+public:
+    virtual ~CommandContext() {}
+
+    virtual void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* pBuffers,
+        const uint32_t* pStrides, const uint32_t* pOffsets) = 0;
+    virtual void SetIndexBuffer(BufferHandle buffer) = 0;     // 16 位索引
+    // firstConstant/numConstants 以 16 字节常量为单位，numConstants 为 0 时绑定整个缓冲
+    virtual void SetConstantBuffer(uint32_t slot, BufferHandle buffer,
+        uint32_t firstConstant = 0, uint32_t numConstants = 0) = 0;
+    // 切换到该顶点格式的输入布局和顶点着色器
+    virtual void SetVertexFormat(VertexFormat format) = 0;
+    virtual void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+        uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) = 0;
+};
+
+class RenderDevice : public CommandContext
+{
+public:
+    virtual ~RenderDevice() {}
+
+    virtual BufferHandle CreateBuffer(const BufferDesc& desc, const void* pInitData) = 0;
+    // 一次 Map 写入若干段数据
+    virtual void WriteBuffer(BufferHandle buffer, MapMode mode, const BufferWrite* pWrites, uint32_t writeCount) = 0;
+
+    virtual void Clear(const float color[4]) = 0;     // 清空渲染目标与深度模板
+    virtual void Present() = 0;
+    // 释放设备持有的渲染目标引用和绑定。交换链调整缓冲区大小之前必须调用，之后重新设置渲染目标
+    virtual void ReleaseRenderTargets() = 0;
+
+    // 帧 fence：每帧结束时插入一个递增的值，GetCompletedFence 返回 GPU 已完成的最大值
+    virtual void InsertFence(uint64_t fence) = 0;
+    virtual uint64_t GetCompletedFence() = 0;
+
+    // 是否支持常量缓冲偏移绑定及对动态常量缓冲使用 NO_OVERWRITE
+    virtual bool SupportsConstantBufferOffsets() const = 0;
+
+    // ==== 并行录制 ====
+    // 可同时录制的命令上下文个数，0 表示不支持（只能直接在设备上提交）
+    virtual uint32_t GetMaxCommandContexts() const { return 0; }
+    // 在设备所在线程上取得第 index 个上下文并开始录制。缓冲绑定从空状态开始，由录制方设置；
+    // 着色器、渲染目标等接口之外的管线状态由设备从当前状态复制
+    virtual CommandContext* BeginCommandContext(uint32_t index) { (void)index; return nullptr; }
+    // 结束录制，可以在录制线程上调用；录制期间不能创建或写入缓冲
+    virtual void EndCommandContext(uint32_t index) { (void)index; }
+    // 在设备所在线程上按 0..count-1 的顺序执行录制好的命令，设备当前的绑定状态保持不变
+    virtual void ExecuteCommandContexts(uint32_t count) { (void)count; }
+
+    const RenderDeviceStats& GetStats() const { return m_Stats; }
+    void ResetStats() { m_Stats.Reset(); }
+
+    // 便捷版本：写入单段数据
+    void WriteBuffer(BufferHandle buffer, MapMode mode, uint32_t offset, const void* pData, uint32_t size)
+    {
+        BufferWrite write = { offset, pData, size };
+        WriteBuffer(buffer, mode, &write, 1);
+    }
+
+protected:
+    RenderDeviceStats m_Stats;
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "RenderQueue.h"
+#include <cassert>
+#include <cstring>
+
+uint64_t RenderQueue::MakeKey(uint32_t meshId, uint32_t depthBucket)
+{
+    return (static_cast<uint64_t>(meshId) << 32) | depthBucket;
+}
+
+uint32_t RenderQueue::DepthBucket(float depth)
+{
+    // 相机后方或 NaN 的物体都归到最前面的桶
+    if (!(depth > 0.0f))
+        return 0;
+    uint32_t bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    return bits;
+}
+
+RenderQueue::RenderQueue()
+{
+}
+
+void RenderQueue::Clear()
+{
+    m_Items.clear();
+    m_Stats = Stats();
+}
+
+void RenderQueue::Push(uint32_t meshId, uint32_t constantsId, float depth, uint32_t firstInstance,
+    uint32_t instanceCount)
+{
+    DrawItem item;
+    item.key = MakeKey(meshId, DepthBucket(depth));
+    item.meshId = meshId;
+    item.constantsId = constantsId;
+    item.firstInstance = firstInstance;
+    item.instanceCount = instanceCount;
+    m_Items.push_back(item);
+}
+
+void RenderQueue::Push(const DrawItem& item)
+{
+    m_Items.push_back(item);
+}
+
+void RenderQueue::Sort()
+{
+    const size_t count = m_Items.size();
+    m_Stats.sortPasses = 0;
+    if (count < 2)
+        return;
+
+    // LSD 基数排序：每趟 8 位，共 8 趟；每趟都是稳定的计数排序
+    m_Scratch.resize(count);
+    DrawItem* src = m_Items.data();
+    DrawItem* dst = m_Scratch.data();
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        uint32_t histogram[256] = {};
+        for (size_t i = 0; i < count; ++i)
+            ++histogram[(src[i].key >> shift) & 0xFF];
+
+        // 所有键在这一字节上相同：这一趟不会改变顺序，直接跳过
+        if (histogram[(src[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for (int b = 0; b < 256; ++b)
+        {
+            uint32_t n = histogram[b];
+            histogram[b] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; ++i)
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+        DrawItem* tmp = src; src = dst; dst = tmp;
+        ++m_Stats.sortPasses;
+    }
+
+    // 奇数趟时结果在交换缓冲中
+    if (src != m_Items.data())
+        m_Items.swap(m_Scratch);
+}
+
+void RenderQueue::SplitItems(uint32_t sliceInstances)
+{
+    assert(sliceInstances > 0);
+    m_Scratch.clear();
+    uint32_t sliceRemaining = sliceInstances;      // 当前切片还能放下的实例数
+    for (const DrawItem& item : m_Items)
+    {
+        // 没有实例的项原样保留
+        DrawItem piece = item;
+        uint32_t remaining = item.instanceCount;
+        do
+        {
+            piece.instanceCount = remaining < sliceRemaining ? remaining : sliceRemaining;
+            m_Scratch.push_back(piece);
+            piece.firstInstance += piece.instanceCount;
+            remaining -= piece.instanceCount;
+            sliceRemaining -= piece.instanceCount;
+            if (sliceRemaining == 0)
+                sliceRemaining = sliceInstances;
+        } while (remaining > 0);
+    }
+    m_Items.swap(m_Scratch);
+}
+
+void RenderQueue::Submit(Backend& backend)
+{
+    SubmitRange(backend, 0, static_cast<uint32_t>(m_Items.size()), m_Stats);
+}
+
+void RenderQueue::SubmitRange(Backend& backend, uint32_t firstItem, uint32_t itemCount, Stats& stats) const
+{
+    assert(firstItem + itemCount <= m_Items.size());
+    // 每次提交都从“未绑定”状态开始，不假设上一帧留下的状态仍然有效
+    bool hasMesh = false, hasConstants = false;
+    uint32_t currMesh = 0, currConstants = 0;
+
+    for (uint32_t i = firstItem; i < firstItem + itemCount; ++i)
+    {
+        const DrawItem& item = m_Items[i];
+        if (!hasConstants || item.constantsId != currConstants)
+        {
+            backend.BindConstants(item.constantsId);
+            currConstants = item.constantsId;
+            hasConstants = true;
+            ++stats.constantBinds;
+        }
+        else
+            ++stats.constantBindsAvoided;
+
+        if (!hasMesh || item.meshId != currMesh)
+        {
+            backend.BindMesh(item.meshId);
+            currMesh = item.meshId;
+            hasMesh = true;
+            ++stats.meshBinds;
+        }
+        else
+            ++stats.meshBindsAvoided;
+
+        backend.Draw(item);
+        ++stats.items;
+    }
+}
+
+void RenderQueue::AddSubmitStats(const Stats& stats)
+{
+    m_Stats.AddSubmit(stats);
+}
+
+const std::vector<RenderQueue::DrawItem>& RenderQueue::GetItems() const
+{
+    return m_Items;
+}
+
+const RenderQueue::Stats& RenderQueue::GetStats() const
+{
+    return m_Stats;
+}
@@ -0,0 +1,128 @@
+//***************************************************************************************
+// RenderQueue.h
+//
+// 渲染队列：收集每帧的绘制项，按 64 位排序键（网格 | 深度桶）做基数排序，
+// 提交时跳过与上一次相同的网格/对象常量绑定，并统计省下的绑定次数。
+// 实际的绑定和绘制通过 RenderQueue::Backend 完成。
+//***************************************************************************************
+
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <cstdint>
+#include <vector>
+
+class RenderQueue
+{
+public:
+    // 一次绘制：某个网格的一段连续实例（材质由着色器按实例的材质索引取，不影响绑定）
+    struct DrawItem
+    {
+        uint64_t key;
+        uint32_t meshId;
+        uint32_t constantsId;       // 提交时绑定的对象常量（SceneRenderer 中为常量环句柄）
+        uint32_t firstInstance;     // 实例范围，由后端解释
+        uint32_t instanceCount;
+    };
+
+    // 提交目标：由 D3D 渲染器或记录用的后端实现
+    class Backend
+    {
+    public:
+        virtual ~Backend() {}
+        virtual void BindMesh(uint32_t meshId) = 0;
+        virtual void BindConstants(uint32_t constantsId) = 0;
+        virtual void Draw(const DrawItem& item) = 0;
+    };
+
+    struct Stats
+    {
+        uint32_t items = 0;                 // 提交的绘制项数
+        uint32_t meshBinds = 0;             // 实际执行的网格绑定
+        uint32_t constantBinds = 0;         // 实际执行的对象常量绑定
+        uint32_t meshBindsAvoided = 0;      // 与上一项相同而跳过的网格绑定
+        uint32_t constantBindsAvoided = 0;  // 与上一项相同而跳过的对象常量绑定
+        uint32_t sortPasses = 0;            // 基数排序实际执行的趟数（全部相同的字节会跳过）
+
+        uint32_t Binds() const { return meshBinds + constantBinds; }
+        uint32_t BindsAvoided() const { return meshBindsAvoided + constantBindsAvoided; }
+        // 合并分段提交的计数（不含排序趟数）
+        void AddSubmit(const Stats& other)
+        {
+            items += other.items;
+            meshBinds += other.meshBinds;
+            constantBinds += other.constantBinds;
+            meshBindsAvoided += other.meshBindsAvoided;
+            constantBindsAvoided += other.constantBindsAvoided;
+        }
+    };
+
+    // 排序键布局：[63:32] 网格  [31:0] 深度桶
+    // 网格切换（IA 重新绑定，格式不同时还要换着色器）是唯一需要避免的状态切换，放在高位；
+    // 材质放在实例数据里，不产生绑定，所以不进排序键
+    static uint64_t MakeKey(uint32_t meshId, uint32_t depthBucket);
+    // 非负深度直接取 float 的位模式，保持大小顺序（由近到远）
+    static uint32_t DepthBucket(float depth);
+
+public:
+    RenderQueue();
+
+    void Clear();                           // 每帧开始时调用，保留已分配的容量
+    void Push(uint32_t meshId, uint32_t constantsId, float depth, uint32_t firstInstance, uint32_t instanceCount);
+    void Push(const DrawItem& item);
+
+    void Sort();                            // 按排序键稳定排序
+    // 按当前顺序累计实例数，在累计值为 sliceInstances 整数倍的位置把绘制项拆开（排序键不变，顺序不变），
+    // 每项不超过 sliceInstances 个实例。并行录制时按实例数切块用：否则一个大批次只能整个落在一块里
+    void SplitItems(uint32_t sliceInstances);
+    void Submit(Backend& backend);          // 按当前顺序提交，跳过重复绑定
+    // 只提交 [firstItem, firstItem + itemCount)，计数写入 stats。每段都从未绑定状态开始，
+    // 不修改队列本身，可以在多个线程上同时提交不同的段
+    void SubmitRange(Backend& backend, uint32_t firstItem, uint32_t itemCount, Stats& stats) const;
+    void AddSubmitStats(const Stats& stats);    // 把分段提交的计数合并到本帧统计
+
+    const std::vector<DrawItem>& GetItems() const;
+    const Stats& GetStats() const;
+
+private:
+    std::vector<DrawItem> m_Items;
+    std::vector<DrawItem> m_Scratch;        // 基数排序的交换缓冲
+    Stats m_Stats;
+};
+
+// 只记录调用序列的后端，用于在没有 D3D 的环境下检查排序和提交结果
+class RenderQueueRecorder : public RenderQueue::Backend
+{
+public:
+    enum class CommandType : uint32_t
+    {
+        BindMesh,
+        BindConstants,
+        Draw
+    };
+
+    struct Command
+    {
+        CommandType type;
+        uint32_t id;                // 网格 id / 对象常量 id，Draw 时为网格 id
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+    };
+
+public:
+    void Clear() { m_Commands.clear(); }
+
+    void BindMesh(uint32_t meshId) override { m_Commands.push_back({ CommandType::BindMesh, meshId, 0, 0 }); }
+    void BindConstants(uint32_t constantsId) override { m_Commands.push_back({ CommandType::BindConstants, constantsId, 0, 0 }); }
+    void Draw(const RenderQueue::DrawItem& item) override
+    {
+        m_Commands.push_back({ CommandType::Draw, item.meshId, item.firstInstance, item.instanceCount });
+    }
+
+    const std::vector<Command>& GetCommands() const { return m_Commands; }
+
+private:
+    std::vector<Command> m_Commands;
+};
+
+#endif
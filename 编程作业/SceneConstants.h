@@ -0,0 +1,68 @@
+//***************************************************************************************
+// SceneConstants.h
+//
+// 光源、材质以及两个常量缓冲的 CPU 端布局，需要与 HLSL 中的 cbuffer 保持一致。
+//***************************************************************************************
+
+#ifndef SCENECONSTANTS_H
+#define SCENECONSTANTS_H
+
+#include <DirectXMath.h>
+
+// ==== 许双博第四次作业修改：光照和材质参数结构 ====
+struct Light
+{
+    // 光源位置（方向光无效）
+    DirectX::XMFLOAT3 position;
+    float range;             // 点光源/聚光灯有效半径
+    // 光源朝向（点光源无效）
+    DirectX::XMFLOAT3 direction;
+    float spot;              // 聚光灯张角（弧度），方向光/点光源无效
+    // 光源颜色：环境光、漫反射、镜面反射
+    DirectX::XMFLOAT3 ambient;
+    float pad0;
+    DirectX::XMFLOAT3 diffuse;
+    float pad1;
+    DirectX::XMFLOAT3 specular;
+    float pad2;
+    int type;               // 0=方向光，1=点光源，2=聚光灯
+    int enabled;            // 是否启用
+    int pad3[2];            // 对齐填充
+};
+
+struct Material
+{
+    DirectX::XMFLOAT3 ambient;
+    float pad0;
+    DirectX::XMFLOAT3 diffuse;
+    float pad1;
+    DirectX::XMFLOAT3 specular;
+    float shininess;
+};
+
+// ==== 常量缓冲拆分：每帧一次的相机/光源数据（b0） ====
+struct CBPerFrame
+{
+    DirectX::XMMATRIX view;
+    DirectX::XMMATRIX proj;
+    // 三种光源（顺序：点光、聚光、方向光）
+    Light lights[3];
+    // 观察者位置
+    DirectX::XMFLOAT3 eyePos;
+    float padEye;
+};
+
+// ==== 常量缓冲拆分：每个绘制对象的数据（b1） ====
+struct CBPerObject
+{
+    // 对象世界矩阵，与实例自身的世界矩阵相乘（字符森林为单位矩阵）
+    DirectX::XMMATRIX world;
+    // 材质表，由每个实例的材质索引选择
+    Material materials[4];
+};
+
+// 常量缓冲大小必须是 16 字节的整数倍
+static_assert(sizeof(CBPerFrame) % 16 == 0, "CBPerFrame 大小需要 16 字节对齐");
+static_assert(sizeof(CBPerObject) % 16 == 0, "CBPerObject 大小需要 16 字节对齐");
+
+#endif
@@ -0,0 +1,669 @@
+#include "SceneRenderer.h"
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+using namespace DirectX;
+
+// 把行向量约定的刚体/缩放矩阵插值：缩放和平移线性插值，旋转球面插值
+static XMMATRIX InterpolateTransform(FXMMATRIX previous, CXMMATRIX current, float alpha)
+{
+    XMVECTOR scale0, rotation0, translation0;
+    XMVECTOR scale1, rotation1, translation1;
+    if (!XMMatrixDecompose(&scale0, &rotation0, &translation0, previous) ||
+        !XMMatrixDecompose(&scale1, &rotation1, &translation1, current))
+        return current;
+    return XMMatrixAffineTransformation(XMVectorLerp(scale0, scale1, alpha), XMVectorZero(),
+        XMQuaternionSlerp(rotation0, rotation1, alpha), XMVectorLerp(translation0, translation1, alpha));
+}
+
+SceneView InterpolateSceneView(const SceneView& previous, const SceneView& current, float alpha)
+{
+    SceneView result = current;
+    if (alpha >= 1.0f)
+        return result;
+
+    // view 已转置；相机的世界矩阵是视图矩阵的逆
+    XMMATRIX world0 = XMMatrixInverse(nullptr, XMMatrixTranspose(previous.view));
+    XMMATRIX world1 = XMMatrixInverse(nullptr, XMMatrixTranspose(current.view));
+    XMMATRIX world = InterpolateTransform(world0, world1, alpha);
+    result.view = XMMatrixTranspose(XMMatrixInverse(nullptr, world));
+
+    result.playerWorld = InterpolateTransform(previous.playerWorld, current.playerWorld, alpha);
+    XMStoreFloat3(&result.eyePos, XMVectorLerp(XMLoadFloat3(&previous.eyePos), XMLoadFloat3(&current.eyePos), alpha));
+    return result;
+}
+
+SceneRenderer::SceneRenderer()
+    : m_CBPerFrame(), m_CBPerObject()
+{
+}
+
+void SceneRenderer::Init(RenderDevice* pDevice, const GeometryPool* pPool, int playerMeshId)
+{
+    assert(pDevice && pPool);
+    m_pDevice = pDevice;
+    m_pPool = pPool;
+    m_PlayerMeshId = playerMeshId;
+
+    // ==== 几何池：所有网格共用一个 VB/IB ====
+    BufferDesc desc{};
+    if (pPool->GetVertexCapacity() > 0)
+    {
+        // 预留了容量：创建可写缓冲，由 UpdateGeometry 追加写入
+        desc.type = BufferType::Vertex;
+        desc.usage = BufferUsage::Dynamic;
+        desc.byteWidth = pPool->GetVertexCapacity() * pPool->GetVertexStride();
+        desc.debugName = "GeometryPool_VB";
+        m_PoolVertexBuffer = m_pDevice->CreateBuffer(desc, nullptr);
+
+        desc.type = BufferType::Index;
+        desc.byteWidth = pPool->GetIndexCapacity() * sizeof(uint16_t);
+        desc.debugName = "GeometryPool_IB";
+        m_PoolIndexBuffer = m_pDevice->CreateBuffer(desc, nullptr);
+        m_UploadedVertexBytes = 0;
+        m_UploadedIndexBytes = 0;
+        UpdateGeometry();
+    }
+    else
+    {
+        desc.type = BufferType::Vertex;
+        desc.usage = BufferUsage::Immutable;
+        desc.byteWidth = pPool->GetVertexByteSize();
+        desc.debugName = "GeometryPool_VB";
+        m_PoolVertexBuffer = m_pDevice->CreateBuffer(desc, pPool->GetVertexData());
+
+        desc.type = BufferType::Index;
+        desc.byteWidth = pPool->GetIndexByteSize();
+        desc.debugName = "GeometryPool_IB";
+        m_PoolIndexBuffer = m_pDevice->CreateBuffer(desc, pPool->GetIndexData());
+        m_UploadedVertexBytes = pPool->GetVertexByteSize();
+        m_UploadedIndexBytes = pPool->GetIndexByteSize();
+        UpdateGeometry();
+    }
+
+    // 常量缓冲：b0 每帧更新，b1 每个绘制对象更新
+    desc.type = BufferType::Constant;
+    desc.usage = BufferUsage::Dynamic;
+    desc.byteWidth = sizeof(CBPerFrame);
+    desc.debugName = "CBPerFrame";
+    m_CBPerFrameBuffer = m_pDevice->CreateBuffer(desc, nullptr);
+    desc.byteWidth = sizeof(CBPerObject);
+    desc.debugName = "CBPerObject";
+    m_CBPerObjectBuffer = m_pDevice->CreateBuffer(desc, nullptr);
+
+    // ==== 常量环形缓冲：需要设备支持常量缓冲偏移绑定和 NO_OVERWRITE 映射 ====
+    m_UseConstantRing = m_pDevice->SupportsConstantBufferOffsets();
+    if (m_UseConstantRing)
+    {
+        desc.byteWidth = kConstantRingBytes;
+        desc.debugName = "ConstantRing";
+        m_ConstantRingBuffer = m_pDevice->CreateBuffer(desc, nullptr);
+        m_ConstantRing.Init(kConstantRingBytes);
+    }
+
+    // ==== 实例化绘制：动态实例缓冲 ====
+    desc.type = BufferType::Vertex;
+    desc.byteWidth = sizeof(InstanceData) * kInstanceBufferCapacity;
+    desc.debugName = "InstanceBuffer";
+    m_InstanceBuffer = m_pDevice->CreateBuffer(desc, nullptr);
+
+    m_CBPerObject.world = XMMatrixIdentity();
+    m_pDevice->SetConstantBuffer(0, m_CBPerFrameBuffer);
+    m_pDevice->SetConstantBuffer(1, m_CBPerObjectBuffer);
+}
+
+void SceneRenderer::UpdateGeometry()
+{
+    // 替换网格只会在末尾追加数据，已上传的部分 GPU 可能仍在使用，用 NO_OVERWRITE 写入新部分
+    const uint8_t* pVertices = static_cast<const uint8_t*>(m_pPool->GetVertexData());
+    const uint32_t vertexBytes = m_pPool->GetVertexByteSize();
+    if (vertexBytes > m_UploadedVertexBytes)
+    {
+        m_pDevice->WriteBuffer(m_PoolVertexBuffer, MapMode::NoOverwrite, m_UploadedVertexBytes,
+            pVertices + m_UploadedVertexBytes, vertexBytes - m_UploadedVertexBytes);
+        m_UploadedVertexBytes = vertexBytes;
+    }
+    const uint8_t* pIndices = reinterpret_cast<const uint8_t*>(m_pPool->GetIndexData());
+    const uint32_t indexBytes = m_pPool->GetIndexByteSize();
+    if (indexBytes > m_UploadedIndexBytes)
+    {
+        m_pDevice->WriteBuffer(m_PoolIndexBuffer, MapMode::NoOverwrite, m_UploadedIndexBytes,
+            pIndices + m_UploadedIndexBytes, indexBytes - m_UploadedIndexBytes);
+        m_UploadedIndexBytes = indexBytes;
+    }
+
+    // Packed 网格的反量化参数放在各自的常量缓冲中，网格替换后重新写入
+    const int meshCount = m_pPool->GetMeshCount();
+    m_MeshDecodeBuffers.resize(meshCount, kInvalidBuffer);
+    m_OccluderBoxes.resize(meshCount);
+    std::vector<XMFLOAT3> positions;
+    for (int i = 0; i < meshCount; ++i)
+    {
+        const GeometryPool::MeshRange& mesh = m_pPool->GetMesh(i);
+        // 字由细笔画组成，三角形本身不是保守的遮挡体，只用完全在网格内部的盒子
+        m_pPool->GetPositions(i, positions);
+        OcclusionCuller::BuildInnerBoxes(positions.data(), sizeof(XMFLOAT3), mesh.vertexCount,
+            m_pPool->GetIndexData() + mesh.startIndex, mesh.indexCount, m_OccluderBoxes[i]);
+        if (mesh.format != VertexFormat::Packed)
+            continue;
+        if (m_MeshDecodeBuffers[i] == kInvalidBuffer)
+        {
+            BufferDesc desc{};
+            desc.type = BufferType::Constant;
+            desc.usage = BufferUsage::Dynamic;
+            desc.byteWidth = sizeof(PositionDecode);
+            desc.debugName = "CBMeshDecode";
+            m_MeshDecodeBuffers[i] = m_pDevice->CreateBuffer(desc, nullptr);
+        }
+        m_pDevice->WriteBuffer(m_MeshDecodeBuffers[i], MapMode::Discard, 0, &mesh.decode, sizeof(mesh.decode));
+    }
+
+    // 单元包围球使用四个字中最大的包围半径
+    m_GlyphRadius = 0.0f;
+    for (int i = 0; i < ForestScene::kGlyphCount && i < m_pPool->GetMeshCount(); ++i)
+        m_GlyphRadius = std::max(m_GlyphRadius, m_pPool->ComputeBoundingRadius(i));
+    m_CellBoundsValid = false;
+}
+
+void SceneRenderer::SetJobSystem(JobSystem* pJobSystem)
+{
+    m_pJobSystem = pJobSystem;
+}
+
+void SceneRenderer::Render(const ForestScene& scene, const SceneView& view)
+{
+    assert(m_pDevice);
+    m_FrameStats.Reset();
+    // 回收 GPU 已经用完的常量环区域，清空上一帧的对象常量
+    BeginFrameFence();
+
+    // 第一人称时不绘制玩家自身
+    FramePrep prep;
+    prep.drawPlayer = view.drawPlayer && m_PlayerMeshId >= 0 && m_PlayerMeshId < m_pPool->GetMeshCount();
+
+    // 字符森林的对象世界矩阵为单位矩阵，所有批次共用一份对象常量
+    prep.forestConstants = PushPerObjectConstants(XMMatrixIdentity());
+    prep.playerConstants = 0;
+    if (prep.drawPlayer)
+        prep.playerConstants = PushPerObjectConstants(XMMatrixTranspose(view.playerWorld));
+
+    // ==== 任务系统：帧准备在工作线程上进行，同时当前线程完成本帧的清屏和常量上传 ====
+    JobSystem::JobHandle prepared = SchedulePrepare(scene, view, prep);
+
+    static const float black[4] = { 0, 0, 0, 1 };
+    m_pDevice->Clear(black);
+    // 相机与光源整帧不变，只上传一次
+    UploadPerFrameConstants(scene, view);
+    // 本帧所有对象常量一次写入
+    FlushPerObjectConstants(scene);
+
+    if (m_pJobSystem)
+        m_pJobSystem->Wait(prepared);
+
+    SubmitDrawItems();
+
+    m_FrameStats.instanceCount = m_InstanceBuilder.GetStats().instanceCount;
+    m_FrameStats.legacyDrawCalls = m_InstanceBuilder.GetStats().legacyDrawCalls;
+    // 并行录制时大批次会按块拆开，实际的绘制次数以提交的绘制项为准
+    m_FrameStats.drawCalls = static_cast<uint32_t>(m_RenderQueue.GetItems().size());
+    m_FrameStats.stateBinds = m_RenderQueue.GetStats().Binds();
+    m_FrameStats.bindsAvoided = m_RenderQueue.GetStats().BindsAvoided();
+    AccumulateVertexBytes();
+
+    m_LastFrameStats = m_FrameStats;
+    EndFrameFence();
+}
+
+// 几何池的 IB 与实例缓冲每个上下文只绑定一次，各网格通过 BaseVertex/StartIndex 区分；
+// 槽0 的步长取决于网格的顶点格式，在第一次 BindMesh 时绑定
+void SceneRenderer::BindGeometry(CommandContext& context)
+{
+    uint32_t stride = sizeof(InstanceData);
+    uint32_t offset = 0;
+    context.SetVertexBuffers(1, 1, &m_InstanceBuffer, &stride, &offset);
+    context.SetIndexBuffer(m_PoolIndexBuffer);
+}
+
+void SceneRenderer::BindMeshVertices(CommandContext& context, uint32_t meshId, const GeometryPool::MeshRange* pPrevious)
+{
+    const GeometryPool::MeshRange& mesh = m_pPool->GetMesh(static_cast<int>(meshId));
+    if (!pPrevious || pPrevious->format != mesh.format)
+    {
+        // 同一个顶点缓冲按网格的步长重新绑定
+        uint32_t offset = 0;
+        context.SetVertexBuffers(0, 1, &m_PoolVertexBuffer, &mesh.vertexStride, &offset);
+        context.SetVertexFormat(mesh.format);
+    }
+    if (mesh.format == VertexFormat::Packed)
+        context.SetConstantBuffer(2, m_MeshDecodeBuffers[meshId]);
+}
+
+// 按网格的实际格式和全部使用 Float 格式分别累计，比较压缩顶点格式节省的顶点读取量
+void SceneRenderer::AccumulateVertexBytes()
+{
+    for (const RenderQueue::DrawItem& item : m_RenderQueue.GetItems())
+    {
+        const GeometryPool::MeshRange& mesh = m_pPool->GetMesh(static_cast<int>(item.meshId));
+        uint64_t vertices = static_cast<uint64_t>(mesh.vertexCount) * item.instanceCount;
+        m_FrameStats.vertexBytes += vertices * mesh.vertexStride;
+        m_FrameStats.floatVertexBytes += vertices * m_pPool->GetVertexStride();
+    }
+}
+
+void SceneRenderer::SubmitDrawItems()
+{
+    const std::vector<RenderQueue::DrawItem>& items = m_RenderQueue.GetItems();
+    uint32_t totalInstances = 0;
+    for (const RenderQueue::DrawItem& item : items)
+        totalInstances += item.instanceCount;
+
+    // 并行录制时各块只能绑定和绘制：对象常量要能按偏移绑定（常量环形缓冲），
+    // 本帧实例要能一次写入实例缓冲；否则逐项上传实例，直接在设备上提交
+    if (!m_UseConstantRing || totalInstances > kInstanceBufferCapacity)
+    {
+        BindGeometry(*m_pDevice);
+        QueueBackend backend(*this);
+        m_RenderQueue.Submit(backend);
+        return;
+    }
+
+    // 按实例数切块：绘制项只有每个网格的几个批次，先按每块的份额在累计实例数上把批次切开，
+    // 否则一个大批次只能整个落在一块里
+    const uint32_t maxChunks = ParallelSubmitter::GetMaxChunks(*m_pDevice, m_pJobSystem);
+    if (maxChunks > 1)
+        m_RenderQueue.SplitItems(std::max(kMinInstancesPerCommandList, (totalInstances + maxChunks - 1) / maxChunks));
+    UploadFrameInstances(totalInstances);
+
+    const uint32_t itemCount = static_cast<uint32_t>(items.size());
+    m_ItemWeights.resize(itemCount);
+    for (uint32_t i = 0; i < itemCount; ++i)
+        m_ItemWeights[i] = items[i].instanceCount;
+
+    m_ChunkStats.assign(maxChunks, RenderQueue::Stats());
+    m_FrameStats.commandLists = m_ParallelSubmitter.Submit(*m_pDevice, m_pJobSystem, m_ItemWeights.data(), itemCount,
+        kMinInstancesPerCommandList,
+        [this](uint32_t chunkIndex, CommandContext& context, const ParallelSubmitter::Chunk& chunk) {
+            // 命令上下文从空绑定开始，每块都要绑定几何和每帧常量
+            BindGeometry(context);
+            context.SetConstantBuffer(0, m_CBPerFrameBuffer);
+            ContextBackend backend(*this, context, chunk.firstItem);
+            m_RenderQueue.SubmitRange(backend, chunk.firstItem, chunk.itemCount, m_ChunkStats[chunkIndex]);
+        });
+
+    for (size_t i = 0; i < m_ParallelSubmitter.GetChunks().size(); ++i)
+        m_RenderQueue.AddSubmitStats(m_ChunkStats[i]);
+}
+
+JobSystem::JobHandle SceneRenderer::SchedulePrepare(const ForestScene& scene, const SceneView& view, const FramePrep& prep)
+{
+    if (!m_pJobSystem)
+    {
+        CullCells(scene, view);
+        BuildForestInstances(scene);
+        BuildDrawItems(view, prep);
+        return nullptr;
+    }
+
+    // 三个阶段依次依赖；实例生成内部再按 ix 切片并行。Render 在返回前会等待，按引用捕获是安全的
+    JobSystem::JobHandle cull = m_pJobSystem->Schedule([this, &scene, &view]() { CullCells(scene, view); });
+    JobSystem::JobHandle instances = m_pJobSystem->Schedule([this, &scene]() { BuildForestInstances(scene); }, &cull, 1);
+    return m_pJobSystem->Schedule([this, &view, prep]() { BuildDrawItems(view, prep); }, &instances, 1);
+}
+
+// ==== 实例化绘制：先按网格 id 收集所有主字/子字的实例，再每个 id 一次 DrawIndexedInstanced ====
+void SceneRenderer::BuildForestInstances(const ForestScene& scene)
+{
+    const int meshCount = m_pPool->GetMeshCount();
+    const int n = scene.GetParams().n;
+    m_InstanceBuilder.Reset(meshCount);
+
+    // 只为剔除后仍可见的单元生成实例
+    if (!m_pJobSystem)
+    {
+        scene.BuildInstances(m_InstanceBuilder, m_CellVisible.data(), 0, -1);
+        return;
+    }
+
+    // 每个 ix 切片写入自己的 builder，再按切片顺序合并，实例顺序与单线程时相同
+    if (static_cast<int>(m_SlabBuilders.size()) < n)
+        m_SlabBuilders.resize(n);
+    m_pJobSystem->ParallelFor(0, static_cast<uint32_t>(n), 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t ix = begin; ix < end; ++ix)
+        {
+            m_SlabBuilders[ix].Reset(meshCount);
+            scene.BuildInstances(m_SlabBuilders[ix], m_CellVisible.data(), static_cast<int>(ix), static_cast<int>(ix) + 1);
+        }
+    });
+    for (int ix = 0; ix < n; ++ix)
+        m_InstanceBuilder.Append(m_SlabBuilders[ix]);
+}
+
+void SceneRenderer::BuildDrawItems(const SceneView& view, const FramePrep& prep)
+{
+    // ==== 许双博第四次作业修改：玩家使用默认材质并更新光照 ====
+    // 玩家只有一个实例：实例矩阵为单位矩阵，变换放在对象世界矩阵中
+    if (prep.drawPlayer)
+    {
+        InstanceData& playerInst = m_InstanceBuilder.Add(m_PlayerMeshId);
+        XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(playerInst.world), XMMatrixIdentity());
+        playerInst.materialIndex = 0;
+    }
+
+    m_InstanceBuilder.Build(kMaxInstancesPerDraw);
+
+    // ==== 渲染队列：每个批次一个绘制项，按（网格, 深度）排序后提交，重复的绑定会被跳过 ====
+    // 字符森林的批次覆盖整个网格阵列，深度统一取 0；玩家按到相机的距离
+    float playerDepth = 0.0f;
+    if (prep.drawPlayer)
+        playerDepth = XMVectorGetX(XMVector3Length(view.playerWorld.r[3] - XMLoadFloat3(&view.eyePos)));
+
+    m_RenderQueue.Clear();
+    for (const InstanceBuilder::Batch& batch : m_InstanceBuilder.GetBatches())
+    {
+        bool isPlayer = batch.meshId == static_cast<uint32_t>(m_PlayerMeshId);
+        m_RenderQueue.Push(batch.meshId, isPlayer ? prep.playerConstants : prep.forestConstants,
+            isPlayer ? playerDepth : 0.0f, batch.firstInstance, batch.instanceCount);
+    }
+    m_RenderQueue.Sort();
+}
+
+static bool SameCellLayout(const ForestParams& a, const ForestParams& b)
+{
+    return a.n == b.n && a.spacing == b.spacing && a.orbitRadius == b.orbitRadius
+        && a.orbitMin == b.orbitMin && a.orbitMax == b.orbitMax;
+}
+
+void SceneRenderer::CullCells(const ForestScene& scene, const SceneView& view)
+{
+    // 包围球只和阵列参数有关，参数不变时沿用上一帧的结果；
+    // 八叉树的拓扑只和 N 有关，间距等变化时只需自底向上更新包围球
+    if (!m_CellBoundsValid || !SameCellLayout(m_CellBoundsParams, scene.GetParams()))
+    {
+        if (m_CellOctree.GetGridSize() != scene.GetParams().n)
+            m_CellOctree.Build(scene.GetParams().n);
+        BuildCellBounds(scene);
+        m_CellOctree.Refit(m_CellBounds);
+        m_CellBoundsParams = scene.GetParams();
+        m_CellBoundsValid = true;
+    }
+
+    // SceneView 中的矩阵是转置后的，这里还原成 view * proj
+    XMFLOAT4X4 viewProj;
+    XMStoreFloat4x4(&viewProj, XMMatrixTranspose(view.view) * XMMatrixTranspose(view.proj));
+    m_FrustumCuller.SetViewProj(&viewProj.m[0][0]);
+
+    // 由近到远遍历八叉树，整棵子树在视锥内/外时不再逐个单元测试
+    m_CellVisible.resize(m_CellBounds.Size());
+    m_CellOctree.Cull(m_FrustumCuller, view.eyePos.x, view.eyePos.y, view.eyePos.z, m_CellVisible.data());
+    const CellOctree::CullStats& cullStats = m_CellOctree.GetStats();
+    m_FrameStats.cellsVisible = cullStats.cellsVisible;
+    m_FrameStats.cellsCulled = static_cast<uint32_t>(m_CellBounds.Size()) - cullStats.cellsVisible;
+    m_FrameStats.cullTests = cullStats.Tests();
+
+    if (m_OcclusionCulling)
+        OccludeCells(scene, &viewProj.m[0][0]);
+}
+
+void SceneRenderer::OccludeCells(const ForestScene& scene, const float viewProj[16])
+{
+    // 八叉树按由近到远给出可见单元，前几个的主字就是最好的遮挡体
+    const std::vector<uint32_t>& visibleCells = m_CellOctree.GetVisibleCells();
+    const uint32_t occluderCount = std::min(kMaxOccluderCells, static_cast<uint32_t>(visibleCells.size()));
+
+    m_OcclusionCuller.Begin(viewProj);
+    for (uint32_t i = 0; i < occluderCount; ++i)
+    {
+        XMFLOAT4X4 world;
+        int meshId = scene.GetCellMainGlyph(static_cast<int>(visibleCells[i]), &world);
+        for (const OcclusionCuller::Box& box : m_OccluderBoxes[meshId])
+            m_OcclusionCuller.RasterizeBox(box, &world.m[0][0]);
+    }
+    m_OcclusionCuller.BuildHiZ();
+
+    // 遮挡体所在的单元自身也会通过测试（它们离相机最近），其余单元被完全挡住时剔除
+    uint32_t occluded = 0;
+    for (uint32_t cell : visibleCells)
+    {
+        if (m_OcclusionCuller.IsSphereOccluded(m_CellBounds.x[cell], m_CellBounds.y[cell],
+            m_CellBounds.z[cell], m_CellBounds.r[cell]))
+        {
+            m_CellVisible[cell] = 0;
+            ++occluded;
+        }
+    }
+    m_FrameStats.cellsVisible -= occluded;
+    m_FrameStats.cellsOccluded = occluded;
+}
+
+void SceneRenderer::SetOcclusionCulling(bool enabled)
+{
+    m_OcclusionCulling = enabled;
+}
+
+bool SceneRenderer::IsOcclusionCullingEnabled() const
+{
+    return m_OcclusionCulling;
+}
+
+void SceneRenderer::BuildCellBounds(const ForestScene& scene)
+{
+    m_CellBounds.Resize(static_cast<size_t>(scene.GetCellCount()));
+    if (!m_pJobSystem)
+    {
+        scene.BuildCellBounds(m_GlyphRadius, m_CellBounds);
+        return;
+    }
+    // 各切片写入互不重叠的区间
+    m_pJobSystem->ParallelFor(0, static_cast<uint32_t>(scene.GetParams().n), 1, [&](uint32_t begin, uint32_t end) {
+        scene.BuildCellBounds(m_GlyphRadius, m_CellBounds, static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+const FrameStats& SceneRenderer::GetLastFrameStats() const
+{
+    return m_LastFrameStats;
+}
+
+uint64_t SceneRenderer::GetLastFrameFence() const
+{
+    return m_FrameFence - 1;
+}
+
+// ==== 渲染队列后端：几何池的 VB/IB 整帧不变，网格切换只需要换 BaseVertex/StartIndex（格式变化时还要换步长和着色器） ====
+void SceneRenderer::QueueBackend::BindMesh(uint32_t meshId)
+{
+    m_Renderer.BindMeshVertices(*m_Renderer.m_pDevice, meshId, m_pMesh);
+    m_pMesh = &m_Renderer.m_pPool->GetMesh(static_cast<int>(meshId));
+}
+
+void SceneRenderer::QueueBackend::BindConstants(uint32_t constantsId)
+{
+    m_Renderer.BindPerObjectConstants(*m_Renderer.m_pDevice, constantsId);
+}
+
+void SceneRenderer::QueueBackend::Draw(const RenderQueue::DrawItem& item)
+{
+    assert(m_pMesh);
+    const InstanceData* pInstances = m_Renderer.m_InstanceBuilder.GetInstances(static_cast<int>(item.meshId)) + item.firstInstance;
+    uint32_t startInstance = m_Renderer.UploadInstances(pInstances, item.instanceCount);
+    m_Renderer.m_pDevice->DrawIndexedInstanced(m_pMesh->indexCount, item.instanceCount,
+        m_pMesh->startIndex, static_cast<int32_t>(m_pMesh->baseVertex), startInstance);
+}
+
+void SceneRenderer::ContextBackend::BindMesh(uint32_t meshId)
+{
+    m_Renderer.BindMeshVertices(m_Context, meshId, m_pMesh);
+    m_pMesh = &m_Renderer.m_pPool->GetMesh(static_cast<int>(meshId));
+}
+
+void SceneRenderer::ContextBackend::BindConstants(uint32_t constantsId)
+{
+    m_Renderer.BindPerObjectConstants(m_Context, constantsId);
+}
+
+void SceneRenderer::ContextBackend::Draw(const RenderQueue::DrawItem& item)
+{
+    assert(m_pMesh);
+    m_Context.DrawIndexedInstanced(m_pMesh->indexCount, item.instanceCount,
+        m_pMesh->startIndex, static_cast<int32_t>(m_pMesh->baseVertex), m_Renderer.m_ItemStartInstances[m_NextItem++]);
+}
+
+// ==== 常量缓冲拆分：每帧上传一次相机、光源和观察者位置 ====
+void SceneRenderer::UploadPerFrameConstants(const ForestScene& scene, const SceneView& view)
+{
+    m_CBPerFrame.view = view.view;
+    m_CBPerFrame.proj = view.proj;
+    for (int li = 0; li < 3; ++li) m_CBPerFrame.lights[li] = scene.GetLights()[li];
+    m_CBPerFrame.eyePos = view.eyePos;
+
+    m_pDevice->WriteBuffer(m_CBPerFrameBuffer, MapMode::Discard, 0, &m_CBPerFrame, sizeof(m_CBPerFrame));
+    m_FrameStats.AddConstantUpload(sizeof(m_CBPerFrame));
+}
+
+// ==== 常量环形缓冲：记录一个对象的世界矩阵（已转置），返回绑定时使用的句柄 ====
+uint32_t SceneRenderer::PushPerObjectConstants(FXMMATRIX world)
+{
+    XMFLOAT4X4 worldF;
+    XMStoreFloat4x4(&worldF, world);
+    m_PendingObjectWorlds.push_back(worldF);
+    return static_cast<uint32_t>(m_PendingObjectWorlds.size() - 1);
+}
+
+// ==== 常量环形缓冲：整帧只 Map 一次，用 NO_OVERWRITE 追加到 GPU 未在使用的区域 ====
+void SceneRenderer::FlushPerObjectConstants(const ForestScene& scene)
+{
+    for (int i = 0; i < ForestScene::kGlyphCount; ++i) m_CBPerObject.materials[i] = scene.GetMaterials()[i];
+
+    if (!m_UseConstantRing || m_PendingObjectWorlds.empty())
+        return;
+
+    const size_t count = m_PendingObjectWorlds.size();
+    m_PendingObjectOffsets.resize(count);
+
+    MapMode mapMode = MapMode::NoOverwrite;
+    bool allocated = true;
+    for (size_t i = 0; i < count && allocated; ++i)
+        allocated = m_ConstantRing.Allocate(sizeof(CBPerObject), &m_PendingObjectOffsets[i]);
+    if (!allocated)
+    {
+        // 环中空间被在途帧占满：DISCARD 换一块新内存，从头重新分配
+        m_ConstantRing.Reset();
+        mapMode = MapMode::Discard;
+        for (size_t i = 0; i < count; ++i)
+        {
+            allocated = m_ConstantRing.Allocate(sizeof(CBPerObject), &m_PendingObjectOffsets[i]);
+            assert(allocated);
+        }
+    }
+
+    m_ObjectStaging.resize(sizeof(CBPerObject) * count);
+    m_ObjectWrites.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_CBPerObject.world = XMLoadFloat4x4(&m_PendingObjectWorlds[i]);
+        uint8_t* pStaging = m_ObjectStaging.data() + sizeof(CBPerObject) * i;
+        memcpy(pStaging, &m_CBPerObject, sizeof(CBPerObject));
+        m_ObjectWrites[i].offset = m_PendingObjectOffsets[i];
+        m_ObjectWrites[i].pData = pStaging;
+        m_ObjectWrites[i].size = sizeof(CBPerObject);
+    }
+    m_pDevice->WriteBuffer(m_ConstantRingBuffer, mapMode, m_ObjectWrites.data(), static_cast<uint32_t>(count));
+    m_FrameStats.AddConstantUpload(sizeof(CBPerObject) * count);
+}
+
+// ==== 常量环形缓冲：把句柄对应的对象常量绑定到 b1 ====
+void SceneRenderer::BindPerObjectConstants(CommandContext& context, uint32_t handle)
+{
+    assert(handle < m_PendingObjectWorlds.size());
+
+    if (m_UseConstantRing)
+    {
+        // 偏移和大小都以 16 字节常量为单位，且必须是 16 的倍数
+        uint32_t firstConstant = m_PendingObjectOffsets[handle] / 16;
+        uint32_t numConstants = ConstantRing::AlignSize(sizeof(CBPerObject)) / 16;
+        context.SetConstantBuffer(1, m_ConstantRingBuffer, firstConstant, numConstants);
+        return;
+    }
+
+    // 不支持偏移绑定：每个对象 Map(WRITE_DISCARD) 一次，只能在设备上直接提交
+    assert(&context == m_pDevice);
+    m_CBPerObject.world = XMLoadFloat4x4(&m_PendingObjectWorlds[handle]);
+    m_pDevice->WriteBuffer(m_CBPerObjectBuffer, MapMode::Discard, 0, &m_CBPerObject, sizeof(m_CBPerObject));
+    m_FrameStats.AddConstantUpload(sizeof(m_CBPerObject));
+}
+
+// ==== 帧 fence：回收 GPU 已完成的帧占用的常量环区域，每帧结束插入 fence 供在途帧控制使用 ====
+void SceneRenderer::BeginFrameFence()
+{
+    m_PendingObjectWorlds.clear();
+    if (!m_UseConstantRing)
+        return;
+
+    m_ConstantRing.Retire(m_pDevice->GetCompletedFence());
+}
+
+void SceneRenderer::EndFrameFence()
+{
+    if (m_UseConstantRing)
+        m_ConstantRing.EndFrame(m_FrameFence);
+    m_pDevice->InsertFence(m_FrameFence);
+    ++m_FrameFence;
+}
+
+// ==== 实例化绘制：把实例追加写入实例缓冲，返回其 StartInstanceLocation ====
+uint32_t SceneRenderer::UploadInstances(const InstanceData* pInstances, uint32_t count)
+{
+    assert(count <= kMaxInstancesPerDraw);
+
+    // 剩余空间足够时用 NO_OVERWRITE 追加，不打断 GPU 正在读取的部分；否则 DISCARD 换一块新内存
+    MapMode mapMode = MapMode::NoOverwrite;
+    if (m_InstanceCursor + count > kInstanceBufferCapacity)
+    {
+        mapMode = MapMode::Discard;
+        m_InstanceCursor = 0;
+    }
+
+    m_pDevice->WriteBuffer(m_InstanceBuffer, mapMode, sizeof(InstanceData) * m_InstanceCursor,
+        pInstances, sizeof(InstanceData) * count);
+    m_FrameStats.instanceBytes += sizeof(InstanceData) * count;
+
+    uint32_t startInstance = m_InstanceCursor;
+    m_InstanceCursor += count;
+    return startInstance;
+}
+
+// ==== 并行录制：本帧所有绘制项的实例一次 Map 写入，记下各项的 StartInstanceLocation ====
+// 调用方保证 totalInstances 不超过实例缓冲容量：整帧中途 DISCARD 的话，先录制的命令会读到新内容
+void SceneRenderer::UploadFrameInstances(uint32_t totalInstances)
+{
+    assert(totalInstances <= kInstanceBufferCapacity);
+    const std::vector<RenderQueue::DrawItem>& items = m_RenderQueue.GetItems();
+    m_ItemStartInstances.resize(items.size());
+    if (totalInstances == 0)
+        return;
+
+    MapMode mapMode = MapMode::NoOverwrite;
+    if (m_InstanceCursor + totalInstances > kInstanceBufferCapacity)
+    {
+        mapMode = MapMode::Discard;
+        m_InstanceCursor = 0;
+    }
+
+    m_InstanceWrites.clear();
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        const RenderQueue::DrawItem& item = items[i];
+        m_ItemStartInstances[i] = m_InstanceCursor;
+        if (item.instanceCount == 0)
+            continue;
+        BufferWrite write;
+        write.offset = sizeof(InstanceData) * m_InstanceCursor;
+        write.pData = m_InstanceBuilder.GetInstances(static_cast<int>(item.meshId)) + item.firstInstance;
+        write.size = sizeof(InstanceData) * item.instanceCount;
+        m_InstanceWrites.push_back(write);
+        m_InstanceCursor += item.instanceCount;
+    }
+    m_pDevice->WriteBuffer(m_InstanceBuffer, mapMode, m_InstanceWrites.data(), static_cast<uint32_t>(m_InstanceWrites.size()));
+    m_FrameStats.instanceBytes += sizeof(InstanceData) * totalInstances;
+}
@@ -0,0 +1,196 @@
+//***************************************************************************************
+// SceneRenderer.h
+//
+// 场景提交：把 ForestScene 的实例、常量和绘制通过 RenderDevice 提交。
+// 包括实例缓冲追加写入、常量环形缓冲、渲染队列排序、多线程录制命令以及每帧统计。
+//***************************************************************************************
+
+#ifndef SCENERENDERER_H
+#define SCENERENDERER_H
+
+#include "RenderDevice.h"
+#include "SceneConstants.h"
+#include "ForestScene.h"
+#include "GeometryPool.h"
+#include "InstanceBuilder.h"
+#include "RenderQueue.h"
+#include "ConstantRing.h"
+#include "FrameStats.h"
+#include "FrustumCuller.h"
+#include "CellOctree.h"
+#include "OcclusionCuller.h"
+#include "JobSystem.h"
+#include "ParallelSubmitter.h"
+#include <vector>
+
+// 相机与玩家等每帧由外部给出的数据
+struct SceneView
+{
+    DirectX::XMMATRIX view;         // 已转置，直接写入常量缓冲
+    DirectX::XMMATRIX proj;         // 已转置
+    DirectX::XMMATRIX playerWorld;  // 玩家世界矩阵（未转置）
+    DirectX::XMFLOAT3 eyePos;
+    bool drawPlayer;
+};
+
+// ==== 固定步长仿真：在两步的相机和玩家状态之间插值 ====
+// 相机按世界空间的位置和朝向（四元数球面插值）插值，投影矩阵和 drawPlayer 取 current
+SceneView InterpolateSceneView(const SceneView& previous, const SceneView& current, float alpha);
+
+class SceneRenderer
+{
+public:
+    static const uint32_t kMaxInstancesPerDraw = 65536;
+    // 实例缓冲的容量：并行录制时整帧实例一次写入，超过时退回逐项上传、直接在设备上提交
+    static const uint32_t kInstanceBufferCapacity = 1024 * 1024;
+    static const uint32_t kConstantRingBytes = 1024 * 1024;
+    // 每个命令上下文至少绘制这么多实例，更少时录制和执行命令列表的开销大于并行的收益
+    static const uint32_t kMinInstancesPerCommandList = 16384;
+
+public:
+    SceneRenderer();
+
+    // pool 中 0..ForestScene::kGlyphCount-1 为四个字，playerMeshId 为玩家网格
+    // 网格按各自的顶点格式绘制，设备需要支持 SetVertexFormat 切换到的全部格式
+    // 几何池预留了容量时按容量创建可写的 VB/IB，之后可以替换网格
+    void Init(RenderDevice* pDevice, const GeometryPool* pPool, int playerMeshId);
+    // ==== 后台加载：几何池替换网格后调用，只上传新追加的数据并重新计算包围半径 ====
+    void UpdateGeometry();
+    // 设置后帧准备（剔除、实例生成、绘制项生成）作为任务执行，为空时在当前线程依次执行
+    void SetJobSystem(JobSystem* pJobSystem);
+    // 提交一帧（不含 Present）
+    void Render(const ForestScene& scene, const SceneView& view);
+
+    const FrameStats& GetLastFrameStats() const;
+    // 最近一次 Render 结束时插入的 fence（尚未 Render 过时为 0）
+    uint64_t GetLastFrameFence() const;
+
+    // ==== 遮挡剔除开关（默认开启） ====
+    void SetOcclusionCulling(bool enabled);
+    bool IsOcclusionCullingEnabled() const;
+
+private:
+    void UploadPerFrameConstants(const ForestScene& scene, const SceneView& view);
+    // ==== 常量环形缓冲：先收集本帧所有对象常量，一次 Map 写入，绘制时按偏移绑定 ====
+    uint32_t PushPerObjectConstants(DirectX::FXMMATRIX world);
+    void FlushPerObjectConstants(const ForestScene& scene);
+    void BindPerObjectConstants(CommandContext& context, uint32_t handle);
+    // ==== 帧准备：剔除 → 各 ix 切片生成实例 → 合并并生成排序后的绘制项 ====
+    struct FramePrep
+    {
+        bool drawPlayer;
+        uint32_t forestConstants;
+        uint32_t playerConstants;
+    };
+    JobSystem::JobHandle SchedulePrepare(const ForestScene& scene, const SceneView& view, const FramePrep& prep);
+    void BuildForestInstances(const ForestScene& scene);
+    void BuildDrawItems(const SceneView& view, const FramePrep& prep);
+    // ==== 并行录制：实例整帧一次写入后，按块在各命令上下文上录制绑定和绘制 ====
+    void SubmitDrawItems();
+    void UploadFrameInstances(uint32_t totalInstances);
+    void BindGeometry(CommandContext& context);
+    // ==== 顶点格式：网格切换时按需重新绑定槽0和顶点着色器，Packed 网格还要绑定位置反量化常量（b2） ====
+    void BindMeshVertices(CommandContext& context, uint32_t meshId, const GeometryPool::MeshRange* pPrevious);
+    void AccumulateVertexBytes();
+    void BeginFrameFence();
+    void EndFrameFence();
+    uint32_t UploadInstances(const InstanceData* pInstances, uint32_t count);
+    // ==== 视锥剔除：N 变化时重建八叉树，其余参数变化时只更新包围球，每帧按当前相机遍历 ====
+    void CullCells(const ForestScene& scene, const SceneView& view);
+    void BuildCellBounds(const ForestScene& scene);
+    // ==== 遮挡剔除：最近的若干个可见单元的主字作为遮挡体，剔除被完全挡住的单元 ====
+    void OccludeCells(const ForestScene& scene, const float viewProj[16]);
+
+    // ==== 渲染队列：把队列提交的绑定/绘制转成设备调用 ====
+    class QueueBackend : public RenderQueue::Backend
+    {
+    public:
+        explicit QueueBackend(SceneRenderer& renderer) : m_Renderer(renderer) {}
+        void BindMesh(uint32_t meshId) override;
+        void BindConstants(uint32_t constantsId) override;
+        void Draw(const RenderQueue::DrawItem& item) override;
+
+    private:
+        SceneRenderer& m_Renderer;
+        const GeometryPool::MeshRange* m_pMesh = nullptr;
+    };
+
+    // 录制一块绘制项的后端：实例已由 UploadFrameInstances 写好，只做绑定和绘制，可在工作线程上使用
+    class ContextBackend : public RenderQueue::Backend
+    {
+    public:
+        ContextBackend(SceneRenderer& renderer, CommandContext& context, uint32_t firstItem)
+            : m_Renderer(renderer), m_Context(context), m_NextItem(firstItem) {}
+        void BindMesh(uint32_t meshId) override;
+        void BindConstants(uint32_t constantsId) override;
+        void Draw(const RenderQueue::DrawItem& item) override;
+
+    private:
+        SceneRenderer& m_Renderer;
+        CommandContext& m_Context;
+        uint32_t m_NextItem;                // 下一次 Draw 对应的绘制项序号
+        const GeometryPool::MeshRange* m_pMesh = nullptr;
+    };
+
+private:
+    RenderDevice*               m_pDevice = nullptr;
+    JobSystem*                  m_pJobSystem = nullptr;
+    const GeometryPool*         m_pPool = nullptr;
+    int                         m_PlayerMeshId = -1;
+
+    BufferHandle                m_PoolVertexBuffer = kInvalidBuffer;
+    BufferHandle                m_PoolIndexBuffer = kInvalidBuffer;
+    uint32_t                    m_UploadedVertexBytes = 0;  // 已写入 GPU 的几何池数据
+    uint32_t                    m_UploadedIndexBytes = 0;
+    BufferHandle                m_CBPerFrameBuffer = kInvalidBuffer;
+    BufferHandle                m_CBPerObjectBuffer = kInvalidBuffer;
+    std::vector<BufferHandle>   m_MeshDecodeBuffers;        // 每个 Packed 网格的 PositionDecode，其余为无效句柄
+    std::vector<std::vector<OcclusionCuller::Box>> m_OccluderBoxes;   // 各网格的内部盒子（局部坐标），作为遮挡体
+
+    CBPerFrame                  m_CBPerFrame;
+    CBPerObject                 m_CBPerObject;
+
+    // ==== 实例化绘制：动态实例缓冲，写满后 DISCARD 重新开始 ====
+    BufferHandle                m_InstanceBuffer = kInvalidBuffer;
+    uint32_t                    m_InstanceCursor = kInstanceBufferCapacity;
+    InstanceBuilder             m_InstanceBuilder;
+    std::vector<InstanceBuilder> m_SlabBuilders;            // 并行时每个 ix 切片一个
+    // ==== 渲染队列：按（网格, 材质, 深度）排序后提交 ====
+    RenderQueue                 m_RenderQueue;
+    // ==== 并行录制 ====
+    ParallelSubmitter           m_ParallelSubmitter;
+    std::vector<uint32_t>       m_ItemStartInstances;       // 每个绘制项在实例缓冲中的起始位置
+    std::vector<uint32_t>       m_ItemWeights;              // 每个绘制项的实例数，按实例数均匀切块
+    std::vector<BufferWrite>    m_InstanceWrites;
+    std::vector<RenderQueue::Stats> m_ChunkStats;           // 每块的提交计数，录制完后按顺序合并
+
+    // ==== 常量环形缓冲（设备不支持常量缓冲偏移绑定时退回 m_CBPerObjectBuffer） ====
+    bool                        m_UseConstantRing = false;
+    BufferHandle                m_ConstantRingBuffer = kInvalidBuffer;
+    ConstantRing                m_ConstantRing;
+    std::vector<DirectX::XMFLOAT4X4> m_PendingObjectWorlds;    // 本帧待上传的对象世界矩阵（已转置）
+    std::vector<uint32_t>       m_PendingObjectOffsets;       // 对应在环形缓冲中的偏移
+    std::vector<uint8_t>        m_ObjectStaging;              // 一次写入环形缓冲前的暂存
+    std::vector<BufferWrite>    m_ObjectWrites;
+    uint64_t                    m_FrameFence = 1;            // 当前帧的 fence 编号
+
+    // ==== 视锥剔除 ====
+    float                       m_GlyphRadius = 0.0f;       // 四个字网格的最大包围半径
+    FrustumCuller               m_FrustumCuller;
+    SphereSoA                   m_CellBounds;
+    CellOctree                  m_CellOctree;
+    ForestParams                m_CellBoundsParams;         // m_CellBounds 对应的阵列参数
+    bool                        m_CellBoundsValid = false;
+    std::vector<uint8_t>        m_CellVisible;
+
+    // ==== 遮挡剔除 ====
+    static const uint32_t       kMaxOccluderCells = 32;
+    bool                        m_OcclusionCulling = true;
+    OcclusionCuller             m_OcclusionCuller;
+
+    // 当前帧的绘制统计，标题栏显示上一帧的结果
+    FrameStats                  m_FrameStats;
+    FrameStats                  m_LastFrameStats;
+};
+
+#endif
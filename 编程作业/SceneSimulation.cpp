@@ -0,0 +1,414 @@
+#include "SceneSimulation.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace DirectX;
+
+SceneSimulation::SceneSimulation()
+    : m_View()
+{
+}
+
+void SceneSimulation::Init(float aspectRatio)
+{
+    m_Scene.Init();
+    m_AspectRatio = aspectRatio;
+    // 初始化相机矩阵，UpdateCameraForCube / UpdateFlightCamera 会覆盖
+    UpdateProjectionMatrix();      // ==== 许双博第三次作业修改：初始化透视矩阵 ====
+    ApplyViewMatrix();             // ==== 视角初始化 ====
+}
+
+void SceneSimulation::SetAspectRatio(float aspectRatio)
+{
+    if (aspectRatio == m_AspectRatio)
+        return;
+    m_AspectRatio = aspectRatio;
+    UpdateProjectionMatrix();   // ==== 保持飞行相机的投影矩阵 ====
+    ApplyViewMatrix();          // ==== 视角更新 ====
+}
+
+// ==== 固定步长：dt 恒为仿真步长，相同的逐步输入得到相同的状态 ====
+void SceneSimulation::Step(InputState& input, float dt)
+{
+    ForestParams& params = m_Scene.GetParams();
+
+#define CLAMP(v, lo, hi)  ((v) < (lo) ? (lo) : ((v) > (hi) ? (hi) : (v)))
+
+    // 参数调整和开关按按下沿触发，每按一次生效一次
+    bool layoutChanged = false;
+    if (input.WasPressed(kKeyOemPlus)) { params.n = CLAMP(params.n + 1, 1, 200); layoutChanged = true; }
+    if (input.WasPressed(kKeyOemMinus)) { params.n = CLAMP(params.n - 1, 1, 200); layoutChanged = true; }
+    if (input.WasPressed(kKeyOem4)) { params.spacing = std::max(1.0f, params.spacing - 0.5f); layoutChanged = true; }
+    if (input.WasPressed(kKeyOem6)) { params.spacing = std::min(20.0f, params.spacing + 0.5f); layoutChanged = true; }
+    if (input.WasPressed(kKeyOemComma)) { params.orbitMax = std::max(0, params.orbitMax - 1); params.orbitMin = std::min(params.orbitMin, params.orbitMax); }
+    if (input.WasPressed(kKeyOemPeriod)) { params.orbitMax = std::min(6, params.orbitMax + 1); }
+    if (layoutChanged && m_CameraMode == CameraMode::AutoFit)
+        UpdateCameraForCube();
+
+    bool shiftPressed = input.IsDown(kKeyShift);
+    if (!shiftPressed)
+    {
+        // 光照开关：按 1/2/3 切换点光源、聚光灯、方向光
+        if (input.WasPressed('1')) m_Scene.ToggleLight(0);
+        if (input.WasPressed('2')) m_Scene.ToggleLight(1);
+        if (input.WasPressed('3')) m_Scene.ToggleLight(2);
+    }
+    else
+    {
+        // 同时按下 Shift 键切换视角
+        const CameraMode previousMode = m_CameraMode;
+        if (input.WasPressed('1')) SetCameraMode(CameraMode::FirstPerson);
+        else if (input.WasPressed('2')) SetCameraMode(CameraMode::ThirdPerson);
+        else if (input.WasPressed('3')) SetCameraMode(CameraMode::FreeFlight);
+        else if (input.WasPressed('0')) SetCameraMode(CameraMode::AutoFit);
+        // 切换后丢弃本步累积的鼠标增量，避免新视角一开始就跳动
+        if (m_CameraMode != previousMode)
+            input.ResetMouse();
+    }
+    // O：开关遮挡剔除，便于比较
+    if (input.WasPressed('O'))
+        m_OcclusionCulling = !m_OcclusionCulling;
+    // F9：请求捕获，由渲染线程在取到快照时开始
+    if (input.WasPressed(kKeyF9))
+        ++m_CaptureRequests;
+
+    // ==== 许双博第四次作业修改：更新光源动画和方向 ====
+    // 聚光灯位置跟随相机眼睛，方向指向相机前方
+    {
+        DirectX::XMFLOAT3 spotDir;
+        DirectX::XMStoreFloat3(&spotDir, GetForwardVector(m_CameraYaw, m_CameraPitch));
+        m_Scene.SetSpotLight(m_CameraPos, spotDir);
+    }
+    m_Scene.Update(dt);
+
+    switch (m_CameraMode)
+    {
+    case CameraMode::AutoFit:
+        UpdateCameraForCube();
+        break;
+    case CameraMode::FirstPerson:
+        UpdateFirstPersonCamera(input, dt);
+        break;
+    case CameraMode::ThirdPerson:
+        UpdateThirdPersonCamera(input, dt);
+        break;
+    case CameraMode::FreeFlight:
+    default:
+        UpdateFlightCamera(input, dt);   // ==== 许双博第三次作业修改：更新飞行相机 ====
+        break;
+    }
+}
+
+const ForestScene& SceneSimulation::GetScene() const
+{
+    return m_Scene;
+}
+
+SceneView SceneSimulation::BuildSceneView() const
+{
+    SceneView view = m_View;
+    // 第一人称时不绘制玩家自身
+    view.drawPlayer = m_CameraMode != CameraMode::FirstPerson;
+    view.playerWorld = XMMatrixScaling(1.5f, 2.5f, 1.5f) * XMMatrixRotationY(m_PlayerYaw)
+        * XMMatrixTranslation(m_PlayerPos.x, m_PlayerPos.y + 1.25f, m_PlayerPos.z);
+    view.eyePos = m_CameraPos;
+    return view;
+}
+
+CameraMode SceneSimulation::GetCameraMode() const
+{
+    return m_CameraMode;
+}
+
+bool SceneSimulation::IsOcclusionCulling() const
+{
+    return m_OcclusionCulling;
+}
+
+uint32_t SceneSimulation::GetCaptureRequests() const
+{
+    return m_CaptureRequests;
+}
+
+void SceneSimulation::UpdateCameraForCube()
+{
+    const ForestParams& params = m_Scene.GetParams();
+    float halfExtent = (params.n - 1) * params.spacing * 0.5f;
+    float radius = std::max<float>(halfExtent * 1.732051f + 8.0f, 12.0f);
+
+    XMFLOAT3 camPos(0.0f, radius * 0.45f, -radius * 1.3f);
+
+    XMVECTOR eyePos = XMLoadFloat3(&camPos);
+    XMMATRIX view = XMMatrixLookAtLH(
+        eyePos,
+        XMVectorZero(),
+        XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)
+    );
+
+    float znear = 1.0f;
+    float zfar = std::max<float>(1000.0f, radius * 6.0f);
+
+    XMMATRIX proj = XMMatrixPerspectiveFovLH(XM_PIDIV4 * 1.2f, m_AspectRatio, znear, zfar);
+
+    m_View.view = XMMatrixTranspose(view);
+    m_View.proj = XMMatrixTranspose(proj);
+
+    XMStoreFloat3(&m_CameraPos, eyePos);
+    XMVECTOR direction = XMVector3Normalize(XMVectorSubtract(XMVectorZero(), eyePos));
+    m_CameraYaw = std::atan2(XMVectorGetX(direction), XMVectorGetZ(direction));
+    float dirY = XMVectorGetY(direction);
+    dirY = std::max(-1.0f, std::min(1.0f, dirY));
+    m_CameraPitch = std::asin(dirY);
+    m_CameraRoll = 0.0f;
+}
+
+// ==== 许双博第三次作业修改：根据键鼠输入更新飞行相机 ====
+void SceneSimulation::UpdateFlightCamera(const InputState& input, float dt)
+{
+    using namespace DirectX;
+
+    // 鼠标控制偏航和俯仰
+    m_CameraYaw += input.GetMouseDeltaX() * m_MouseSensitivity;
+    m_CameraPitch += input.GetMouseDeltaY() * m_MouseSensitivity;
+
+    // 限制俯仰角避免翻折
+    const float pitchLimit = XM_PIDIV2 - 0.01f;
+    m_CameraPitch = std::max(-pitchLimit, std::min(pitchLimit, m_CameraPitch));
+
+    // 键盘桶滚，左右滚转
+    if (input.IsDown('Q'))
+        m_CameraRoll -= m_RollSpeed * dt;
+    if (input.IsDown('E'))
+        m_CameraRoll += m_RollSpeed * dt;
+
+    // 保持角度在 [-pi, pi] 范围，避免浮点漂移
+    auto WrapAngle = [](float angle)
+    {
+        while (angle > XM_PI) angle -= XM_2PI;
+        while (angle < -XM_PI) angle += XM_2PI;
+        return angle;
+    };
+    m_CameraYaw = WrapAngle(m_CameraYaw);
+    m_CameraRoll = WrapAngle(m_CameraRoll);
+
+    XMVECTOR rotation = XMQuaternionRotationRollPitchYaw(m_CameraPitch, m_CameraYaw, m_CameraRoll);
+    XMVECTOR forward = XMVector3Rotate(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), rotation);
+    XMVECTOR right = XMVector3Rotate(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), rotation);
+    XMVECTOR up = XMVector3Normalize(XMVector3Rotate(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), rotation));
+
+    XMVECTOR position = XMLoadFloat3(&m_CameraPos);
+    float moveSpeed = m_MoveSpeed;
+
+    if (input.IsDown('W'))
+        position += forward * moveSpeed * dt;
+    if (input.IsDown('S'))
+        position -= forward * moveSpeed * dt;
+    if (input.IsDown('A'))
+        position -= right * moveSpeed * dt;
+    if (input.IsDown('D'))
+        position += right * moveSpeed * dt;
+
+    XMStoreFloat3(&m_CameraPos, position);
+
+    XMMATRIX view = XMMatrixLookToLH(position, forward, up);
+    m_View.view = XMMatrixTranspose(view);
+}
+
+
+
+void SceneSimulation::UpdateFirstPersonCamera(const InputState& input, float dt)
+{
+    UpdatePlayerMovement(input, dt);
+    UpdateFirstPersonViewMatrix();
+}
+
+void SceneSimulation::UpdateThirdPersonCamera(const InputState& input, float dt)
+{
+    UpdatePlayerMovement(input, dt);
+    UpdateThirdPersonViewMatrix();
+}
+
+void SceneSimulation::UpdatePlayerMovement(const InputState& input, float dt)
+{
+    using namespace DirectX;
+
+    m_PlayerYaw += input.GetMouseDeltaX() * m_MouseSensitivity;
+    m_PlayerPitch += input.GetMouseDeltaY() * m_MouseSensitivity;
+
+    const float pitchLimit = XM_PIDIV2 - 0.01f;
+    m_PlayerPitch = std::max(-pitchLimit, std::min(pitchLimit, m_PlayerPitch));
+
+    auto WrapAngle = [](float angle)
+    {
+        while (angle > XM_PI) angle -= XM_2PI;
+        while (angle < -XM_PI) angle += XM_2PI;
+        return angle;
+    };
+    m_PlayerYaw = WrapAngle(m_PlayerYaw);
+
+    XMVECTOR forward = GetForwardVector(m_PlayerYaw, m_PlayerPitch);
+    XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+    XMVECTOR right = XMVector3Normalize(XMVector3Cross(up, forward));
+
+    XMVECTOR position = XMLoadFloat3(&m_PlayerPos);
+    float moveSpeed = m_PlayerMoveSpeed;
+
+    if (input.IsDown('W'))
+        position += forward * moveSpeed * dt;
+    if (input.IsDown('S'))
+        position -= forward * moveSpeed * dt;
+    if (input.IsDown('A'))
+        position -= right * moveSpeed * dt;
+    if (input.IsDown('D'))
+        position += right * moveSpeed * dt;
+    if (input.IsDown(kKeySpace))
+        position += up * moveSpeed * dt;
+    if (input.IsDown(kKeyControl))
+        position -= up * moveSpeed * dt;
+
+    XMStoreFloat3(&m_PlayerPos, position);
+}
+// ==== 许双博第三次作业修改：刷新飞行相机视图矩阵 ====
+void SceneSimulation::UpdateFreeFlightViewMatrix()
+{
+    using namespace DirectX;
+    XMVECTOR position = XMLoadFloat3(&m_CameraPos);
+    XMVECTOR rotation = XMQuaternionRotationRollPitchYaw(m_CameraPitch, m_CameraYaw, m_CameraRoll);
+    XMVECTOR forward = XMVector3Rotate(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), rotation);
+    XMVECTOR up = XMVector3Normalize(XMVector3Rotate(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), rotation));
+    XMMATRIX view = XMMatrixLookToLH(position, forward, up);
+    m_View.view = XMMatrixTranspose(view);
+}
+
+
+
+void SceneSimulation::UpdateFirstPersonViewMatrix()
+{
+    using namespace DirectX;
+    XMVECTOR basePos = XMLoadFloat3(&m_PlayerPos);
+    XMVECTOR eye = basePos + XMVectorSet(0.0f, m_PlayerEyeHeight, 0.0f, 0.0f);
+    XMVECTOR forward = GetForwardVector(m_PlayerYaw, m_PlayerPitch);
+    XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+    XMStoreFloat3(&m_FirstPersonEyePos, eye);
+    XMMATRIX view = XMMatrixLookToLH(eye, forward, up);
+    m_View.view = XMMatrixTranspose(view);
+}
+
+void SceneSimulation::UpdateThirdPersonViewMatrix()
+{
+    using namespace DirectX;
+    XMVECTOR basePos = XMLoadFloat3(&m_PlayerPos);
+    XMVECTOR target = basePos + XMVectorSet(0.0f, m_PlayerEyeHeight, 0.0f, 0.0f);
+    XMVECTOR forward = GetForwardVector(m_PlayerYaw, m_PlayerPitch);
+    XMVECTOR cameraPos = target - forward * m_ThirdPersonDistance + XMVectorSet(0.0f, m_ThirdPersonHeight, 0.0f, 0.0f);
+    XMStoreFloat3(&m_ThirdPersonCameraPos, cameraPos);
+    XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+    XMMATRIX view = XMMatrixLookAtLH(cameraPos, target, up);
+    m_View.view = XMMatrixTranspose(view);
+}
+
+void SceneSimulation::ApplyViewMatrix()
+{
+    switch (m_CameraMode)
+    {
+    case CameraMode::AutoFit:
+        UpdateCameraForCube();
+        break;
+    case CameraMode::FirstPerson:
+        UpdateFirstPersonViewMatrix();
+        break;
+    case CameraMode::ThirdPerson:
+        UpdateThirdPersonViewMatrix();
+        break;
+    case CameraMode::FreeFlight:
+    default:
+        UpdateFreeFlightViewMatrix();
+        break;
+    }
+}
+
+DirectX::XMVECTOR SceneSimulation::GetForwardVector(float yaw, float pitch) const
+{
+    using namespace DirectX;
+    XMVECTOR rotation = XMQuaternionRotationRollPitchYaw(pitch, yaw, 0.0f);
+    return XMVector3Normalize(XMVector3Rotate(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), rotation));
+}
+
+void SceneSimulation::SetCameraMode(CameraMode mode)
+{
+    if (m_CameraMode == mode)
+        return;
+
+    using namespace DirectX;
+
+    auto alignFromCurrentView = [this]()
+    {
+        XMVECTOR camPos = XMLoadFloat3(&m_CameraPos);
+        XMVECTOR forward = GetForwardVector(m_CameraYaw, m_CameraPitch);
+        XMVECTOR target = camPos + forward * m_ThirdPersonDistance;
+        target -= XMVectorSet(0.0f, m_ThirdPersonHeight, 0.0f, 0.0f);
+        target -= XMVectorSet(0.0f, m_PlayerEyeHeight, 0.0f, 0.0f);
+        XMStoreFloat3(&m_PlayerPos, target);
+        m_PlayerYaw = m_CameraYaw;
+        m_PlayerPitch = m_CameraPitch;
+    };
+
+    if (mode == CameraMode::FirstPerson)
+    {
+        if (m_CameraMode == CameraMode::FreeFlight || m_CameraMode == CameraMode::AutoFit)
+        {
+            m_PlayerYaw = m_CameraYaw;
+            m_PlayerPitch = m_CameraPitch;
+            m_PlayerPos = m_CameraPos;
+            m_PlayerPos.y -= m_PlayerEyeHeight;
+        }
+    }
+    else if (mode == CameraMode::ThirdPerson)
+    {
+        if (m_CameraMode == CameraMode::FreeFlight || m_CameraMode == CameraMode::AutoFit)
+        {
+            alignFromCurrentView();
+        }
+    }
+    else if (mode == CameraMode::FreeFlight)
+    {
+        if (m_CameraMode == CameraMode::FirstPerson)
+        {
+            m_CameraPos = m_FirstPersonEyePos;
+            m_CameraYaw = m_PlayerYaw;
+            m_CameraPitch = m_PlayerPitch;
+        }
+        else if (m_CameraMode == CameraMode::ThirdPerson)
+        {
+            m_CameraPos = m_ThirdPersonCameraPos;
+            m_CameraYaw = m_PlayerYaw;
+            m_CameraPitch = m_PlayerPitch;
+        }
+    }
+
+    if (mode != CameraMode::FreeFlight)
+    {
+        m_CameraRoll = 0.0f;
+    }
+
+    m_CameraMode = mode;
+
+    if (mode == CameraMode::AutoFit)
+    {
+        UpdateCameraForCube();
+    }
+    else
+    {
+        UpdateProjectionMatrix();
+        ApplyViewMatrix();
+    }
+}
+
+// ==== 许双博第三次作业修改：刷新飞行相机投影矩阵 ====
+void SceneSimulation::UpdateProjectionMatrix()
+{
+    using namespace DirectX;
+    float aspect = m_AspectRatio;
+    float fov = XM_PIDIV4 * 1.1f;
+    m_View.proj = XMMatrixTranspose(XMMatrixPerspectiveFovLH(fov, aspect, 0.1f, 2000.0f));
+}
@@ -0,0 +1,92 @@
+//***************************************************************************************
+// SceneSimulation.h
+//
+// 场景仿真状态：字符森林、四种视角的相机、玩家、遮挡剔除开关和捕获请求。
+// 每次 Step 按 InputState 中本步的按键和鼠标增量推进一个固定步长，
+// 只依赖输入和 dt，不涉及窗口、线程和 D3D。
+// GameApp 在仿真线程上驱动它；测试中可以直接驱动，比较两次运行的状态是否逐位相同。
+//***************************************************************************************
+
+#ifndef SCENESIMULATION_H
+#define SCENESIMULATION_H
+
+#include "ForestScene.h"
+#include "SceneRenderer.h"
+#include "InputState.h"
+
+// 视角
+enum class CameraMode
+{
+    AutoFit,
+    FirstPerson,
+    ThirdPerson,
+    FreeFlight
+};
+
+class SceneSimulation
+{
+public:
+    SceneSimulation();
+
+    // 初始化场景和相机矩阵
+    void Init(float aspectRatio);
+    // 宽高比变化时更新投影矩阵
+    void SetAspectRatio(float aspectRatio);
+    // 推进一步：按键调整参数和开关、光源动画、相机和玩家移动；切换视角时调用 input.ResetMouse()
+    void Step(InputState& input, float dt);
+
+    const ForestScene& GetScene() const;
+    // 相机矩阵（已转置）与玩家状态
+    SceneView BuildSceneView() const;
+    CameraMode GetCameraMode() const;
+    bool IsOcclusionCulling() const;
+    // 累计的捕获请求（F9）
+    uint32_t GetCaptureRequests() const;
+
+private:
+    void UpdateCameraForCube();
+    // ==== 许双博第三次作业修改：飞行相机辅助函数 ====
+    void UpdateFlightCamera(const InputState& input, float dt);
+    void UpdateProjectionMatrix();
+    // ==== 视角切换 ====
+    void SetCameraMode(CameraMode mode);
+    void UpdateFirstPersonCamera(const InputState& input, float dt);
+    void UpdateThirdPersonCamera(const InputState& input, float dt);
+    void UpdatePlayerMovement(const InputState& input, float dt);
+    void UpdateFreeFlightViewMatrix();
+    void UpdateFirstPersonViewMatrix();
+    void UpdateThirdPersonViewMatrix();
+    void ApplyViewMatrix();
+    DirectX::XMVECTOR GetForwardVector(float yaw, float pitch) const;
+
+private:
+    ForestScene m_Scene;
+    SceneView   m_View;             // 只使用 view / proj，其余在 BuildSceneView 中填写
+    float       m_AspectRatio = 1.0f;
+    bool        m_OcclusionCulling = true;
+    uint32_t    m_CaptureRequests = 0;
+
+    // ==== 许双博第三次作业修改：飞行相机状态 ====
+    DirectX::XMFLOAT3 m_CameraPos = DirectX::XMFLOAT3(0.0f, 20.0f, -80.0f);
+    float   m_CameraYaw = 0.0f;
+    float   m_CameraPitch = -0.25f;
+    float   m_CameraRoll = 0.0f;
+    float   m_MoveSpeed = 15.0f;// 移动速度
+    float   m_RollSpeed = DirectX::XMConvertToRadians(30.0f);// 转动速度
+    float   m_MouseSensitivity = 0.0025f;
+
+    CameraMode m_CameraMode = CameraMode::FreeFlight;
+
+    // ==== 角色状态 ====
+    DirectX::XMFLOAT3 m_PlayerPos = DirectX::XMFLOAT3(0.0f, 0.0f, -40.0f);
+    float   m_PlayerYaw = 0.0f;
+    float   m_PlayerPitch = 0.0f;
+    float   m_PlayerMoveSpeed = 15.0f;// 移动速度
+    float   m_PlayerEyeHeight = 1.5f;
+    float   m_ThirdPersonDistance = 15.0f;
+    float   m_ThirdPersonHeight = 4.0f;
+    DirectX::XMFLOAT3 m_FirstPersonEyePos = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+    DirectX::XMFLOAT3 m_ThirdPersonCameraPos = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+};
+
+#endif
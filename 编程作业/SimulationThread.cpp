@@ -0,0 +1,142 @@
+#include "SimulationThread.h"
+#include <algorithm>
+#include <cmath>
+
+SimulationThread::SimulationThread(MonotonicClock& clock)
+    : m_Clock(clock)
+{
+}
+
+SimulationThread::~SimulationThread()
+{
+    Stop();
+}
+
+void SimulationThread::Start(StepFunction step, PublishFunction publish, double stepRate)
+{
+    Reset(std::move(step), std::move(publish), stepRate);
+    m_Thread = std::thread(&SimulationThread::ThreadMain, this);
+}
+
+void SimulationThread::StartManual(StepFunction step, PublishFunction publish, double stepRate)
+{
+    Reset(std::move(step), std::move(publish), stepRate);
+}
+
+void SimulationThread::Reset(StepFunction step, PublishFunction publish, double stepRate)
+{
+    Stop();
+    m_Step = std::move(step);
+    m_Publish = std::move(publish);
+    if (stepRate <= 0.0)
+        stepRate = 120.0;
+    m_StepSeconds = static_cast<float>(1.0 / stepRate);
+    m_StepNs = std::max<uint64_t>(1, static_cast<uint64_t>(std::llround(1e9 / stepRate)));
+    m_StartNs = m_Clock.NowNs();
+    m_DroppedNs = 0;
+    m_DroppedSteps = 0;
+    m_TickCount = 0;
+    m_Quit = false;
+    m_Running = true;
+}
+
+void SimulationThread::Stop()
+{
+    if (m_Thread.joinable())
+    {
+        m_Quit = true;
+        m_Thread.join();
+    }
+    m_Running = false;
+}
+
+bool SimulationThread::IsRunning() const
+{
+    return m_Running.load();
+}
+
+float SimulationThread::GetStepSeconds() const
+{
+    return m_StepSeconds;
+}
+
+uint64_t SimulationThread::GetStepNs() const
+{
+    return m_StepNs;
+}
+
+uint64_t SimulationThread::GetTickCount() const
+{
+    return m_TickCount.load(std::memory_order_acquire);
+}
+
+uint64_t SimulationThread::GetInputTick() const
+{
+    // 还没开始时返回 0，事件在第一步处理
+    if (!IsRunning())
+        return 0;
+    // 第 k 步在仿真时钟到达 k * 步长时执行，此刻之后第一个到期的步就是事件所属的步
+    // 仿真线程落后时，它补步时在同一步处理这个事件，与补步的批次无关
+    uint64_t tick = GetSimulationClock() / m_StepNs + 1;
+    return std::max(tick, GetTickCount() + 1);
+}
+
+uint64_t SimulationThread::GetDroppedSteps() const
+{
+    return m_DroppedSteps.load(std::memory_order_relaxed);
+}
+
+float SimulationThread::GetInterpolationAlpha(uint64_t tick) const
+{
+    if (!IsRunning())
+        return 1.0f;
+    double sinceTick = static_cast<double>(GetSimulationClock()) - static_cast<double>(tick * m_StepNs);
+    float alpha = static_cast<float>(sinceTick / static_cast<double>(m_StepNs));
+    return std::max(0.0f, std::min(1.0f, alpha));
+}
+
+uint64_t SimulationThread::GetSimulationClock() const
+{
+    return m_Clock.NowNs() - m_StartNs - m_DroppedNs.load(std::memory_order_acquire);
+}
+
+int SimulationThread::Pump()
+{
+    const uint64_t now = GetSimulationClock();
+    uint64_t tick = m_TickCount.load(std::memory_order_relaxed);     // 只有调用 Pump 的线程修改
+
+    // 落后超过 kMaxBacklogSteps 步时丢弃多出的整步，仿真时钟随之后移，不足一步的部分保留
+    const uint64_t due = now / m_StepNs;
+    if (due > tick + kMaxBacklogSteps)
+    {
+        const uint64_t dropped = due - tick - kMaxBacklogSteps;
+        m_DroppedSteps.fetch_add(dropped, std::memory_order_relaxed);
+        m_DroppedNs.fetch_add(dropped * m_StepNs, std::memory_order_release);
+    }
+    const uint64_t target = std::min(due, tick + kMaxBacklogSteps);
+
+    int steps = 0;
+    while (tick < target && steps < kMaxStepsPerWake)
+    {
+        ++tick;
+        m_Step(tick, m_StepSeconds);
+        m_TickCount.store(tick, std::memory_order_release);
+        ++steps;
+    }
+    if (steps > 0 && m_Publish)
+        m_Publish();
+    return steps;
+}
+
+void SimulationThread::ThreadMain()
+{
+    while (!m_Quit)
+    {
+        Pump();
+        // 一批没补完时不休眠，发布后接着补；否则睡到下一步到期
+        const uint64_t now = GetSimulationClock();
+        const uint64_t next = (GetTickCount() + 1) * m_StepNs;
+        if (next > now)
+            m_Clock.SleepNs(next - now);
+    }
+}
@@ -0,0 +1,87 @@
+//***************************************************************************************
+// SimulationThread.h
+//
+// 仿真线程：在独立线程上以固定步长推进仿真（累加器方式），每次醒来补足落后的步数后
+// 调用一次发布函数。步长固定，相同的逐步输入总会得到相同的状态，与渲染帧率无关。
+// 渲染线程通过 TripleBuffer 读取发布的快照，并用 GetInterpolationAlpha 在快照中
+// 上一步与当前步的状态之间插值（画面比仿真晚一步，但不会抖动）。
+// 时间取自 MonotonicClock，步长以整数纳秒累计；测试中可以传入 FakeClock，
+// 用 StartManual + Pump 在调用方线程上逐次推进，不启动线程。
+// 输入事件按 GetInputTick 打上所属的步号，补步时每个事件仍在它所属的那一步生效，
+// 结果与每次醒来执行了几步无关。
+// 每次醒来最多执行 kMaxStepsPerWake 步，之后先发布再接着补，落后的时间不会丢失；
+// 只有落后超过 kMaxBacklogSteps 步（例如调试断点）时才丢弃多出的整步，
+// 丢弃的步数计入 GetDroppedSteps。
+//***************************************************************************************
+
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include "MonotonicClock.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+class SimulationThread
+{
+public:
+    static const int kMaxStepsPerWake = 5;
+    static const int kMaxBacklogSteps = 120;    // 120Hz 时约 1 秒
+
+    // tick 为本步的步号（从 1 开始，执行完后 GetTickCount() == tick），dt 为固定步长（秒）
+    typedef std::function<void(uint64_t tick, float dt)> StepFunction;
+    // 一次醒来执行完一批步后调用，用于发布快照
+    typedef std::function<void()> PublishFunction;
+
+public:
+    explicit SimulationThread(MonotonicClock& clock = MonotonicClock::GetSystemClock());
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // 以每秒 stepRate 步的固定步长在独立线程上运行
+    void Start(StepFunction step, PublishFunction publish, double stepRate);
+    // 不启动线程，由调用方反复调用 Pump 推进
+    void StartManual(StepFunction step, PublishFunction publish, double stepRate);
+    // 执行已到期的步（最多 kMaxStepsPerWake 步），执行过时调用发布函数，返回执行的步数
+    // 线程模式下由仿真线程调用，手动模式下由调用方调用
+    int Pump();
+    // 等当前一步执行完后退出线程，可重复调用
+    void Stop();
+
+    bool IsRunning() const;
+    float GetStepSeconds() const;
+    uint64_t GetStepNs() const;
+    // 已执行的步数（任意线程可读），第 k 步结束时的状态对应仿真时间 k * 步长
+    uint64_t GetTickCount() const;
+    // 消息线程：此刻产生的输入事件所属的步号，该步开始时生效；未运行时为 0
+    uint64_t GetInputTick() const;
+    // 落后太多时丢弃的步数
+    uint64_t GetDroppedSteps() const;
+    // 渲染线程：当前时刻在第 tick - 1 步与第 tick 步状态之间的插值系数 [0, 1]
+    float GetInterpolationAlpha(uint64_t tick) const;
+
+private:
+    void Reset(StepFunction step, PublishFunction publish, double stepRate);
+    void ThreadMain();
+    // 从 Start 起扣除丢弃时间后的仿真时钟（纳秒）
+    uint64_t GetSimulationClock() const;
+
+private:
+    MonotonicClock& m_Clock;
+    std::thread m_Thread;
+    StepFunction m_Step;
+    PublishFunction m_Publish;
+    uint64_t m_StepNs = 8333333;
+    float m_StepSeconds = 1.0f / 120.0f;
+    uint64_t m_StartNs = 0;                         // Start 时设置，运行期间只读
+    std::atomic<uint64_t> m_DroppedNs{ 0 };         // 丢弃的时间，总是步长的整数倍
+    std::atomic<uint64_t> m_DroppedSteps{ 0 };
+    std::atomic<bool> m_Running{ false };
+    std::atomic<bool> m_Quit{ false };
+    std::atomic<uint64_t> m_TickCount{ 0 };
+};
+
+#endif
@@ -0,0 +1,71 @@
+//***************************************************************************************
+// SpscRing.h
+//
+// 无锁单生产者单消费者环形队列：容量固定为 2 的幂，读写位置各自只被一个线程修改，
+// 满了 Push 返回 false（由调用方决定丢弃），空了 Pop 返回 false，双方都不会阻塞。
+// 两个位置放在不同的缓存行，避免生产者和消费者互相使对方的缓存行失效。
+//***************************************************************************************
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstdint>
+
+template <class T, uint32_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity 必须是 2 的幂");
+
+public:
+    SpscRing() = default;
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // ==== 生产者 ====
+    bool Push(const T& item)
+    {
+        const uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+        if (tail - m_Head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        m_Items[tail & (Capacity - 1)] = item;
+        m_Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ==== 消费者 ====
+    bool Pop(T& item)
+    {
+        const uint32_t head = m_Head.load(std::memory_order_relaxed);
+        if (head == m_Tail.load(std::memory_order_acquire))
+            return false;
+        item = m_Items[head & (Capacity - 1)];
+        m_Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 查看队头元素但不取出，之后 Pop 取到的就是它
+    bool Peek(T& item) const
+    {
+        const uint32_t head = m_Head.load(std::memory_order_relaxed);
+        if (head == m_Tail.load(std::memory_order_acquire))
+            return false;
+        item = m_Items[head & (Capacity - 1)];
+        return true;
+    }
+
+    // 近似值，仅供统计
+    uint32_t Size() const
+    {
+        return m_Tail.load(std::memory_order_acquire) - m_Head.load(std::memory_order_acquire);
+    }
+
+private:
+    // 读写位置单调递增，取模后作为下标；差值即元素个数（无符号回绕也成立）
+    alignas(64) std::atomic<uint32_t> m_Head{ 0 };
+    alignas(64) std::atomic<uint32_t> m_Tail{ 0 };
+    alignas(64) T m_Items[Capacity]{};
+};
+
+#endif
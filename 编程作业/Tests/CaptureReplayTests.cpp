@@ -0,0 +1,294 @@
+//***************************************************************************************
+// CaptureReplayTests.cpp
+//
+// 帧命令流捕获与回放：在 NullRenderDevice 上捕获一帧，经 MappedFile 映射后在新设备上回放，
+// 回放时再捕获一次，两份文件逐条记录相同（CompareCaptures 返回 -1）；
+// 改动其中一次绘制时，CompareCaptures 报告的正是这条绘制记录的序号。
+// 截断、记录长度越界或不对齐、句柄和写入段数超出范围的文件必须被拒绝。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "CaptureRenderDevice.h"
+#include "CaptureReplay.h"
+#include "MappedFile.h"
+#include "NullRenderDevice.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    const char* const kCapturePath = "CaptureReplayTests_tmp.gfcp";
+    const char* const kRecapturePath = "CaptureReplayTests_tmp2.gfcp";
+    const uint32_t kDrawsPerFrame = 6;
+    const uint32_t kNoMutation = UINT32_MAX;
+
+    struct Buffers
+    {
+        BufferHandle vertices = kInvalidBuffer;
+        BufferHandle indices = kInvalidBuffer;
+        BufferHandle constants = kInvalidBuffer;
+    };
+
+    Buffers CreateBuffers(RenderDevice& device)
+    {
+        std::vector<float> vertices(64 * 10);
+        for (size_t i = 0; i < vertices.size(); ++i)
+            vertices[i] = static_cast<float>(i) * 0.25f;
+        std::vector<uint16_t> indices(96);
+        for (size_t i = 0; i < indices.size(); ++i)
+            indices[i] = static_cast<uint16_t>(i % 64);
+
+        Buffers buffers;
+        buffers.vertices = device.CreateBuffer({ BufferType::Vertex, BufferUsage::Immutable,
+            static_cast<uint32_t>(vertices.size() * sizeof(float)), "Vertices" }, vertices.data());
+        buffers.indices = device.CreateBuffer({ BufferType::Index, BufferUsage::Immutable,
+            static_cast<uint32_t>(indices.size() * sizeof(uint16_t)), "Indices" }, indices.data());
+        buffers.constants = device.CreateBuffer({ BufferType::Constant, BufferUsage::Dynamic, 256, "Constants" }, nullptr);
+        return buffers;
+    }
+
+    // 一帧：清屏、绑定、写常量、若干次绘制、fence、Present；mutatedDraw 指定的那次绘制多画一个实例
+    void SubmitFrame(RenderDevice& device, const Buffers& buffers, uint64_t fence, uint32_t mutatedDraw = kNoMutation)
+    {
+        const float color[4] = { 0.1f, 0.2f, 0.3f, 1.0f };
+        device.Clear(color);
+        const uint32_t stride = 40, offset = 0;
+        device.SetVertexBuffers(0, 1, &buffers.vertices, &stride, &offset);
+        device.SetIndexBuffer(buffers.indices);
+        device.SetVertexFormat(VertexFormat::Float);
+
+        float constants[16];
+        for (int i = 0; i < 16; ++i)
+            constants[i] = static_cast<float>(fence * 16 + i);
+        device.WriteBuffer(buffers.constants, MapMode::Discard, 0, constants, sizeof(constants));
+        device.SetConstantBuffer(0, buffers.constants);
+
+        for (uint32_t draw = 0; draw < kDrawsPerFrame; ++draw)
+        {
+            const uint32_t instances = 10 + draw + (draw == mutatedDraw ? 1 : 0);
+            device.DrawIndexedInstanced(12, instances, draw * 12, 0, draw * 100);
+        }
+        device.InsertFence(fence);
+        device.Present();
+    }
+
+    // 在新设备上创建缓冲后捕获一帧
+    bool CaptureFrame(const char* path, uint32_t mutatedDraw = kNoMutation)
+    {
+        NullRenderDevice inner;
+        CaptureRenderDevice capture(&inner);
+        const Buffers buffers = CreateBuffers(capture);
+        if (!capture.BeginCapture(path, 1))
+            return false;
+        SubmitFrame(capture, buffers, 1, mutatedDraw);
+        return !capture.IsCapturing();
+    }
+
+    std::vector<uint8_t> ReadAll(const char* path)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+            return std::vector<uint8_t>();
+        return std::vector<uint8_t>(file.GetData(), file.GetData() + file.GetSize());
+    }
+
+    // 第 nth 条 type 类型记录的序号和偏移
+    bool FindRecord(const std::vector<uint8_t>& data, CaptureCommandType type, uint32_t nth,
+        int64_t* pIndex, size_t* pOffset)
+    {
+        CaptureReader reader;
+        if (!reader.Open(data.data(), data.size()))
+            return false;
+        const CaptureCommandHeader* pCommand = nullptr;
+        uint32_t seen = 0;
+        while (reader.Next(&pCommand))
+        {
+            if (pCommand->type == static_cast<uint16_t>(type) && seen++ == nth)
+            {
+                *pIndex = reader.GetCommandIndex() - 1;
+                *pOffset = reinterpret_cast<const uint8_t*>(pCommand) - data.data();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <class T>
+    T& BodyAt(std::vector<uint8_t>& data, size_t offset)
+    {
+        return *reinterpret_cast<T*>(data.data() + offset + sizeof(CaptureCommandHeader));
+    }
+
+    bool Replays(const std::vector<uint8_t>& data)
+    {
+        NullRenderDevice device;
+        CaptureReplayer replayer(&device);
+        return replayer.Replay(data.data(), data.size());
+    }
+}
+
+// ==== 捕获 → 回放 → 再捕获 ====
+TEST_CASE(ReplayThenRecaptureIsIdentical)
+{
+    CHECK(CaptureFrame(kCapturePath));
+    MappedFile original;
+    CHECK(original.Open(kCapturePath));
+
+    // 在新设备上边回放边捕获：缓冲在捕获期间创建，和原文件一样出现在开头
+    NullRenderDevice inner;
+    CaptureRenderDevice capture(&inner);
+    CaptureReplayer replayer(&capture);
+    CHECK(capture.BeginCapture(kRecapturePath, 1));
+    CHECK(replayer.Replay(original.GetData(), original.GetSize()));
+    CHECK(!capture.IsCapturing());
+    CHECK(replayer.GetStats().frames == 1);
+    CHECK(replayer.GetStats().drawCalls == kDrawsPerFrame);
+    CHECK(inner.GetStats().bufferCreates == 3);
+    CHECK(inner.GetStats().drawCalls == kDrawsPerFrame);
+
+    MappedFile recaptured;
+    CHECK(recaptured.Open(kRecapturePath));
+    CHECK(CompareCaptures(original.GetData(), original.GetSize(),
+        recaptured.GetData(), recaptured.GetSize()) == -1);
+    CaptureReader reader;
+    CHECK(reader.Open(recaptured.GetData(), recaptured.GetSize()));
+    CHECK(reader.GetHeader().frameCount == 1);
+
+    original.Close();
+    recaptured.Close();
+    remove(kCapturePath);
+    remove(kRecapturePath);
+}
+
+TEST_CASE(MutatedDrawIsReportedAtItsRecordIndex)
+{
+    CHECK(CaptureFrame(kCapturePath));
+    const std::vector<uint8_t> original = ReadAll(kCapturePath);
+    for (uint32_t mutated : { 0u, 3u, kDrawsPerFrame - 1 })
+    {
+        CHECK(CaptureFrame(kRecapturePath, mutated));
+        const std::vector<uint8_t> changed = ReadAll(kRecapturePath);
+        int64_t expected = -1;
+        size_t offset = 0;
+        CHECK(FindRecord(original, CaptureCommandType::DrawIndexedInstanced, mutated, &expected, &offset));
+        CHECK(expected > 0);
+        CHECK(CompareCaptures(original.data(), original.size(), changed.data(), changed.size()) == expected);
+        CHECK(CompareCaptures(changed.data(), changed.size(), original.data(), original.size()) == expected);
+    }
+    remove(kCapturePath);
+    remove(kRecapturePath);
+}
+
+// ==== 损坏的文件 ====
+TEST_CASE(TruncatedCaptureIsRejected)
+{
+    CHECK(CaptureFrame(kCapturePath));
+    const std::vector<uint8_t> original = ReadAll(kCapturePath);
+    remove(kCapturePath);
+    CHECK(Replays(original));
+
+    // 文件比文件头声明的短
+    std::vector<uint8_t> truncated(original.begin(), original.end() - 8);
+    CHECK(!Replays(truncated));
+    CHECK(CompareCaptures(original.data(), original.size(), truncated.data(), truncated.size()) == 0);
+
+    // 文件头改成截断后的长度：最后一条记录越界，读取时报错
+    int64_t index = -1;
+    size_t offset = 0;
+    CHECK(FindRecord(original, CaptureCommandType::DrawIndexedInstanced, 2, &index, &offset));
+    truncated.assign(original.begin(), original.begin() + offset + 16);
+    CaptureHeader header;
+    memcpy(&header, truncated.data(), sizeof(header));
+    header.commandBytes = truncated.size() - sizeof(CaptureHeader);
+    memcpy(truncated.data(), &header, sizeof(header));
+    CHECK(!Replays(truncated));
+    CaptureReader reader;
+    CHECK(reader.Open(truncated.data(), truncated.size()));
+    const CaptureCommandHeader* pCommand = nullptr;
+    while (reader.Next(&pCommand))
+    {
+    }
+    CHECK(reader.HasError());
+    CHECK(reader.GetCommandIndex() == index);
+    CHECK(CompareCaptures(original.data(), original.size(), truncated.data(), truncated.size()) == index);
+
+    // 文件头本身不完整
+    truncated.assign(original.begin(), original.begin() + sizeof(CaptureHeader) - 1);
+    CHECK(!Replays(truncated));
+}
+
+TEST_CASE(OversizedOrMisalignedRecordsAreRejected)
+{
+    CHECK(CaptureFrame(kCapturePath));
+    const std::vector<uint8_t> original = ReadAll(kCapturePath);
+    remove(kCapturePath);
+    int64_t index = -1;
+    size_t offset = 0;
+    CHECK(FindRecord(original, CaptureCommandType::DrawIndexedInstanced, 0, &index, &offset));
+
+    const uint32_t badSizes[] = { 0, 4, sizeof(CaptureCommandHeader) + 12, static_cast<uint32_t>(original.size()), UINT32_MAX - 7 };
+    for (uint32_t size : badSizes)
+    {
+        std::vector<uint8_t> data = original;
+        reinterpret_cast<CaptureCommandHeader*>(data.data() + offset)->size = size;
+        CHECK(!Replays(data));
+    }
+
+    // 记录长度合法但小于它的类型所需的长度
+    std::vector<uint8_t> data = original;
+    reinterpret_cast<CaptureCommandHeader*>(data.data() + offset)->type =
+        static_cast<uint16_t>(CaptureCommandType::SetVertexBuffers);
+    CHECK(!Replays(data));
+
+    // 未知类型
+    data = original;
+    reinterpret_cast<CaptureCommandHeader*>(data.data() + offset)->type = 0x7fff;
+    CHECK(!Replays(data));
+}
+
+TEST_CASE(OutOfRangeFieldsAreRejected)
+{
+    CHECK(CaptureFrame(kCapturePath));
+    const std::vector<uint8_t> original = ReadAll(kCapturePath);
+    remove(kCapturePath);
+    int64_t index = -1;
+    size_t create = 0, write = 0;
+    CHECK(FindRecord(original, CaptureCommandType::CreateBuffer, 0, &index, &create));
+    CHECK(FindRecord(original, CaptureCommandType::WriteBuffer, 0, &index, &write));
+
+    // 句柄决定映射表的大小：超过上限时拒绝，不会按句柄分配映射表
+    const uint32_t badHandles[] = { kInvalidBuffer, kCaptureMaxBuffers, UINT32_MAX - 1, UINT32_MAX };
+    for (uint32_t handle : badHandles)
+    {
+        std::vector<uint8_t> data = original;
+        BodyAt<CaptureCreateBuffer>(data, create).handle = handle;
+        NullRenderDevice device;
+        CaptureReplayer replayer(&device);
+        CHECK(!replayer.Replay(data.data(), data.size()));
+        CHECK(device.GetStats().bufferCreates == 0);
+    }
+
+    // 初始数据比记录长
+    std::vector<uint8_t> data = original;
+    BodyAt<CaptureCreateBuffer>(data, create).byteWidth = UINT32_MAX;
+    CHECK(!Replays(data));
+
+    // 写入段数或段长超出记录
+    data = original;
+    BodyAt<CaptureWriteBuffer>(data, write).writeCount = UINT32_MAX;
+    CHECK(!Replays(data));
+    data = original;
+    BodyAt<CaptureWriteBuffer>(data, write).writeCount = 0x20000000;
+    CHECK(!Replays(data));
+    data = original;
+    reinterpret_cast<CaptureWriteRange*>(&BodyAt<CaptureWriteBuffer>(data, write) + 1)->size = UINT32_MAX;
+    CHECK(!Replays(data));
+
+    // 写入没有创建过的句柄
+    data = original;
+    BodyAt<CaptureWriteBuffer>(data, write).handle = 999;
+    CHECK(!Replays(data));
+}
+
+TEST_MAIN()
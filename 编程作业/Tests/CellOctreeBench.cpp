@@ -0,0 +1,61 @@
+//***************************************************************************************
+// CellOctreeBench.cpp
+//
+// 层次剔除与逐单元剔除的比较：n³ 个单元（n = 100、200）按四种视角分别用 FrustumCuller 逐个测试
+// 和用 CellOctree 由近到远遍历，报告每帧耗时和包围球测试次数。
+// 用法：CellOctreeBench [-quick]
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestCamera.h"
+#include "CellOctree.h"
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    const int sizes[] = { 100, 200 };
+    const int quickSizes[] = { 20 };
+    const int* pSizes = quick ? quickSizes : sizes;
+    const int sizeCount = quick ? 1 : 2;
+    const int frames = quick ? 3 : 20;
+    const float spacing = 4.5f;
+
+    printf("%6s %-12s %12s %12s %14s %14s %10s\n", "n", "视角", "逐单元 ms", "八叉树 ms", "逐单元测试", "八叉树测试", "可见");
+    for (int s = 0; s < sizeCount; ++s)
+    {
+        const int n = pSizes[s];
+        SphereSoA bounds;
+        TestCamera::BuildGrid(n, spacing, 3.0f, bounds);
+        CellOctree octree;
+        octree.Build(n);
+        octree.Refit(bounds);
+        std::vector<uint8_t> visible(bounds.Size());
+        TestCamera::Camera cameras[4];
+        TestCamera::MakeForestCameras(n, spacing, cameras);
+
+        for (const TestCamera::Camera& camera : cameras)
+        {
+            float viewProj[16];
+            TestCamera::MakeViewProj(camera, viewProj);
+            FrustumCuller frustum;
+            frustum.SetViewProj(viewProj);
+
+            TestCommon::BenchTimer flatTimer;
+            uint32_t flatVisible = 0;
+            for (int frame = 0; frame < frames; ++frame)
+                flatVisible = frustum.Cull(bounds, visible.data());
+            const double flatMs = flatTimer.GetSeconds() * 1000.0 / frames;
+
+            TestCommon::BenchTimer octreeTimer;
+            for (int frame = 0; frame < frames; ++frame)
+                octree.Cull(frustum, camera.eye[0], camera.eye[1], camera.eye[2], visible.data());
+            const double octreeMs = octreeTimer.GetSeconds() * 1000.0 / frames;
+
+            const CellOctree::CullStats& stats = octree.GetStats();
+            TestCommon::KeepAlive(flatVisible);
+            printf("%6d %-12s %12.3f %12.3f %14u %14u %9.1f%%\n", n, camera.name, flatMs, octreeMs,
+                static_cast<uint32_t>(bounds.Size()), stats.Tests(), 100.0 * stats.cellsVisible / bounds.Size());
+        }
+    }
+    return 0;
+}
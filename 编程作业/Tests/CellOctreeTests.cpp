@@ -0,0 +1,226 @@
+//***************************************************************************************
+// CellOctreeTests.cpp
+//
+// CellOctree：拓扑覆盖每个单元一次、节点包围球包含子节点，
+// 剔除结果与逐单元剔除一致（只允许在视锥边界上因舍入不同），可见单元大致由近到远。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestCamera.h"
+#include "CellOctree.h"
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    float DistanceToEye(const SphereSoA& bounds, uint32_t cell, const float eye[3])
+    {
+        const float dx = bounds.x[cell] - eye[0], dy = bounds.y[cell] - eye[1], dz = bounds.z[cell] - eye[2];
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    // 球到最近的视锥平面的余量，接近 0 表示压在边界上
+    float PlaneMargin(const FrustumCuller& frustum, const SphereSoA& bounds, uint32_t cell)
+    {
+        float margin = 1e30f;
+        for (int i = 0; i < 6; ++i)
+        {
+            const float* p = frustum.GetPlane(i);
+            const float dist = p[0] * bounds.x[cell] + p[1] * bounds.y[cell] + p[2] * bounds.z[cell] + p[3];
+            margin = std::min(margin, std::fabs(dist + bounds.r[cell]));
+        }
+        return margin;
+    }
+
+    // 八叉树与逐单元剔除的结果不一致的单元都必须压在视锥边界上
+    void CheckMatchesFlat(int n, const float viewProj[16], const float eye[3], float spacing, float radius)
+    {
+        SphereSoA bounds;
+        TestCamera::BuildGrid(n, spacing, radius, bounds);
+        CellOctree octree;
+        octree.Build(n);
+        octree.Refit(bounds);
+
+        FrustumCuller frustum;
+        frustum.SetViewProj(viewProj);
+        std::vector<uint8_t> flat(bounds.Size()), hierarchical(bounds.Size());
+        const uint32_t flatVisible = frustum.Cull(bounds, flat.data());
+        octree.Cull(frustum, eye[0], eye[1], eye[2], hierarchical.data());
+
+        uint32_t mismatches = 0, offBoundary = 0;
+        for (uint32_t cell = 0; cell < bounds.Size(); ++cell)
+        {
+            if (flat[cell] == hierarchical[cell])
+                continue;
+            ++mismatches;
+            if (PlaneMargin(frustum, bounds, cell) > 1e-3f)
+                ++offBoundary;
+        }
+        CHECK(offBoundary == 0);
+        CHECK(mismatches <= flatVisible / 1000 + 1);
+        CHECK(octree.GetStats().cellsVisible == octree.GetVisibleCells().size());
+    }
+}
+
+TEST_CASE(EveryCellAppearsOnce)
+{
+    const int n = 13;      // 不是 2 的幂，切分不均匀
+    SphereSoA bounds;
+    TestCamera::BuildGrid(n, 4.5f, 1.0f, bounds);
+    CellOctree octree;
+    octree.Build(n);
+    octree.Refit(bounds);
+    CHECK(octree.GetCellCount() == static_cast<uint32_t>(n * n * n));
+    CHECK(octree.GetNodes()[0].cellCount == octree.GetCellCount());
+
+    // 默认视锥接受一切：所有单元都出现在可见列表中，且只出现一次
+    FrustumCuller everything;
+    std::vector<uint8_t> visible(bounds.Size());
+    octree.Cull(everything, 0.0f, 0.0f, 0.0f, visible.data());
+    std::vector<uint32_t> cells = octree.GetVisibleCells();
+    std::sort(cells.begin(), cells.end());
+    CHECK(cells.size() == bounds.Size());
+    bool permutation = true;
+    for (uint32_t i = 0; i < cells.size(); ++i)
+        permutation = permutation && cells[i] == i;
+    CHECK(permutation);
+}
+
+TEST_CASE(NodeSpheresContainChildren)
+{
+    const int n = 20;
+    SphereSoA bounds;
+    TestCamera::BuildGrid(n, 4.5f, 3.0f, bounds);
+    CellOctree octree;
+    octree.Build(n);
+    octree.Refit(bounds);
+
+    const std::vector<CellOctree::Node>& nodes = octree.GetNodes();
+    bool contained = true;
+    for (const CellOctree::Node& node : nodes)
+    {
+        uint32_t childCells = 0;
+        for (uint32_t k = 0; k < node.childCount; ++k)
+        {
+            const CellOctree::Node& child = nodes[node.firstChild + k];
+            const float dx = child.x - node.x, dy = child.y - node.y, dz = child.z - node.z;
+            contained = contained && std::sqrt(dx * dx + dy * dy + dz * dz) + child.r <= node.r * 1.0001f;
+            childCells += child.cellCount;
+        }
+        CHECK(node.childCount == 0 || childCells == node.cellCount);
+        // 叶子每个方向不超过 kLeafSize 个单元
+        CHECK(node.childCount != 0 || node.cellCount <= static_cast<uint32_t>(CellOctree::kLeafSize * CellOctree::kLeafSize * CellOctree::kLeafSize));
+    }
+    CHECK(contained);
+}
+
+TEST_CASE(MatchesFlatCullingForForestCameras)
+{
+    const int n = 40;
+    const float spacing = 4.5f;
+    TestCamera::Camera cameras[4];
+    TestCamera::MakeForestCameras(n, spacing, cameras);
+    for (const TestCamera::Camera& camera : cameras)
+    {
+        float viewProj[16];
+        TestCamera::MakeViewProj(camera, viewProj);
+        CheckMatchesFlat(n, viewProj, camera.eye, spacing, 3.0f);
+    }
+}
+
+TEST_CASE(MatchesFlatCullingForRandomCameras)
+{
+    std::mt19937 random(99);
+    std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+    for (int i = 0; i < 20; ++i)
+    {
+        const float eye[3] = { position(random), position(random), position(random) };
+        const float target[3] = { position(random), position(random), position(random) };
+        float viewProj[16];
+        TestCamera::MakeViewProj(eye, target, 0.9f, 1.5f, 0.5f, 400.0f, viewProj);
+        CheckMatchesFlat(17, viewProj, eye, 6.0f, 2.5f);
+    }
+}
+
+TEST_CASE(VisibleCellsAreRoughlyFrontToBack)
+{
+    const int n = 40;
+    SphereSoA bounds;
+    TestCamera::BuildGrid(n, 4.5f, 3.0f, bounds);
+    CellOctree octree;
+    octree.Build(n);
+    octree.Refit(bounds);
+    TestCamera::Camera cameras[4];
+    TestCamera::MakeForestCameras(n, 4.5f, cameras);
+    for (const TestCamera::Camera& camera : cameras)
+    {
+        float viewProj[16];
+        TestCamera::MakeViewProj(camera, viewProj);
+        FrustumCuller frustum;
+        frustum.SetViewProj(viewProj);
+        std::vector<uint8_t> visible(bounds.Size());
+        octree.Cull(frustum, camera.eye[0], camera.eye[1], camera.eye[2], visible.data());
+
+        const std::vector<uint32_t>& cells = octree.GetVisibleCells();
+        CHECK(!cells.empty());
+        if (cells.empty())
+            continue;
+        // 最先给出的一段比最后给出的一段近
+        const size_t tenth = std::max<size_t>(1, cells.size() / 10);
+        double head = 0.0, tail = 0.0;
+        for (size_t i = 0; i < tenth; ++i)
+        {
+            head += DistanceToEye(bounds, cells[i], camera.eye);
+            tail += DistanceToEye(bounds, cells[cells.size() - 1 - i], camera.eye);
+        }
+        CHECK(head < tail);
+    }
+}
+
+TEST_CASE(PartialViewsTestFewerSpheresThanCells)
+{
+    const int n = 40;
+    SphereSoA bounds;
+    TestCamera::BuildGrid(n, 4.5f, 3.0f, bounds);
+    CellOctree octree;
+    octree.Build(n);
+    octree.Refit(bounds);
+    TestCamera::Camera cameras[4];
+    TestCamera::MakeForestCameras(n, 4.5f, cameras);
+
+    // 第一人称只看到阵列的一部分，大块区域整体拒绝
+    float viewProj[16];
+    TestCamera::MakeViewProj(cameras[1], viewProj);
+    FrustumCuller frustum;
+    frustum.SetViewProj(viewProj);
+    std::vector<uint8_t> visible(bounds.Size());
+    octree.Cull(frustum, cameras[1].eye[0], cameras[1].eye[1], cameras[1].eye[2], visible.data());
+    const CellOctree::CullStats& stats = octree.GetStats();
+    CHECK(stats.nodesRejected > 0);
+    CHECK(stats.nodesAccepted > 0);
+    CHECK(stats.Tests() < octree.GetCellCount() / 2);
+}
+
+TEST_CASE(RefitFollowsSpacingChanges)
+{
+    const int n = 16;
+    TestCamera::Camera cameras[4];
+    TestCamera::MakeForestCameras(n, 4.5f, cameras);
+    float viewProj[16];
+    TestCamera::MakeViewProj(cameras[3], viewProj);
+
+    SphereSoA bounds;
+    TestCamera::BuildGrid(n, 4.5f, 3.0f, bounds);
+    CellOctree octree;
+    octree.Build(n);
+    octree.Refit(bounds);
+    const float rootRadius = octree.GetNodes()[0].r;
+
+    // 拓扑不变，只重新计算包围球
+    TestCamera::BuildGrid(n, 9.0f, 3.0f, bounds);
+    octree.Refit(bounds);
+    CHECK(octree.GetNodes()[0].r > rootRadius * 1.5f);
+    CheckMatchesFlat(n, viewProj, cameras[3].eye, 9.0f, 3.0f);
+}
+
+TEST_MAIN()
@@ -0,0 +1,183 @@
+//***************************************************************************************
+// ConstantRingTests.cpp
+//
+// ConstantRing：槽位对齐、按 fence 回收、回绕时跳过尾部，以及随机分配下在途区域互不重叠。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "ConstantRing.h"
+#include <deque>
+#include <random>
+
+namespace
+{
+    const uint32_t kSlot = ConstantRing::kSlotBytes;
+
+    struct Region
+    {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    bool Overlaps(const Region& a, const Region& b)
+    {
+        return a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+    }
+}
+
+TEST_CASE(AlignsToSlots)
+{
+    CHECK(ConstantRing::AlignSize(1) == kSlot);
+    CHECK(ConstantRing::AlignSize(kSlot) == kSlot);
+    CHECK(ConstantRing::AlignSize(kSlot + 1) == 2 * kSlot);
+
+    ConstantRing ring;
+    ring.Init(4 * kSlot + 100);     // 不足一个槽位的部分舍去
+    CHECK(ring.GetCapacity() == 4 * kSlot);
+
+    uint32_t offset = 1;
+    CHECK(ring.Allocate(16, &offset) && offset == 0);
+    CHECK(ring.Allocate(kSlot + 16, &offset) && offset == kSlot);
+    CHECK(ring.Allocate(16, &offset) && offset == 3 * kSlot);
+    CHECK(ring.GetUsedBytes() == 4 * kSlot);
+    CHECK(ring.GetStats().bytes == 4 * kSlot);
+}
+
+TEST_CASE(RejectsZeroAndOversized)
+{
+    ConstantRing ring;
+    ring.Init(2 * kSlot);
+    uint32_t offset;
+    CHECK(!ring.Allocate(0, &offset));
+    CHECK(!ring.Allocate(2 * kSlot + 1, &offset));
+    CHECK(ring.GetStats().failures == 2);
+    CHECK(ring.GetUsedBytes() == 0);
+}
+
+TEST_CASE(FailsWhenInFlightFramesFillTheRing)
+{
+    ConstantRing ring;
+    ring.Init(4 * kSlot);
+    uint32_t offset;
+    for (int i = 0; i < 4; ++i)
+        CHECK(ring.Allocate(kSlot, &offset));
+    ring.EndFrame(1);
+    // GPU 还没完成第 1 帧，整块缓冲都在途
+    CHECK(!ring.Allocate(kSlot, &offset));
+    CHECK(ring.GetStats().failures == 1);
+
+    ring.Retire(0);
+    CHECK(ring.GetFramesInFlight() == 1);
+    CHECK(!ring.Allocate(kSlot, &offset));
+
+    ring.Retire(1);
+    CHECK(ring.GetFramesInFlight() == 0);
+    CHECK(ring.GetUsedBytes() == 0);
+    // 没有在途数据时回到开头
+    CHECK(ring.Allocate(kSlot, &offset) && offset == 0);
+}
+
+TEST_CASE(WrapSkipsTailAndChargesItToTheFrame)
+{
+    ConstantRing ring;
+    ring.Init(4 * kSlot);
+    uint32_t offset;
+    CHECK(ring.Allocate(kSlot, &offset) && offset == 0);
+    ring.EndFrame(1);
+    CHECK(ring.Allocate(2 * kSlot, &offset) && offset == kSlot);
+    ring.EndFrame(2);
+    ring.Retire(1);                 // 释放 [0, 1)，head 停在 3
+
+    // 尾部只剩 1 个槽位，放不下 2 个：跳过尾部从开头分配
+    CHECK(!ring.Allocate(2 * kSlot, &offset));
+    CHECK(ring.Allocate(kSlot, &offset) && offset == 3 * kSlot);
+    CHECK(ring.Allocate(kSlot, &offset) && offset == 0);
+    CHECK(ring.GetStats().wraps == 1);
+    ring.EndFrame(3);
+    CHECK(ring.GetUsedBytes() == 4 * kSlot);
+
+    ring.Retire(2);
+    CHECK(ring.GetUsedBytes() == 2 * kSlot);
+    // 第 3 帧在尾部 [3, 4) 和开头 [0, 1)，中间空出 2 个槽位
+    CHECK(ring.Allocate(2 * kSlot, &offset) && offset == kSlot);
+    ring.EndFrame(4);
+    ring.Retire(4);
+    CHECK(ring.GetUsedBytes() == 0);
+    CHECK(ring.GetFramesInFlight() == 0);
+}
+
+TEST_CASE(WrapWasteIsReleasedWithItsFrame)
+{
+    ConstantRing ring;
+    ring.Init(4 * kSlot);
+    uint32_t offset;
+    CHECK(ring.Allocate(2 * kSlot, &offset) && offset == 0);
+    ring.EndFrame(1);
+    CHECK(ring.Allocate(kSlot, &offset) && offset == 2 * kSlot);
+    ring.EndFrame(2);
+    ring.Retire(1);
+
+    // 尾部 1 个槽位放不下：跳过的部分记在第 3 帧上，与第 3 帧一起回收
+    CHECK(ring.Allocate(2 * kSlot, &offset) && offset == 0);
+    ring.EndFrame(3);
+    CHECK(ring.GetUsedBytes() == 4 * kSlot);
+    ring.Retire(2);
+    CHECK(ring.GetUsedBytes() == 3 * kSlot);
+    ring.Retire(3);
+    CHECK(ring.GetUsedBytes() == 0);
+}
+
+TEST_CASE(RandomFramesNeverOverlapInFlightData)
+{
+    std::mt19937 random(1234);
+    ConstantRing ring;
+    ring.Init(64 * kSlot);
+
+    // 模拟 GPU 落后最多 3 帧：每帧随机分配若干次，分配到的区域不能与任何在途区域重叠
+    std::deque<std::vector<Region>> frames;
+    std::vector<Region> current;
+    uint64_t fence = 0;
+    uint32_t successes = 0;
+    for (int frame = 0; frame < 2000; ++frame)
+    {
+        const int allocations = static_cast<int>(random() % 12);
+        for (int i = 0; i < allocations; ++i)
+        {
+            Region region;
+            region.size = ConstantRing::AlignSize(1 + static_cast<uint32_t>(random() % (6 * kSlot)));
+            if (!ring.Allocate(region.size, &region.offset))
+                continue;
+            ++successes;
+            CHECK(region.offset % kSlot == 0);
+            CHECK(region.offset + region.size <= ring.GetCapacity());
+            for (const std::vector<Region>& inFlight : frames)
+            {
+                for (const Region& other : inFlight)
+                    CHECK(!Overlaps(region, other));
+            }
+            for (const Region& other : current)
+                CHECK(!Overlaps(region, other));
+            current.push_back(region);
+        }
+        ring.EndFrame(++fence);
+        frames.push_back(current);
+        current.clear();
+
+        // GPU 随机完成 0~2 帧，但落后不超过 3 帧
+        uint32_t retire = static_cast<uint32_t>(random() % 3);
+        if (frames.size() > 3 + retire)
+            retire = static_cast<uint32_t>(frames.size() - 3);
+        if (retire > frames.size())
+            retire = static_cast<uint32_t>(frames.size());
+        const uint64_t completed = fence - frames.size() + retire;
+        for (uint32_t i = 0; i < retire; ++i)
+            frames.pop_front();
+        ring.Retire(completed);
+        CHECK(ring.GetFramesInFlight() == frames.size());
+    }
+    CHECK(successes > 1000);
+    CHECK(ring.GetStats().wraps > 0);
+    CHECK(ring.GetStats().failures > 0);
+}
+
+TEST_MAIN()
@@ -0,0 +1,126 @@
+//***************************************************************************************
+// ForestSceneTests.cpp
+//
+// ForestScene 的实例生成：SIMD 版本（BuildInstances）与逐实例调用 DirectXMath 的标量版本
+// （BuildInstancesReference）必须逐位相同，包括实例顺序、剔除掩码和按 ix 切片生成的情况。
+// 编译选项（FMA 合并、DirectXMath 指令集）改变舍入时由这里发现，而不是在运行时比较。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "ForestScene.h"
+#include "LaneMath.h"
+
+namespace
+{
+    bool SameInstances(const InstanceBuilder& a, const InstanceBuilder& b)
+    {
+        if (a.GetMeshCount() != b.GetMeshCount())
+            return false;
+        for (int meshId = 0; meshId < a.GetMeshCount(); ++meshId)
+        {
+            const uint32_t count = a.GetInstanceCount(meshId);
+            if (count != b.GetInstanceCount(meshId))
+                return false;
+            if (count > 0 && memcmp(a.GetInstances(meshId), b.GetInstances(meshId), count * sizeof(InstanceData)) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    // 推进若干步，使旋转角和子字角度不为 0
+    ForestScene MakeScene(int n, float spacing, float orbitRadius, int steps)
+    {
+        ForestScene scene;
+        scene.Init();
+        ForestParams& params = scene.GetParams();
+        params.n = n;
+        params.spacing = spacing;
+        params.orbitRadius = orbitRadius;
+        for (int i = 0; i < steps; ++i)
+            scene.Update(1.0f / 60.0f);
+        return scene;
+    }
+}
+
+// LaneMath.h 自带的 ScalarSinCos 与 XMScalarSinCos 逐位相同（4 路版本与 ScalarSinCos 的比较见 LaneMathTests）
+TEST_CASE(ScalarSinCosMatchesDirectXMath)
+{
+    int mismatches = 0;
+    for (int i = -300000; i <= 300000; ++i)
+    {
+        const float value = i * 0.0913f + (i % 7) * 1e-4f;
+        float s, c, xmSin, xmCos;
+        ScalarSinCos(value, &s, &c);
+        DirectX::XMScalarSinCos(&xmSin, &xmCos, value);
+        if (memcmp(&s, &xmSin, sizeof(float)) != 0 || memcmp(&c, &xmCos, sizeof(float)) != 0)
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE(SimdMatchesReferenceBitExactly)
+{
+    const int sizes[] = { 1, 3, 10, 17 };
+    const int steps[] = { 0, 1, 37, 600 };
+    for (int n : sizes)
+    {
+        for (int step : steps)
+        {
+            ForestScene scene = MakeScene(n, 4.5f, 2.5f, step);
+            InstanceBuilder simd(ForestScene::kGlyphCount), reference(ForestScene::kGlyphCount);
+            scene.BuildInstances(simd);
+            scene.BuildInstancesReference(reference);
+            uint32_t total = 0;
+            for (int meshId = 0; meshId < ForestScene::kGlyphCount; ++meshId)
+                total += simd.GetInstanceCount(meshId);
+            CHECK(total >= static_cast<uint32_t>(n * n * n));
+            CHECK(SameInstances(simd, reference));
+        }
+    }
+}
+
+TEST_CASE(SimdMatchesReferenceWithOtherParams)
+{
+    ForestScene scene = MakeScene(8, 7.25f, 0.3f, 123);
+    scene.GetParams().orbitMin = 0;
+    scene.GetParams().orbitMax = 5;
+    InstanceBuilder simd(ForestScene::kGlyphCount), reference(ForestScene::kGlyphCount);
+    scene.BuildInstances(simd);
+    scene.BuildInstancesReference(reference);
+    CHECK(SameInstances(simd, reference));
+}
+
+TEST_CASE(SimdMatchesReferenceWithVisibilityMask)
+{
+    // 掩码让每组 4 个实例凑不满，覆盖补齐空 lane 的路径
+    ForestScene scene = MakeScene(9, 4.5f, 2.5f, 90);
+    std::vector<uint8_t> visible(scene.GetCellCount());
+    uint32_t state = 12345;
+    for (uint8_t& v : visible)
+    {
+        state = state * 1664525u + 1013904223u;
+        v = (state >> 24) % 3 == 0 ? 1 : 0;
+    }
+    InstanceBuilder simd(ForestScene::kGlyphCount), reference(ForestScene::kGlyphCount);
+    scene.BuildInstances(simd, visible.data());
+    scene.BuildInstancesReference(reference, visible.data());
+    CHECK(SameInstances(simd, reference));
+}
+
+TEST_CASE(SlabsConcatenateToWholeBuild)
+{
+    // SceneRenderer 按 ix 切片并行生成后再按顺序合并，结果要与一次生成全部相同
+    ForestScene scene = MakeScene(6, 4.5f, 2.5f, 45);
+    const int n = scene.GetParams().n;
+    InstanceBuilder whole(ForestScene::kGlyphCount), merged(ForestScene::kGlyphCount);
+    scene.BuildInstancesReference(whole);
+    for (int ix = 0; ix < n; ++ix)
+    {
+        InstanceBuilder slab(ForestScene::kGlyphCount);
+        scene.BuildInstances(slab, nullptr, ix, ix + 1);
+        merged.Append(slab);
+    }
+    CHECK(SameInstances(whole, merged));
+}
+
+TEST_MAIN()
@@ -0,0 +1,189 @@
+//***************************************************************************************
+// FrameLimiterTests.cpp
+//
+// FrameLimiter：不限制时直接返回、第一帧只开始计时、提前完成的帧睡眠 + 自旋到目标时刻、
+// 超时的帧不等待、长时间运行目标时刻不漂移，以及睡眠估计随系统睡眠超时自适应。
+// 时间由 FakeClock 推进：每次读时钟前进 kReadCostNs，每次睡眠额外超时 overshoot。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "FrameLimiter.h"
+
+namespace
+{
+    const uint64_t kReadCostNs = 200;
+    const uint64_t kPeriodNs = 10000000;    // 100 FPS
+}
+
+// ==== 开关 ====
+TEST_CASE(DisabledLimiterDoesNotWait)
+{
+    FakeClock clock;
+    FrameLimiter limiter(clock);
+    CHECK(!limiter.IsEnabled());
+    for (int i = 0; i < 10; ++i)
+        limiter.Wait();
+    CHECK(clock.NowNs() == 0);
+    CHECK(limiter.GetStats().waitedFrames == 0);
+
+    limiter.SetTargetFrameRate(100.0);
+    CHECK(limiter.IsEnabled());
+    CHECK(limiter.GetTargetFrameRate() == 100.0);
+    limiter.SetTargetFrameRate(-1.0);
+    CHECK(!limiter.IsEnabled());
+    CHECK(limiter.GetTargetFrameRate() == 0.0);
+}
+
+TEST_CASE(FirstFrameOnlyStartsTiming)
+{
+    FakeClock clock(5000);
+    clock.SetReadCost(kReadCostNs);
+    FrameLimiter limiter(clock);
+    limiter.SetTargetFrameRate(100.0);
+    limiter.Wait();
+    CHECK(clock.GetSleepCount() == 0);
+    CHECK(clock.NowNs() < 5000 + 2 * kReadCostNs);
+}
+
+// ==== 等待 ====
+TEST_CASE(EarlyFrameSleepsThenSpinsToTarget)
+{
+    FakeClock clock;
+    clock.SetReadCost(kReadCostNs);
+    FrameLimiter limiter(clock);
+    limiter.SetTargetFrameRate(100.0);
+    limiter.Wait();
+    const uint64_t start = clock.NowNs() - kReadCostNs;     // Wait 读到的时刻
+
+    clock.Advance(2000000);     // 2ms 的工作
+    limiter.Wait();
+    const uint64_t woke = clock.NowNs() - kReadCostNs;
+    CHECK(woke >= start + kPeriodNs);
+    CHECK(woke - (start + kPeriodNs) <= kReadCostNs);
+    CHECK(clock.GetSleepCount() > 0);
+
+    const FrameLimiter::Stats& stats = limiter.GetStats();
+    CHECK(stats.waitedFrames == 1);
+    CHECK(stats.lateFrames == 0);
+    CHECK(stats.sleepNs > stats.spinNs);
+    CHECK(stats.maxErrorNs <= kReadCostNs);
+}
+
+TEST_CASE(LateFrameDoesNotWait)
+{
+    FakeClock clock;
+    clock.SetReadCost(kReadCostNs);
+    FrameLimiter limiter(clock);
+    limiter.SetTargetFrameRate(100.0);
+    limiter.Wait();
+    clock.Advance(kPeriodNs + 3000000);
+    const uint64_t before = clock.NowNs();
+    limiter.Wait();
+    CHECK(clock.GetSleepCount() == 0);
+    CHECK(clock.NowNs() - before <= 2 * kReadCostNs);
+    CHECK(limiter.GetStats().lateFrames == 1);
+    CHECK(limiter.GetStats().waitedFrames == 0);
+
+    // 落后不到一个周期：保持原来的节拍，下一帧的目标是起点 + 2 个周期
+    clock.Advance(1000000);
+    limiter.Wait();
+    CHECK(limiter.GetStats().waitedFrames == 1);
+    CHECK(clock.NowNs() - kReadCostNs - 2 * kPeriodNs <= 2 * kReadCostNs);
+}
+
+TEST_CASE(FallingFarBehindRestartsTiming)
+{
+    FakeClock clock;
+    clock.SetReadCost(kReadCostNs);
+    FrameLimiter limiter(clock);
+    limiter.SetTargetFrameRate(100.0);
+    limiter.Wait();
+    clock.Advance(5 * kPeriodNs);   // 卡顿了几帧：不追赶
+    limiter.Wait();
+    const uint64_t restart = clock.NowNs();
+    clock.Advance(1000000);
+    limiter.Wait();
+    const uint64_t woke = clock.NowNs();
+    CHECK(woke - restart >= kPeriodNs - 2 * kReadCostNs);
+    CHECK(woke - restart <= kPeriodNs + 2 * kReadCostNs);
+}
+
+// ==== 长时间运行 ====
+TEST_CASE(TargetsDoNotDrift)
+{
+    FakeClock clock;
+    clock.SetReadCost(kReadCostNs);
+    clock.SetSleepOvershoot(300000);
+    FrameLimiter limiter(clock);
+    limiter.SetTargetFrameRate(100.0);
+    limiter.Wait();
+    const uint64_t start = clock.NowNs();
+
+    // 每帧工作时长不同，但都在一个周期以内
+    const int kFrames = 2000;
+    uint32_t seed = 12345;
+    for (int i = 0; i < kFrames; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        clock.Advance(1000000 + (seed >> 8) % 6000000);
+        limiter.Wait();
+    }
+    // 目标时刻按固定周期递推，误差不随帧数累积
+    const uint64_t elapsed = clock.NowNs() - start;
+    const uint64_t expected = static_cast<uint64_t>(kFrames) * kPeriodNs;
+    CHECK(elapsed >= expected - 2 * kReadCostNs);
+    CHECK(elapsed <= expected + 2 * kReadCostNs);
+    CHECK(limiter.GetStats().waitedFrames == kFrames);
+    CHECK(limiter.GetStats().lateFrames == 0);
+}
+
+TEST_CASE(SleepEstimateAdaptsToOvershoot)
+{
+    // 系统睡眠总是比请求多 3ms：估计值跟上后不会再睡过头，醒来误差仍只有读时钟的开销
+    const uint64_t kOvershootNs = 3000000;
+    FakeClock clock;
+    clock.SetReadCost(kReadCostNs);
+    clock.SetSleepOvershoot(kOvershootNs);
+    FrameLimiter limiter(clock);
+    limiter.SetTargetFrameRate(100.0);
+    limiter.Wait();
+    for (int i = 0; i < 100; ++i)
+    {
+        clock.Advance(1000000);
+        limiter.Wait();
+    }
+    CHECK(limiter.GetSleepEstimateNs() >= FrameLimiter::kSleepQuantumNs + kOvershootNs - 100000);
+    CHECK(limiter.GetStats().lateFrames == 0);
+
+    limiter.ResetStats();
+    for (int i = 0; i < 100; ++i)
+    {
+        clock.Advance(1000000);
+        limiter.Wait();
+    }
+    const FrameLimiter::Stats& stats = limiter.GetStats();
+    CHECK(stats.waitedFrames == 100);
+    CHECK(stats.maxErrorNs <= kReadCostNs);
+    CHECK(stats.sleepNs > 0);
+    CHECK(stats.spinNs > 0);
+}
+
+TEST_CASE(ResetStartsTimingAgain)
+{
+    FakeClock clock;
+    clock.SetReadCost(kReadCostNs);
+    FrameLimiter limiter(clock);
+    limiter.SetTargetFrameRate(100.0);
+    limiter.Wait();
+    clock.Advance(1000000);
+    limiter.Wait();
+    // 暂停恢复：不会为暂停期间补等，也不会记为超时
+    clock.Advance(1000000000);
+    limiter.Reset();
+    const uint32_t sleeps = clock.GetSleepCount();
+    limiter.Wait();
+    CHECK(clock.GetSleepCount() == sleeps);
+    CHECK(limiter.GetStats().lateFrames == 0);
+}
+
+TEST_MAIN()
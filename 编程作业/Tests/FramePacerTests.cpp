@@ -0,0 +1,199 @@
+//***************************************************************************************
+// FramePacerTests.cpp
+//
+// FramePacer：状态切换、在途帧数达到上限时等待、延迟按轮询点记录，
+// 以及实际完成时刻落在 (pendingNs, completeNs] 内。时间全部由测试传入。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "FramePacer.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // 一帧：BeginFrame 后立即可以开始，提交时插入 fence
+    void RunFrame(FramePacer& pacer, uint64_t completedFence, uint64_t beginNs, uint64_t submitNs, uint64_t fence)
+    {
+        pacer.BeginFrame(beginNs);
+        CHECK(pacer.TryStart(completedFence, beginNs));
+        pacer.EndFrame(fence, submitNs);
+    }
+}
+
+// ==== 状态 ====
+TEST_CASE(StatesFollowBeginStartEnd)
+{
+    FramePacer pacer(2);
+    CHECK(pacer.GetState() == FramePacer::State::Idle);
+    pacer.BeginFrame(0);
+    CHECK(pacer.GetState() == FramePacer::State::Waiting);
+    CHECK(pacer.TryStart(0, 10));
+    CHECK(pacer.GetState() == FramePacer::State::Recording);
+    pacer.EndFrame(1, 20);
+    CHECK(pacer.GetState() == FramePacer::State::Idle);
+    CHECK(pacer.GetFrameIndex() == 1);
+    CHECK(pacer.GetFramesInFlight() == 1);
+}
+
+TEST_CASE(MaxFramesInFlightIsAtLeastOne)
+{
+    FramePacer pacer(0);
+    CHECK(pacer.GetMaxFramesInFlight() == 1);
+    pacer.SetMaxFramesInFlight(3);
+    CHECK(pacer.GetMaxFramesInFlight() == 3);
+    pacer.SetMaxFramesInFlight(0);
+    CHECK(pacer.GetMaxFramesInFlight() == 1);
+}
+
+// ==== 在途帧数 ====
+TEST_CASE(ThrottlesWhenFramesInFlightReachLimit)
+{
+    FramePacer pacer(2);
+    RunFrame(pacer, 0, 0, 10, 1);
+    RunFrame(pacer, 0, 10, 20, 2);
+    CHECK(pacer.GetFramesInFlight() == 2);
+
+    pacer.BeginFrame(20);
+    CHECK(!pacer.TryStart(0, 25));
+    CHECK(!pacer.TryStart(0, 30));
+    CHECK(pacer.GetState() == FramePacer::State::Waiting);
+    // 第一帧完成后可以开始
+    CHECK(pacer.TryStart(1, 40));
+    CHECK(pacer.GetFramesInFlight() == 1);
+    pacer.EndFrame(3, 50);
+
+    const FramePacer::Stats& stats = pacer.GetStats();
+    CHECK(stats.throttledFrames == 1);
+    CHECK(stats.completedFrames == 1);
+    // 等待时间在帧完成时计入统计
+    pacer.Retire(3, 60);
+    CHECK(stats.completedFrames == 3);
+    CHECK(stats.totalWaitNs == 20);
+}
+
+TEST_CASE(RetireCompletesFramesUpToFenceInOrder)
+{
+    FramePacer pacer(3);
+    RunFrame(pacer, 0, 0, 10, 1);
+    RunFrame(pacer, 0, 10, 20, 2);
+    RunFrame(pacer, 0, 20, 30, 3);
+    pacer.Retire(2, 40);
+    CHECK(pacer.GetFramesInFlight() == 1);
+    CHECK(pacer.GetLastCompletedFrame().fence == 2);
+    CHECK(pacer.GetLastCompletedFrame().completeNs == 40);
+    CHECK(pacer.GetStats().completedFrames == 2);
+    // 旧的 fence 不会重复完成
+    pacer.Retire(2, 50);
+    CHECK(pacer.GetStats().completedFrames == 2);
+}
+
+// ==== 轮询点 ====
+TEST_CASE(LatencyIsMeasuredAtPollPoints)
+{
+    FramePacer pacer(2);
+    pacer.BeginFrame(0);
+    CHECK(pacer.TryStart(0, 100));
+    pacer.EndFrame(1, 300);
+    // 轮询点 1：Present 之后还没完成
+    pacer.Retire(0, 310);
+    CHECK(pacer.GetStats().completedFrames == 0);
+    // 轮询点 2：帧限制等待之后完成
+    pacer.Retire(1, 900);
+
+    const FramePacer::FrameTiming& frame = pacer.GetLastCompletedFrame();
+    CHECK(frame.WaitNs() == 100);
+    CHECK(frame.CpuNs() == 200);
+    CHECK(frame.LatencyNs() == 800);
+    CHECK(frame.pendingNs == 310);
+    CHECK(frame.completeNs == 900);
+    CHECK(frame.CompletionUncertaintyNs() == 590);
+    CHECK(pacer.GetStats().totalUncertaintyNs == 590);
+}
+
+TEST_CASE(PendingOnlyMovesForwardWhileInFlight)
+{
+    FramePacer pacer(2);
+    RunFrame(pacer, 0, 0, 100, 1);
+    CHECK(pacer.GetFramesInFlight() == 1);
+    pacer.Retire(0, 150);
+    pacer.Retire(0, 120);     // 时间不会倒退
+    pacer.Retire(1, 200);
+    CHECK(pacer.GetLastCompletedFrame().pendingNs == 150);
+    CHECK(pacer.GetLastCompletedFrame().CompletionUncertaintyNs() == 50);
+}
+
+TEST_CASE(FrameCompletedAtSubmitHasNoUncertainty)
+{
+    // GPU 已经赶上：Present 之后第一次轮询就完成，完成时刻不早于提交
+    FramePacer pacer(2);
+    RunFrame(pacer, 0, 0, 100, 1);
+    pacer.Retire(1, 100);
+    CHECK(pacer.GetLastCompletedFrame().completeNs == 100);
+    CHECK(pacer.GetLastCompletedFrame().CompletionUncertaintyNs() == 0);
+}
+
+TEST_CASE(ActualCompletionLiesInsidePolledInterval)
+{
+    // GPU 每帧耗时固定，按 GameApp 的轮询点轮询：实际完成时刻必须落在 (pendingNs, completeNs] 内
+    const uint64_t kGpuNs = 7000;
+    const uint64_t kCpuNs = 3000;
+    const uint64_t kLimiterNs = 2000;
+    FramePacer pacer(2);
+    uint64_t now = 0;
+    uint64_t gpuFree = 0;
+    std::vector<uint64_t> gpuDone;   // 下标为 fence - 1
+    auto completedFence = [&](uint64_t t)
+    {
+        uint64_t fence = 0;
+        while (fence < gpuDone.size() && gpuDone[fence] <= t)
+            ++fence;
+        return fence;
+    };
+
+    bool intervalsValid = true;
+    uint64_t checked = 0;
+    uint64_t lastFence = 0;
+    for (uint64_t frame = 0; frame < 50; ++frame)
+    {
+        pacer.Retire(completedFence(now), now);            // 轮询点 2
+        pacer.BeginFrame(now);
+        while (!pacer.TryStart(completedFence(now), now))  // 轮询点 3
+            now += 500;
+        now += kCpuNs;
+        gpuFree = std::max(gpuFree, now) + kGpuNs;
+        gpuDone.push_back(gpuFree);
+        pacer.EndFrame(gpuDone.size(), now);
+        pacer.Retire(completedFence(now), now);            // 轮询点 1
+        now += kLimiterNs;
+
+        const FramePacer::FrameTiming& done = pacer.GetLastCompletedFrame();
+        if (done.fence != 0 && done.fence != lastFence)
+        {
+            lastFence = done.fence;
+            const uint64_t actual = gpuDone[done.fence - 1];
+            intervalsValid = intervalsValid && done.pendingNs < actual && actual <= done.completeNs;
+            ++checked;
+        }
+    }
+    CHECK(intervalsValid);
+    CHECK(checked > 40);
+    CHECK(pacer.GetStats().throttledFrames > 0);
+}
+
+TEST_CASE(ResetStatsKeepsFramesInFlight)
+{
+    FramePacer pacer(2);
+    RunFrame(pacer, 0, 0, 10, 1);
+    RunFrame(pacer, 1, 10, 20, 2);
+    CHECK(pacer.GetStats().completedFrames == 1);
+    pacer.ResetStats();
+    CHECK(pacer.GetStats().completedFrames == 0);
+    CHECK(pacer.GetStats().totalLatencyNs == 0);
+    CHECK(pacer.GetFramesInFlight() == 1);
+    pacer.Retire(2, 30);
+    CHECK(pacer.GetStats().completedFrames == 1);
+    CHECK(pacer.GetStats().AverageLatencyMs() > 0.0);
+}
+
+TEST_MAIN()
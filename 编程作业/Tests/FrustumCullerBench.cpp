@@ -0,0 +1,46 @@
+//***************************************************************************************
+// FrustumCullerBench.cpp
+//
+// 逐单元视锥剔除：n³ 个单元包围球（n = 100 即 100 万个）按四种视角批量测试，
+// 报告每帧耗时、每秒测试的球数和可见比例。
+// 用法：FrustumCullerBench [-quick]
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestCamera.h"
+#include "FrustumCuller.h"
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    const int n = quick ? 20 : 100;
+    const int frames = quick ? 3 : 50;
+    const float spacing = 4.5f;
+
+    SphereSoA bounds;
+    TestCamera::BuildGrid(n, spacing, 3.0f, bounds);
+    std::vector<uint8_t> visible(bounds.Size());
+    TestCamera::Camera cameras[4];
+    TestCamera::MakeForestCameras(n, spacing, cameras);
+
+    printf("%d 个单元，每种视角 %d 帧\n", static_cast<int>(bounds.Size()), frames);
+    printf("%-12s %10s %14s %10s\n", "视角", "ms/帧", "百万球/秒", "可见");
+    FrustumCuller culler;
+    for (const TestCamera::Camera& camera : cameras)
+    {
+        float viewProj[16];
+        TestCamera::MakeViewProj(camera, viewProj);
+        culler.SetViewProj(viewProj);
+
+        uint32_t visibleCount = culler.Cull(bounds, visible.data());
+        TestCommon::BenchTimer timer;
+        for (int frame = 0; frame < frames; ++frame)
+            visibleCount = culler.Cull(bounds, visible.data());
+        const double seconds = timer.GetSeconds();
+        TestCommon::KeepAlive(visibleCount);
+
+        printf("%-12s %10.3f %14.1f %9.1f%%\n", camera.name, seconds * 1000.0 / frames,
+            bounds.Size() * static_cast<double>(frames) / seconds / 1e6, 100.0 * visibleCount / bounds.Size());
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+//***************************************************************************************
+// FrustumCullerTests.cpp
+//
+// FrustumCuller：平面提取、单个球的判定，以及 SSE/AVX 批量版本与标量判定逐个一致。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestCamera.h"
+#include "FrustumCuller.h"
+#include <random>
+
+namespace
+{
+    // 相机在原点看向 +z
+    void MakeForwardCamera(FrustumCuller& culler)
+    {
+        const float eye[3] = { 0.0f, 0.0f, 0.0f };
+        const float target[3] = { 0.0f, 0.0f, 1.0f };
+        float viewProj[16];
+        TestCamera::MakeViewProj(eye, target, 1.5708f, 1.0f, 1.0f, 100.0f, viewProj);
+        culler.SetViewProj(viewProj);
+    }
+}
+
+TEST_CASE(DefaultAcceptsEverything)
+{
+    FrustumCuller culler;
+    CHECK(culler.IsSphereVisible(1e6f, -1e6f, 1e6f, 0.0f));
+}
+
+TEST_CASE(PlanesAreNormalizedAndFaceInward)
+{
+    FrustumCuller culler;
+    MakeForwardCamera(culler);
+    for (int i = 0; i < 6; ++i)
+    {
+        const float* p = culler.GetPlane(i);
+        CHECK_NEAR(p[0] * p[0] + p[1] * p[1] + p[2] * p[2], 1.0, 1e-5);
+        // 视锥内的点 (0, 0, 10) 在每个平面的正侧
+        CHECK(p[2] * 10.0f + p[3] > 0.0f);
+    }
+    // 近平面 z = 1，远平面 z = 100
+    CHECK_NEAR(culler.GetPlane(4)[2] * 1.0f + culler.GetPlane(4)[3], 0.0, 1e-4);
+    CHECK_NEAR(culler.GetPlane(5)[2] * 100.0f + culler.GetPlane(5)[3], 0.0, 1e-3);
+}
+
+TEST_CASE(ClassifiesSpheres)
+{
+    FrustumCuller culler;
+    MakeForwardCamera(culler);
+    CHECK(culler.IsSphereVisible(0.0f, 0.0f, 50.0f, 1.0f));
+    CHECK(!culler.IsSphereVisible(0.0f, 0.0f, -5.0f, 1.0f));         // 相机后方
+    CHECK(!culler.IsSphereVisible(0.0f, 0.0f, 120.0f, 1.0f));        // 远平面外
+    CHECK(!culler.IsSphereVisible(30.0f, 0.0f, 10.0f, 1.0f));        // 90° 视野，x > z 在右平面外
+    CHECK(culler.IsSphereVisible(0.0f, 0.0f, 0.5f, 1.0f));           // 与近平面相交
+
+    CHECK(culler.Classify(0.0f, 0.0f, 50.0f, 1.0f) == FrustumCuller::Containment::Inside);
+    CHECK(culler.Classify(0.0f, 0.0f, 100.0f, 1.0f) == FrustumCuller::Containment::Intersect);
+    CHECK(culler.Classify(0.0f, 0.0f, -5.0f, 1.0f) == FrustumCuller::Containment::Outside);
+}
+
+TEST_CASE(BatchMatchesScalarForEveryCount)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 8.0f);
+
+    FrustumCuller culler;
+    TestCamera::Camera cameras[4];
+    TestCamera::MakeForestCameras(40, 4.5f, cameras);
+    float viewProj[16];
+    TestCamera::MakeViewProj(cameras[3], viewProj);
+    culler.SetViewProj(viewProj);
+
+    // 长度覆盖 SIMD 宽度的整数倍与余数部分
+    for (uint32_t count = 0; count < 40; ++count)
+    {
+        SphereSoA spheres;
+        spheres.Resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            spheres.x[i] = position(random);
+            spheres.y[i] = position(random);
+            spheres.z[i] = position(random);
+            spheres.r[i] = radius(random);
+        }
+        std::vector<uint8_t> visible(count + 1, 0xCD);
+        const uint32_t visibleCount = culler.Cull(spheres, visible.data());
+
+        uint32_t expected = 0;
+        bool same = true;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const bool scalar = culler.IsSphereVisible(spheres.x[i], spheres.y[i], spheres.z[i], spheres.r[i]);
+            same = same && visible[i] == (scalar ? 1 : 0);
+            expected += scalar ? 1 : 0;
+        }
+        CHECK(same);
+        CHECK(visibleCount == expected);
+        CHECK(visible[count] == 0xCD);      // 不写越界
+    }
+}
+
+TEST_CASE(NanSpheresAreCulled)
+{
+    FrustumCuller culler;
+    MakeForwardCamera(culler);
+    const float nan = std::nanf("");
+    float x[4] = { 0.0f, nan, 0.0f, 0.0f };
+    float y[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float z[4] = { 10.0f, 10.0f, 10.0f, 10.0f };
+    float r[4] = { 1.0f, 1.0f, nan, 1.0f };
+    uint8_t visible[4];
+    CHECK(culler.Cull(x, y, z, r, 4, visible) == 2);
+    CHECK(visible[0] == 1 && visible[1] == 0 && visible[2] == 0 && visible[3] == 1);
+}
+
+TEST_MAIN()
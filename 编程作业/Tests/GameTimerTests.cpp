@@ -0,0 +1,174 @@
+//***************************************************************************************
+// GameTimerTests.cpp
+//
+// GameTimer：帧间隔与总时间、暂停期间不计时（包括多次暂停和重复调用）、Reset 清零，
+// 以及运行数十天后仍能分辨单帧的纳秒级差异（不漂移）。时间由 FakeClock 推进；
+// 另外检查 SystemClock 单调且休眠不短于请求时长。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "GameTimer.h"
+
+namespace
+{
+    const uint64_t kFrameNs = 16666667;    // 60 FPS
+}
+
+// ==== 基本计时 ====
+TEST_CASE(TickMeasuresDeltaAndTotal)
+{
+    FakeClock clock(1000);
+    GameTimer timer(clock);
+    timer.Reset();
+    timer.Tick();
+    CHECK(timer.DeltaNs() == 0);
+
+    clock.Advance(kFrameNs);
+    timer.Tick();
+    CHECK(timer.DeltaNs() == kFrameNs);
+    CHECK(timer.TotalNs() == kFrameNs);
+    clock.Advance(2 * kFrameNs);
+    timer.Tick();
+    CHECK(timer.DeltaNs() == 2 * kFrameNs);
+    CHECK(timer.TotalNs() == 3 * kFrameNs);
+    CHECK_NEAR(timer.DeltaSeconds(), 2 * kFrameNs * 1e-9, 1e-12);
+    CHECK_NEAR(timer.TotalTime(), 3 * kFrameNs * 1e-9, 1e-6);
+}
+
+TEST_CASE(ResetClearsTotalAndPausedTime)
+{
+    FakeClock clock;
+    GameTimer timer(clock);
+    timer.Reset();
+    clock.Advance(kFrameNs);
+    timer.Stop();
+    clock.Advance(5 * kFrameNs);
+    timer.Start();
+    clock.Advance(kFrameNs);
+    timer.Tick();
+    CHECK(timer.TotalNs() == 2 * kFrameNs);
+
+    timer.Reset();
+    CHECK(timer.TotalNs() == 0);
+    CHECK(timer.DeltaNs() == 0);
+    CHECK(!timer.IsStopped());
+    clock.Advance(kFrameNs);
+    timer.Tick();
+    CHECK(timer.TotalNs() == kFrameNs);
+}
+
+// ==== 暂停与恢复 ====
+TEST_CASE(PausedTimeIsNotCounted)
+{
+    FakeClock clock;
+    GameTimer timer(clock);
+    timer.Reset();
+    clock.Advance(3 * kFrameNs);
+    timer.Tick();
+
+    timer.Stop();
+    CHECK(timer.IsStopped());
+    clock.Advance(1000000000);
+    timer.Tick();
+    CHECK(timer.DeltaNs() == 0);
+    CHECK(timer.TotalNs() == 3 * kFrameNs);
+
+    timer.Start();
+    CHECK(!timer.IsStopped());
+    clock.Advance(kFrameNs);
+    timer.Tick();
+    // 恢复后的第一帧间隔从恢复时刻算起，不包含暂停时间
+    CHECK(timer.DeltaNs() == kFrameNs);
+    CHECK(timer.TotalNs() == 4 * kFrameNs);
+}
+
+TEST_CASE(StoppedTotalExcludesTimeSinceStop)
+{
+    FakeClock clock;
+    GameTimer timer(clock);
+    timer.Reset();
+    clock.Advance(kFrameNs);
+    timer.Tick();
+    clock.Advance(kFrameNs);
+    timer.Stop();   // 停止前最后一次 Tick 之后的时间也计入
+    clock.Advance(7 * kFrameNs);
+    CHECK(timer.TotalNs() == 2 * kFrameNs);
+}
+
+TEST_CASE(RepeatedPausesAccumulate)
+{
+    FakeClock clock;
+    GameTimer timer(clock);
+    timer.Reset();
+    uint64_t running = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        clock.Advance(kFrameNs);
+        running += kFrameNs;
+        timer.Tick();
+        timer.Stop();
+        timer.Stop();       // 重复 Stop 不会重置停止时刻
+        clock.Advance(kFrameNs / 2 + i);
+        timer.Start();
+        timer.Start();      // 重复 Start 不会重复累计暂停时间
+    }
+    clock.Advance(kFrameNs);
+    running += kFrameNs;
+    timer.Tick();
+    CHECK(timer.TotalNs() == running);
+    CHECK(timer.DeltaNs() == kFrameNs);
+}
+
+// ==== 长时间运行 ====
+TEST_CASE(NoDriftAfterDaysOfUptime)
+{
+    // 从很大的计数起步，运行 30 天后总时间仍精确到纳秒，双精度访问器仍能分辨 1 微秒
+    const uint64_t kStartNs = 1ull << 60;
+    const uint64_t kDaysNs = 30ull * 24 * 3600 * 1000000000ull;
+    FakeClock clock(kStartNs);
+    GameTimer timer(clock);
+    timer.Reset();
+    clock.Advance(kDaysNs);
+    timer.Tick();
+    CHECK(timer.TotalNs() == kDaysNs);
+
+    clock.Advance(kFrameNs + 1);
+    timer.Tick();
+    CHECK(timer.DeltaNs() == kFrameNs + 1);
+    CHECK(timer.TotalNs() == kDaysNs + kFrameNs + 1);
+    CHECK_NEAR(timer.TotalSeconds() - kDaysNs * 1e-9, (kFrameNs + 1) * 1e-9, 1e-6);
+
+    // 逐帧累加的帧间隔与总时间一致，不会因为舍入累积误差
+    uint64_t sum = 0;
+    uint32_t seed = 7;
+    for (int i = 0; i < 100000; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        clock.Advance(kFrameNs + (seed >> 16) % 1000);
+        timer.Tick();
+        sum += timer.DeltaNs();
+    }
+    CHECK(timer.TotalNs() == kDaysNs + kFrameNs + 1 + sum);
+}
+
+// ==== 系统时钟 ====
+TEST_CASE(SystemClockIsMonotonicAndSleepsAtLeastRequested)
+{
+    MonotonicClock& clock = MonotonicClock::GetSystemClock();
+    uint64_t previous = clock.NowNs();
+    bool monotonic = true;
+    for (int i = 0; i < 100000; ++i)
+    {
+        uint64_t now = clock.NowNs();
+        monotonic = monotonic && now >= previous;
+        previous = now;
+    }
+    CHECK(monotonic);
+
+    const uint64_t kSleepNs = 2000000;
+    uint64_t before = clock.NowNs();
+    clock.SleepNs(kSleepNs);
+    CHECK(clock.NowNs() - before >= kSleepNs);
+}
+
+TEST_MAIN()
@@ -0,0 +1,240 @@
+//***************************************************************************************
+// GeometryPoolTests.cpp
+//
+// 几何池的偏移表：Float / Packed 网格混合存放时 baseVertex 按各自的步长对齐、startIndex 连续，
+// 索引保持网格内的局部编号；ReplaceMesh 超出预留容量（包括对齐后才超出）时拒绝且不改动池；
+// Packed 网格的 GetPositions 解码误差在量化精度以内。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "GeometryPool.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace DirectX;
+
+namespace
+{
+    std::vector<FloatVertex> MakeVertices(uint32_t count, float offset)
+    {
+        std::vector<FloatVertex> vertices(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const float t = offset + static_cast<float>(i);
+            vertices[i].pos = XMFLOAT3(t, t * 0.5f - 3.0f, 1.0f - t * 0.25f);
+            vertices[i].normal = XMFLOAT3(0.0f, 0.0f, 1.0f);
+            vertices[i].color = XMFLOAT4(0.25f, 0.5f, 0.75f, 1.0f);
+        }
+        return vertices;
+    }
+
+    // 0..count-1 的三角扇
+    std::vector<uint16_t> MakeFanIndices(uint32_t vertexCount)
+    {
+        std::vector<uint16_t> indices;
+        for (uint32_t i = 1; i + 1 < vertexCount; ++i)
+        {
+            indices.push_back(0);
+            indices.push_back(static_cast<uint16_t>(i));
+            indices.push_back(static_cast<uint16_t>(i + 1));
+        }
+        return indices;
+    }
+
+    std::vector<PackedVertex> Pack(const std::vector<FloatVertex>& vertices, PositionDecode& decode)
+    {
+        std::vector<PackedVertex> packed;
+        const bool ok = PackVertices(vertices.data(), static_cast<uint32_t>(vertices.size()), packed, decode);
+        CHECK(ok);
+        return packed;
+    }
+
+    bool SameBytes(const GeometryPool& pool, int meshId, const void* pExpected)
+    {
+        const GeometryPool::MeshRange& mesh = pool.GetMesh(meshId);
+        const uint8_t* pData = static_cast<const uint8_t*>(pool.GetVertexData())
+            + static_cast<size_t>(mesh.baseVertex) * mesh.vertexStride;
+        return memcmp(pData, pExpected, static_cast<size_t>(mesh.vertexCount) * mesh.vertexStride) == 0;
+    }
+}
+
+// ==== 偏移表 ====
+TEST_CASE(MixedFormatsAlignToTheirOwnStride)
+{
+    GeometryPool pool(sizeof(FloatVertex));
+    std::vector<FloatVertex> a = MakeVertices(3, 0.0f), c = MakeVertices(2, 10.0f);
+    std::vector<FloatVertex> b = MakeVertices(5, 20.0f);
+    PositionDecode decode;
+    std::vector<PackedVertex> packed = Pack(b, decode);
+    std::vector<uint16_t> ia = MakeFanIndices(3), ib = MakeFanIndices(5), ic = { 0, 1, 1 };
+
+    // A：字节 [0, 120)；B 的起始 120 对齐到 16 为 128，baseVertex = 8；
+    // C 的起始 128 + 80 = 208 对齐到 40 为 240，baseVertex = 6
+    const int idA = pool.AddMesh(a.data(), 3, ia.data(), static_cast<uint32_t>(ia.size()));
+    const int idB = pool.AddMesh(packed.data(), 5, ib.data(), static_cast<uint32_t>(ib.size()), VertexFormat::Packed, &decode);
+    const int idC = pool.AddMesh(c.data(), 2, ic.data(), static_cast<uint32_t>(ic.size()));
+    CHECK(idA == 0 && idB == 1 && idC == 2);
+    CHECK(pool.GetMeshCount() == 3);
+
+    const GeometryPool::MeshRange& meshA = pool.GetMesh(idA);
+    const GeometryPool::MeshRange& meshB = pool.GetMesh(idB);
+    const GeometryPool::MeshRange& meshC = pool.GetMesh(idC);
+    CHECK(meshA.baseVertex == 0 && meshA.vertexStride == 40 && meshA.format == VertexFormat::Float);
+    CHECK(meshB.baseVertex == 8 && meshB.vertexStride == 16 && meshB.format == VertexFormat::Packed);
+    CHECK(meshC.baseVertex == 6 && meshC.vertexStride == 40);
+    CHECK(meshA.startIndex == 0 && meshA.indexCount == 3);
+    CHECK(meshB.startIndex == 3 && meshB.indexCount == 9);
+    CHECK(meshC.startIndex == 12 && meshC.indexCount == 3);
+    CHECK(memcmp(meshB.decode.scale, decode.scale, sizeof(decode.scale)) == 0);
+    CHECK(memcmp(meshB.decode.offset, decode.offset, sizeof(decode.offset)) == 0);
+
+    CHECK(pool.GetVertexByteSize() == 320);
+    CHECK(pool.GetVertexCount() == 8);
+    CHECK(pool.GetIndexCount() == 15);
+    CHECK(pool.GetIndexByteSize() == 30);
+    CHECK(SameBytes(pool, idA, a.data()));
+    CHECK(SameBytes(pool, idB, packed.data()));
+    CHECK(SameBytes(pool, idC, c.data()));
+}
+
+TEST_CASE(PackedAfterPackedNeedsNoPadding)
+{
+    // 16 的倍数之后紧接 Packed 网格，不插入填充；之后的 Float 网格再对齐到 40
+    GeometryPool pool(sizeof(FloatVertex));
+    std::vector<FloatVertex> source = MakeVertices(3, 0.0f);
+    PositionDecode decode;
+    std::vector<PackedVertex> packed = Pack(source, decode);
+    std::vector<uint16_t> indices = MakeFanIndices(3);
+    pool.AddMesh(packed.data(), 3, indices.data(), 3, VertexFormat::Packed, &decode);
+    pool.AddMesh(packed.data(), 3, indices.data(), 3, VertexFormat::Packed, &decode);
+    pool.AddMesh(source.data(), 3, indices.data(), 3);
+    CHECK(pool.GetMesh(0).baseVertex == 0);
+    CHECK(pool.GetMesh(1).baseVertex == 3);
+    CHECK(pool.GetMesh(2).baseVertex == 3);     // 96 对齐到 40 为 120
+    CHECK(pool.GetVertexByteSize() == 240);
+}
+
+TEST_CASE(IndicesStayLocalAndContiguous)
+{
+    // 索引原样保存（不加 baseVertex），各网格的索引段首尾相接
+    GeometryPool pool(sizeof(FloatVertex));
+    const uint32_t counts[] = { 4, 7, 3, 6 };
+    std::vector<std::vector<uint16_t>> sources;
+    for (uint32_t count : counts)
+    {
+        std::vector<FloatVertex> vertices = MakeVertices(count, static_cast<float>(count));
+        sources.push_back(MakeFanIndices(count));
+        pool.AddMesh(vertices.data(), count, sources.back().data(), static_cast<uint32_t>(sources.back().size()));
+    }
+
+    uint32_t expectedStart = 0;
+    for (int meshId = 0; meshId < pool.GetMeshCount(); ++meshId)
+    {
+        const GeometryPool::MeshRange& mesh = pool.GetMesh(meshId);
+        CHECK(mesh.startIndex == expectedStart);
+        CHECK(mesh.indexCount == sources[meshId].size());
+        const uint16_t* pIndices = pool.GetIndexData() + mesh.startIndex;
+        CHECK(memcmp(pIndices, sources[meshId].data(), mesh.indexCount * sizeof(uint16_t)) == 0);
+        for (uint32_t i = 0; i < mesh.indexCount; ++i)
+            CHECK(pIndices[i] < mesh.vertexCount);
+        expectedStart += mesh.indexCount;
+    }
+    CHECK(expectedStart == pool.GetIndexCount());
+}
+
+// ==== 运行中替换 ====
+TEST_CASE(ReplaceMeshAppendsWithinCapacity)
+{
+    GeometryPool pool(sizeof(FloatVertex));
+    pool.Reserve(10, 12);
+    CHECK(pool.GetVertexCapacity() == 10 && pool.GetIndexCapacity() == 12);
+    std::vector<FloatVertex> placeholder = MakeVertices(3, 0.0f), loaded = MakeVertices(4, 5.0f);
+    std::vector<uint16_t> i3 = MakeFanIndices(3), i4 = MakeFanIndices(4);
+    const int meshId = pool.AddMesh(placeholder.data(), 3, i3.data(), 3);
+
+    CHECK(pool.ReplaceMesh(meshId, loaded.data(), 4, i4.data(), 6));
+    const GeometryPool::MeshRange& mesh = pool.GetMesh(meshId);
+    CHECK(pool.GetMeshCount() == 1);
+    CHECK(mesh.baseVertex == 3 && mesh.vertexCount == 4);
+    CHECK(mesh.startIndex == 3 && mesh.indexCount == 6);
+    CHECK(SameBytes(pool, meshId, loaded.data()));
+    // 旧数据保留在原处，渲染端只需上传新追加的部分
+    CHECK(memcmp(pool.GetVertexData(), placeholder.data(), 3 * sizeof(FloatVertex)) == 0);
+    CHECK(pool.GetVertexCount() == 7 && pool.GetIndexCount() == 9);
+}
+
+TEST_CASE(ReplaceMeshRejectsOverCapacity)
+{
+    GeometryPool pool(sizeof(FloatVertex));
+    pool.Reserve(3, 12);
+    std::vector<FloatVertex> one = MakeVertices(1, 0.0f), three = MakeVertices(3, 0.0f);
+    std::vector<uint16_t> degenerate = { 0, 0, 0 }, i3 = MakeFanIndices(3);
+    const int meshId = pool.AddMesh(one.data(), 1, degenerate.data(), 3);
+
+    // 索引超出：3 + 12 > 12
+    std::vector<uint16_t> many(12, 0);
+    CHECK(!pool.ReplaceMesh(meshId, one.data(), 1, many.data(), 12));
+    // 顶点超出：40 + 120 > 120
+    CHECK(!pool.ReplaceMesh(meshId, three.data(), 3, i3.data(), 3));
+
+    // 5 个 Packed 顶点不对齐时 40 + 80 = 120 正好放得下，对齐到 48 后为 128，必须拒绝
+    std::vector<FloatVertex> five = MakeVertices(5, 0.0f);
+    PositionDecode decode;
+    std::vector<PackedVertex> packed = Pack(five, decode);
+    std::vector<uint16_t> i5 = MakeFanIndices(5);
+    CHECK(!pool.ReplaceMesh(meshId, packed.data(), 5, i5.data(), static_cast<uint32_t>(i5.size()), VertexFormat::Packed, &decode));
+
+    // 被拒绝的替换不改动池和偏移表
+    CHECK(pool.GetVertexByteSize() == 40 && pool.GetIndexCount() == 3);
+    CHECK(pool.GetMesh(meshId).baseVertex == 0 && pool.GetMesh(meshId).vertexCount == 1);
+    CHECK(pool.GetMesh(meshId).format == VertexFormat::Float);
+
+    // 4 个 Packed 顶点对齐后为 48 + 64 = 112，可以放下
+    CHECK(pool.ReplaceMesh(meshId, packed.data(), 4, i3.data(), 3, VertexFormat::Packed, &decode));
+    CHECK(pool.GetMesh(meshId).baseVertex == 3 && pool.GetMesh(meshId).format == VertexFormat::Packed);
+}
+
+TEST_CASE(ReplaceMeshWithoutReserveFails)
+{
+    GeometryPool pool(sizeof(FloatVertex));
+    std::vector<FloatVertex> vertices = MakeVertices(3, 0.0f);
+    std::vector<uint16_t> indices = MakeFanIndices(3);
+    const int meshId = pool.AddMesh(vertices.data(), 3, indices.data(), 3);
+    CHECK(!pool.ReplaceMesh(meshId, vertices.data(), 3, indices.data(), 3));
+}
+
+// ==== 顶点位置 ====
+TEST_CASE(PositionsOfFloatAndPackedMeshes)
+{
+    GeometryPool pool(sizeof(FloatVertex));
+    std::vector<FloatVertex> vertices = MakeVertices(17, -4.0f);
+    std::vector<uint16_t> indices = MakeFanIndices(17);
+    PositionDecode decode;
+    std::vector<PackedVertex> packed = Pack(vertices, decode);
+    const int floatId = pool.AddMesh(vertices.data(), 17, indices.data(), static_cast<uint32_t>(indices.size()));
+    const int packedId = pool.AddMesh(packed.data(), 17, indices.data(), static_cast<uint32_t>(indices.size()),
+        VertexFormat::Packed, &decode);
+
+    std::vector<XMFLOAT3> floatPositions, packedPositions;
+    pool.GetPositions(floatId, floatPositions);
+    pool.GetPositions(packedId, packedPositions);
+    CHECK(floatPositions.size() == 17 && packedPositions.size() == 17);
+
+    float maxRadius = 0.0f;
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        const XMFLOAT3& expected = vertices[i].pos;
+        CHECK(floatPositions[i].x == expected.x && floatPositions[i].y == expected.y && floatPositions[i].z == expected.z);
+        // 每轴误差不超过包围盒尺寸 / 65535 的一半
+        CHECK_NEAR(packedPositions[i].x, expected.x, decode.scale[0] / 65535.0f * 0.5f + 1e-5f);
+        CHECK_NEAR(packedPositions[i].y, expected.y, decode.scale[1] / 65535.0f * 0.5f + 1e-5f);
+        CHECK_NEAR(packedPositions[i].z, expected.z, decode.scale[2] / 65535.0f * 0.5f + 1e-5f);
+        const float radius = std::sqrt(expected.x * expected.x + expected.y * expected.y + expected.z * expected.z);
+        maxRadius = std::max(maxRadius, radius);
+    }
+    CHECK_NEAR(pool.ComputeBoundingRadius(floatId), maxRadius, 1e-5f);
+    CHECK_NEAR(pool.ComputeBoundingRadius(packedId), maxRadius, 1e-3f);
+}
+
+TEST_MAIN()
@@ -0,0 +1,201 @@
+//***************************************************************************************
+// GlyphCookerTests.cpp
+//
+// 烘焙工具的往返：OBJ -> ObjImporter -> CookMesh -> GlyphMeshFile::Write -> Open，
+// 文件中的顶点和索引与烘焙结果逐字节相同，文件头与烘焙时的描述一致；
+// 按位置还原出的三角形（保持绕序）与 OBJ 中的三角形相同，法线为各面的几何法线；
+// 压缩为 Packed 时反量化参数随文件保存，解码后的位置误差不超过记录的压缩误差。
+// 测试在当前目录写临时文件，结束时删除。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "MeshCook.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* const kTempObj = "GlyphCookerTests_tmp.obj";
+    const char* const kTempMesh = "GlyphCookerTests_tmp.gmesh";
+
+    // 边长 10 的立方体（按默认系数缩放后为单位立方体），每个面是一个四边形（导入时扇形三角化为两个三角形），绕序朝外
+    const char* const kCubeObj =
+        "# cube\n"
+        "v 0 0 0\nv 10 0 0\nv 10 10 0\nv 0 10 0\n"
+        "v 0 0 10\nv 10 0 10\nv 10 10 10\nv 0 10 10\n"
+        "f 1 4 3 2\nf 5 6 7 8\nf 1 2 6 5\nf 2 3 7 6\nf 3 4 8 7\nf 4 1 5 8\n";
+
+    typedef std::array<float, 3> Position;
+    typedef std::array<Position, 3> Triangle;
+
+    bool ImportText(const char* text, ObjMesh& mesh)
+    {
+        {
+            std::ofstream file(kTempObj, std::ios::binary);
+            file << text;
+        }
+        JobSystem jobs;
+        ObjImporter importer(&jobs);
+        const bool ok = importer.Import(kTempObj, mesh);
+        remove(kTempObj);
+        return ok;
+    }
+
+    // 旋转到最小的顶点在前（不改变绕序），再整体排序，便于比较与顶点编号无关的三角形集合
+    void Canonicalize(std::vector<Triangle>& triangles)
+    {
+        for (Triangle& triangle : triangles)
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        std::sort(triangles.begin(), triangles.end());
+    }
+
+    std::vector<Triangle> ObjTriangles(const ObjMesh& obj, float scale)
+    {
+        std::vector<Triangle> triangles(obj.indices.size() / 3);
+        for (size_t i = 0; i < obj.indices.size(); ++i)
+        {
+            const ObjVertex& v = obj.vertices[obj.indices[i]];
+            for (int axis = 0; axis < 3; ++axis)
+                triangles[i / 3][i % 3][axis] = static_cast<float>(v.pos[axis]) * scale;
+        }
+        Canonicalize(triangles);
+        return triangles;
+    }
+
+    std::vector<Triangle> FileTriangles(const FloatVertex* pVertices, const uint16_t* pIndices, uint32_t indexCount)
+    {
+        std::vector<Triangle> triangles(indexCount / 3);
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            const FloatVertex& v = pVertices[pIndices[i]];
+            triangles[i / 3][i % 3] = Position{ { v.pos.x, v.pos.y, v.pos.z } };
+        }
+        Canonicalize(triangles);
+        return triangles;
+    }
+
+    bool SameHeader(const GlyphMeshHeader& header, const GlyphMeshDesc& desc)
+    {
+        bool same = header.vertexFormat == static_cast<uint32_t>(desc.format)
+            && header.vertexCount == desc.vertexCount && header.indexCount == desc.indexCount
+            && header.sourceVertexCount == desc.sourceVertexCount
+            && header.acmrBefore == desc.acmrBefore && header.acmrAfter == desc.acmrAfter
+            && header.atvrBefore == desc.atvrBefore && header.atvrAfter == desc.atvrAfter;
+        for (int axis = 0; axis < 3; ++axis)
+            same = same && header.aabbMin[axis] == desc.aabbMin[axis] && header.aabbMax[axis] == desc.aabbMax[axis];
+        return same;
+    }
+}
+
+TEST_CASE(FloatCookRoundTripsThroughFile)
+{
+    ObjMesh obj;
+    CHECK(ImportText(kCubeObj, obj));
+    CHECK(obj.indices.size() == 36);
+
+    CookOptions options;
+    options.allowPacked = false;
+    CookedMesh cooked;
+    std::string error;
+    CHECK(CookMesh(obj, options, cooked, &error));
+    CHECK(cooked.desc.format == VertexFormat::Float);
+    // 相邻面法线不同，每个面 4 个顶点焊接后各自保留
+    CHECK(cooked.desc.vertexCount == 24 && cooked.desc.indexCount == 36 && cooked.desc.sourceVertexCount == 36);
+    CHECK(cooked.desc.aabbMin[0] == 0.0f && cooked.desc.aabbMax[2] == 1.0f);
+
+    CHECK(GlyphMeshFile::Write(kTempMesh, cooked.desc));
+    {
+        GlyphMeshFile file;
+        CHECK(file.Open(kTempMesh));
+        const GlyphMeshHeader& header = file.GetHeader();
+        CHECK(SameHeader(header, cooked.desc));
+        CHECK(memcmp(file.GetVertices(), cooked.vertices.data(), cooked.vertices.size() * sizeof(FloatVertex)) == 0);
+        CHECK(memcmp(file.GetIndices(), cooked.indices.data(), cooked.indices.size() * sizeof(uint16_t)) == 0);
+
+        // 与 OBJ 中缩放后的三角形完全相同，绕序不变
+        const FloatVertex* pVertices = reinterpret_cast<const FloatVertex*>(file.GetVertices());
+        CHECK(FileTriangles(pVertices, file.GetIndices(), header.indexCount) == ObjTriangles(obj, options.scale));
+
+        // 每个三角形的三个顶点都带着该面的几何法线
+        bool geometricNormals = true;
+        for (uint32_t i = 0; i < header.indexCount; i += 3)
+        {
+            const FloatVertex& a = pVertices[file.GetIndices()[i]];
+            const FloatVertex& b = pVertices[file.GetIndices()[i + 1]];
+            const FloatVertex& c = pVertices[file.GetIndices()[i + 2]];
+            const float e1[3] = { b.pos.x - a.pos.x, b.pos.y - a.pos.y, b.pos.z - a.pos.z };
+            const float e2[3] = { c.pos.x - a.pos.x, c.pos.y - a.pos.y, c.pos.z - a.pos.z };
+            const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+            const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (const FloatVertex* pCorner : { &a, &b, &c })
+            {
+                geometricNormals = geometricNormals && std::fabs(pCorner->normal.x - n[0] / length) < 1e-6f
+                    && std::fabs(pCorner->normal.y - n[1] / length) < 1e-6f
+                    && std::fabs(pCorner->normal.z - n[2] / length) < 1e-6f;
+            }
+        }
+        CHECK(geometricNormals);
+    }
+    remove(kTempMesh);
+}
+
+TEST_CASE(PackedCookRoundTripsThroughFile)
+{
+    ObjMesh obj;
+    CHECK(ImportText(kCubeObj, obj));
+
+    CookedMesh cooked;
+    std::string error;
+    CHECK(CookMesh(obj, CookOptions(), cooked, &error));
+    CHECK(cooked.desc.format == VertexFormat::Packed);
+    CHECK(cooked.packed.size() == cooked.vertices.size());
+
+    CHECK(GlyphMeshFile::Write(kTempMesh, cooked.desc));
+    {
+        GlyphMeshFile file;
+        CHECK(file.Open(kTempMesh));
+        const GlyphMeshHeader& header = file.GetHeader();
+        CHECK(file.GetVertexFormat() == VertexFormat::Packed && header.vertexStride == sizeof(PackedVertex));
+        CHECK(SameHeader(header, cooked.desc));
+        CHECK(memcmp(&header.decode, &cooked.desc.decode, sizeof(PositionDecode)) == 0);
+        CHECK(header.packError[0] == cooked.packError.position && header.packError[1] == cooked.packError.normal);
+        CHECK(memcmp(file.GetVertices(), cooked.packed.data(), cooked.packed.size() * sizeof(PackedVertex)) == 0);
+        CHECK(memcmp(file.GetIndices(), cooked.indices.data(), cooked.indices.size() * sizeof(uint16_t)) == 0);
+
+        // 用文件中的反量化参数解码，与压缩前的 Float 顶点一一对应
+        const PackedVertex* pPacked = reinterpret_cast<const PackedVertex*>(file.GetVertices());
+        std::vector<FloatVertex> decoded(header.vertexCount);
+        float maxError = 0.0f;
+        for (uint32_t i = 0; i < header.vertexCount; ++i)
+        {
+            UnpackVertex(pPacked[i], header.decode, decoded[i]);
+            maxError = std::max(maxError, std::fabs(decoded[i].pos.x - cooked.vertices[i].pos.x));
+            maxError = std::max(maxError, std::fabs(decoded[i].pos.y - cooked.vertices[i].pos.y));
+            maxError = std::max(maxError, std::fabs(decoded[i].pos.z - cooked.vertices[i].pos.z));
+        }
+        CHECK(maxError <= header.packError[0]);
+        // 立方体的角点正好落在量化格点上
+        CHECK(FileTriangles(decoded.data(), file.GetIndices(), header.indexCount) == ObjTriangles(obj, 0.1f));
+    }
+    remove(kTempMesh);
+}
+
+TEST_CASE(RejectsMeshWithoutTriangles)
+{
+    // ObjImporter 已经拒绝没有面的 OBJ，这里直接构造空网格
+    ObjMesh obj;
+    obj.vertices.resize(2);
+    CookedMesh cooked;
+    std::string error;
+    CHECK(!CookMesh(obj, CookOptions(), cooked, &error));
+    CHECK(!error.empty());
+}
+
+TEST_MAIN()
@@ -0,0 +1,254 @@
+//***************************************************************************************
+// GlyphMeshFileTests.cpp
+//
+// GlyphMeshFile：写出的文件头、流的 64 字节对齐和零填充，Open 后取回的顶点和索引与写入的相同；
+// 魔数、版本、格式、步长、数量、流范围和对齐任何一项不合法都拒绝，截断到任意长度都拒绝，
+// 随机改写文件头时要么拒绝、要么两个流仍然完整落在文件内。
+// 烘焙工具从 OBJ 到文件的往返见 GlyphCookerTests（需要 DirectXMath）。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "GlyphMeshFile.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const char* const kTempMesh = "GlyphMeshFileTests_tmp.gmesh";
+
+    struct TestMesh
+    {
+        std::vector<uint8_t> vertices;
+        std::vector<uint16_t> indices;
+        GlyphMeshDesc desc;
+    };
+
+    // 顶点内容不需要有意义，只要每个字节不同，便于发现错位
+    void MakeMesh(VertexFormat format, uint32_t vertexCount, uint32_t triangleCount, TestMesh& mesh)
+    {
+        mesh.vertices.resize(static_cast<size_t>(vertexCount) * GetVertexStride(format));
+        for (size_t i = 0; i < mesh.vertices.size(); ++i)
+            mesh.vertices[i] = static_cast<uint8_t>(i * 7 + 1);
+        mesh.indices.resize(static_cast<size_t>(triangleCount) * 3);
+        for (size_t i = 0; i < mesh.indices.size(); ++i)
+            mesh.indices[i] = static_cast<uint16_t>((i * 5) % vertexCount);
+
+        mesh.desc = GlyphMeshDesc();
+        mesh.desc.format = format;
+        mesh.desc.pVertices = mesh.vertices.data();
+        mesh.desc.vertexCount = vertexCount;
+        mesh.desc.pIndices = mesh.indices.data();
+        mesh.desc.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        mesh.desc.sourceVertexCount = triangleCount * 3;
+        mesh.desc.acmrBefore = 2.5f;
+        mesh.desc.acmrAfter = 0.75f;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            mesh.desc.aabbMin[axis] = -1.0f - axis;
+            mesh.desc.aabbMax[axis] = 1.0f + axis;
+            mesh.desc.decode.scale[axis] = 2.0f + 2.0f * axis;
+            mesh.desc.decode.offset[axis] = mesh.desc.aabbMin[axis];
+            mesh.desc.packError[axis] = 1e-3f * (axis + 1);
+        }
+    }
+
+    bool ReadFile(const char* path, std::vector<uint8_t>& data)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    void WriteFile(const char* path, const uint8_t* pData, size_t size)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(pData), static_cast<std::streamsize>(size));
+    }
+
+    // 写出网格后读回整个文件
+    bool WriteAndRead(const TestMesh& mesh, std::vector<uint8_t>& data)
+    {
+        const bool ok = GlyphMeshFile::Write(kTempMesh, mesh.desc) && ReadFile(kTempMesh, data);
+        remove(kTempMesh);
+        return ok;
+    }
+
+    bool IsValid(const std::vector<uint8_t>& data)
+    {
+        const GlyphMeshHeader* pHeader = nullptr;
+        const bool valid = GlyphMeshFile::Validate(data.data(), data.size(), &pHeader);
+        return valid && pHeader == reinterpret_cast<const GlyphMeshHeader*>(data.data());
+    }
+
+    // 修改文件头的副本后检查
+    template <typename Mutate>
+    bool IsValidAfter(const std::vector<uint8_t>& data, Mutate mutate)
+    {
+        std::vector<uint8_t> copy = data;
+        GlyphMeshHeader header;
+        memcpy(&header, copy.data(), sizeof(header));
+        mutate(header);
+        memcpy(copy.data(), &header, sizeof(header));
+        return IsValid(copy);
+    }
+}
+
+TEST_CASE(WrittenFileHasAlignedStreamsAndRoundTrips)
+{
+    const VertexFormat formats[] = { VertexFormat::Float, VertexFormat::Packed };
+    for (VertexFormat format : formats)
+    {
+        TestMesh mesh;
+        MakeMesh(format, 37, 50, mesh);
+        std::vector<uint8_t> data;
+        CHECK(WriteAndRead(mesh, data));
+        CHECK(IsValid(data));
+
+        GlyphMeshHeader header;
+        memcpy(&header, data.data(), sizeof(header));
+        CHECK(header.magic == kGlyphMeshMagic && header.version == kGlyphMeshVersion);
+        CHECK(header.vertexFormat == static_cast<uint32_t>(format));
+        CHECK(header.vertexStride == GetVertexStride(format));
+        CHECK(header.vertexCount == 37 && header.indexCount == 150 && header.sourceVertexCount == 150);
+        CHECK(header.acmrBefore == 2.5f && header.acmrAfter == 0.75f);
+        CHECK(header.aabbMin[2] == -3.0f && header.aabbMax[2] == 3.0f);
+        // 反量化参数和压缩误差只在 Packed 时写入
+        const bool packed = format == VertexFormat::Packed;
+        CHECK(header.decode.scale[1] == (packed ? 4.0f : 0.0f));
+        CHECK(header.packError[0] == (packed ? 1e-3f : 0.0f));
+
+        // 两个流按 64 字节对齐，紧跟在前一部分之后，文件在索引流末尾结束，填充为 0
+        CHECK(header.vertexOffset == GlyphMeshAlign(sizeof(GlyphMeshHeader)));
+        CHECK(header.vertexOffset % kGlyphMeshStreamAlignment == 0 && header.indexOffset % kGlyphMeshStreamAlignment == 0);
+        CHECK(header.indexOffset == GlyphMeshAlign(header.vertexOffset + header.vertexBytes));
+        CHECK(data.size() == header.indexOffset + header.indexBytes);
+        bool zeroPadding = true;
+        for (size_t i = sizeof(GlyphMeshHeader); i < header.vertexOffset; ++i)
+            zeroPadding = zeroPadding && data[i] == 0;
+        for (size_t i = static_cast<size_t>(header.vertexOffset + header.vertexBytes); i < header.indexOffset; ++i)
+            zeroPadding = zeroPadding && data[i] == 0;
+        CHECK(zeroPadding);
+
+        // Open 返回映射中的指针，内容与写入的相同
+        WriteFile(kTempMesh, data.data(), data.size());
+        {
+            GlyphMeshFile file;
+            CHECK(file.Open(kTempMesh));
+            CHECK(file.IsOpen() && file.GetVertexFormat() == format);
+            CHECK(memcmp(file.GetVertices(), mesh.vertices.data(), mesh.vertices.size()) == 0);
+            CHECK(memcmp(file.GetIndices(), mesh.indices.data(), mesh.indices.size() * sizeof(uint16_t)) == 0);
+            CHECK(reinterpret_cast<uintptr_t>(file.GetVertices()) % kGlyphMeshStreamAlignment == 0);
+            file.Close();
+            CHECK(!file.IsOpen());
+        }
+        remove(kTempMesh);
+    }
+}
+
+TEST_CASE(RejectsInvalidHeaderFields)
+{
+    TestMesh mesh;
+    MakeMesh(VertexFormat::Float, 10, 4, mesh);
+    std::vector<uint8_t> data;
+    CHECK(WriteAndRead(mesh, data));
+    CHECK(IsValid(data));
+
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.magic ^= 1; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.version = kGlyphMeshVersion + 1; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.vertexFormat = static_cast<uint32_t>(VertexFormat::Count); }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.vertexStride = sizeof(PackedVertex); }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.vertexCount = 0; h.vertexBytes = 0; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.vertexCount = 65537; h.vertexBytes = 65537ull * h.vertexStride; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.indexCount = 0; h.indexBytes = 0; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.indexCount = 11; h.indexBytes = 22; }));
+    // 字节数与数量不一致
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.vertexBytes -= 1; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.indexBytes += 2; }));
+    // 流起始偏移没有对齐、与文件头重叠或超出文件
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.vertexOffset += 4; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.indexOffset += 2; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.vertexOffset = 0; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.indexOffset += kGlyphMeshStreamAlignment; }));
+    CHECK(!IsValidAfter(data, [](GlyphMeshHeader& h) { h.vertexOffset = ~0ull & ~63ull; }));
+
+    // 没改动时仍然合法（上面每项只改了副本）
+    CHECK(IsValidAfter(data, [](GlyphMeshHeader&) {}));
+
+    // 不合法的描述不会写出文件
+    mesh.desc.indexCount = 10;
+    CHECK(!GlyphMeshFile::Write(kTempMesh, mesh.desc));
+    std::vector<uint8_t> unused;
+    CHECK(!ReadFile(kTempMesh, unused));
+}
+
+TEST_CASE(RejectsTruncatedFiles)
+{
+    TestMesh mesh;
+    MakeMesh(VertexFormat::Packed, 20, 9, mesh);
+    std::vector<uint8_t> data;
+    CHECK(WriteAndRead(mesh, data));
+
+    // 文件在索引流末尾结束，少任何一个字节都不合法
+    bool rejected = true;
+    for (size_t size = 0; size < data.size(); ++size)
+    {
+        const GlyphMeshHeader* pHeader = reinterpret_cast<const GlyphMeshHeader*>(1);
+        rejected = rejected && !GlyphMeshFile::Validate(data.data(), size, &pHeader) && pHeader == nullptr;
+    }
+    CHECK(rejected);
+    const GlyphMeshHeader* pHeader = nullptr;
+    CHECK(!GlyphMeshFile::Validate(nullptr, data.size(), &pHeader));
+
+    // 磁盘上截断的文件和不存在的文件都打不开
+    WriteFile(kTempMesh, data.data(), data.size() - 1);
+    GlyphMeshFile file;
+    CHECK(!file.Open(kTempMesh));
+    CHECK(!file.IsOpen());
+    WriteFile(kTempMesh, data.data(), sizeof(GlyphMeshHeader) - 1);
+    CHECK(!file.Open(kTempMesh));
+    remove(kTempMesh);
+    CHECK(!file.Open(kTempMesh));
+
+    // 末尾多出的数据不影响
+    data.resize(data.size() + 100, 0xCD);
+    CHECK(IsValid(data));
+}
+
+TEST_CASE(CorruptHeadersNeverPointOutsideTheFile)
+{
+    TestMesh mesh;
+    MakeMesh(VertexFormat::Float, 16, 12, mesh);
+    std::vector<uint8_t> data;
+    CHECK(WriteAndRead(mesh, data));
+
+    std::mt19937 random(24);
+    uint32_t accepted = 0;
+    bool inside = true;
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::vector<uint8_t> copy = data;
+        // 改写文件头中的 1 到 4 个字节
+        const int flips = 1 + static_cast<int>(random() % 4);
+        for (int k = 0; k < flips; ++k)
+            copy[random() % sizeof(GlyphMeshHeader)] = static_cast<uint8_t>(random());
+        const GlyphMeshHeader* pHeader = nullptr;
+        if (!GlyphMeshFile::Validate(copy.data(), copy.size(), &pHeader))
+            continue;
+        ++accepted;
+        inside = inside && pHeader->vertexOffset + pHeader->vertexBytes <= copy.size()
+            && pHeader->indexOffset + pHeader->indexBytes <= copy.size()
+            && pHeader->vertexBytes == uint64_t(pHeader->vertexCount) * GetVertexStride(VertexFormat(pHeader->vertexFormat))
+            && pHeader->indexCount % 3 == 0;
+    }
+    CHECK(inside);
+    // 只改统计字段（包围盒、ACMR 等）的情况仍然合法
+    CHECK(accepted > 0);
+}
+
+TEST_MAIN()
@@ -0,0 +1,98 @@
+//***************************************************************************************
+// InputQueueBench.cpp
+//
+// 输入事件队列的吞吐：一个线程按最快速度压入 InputEvent（模拟消息线程），
+// 另一个线程按固定步长取完并更新 InputState（模拟仿真线程），报告每秒事件数；
+// 再在单线程上测量 Apply 的开销，与每帧 25 次 GetAsyncKeyState 的量级对比。
+// 用法：InputQueueBench [-quick]
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "InputState.h"
+#include <atomic>
+#include <thread>
+
+namespace
+{
+    InputEvent MakeEvent(uint32_t i)
+    {
+        InputEvent event;
+        switch (i % 4)
+        {
+        case 0: event = InputEvent{ InputEvent::KeyDown, static_cast<uint8_t>('A' + i % 26), 0, 0, 0 }; break;
+        case 1: event = InputEvent{ InputEvent::KeyUp, static_cast<uint8_t>('A' + i % 26), 0, 0, 0 }; break;
+        default: event = InputEvent{ InputEvent::MouseMove, 0, static_cast<int32_t>(i % 1920), static_cast<int32_t>(i % 1080), 0 }; break;
+        }
+        return event;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    const uint32_t eventCount = quick ? 200000 : 20000000;
+
+    // ==== 双线程：生产者压满就重试，消费者每次取完 ====
+    {
+        InputQueue queue;
+        std::atomic<bool> done{ false };
+        uint64_t fullRetries = 0;
+        TestCommon::BenchTimer timer;
+        std::thread producer([&]() {
+            for (uint32_t i = 0; i < eventCount; ++i)
+            {
+                const InputEvent event = MakeEvent(i);
+                while (!queue.Push(event))
+                {
+                    ++fullRetries;
+                    std::this_thread::yield();
+                }
+            }
+            done = true;
+        });
+
+        InputState state;
+        uint64_t drained = 0, ticks = 0;
+        while (!done || queue.Size() > 0)
+        {
+            state.BeginTick();
+            const uint32_t count = state.Drain(queue);
+            drained += count;
+            ++ticks;
+            // 取空时让出时间片，单核机器上生产者才有机会运行
+            if (count == 0)
+                std::this_thread::yield();
+        }
+        producer.join();
+        const double seconds = timer.GetSeconds();
+        TestCommon::KeepAlive(state);
+        printf("双线程：%llu 个事件，%.3f 秒，%.1f M 事件/秒，%llu 步，队列满重试 %llu 次\n",
+            static_cast<unsigned long long>(drained), seconds, drained / seconds / 1e6,
+            static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(fullRetries));
+        if (drained != eventCount)
+        {
+            fprintf(stderr, "丢失事件：%llu / %u\n", static_cast<unsigned long long>(drained), eventCount);
+            return 1;
+        }
+    }
+
+    // ==== 单线程：压入一批再取完，不含线程间同步 ====
+    {
+        InputQueue queue;
+        InputState state;
+        const uint32_t batch = 512;
+        uint64_t processed = 0;
+        TestCommon::BenchTimer timer;
+        for (uint32_t i = 0; i < eventCount; i += batch)
+        {
+            for (uint32_t j = 0; j < batch; ++j)
+                queue.Push(MakeEvent(i + j));
+            state.BeginTick();
+            processed += state.Drain(queue);
+        }
+        const double seconds = timer.GetSeconds();
+        TestCommon::KeepAlive(state);
+        printf("单线程：%llu 个事件，%.1f ns/事件\n", static_cast<unsigned long long>(processed), seconds * 1e9 / processed);
+    }
+    return 0;
+}
@@ -0,0 +1,231 @@
+//***************************************************************************************
+// InputStateTests.cpp
+//
+// SpscRing：先进先出、满/空、位置回绕，以及两个线程同时读写时不丢不乱；
+// InputState：按下/松开沿、按键重复、同一步内的短按、失去焦点和鼠标增量。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "InputState.h"
+#include <thread>
+
+namespace
+{
+    InputEvent Key(InputEvent::Type type, uint8_t key, uint64_t tick = 0)
+    {
+        return InputEvent{ type, key, 0, 0, tick };
+    }
+
+    InputEvent Mouse(int32_t x, int32_t y, uint64_t tick = 0)
+    {
+        return InputEvent{ InputEvent::MouseMove, 0, x, y, tick };
+    }
+}
+
+// ==== SpscRing ====
+TEST_CASE(RingIsFifoAndReportsFullAndEmpty)
+{
+    SpscRing<int, 4> ring;
+    int value = -1;
+    CHECK(!ring.Pop(value));
+    for (int i = 0; i < 4; ++i)
+        CHECK(ring.Push(i));
+    CHECK(!ring.Push(99));
+    CHECK(ring.Size() == 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(ring.Pop(value));
+        CHECK(value == i);
+    }
+    CHECK(!ring.Pop(value));
+    CHECK(ring.Size() == 0);
+}
+
+TEST_CASE(RingWrapsManyTimes)
+{
+    // 读写位置远超容量后仍按顺序
+    SpscRing<uint32_t, 8> ring;
+    uint32_t next = 0, expected = 0;
+    bool ordered = true;
+    for (int round = 0; round < 10000; ++round)
+    {
+        const int pushes = round % 7 + 1;
+        for (int i = 0; i < pushes; ++i)
+        {
+            if (ring.Push(next))
+                ++next;
+        }
+        uint32_t value;
+        for (int i = 0; i < round % 5 + 1 && ring.Pop(value); ++i)
+            ordered = ordered && value == expected++;
+    }
+    uint32_t value;
+    while (ring.Pop(value))
+        ordered = ordered && value == expected++;
+    CHECK(ordered);
+    CHECK(expected == next);
+}
+
+TEST_CASE(RingAcrossThreadsKeepsOrder)
+{
+    const uint32_t kCount = 200000;
+    SpscRing<uint32_t, 64> ring;
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < kCount; ++i)
+        {
+            while (!ring.Push(i))
+                std::this_thread::yield();
+        }
+    });
+
+    uint32_t expected = 0;
+    bool ordered = true;
+    while (expected < kCount)
+    {
+        uint32_t value;
+        if (ring.Pop(value))
+            ordered = ordered && value == expected++;
+        else
+            std::this_thread::yield();
+    }
+    producer.join();
+    CHECK(ordered);
+    uint32_t value;
+    CHECK(!ring.Pop(value));
+}
+
+// ==== InputState ====
+TEST_CASE(PressAndReleaseEdges)
+{
+    InputState state;
+    state.BeginTick();
+    state.Apply(Key(InputEvent::KeyDown, 'W'));
+    CHECK(state.IsDown('W') && state.WasPressed('W') && !state.WasReleased('W'));
+
+    // 下一步仍按住：只有状态，没有沿；系统的按键重复不产生新的按下沿
+    state.BeginTick();
+    state.Apply(Key(InputEvent::KeyDown, 'W'));
+    CHECK(state.IsDown('W') && !state.WasPressed('W'));
+
+    state.BeginTick();
+    state.Apply(Key(InputEvent::KeyUp, 'W'));
+    CHECK(!state.IsDown('W') && state.WasReleased('W'));
+
+    // 没按下时的 KeyUp 不产生松开沿
+    state.BeginTick();
+    state.Apply(Key(InputEvent::KeyUp, 'W'));
+    CHECK(!state.WasReleased('W'));
+}
+
+TEST_CASE(TapWithinOneTickIsNotLost)
+{
+    // 高帧率下一步很短，按下又松开落在同一步内，旧的按键冷却会把它丢掉
+    InputState state;
+    state.BeginTick();
+    state.Apply(Key(InputEvent::KeyDown, 'C'));
+    state.Apply(Key(InputEvent::KeyUp, 'C'));
+    CHECK(!state.IsDown('C'));
+    CHECK(state.WasPressed('C') && state.WasReleased('C'));
+    state.BeginTick();
+    CHECK(!state.WasPressed('C') && !state.WasReleased('C'));
+}
+
+TEST_CASE(FocusLostReleasesAllKeys)
+{
+    InputState state;
+    state.BeginTick();
+    state.Apply(Key(InputEvent::KeyDown, 'A'));
+    state.Apply(Key(InputEvent::KeyDown, 255));
+    state.BeginTick();
+    state.Apply(Key(InputEvent::FocusLost, 0));
+    CHECK(!state.IsDown('A') && !state.IsDown(255));
+    CHECK(state.WasReleased('A') && state.WasReleased(255));
+    CHECK(!state.WasReleased('B'));
+}
+
+TEST_CASE(MouseDeltaAccumulatesPerTick)
+{
+    InputState state;
+    state.BeginTick();
+    // 第一次移动只记录位置
+    state.Apply(Mouse(100, 100));
+    CHECK(state.GetMouseDeltaX() == 0.0f && state.GetMouseDeltaY() == 0.0f);
+    state.Apply(Mouse(110, 95));
+    state.Apply(Mouse(115, 90));
+    CHECK(state.GetMouseDeltaX() == 15.0f && state.GetMouseDeltaY() == -10.0f);
+
+    state.BeginTick();
+    CHECK(state.GetMouseDeltaX() == 0.0f);
+    state.Apply(Mouse(120, 90));
+    CHECK(state.GetMouseDeltaX() == 5.0f);
+
+    // 重新获得焦点后光标可能在别处，跳过一次增量
+    state.Apply(Key(InputEvent::FocusGained, 0));
+    state.Apply(Mouse(500, 500));
+    CHECK(state.GetMouseDeltaX() == 0.0f && state.GetMouseDeltaY() == 0.0f);
+    state.Apply(Mouse(501, 502));
+    CHECK(state.GetMouseDeltaX() == 1.0f && state.GetMouseDeltaY() == 2.0f);
+}
+
+TEST_CASE(DrainAppliesQueuedEventsInOrder)
+{
+    InputQueue queue;
+    queue.Push(Key(InputEvent::KeyDown, 'Q'));
+    queue.Push(Mouse(0, 0));
+    queue.Push(Mouse(3, 4));
+    queue.Push(Key(InputEvent::KeyUp, 'Q'));
+    queue.Push(Key(InputEvent::KeyDown, 'E'));
+
+    InputState state;
+    state.BeginTick();
+    CHECK(state.Drain(queue) == 5);
+    CHECK(state.WasPressed('Q') && state.WasReleased('Q') && !state.IsDown('Q'));
+    CHECK(state.IsDown('E'));
+    CHECK(state.GetMouseDeltaX() == 3.0f && state.GetMouseDeltaY() == 4.0f);
+    CHECK(state.Drain(queue) == 0);
+}
+
+TEST_CASE(PeekLeavesTheItemForPop)
+{
+    SpscRing<int, 4> ring;
+    int value = -1;
+    CHECK(!ring.Peek(value));
+    ring.Push(7);
+    ring.Push(8);
+    CHECK(ring.Peek(value) && value == 7);
+    CHECK(ring.Size() == 2);
+    CHECK(ring.Pop(value) && value == 7);
+    CHECK(ring.Peek(value) && value == 8);
+}
+
+// 仿真线程补步时，每步只取属于它的事件，后面的事件留到对应的步
+TEST_CASE(DrainStopsAtEventsForLaterTicks)
+{
+    InputQueue queue;
+    queue.Push(Key(InputEvent::KeyDown, 'W', 3));
+    queue.Push(Mouse(0, 0, 3));
+    queue.Push(Key(InputEvent::KeyUp, 'W', 4));
+    queue.Push(Mouse(10, 0, 6));
+
+    InputState state;
+    for (uint64_t tick = 1; tick <= 2; ++tick)
+    {
+        state.BeginTick();
+        CHECK(state.Drain(queue, tick) == 0);
+    }
+    state.BeginTick();
+    CHECK(state.Drain(queue, 3) == 2);
+    CHECK(state.WasPressed('W') && state.IsDown('W'));
+    state.BeginTick();
+    CHECK(state.Drain(queue, 4) == 1);
+    CHECK(state.WasReleased('W') && !state.IsDown('W'));
+    state.BeginTick();
+    CHECK(state.Drain(queue, 5) == 0);
+    CHECK(state.GetMouseDeltaX() == 0.0f);
+    state.BeginTick();
+    CHECK(state.Drain(queue, 6) == 1);
+    CHECK(state.GetMouseDeltaX() == 10.0f);
+    CHECK(queue.Size() == 0);
+}
+
+TEST_MAIN()
@@ -0,0 +1,64 @@
+//***************************************************************************************
+// InstanceBuilderBench.cpp
+//
+// 按字符森林的规模（n³ 个主字，每个主字带 orbitMax 个子字，四种字轮流）生成一帧实例，
+// 报告实例化前后每帧的绘制调用次数和构建耗时。
+// 用法：InstanceBuilderBench [-quick]
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "InstanceBuilder.h"
+
+namespace
+{
+    const int kGlyphCount = 4;
+    const int kOrbiters = 3;
+    const uint32_t kMaxInstancesPerDraw = 65536;
+
+    void BuildFrame(InstanceBuilder& builder, int n)
+    {
+        builder.Reset(kGlyphCount);
+        float world[16] = {
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f };
+        for (int cell = 0; cell < n * n * n; ++cell)
+        {
+            world[12] = static_cast<float>(cell);
+            const int glyph = cell % kGlyphCount;
+            builder.Add(glyph, world, static_cast<uint32_t>(glyph));
+            for (int k = 0; k < kOrbiters; ++k)
+            {
+                const int child = (glyph + 1 + k) % kGlyphCount;
+                builder.Add(child, world, static_cast<uint32_t>(child));
+            }
+        }
+        builder.Build(kMaxInstancesPerDraw);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    const int sizes[] = { 10, 50, 100 };
+    const int sizeCount = quick ? 1 : 3;
+    const int frames = quick ? 3 : 20;
+
+    InstanceBuilder builder;
+    printf("%6s %12s %14s %12s %12s\n", "n", "实例数", "逐物体绘制", "实例化绘制", "构建 ms/帧");
+    for (int s = 0; s < sizeCount; ++s)
+    {
+        const int n = sizes[s];
+        BuildFrame(builder, n);     // 预热：之后的帧复用容量
+        TestCommon::BenchTimer timer;
+        for (int frame = 0; frame < frames; ++frame)
+            BuildFrame(builder, n);
+        const double msPerFrame = timer.GetSeconds() * 1000.0 / frames;
+        const InstanceBuilder::Stats& stats = builder.GetStats();
+        printf("%6d %12u %14u %12u %12.3f\n", n, stats.instanceCount, stats.legacyDrawCalls, stats.drawCalls,
+            msPerFrame);
+        TestCommon::KeepAlive(builder.GetInstances(0));
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+//***************************************************************************************
+// InstanceBuilderTests.cpp
+//
+// InstanceBuilder：按网格分桶、批次切分、合并与跨帧复用。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "InstanceBuilder.h"
+
+namespace
+{
+    void MakeTranslation(float x, float y, float z, float world[16])
+    {
+        for (int i = 0; i < 16; ++i)
+            world[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+        world[12] = x;
+        world[13] = y;
+        world[14] = z;
+    }
+}
+
+TEST_CASE(BucketsInstancesPerMesh)
+{
+    InstanceBuilder builder(3);
+    float world[16];
+    for (int i = 0; i < 10; ++i)
+    {
+        MakeTranslation(static_cast<float>(i), 0.0f, 0.0f, world);
+        builder.Add(i % 3, world, static_cast<uint32_t>(i));
+    }
+    builder.Build(1024);
+
+    CHECK(builder.GetInstanceCount(0) == 4);
+    CHECK(builder.GetInstanceCount(1) == 3);
+    CHECK(builder.GetInstanceCount(2) == 3);
+    // 每个桶内保持追加顺序
+    const InstanceData* pMesh1 = builder.GetInstances(1);
+    CHECK(pMesh1[0].materialIndex == 1 && pMesh1[1].materialIndex == 4 && pMesh1[2].materialIndex == 7);
+    CHECK(pMesh1[2].world[3][0] == 7.0f);
+
+    const InstanceBuilder::Stats& stats = builder.GetStats();
+    CHECK(stats.instanceCount == 10);
+    CHECK(stats.legacyDrawCalls == 10);
+    CHECK(stats.drawCalls == 3);
+    CHECK(builder.GetBatches().size() == 3);
+}
+
+TEST_CASE(SplitsBatchesAtDrawLimit)
+{
+    InstanceBuilder builder(2);
+    float world[16];
+    MakeTranslation(0.0f, 0.0f, 0.0f, world);
+    for (int i = 0; i < 10; ++i)
+        builder.Add(0, world, 0);
+    builder.Add(1, world, 0);
+    builder.Build(4);
+
+    const std::vector<InstanceBuilder::Batch>& batches = builder.GetBatches();
+    CHECK(batches.size() == 4);
+    CHECK(batches[0].meshId == 0 && batches[0].firstInstance == 0 && batches[0].instanceCount == 4);
+    CHECK(batches[1].meshId == 0 && batches[1].firstInstance == 4 && batches[1].instanceCount == 4);
+    CHECK(batches[2].meshId == 0 && batches[2].firstInstance == 8 && batches[2].instanceCount == 2);
+    CHECK(batches[3].meshId == 1 && batches[3].firstInstance == 0 && batches[3].instanceCount == 1);
+    CHECK(builder.GetStats().drawCalls == 4);
+}
+
+TEST_CASE(EmptyMeshesProduceNoBatches)
+{
+    InstanceBuilder builder(4);
+    float world[16];
+    MakeTranslation(0.0f, 0.0f, 0.0f, world);
+    builder.Add(2, world, 0);
+    builder.Build(16);
+    CHECK(builder.GetBatches().size() == 1);
+    CHECK(builder.GetBatches()[0].meshId == 2);
+    CHECK(builder.GetInstanceCount(0) == 0);
+}
+
+TEST_CASE(AppendMergesPerMesh)
+{
+    InstanceBuilder a(2), b(2);
+    float world[16];
+    MakeTranslation(0.0f, 0.0f, 0.0f, world);
+    a.Add(0, world, 1);
+    b.Add(0, world, 2);
+    b.Add(1, world, 3);
+    a.Append(b);
+    a.Build(16);
+    CHECK(a.GetInstanceCount(0) == 2);
+    CHECK(a.GetInstanceCount(1) == 1);
+    CHECK(a.GetInstances(0)[1].materialIndex == 2);
+    CHECK(a.GetStats().instanceCount == 3);
+}
+
+TEST_CASE(ResetKeepsCapacity)
+{
+    InstanceBuilder builder(1);
+    float world[16];
+    MakeTranslation(0.0f, 0.0f, 0.0f, world);
+    for (int i = 0; i < 100; ++i)
+        builder.Add(0, world, 0);
+    const InstanceData* pBefore = builder.GetInstances(0);
+    builder.Reset(1);
+    CHECK(builder.GetInstanceCount(0) == 0);
+    CHECK(builder.GetBatches().empty());
+    CHECK(builder.GetStats().instanceCount == 0);
+    for (int i = 0; i < 100; ++i)
+        builder.Add(0, world, 0);
+    // 容量没有释放，第二帧不重新分配
+    CHECK(builder.GetInstances(0) == pBefore);
+}
+
+TEST_MAIN()
@@ -0,0 +1,155 @@
+//***************************************************************************************
+// JobSystemBench.cpp
+//
+// 帧准备随线程数的扩展：按 SceneRenderer::SchedulePrepare 的结构组织一帧的工作——
+// 按 ix 切片并行剔除 n³ 个单元 -> 按切片并行为可见单元生成主字和子字实例 -> 合并并切分批次，
+// 三步用任务依赖串起来。在 n = 100、200 下用不同的工作线程数运行，报告每帧耗时和加速比。
+// 实例矩阵用标量代码计算，与 ForestScene 的工作量同一量级，但不依赖 DirectXMath。
+// 用法：JobSystemBench [-quick]
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestCamera.h"
+#include "FrustumCuller.h"
+#include "InstanceBuilder.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    const int kMeshCount = 7;
+    const int kSubGlyphsPerCell = 3;
+    const uint32_t kMaxInstancesPerDraw = 65536;
+
+    struct FrameData
+    {
+        int n = 0;
+        SphereSoA bounds;
+        FrustumCuller frustum;
+        std::vector<uint8_t> visible;
+        std::vector<InstanceBuilder> slabBuilders;
+        InstanceBuilder builder;
+    };
+
+    // 绕 y 轴旋转、缩放后平移
+    void MakeWorld(float angle, float scale, float x, float y, float z, float world[16])
+    {
+        const float c = std::cos(angle) * scale, s = std::sin(angle) * scale;
+        const float m[16] = {
+            c,    0.0f, -s,   0.0f,
+            0.0f, scale, 0.0f, 0.0f,
+            s,    0.0f, c,    0.0f,
+            x,    y,    z,    1.0f };
+        std::copy(m, m + 16, world);
+    }
+
+    void CullSlab(FrameData& frame, uint32_t ix)
+    {
+        const size_t slab = static_cast<size_t>(frame.n) * frame.n;
+        const size_t first = ix * slab;
+        frame.frustum.Cull(&frame.bounds.x[first], &frame.bounds.y[first], &frame.bounds.z[first], &frame.bounds.r[first],
+            static_cast<uint32_t>(slab), &frame.visible[first]);
+    }
+
+    void BuildSlab(FrameData& frame, uint32_t ix)
+    {
+        InstanceBuilder& builder = frame.slabBuilders[ix];
+        builder.Reset(kMeshCount);
+        const size_t slab = static_cast<size_t>(frame.n) * frame.n;
+        float world[16];
+        for (size_t cell = ix * slab; cell < (ix + 1) * slab; ++cell)
+        {
+            if (!frame.visible[cell])
+                continue;
+            const float x = frame.bounds.x[cell], y = frame.bounds.y[cell], z = frame.bounds.z[cell];
+            const uint32_t meshId = static_cast<uint32_t>(cell % kMeshCount);
+            MakeWorld(0.1f * static_cast<float>(cell % 31), 1.0f, x, y, z, world);
+            builder.Add(static_cast<int>(meshId), world, meshId);
+            for (int sub = 0; sub < kSubGlyphsPerCell; ++sub)
+            {
+                const float angle = 2.0944f * sub;
+                MakeWorld(angle, 0.4f, x + std::cos(angle), y + 1.0f, z + std::sin(angle), world);
+                builder.Add((static_cast<int>(meshId) + 1 + sub) % kMeshCount, world, meshId);
+            }
+        }
+    }
+
+    // 一帧的准备：剔除 -> 生成实例 -> 合并与切分批次
+    void PrepareFrame(JobSystem& jobs, FrameData& frame)
+    {
+        const uint32_t n = static_cast<uint32_t>(frame.n);
+        JobSystem::JobHandle cull = jobs.Schedule([&jobs, &frame, n]() {
+            jobs.ParallelFor(0, n, 1, [&frame](uint32_t begin, uint32_t end) {
+                for (uint32_t ix = begin; ix < end; ++ix)
+                    CullSlab(frame, ix);
+            });
+        });
+        JobSystem::JobHandle instances = jobs.Schedule([&jobs, &frame, n]() {
+            jobs.ParallelFor(0, n, 1, [&frame](uint32_t begin, uint32_t end) {
+                for (uint32_t ix = begin; ix < end; ++ix)
+                    BuildSlab(frame, ix);
+            });
+        }, &cull, 1);
+        JobSystem::JobHandle drawItems = jobs.Schedule([&frame, n]() {
+            frame.builder.Reset(kMeshCount);
+            for (uint32_t ix = 0; ix < n; ++ix)
+                frame.builder.Append(frame.slabBuilders[ix]);
+            frame.builder.Build(kMaxInstancesPerDraw);
+        }, &instances, 1);
+        jobs.Wait(drawItems);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    const int sizes[] = { 100, 200 };
+    const int quickSizes[] = { 20 };
+    const int* pSizes = quick ? quickSizes : sizes;
+    const int sizeCount = quick ? 1 : 2;
+    const int frames = quick ? 2 : 10;
+    const float spacing = 4.5f;
+
+    // 工作线程数：0（只有调用线程）、1、3、7 …… 直到硬件线程数 - 1
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> workerCounts;
+    for (unsigned workers = 0; workers < hardware; workers = workers * 2 + 1)
+        workerCounts.push_back(workers);
+    if (workerCounts.back() != hardware - 1)
+        workerCounts.push_back(hardware - 1);
+    if (quick)
+        workerCounts.resize(std::min<size_t>(workerCounts.size(), 2));
+
+    printf("硬件线程 %u\n", hardware);
+    printf("%6s %8s %12s %10s %12s\n", "n", "线程", "ms/帧", "加速比", "实例");
+    for (int s = 0; s < sizeCount; ++s)
+    {
+        FrameData frame;
+        frame.n = pSizes[s];
+        TestCamera::BuildGrid(frame.n, spacing, 3.0f, frame.bounds);
+        frame.visible.resize(frame.bounds.Size());
+        frame.slabBuilders.resize(frame.n);
+        TestCamera::Camera cameras[4];
+        TestCamera::MakeForestCameras(frame.n, spacing, cameras);
+        float viewProj[16];
+        TestCamera::MakeViewProj(cameras[0], viewProj);
+        frame.frustum.SetViewProj(viewProj);
+
+        double baselineMs = 0.0;
+        for (unsigned workers : workerCounts)
+        {
+            JobSystem jobs(workers);
+            PrepareFrame(jobs, frame);      // 预热：分配各切片的实例容量
+            TestCommon::BenchTimer timer;
+            for (int f = 0; f < frames; ++f)
+                PrepareFrame(jobs, frame);
+            const double ms = timer.GetSeconds() * 1000.0 / frames;
+            if (workers == 0)
+                baselineMs = ms;
+            printf("%6d %8u %12.3f %9.2fx %12u\n", frame.n, workers + 1, ms, baselineMs / ms,
+                frame.builder.GetStats().instanceCount);
+        }
+    }
+    return 0;
+}
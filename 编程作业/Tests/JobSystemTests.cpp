@@ -0,0 +1,130 @@
+//***************************************************************************************
+// JobSystemTests.cpp
+//
+// JobSystem：依赖顺序、Wait、ParallelFor 的覆盖范围，以及没有工作线程时的退化路径。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+
+TEST_CASE(EmptyHandleCountsAsDone)
+{
+    JobSystem jobs(2);
+    jobs.Wait(JobSystem::JobHandle());
+    JobSystem::JobHandle none;
+    std::atomic<int> ran{ 0 };
+    jobs.Wait(jobs.Schedule([&]() { ++ran; }, &none, 1));
+    CHECK(ran == 1);
+}
+
+TEST_CASE(DependenciesRunFirst)
+{
+    for (unsigned workers : { 0u, 1u, 3u })
+    {
+        JobSystem jobs(workers);
+        for (int round = 0; round < 50; ++round)
+        {
+            // 菱形依赖：a -> (b, c) -> d，记录每个任务执行时的序号
+            std::atomic<int> counter{ 0 };
+            int order[4] = { -1, -1, -1, -1 };
+            JobSystem::JobHandle a = jobs.Schedule([&]() { order[0] = counter++; });
+            JobSystem::JobHandle b = jobs.Schedule([&]() { order[1] = counter++; }, &a, 1);
+            JobSystem::JobHandle c = jobs.Schedule([&]() { order[2] = counter++; }, &a, 1);
+            const JobSystem::JobHandle both[2] = { b, c };
+            JobSystem::JobHandle d = jobs.Schedule([&]() { order[3] = counter++; }, both, 2);
+            jobs.Wait(d);
+
+            CHECK(order[0] == 0);
+            CHECK(order[1] > order[0] && order[2] > order[0]);
+            CHECK(order[3] == 3);
+        }
+    }
+}
+
+TEST_CASE(DependencyAlreadyDone)
+{
+    JobSystem jobs(2);
+    std::atomic<int> ran{ 0 };
+    JobSystem::JobHandle first = jobs.Schedule([&]() { ++ran; });
+    jobs.Wait(first);
+    // 依赖已完成时立即入队，不会永远等待
+    jobs.Wait(jobs.Schedule([&]() { ++ran; }, &first, 1));
+    CHECK(ran == 2);
+}
+
+TEST_CASE(WaitRunsQueuedJobsWithoutWorkers)
+{
+    // 没有工作线程时由等待的线程自己执行任务
+    JobSystem none(0);
+    CHECK(none.GetWorkerCount() == 0);
+    std::atomic<int> ran{ 0 };
+    std::vector<JobSystem::JobHandle> handles;
+    for (int i = 0; i < 100; ++i)
+        handles.push_back(none.Schedule([&]() { ++ran; }));
+    for (const JobSystem::JobHandle& handle : handles)
+        none.Wait(handle);
+    CHECK(ran == 100);
+}
+
+TEST_CASE(ParallelForCoversRangeOnce)
+{
+    for (unsigned workers : { 0u, 1u, 3u })
+    {
+        JobSystem jobs(workers);
+        const uint32_t grains[] = { 0, 1, 7, 64, 1000, 5000 };
+        for (uint32_t grain : grains)
+        {
+            const uint32_t begin = 13, end = 2013;
+            std::vector<std::atomic<int>> hits(end);
+            for (std::atomic<int>& hit : hits)
+                hit = 0;
+            std::atomic<bool> blockTooLarge{ false };
+            jobs.ParallelFor(begin, end, grain, [&](uint32_t blockBegin, uint32_t blockEnd) {
+                if (blockEnd - blockBegin > std::max(1u, grain))
+                    blockTooLarge = true;
+                for (uint32_t i = blockBegin; i < blockEnd; ++i)
+                    ++hits[i];
+            });
+            bool exactlyOnce = true;
+            for (uint32_t i = 0; i < end; ++i)
+                exactlyOnce = exactlyOnce && hits[i] == (i >= begin ? 1 : 0);
+            CHECK(exactlyOnce);
+            CHECK(!blockTooLarge);
+        }
+    }
+}
+
+TEST_CASE(ParallelForEmptyRange)
+{
+    JobSystem jobs(2);
+    int calls = 0;
+    jobs.ParallelFor(5, 5, 1, [&](uint32_t, uint32_t) { ++calls; });
+    jobs.ParallelFor(9, 5, 1, [&](uint32_t, uint32_t) { ++calls; });
+    CHECK(calls == 0);
+}
+
+TEST_CASE(NestedParallelForInsideJob)
+{
+    // SceneRenderer 在任务里调用 ParallelFor：工作线程等待时要帮忙执行，不能死锁
+    JobSystem jobs(2);
+    std::atomic<uint64_t> sum{ 0 };
+    std::vector<JobSystem::JobHandle> outer;
+    for (int j = 0; j < 4; ++j)
+    {
+        outer.push_back(jobs.Schedule([&]() {
+            jobs.ParallelFor(0, 1000, 10, [&](uint32_t blockBegin, uint32_t blockEnd) {
+                uint64_t local = 0;
+                for (uint32_t i = blockBegin; i < blockEnd; ++i)
+                    local += i;
+                sum += local;
+            });
+        }));
+    }
+    for (const JobSystem::JobHandle& handle : outer)
+        jobs.Wait(handle);
+    CHECK(sum == 4ull * 999 * 1000 / 2);
+}
+
+TEST_MAIN()
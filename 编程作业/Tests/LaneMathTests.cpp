@@ -0,0 +1,162 @@
+//***************************************************************************************
+// LaneMathTests.cpp
+//
+// LaneMath.h 的 4 路 SSE 运算与标量版本逐位相同：LaneSinCos 与 ScalarSinCos（XMScalarSinCos 的同一算法），
+// LaneCellScale 与 CellScale，旋转矩阵各元素的位置和符号，矩阵乘法的加法顺序。
+// 不依赖 DirectXMath，x86 上总是运行真正的 SSE 路径；ScalarSinCos 与 XMScalarSinCos 的一致性
+// 由 ForestSceneTests（需要 DirectXMath）检查。编译选项改变舍入（例如合并为 FMA）时由这里发现。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "LaneMath.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    bool SameBits(float a, float b)
+    {
+        return memcmp(&a, &b, sizeof(float)) == 0;
+    }
+}
+
+// 缩放仍然落在 [0.35, 0.7) 内并大致均匀（正弦哈希换成多项式后分布不变）
+TEST_CASE(CellScaleStaysInRangeAndSpreads)
+{
+    int buckets[7] = {};
+    const int n = 40;
+    for (int ix = 0; ix < n; ++ix)
+        for (int iy = 0; iy < n; ++iy)
+            for (int iz = 0; iz < n; ++iz)
+            {
+                const float scale = CellScale(ix, iy, iz);
+                CHECK(scale >= 0.35f && scale < 0.7f);
+                ++buckets[std::min(6, static_cast<int>((scale - 0.35f) / 0.05f))];
+            }
+    const int expected = n * n * n / 7;
+    for (int count : buckets)
+        CHECK(count > expected * 8 / 10 && count < expected * 12 / 10);
+}
+
+#if defined(LANE_MATH_SSE)
+TEST_CASE(SinCosLanesMatchScalarBitExactly)
+{
+    // 覆盖折叠边界附近、负数和 CellScale 用到的大参数（n = 200 时约 2.6 万）
+    float values[4];
+    int mismatches = 0, lane = 0;
+    for (int i = -300000; i <= 300000; ++i)
+    {
+        values[lane++] = i * 0.0913f + (i % 7) * 1e-4f;
+        if (lane < 4)
+            continue;
+        lane = 0;
+        alignas(16) float laneSin[4], laneCos[4];
+        __m128 s, c;
+        LaneSinCos(_mm_loadu_ps(values), &s, &c);
+        _mm_store_ps(laneSin, s);
+        _mm_store_ps(laneCos, c);
+        for (int k = 0; k < 4; ++k)
+        {
+            float scalarSin, scalarCos;
+            ScalarSinCos(values[k], &scalarSin, &scalarCos);
+            if (!SameBits(laneSin[k], scalarSin) || !SameBits(laneCos[k], scalarCos))
+                ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+
+    const float edges[4] = { kLanePiDiv2, -kLanePiDiv2, kLanePi, -0.0f };
+    alignas(16) float laneSin[4], laneCos[4];
+    __m128 s, c;
+    LaneSinCos(_mm_loadu_ps(edges), &s, &c);
+    _mm_store_ps(laneSin, s);
+    _mm_store_ps(laneCos, c);
+    for (int k = 0; k < 4; ++k)
+    {
+        float scalarSin, scalarCos;
+        ScalarSinCos(edges[k], &scalarSin, &scalarCos);
+        CHECK(SameBits(laneSin[k], scalarSin) && SameBits(laneCos[k], scalarCos));
+    }
+}
+
+TEST_CASE(CellScaleLanesMatchScalarBitExactly)
+{
+    int mismatches = 0;
+    for (int ix = 0; ix < 200; ix += 3)
+        for (int iy = 0; iy < 200; iy += 1)
+            for (int iz = 0; iz < 200; iz += 4)
+            {
+                alignas(16) float scales[4];
+                _mm_store_ps(scales, LaneCellScale(ix, iy, iz));
+                for (int k = 0; k < 4; ++k)
+                    mismatches += SameBits(scales[k], CellScale(ix, iy, iz + k)) ? 0 : 1;
+            }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE(RotationLanesUseScalarSinCos)
+{
+    const float angles[4] = { 0.3f, -2.5f, 7.0f, 100.0f };
+    LaneMatrix rotateY, rotateX;
+    LaneRotationY(_mm_loadu_ps(angles), rotateY);
+    LaneRotationX(_mm_loadu_ps(angles), rotateX);
+    for (int k = 0; k < 4; ++k)
+    {
+        float s, c;
+        ScalarSinCos(angles[k], &s, &c);
+        alignas(16) float y[4], x[4];
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+            {
+                _mm_store_ps(y, rotateY.m[i][j]);
+                _mm_store_ps(x, rotateX.m[i][j]);
+                // XMMatrixRotationY：r0 = (c, 0, -s, 0)，r2 = (s, 0, c, 0)
+                float expectedY = i == j ? 1.0f : 0.0f;
+                if (i == 0 && j == 0) expectedY = c;
+                if (i == 0 && j == 2) expectedY = s * -1.0f;
+                if (i == 2 && j == 0) expectedY = s;
+                if (i == 2 && j == 2) expectedY = c;
+                // XMMatrixRotationX：r1 = (0, c, s, 0)，r2 = (0, -s, c, 0)
+                float expectedX = i == j ? 1.0f : 0.0f;
+                if (i == 1 && j == 1) expectedX = c;
+                if (i == 1 && j == 2) expectedX = s;
+                if (i == 2 && j == 1) expectedX = s * -1.0f;
+                if (i == 2 && j == 2) expectedX = c;
+                CHECK(SameBits(y[k], expectedY));
+                CHECK(SameBits(x[k], expectedX));
+            }
+    }
+}
+
+// 加法顺序 (x + z) + (y + w)：用会因顺序不同而舍入不同的数检查
+TEST_CASE(MultiplyLanesAddPairsInDirectXMathOrder)
+{
+    float a[16], b[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        a[i] = 1.0f + i * 1e-3f;
+        b[i] = (i % 2 ? 1e7f : 1.0f) * (1.0f + i * 0.37f);
+    }
+    LaneMatrix la, lb, product;
+    LaneBroadcast(a, la);
+    LaneBroadcast(b, lb);
+    LaneMultiply(la, lb, product);
+    int mismatches = 0;
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+        {
+            const float x = a[i * 4 + 0] * b[0 * 4 + j];
+            const float y = a[i * 4 + 1] * b[1 * 4 + j];
+            const float z = a[i * 4 + 2] * b[2 * 4 + j];
+            const float w = a[i * 4 + 3] * b[3 * 4 + j];
+            const float expected = (x + z) + (y + w);
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, product.m[i][j]);
+            for (int k = 0; k < 4; ++k)
+                mismatches += SameBits(lanes[k], expected) ? 0 : 1;
+        }
+    CHECK(mismatches == 0);
+}
+#endif
+
+TEST_MAIN()
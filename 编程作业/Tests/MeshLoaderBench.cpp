@@ -0,0 +1,151 @@
+//***************************************************************************************
+// MeshLoaderBench.cpp
+//
+// 后台加载的延迟：一次请求 N 个大网格，渲染线程每毫秒 PopFinished 一次（模拟逐帧轮询），
+// 报告从请求到第一次和最后一次取到网格的时间，以及每个网格的平均加载耗时。
+// 两种加载函数：启动时处理（生成三角形顺序打乱的经纬球再做顶点缓存优化，
+// 与没有烘焙文件时的 NameVertices 路径相当）和映射 GlyphCooker 烘焙好的 .gmesh 文件。
+// 用法：MeshLoaderBench [-quick]
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestMesh.h"
+#include "MeshLoader.h"
+#include "MeshOptimizer.h"
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace
+{
+    struct MeshSize
+    {
+        uint32_t stacks;
+        uint32_t slices;
+    };
+
+    std::string CookedPath(int meshId)
+    {
+        return "MeshLoaderBench_tmp" + std::to_string(meshId) + ".gmesh";
+    }
+
+    // 启动时处理：生成并优化，结果拷进 MeshData
+    void ProcessMesh(MeshLoader::MeshData& mesh, MeshSize size, uint32_t seed)
+    {
+        std::vector<TestMesh::Position> positions;
+        std::vector<uint16_t> soup;
+        TestMesh::AppendSphere(0.0f, 0.0f, 0.0f, 1.0f, size.stacks, size.slices, positions, soup);
+        TestMesh::ShuffleTriangles(soup, seed);
+        const uint32_t indexCount = static_cast<uint32_t>(soup.size());
+        mesh.indices.resize(indexCount);
+        mesh.vertexCount = static_cast<uint32_t>(positions.size());
+        MeshOptimizer::OptimizeVertexCache(mesh.indices.data(), soup.data(), indexCount, mesh.vertexCount);
+
+        // Float 格式：位置之后的法线和颜色用位置和常量填充
+        mesh.vertices.resize(static_cast<size_t>(mesh.vertexCount) * kFloatVertexStride);
+        float* pOut = reinterpret_cast<float*>(mesh.vertices.data());
+        for (const TestMesh::Position& p : positions)
+        {
+            const float vertex[10] = { p.x, p.y, p.z, p.x, p.y, p.z, 1.0f, 1.0f, 1.0f, 1.0f };
+            memcpy(pOut, vertex, sizeof(vertex));
+            pOut += 10;
+        }
+    }
+
+    // 把处理好的网格写成烘焙文件，供映射方式加载
+    bool CookMesh(int meshId, MeshSize size)
+    {
+        MeshLoader::MeshData mesh;
+        ProcessMesh(mesh, size, static_cast<uint32_t>(meshId) + 1);
+        GlyphMeshDesc desc;
+        desc.pVertices = mesh.vertices.data();
+        desc.vertexCount = mesh.vertexCount;
+        desc.pIndices = mesh.indices.data();
+        desc.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        return GlyphMeshFile::Write(CookedPath(meshId).c_str(), desc);
+    }
+
+    struct Result
+    {
+        double firstMs = 0.0;
+        double lastMs = 0.0;
+        double averageLoadMs = 0.0;
+        uint64_t bytes = 0;
+    };
+
+    template <class Load>
+    Result Run(unsigned workers, int meshCount, Load load)
+    {
+        MeshLoader loader(workers);
+        TestCommon::BenchTimer timer;
+        for (int id = 0; id < meshCount; ++id)
+            loader.Request(id, [id, &load](MeshLoader::MeshData& mesh) { load(id, mesh); });
+
+        Result result;
+        std::vector<MeshLoader::MeshData> finished;
+        while (finished.size() < static_cast<size_t>(meshCount))
+        {
+            if (loader.PopFinished(finished) > 0)
+            {
+                if (result.firstMs == 0.0)
+                    result.firstMs = timer.GetSeconds() * 1000.0;
+                result.lastMs = timer.GetSeconds() * 1000.0;
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        for (const MeshLoader::MeshData& mesh : finished)
+        {
+            result.averageLoadMs += mesh.loadSeconds * 1000.0 / meshCount;
+            result.bytes += mesh.GetVertexBytes() + mesh.GetIndexCount() * sizeof(uint16_t);
+            TestCommon::KeepAlive(mesh.GetIndexData()[mesh.GetIndexCount() - 1]);
+        }
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    const int meshCount = quick ? 4 : 16;
+    const MeshSize size = quick ? MeshSize{ 32, 48 } : MeshSize{ 180, 360 };   // 后者约 6.4 万顶点、13 万三角形
+    const unsigned workerCounts[] = { 1, 2, 4 };
+
+    for (int id = 0; id < meshCount; ++id)
+    {
+        if (!CookMesh(id, size))
+        {
+            fprintf(stderr, "无法写入 %s\n", CookedPath(id).c_str());
+            return 1;
+        }
+    }
+
+    printf("%d 个网格，每个 %u 顶点\n", meshCount, size.stacks > 1 ? (size.stacks - 1) * size.slices + 2 : 0);
+    printf("%-10s %6s | %10s %10s %12s %10s\n", "加载方式", "线程", "首个 ms", "最后 ms", "平均加载 ms", "数据 MB");
+    for (unsigned workers : workerCounts)
+    {
+        Result processed = Run(workers, meshCount, [size](int id, MeshLoader::MeshData& mesh)
+        {
+            ProcessMesh(mesh, size, static_cast<uint32_t>(id) + 1);
+        });
+        Result mapped = Run(workers, meshCount, [](int id, MeshLoader::MeshData& mesh)
+        {
+            std::shared_ptr<GlyphMeshFile> pFile = std::make_shared<GlyphMeshFile>();
+            if (!pFile->Open(CookedPath(id).c_str()))
+                return;
+            mesh.vertexCount = pFile->GetHeader().vertexCount;
+            mesh.format = pFile->GetVertexFormat();
+            mesh.mappedFile = pFile;
+        });
+        printf("%-10s %6u | %10.2f %10.2f %12.3f %10.2f\n", "启动时处理", workers,
+            processed.firstMs, processed.lastMs, processed.averageLoadMs, processed.bytes / 1048576.0);
+        printf("%-10s %6u | %10.2f %10.2f %12.3f %10.2f\n", "映射烘焙文件", workers,
+            mapped.firstMs, mapped.lastMs, mapped.averageLoadMs, mapped.bytes / 1048576.0);
+    }
+
+    for (int id = 0; id < meshCount; ++id)
+        remove(CookedPath(id).c_str());
+    return 0;
+}
@@ -0,0 +1,201 @@
+//***************************************************************************************
+// MeshLoaderTests.cpp
+//
+// MeshLoader：GetPendingCount 从 Request 起计数，加载完成后仍计入，直到被 PopFinished 取走；
+// 加载结果带有网格 id 和耗时。映射文件的 MeshData 不拷贝顶点和索引，
+// 映射在最后一个引用它的 MeshData 销毁时才关闭，加载器先析构也不影响已取走的数据。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "MeshLoader.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <thread>
+
+namespace
+{
+    const char* const kTempMesh = "MeshLoaderTests_tmp.gmesh";
+
+    // 阻塞加载函数直到 Open，用来观察加载中的状态
+    class Gate
+    {
+    public:
+        void Wait()
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Opened.wait(lock, [this]() { return m_Open; });
+        }
+
+        void Open()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Open = true;
+            }
+            m_Opened.notify_all();
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::condition_variable m_Opened;
+        bool m_Open = false;
+    };
+
+    // 轮询直到取满 count 个（模拟渲染线程每帧取一次）
+    void PopUntil(MeshLoader& loader, std::vector<MeshLoader::MeshData>& finished, size_t count)
+    {
+        while (finished.size() < count)
+        {
+            if (loader.PopFinished(finished) == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void FillOwned(MeshLoader::MeshData& mesh, uint32_t vertexCount)
+    {
+        mesh.vertexCount = vertexCount;
+        mesh.vertices.assign(vertexCount * kFloatVertexStride, static_cast<uint8_t>(mesh.meshId));
+        mesh.indices = { 0, 1, 2 };
+    }
+
+    // 写一个三个 Packed 顶点的字形网格文件
+    bool WriteTempMesh(std::vector<PackedVertex>& vertices, std::vector<uint16_t>& indices)
+    {
+        vertices.resize(3);
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            PackedVertex& v = vertices[i];
+            v.pos[0] = static_cast<uint16_t>(i * 1000);
+            v.pos[1] = static_cast<uint16_t>(i * 2000 + 1);
+            v.pos[2] = 65535;
+            v.pos[3] = 0;
+            v.normal[0] = 0;
+            v.normal[1] = 32767;
+            v.color[0] = v.color[1] = v.color[2] = v.color[3] = static_cast<uint8_t>(100 + i);
+        }
+        indices = { 0, 1, 2, 2, 1, 0 };
+        GlyphMeshDesc desc;
+        desc.format = VertexFormat::Packed;
+        desc.pVertices = vertices.data();
+        desc.vertexCount = 3;
+        desc.pIndices = indices.data();
+        desc.indexCount = 6;
+        desc.decode.scale[0] = desc.decode.scale[1] = desc.decode.scale[2] = 1.0f;
+        return GlyphMeshFile::Write(kTempMesh, desc);
+    }
+}
+
+TEST_CASE(PendingCountLastsUntilPopped)
+{
+    MeshLoader loader(2);
+    CHECK(loader.GetPendingCount() == 0);
+
+    Gate gate;
+    for (int id = 0; id < 3; ++id)
+    {
+        loader.Request(id, [&gate](MeshLoader::MeshData& mesh)
+        {
+            gate.Wait();
+            FillOwned(mesh, 4);
+        });
+    }
+    CHECK(loader.GetPendingCount() == 3);
+
+    std::vector<MeshLoader::MeshData> finished;
+    CHECK(loader.PopFinished(finished) == 0);
+    CHECK(loader.GetPendingCount() == 3);
+
+    gate.Open();
+    // 加载完成但还没取走时仍然计入
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(loader.GetPendingCount() == 3);
+    PopUntil(loader, finished, 3);
+    CHECK(finished.size() == 3);
+    CHECK(loader.GetPendingCount() == 0);
+    CHECK(loader.PopFinished(finished) == 0);
+
+    // 每个结果带着自己的网格 id 和数据
+    std::vector<int> ids;
+    for (const MeshLoader::MeshData& mesh : finished)
+    {
+        ids.push_back(mesh.meshId);
+        CHECK(mesh.vertexCount == 4);
+        CHECK(mesh.GetVertexBytes() == 4 * kFloatVertexStride);
+        CHECK(mesh.GetVertexData()[0] == static_cast<uint8_t>(mesh.meshId));
+        CHECK(mesh.GetIndexCount() == 3);
+        CHECK(!mesh.mappedFile);
+        CHECK(mesh.loadSeconds >= 0.0);
+    }
+    std::sort(ids.begin(), ids.end());
+    CHECK(ids == std::vector<int>({ 0, 1, 2 }));
+}
+
+TEST_CASE(PendingCountWithoutPollingDuringLoad)
+{
+    MeshLoader loader(1);
+    Gate gate;
+    loader.Request(7, [&gate](MeshLoader::MeshData& mesh) { gate.Wait(); FillOwned(mesh, 1); });
+    loader.Request(8, [](MeshLoader::MeshData& mesh) { FillOwned(mesh, 1); });
+    CHECK(loader.GetPendingCount() == 2);
+    gate.Open();
+
+    // 只取到一部分时计数只减去取到的个数
+    std::vector<MeshLoader::MeshData> finished;
+    PopUntil(loader, finished, 1);
+    CHECK(loader.GetPendingCount() == 2 - finished.size());
+    PopUntil(loader, finished, 2);
+    CHECK(loader.GetPendingCount() == 0);
+}
+
+TEST_CASE(MappedFileLivesAsLongAsTheMeshData)
+{
+    std::vector<PackedVertex> vertices;
+    std::vector<uint16_t> indices;
+    CHECK(WriteTempMesh(vertices, indices));
+
+    std::weak_ptr<const GlyphMeshFile> watch;
+    std::vector<MeshLoader::MeshData> finished;
+    {
+        MeshLoader loader(1);
+        loader.Request(3, [](MeshLoader::MeshData& mesh)
+        {
+            std::shared_ptr<GlyphMeshFile> pFile = std::make_shared<GlyphMeshFile>();
+            if (!pFile->Open(kTempMesh))
+                return;
+            mesh.vertexCount = pFile->GetHeader().vertexCount;
+            mesh.format = pFile->GetVertexFormat();
+            mesh.decode = pFile->GetHeader().decode;
+            mesh.mappedFile = pFile;
+        });
+        PopUntil(loader, finished, 1);
+        // 加载器在这里析构，加载线程退出
+    }
+    CHECK(finished.size() == 1);
+    MeshLoader::MeshData& mesh = finished[0];
+    CHECK(mesh.mappedFile != nullptr);
+    watch = mesh.mappedFile;
+    CHECK(watch.use_count() == 1);      // 只有 MeshData 持有，加载函数中的引用已经释放
+
+    // 顶点和索引直接指向映射，不拷贝
+    CHECK(mesh.vertices.empty() && mesh.indices.empty());
+    CHECK(mesh.format == VertexFormat::Packed);
+    CHECK(mesh.GetVertexData() == mesh.mappedFile->GetVertices());
+    CHECK(mesh.GetVertexBytes() == vertices.size() * sizeof(PackedVertex));
+    CHECK(memcmp(mesh.GetVertexData(), vertices.data(), mesh.GetVertexBytes()) == 0);
+    CHECK(mesh.GetIndexCount() == indices.size());
+    CHECK(memcmp(mesh.GetIndexData(), indices.data(), indices.size() * sizeof(uint16_t)) == 0);
+
+    // 拷贝出的 MeshData 共享同一个映射，全部销毁后映射才关闭
+    {
+        MeshLoader::MeshData copy = mesh;
+        CHECK(watch.use_count() == 2);
+        finished.clear();
+        CHECK(!watch.expired());
+        CHECK(copy.GetIndexData()[5] == 0);
+    }
+    CHECK(watch.expired());
+    remove(kTempMesh);
+}
+
+TEST_MAIN()
@@ -0,0 +1,168 @@
+//***************************************************************************************
+// MeshOptimizerTests.cpp
+//
+// MeshOptimizer：FIFO 缓存模拟的 ACMR/ATVR 与手算一致；顶点缓存优化和 overdraw 排序
+// 只改变三角形顺序（不增删、不改变三角形内顶点顺序），打乱顺序的球面网格优化后 ACMR 明显下降，
+// 切簇后 ACMR 只略有变差；以及两层同心球排序后外层先画。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestMesh.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    using TestMesh::Position;
+
+    // 三角形按原样（保持朝向）比较的多重集合
+    std::vector<uint64_t> SortedTriangles(const std::vector<uint16_t>& indices)
+    {
+        std::vector<uint64_t> triangles;
+        for (size_t t = 0; t + 2 < indices.size(); t += 3)
+            triangles.push_back((uint64_t(indices[t]) << 32) | (uint64_t(indices[t + 1]) << 16) | indices[t + 2]);
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    struct Mesh
+    {
+        std::vector<Position> positions;
+        std::vector<uint16_t> indices;
+
+        uint32_t VertexCount() const { return static_cast<uint32_t>(positions.size()); }
+        uint32_t IndexCount() const { return static_cast<uint32_t>(indices.size()); }
+    };
+
+    Mesh MakeShuffledSphere()
+    {
+        Mesh mesh;
+        TestMesh::AppendSphere(0.0f, 0.0f, 0.0f, 1.0f, 40, 60, mesh.positions, mesh.indices);
+        TestMesh::ShuffleTriangles(mesh.indices, 99);
+        return mesh;
+    }
+}
+
+// ==== 缓存模拟 ====
+TEST_CASE(AnalyzeCountsMissesByHand)
+{
+    // 两个共享一条边的三角形：4 个顶点各变换一次
+    const uint16_t quad[] = { 0, 1, 2, 2, 1, 3 };
+    VertexCacheStats stats = MeshOptimizer::AnalyzeVertexCache(quad, 6, 4);
+    CHECK(stats.transformedVertices == 4);
+    CHECK_NEAR(stats.acmr, 2.0, 1e-6);
+    CHECK_NEAR(stats.atvr, 1.0, 1e-6);
+
+    // 缓存只有 1 个槽位时，第二个三角形只有 2 命中，1 已被挤出
+    stats = MeshOptimizer::AnalyzeVertexCache(quad, 6, 4, 1);
+    CHECK(stats.transformedVertices == 5);
+
+    // 展开后的网格（NameVertices 原来的做法）：每个索引都是新顶点，ACMR 为 3
+    std::vector<uint16_t> identity(300);
+    for (size_t i = 0; i < identity.size(); ++i)
+        identity[i] = static_cast<uint16_t>(i);
+    stats = MeshOptimizer::AnalyzeVertexCache(identity.data(), 300, 300);
+    CHECK_NEAR(stats.acmr, 3.0, 1e-6);
+    CHECK_NEAR(stats.atvr, 1.0, 1e-6);
+
+    stats = MeshOptimizer::AnalyzeVertexCache(quad, 0, 4);
+    CHECK(stats.transformedVertices == 0);
+}
+
+// ==== 顶点缓存优化 ====
+TEST_CASE(VertexCacheOptimizationOnlyReordersTriangles)
+{
+    Mesh mesh = MakeShuffledSphere();
+    std::vector<uint16_t> optimized(mesh.indices.size());
+    std::vector<uint32_t> clusters;
+    MeshOptimizer::OptimizeVertexCache(optimized.data(), mesh.indices.data(), mesh.IndexCount(), mesh.VertexCount(),
+        MeshOptimizer::kDefaultCacheSize, &clusters);
+    CHECK(SortedTriangles(optimized) == SortedTriangles(mesh.indices));
+
+    CHECK(!clusters.empty() && clusters[0] == 0);
+    bool increasing = true;
+    for (size_t k = 1; k < clusters.size(); ++k)
+        increasing = increasing && clusters[k] > clusters[k - 1];
+    CHECK(increasing);
+    CHECK(clusters.back() < mesh.IndexCount() / 3);
+
+    // 原地优化与写到另一块缓冲的结果相同
+    std::vector<uint16_t> inPlace = mesh.indices;
+    MeshOptimizer::OptimizeVertexCache(inPlace.data(), inPlace.data(), mesh.IndexCount(), mesh.VertexCount());
+    CHECK(inPlace == optimized);
+}
+
+TEST_CASE(VertexCacheOptimizationLowersAcmr)
+{
+    Mesh mesh = MakeShuffledSphere();
+    VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(mesh.indices.data(), mesh.IndexCount(), mesh.VertexCount());
+    std::vector<uint16_t> optimized(mesh.indices.size());
+    MeshOptimizer::OptimizeVertexCache(optimized.data(), mesh.indices.data(), mesh.IndexCount(), mesh.VertexCount());
+    VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(optimized.data(), mesh.IndexCount(), mesh.VertexCount());
+    // 打乱后接近每三角形 3 次变换；规则网格优化后应接近 Tipsify 论文中的 0.6~0.8
+    CHECK(before.acmr > 2.5f);
+    CHECK(after.acmr < 0.9f);
+    CHECK(after.atvr < 1.5f);
+    CHECK(after.atvr >= 1.0f);
+}
+
+TEST_CASE(LargerCacheDoesNotHurt)
+{
+    Mesh mesh = MakeShuffledSphere();
+    std::vector<uint16_t> small(mesh.indices.size()), large(mesh.indices.size());
+    MeshOptimizer::OptimizeVertexCache(small.data(), mesh.indices.data(), mesh.IndexCount(), mesh.VertexCount(), 8);
+    MeshOptimizer::OptimizeVertexCache(large.data(), mesh.indices.data(), mesh.IndexCount(), mesh.VertexCount(), 32);
+    VertexCacheStats smallStats = MeshOptimizer::AnalyzeVertexCache(small.data(), mesh.IndexCount(), mesh.VertexCount(), 8);
+    VertexCacheStats largeStats = MeshOptimizer::AnalyzeVertexCache(large.data(), mesh.IndexCount(), mesh.VertexCount(), 32);
+    CHECK(largeStats.acmr <= smallStats.acmr);
+}
+
+// ==== overdraw 排序 ====
+TEST_CASE(OverdrawOrderKeepsTrianglesAndCacheLocality)
+{
+    Mesh mesh = MakeShuffledSphere();
+    std::vector<uint16_t> cacheOnly(mesh.indices.size()), overdraw(mesh.indices.size());
+    MeshOptimizer::OptimizeVertexCache(cacheOnly.data(), mesh.indices.data(), mesh.IndexCount(), mesh.VertexCount());
+    MeshOptimizer::OptimizeOverdraw(overdraw.data(), mesh.indices.data(), mesh.IndexCount(),
+        mesh.positions.data(), mesh.VertexCount(), sizeof(Position));
+    CHECK(SortedTriangles(overdraw) == SortedTriangles(mesh.indices));
+
+    VertexCacheStats cacheStats = MeshOptimizer::AnalyzeVertexCache(cacheOnly.data(), mesh.IndexCount(), mesh.VertexCount());
+    VertexCacheStats overdrawStats = MeshOptimizer::AnalyzeVertexCache(overdraw.data(), mesh.IndexCount(), mesh.VertexCount());
+    // 切簇会打断簇之间的缓存复用，但每段从冷缓存开始的 ACMR 都限制在 threshold 倍以内
+    CHECK(overdrawStats.acmr <= cacheStats.acmr * 1.25f);
+}
+
+TEST_CASE(OuterShellIsDrawnFirst)
+{
+    // 两层同心球，内层的三角形在前：排序后外层（越朝外）应该先画
+    Mesh mesh;
+    TestMesh::AppendSphere(0.0f, 0.0f, 0.0f, 1.0f, 20, 30, mesh.positions, mesh.indices);
+    const uint32_t innerVertices = mesh.VertexCount();
+    TestMesh::AppendSphere(0.0f, 0.0f, 0.0f, 3.0f, 20, 30, mesh.positions, mesh.indices);
+
+    std::vector<uint16_t> sorted(mesh.indices.size());
+    MeshOptimizer::OptimizeOverdraw(sorted.data(), mesh.indices.data(), mesh.IndexCount(),
+        mesh.positions.data(), mesh.VertexCount(), sizeof(Position));
+    CHECK(SortedTriangles(sorted) == SortedTriangles(mesh.indices));
+
+    const size_t half = sorted.size() / 2;
+    uint32_t outerInFirstHalf = 0;
+    for (size_t i = 0; i < half; i += 3)
+        outerInFirstHalf += sorted[i] >= innerVertices ? 1 : 0;
+    CHECK(outerInFirstHalf == half / 3);
+}
+
+TEST_CASE(EmptyMesh)
+{
+    std::vector<uint32_t> clusters(3, 7);
+    uint16_t dummy = 0;
+    MeshOptimizer::OptimizeVertexCache(&dummy, &dummy, 0, 0, MeshOptimizer::kDefaultCacheSize, &clusters);
+    CHECK(clusters.empty());
+    Position p = { 0.0f, 0.0f, 0.0f };
+    MeshOptimizer::OptimizeOverdraw(&dummy, &dummy, 0, &p, 1, sizeof(Position));
+    CHECK(dummy == 0);
+}
+
+TEST_MAIN()
@@ -0,0 +1,239 @@
+//***************************************************************************************
+// MeshWelderTests.cpp
+//
+// WeldVertices：与 NameVertices 原来的展开方式（每个索引一份顶点拷贝）对比，
+// 焊接后逐个三角形还原出的顶点与展开结果在量化精度内相同，三角形个数和顺序不变；
+// 以及立方体的顶点数、浮点误差内的合并、属性不同时不合并、未引用顶点的丢弃和统计。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "MeshWelder.h"
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    // 与 FloatVertex 相同的布局：位置、法线、颜色
+    struct Vertex
+    {
+        float pos[3];
+        float normal[3];
+        float color[4];
+    };
+
+    const float kPositionQuantum = 1e-5f;
+    const WeldAttribute kAttributes[] = {
+        { offsetof(Vertex, pos),    3, kPositionQuantum },
+        { offsetof(Vertex, normal), 3, 1e-4f },
+        { offsetof(Vertex, color),  4, 1.0f / 512.0f }
+    };
+    const uint32_t kAttributeCount = sizeof(kAttributes) / sizeof(kAttributes[0]);
+
+    Vertex MakeVertex(float x, float y, float z, float nx, float ny, float nz)
+    {
+        return Vertex{ { x, y, z }, { nx, ny, nz }, { 1.0f, 0.5f, 0.25f, 1.0f } };
+    }
+
+    // 单位立方体按面展开（与 NameVertices 相同：每个三角形三个独立顶点，法线为面法线）
+    std::vector<Vertex> ExpandCube()
+    {
+        static const float kNormals[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+        std::vector<Vertex> vertices;
+        for (int face = 0; face < 6; ++face)
+        {
+            const float* n = kNormals[face];
+            int axis = n[0] != 0 ? 0 : (n[1] != 0 ? 1 : 2);
+            int u = (axis + 1) % 3;
+            int v = (axis + 2) % 3;
+            float corners[4][3];
+            for (int c = 0; c < 4; ++c)
+            {
+                corners[c][axis] = n[axis] > 0 ? 1.0f : 0.0f;
+                corners[c][u] = (c == 1 || c == 2) ? 1.0f : 0.0f;
+                corners[c][v] = (c >= 2) ? 1.0f : 0.0f;
+            }
+            static const int kQuad[6] = { 0, 1, 2, 0, 2, 3 };
+            for (int i : kQuad)
+                vertices.push_back(MakeVertex(corners[i][0], corners[i][1], corners[i][2], n[0], n[1], n[2]));
+        }
+        return vertices;
+    }
+
+    const Vertex& WeldedVertex(const std::vector<uint8_t>& welded, uint16_t index)
+    {
+        return *reinterpret_cast<const Vertex*>(welded.data() + static_cast<size_t>(index) * sizeof(Vertex));
+    }
+
+    // 每个分量相差不超过半个量化步长（加上浮点舍入）
+    bool SameWithinQuantum(const Vertex& a, const Vertex& b)
+    {
+        for (uint32_t attr = 0; attr < kAttributeCount; ++attr)
+        {
+            const float* pa = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(&a) + kAttributes[attr].byteOffset);
+            const float* pb = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(&b) + kAttributes[attr].byteOffset);
+            for (uint32_t c = 0; c < kAttributes[attr].floatCount; ++c)
+            {
+                if (std::fabs(pa[c] - pb[c]) > kAttributes[attr].quantum * 1.001f)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // 焊接结果按三角形还原后与展开结果逐个对比
+    bool TrianglesMatchExpansion(const std::vector<Vertex>& expanded, const std::vector<uint8_t>& welded,
+        const std::vector<uint16_t>& indices)
+    {
+        if (indices.size() != expanded.size())
+            return false;
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            if (static_cast<size_t>(indices[i]) * sizeof(Vertex) >= welded.size())
+                return false;
+            if (!SameWithinQuantum(WeldedVertex(welded, indices[i]), expanded[i]))
+                return false;
+        }
+        return true;
+    }
+
+    WeldStats Weld(const std::vector<Vertex>& vertices, const std::vector<uint16_t>* pIndices,
+        std::vector<uint8_t>& welded, std::vector<uint16_t>& indices)
+    {
+        return WeldVertices(vertices.data(), static_cast<uint32_t>(vertices.size()), sizeof(Vertex),
+            kAttributes, kAttributeCount, pIndices ? pIndices->data() : nullptr,
+            pIndices ? static_cast<uint32_t>(pIndices->size()) : 0, welded, indices);
+    }
+}
+
+// ==== 与展开结果对比 ====
+TEST_CASE(CubeWeldsToFourVerticesPerFace)
+{
+    std::vector<Vertex> expanded = ExpandCube();
+    std::vector<uint8_t> welded;
+    std::vector<uint16_t> indices;
+    WeldStats stats = Weld(expanded, nullptr, welded, indices);
+    CHECK(stats.inputVertices == 36);
+    CHECK(stats.outputVertices == 24);      // 面法线不同，角上的顶点按面分开
+    CHECK(stats.inputBytes == 36 * sizeof(Vertex));
+    CHECK(stats.outputBytes == 24 * sizeof(Vertex));
+    CHECK_NEAR(stats.VertexRatio(), 24.0 / 36.0, 1e-12);
+    CHECK(TrianglesMatchExpansion(expanded, welded, indices));
+}
+
+TEST_CASE(PositionOnlyWeldMergesCorners)
+{
+    std::vector<Vertex> expanded = ExpandCube();
+    std::vector<uint8_t> welded;
+    std::vector<uint16_t> indices;
+    WeldStats stats = WeldVertices(expanded.data(), static_cast<uint32_t>(expanded.size()), sizeof(Vertex),
+        kAttributes, 1, nullptr, 0, welded, indices);
+    CHECK(stats.outputVertices == 8);
+    CHECK(indices.size() == 36);
+}
+
+TEST_CASE(NoisyIndexedMeshMatchesExpansion)
+{
+    // 随机的索引网格按 NameVertices 的方式展开，每份拷贝加上远小于量化步长的噪声
+    const uint32_t kVertexCount = 500;
+    const uint32_t kTriangleCount = 3000;
+    uint32_t seed = 2024;
+    auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    std::vector<Vertex> unique(kVertexCount);
+    for (Vertex& v : unique)
+    {
+        for (float& p : v.pos)
+            p = (next() % 100000) * 0.001f;
+        for (int c = 0; c < 3; ++c)
+            v.normal[c] = c == static_cast<int>(next() % 3) ? 1.0f : 0.0f;
+        for (float& c : v.color)
+            c = (next() % 256) / 255.0f;
+    }
+    std::vector<Vertex> expanded;
+    for (uint32_t t = 0; t < kTriangleCount * 3; ++t)
+    {
+        Vertex v = unique[next() % kVertexCount];
+        v.pos[0] += ((next() % 3) - 1.0f) * kPositionQuantum * 0.05f;
+        expanded.push_back(v);
+    }
+
+    std::vector<uint8_t> welded;
+    std::vector<uint16_t> indices;
+    WeldStats stats = Weld(expanded, nullptr, welded, indices);
+    CHECK(TrianglesMatchExpansion(expanded, welded, indices));
+    CHECK(stats.outputVertices <= kVertexCount);
+    CHECK(stats.outputVertices < stats.inputVertices / 10);
+
+    // 焊接后的顶点两两不同：再焊一次不会减少
+    std::vector<uint8_t> rewelded;
+    std::vector<uint16_t> reindices;
+    WeldStats again = WeldVertices(welded.data(), stats.outputVertices, sizeof(Vertex), kAttributes, kAttributeCount,
+        indices.data(), static_cast<uint32_t>(indices.size()), rewelded, reindices);
+    CHECK(again.outputVertices == stats.outputVertices);
+    CHECK(reindices == indices);
+}
+
+// ==== 合并规则 ====
+TEST_CASE(DifferentAttributesAreKeptApart)
+{
+    std::vector<Vertex> vertices;
+    vertices.push_back(MakeVertex(0, 0, 0, 0, 0, 1));
+    vertices.push_back(MakeVertex(0, 0, 0, 0, 0, 1));
+    vertices.push_back(MakeVertex(kPositionQuantum * 3, 0, 0, 0, 0, 1));    // 位置超过量化步长
+    Vertex colored = MakeVertex(0, 0, 0, 0, 0, 1);
+    colored.color[3] = 0.5f;
+    vertices.push_back(colored);                                            // 颜色不同
+    vertices.push_back(MakeVertex(0, 0, 0, 0, 1, 0));                       // 法线不同
+    vertices.push_back(MakeVertex(0, 0, 0, 0, 0, 1));
+
+    std::vector<uint8_t> welded;
+    std::vector<uint16_t> indices;
+    WeldStats stats = Weld(vertices, nullptr, welded, indices);
+    CHECK(stats.outputVertices == 4);
+    const uint16_t expected[] = { 0, 0, 1, 2, 3, 0 };
+    CHECK(indices.size() == 6 && memcmp(indices.data(), expected, sizeof(expected)) == 0);
+}
+
+TEST_CASE(KeepsFirstOccurrenceData)
+{
+    std::vector<Vertex> vertices;
+    vertices.push_back(MakeVertex(1.0f, 2.0f, 3.0f, 0, 0, 1));
+    vertices.push_back(MakeVertex(1.0f + kPositionQuantum * 0.2f, 2.0f, 3.0f, 0, 0, 1));
+    vertices.push_back(MakeVertex(1.0f, 2.0f, 3.0f, 0, 0, 1));
+    std::vector<uint8_t> welded;
+    std::vector<uint16_t> indices;
+    Weld(vertices, nullptr, welded, indices);
+    CHECK(welded.size() == sizeof(Vertex));
+    CHECK(memcmp(welded.data(), &vertices[0], sizeof(Vertex)) == 0);
+}
+
+TEST_CASE(UnreferencedVerticesAreDropped)
+{
+    std::vector<Vertex> vertices;
+    for (int i = 0; i < 6; ++i)
+        vertices.push_back(MakeVertex(static_cast<float>(i), 0, 0, 0, 0, 1));
+    const std::vector<uint16_t> source = { 5, 3, 1, 1, 3, 5 };
+    std::vector<uint8_t> welded;
+    std::vector<uint16_t> indices;
+    WeldStats stats = Weld(vertices, &source, welded, indices);
+    CHECK(stats.inputVertices == 6);
+    CHECK(stats.outputVertices == 3);
+    const std::vector<uint16_t> expected = { 0, 1, 2, 2, 1, 0 };
+    CHECK(indices == expected);
+    // 输出顶点按第一次被引用的顺序排列
+    CHECK(WeldedVertex(welded, 0).pos[0] == 5.0f);
+    CHECK(WeldedVertex(welded, 2).pos[0] == 1.0f);
+}
+
+TEST_CASE(EmptyInput)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint8_t> welded(4);
+    std::vector<uint16_t> indices(4);
+    WeldStats stats = Weld(vertices, nullptr, welded, indices);
+    CHECK(stats.outputVertices == 0);
+    CHECK(welded.empty());
+    CHECK(indices.empty());
+}
+
+TEST_MAIN()
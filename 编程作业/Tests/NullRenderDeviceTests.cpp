@@ -0,0 +1,95 @@
+//***************************************************************************************
+// NullRenderDeviceTests.cpp
+//
+// NullRenderDevice：计数、fence，以及窗口大小变化时的渲染目标释放顺序
+// （与 GameApp::OnResize 相同：ReleaseRenderTargets → ResizeBuffers → SetRenderTargets）。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "NullRenderDevice.h"
+#include "CaptureRenderDevice.h"
+
+namespace
+{
+    const float kBlack[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    // GameApp::OnResize 的顺序
+    bool Resize(RenderDevice& device, NullRenderDevice& swapChain, uint32_t width, uint32_t height)
+    {
+        device.ReleaseRenderTargets();
+        bool resized = swapChain.ResizeBuffers(width, height);
+        swapChain.SetRenderTargets();
+        return resized;
+    }
+}
+
+TEST_CASE(ResizeFailsWhileRenderTargetsAreHeld)
+{
+    NullRenderDevice device;
+    CHECK(device.HasRenderTargets());
+    CHECK(!device.ResizeBuffers(800, 600));
+    CHECK(device.GetResizeFailures() == 1);
+    CHECK(device.GetWidth() == 1);
+}
+
+TEST_CASE(ReleaseThenResizeThenRebind)
+{
+    NullRenderDevice device;
+    for (uint32_t i = 1; i <= 3; ++i)
+    {
+        CHECK(Resize(device, device, 640 * i, 480 * i));
+        device.Clear(kBlack);
+        device.Present();
+    }
+    CHECK(device.GetResizeFailures() == 0);
+    CHECK(device.GetWidth() == 1920 && device.GetHeight() == 1440);
+    CHECK(device.GetClearsWithoutTargets() == 0);
+    CHECK(device.GetStats().presents == 3);
+}
+
+TEST_CASE(ClearWithoutRenderTargetsIsCounted)
+{
+    NullRenderDevice device;
+    device.ReleaseRenderTargets();
+    CHECK(device.ResizeBuffers(320, 240));
+    // 忘记重新设置渲染目标
+    device.Clear(kBlack);
+    CHECK(device.GetClearsWithoutTargets() == 1);
+}
+
+TEST_CASE(CaptureDeviceForwardsRelease)
+{
+    NullRenderDevice inner;
+    CaptureRenderDevice capture(&inner);
+    CHECK(Resize(capture, inner, 1024, 768));
+    CHECK(inner.GetResizeFailures() == 0);
+    CHECK(inner.HasRenderTargets());
+}
+
+TEST_CASE(FencesCompleteImmediately)
+{
+    NullRenderDevice device;
+    CHECK(device.GetCompletedFence() == 0);
+    device.InsertFence(1);
+    device.InsertFence(2);
+    CHECK(device.GetCompletedFence() == 2);
+}
+
+TEST_CASE(CommandContextStatsMergeOnExecute)
+{
+    NullRenderDevice device;
+    device.SetMaxCommandContexts(2);
+    CommandContext* pFirst = device.BeginCommandContext(0);
+    CommandContext* pSecond = device.BeginCommandContext(1);
+    pFirst->DrawIndexedInstanced(3, 2, 0, 0, 0);
+    pSecond->DrawIndexedInstanced(6, 1, 0, 0, 0);
+    device.EndCommandContext(0);
+    device.EndCommandContext(1);
+    CHECK(device.GetStats().drawCalls == 0);
+    device.ExecuteCommandContexts(2);
+    CHECK(device.GetStats().drawCalls == 2);
+    CHECK(device.GetStats().instancesDrawn == 3);
+    CHECK(device.GetStats().indicesDrawn == 12);
+}
+
+TEST_MAIN()
@@ -0,0 +1,93 @@
+//***************************************************************************************
+// ObjImporterBench.cpp
+//
+// ObjImporter 的吞吐量（MB/s）：生成一个带 vn 的网格 OBJ，分别在调用线程上解析和
+// 交给 JobSystem 并行解析，输出解析、建网格两部分的耗时。-quick 时只生成约 1 MB。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "ObjImporter.h"
+#include "JobSystem.h"
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    const char* const kBenchObj = "ObjImporterBench_tmp.obj";
+
+    // n×n 个四边形，顶点坐标带 6 位小数，与建模软件导出的文件相近
+    uint64_t WriteGridObj(const char* path, int n)
+    {
+        FILE* pFile = fopen(path, "wb");
+        if (!pFile)
+            return 0;
+        for (int y = 0; y <= n; ++y)
+        {
+            for (int x = 0; x <= n; ++x)
+                fprintf(pFile, "v %.6f %.6f %.6f\n", x * 0.013, y * 0.017, 0.001 * ((x * 7 + y * 13) % 101));
+        }
+        fprintf(pFile, "vn 0 0 1\nvn 0.1 0.2 1\n");
+        for (int y = 0; y < n; ++y)
+        {
+            for (int x = 0; x < n; ++x)
+            {
+                const int a = y * (n + 1) + x + 1;
+                fprintf(pFile, "f %d//1 %d//2 %d//1 %d//2\n", a, a + 1, a + n + 2, a + n + 1);
+            }
+        }
+        const uint64_t bytes = static_cast<uint64_t>(ftell(pFile));
+        fclose(pFile);
+        return bytes;
+    }
+
+    void Run(const char* label, JobSystem* pJobs, uint64_t bytes, int repeats)
+    {
+        ObjImporter importer(pJobs);
+        ObjMesh mesh;
+        double best = 1e30, parse = 0.0, build = 0.0;
+        for (int r = 0; r < repeats; ++r)
+        {
+            TestCommon::BenchTimer timer;
+            if (!importer.Import(kBenchObj, mesh))
+            {
+                printf("%-20s 导入失败：%s\n", label, importer.GetError().c_str());
+                return;
+            }
+            const double seconds = timer.GetSeconds();
+            if (seconds < best)
+            {
+                best = seconds;
+                parse = importer.GetStats().parseSeconds;
+                build = importer.GetStats().buildSeconds;
+            }
+            TestCommon::KeepAlive(mesh);
+        }
+        const double mb = bytes / (1024.0 * 1024.0);
+        printf("%-20s %8.1f MB/s  总计 %8.2f ms（解析 %8.2f ms，建网格 %8.2f ms）\n",
+            label, mb / best, best * 1000.0, parse * 1000.0, build * 1000.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    const int n = quick ? 120 : 1200;
+    const int repeats = quick ? 2 : 5;
+
+    const uint64_t bytes = WriteGridObj(kBenchObj, n);
+    if (bytes == 0)
+    {
+        printf("无法写入 %s\n", kBenchObj);
+        return 1;
+    }
+    printf("OBJ %.1f MB，%d 个四边形\n", bytes / (1024.0 * 1024.0), n * n);
+
+    Run("调用线程", nullptr, bytes, repeats);
+    JobSystem jobs;
+    char label[64];
+    snprintf(label, sizeof(label), "JobSystem（%u 个工作线程）", jobs.GetWorkerCount());
+    Run(label, &jobs, bytes, repeats);
+
+    remove(kBenchObj);
+    return 0;
+}
@@ -0,0 +1,368 @@
+//***************************************************************************************
+// ObjImporterTests.cpp
+//
+// ObjImporter 与 node/转化.py 的一致性：
+//   - 由 node/*_output.txt 中的顶点位置和三角形还原出 OBJ（转化.py 处理这些 OBJ 会逐字节地
+//     重新生成同样的文件），导入后按脚本的格式输出，必须与原文件逐字节相同；
+//   - 小例子逐项检查扇形三角化、vn 的各种写法、几何法线的回退、负编号、换行和注释；
+//   - 出错时返回 false 并给出原因；按小块读取并行解析的结果与整块串行解析相同。
+// 测试在当前目录写临时 OBJ 文件，结束时删除。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "ObjImporter.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifndef GLYPH_NODE_DIR
+#define GLYPH_NODE_DIR "../../node"
+#endif
+
+namespace
+{
+    const char* const kTempObj = "ObjImporterTests_tmp.obj";
+
+    bool ReadText(const std::string& path, std::string& text)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        std::ostringstream stream;
+        stream << file.rdbuf();
+        text = stream.str();
+        return true;
+    }
+
+    void WriteText(const char* path, const std::string& text)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+    }
+
+    bool ImportText(const std::string& text, ObjMesh& mesh, JobSystem* pJobs = nullptr,
+        size_t chunkBytes = ObjImporter::kDefaultChunkBytes, std::string* pError = nullptr)
+    {
+        WriteText(kTempObj, text);
+        ObjImporter importer(pJobs, chunkBytes);
+        const bool ok = importer.Import(kTempObj, mesh);
+        if (pError)
+            *pError = importer.GetError();
+        remove(kTempObj);
+        return ok;
+    }
+
+    // 转化.py 的 fmt：%.6f 后去掉末尾的 0 和小数点，绝对值小于 1e-6 时为 0.000000
+    std::string Fmt(double x)
+    {
+        if (!(std::fabs(x) >= 1e-6))
+            return "0.000000";
+        char text[64];
+        snprintf(text, sizeof(text), "%.6f", x);
+        std::string s(text);
+        while (!s.empty() && s.back() == '0')
+            s.pop_back();
+        if (!s.empty() && s.back() == '.')
+            s.pop_back();
+        return s;
+    }
+
+    // 按 转化.py 的格式输出整个文件
+    std::string FormatLikeScript(const ObjMesh& mesh, const std::string& objName)
+    {
+        std::string out;
+        out += "// ===== Generated C++ model data (with per-vertex normals embedded) =====\n";
+        out += "// Source OBJ: " + objName + "\n\n";
+        out += "static const GameApp::VertexPosColor tempVertices[] = {\n";
+        for (const ObjVertex& v : mesh.vertices)
+        {
+            out += "    { XMFLOAT3(" + Fmt(v.pos[0]) + ", " + Fmt(v.pos[1]) + ", " + Fmt(v.pos[2]) + "), XMFLOAT3(" +
+                Fmt(v.normal[0]) + ", " + Fmt(v.normal[1]) + ", " + Fmt(v.normal[2]) + "), XMFLOAT4(" +
+                Fmt(v.color[0]) + ", " + Fmt(v.color[1]) + ", " + Fmt(v.color[2]) + ", " + Fmt(v.color[3]) + ") },\n";
+        }
+        out += "};\n\n";
+        out += "static const WORD tempIndices[] = {\n";
+        const size_t kPerLine = 12;
+        for (size_t i = 0; i < mesh.indices.size(); i += kPerLine)
+        {
+            out += "    ";
+            for (size_t j = i; j < std::min(i + kPerLine, mesh.indices.size()); ++j)
+                out += (j > i ? ", " : "") + std::to_string(mesh.indices[j]);
+            out += i + kPerLine < mesh.indices.size() ? ",\n" : "\n";
+        }
+        out += "};\n\n";
+        out += "// meta\n";
+        out += "// verticesCount = " + std::to_string(mesh.vertices.size()) + "\n";
+        out += "// indexCount = " + std::to_string(mesh.indices.size()) + "\n";
+        out += "// NOTE: tempVertices 已包含法线 (pos, normal, color)。若渲染法线方向不对，可在渲染端反向法线或调整三角顺序。\n";
+        return out;
+    }
+
+    bool IsDigitChar(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // 由脚本输出还原 OBJ：位置按原文本写出，三角形 (i0, i1, i2) 写成 f i2 i1 i0（脚本输出时倒序）
+    bool ObjFromScriptOutput(const std::string& text, std::string& obj)
+    {
+        std::istringstream stream(text);
+        std::string line;
+        bool inIndices = false;
+        std::vector<uint32_t> indices;
+        while (std::getline(stream, line))
+        {
+            const std::string vertexPrefix = "    { XMFLOAT3(";
+            if (line.compare(0, vertexPrefix.size(), vertexPrefix) == 0)
+            {
+                const size_t end = line.find(')');
+                std::string pos = line.substr(vertexPrefix.size(), end - vertexPrefix.size());
+                std::string coords;
+                for (char c : pos)
+                {
+                    if (c != ',')
+                        coords += c;
+                }
+                obj += "v " + coords + "\n";
+            }
+            else if (line.find("tempIndices[] = {") != std::string::npos)
+            {
+                inIndices = true;
+            }
+            else if (inIndices && line == "};")
+            {
+                inIndices = false;
+            }
+            else if (inIndices)
+            {
+                for (size_t p = 0; p < line.size();)
+                {
+                    if (IsDigitChar(line[p]))
+                    {
+                        size_t q = p;
+                        while (q < line.size() && IsDigitChar(line[q]))
+                            ++q;
+                        indices.push_back(static_cast<uint32_t>(std::stoul(line.substr(p, q - p))));
+                        p = q;
+                    }
+                    else
+                    {
+                        ++p;
+                    }
+                }
+            }
+        }
+        if (indices.empty() || indices.size() % 3 != 0)
+            return false;
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            obj += "f " + std::to_string(indices[t + 2] + 1) + " " + std::to_string(indices[t + 1] + 1) + " " +
+                std::to_string(indices[t] + 1) + "\n";
+        }
+        return true;
+    }
+
+    bool SameMesh(const ObjMesh& a, const ObjMesh& b)
+    {
+        if (a.vertices.size() != b.vertices.size() || a.indices != b.indices)
+            return false;
+        return a.vertices.empty() || memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(ObjVertex)) == 0;
+    }
+
+    void CheckNormal(const ObjVertex& v, double x, double y, double z)
+    {
+        CHECK_NEAR(v.normal[0], x, 1e-12);
+        CHECK_NEAR(v.normal[1], y, 1e-12);
+        CHECK_NEAR(v.normal[2], z, 1e-12);
+    }
+}
+
+// ==== 与 转化.py 的输出逐字节对照 ====
+TEST_CASE(MatchesScriptOutputs)
+{
+    const char* const names[] = { "xu", "wang", "qin", "sh" };
+    JobSystem jobs(3);
+    for (const char* name : names)
+    {
+        std::string expected;
+        const bool found = ReadText(std::string(GLYPH_NODE_DIR) + "/" + name + "_output.txt", expected);
+        CHECK(found);
+        if (!found)
+            continue;
+        std::string obj;
+        CHECK(ObjFromScriptOutput(expected, obj));
+
+        // 串行整块读取，与并行按小块读取都要一致
+        ObjMesh serial, parallel;
+        CHECK(ImportText(obj, serial));
+        CHECK(ImportText(obj, parallel, &jobs, 4096));
+        const std::string objName = std::string(name) + ".obj";
+        const bool serialMatches = FormatLikeScript(serial, objName) == expected;
+        const bool parallelMatches = FormatLikeScript(parallel, objName) == expected;
+        CHECK(serialMatches);
+        CHECK(parallelMatches);
+        if (!serialMatches || !parallelMatches)
+            fprintf(stderr, "  %s_output.txt 不一致\n", name);
+    }
+}
+
+// ==== 语义 ====
+TEST_CASE(FanTriangulationAndWinding)
+{
+    // 四边形和五边形按扇形三角化，每个三角形按 (v2, v1, v0) 输出
+    ObjMesh mesh;
+    CHECK(ImportText(
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\nv 3 1 0\nv 2 2 0\n"
+        "f 1 2 3 4\n"
+        "f 2 5 6 7 3\n", mesh));
+    const std::vector<uint32_t> expected = { 2, 1, 0, 3, 2, 0, 5, 4, 1, 6, 5, 1, 2, 6, 1 };
+    CHECK(mesh.indices == expected);
+    CHECK(mesh.vertices.size() == 7);
+    // 平面网格朝 +z，几何法线累加后仍是 +z
+    for (const ObjVertex& v : mesh.vertices)
+        CheckNormal(v, 0.0, 0.0, 1.0);
+    CHECK(mesh.vertices[0].color[3] == 1.0f);
+}
+
+TEST_CASE(CornerFormsAndExplicitNormals)
+{
+    // v、v/vt、v//vn、v/vt/vn 四种写法；vn 先归一化
+    ObjMesh mesh;
+    CHECK(ImportText(
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\n"
+        "vt 0 0\nvt 1 0\n"
+        "vn 0 0 2\nvn 3 0 0\n"
+        "f 1//1 2//1 3//1\n"
+        "f 1/1/2 3/2/2 4/1/2\n"
+        "f 2/1 3/2 4/1\n", mesh));
+    CHECK(mesh.indices.size() == 9);
+    // 顶点 1：(0,0,1) + (1,0,0)，归一化
+    const double s = 1.0 / std::sqrt(2.0);
+    CheckNormal(mesh.vertices[0], s, 0.0, s);
+    // 顶点 2：(0,0,1) + 第三个面（三个顶点都没有 vn）的几何法线 (1,1,1)/√3
+    const double r = 1.0 / std::sqrt(3.0);
+    const double length2 = std::sqrt(r * r + r * r + (1.0 + r) * (1.0 + r));
+    CheckNormal(mesh.vertices[1], r / length2, r / length2, (1.0 + r) / length2);
+    // 顶点 4：(1,0,0) + 同一个几何法线
+    const double nx = 1.0 + r, ny = r, nz = r;
+    const double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+    CheckNormal(mesh.vertices[3], nx / length, ny / length, nz / length);
+}
+
+TEST_CASE(MissingNormalFallsBackToGeometric)
+{
+    // 三角形中只有部分顶点写了 vn：有的累加 vn，没有的累加几何法线；越界的 vn 也按几何法线
+    ObjMesh mesh;
+    CHECK(ImportText(
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "vn 1 0 0\n"
+        "f 1//1 2 3//9\n", mesh));
+    CheckNormal(mesh.vertices[0], 1.0, 0.0, 0.0);
+    CheckNormal(mesh.vertices[1], 0.0, 0.0, 1.0);
+    CheckNormal(mesh.vertices[2], 0.0, 0.0, 1.0);
+}
+
+TEST_CASE(DegenerateNormalIsZUp)
+{
+    // 退化三角形的几何法线长度为 0，结果取 (0, 0, 1)；没有被面引用的顶点也一样
+    ObjMesh mesh;
+    CHECK(ImportText("v 0 0 0\nv 1 1 1\nv 2 2 2\nv 5 5 5\nf 1 2 3\n", mesh));
+    for (const ObjVertex& v : mesh.vertices)
+        CheckNormal(v, 0.0, 0.0, 1.0);
+}
+
+TEST_CASE(NegativeIndicesAreRelative)
+{
+    ObjMesh relative, absolute;
+    CHECK(ImportText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf -3 -2 -1\nv 1 1 0\nf -3 -1 -2\n", relative));
+    CHECK(ImportText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\nv 1 1 0\nf 2 4 3\n", absolute));
+    CHECK(SameMesh(relative, absolute));
+}
+
+TEST_CASE(LineEndingsCommentsAndSkippedLines)
+{
+    // CRLF、单独的 \r、注释、空行、vt / o / s 等行、少于三个分量的 v、少于三个顶点的面
+    ObjMesh messy, clean;
+    CHECK(ImportText(
+        "# comment\r\n\r\n  v 0 0 0  \r\nv 1 0 0\rv 0 1 0\n"
+        "v 9 9\no name\ns off\nvt 0.5 0.5\n"
+        "f 1 2\n\tf 1 2 3\t\r\n", messy));
+    CHECK(ImportText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n", clean));
+    CHECK(SameMesh(messy, clean));
+}
+
+TEST_CASE(ParsesNumbersLikePython)
+{
+    ObjMesh mesh;
+    CHECK(ImportText("v 1e2 -.5 +3.\nv 0.1 1.7976931348623157e308 12345678901234567890\nv 0 1 0\nf 1 2 3\n", mesh));
+    CHECK(mesh.vertices[0].pos[0] == 100.0);
+    CHECK(mesh.vertices[0].pos[1] == -0.5);
+    CHECK(mesh.vertices[0].pos[2] == 3.0);
+    CHECK(mesh.vertices[1].pos[0] == 0.1);
+    CHECK(mesh.vertices[1].pos[1] == 1.7976931348623157e308);
+    CHECK(mesh.vertices[1].pos[2] == 12345678901234567890.0);
+}
+
+// ==== 错误 ====
+TEST_CASE(ReportsErrors)
+{
+    ObjMesh mesh;
+    std::string error;
+    CHECK(!ImportText("v 0 0 0\nv 1 0 x\nv 0 1 0\nf 1 2 3\n", mesh, nullptr, ObjImporter::kDefaultChunkBytes, &error));
+    CHECK(error.find("第 2 行") != std::string::npos);
+    CHECK(!ImportText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n", mesh, nullptr, ObjImporter::kDefaultChunkBytes, &error));
+    CHECK(!error.empty());
+    CHECK(!ImportText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 a\n", mesh, nullptr, ObjImporter::kDefaultChunkBytes, &error));
+    CHECK(!ImportText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 0 1 2\n", mesh));
+    CHECK(!ImportText("v 0 0 0\nv 1 0 0\nv 0 1 0\n", mesh, nullptr, ObjImporter::kDefaultChunkBytes, &error));
+    CHECK(!error.empty());
+
+    ObjImporter importer;
+    CHECK(!importer.Import("ObjImporterTests_does_not_exist.obj", mesh));
+    CHECK(!importer.GetError().empty());
+}
+
+// ==== 分块与并行 ====
+TEST_CASE(ChunkedParallelImportMatchesSerial)
+{
+    // 约 1 MB：网格顶点、带 vn 的四边形、负编号，跨越很多个 4 KB 的块
+    std::string obj;
+    const int n = 120;
+    char line[128];
+    for (int y = 0; y <= n; ++y)
+    {
+        for (int x = 0; x <= n; ++x)
+        {
+            snprintf(line, sizeof(line), "v %.4f %.4f %.5f\n", x * 0.01, y * 0.01, 0.001 * ((x * 7 + y * 13) % 17));
+            obj += line;
+        }
+    }
+    obj += "vn 0 0 1\nvn 0.1 0 1\n";
+    for (int y = 0; y < n; ++y)
+    {
+        for (int x = 0; x < n; ++x)
+        {
+            const int a = y * (n + 1) + x + 1;
+            if ((x + y) % 3 == 0)
+                snprintf(line, sizeof(line), "f %d//1 %d//2 %d//1 %d//2\n", a, a + 1, a + n + 2, a + n + 1);
+            else
+                snprintf(line, sizeof(line), "f %d/1 %d %d\r\nf %d %d %d\n", a, a + 1, a + n + 2, a, a + n + 2, a + n + 1);
+            obj += line;
+        }
+    }
+    CHECK(obj.size() > 500 * 1024);
+
+    ObjMesh serial, chunked, parallel;
+    CHECK(ImportText(obj, serial));
+    CHECK(ImportText(obj, chunked, nullptr, 4096));
+    JobSystem jobs(3);
+    CHECK(ImportText(obj, parallel, &jobs, 64 * 1024));
+    CHECK(serial.indices.size() == static_cast<size_t>(n) * n * 6);
+    CHECK(SameMesh(serial, chunked));
+    CHECK(SameMesh(serial, parallel));
+}
+
+TEST_MAIN()
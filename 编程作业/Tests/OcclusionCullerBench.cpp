@@ -0,0 +1,106 @@
+//***************************************************************************************
+// OcclusionCullerBench.cpp
+//
+// 遮挡剔除的效果与开销：n³ 个单元先经八叉树视锥剔除，再取最近的 32 个可见单元的
+// 立方体作为遮挡体（与 SceneRenderer 的做法相同），报告每种视角下被遮挡的比例和每帧耗时。
+// 用法：OcclusionCullerBench [-quick]
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestCamera.h"
+#include "CellOctree.h"
+#include "OcclusionCuller.h"
+#include <algorithm>
+
+namespace
+{
+    const uint32_t kMaxOccluderCells = 32;
+
+    // 以原点为中心、半边长 h 的立方体，三角形朝外
+    void MakeCube(float h, float positions[8][3], uint16_t indices[36])
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            positions[i][0] = (i & 1) ? h : -h;
+            positions[i][1] = (i & 2) ? h : -h;
+            positions[i][2] = (i & 4) ? h : -h;
+        }
+        static const uint16_t faces[36] = {
+            0, 2, 3, 0, 3, 1,   4, 5, 7, 4, 7, 6,
+            0, 4, 6, 0, 6, 2,   1, 3, 7, 1, 7, 5,
+            0, 1, 5, 0, 5, 4,   2, 6, 7, 2, 7, 3 };
+        std::copy(faces, faces + 36, indices);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    const int sizes[] = { 50, 100 };
+    const int quickSizes[] = { 20 };
+    const int* pSizes = quick ? quickSizes : sizes;
+    const int sizeCount = quick ? 1 : 2;
+    const int frames = quick ? 3 : 20;
+    const float spacing = 4.5f;
+    const float cellRadius = 3.0f;
+
+    float cube[8][3];
+    uint16_t cubeIndices[36];
+    MakeCube(cellRadius * 0.5f, cube, cubeIndices);
+
+    printf("%6s %-12s %10s %10s %10s %12s\n", "n", "视角", "视锥可见", "被遮挡", "遮挡比例", "遮挡 ms/帧");
+    for (int s = 0; s < sizeCount; ++s)
+    {
+        const int n = pSizes[s];
+        SphereSoA bounds;
+        TestCamera::BuildGrid(n, spacing, cellRadius, bounds);
+        CellOctree octree;
+        octree.Build(n);
+        octree.Refit(bounds);
+        std::vector<uint8_t> visible(bounds.Size());
+        TestCamera::Camera cameras[4];
+        TestCamera::MakeForestCameras(n, spacing, cameras);
+
+        OcclusionCuller culler;
+        for (const TestCamera::Camera& camera : cameras)
+        {
+            float viewProj[16];
+            TestCamera::MakeViewProj(camera, viewProj);
+            FrustumCuller frustum;
+            frustum.SetViewProj(viewProj);
+            octree.Cull(frustum, camera.eye[0], camera.eye[1], camera.eye[2], visible.data());
+            const std::vector<uint32_t>& visibleCells = octree.GetVisibleCells();
+
+            uint32_t occluded = 0;
+            TestCommon::BenchTimer timer;
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                culler.Begin(viewProj);
+                const uint32_t occluderCount = std::min(kMaxOccluderCells, static_cast<uint32_t>(visibleCells.size()));
+                for (uint32_t i = 0; i < occluderCount; ++i)
+                {
+                    const uint32_t cell = visibleCells[i];
+                    const float world[16] = {
+                        1.0f, 0.0f, 0.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 1.0f, 0.0f,
+                        bounds.x[cell], bounds.y[cell], bounds.z[cell], 1.0f };
+                    culler.RasterizeMesh(cube, sizeof(cube[0]), 8, cubeIndices, 36, world);
+                }
+                culler.BuildHiZ();
+
+                occluded = 0;
+                for (uint32_t cell : visibleCells)
+                {
+                    if (culler.IsSphereOccluded(bounds.x[cell], bounds.y[cell], bounds.z[cell], bounds.r[cell]))
+                        ++occluded;
+                }
+            }
+            const double msPerFrame = timer.GetSeconds() * 1000.0 / frames;
+            const size_t visibleCount = visibleCells.size();
+            printf("%6d %-12s %10zu %10u %9.1f%% %12.3f\n", n, camera.name, visibleCount, occluded,
+                visibleCount ? 100.0 * occluded / visibleCount : 0.0, msPerFrame);
+        }
+    }
+    return 0;
+}
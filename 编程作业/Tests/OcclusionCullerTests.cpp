@@ -0,0 +1,327 @@
+//***************************************************************************************
+// OcclusionCullerTests.cpp
+//
+// OcclusionCuller：遮挡体后方的球被剔除、前方/部分遮挡/屏幕外的不剔除，
+// 层次 Z 每级是下一级 2×2 的最大值，剔除结果保守（被剔除的球一定整体在遮挡体之后）；
+// 内部盒子完全在网格内部，两笔之间无论多窄的缝后面的球都不会被剔除。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestCamera.h"
+#include "TestMesh.h"
+#include "OcclusionCuller.h"
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    const float kIdentity[16] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f };
+
+    // 相机在原点看向 +z，90° 视野
+    void BeginForward(OcclusionCuller& culler)
+    {
+        const float eye[3] = { 0.0f, 0.0f, 0.0f };
+        const float target[3] = { 0.0f, 0.0f, 1.0f };
+        float viewProj[16];
+        TestCamera::MakeViewProj(eye, target, 1.5708f, 2.0f, 1.0f, 1000.0f, viewProj);
+        culler.Begin(viewProj);
+    }
+
+    // z = depth 处的矩形 [x0, x1] × [y0, y1]，两个三角形都朝向相机
+    void RasterizeQuad(OcclusionCuller& culler, float x0, float y0, float x1, float y1, float depth)
+    {
+        const float positions[4][3] = { { x0, y0, depth }, { x0, y1, depth }, { x1, y1, depth }, { x1, y0, depth } };
+        const uint16_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+        culler.RasterizeMesh(positions, sizeof(positions[0]), 4, indices, 6, kIdentity);
+    }
+
+    // 追加一个封闭的长方体笔画 [x0, x1] × [y0, y1] × [z0, z1]，三角形朝外
+    void AppendCuboid(float x0, float y0, float z0, float x1, float y1, float z1,
+        std::vector<TestMesh::Position>& positions, std::vector<uint16_t>& indices)
+    {
+        const uint16_t base = static_cast<uint16_t>(positions.size());
+        for (int i = 0; i < 8; ++i)
+            positions.push_back({ (i & 1) ? x1 : x0, (i & 2) ? y1 : y0, (i & 4) ? z1 : z0 });
+        const uint16_t faces[12][3] = {
+            { 0, 2, 3 }, { 0, 3, 1 }, { 4, 5, 7 }, { 4, 7, 6 },     // -z、+z
+            { 0, 4, 6 }, { 0, 6, 2 }, { 1, 3, 7 }, { 1, 7, 5 },     // -x、+x
+            { 0, 1, 5 }, { 0, 5, 4 }, { 2, 6, 7 }, { 2, 7, 3 } };   // -y、+y
+        for (const auto& face : faces)
+            for (uint16_t index : face)
+                indices.push_back(static_cast<uint16_t>(base + index));
+    }
+
+    // 把网格的内部盒子作为遮挡体光栅化（与 SceneRenderer::OccludeCells 相同）
+    void RasterizeInnerBoxes(OcclusionCuller& culler, const std::vector<TestMesh::Position>& positions,
+        const std::vector<uint16_t>& indices)
+    {
+        std::vector<OcclusionCuller::Box> boxes;
+        OcclusionCuller::BuildInnerBoxes(positions.data(), sizeof(positions[0]), static_cast<uint32_t>(positions.size()),
+            indices.data(), static_cast<uint32_t>(indices.size()), boxes);
+        for (const OcclusionCuller::Box& box : boxes)
+            culler.RasterizeBox(box, kIdentity);
+    }
+
+    // z = 10 处两道竖笔画，中间留出 [gapCenter - gap / 2, gapCenter + gap / 2] 的缝
+    void RasterizeStrokes(OcclusionCuller& culler, float gapCenter, float gap)
+    {
+        std::vector<TestMesh::Position> positions;
+        std::vector<uint16_t> indices;
+        AppendCuboid(-3.0f, -4.0f, 10.0f, gapCenter - gap * 0.5f, 4.0f, 11.0f, positions, indices);
+        AppendCuboid(gapCenter + gap * 0.5f, -4.0f, 10.0f, 3.0f, 4.0f, 11.0f, positions, indices);
+        RasterizeInnerBoxes(culler, positions, indices);
+    }
+}
+
+TEST_CASE(EmptyDepthOccludesNothing)
+{
+    OcclusionCuller culler;
+    BeginForward(culler);
+    culler.BuildHiZ();
+    CHECK(!culler.IsSphereOccluded(0.0f, 0.0f, 500.0f, 1.0f));
+    CHECK(culler.GetStats().spheresTested == 1);
+    CHECK(culler.GetStats().spheresOccluded == 0);
+}
+
+TEST_CASE(WallOccludesSpheresBehindIt)
+{
+    OcclusionCuller culler;
+    BeginForward(culler);
+    RasterizeQuad(culler, -100.0f, -100.0f, 100.0f, 100.0f, 10.0f);
+    culler.BuildHiZ();
+    CHECK(culler.GetStats().rasterizedTriangles == 2);
+
+    CHECK(culler.IsSphereOccluded(0.0f, 0.0f, 30.0f, 1.0f));
+    CHECK(culler.IsSphereOccluded(5.0f, -3.0f, 200.0f, 20.0f));
+    CHECK(!culler.IsSphereOccluded(0.0f, 0.0f, 5.0f, 1.0f));       // 在墙前面
+    CHECK(!culler.IsSphereOccluded(0.0f, 0.0f, 10.5f, 1.0f));      // 与墙相交
+    CHECK(!culler.IsSphereOccluded(0.0f, 0.0f, -20.0f, 1.0f));     // 在相机后方
+    CHECK(!culler.IsSphereOccluded(0.0f, 0.0f, 1.2f, 1.0f));       // 跨过近平面
+    CHECK(!culler.IsSphereOccluded(5000.0f, 0.0f, 30.0f, 1.0f));   // 屏幕外交给视锥剔除
+    CHECK(culler.GetStats().spheresOccluded == 2);
+}
+
+TEST_CASE(PartialOccluderKeepsSphere)
+{
+    OcclusionCuller culler;
+    BeginForward(culler);
+    // 只挡住左半边
+    RasterizeQuad(culler, -100.0f, -100.0f, 0.0f, 100.0f, 10.0f);
+    culler.BuildHiZ();
+    CHECK(culler.IsSphereOccluded(-20.0f, 0.0f, 40.0f, 2.0f));
+    CHECK(!culler.IsSphereOccluded(0.0f, 0.0f, 40.0f, 5.0f));
+    CHECK(!culler.IsSphereOccluded(20.0f, 0.0f, 40.0f, 2.0f));
+}
+
+TEST_CASE(TrianglesBehindCameraAreSkipped)
+{
+    OcclusionCuller culler;
+    BeginForward(culler);
+    RasterizeQuad(culler, -100.0f, -100.0f, 100.0f, 100.0f, -10.0f);
+    culler.BuildHiZ();
+    CHECK(culler.GetStats().occluderTriangles == 2);
+    CHECK(culler.GetStats().rasterizedTriangles == 0);
+    CHECK(!culler.IsSphereOccluded(0.0f, 0.0f, 30.0f, 1.0f));
+}
+
+TEST_CASE(HiZLevelsAreMaxOfFinerLevel)
+{
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> coordinate(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> depth(5.0f, 80.0f);
+    OcclusionCuller culler;
+    BeginForward(culler);
+    for (int i = 0; i < 30; ++i)
+    {
+        const float x = coordinate(random), y = coordinate(random);
+        RasterizeQuad(culler, x, y, x + 15.0f, y + 10.0f, depth(random));
+    }
+    culler.BuildHiZ();
+
+    int width = 0, height = 0;
+    const float* pFine = culler.GetDepth(0, &width, &height);
+    CHECK(width == OcclusionCuller::kWidth && height == OcclusionCuller::kHeight);
+    // 有像素被写入
+    CHECK(*std::min_element(pFine, pFine + width * height) < 1.0f);
+
+    bool conservative = true;
+    for (int level = 1; width > 1 || height > 1; ++level)
+    {
+        int coarseWidth = 0, coarseHeight = 0;
+        const float* pCoarse = culler.GetDepth(level, &coarseWidth, &coarseHeight);
+        for (int y = 0; y < coarseHeight; ++y)
+        {
+            for (int x = 0; x < coarseWidth; ++x)
+            {
+                float expected = 0.0f;
+                for (int dy = 0; dy < 2; ++dy)
+                    for (int dx = 0; dx < 2; ++dx)
+                        expected = std::max(expected, pFine[std::min(y * 2 + dy, height - 1) * width + std::min(x * 2 + dx, width - 1)]);
+                conservative = conservative && pCoarse[y * coarseWidth + x] == expected;
+            }
+        }
+        pFine = pCoarse;
+        width = coarseWidth;
+        height = coarseHeight;
+    }
+    CHECK(conservative);
+}
+
+TEST_CASE(OccludedSpheresAreBehindTheOccluder)
+{
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> coordinate(-80.0f, 80.0f);
+    std::uniform_real_distribution<float> depth(2.0f, 60.0f);
+    std::uniform_real_distribution<float> radius(0.1f, 6.0f);
+    OcclusionCuller culler;
+    BeginForward(culler);
+    const float wallDepth = 25.0f;
+    const float kPixelAtWall = wallDepth * 4.0f / OcclusionCuller::kWidth;
+    RasterizeQuad(culler, -30.0f, -20.0f, 30.0f, 20.0f, wallDepth);
+    culler.BuildHiZ();
+
+    uint32_t occluded = 0;
+    bool conservative = true;
+    for (int i = 0; i < 5000; ++i)
+    {
+        const float x = coordinate(random), y = coordinate(random), z = depth(random), r = radius(random);
+        if (!culler.IsSphereOccluded(x, y, z, r))
+            continue;
+        ++occluded;
+        // 整体在墙后，并且从相机看落在墙的范围内（墙边界按透视投影到球的最近深度）。
+        // 光栅化按像素中心判断覆盖，边上允许差一个像素（墙所在深度上约 25 / 64）
+        const float scale = (z - r) / wallDepth;
+        const float halfWidth = 30.0f + kPixelAtWall, halfHeight = 20.0f + kPixelAtWall;
+        conservative = conservative && z - r > wallDepth
+            && x - r >= -halfWidth * scale && x + r <= halfWidth * scale
+            && y - r >= -halfHeight * scale && y + r <= halfHeight * scale;
+    }
+    CHECK(occluded > 0);
+    CHECK(conservative);
+}
+
+TEST_CASE(InnerBoxesStayInsideConvexMesh)
+{
+    std::vector<TestMesh::Position> positions;
+    std::vector<uint16_t> indices;
+    TestMesh::AppendSphere(1.0f, 2.0f, 3.0f, 2.0f, 12, 16, positions, indices);
+    std::vector<OcclusionCuller::Box> boxes;
+    OcclusionCuller::BuildInnerBoxes(positions.data(), sizeof(positions[0]), static_cast<uint32_t>(positions.size()),
+        indices.data(), static_cast<uint32_t>(indices.size()), boxes, 16, 8);
+    CHECK(!boxes.empty() && boxes.size() <= 8);
+
+    // 球网格是凸的：盒子的 8 个角都在每个面（朝外）的内侧
+    bool inside = true;
+    float volume = 0.0f;
+    for (const OcclusionCuller::Box& box : boxes)
+    {
+        volume += (box.max[0] - box.min[0]) * (box.max[1] - box.min[1]) * (box.max[2] - box.min[2]);
+        for (size_t t = 0; t + 2 < indices.size(); t += 3)
+        {
+            const TestMesh::Position& a = positions[indices[t]];
+            const TestMesh::Position& b = positions[indices[t + 1]];
+            const TestMesh::Position& c = positions[indices[t + 2]];
+            const float ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+            const float vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+            const float nx = uy * vz - uz * vy, ny = uz * vx - ux * vz, nz = ux * vy - uy * vx;
+            for (int i = 0; i < 8; ++i)
+            {
+                const float px = ((i & 1) ? box.max[0] : box.min[0]) - a.x;
+                const float py = ((i & 2) ? box.max[1] : box.min[1]) - a.y;
+                const float pz = ((i & 4) ? box.max[2] : box.min[2]) - a.z;
+                inside = inside && nx * px + ny * py + nz * pz <= 1e-5f;
+            }
+        }
+    }
+    CHECK(inside);
+    // 最大的几个盒子占据了球体积的相当一部分（4/3 π r³ ≈ 33.5）
+    CHECK(volume > 10.0f);
+}
+
+TEST_CASE(InnerBoxesDoNotBridgeStrokes)
+{
+    std::vector<TestMesh::Position> positions;
+    std::vector<uint16_t> indices;
+    AppendCuboid(-3.0f, -4.0f, 0.0f, -0.01f, 4.0f, 1.0f, positions, indices);
+    AppendCuboid(0.01f, -4.0f, 0.0f, 3.0f, 4.0f, 1.0f, positions, indices);
+    std::vector<OcclusionCuller::Box> boxes;
+    OcclusionCuller::BuildInnerBoxes(positions.data(), sizeof(positions[0]), static_cast<uint32_t>(positions.size()),
+        indices.data(), static_cast<uint32_t>(indices.size()), boxes);
+    CHECK(boxes.size() >= 2);
+    bool separate = true;
+    for (const OcclusionCuller::Box& box : boxes)
+        separate = separate && (box.max[0] <= -0.01f || box.min[0] >= 0.01f)
+            && box.min[1] >= -4.0f && box.max[1] <= 4.0f && box.min[2] >= 0.0f && box.max[2] <= 1.0f;
+    CHECK(separate);
+
+    // 不封闭的网格（去掉一个面）或扁平网格不生成盒子
+    indices.resize(indices.size() - 3);
+    OcclusionCuller::BuildInnerBoxes(positions.data(), sizeof(positions[0]), static_cast<uint32_t>(positions.size()),
+        indices.data(), static_cast<uint32_t>(indices.size()), boxes);
+    separate = true;
+    for (const OcclusionCuller::Box& box : boxes)
+        separate = separate && (box.max[0] <= -0.01f || box.min[0] >= 0.01f);
+    CHECK(separate);
+    const float flat[3][3] = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+    const uint16_t flatIndices[3] = { 0, 1, 2 };
+    OcclusionCuller::BuildInnerBoxes(flat, sizeof(flat[0]), 3, flatIndices, 3, boxes);
+    CHECK(boxes.empty());
+}
+
+TEST_CASE(SphereBehindGapBetweenStrokesIsNeverOccluded)
+{
+    // z = 10 处一个像素约 0.156 个单位：缝宽从远小于一个像素到几个像素，缝的位置在像素内逐步移动
+    const float gaps[] = { 0.005f, 0.02f, 0.05f, 0.1f, 0.2f, 0.5f };
+    const float kPixelAtStrokes = 10.0f * 4.0f / OcclusionCuller::kWidth;
+    bool visible = true;
+    for (float gap : gaps)
+    {
+        for (int step = 0; step < 16; ++step)
+        {
+            const float gapCenter = kPixelAtStrokes * step / 16.0f;
+            OcclusionCuller culler;
+            BeginForward(culler);
+            RasterizeStrokes(culler, gapCenter, gap);
+            culler.BuildHiZ();
+            // 球心正对着缝，远近、大小各不相同，总能从缝中看到一部分
+            const float depths[] = { 30.0f, 100.0f, 400.0f };
+            for (float depth : depths)
+            {
+                const float scale = depth / 10.0f;
+                visible = visible && !culler.IsSphereOccluded(gapCenter * scale, 0.0f, depth, 0.25f);
+                visible = visible && !culler.IsSphereOccluded(gapCenter * scale, 1.0f * scale, depth, 2.0f);
+            }
+        }
+    }
+    CHECK(visible);
+
+    // 对照：同样大小的一整块笔画挡住同样的球，盒子确实写入了深度
+    OcclusionCuller culler;
+    BeginForward(culler);
+    std::vector<TestMesh::Position> positions;
+    std::vector<uint16_t> indices;
+    AppendCuboid(-3.0f, -4.0f, 10.0f, 3.0f, 4.0f, 11.0f, positions, indices);
+    RasterizeInnerBoxes(culler, positions, indices);
+    culler.BuildHiZ();
+    CHECK(culler.GetStats().rasterizedBoxes > 0);
+    CHECK(culler.IsSphereOccluded(0.0f, 0.0f, 100.0f, 2.0f));
+    CHECK(culler.IsSphereOccluded(0.0f, 10.0f, 400.0f, 8.0f));
+}
+
+TEST_CASE(BoxesCrossingNearPlaneAreSkipped)
+{
+    OcclusionCuller culler;
+    BeginForward(culler);
+    const OcclusionCuller::Box box = { { -5.0f, -5.0f, -1.0f }, { 5.0f, 5.0f, 20.0f } };
+    culler.RasterizeBox(box, kIdentity);
+    culler.BuildHiZ();
+    CHECK(culler.GetStats().occluderBoxes == 1);
+    CHECK(culler.GetStats().rasterizedBoxes == 0);
+    CHECK(!culler.IsSphereOccluded(0.0f, 0.0f, 100.0f, 1.0f));
+}
+
+TEST_MAIN()
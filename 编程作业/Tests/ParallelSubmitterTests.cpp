@@ -0,0 +1,265 @@
+//***************************************************************************************
+// ParallelSubmitterTests.cpp
+//
+// ParallelSubmitter：按权重切块，以及多线程录制后按块顺序执行，
+// 绘制顺序与在设备上直接提交相同。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "NullRenderDevice.h"
+#include "ParallelSubmitter.h"
+#include "RenderQueue.h"
+#include <memory>
+
+namespace
+{
+    // 记录每个绘制调用的 (startInstance, instanceCount)：命令上下文各自记录，执行时按上下文顺序接到设备的序列后面
+    class OrderDevice : public NullRenderDevice
+    {
+    public:
+        struct Draw
+        {
+            uint32_t startInstance;
+            uint32_t instanceCount;
+        };
+
+        void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+            uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override
+        {
+            NullRenderDevice::DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+            m_Executed.push_back({ startInstance, instanceCount });
+        }
+
+        CommandContext* BeginCommandContext(uint32_t index) override
+        {
+            while (m_Contexts.size() <= index)
+                m_Contexts.emplace_back(new Context());
+            m_Contexts[index]->draws.clear();
+            return m_Contexts[index].get();
+        }
+
+        void ExecuteCommandContexts(uint32_t count) override
+        {
+            for (uint32_t i = 0; i < count; ++i)
+                m_Executed.insert(m_Executed.end(), m_Contexts[i]->draws.begin(), m_Contexts[i]->draws.end());
+            ++m_Executions;
+        }
+
+        const std::vector<Draw>& GetExecuted() const { return m_Executed; }
+        uint32_t GetExecutions() const { return m_Executions; }
+
+    private:
+        class Context : public CommandContext
+        {
+        public:
+            void SetVertexBuffers(uint32_t, uint32_t, const BufferHandle*, const uint32_t*, const uint32_t*) override {}
+            void SetIndexBuffer(BufferHandle) override {}
+            void SetConstantBuffer(uint32_t, BufferHandle, uint32_t, uint32_t) override {}
+            void SetVertexFormat(VertexFormat) override {}
+            void DrawIndexedInstanced(uint32_t, uint32_t instanceCount, uint32_t, int32_t, uint32_t startInstance) override
+            {
+                draws.push_back({ startInstance, instanceCount });
+            }
+
+            std::vector<Draw> draws;
+        };
+
+        std::vector<std::unique_ptr<Context>> m_Contexts;
+        std::vector<Draw> m_Executed;
+        uint32_t m_Executions = 0;
+    };
+
+    // 与 SceneRenderer::ContextBackend 相同：在给定上下文上按项绘制
+    class DrawBackend : public RenderQueue::Backend
+    {
+    public:
+        explicit DrawBackend(CommandContext& context) : m_Context(context) {}
+        void BindMesh(uint32_t) override {}
+        void BindConstants(uint32_t) override {}
+        void Draw(const RenderQueue::DrawItem& item) override
+        {
+            m_Context.DrawIndexedInstanced(3, item.instanceCount, 0, 0, item.firstInstance);
+        }
+
+    private:
+        CommandContext& m_Context;
+    };
+
+    uint32_t SumWeights(const std::vector<uint32_t>& weights, const ParallelSubmitter::Chunk& chunk)
+    {
+        uint32_t sum = 0;
+        for (uint32_t i = chunk.firstItem; i < chunk.firstItem + chunk.itemCount; ++i)
+            sum += weights[i];
+        return sum;
+    }
+
+    // 实例数悬殊的几个批次，模拟字符森林：四个字各一个大批次，玩家一个实例
+    void FillQueue(RenderQueue& queue)
+    {
+        const uint32_t counts[] = { 250000, 180000, 1, 90000, 70000 };
+        uint32_t first = 0;
+        for (uint32_t mesh = 0; mesh < 5; ++mesh)
+        {
+            queue.Push(mesh, 0, 0.0f, first, counts[mesh]);
+            first += counts[mesh];
+        }
+        queue.Sort();
+    }
+}
+
+TEST_CASE(SplitUniformWeightsDifferByAtMostOne)
+{
+    std::vector<ParallelSubmitter::Chunk> chunks;
+    ParallelSubmitter::Split(nullptr, 10, 3, 1, chunks);
+    CHECK(chunks.size() == 3);
+    uint32_t next = 0;
+    for (const ParallelSubmitter::Chunk& chunk : chunks)
+    {
+        CHECK(chunk.firstItem == next);
+        CHECK(chunk.itemCount == 3 || chunk.itemCount == 4);
+        next += chunk.itemCount;
+    }
+    CHECK(next == 10);
+
+    // 总量不足 minWeightPerChunk 的两倍时只切一块
+    ParallelSubmitter::Split(nullptr, 10, 8, 6, chunks);
+    CHECK(chunks.size() == 1 && chunks[0].itemCount == 10);
+    ParallelSubmitter::Split(nullptr, 0, 8, 1, chunks);
+    CHECK(chunks.empty());
+}
+
+TEST_CASE(SplitBalancesWeights)
+{
+    // 先按份额拆开的大批次：各块的权重应接近平均值
+    RenderQueue queue;
+    FillQueue(queue);
+    const uint32_t maxChunks = 4;
+    const uint32_t total = 590001;
+    queue.SplitItems((total + maxChunks - 1) / maxChunks);
+    std::vector<uint32_t> weights;
+    for (const RenderQueue::DrawItem& item : queue.GetItems())
+        weights.push_back(item.instanceCount);
+
+    std::vector<ParallelSubmitter::Chunk> chunks;
+    ParallelSubmitter::Split(weights.data(), static_cast<uint32_t>(weights.size()), maxChunks, 16384, chunks);
+    CHECK(chunks.size() == maxChunks);
+    uint32_t next = 0, covered = 0;
+    for (const ParallelSubmitter::Chunk& chunk : chunks)
+    {
+        CHECK(chunk.firstItem == next && chunk.itemCount > 0);
+        next += chunk.itemCount;
+        const uint32_t weight = SumWeights(weights, chunk);
+        covered += weight;
+        // 每块不超过一个拆分份额，不会整帧落在一块里
+        CHECK(weight <= (total + maxChunks - 1) / maxChunks);
+    }
+    CHECK(next == weights.size());
+    CHECK(covered == total);
+
+    // 没有拆分时大批次只能整个落在一块里：块数受项数限制
+    RenderQueue unsplit;
+    FillQueue(unsplit);
+    weights.clear();
+    for (const RenderQueue::DrawItem& item : unsplit.GetItems())
+        weights.push_back(item.instanceCount);
+    ParallelSubmitter::Split(weights.data(), static_cast<uint32_t>(weights.size()), 16, 16384, chunks);
+    CHECK(chunks.size() == weights.size());
+}
+
+TEST_CASE(MinWeightLimitsChunkCount)
+{
+    const std::vector<uint32_t> weights(100, 100);
+    std::vector<ParallelSubmitter::Chunk> chunks;
+    ParallelSubmitter::Split(weights.data(), 100, 8, 2500, chunks);
+    CHECK(chunks.size() == 4);
+    for (const ParallelSubmitter::Chunk& chunk : chunks)
+        CHECK(SumWeights(weights, chunk) == 2500);
+}
+
+TEST_CASE(ParallelSubmitMatchesDirectOrder)
+{
+    RenderQueue queue;
+    FillQueue(queue);
+
+    // 直接在设备上提交的顺序
+    OrderDevice direct;
+    {
+        DrawBackend backend(direct);
+        queue.Submit(backend);
+    }
+
+    for (unsigned workers : { 1u, 3u, 7u })
+    {
+        JobSystem jobs(workers);
+        OrderDevice device;
+        RenderQueue split;
+        FillQueue(split);
+        const uint32_t maxChunks = ParallelSubmitter::GetMaxChunks(device, &jobs);
+        CHECK(maxChunks == workers + 1);
+        split.SplitItems((590001 + maxChunks - 1) / maxChunks);
+        std::vector<uint32_t> weights;
+        for (const RenderQueue::DrawItem& item : split.GetItems())
+            weights.push_back(item.instanceCount);
+
+        for (int round = 0; round < 20; ++round)
+        {
+            ParallelSubmitter submitter;
+            std::vector<RenderQueue::Stats> stats(maxChunks);
+            const uint32_t contexts = submitter.Submit(device, &jobs, weights.data(), static_cast<uint32_t>(weights.size()),
+                16384, [&](uint32_t chunkIndex, CommandContext& context, const ParallelSubmitter::Chunk& chunk) {
+                    DrawBackend backend(context);
+                    split.SubmitRange(backend, chunk.firstItem, chunk.itemCount, stats[chunkIndex]);
+                });
+            CHECK(contexts == maxChunks);
+        }
+        CHECK(device.GetExecutions() == 20);
+
+        // 拆开的绘制按顺序拼起来，覆盖的实例范围与直接提交相同
+        const std::vector<OrderDevice::Draw>& executed = device.GetExecuted();
+        const size_t perRound = split.GetItems().size();
+        CHECK(executed.size() == perRound * 20);
+        bool sameOrder = true;
+        for (size_t round = 0; round < 20 && sameOrder; ++round)
+        {
+            size_t d = round * perRound;
+            for (const OrderDevice::Draw& expected : direct.GetExecuted())
+            {
+                uint32_t start = expected.startInstance, remaining = expected.instanceCount;
+                while (remaining > 0 && d < executed.size() && sameOrder)
+                {
+                    sameOrder = executed[d].startInstance == start && executed[d].instanceCount <= remaining;
+                    start += executed[d].instanceCount;
+                    remaining -= executed[d].instanceCount;
+                    ++d;
+                }
+                sameOrder = sameOrder && remaining == 0;
+            }
+        }
+        CHECK(sameOrder);
+    }
+}
+
+TEST_CASE(WithoutJobSystemRecordsOnDevice)
+{
+    RenderQueue queue;
+    FillQueue(queue);
+    OrderDevice device;
+    ParallelSubmitter submitter;
+    std::vector<uint32_t> weights;
+    for (const RenderQueue::DrawItem& item : queue.GetItems())
+        weights.push_back(item.instanceCount);
+    CommandContext* pRecorded = nullptr;
+    const uint32_t contexts = submitter.Submit(device, nullptr, weights.data(), static_cast<uint32_t>(weights.size()),
+        16384, [&](uint32_t, CommandContext& context, const ParallelSubmitter::Chunk& chunk) {
+            pRecorded = &context;
+            RenderQueue::Stats stats;
+            DrawBackend backend(context);
+            queue.SubmitRange(backend, chunk.firstItem, chunk.itemCount, stats);
+        });
+    CHECK(contexts == 0);
+    CHECK(pRecorded == &device);
+    CHECK(device.GetExecutions() == 0);
+    CHECK(device.GetExecuted().size() == queue.GetItems().size());
+}
+
+TEST_MAIN()
@@ -0,0 +1,115 @@
+//***************************************************************************************
+// PollBackoffTests.cpp
+//
+// PollBackoff：先自旋、超过 kSpinNs 后睡眠，睡眠时长翻倍到上限，Reset 后重新从自旋开始；
+// 以及等待一个在固定时刻满足的条件时，醒来的延迟不超过一次最长睡眠。时间由 FakeClock 推进。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "PollBackoff.h"
+#include <vector>
+
+namespace
+{
+    const uint64_t kReadCostNs = 100;
+}
+
+// ==== 自旋与睡眠 ====
+TEST_CASE(SpinsBeforeSleeping)
+{
+    FakeClock clock(1000);
+    clock.SetReadCost(kReadCostNs);
+    PollBackoff backoff(clock);
+    backoff.Reset();
+    while (clock.NowNs() - 1000 < PollBackoff::kSpinNs)
+        backoff.Wait();
+    CHECK(clock.GetSleepCount() == 0);
+    CHECK(backoff.GetStats().sleeps == 0);
+    CHECK(backoff.GetStats().spinNs >= PollBackoff::kSpinNs / 2);     // 其余是两次 Wait 之间读时钟的开销
+
+    backoff.Wait();
+    CHECK(clock.GetSleepCount() == 1);
+    CHECK(backoff.GetStats().sleeps == 1);
+}
+
+TEST_CASE(SleepDoublesUpToMaximum)
+{
+    FakeClock clock;
+    clock.SetReadCost(kReadCostNs);     // 自旋靠读时钟的开销推进假时钟
+    PollBackoff backoff(clock);
+    backoff.Reset();
+    backoff.Wait();                         // 记下开始时刻，自旋一步
+    clock.Advance(PollBackoff::kSpinNs);    // 直接越过自旋阶段
+
+    std::vector<uint64_t> sleeps;
+    for (int i = 0; i < 6; ++i)
+    {
+        const uint64_t before = backoff.GetStats().sleepNs;
+        backoff.Wait();
+        sleeps.push_back(backoff.GetStats().sleepNs - before);
+    }
+    // 统计的是实际耗时，包含睡眠后读一次时钟的开销
+    CHECK(sleeps[0] == PollBackoff::kMinSleepNs + kReadCostNs);
+    CHECK(sleeps[1] == PollBackoff::kMinSleepNs * 2 + kReadCostNs);
+    for (size_t i = 1; i < sleeps.size(); ++i)
+        CHECK(sleeps[i] >= sleeps[i - 1] && sleeps[i] <= PollBackoff::kMaxSleepNs + kReadCostNs);
+    CHECK(sleeps.back() == PollBackoff::kMaxSleepNs + kReadCostNs);
+}
+
+TEST_CASE(ResetStartsWithSpinAgain)
+{
+    FakeClock clock;
+    clock.SetReadCost(kReadCostNs);     // 自旋靠读时钟的开销推进假时钟
+    PollBackoff backoff(clock);
+    backoff.Reset();
+    backoff.Wait();
+    clock.Advance(PollBackoff::kSpinNs);
+    backoff.Wait();
+    backoff.Wait();
+    CHECK(clock.GetSleepCount() == 2);
+
+    const uint64_t sleepNs = backoff.GetStats().sleepNs;
+    backoff.Reset();
+    backoff.Wait();
+    CHECK(clock.GetSleepCount() == 2);
+    clock.Advance(PollBackoff::kSpinNs);
+    backoff.Wait();
+    CHECK(backoff.GetStats().sleepNs - sleepNs == PollBackoff::kMinSleepNs + kReadCostNs);
+    CHECK(backoff.GetStats().waits == 5);
+
+    backoff.ResetStats();
+    CHECK(backoff.GetStats().waits == 0);
+    CHECK(backoff.GetStats().sleepNs == 0);
+}
+
+TEST_CASE(WakesSoonAfterConditionHolds)
+{
+    // 条件在 readyNs 满足：醒来的延迟在自旋阶段不超过一步，在睡眠阶段不超过一次最长睡眠（含超时）
+    const uint64_t kOvershootNs = 80000;
+    const uint64_t readyTimes[] = { 0, 1500, 30000, 400000, 5000000, 20000000 };
+    for (uint64_t readyNs : readyTimes)
+    {
+        FakeClock clock;
+        clock.SetReadCost(kReadCostNs);
+        clock.SetSleepOvershoot(kOvershootNs);
+        PollBackoff backoff(clock);
+        backoff.Reset();
+        uint64_t polls = 0;
+        uint64_t now = clock.NowNs();
+        while (now < readyNs)
+        {
+            backoff.Wait();
+            now = clock.NowNs();
+            ++polls;
+        }
+        const uint64_t lateNs = now - readyNs;
+        if (readyNs < PollBackoff::kSpinNs)
+            CHECK(lateNs <= PollBackoff::kSpinStepNs + 2 * kReadCostNs);
+        else
+            CHECK(lateNs <= PollBackoff::kMaxSleepNs + kOvershootNs + 2 * kReadCostNs);
+        // 睡眠阶段轮询次数按对数增长后趋于线性，不会像逐次让出时间片那样空转
+        CHECK(polls <= PollBackoff::kSpinNs / PollBackoff::kSpinStepNs + 2 + readyNs / PollBackoff::kMaxSleepNs + 3);
+    }
+}
+
+TEST_MAIN()
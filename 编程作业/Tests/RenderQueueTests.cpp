@@ -0,0 +1,165 @@
+//***************************************************************************************
+// RenderQueueTests.cpp
+//
+// RenderQueue：排序键布局、基数排序的稳定性、按实例数拆分绘制项，以及对记录后端提交时跳过重复绑定。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "RenderQueue.h"
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    typedef RenderQueueRecorder::CommandType CommandType;
+
+    uint32_t CountCommands(const RenderQueueRecorder& recorder, CommandType type)
+    {
+        uint32_t count = 0;
+        for (const RenderQueueRecorder::Command& command : recorder.GetCommands())
+        {
+            if (command.type == type)
+                ++count;
+        }
+        return count;
+    }
+}
+
+TEST_CASE(KeyOrdersMeshThenDepth)
+{
+    const uint32_t nearDepth = RenderQueue::DepthBucket(1.0f);
+    const uint32_t farDepth = RenderQueue::DepthBucket(100.0f);
+    CHECK(nearDepth < farDepth);
+    CHECK(RenderQueue::DepthBucket(-5.0f) == 0);
+    CHECK(RenderQueue::DepthBucket(0.0f) == 0);
+
+    CHECK(RenderQueue::MakeKey(0, farDepth) < RenderQueue::MakeKey(1, nearDepth));
+    CHECK(RenderQueue::MakeKey(1, nearDepth) < RenderQueue::MakeKey(1, farDepth));
+    CHECK((RenderQueue::MakeKey(3, 42) >> 32) == 3);
+    CHECK((RenderQueue::MakeKey(3, 42) & 0xFFFFFFFFu) == 42);
+}
+
+TEST_CASE(SortMatchesStableSortByKey)
+{
+    std::mt19937 random(7);
+    RenderQueue queue;
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        const uint32_t mesh = random() % 5;
+        const float depth = static_cast<float>(random() % 64);
+        // 实例起点记录推入顺序，用来检查相同键之间的顺序
+        queue.Push(mesh, 0, depth, i, 1);
+    }
+    std::vector<RenderQueue::DrawItem> expected = queue.GetItems();
+    std::stable_sort(expected.begin(), expected.end(),
+        [](const RenderQueue::DrawItem& a, const RenderQueue::DrawItem& b) { return a.key < b.key; });
+
+    queue.Sort();
+    const std::vector<RenderQueue::DrawItem>& items = queue.GetItems();
+    CHECK(items.size() == expected.size());
+    bool same = true;
+    for (size_t i = 0; i < items.size(); ++i)
+        same = same && items[i].key == expected[i].key && items[i].firstInstance == expected[i].firstInstance;
+    CHECK(same);
+    // 深度只用到低 32 位中的少数几个字节，全部相同的字节不排
+    CHECK(queue.GetStats().sortPasses < 8);
+}
+
+TEST_CASE(SplitItemsKeepsOrderAndInstances)
+{
+    RenderQueue queue;
+    queue.Push(0, 7, 0.0f, 0, 10);
+    queue.Push(1, 7, 0.0f, 100, 3);
+    queue.Push(2, 7, 0.0f, 5, 0);
+    queue.Push(3, 8, 2.0f, 0, 8);
+    queue.Sort();
+    queue.SplitItems(4);
+
+    // 在累计实例数 4、8、12、16、20 处切开：10 -> 4 + 4 + 2，3 -> 2 + 1，0 实例的项保留，8 -> 3 + 4 + 1
+    const std::vector<RenderQueue::DrawItem>& items = queue.GetItems();
+    CHECK(items.size() == 9);
+    const uint32_t expectedMesh[] = { 0, 0, 0, 1, 1, 2, 3, 3, 3 };
+    const uint32_t expectedFirst[] = { 0, 4, 8, 100, 102, 5, 0, 3, 7 };
+    const uint32_t expectedCount[] = { 4, 4, 2, 2, 1, 0, 3, 4, 1 };
+    for (size_t i = 0; i < items.size() && i < 9; ++i)
+    {
+        CHECK(items[i].meshId == expectedMesh[i]);
+        CHECK(items[i].firstInstance == expectedFirst[i]);
+        CHECK(items[i].instanceCount == expectedCount[i]);
+        CHECK(items[i].key == RenderQueue::MakeKey(items[i].meshId,
+            RenderQueue::DepthBucket(items[i].meshId == 3 ? 2.0f : 0.0f)));
+    }
+
+    // 拆开的项网格和常量相同，提交时不会重新绑定
+    RenderQueueRecorder recorder;
+    queue.Submit(recorder);
+    CHECK(CountCommands(recorder, CommandType::Draw) == 9);
+    CHECK(CountCommands(recorder, CommandType::BindMesh) == 4);
+    CHECK(CountCommands(recorder, CommandType::BindConstants) == 2);
+}
+
+TEST_CASE(SubmitSkipsRedundantBinds)
+{
+    RenderQueue queue;
+    // 网格交替推入，排序后同一网格相邻
+    for (uint32_t i = 0; i < 8; ++i)
+        queue.Push(i % 2, 0, static_cast<float>(i + 1), i, 1);
+    queue.Push(2, 1, 1.0f, 0, 1);    // 玩家：不同的对象常量
+    queue.Sort();
+
+    RenderQueueRecorder recorder;
+    queue.Submit(recorder);
+    const RenderQueue::Stats& stats = queue.GetStats();
+    CHECK(stats.items == 9);
+    CHECK(stats.meshBinds == 3);
+    CHECK(stats.meshBindsAvoided == 6);
+    CHECK(stats.constantBinds == 2);
+    CHECK(stats.constantBindsAvoided == 7);
+    CHECK(stats.Binds() == CountCommands(recorder, CommandType::BindMesh) + CountCommands(recorder, CommandType::BindConstants));
+    CHECK(CountCommands(recorder, CommandType::Draw) == 9);
+
+    // 命令序列：常量、网格、绘制……，绑定总在对应的绘制之前
+    const std::vector<RenderQueueRecorder::Command>& commands = recorder.GetCommands();
+    CHECK(commands[0].type == CommandType::BindConstants && commands[0].id == 0);
+    CHECK(commands[1].type == CommandType::BindMesh && commands[1].id == 0);
+    CHECK(commands[2].type == CommandType::Draw && commands[2].id == 0);
+    // 同一网格内由近到远
+    CHECK(commands[2].firstInstance == 0 && commands[3].firstInstance == 2);
+    const RenderQueueRecorder::Command& last = commands.back();
+    CHECK(last.type == CommandType::Draw && last.id == 2);
+    CHECK(commands[commands.size() - 3].type == CommandType::BindConstants && commands[commands.size() - 3].id == 1);
+}
+
+TEST_CASE(SubmitRangesRebindFromScratch)
+{
+    RenderQueue queue;
+    for (uint32_t i = 0; i < 6; ++i)
+        queue.Push(0, 0, 1.0f, i, 1);
+    queue.Sort();
+
+    // 两段分别提交：每段都从未绑定状态开始，合并后的计数等于两段之和
+    RenderQueueRecorder first, second;
+    RenderQueue::Stats firstStats, secondStats;
+    queue.SubmitRange(first, 0, 3, firstStats);
+    queue.SubmitRange(second, 3, 3, secondStats);
+    CHECK(first.GetCommands().size() == 5 && second.GetCommands().size() == 5);
+    CHECK(second.GetCommands()[2].firstInstance == 3);
+    queue.AddSubmitStats(firstStats);
+    queue.AddSubmitStats(secondStats);
+    CHECK(queue.GetStats().items == 6);
+    CHECK(queue.GetStats().meshBinds == 2);
+    CHECK(queue.GetStats().BindsAvoided() == 8);
+}
+
+TEST_CASE(ClearKeepsNothingFromPreviousFrame)
+{
+    RenderQueue queue;
+    queue.Push(1, 0, 1.0f, 0, 1);
+    RenderQueueRecorder recorder;
+    queue.Submit(recorder);
+    queue.Clear();
+    CHECK(queue.GetItems().empty());
+    CHECK(queue.GetStats().items == 0 && queue.GetStats().Binds() == 0);
+}
+
+TEST_MAIN()
@@ -0,0 +1,96 @@
+//***************************************************************************************
+// SceneRendererBench.cpp
+//
+// 整帧 CPU 开销：每帧推进 ForestScene 一步，再用 SceneRenderer::Render 提交到 NullRenderDevice，
+// 不同 N 下报告每帧的 CPU 毫秒数，空设备统计的每帧调用次数和写入字节数，
+// 以及 FrameStats 统计的上传字节（常量缓冲不随物体数变化，增长的只有实例数据）。
+// 场景见 TestScene.h。
+// 分别在当前线程和任务系统上准备帧（后者同时并行录制命令列表）。
+// 用法：SceneRendererBench [-quick]
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestScene.h"
+#include "NullRenderDevice.h"
+#include <cstdio>
+
+namespace
+{
+    const float kStepSeconds = 1.0f / 120.0f;
+
+    struct Result
+    {
+        double msPerFrame = 0.0;
+        FrameStats frame;           // 最后一帧
+        RenderDeviceStats device;   // 每帧平均（计数向下取整）
+    };
+
+    Result Run(int n, int frames, JobSystem* pJobSystem)
+    {
+        GeometryPool pool;
+        TestScene::BuildPool(pool);
+        NullRenderDevice device;
+        SceneRenderer renderer;
+        renderer.Init(&device, &pool, ForestScene::kGlyphCount);
+        renderer.SetJobSystem(pJobSystem);
+
+        ForestScene scene;
+        scene.Init();
+        scene.GetParams().n = n;
+        const SceneView view = TestScene::MakeAutoFitView(scene.GetParams());
+
+        // 第一帧建立八叉树和缓冲，不计入
+        scene.Update(kStepSeconds);
+        renderer.Render(scene, view);
+        device.Present();
+        device.ResetStats();
+
+        TestCommon::BenchTimer timer;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            scene.Update(kStepSeconds);
+            renderer.Render(scene, view);
+            device.Present();
+        }
+        Result result;
+        result.msPerFrame = timer.GetSeconds() * 1000.0 / frames;
+        result.frame = renderer.GetLastFrameStats();
+
+        const RenderDeviceStats& total = device.GetStats();
+        result.device.drawCalls = total.drawCalls / frames;
+        result.device.bufferWrites = total.bufferWrites / frames;
+        result.device.bytesWritten = total.bytesWritten / frames;
+        result.device.vertexBufferBinds = total.vertexBufferBinds / frames;
+        result.device.constantBufferBinds = total.constantBufferBinds / frames;
+        result.device.instancesDrawn = total.instancesDrawn / frames;
+        TestCommon::KeepAlive(result.frame.instanceCount);
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    const std::vector<int> sizes = quick ? std::vector<int>{ 5, 10 } : std::vector<int>{ 5, 10, 20, 40 };
+    const int frames = quick ? 5 : 120;
+    JobSystem jobSystem;
+
+    printf("每帧：推进一步 + Render（NullRenderDevice），%d 帧取平均\n", frames);
+    printf("%-6s %4s | %9s %9s %6s | %6s %7s %7s %10s %8s %8s | %8s %10s %10s\n", "准备", "N", "ms/帧", "实例",
+        "剔除", "绘制", "Map", "VB绑定", "写入 KB", "CB绑定", "命令列表", "常量 B", "实例 KB", "上传 KB");
+    for (int n : sizes)
+    {
+        for (int useJobs = 0; useJobs < 2; ++useJobs)
+        {
+            const Result r = Run(n, frames, useJobs ? &jobSystem : nullptr);
+            printf("%-6s %4d | %9.3f %9u %6u | %6u %7u %7u %10.1f %8u %8u | %8llu %10.1f %10.1f\n",
+                useJobs ? "任务" : "单线程", n,
+                r.msPerFrame, r.frame.instanceCount, r.frame.cellsCulled + r.frame.cellsOccluded,
+                r.device.drawCalls, r.device.bufferWrites, r.device.vertexBufferBinds,
+                r.device.bytesWritten / 1024.0, r.device.constantBufferBinds, r.frame.commandLists,
+                static_cast<unsigned long long>(r.frame.constantBytes), r.frame.instanceBytes / 1024.0,
+                r.frame.UploadedBytes() / 1024.0);
+        }
+    }
+    return 0;
+}
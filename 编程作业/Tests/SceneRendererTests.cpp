@@ -0,0 +1,68 @@
+//***************************************************************************************
+// SceneRendererTests.cpp
+//
+// 常量缓冲拆分后的上传量：每帧的常量字节只有一份 CBPerFrame 和每个对象（字符森林、玩家）一份 CBPerObject，
+// 与单元数和实例数无关；实例数据随实例数线性增长。常量环形缓冲和逐对象 Map 两条路径都检查，
+// 并且 FrameStats 统计的上传字节与 NullRenderDevice 实际写入的字节一致。场景见 TestScene.h。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestScene.h"
+#include "NullRenderDevice.h"
+
+namespace
+{
+    struct FrameResult
+    {
+        FrameStats frame;
+        RenderDeviceStats device;
+    };
+
+    // 渲染两帧，返回第二帧（第一帧建立八叉树和缓冲）
+    FrameResult RenderSecondFrame(int n, bool constantOffsets)
+    {
+        GeometryPool pool;
+        TestScene::BuildPool(pool);
+        NullRenderDevice device;
+        device.SetSupportsConstantBufferOffsets(constantOffsets);
+        SceneRenderer renderer;
+        renderer.Init(&device, &pool, ForestScene::kGlyphCount);
+
+        ForestScene scene;
+        scene.Init();
+        scene.GetParams().n = n;
+        const SceneView view = TestScene::MakeAutoFitView(scene.GetParams());
+        renderer.Render(scene, view);
+        device.Present();
+
+        device.ResetStats();
+        scene.Update(1.0f / 120.0f);
+        renderer.Render(scene, view);
+        return { renderer.GetLastFrameStats(), device.GetStats() };
+    }
+}
+
+TEST_CASE(ConstantBytesDoNotDependOnObjectCount)
+{
+    const uint64_t expected = sizeof(CBPerFrame) + 2 * sizeof(CBPerObject);
+    const int sizes[] = { 1, 4, 10, 20 };
+    for (int constantOffsets = 0; constantOffsets < 2; ++constantOffsets)
+    {
+        uint32_t previousInstances = 0;
+        for (int n : sizes)
+        {
+            const FrameResult r = RenderSecondFrame(n, constantOffsets != 0);
+            CHECK(r.frame.constantBytes == expected);
+            // 环形缓冲：每帧一次 CBPerFrame、一次对象常量；逐对象 Map：每个对象一次
+            CHECK(r.frame.constantUploads == (constantOffsets ? 2u : 3u));
+            CHECK(r.frame.instanceBytes == uint64_t(r.frame.instanceCount) * sizeof(InstanceData));
+            CHECK(r.frame.instanceCount > previousInstances);
+            previousInstances = r.frame.instanceCount;
+
+            // 统计与设备实际写入的一致：每帧的写入只有常量和实例
+            CHECK(r.device.bytesWritten == r.frame.UploadedBytes());
+        }
+    }
+}
+
+TEST_MAIN()
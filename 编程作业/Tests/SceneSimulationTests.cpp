@@ -0,0 +1,239 @@
+//***************************************************************************************
+// SceneSimulationTests.cpp
+//
+// 固定步长仿真的可重现性：同一段带时间的输入脚本在 FakeClock 上运行两次，
+// 一次每毫秒推进一次，一次不规则地隔很久才推进、一次只补 kMaxStepsPerWake 步，
+// 每一步的 ForestScene 和 SceneView 都必须逐位相同。
+// 输入事件按 SimulationThread::GetInputTick 标上步号，InputState::Drain 只取属于当前步的事件；
+// 不按步号取（补步时第一步就取完）时结果随推进时机变化，作为对照。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "SceneSimulation.h"
+#include "SimulationThread.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    const uint64_t kMs = 1000000;
+    const uint64_t kScriptMs = 1000;
+
+    struct ScriptEvent
+    {
+        uint64_t   timeMs;
+        InputEvent event;
+    };
+
+    InputEvent Key(InputEvent::Type type, uint8_t key)
+    {
+        return InputEvent{ type, key, 0, 0, 0 };
+    }
+
+    // 按下又松开（同一毫秒内也算一次按下沿）
+    void Press(std::vector<ScriptEvent>& script, uint64_t timeMs, uint8_t key, uint64_t holdMs)
+    {
+        script.push_back({ timeMs, Key(InputEvent::KeyDown, key) });
+        script.push_back({ timeMs + holdMs, Key(InputEvent::KeyUp, key) });
+    }
+
+    // 约 1 秒的操作：飞行、调参数、切换到第一人称和第三人称再回到飞行、开关灯和遮挡剔除、请求捕获
+    std::vector<ScriptEvent> MakeScript()
+    {
+        std::vector<ScriptEvent> script;
+        for (uint64_t t = 5; t < 950; t += 7)
+        {
+            int32_t x = static_cast<int32_t>(t * 3 % 640);
+            int32_t y = static_cast<int32_t>(t % 97);
+            script.push_back({ t, InputEvent{ InputEvent::MouseMove, 0, x, y, 0 } });
+        }
+        Press(script, 20, 'W', 230);
+        Press(script, 260, kKeyOemPlus, 0);
+        Press(script, 265, kKeyOem6, 3);
+        script.push_back({ 300, Key(InputEvent::KeyDown, 'D') });
+        Press(script, 330, kKeyShift, 15);
+        Press(script, 335, '1', 5);
+        Press(script, 400, kKeySpace, 50);
+        Press(script, 500, kKeyShift, 10);
+        Press(script, 503, '2', 2);
+        Press(script, 600, 'O', 1);
+        Press(script, 610, kKeyF9, 9);
+        Press(script, 650, '1', 4);
+        Press(script, 700, kKeyShift, 20);
+        Press(script, 705, '3', 10);
+        Press(script, 720, 'Q', 80);
+        script.push_back({ 900, Key(InputEvent::KeyUp, 'D') });
+        return script;
+    }
+
+    // 每一步结束时的状态
+    struct StepState
+    {
+        uint64_t     tick;
+        ForestParams params;
+        std::array<Light, 3> lights;
+        double       totalTime;
+        SceneView    view;
+        CameraMode   cameraMode;
+        bool         occlusionCulling;
+        uint32_t     captureRequests;
+    };
+
+    bool SameState(const StepState& a, const StepState& b)
+    {
+        return a.tick == b.tick
+            && a.params.n == b.params.n && a.params.spacing == b.params.spacing
+            && a.params.orbitRadius == b.params.orbitRadius
+            && a.params.orbitMin == b.params.orbitMin && a.params.orbitMax == b.params.orbitMax
+            && memcmp(a.lights.data(), b.lights.data(), sizeof(a.lights)) == 0
+            && a.totalTime == b.totalTime
+            && memcmp(&a.view.view, &b.view.view, sizeof(a.view.view)) == 0
+            && memcmp(&a.view.proj, &b.view.proj, sizeof(a.view.proj)) == 0
+            && memcmp(&a.view.playerWorld, &b.view.playerWorld, sizeof(a.view.playerWorld)) == 0
+            && memcmp(&a.view.eyePos, &b.view.eyePos, sizeof(a.view.eyePos)) == 0
+            && a.view.drawPlayer == b.view.drawPlayer
+            && a.cameraMode == b.cameraMode
+            && a.occlusionCulling == b.occlusionCulling
+            && a.captureRequests == b.captureRequests;
+    }
+
+    bool SameTrace(const std::vector<StepState>& a, const std::vector<StepState>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (!SameState(a[i], b[i]))
+                return false;
+        }
+        return true;
+    }
+
+    struct RunResult
+    {
+        std::vector<StepState> trace;
+        int maxStepsPerPump = 0;
+        uint64_t droppedSteps = 0;
+    };
+
+    // pumpGapMs 返回第 i 次推进后隔多少毫秒再推进；drainAll 为 true 时忽略事件的步号
+    template <class GapFunction>
+    RunResult RunScript(const std::vector<ScriptEvent>& script, GapFunction pumpGapMs, bool drainAll)
+    {
+        FakeClock clock;
+        SimulationThread simulation(clock);
+        SceneSimulation scene;
+        scene.Init(16.0f / 9.0f);
+        InputQueue queue;
+        InputState input;
+
+        RunResult result;
+        simulation.StartManual([&](uint64_t tick, float dt)
+        {
+            input.BeginTick();
+            input.Drain(queue, drainAll ? UINT64_MAX : tick);
+            scene.Step(input, dt);
+
+            StepState state;
+            state.tick = tick;
+            state.params = scene.GetScene().GetParams();
+            state.lights = scene.GetScene().GetLights();
+            state.totalTime = scene.GetScene().GetTotalTime();
+            state.view = scene.BuildSceneView();
+            state.cameraMode = scene.GetCameraMode();
+            state.occlusionCulling = scene.IsOcclusionCulling();
+            state.captureRequests = scene.GetCaptureRequests();
+            result.trace.push_back(state);
+        }, nullptr, 120.0);
+
+        size_t nextEvent = 0;
+        uint64_t nextPumpMs = 0;
+        int pumpIndex = 0;
+        for (uint64_t t = 0; t <= kScriptMs; ++t)
+        {
+            // 消息线程：此刻发生的事件标上步号后入队
+            for (; nextEvent < script.size() && script[nextEvent].timeMs == t; ++nextEvent)
+            {
+                InputEvent event = script[nextEvent].event;
+                event.tick = simulation.GetInputTick();
+                CHECK(queue.Push(event));
+            }
+            if (t == nextPumpMs)
+            {
+                result.maxStepsPerPump = std::max(result.maxStepsPerPump, simulation.Pump());
+                nextPumpMs = t + pumpGapMs(pumpIndex++);
+            }
+            clock.Advance(kMs);
+        }
+        // 补完剩下的步
+        while (simulation.Pump() > 0)
+        {
+        }
+        result.droppedSteps = simulation.GetDroppedSteps();
+        return result;
+    }
+
+    uint64_t EveryMillisecond(int)
+    {
+        return 1;
+    }
+
+    // 1..45ms 的不规则间隔，大多数时候一次醒来补不完
+    uint64_t Irregular(int index)
+    {
+        return 1 + static_cast<uint64_t>(index * 37 + 11) % 45;
+    }
+}
+
+TEST_CASE(ScriptReplaysBitIdenticallyRegardlessOfPumpTiming)
+{
+    std::vector<ScriptEvent> script = MakeScript();
+    std::stable_sort(script.begin(), script.end(),
+        [](const ScriptEvent& a, const ScriptEvent& b) { return a.timeMs < b.timeMs; });
+
+    RunResult steady = RunScript(script, EveryMillisecond, false);
+    RunResult bursty = RunScript(script, Irregular, false);
+
+    // 1 秒正好 120 步，两次都没有丢步；不规则推进时确实出现过一次补满 kMaxStepsPerWake 步
+    CHECK(steady.trace.size() == 120);
+    CHECK(steady.droppedSteps == 0 && bursty.droppedSteps == 0);
+    CHECK(steady.maxStepsPerPump == 1);
+    CHECK(bursty.maxStepsPerPump == SimulationThread::kMaxStepsPerWake);
+    CHECK(SameTrace(steady.trace, bursty.trace));
+
+    // 脚本确实改变了状态：参数、开关、捕获请求，最后回到飞行视角
+    const StepState& last = steady.trace.back();
+    CHECK(last.params.n == 11);
+    CHECK(last.params.spacing == 5.0f);
+    CHECK(!last.occlusionCulling);
+    CHECK(last.captureRequests == 1);
+    CHECK(last.lights[0].enabled == 0);
+    CHECK(last.cameraMode == CameraMode::FreeFlight);
+    bool visitedFirstPerson = false, visitedThirdPerson = false;
+    for (const StepState& state : steady.trace)
+    {
+        visitedFirstPerson |= state.cameraMode == CameraMode::FirstPerson;
+        visitedThirdPerson |= state.cameraMode == CameraMode::ThirdPerson;
+    }
+    CHECK(visitedFirstPerson && visitedThirdPerson);
+
+    // 同样的推进方式再运行一次，结果也相同（场景初始化不依赖全局随机数）
+    RunResult again = RunScript(script, Irregular, false);
+    CHECK(SameTrace(bursty.trace, again.trace));
+}
+
+// 对照：补步时第一步就把队列取完，事件生效的步随推进时机变化，状态不再相同
+TEST_CASE(DrainingWithoutTicksDependsOnPumpTiming)
+{
+    std::vector<ScriptEvent> script = MakeScript();
+    std::stable_sort(script.begin(), script.end(),
+        [](const ScriptEvent& a, const ScriptEvent& b) { return a.timeMs < b.timeMs; });
+
+    RunResult steady = RunScript(script, EveryMillisecond, true);
+    RunResult bursty = RunScript(script, Irregular, true);
+    CHECK(steady.trace.size() == bursty.trace.size());
+    CHECK(!SameTrace(steady.trace, bursty.trace));
+}
+
+TEST_MAIN()
@@ -0,0 +1,193 @@
+//***************************************************************************************
+// SimulationThreadTests.cpp
+//
+// SimulationThread 的步数与时间：执行的步数等于经过的时间除以步长（向下取整），
+// 一次 Pump 最多执行 kMaxStepsPerWake 步，其余留给下一次而不是丢弃；
+// 落后超过 kMaxBacklogSteps 步时只丢弃多出的整步并计数。
+// 另外检查输入事件的步号和插值系数。时间由 FakeClock 推进，最后用系统时钟跑一次线程模式。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "SimulationThread.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const double kRate = 120.0;
+
+    struct Recorder
+    {
+        std::vector<uint64_t> ticks;
+        std::vector<float> dts;
+        int publishes = 0;
+
+        SimulationThread::StepFunction Step()
+        {
+            return [this](uint64_t tick, float dt) { ticks.push_back(tick); dts.push_back(dt); };
+        }
+
+        SimulationThread::PublishFunction Publish()
+        {
+            return [this]() { ++publishes; };
+        }
+    };
+
+    // 一次推进直到没有到期的步，返回推进次数
+    int PumpAll(SimulationThread& simulation)
+    {
+        int pumps = 0;
+        while (simulation.Pump() > 0)
+            ++pumps;
+        return pumps;
+    }
+}
+
+TEST_CASE(StepCountFollowsElapsedTime)
+{
+    FakeClock clock(5000);
+    SimulationThread simulation(clock);
+    Recorder recorder;
+    simulation.StartManual(recorder.Step(), recorder.Publish(), kRate);
+    const uint64_t stepNs = simulation.GetStepNs();
+    CHECK(stepNs == 8333333);
+
+    // 每次前进 1.7ms 并推进一次，任何时刻的步数都等于 floor(经过时间 / 步长)
+    uint64_t elapsed = 0;
+    bool matched = true;
+    for (int i = 0; i < 2000; ++i)
+    {
+        clock.Advance(1700000);
+        elapsed += 1700000;
+        simulation.Pump();
+        matched &= simulation.GetTickCount() == elapsed / stepNs;
+    }
+    CHECK(matched);
+    CHECK(simulation.GetDroppedSteps() == 0);
+
+    // 步号连续，dt 恒为步长
+    bool consecutive = true, fixedDt = true;
+    for (size_t i = 0; i < recorder.ticks.size(); ++i)
+    {
+        consecutive &= recorder.ticks[i] == i + 1;
+        fixedDt &= recorder.dts[i] == simulation.GetStepSeconds();
+    }
+    CHECK(consecutive && fixedDt);
+    CHECK(recorder.ticks.size() == elapsed / stepNs);
+}
+
+TEST_CASE(PumpRunsAtMostMaxStepsAndCarriesTheRest)
+{
+    FakeClock clock;
+    SimulationThread simulation(clock);
+    Recorder recorder;
+    simulation.StartManual(recorder.Step(), recorder.Publish(), kRate);
+
+    CHECK(simulation.Pump() == 0);
+    CHECK(recorder.publishes == 0);         // 没有执行步时不发布
+
+    // 100ms 到期 12 步：5 + 5 + 2，每批发布一次，没有丢弃
+    clock.Advance(100000000);
+    CHECK(simulation.Pump() == SimulationThread::kMaxStepsPerWake);
+    CHECK(simulation.GetTickCount() == 5);
+    CHECK(recorder.publishes == 1);
+    CHECK(simulation.Pump() == SimulationThread::kMaxStepsPerWake);
+    CHECK(simulation.Pump() == 2);
+    CHECK(simulation.Pump() == 0);
+    CHECK(simulation.GetTickCount() == 12);
+    CHECK(recorder.publishes == 3);
+    CHECK(simulation.GetDroppedSteps() == 0);
+}
+
+TEST_CASE(BacklogBeyondLimitIsDroppedAndCounted)
+{
+    FakeClock clock;
+    SimulationThread simulation(clock);
+    Recorder recorder;
+    simulation.StartManual(recorder.Step(), recorder.Publish(), kRate);
+    const uint64_t stepNs = simulation.GetStepNs();
+
+    // 停顿 3 秒（360 步），只补 kMaxBacklogSteps 步，其余整步丢弃
+    const uint64_t stall = 3000000000ull + stepNs / 2;
+    clock.Advance(stall);
+    const uint64_t due = stall / stepNs;
+    PumpAll(simulation);
+    CHECK(simulation.GetTickCount() == static_cast<uint64_t>(SimulationThread::kMaxBacklogSteps));
+    CHECK(simulation.GetDroppedSteps() == due - SimulationThread::kMaxBacklogSteps);
+
+    // 丢弃后仿真时钟后移整步，不足一步的零头保留：再过 (步长 - 零头) 正好到期下一步
+    clock.Advance(stepNs - stall % stepNs - 1);
+    CHECK(simulation.Pump() == 0);
+    clock.Advance(1);
+    CHECK(simulation.Pump() == 1);
+    CHECK(simulation.GetDroppedSteps() == due - SimulationThread::kMaxBacklogSteps);
+}
+
+TEST_CASE(InputTickIsTheNextStepToRun)
+{
+    FakeClock clock;
+    SimulationThread simulation(clock);
+    CHECK(simulation.GetInputTick() == 0);      // 还没开始：下一次 Drain 立即处理
+
+    Recorder recorder;
+    simulation.StartManual(recorder.Step(), recorder.Publish(), kRate);
+    const uint64_t stepNs = simulation.GetStepNs();
+    CHECK(simulation.GetInputTick() == 1);
+    clock.Advance(stepNs - 1);
+    CHECK(simulation.GetInputTick() == 1);
+    // 第 1 步已经到期：此刻的事件发生在第 1 步的时间之后，属于第 2 步，无论第 1 步是否已经执行
+    clock.Advance(1);
+    CHECK(simulation.GetInputTick() == 2);
+    simulation.Pump();
+    CHECK(simulation.GetInputTick() == 2);
+
+    // 落后时也按时间而不是按已执行的步数标记
+    clock.Advance(stepNs * 20);
+    CHECK(simulation.GetTickCount() == 1);
+    CHECK(simulation.GetInputTick() == 22);
+
+    simulation.Stop();
+    CHECK(simulation.GetInputTick() == 0);
+}
+
+TEST_CASE(InterpolationAlphaFollowsTheClock)
+{
+    FakeClock clock;
+    SimulationThread simulation(clock);
+    CHECK(simulation.GetInterpolationAlpha(0) == 1.0f);
+
+    Recorder recorder;
+    simulation.StartManual(recorder.Step(), recorder.Publish(), kRate);
+    const uint64_t stepNs = simulation.GetStepNs();
+    clock.Advance(stepNs + stepNs / 4);
+    simulation.Pump();
+    CHECK_NEAR(simulation.GetInterpolationAlpha(1), 0.25, 1e-6);
+    CHECK(simulation.GetInterpolationAlpha(2) == 0.0f);
+    clock.Advance(stepNs * 3);
+    CHECK(simulation.GetInterpolationAlpha(1) == 1.0f);
+}
+
+// 线程模式用系统时钟：步数不超过经过的时间，停止后不再增加
+TEST_CASE(ThreadModeStepsWithTheSystemClock)
+{
+    SimulationThread simulation;
+    std::atomic<uint64_t> lastTick{ 0 };
+    std::atomic<int> publishes{ 0 };
+    TestCommon::BenchTimer timer;
+    simulation.Start([&](uint64_t tick, float) { lastTick = tick; }, [&]() { ++publishes; }, kRate);
+    CHECK(simulation.IsRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    simulation.Stop();
+    const double seconds = timer.GetSeconds();
+    CHECK(!simulation.IsRunning());
+
+    const uint64_t ticks = simulation.GetTickCount();
+    CHECK(ticks > 0);
+    CHECK(ticks <= static_cast<uint64_t>(seconds * kRate) + 1);
+    CHECK(lastTick == ticks);
+    CHECK(publishes > 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(simulation.GetTickCount() == ticks);
+}
+
+TEST_MAIN()
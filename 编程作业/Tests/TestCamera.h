@@ -0,0 +1,130 @@
+//***************************************************************************************
+// TestCamera.h
+//
+// 剔除测试与基准共用的相机和单元阵列：不依赖 DirectXMath，
+// 矩阵约定与 XMMatrixLookAtLH * XMMatrixPerspectiveFovLH 相同（行向量、行主序、深度 [0, 1]）。
+// 单元阵列与 ForestScene::BuildCellBounds 的布局相同：n³ 个单元以原点为中心、间距 spacing。
+//***************************************************************************************
+
+#ifndef TESTCAMERA_H
+#define TESTCAMERA_H
+
+#include "FrustumCuller.h"
+#include <cmath>
+#include <cstdint>
+
+namespace TestCamera
+{
+    struct Camera
+    {
+        const char* name;
+        float eye[3];
+        float target[3];
+    };
+
+    inline void Normalize(float v[3])
+    {
+        const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        v[0] /= length;
+        v[1] /= length;
+        v[2] /= length;
+    }
+
+    inline void Cross(const float a[3], const float b[3], float out[3])
+    {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    inline float Dot(const float a[3], const float b[3])
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    // view * proj，y 轴向上
+    inline void MakeViewProj(const float eye[3], const float target[3], float fovY, float aspect,
+        float nearZ, float farZ, float viewProj[16])
+    {
+        const float up[3] = { 0.0f, 1.0f, 0.0f };
+        float zAxis[3] = { target[0] - eye[0], target[1] - eye[1], target[2] - eye[2] };
+        Normalize(zAxis);
+        float xAxis[3];
+        Cross(up, zAxis, xAxis);
+        Normalize(xAxis);
+        float yAxis[3];
+        Cross(zAxis, xAxis, yAxis);
+
+        const float view[16] = {
+            xAxis[0], yAxis[0], zAxis[0], 0.0f,
+            xAxis[1], yAxis[1], zAxis[1], 0.0f,
+            xAxis[2], yAxis[2], zAxis[2], 0.0f,
+            -Dot(xAxis, eye), -Dot(yAxis, eye), -Dot(zAxis, eye), 1.0f };
+
+        const float h = 1.0f / std::tan(fovY * 0.5f);
+        const float w = h / aspect;
+        const float q = farZ / (farZ - nearZ);
+        const float proj[16] = {
+            w,    0.0f, 0.0f,          0.0f,
+            0.0f, h,    0.0f,          0.0f,
+            0.0f, 0.0f, q,             1.0f,
+            0.0f, 0.0f, -q * nearZ,    0.0f };
+
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int col = 0; col < 4; ++col)
+            {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; ++k)
+                    sum += view[row * 4 + k] * proj[k * 4 + col];
+                viewProj[row * 4 + col] = sum;
+            }
+        }
+    }
+
+    inline void MakeViewProj(const Camera& camera, float viewProj[16])
+    {
+        MakeViewProj(camera.eye, camera.target, 0.7854f, 16.0f / 9.0f, 0.5f, 2000.0f, viewProj);
+    }
+
+    // 单元 (ix, iy, iz) 的编号为 (ix * n + iy) * n + iz
+    inline void BuildGrid(int n, float spacing, float radius, SphereSoA& bounds)
+    {
+        const float c = (n - 1) * 0.5f;
+        bounds.Resize(static_cast<size_t>(n) * n * n);
+        size_t cell = 0;
+        for (int ix = 0; ix < n; ++ix)
+        {
+            for (int iy = 0; iy < n; ++iy)
+            {
+                for (int iz = 0; iz < n; ++iz, ++cell)
+                {
+                    bounds.x[cell] = (ix - c) * spacing;
+                    bounds.y[cell] = (iy - c) * spacing;
+                    bounds.z[cell] = (iz - c) * spacing;
+                    bounds.r[cell] = radius;
+                }
+            }
+        }
+    }
+
+    // 与 GameApp 的视角对应的几个典型相机，阵列尺寸为 n * spacing
+    inline void MakeForestCameras(int n, float spacing, Camera cameras[4])
+    {
+        const float extent = n * spacing * 0.5f;
+        const Camera presets[4] = {
+            // 整个阵列在视野内
+            { "AutoFit",     { 0.0f, extent * 0.8f, -extent * 3.0f }, { 0.0f, 0.0f, 0.0f } },
+            // 在阵列内部平视
+            { "FirstPerson", { 0.0f, 0.0f, -extent * 0.5f }, { 0.0f, 0.0f, extent } },
+            // 在角色后上方俯视
+            { "ThirdPerson", { 0.0f, spacing * 2.0f, -extent - spacing * 4.0f }, { 0.0f, 0.0f, -extent * 0.5f } },
+            // 默认的飞行相机：阵列外斜向下看
+            { "FreeFlight",  { extent * 0.3f, extent * 0.6f, -extent * 1.6f }, { 0.0f, -extent * 0.2f, 0.0f } }
+        };
+        for (int i = 0; i < 4; ++i)
+            cameras[i] = presets[i];
+    }
+}
+
+#endif
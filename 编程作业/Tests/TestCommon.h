@@ -0,0 +1,126 @@
+//***************************************************************************************
+// TestCommon.h
+//
+// 测试与基准程序共用的最小框架：TEST_CASE 注册测试，CHECK 系列宏记录失败并继续执行，
+// TEST_MAIN 依次运行全部测试，有失败时返回非零。
+// 基准程序用 BenchTimer 计时；命令行带 -quick 时只跑小规模，供 ctest 冒烟运行。
+//***************************************************************************************
+
+#ifndef TESTCOMMON_H
+#define TESTCOMMON_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace TestCommon
+{
+    struct TestCase
+    {
+        const char* name;
+        void (*function)();
+    };
+
+    inline std::vector<TestCase>& GetRegistry()
+    {
+        static std::vector<TestCase> registry;
+        return registry;
+    }
+
+    inline int& GetFailureCount()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, void (*function)())
+        {
+            GetRegistry().push_back({ name, function });
+        }
+    };
+
+    inline void ReportFailure(const char* file, int line, const char* expression)
+    {
+        fprintf(stderr, "%s:%d: 检查失败：%s\n", file, line, expression);
+        ++GetFailureCount();
+    }
+
+    inline int RunAll()
+    {
+        int failedCases = 0;
+        for (const TestCase& test : GetRegistry())
+        {
+            const int before = GetFailureCount();
+            test.function();
+            const bool passed = GetFailureCount() == before;
+            printf("[%s] %s\n", passed ? "通过" : "失败", test.name);
+            if (!passed)
+                ++failedCases;
+        }
+        printf("%zu 个测试，%d 个失败\n", GetRegistry().size(), failedCases);
+        return failedCases == 0 ? 0 : 1;
+    }
+
+    // ==== 基准 ====
+    inline bool IsQuickRun(int argc, char** argv)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "-quick") == 0)
+                return true;
+        }
+        return false;
+    }
+
+    class BenchTimer
+    {
+    public:
+        BenchTimer() : m_Start(std::chrono::steady_clock::now()) {}
+
+        double GetSeconds() const
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point m_Start;
+    };
+
+    // 防止编译器把基准中的计算当作无用代码删除：value 的地址交给一段空的内联汇编，
+    // 编译器必须认为汇编会读取其中的内存，因此计算 value 的代码不能省略
+    template <class T>
+    inline void KeepAlive(const T& value)
+    {
+#if defined(_MSC_VER)
+        static volatile char sink;
+        sink = *reinterpret_cast<const volatile char*>(&value);
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "g"(&value) : "memory");
+#endif
+    }
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static TestCommon::Registrar name##Registrar(#name, name); \
+    static void name()
+
+#define CHECK(expression) \
+    do { if (!(expression)) TestCommon::ReportFailure(__FILE__, __LINE__, #expression); } while (0)
+
+#define CHECK_NEAR(a, b, epsilon) \
+    do { if (!(std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= (epsilon))) \
+        TestCommon::ReportFailure(__FILE__, __LINE__, #a " ≈ " #b); } while (0)
+
+#define TEST_MAIN() \
+    int main() { return TestCommon::RunAll(); }
+
+#endif
@@ -0,0 +1,78 @@
+//***************************************************************************************
+// TestMesh.h
+//
+// 网格处理测试与基准共用的网格：经纬球（顶点为 float3 位置，三角形朝外），
+// 以及按固定种子打乱三角形顺序（模拟 OBJ 面顺序这种与顶点缓存无关的输入）。
+//***************************************************************************************
+
+#ifndef TESTMESH_H
+#define TESTMESH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace TestMesh
+{
+    struct Position
+    {
+        float x, y, z;
+    };
+
+    // 追加一个以 center 为中心的经纬球：stacks 条纬线带、slices 条经线，两极各一个顶点
+    inline void AppendSphere(float cx, float cy, float cz, float radius, uint32_t stacks, uint32_t slices,
+        std::vector<Position>& positions, std::vector<uint16_t>& indices)
+    {
+        const float kPi = 3.14159265f;
+        const uint32_t base = static_cast<uint32_t>(positions.size());
+        positions.push_back({ cx, cy + radius, cz });
+        for (uint32_t i = 1; i < stacks; ++i)
+        {
+            const float phi = kPi * i / stacks;
+            for (uint32_t j = 0; j < slices; ++j)
+            {
+                const float theta = 2.0f * kPi * j / slices;
+                positions.push_back({ cx + radius * std::sin(phi) * std::cos(theta), cy + radius * std::cos(phi),
+                    cz + radius * std::sin(phi) * std::sin(theta) });
+            }
+        }
+        positions.push_back({ cx, cy - radius, cz });
+        const uint32_t south = static_cast<uint32_t>(positions.size()) - 1;
+
+        auto ring = [base, slices](uint32_t i, uint32_t j) { return base + 1 + (i - 1) * slices + j % slices; };
+        auto add = [&indices](uint32_t a, uint32_t b, uint32_t c)
+        {
+            indices.push_back(static_cast<uint16_t>(a));
+            indices.push_back(static_cast<uint16_t>(b));
+            indices.push_back(static_cast<uint16_t>(c));
+        };
+        for (uint32_t j = 0; j < slices; ++j)
+            add(base, ring(1, j + 1), ring(1, j));
+        for (uint32_t i = 1; i + 1 < stacks; ++i)
+        {
+            for (uint32_t j = 0; j < slices; ++j)
+            {
+                add(ring(i, j), ring(i, j + 1), ring(i + 1, j + 1));
+                add(ring(i, j), ring(i + 1, j + 1), ring(i + 1, j));
+            }
+        }
+        for (uint32_t j = 0; j < slices; ++j)
+            add(south, ring(stacks - 1, j), ring(stacks - 1, j + 1));
+    }
+
+    // 按三角形打乱顺序，三角形内的顶点顺序（朝向）不变
+    inline void ShuffleTriangles(std::vector<uint16_t>& indices, uint32_t seed)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        for (size_t t = triangleCount; t > 1; --t)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const size_t other = (seed >> 8) % t;
+            for (int c = 0; c < 3; ++c)
+                std::swap(indices[(t - 1) * 3 + c], indices[other * 3 + c]);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,61 @@
+//***************************************************************************************
+// TestScene.h
+//
+// SceneRenderer 测试与基准共用的场景：四个字和玩家网格用大小不同的经纬球代替（Float 顶点），
+// 相机与 SceneSimulation 的 AutoFit 视角相同，从斜上方看整个立方体。
+//***************************************************************************************
+
+#ifndef TESTSCENE_H
+#define TESTSCENE_H
+
+#include "TestMesh.h"
+#include "SceneRenderer.h"
+#include <algorithm>
+
+namespace TestScene
+{
+    // 网格 0..ForestScene::kGlyphCount-1 为字，kGlyphCount 为玩家
+    inline void BuildPool(GeometryPool& pool)
+    {
+        pool.Clear(kFloatVertexStride);
+        for (int meshId = 0; meshId <= ForestScene::kGlyphCount; ++meshId)
+        {
+            std::vector<TestMesh::Position> positions;
+            std::vector<uint16_t> indices;
+            const uint32_t stacks = 12 + 4 * meshId;
+            TestMesh::AppendSphere(0.0f, 0.0f, 0.0f, 1.0f, stacks, stacks * 2, positions, indices);
+
+            // 位置之后的法线和颜色用位置和常量填充
+            std::vector<float> vertices;
+            vertices.reserve(positions.size() * 10);
+            for (const TestMesh::Position& p : positions)
+            {
+                const float vertex[10] = { p.x, p.y, p.z, p.x, p.y, p.z, 1.0f, 1.0f, 1.0f, 1.0f };
+                vertices.insert(vertices.end(), vertex, vertex + 10);
+            }
+            pool.AddMesh(vertices.data(), static_cast<uint32_t>(positions.size()),
+                indices.data(), static_cast<uint32_t>(indices.size()));
+        }
+    }
+
+    inline SceneView MakeAutoFitView(const ForestParams& params)
+    {
+        using namespace DirectX;
+        const float halfExtent = (params.n - 1) * params.spacing * 0.5f;
+        const float radius = std::max(halfExtent * 1.732051f + 8.0f, 12.0f);
+        const XMVECTOR eyePos = XMVectorSet(0.0f, radius * 0.45f, -radius * 1.3f, 1.0f);
+        const XMMATRIX view = XMMatrixLookAtLH(eyePos, XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        const XMMATRIX proj = XMMatrixPerspectiveFovLH(XM_PIDIV4 * 1.2f, 16.0f / 9.0f, 1.0f,
+            std::max(1000.0f, radius * 6.0f));
+
+        SceneView sceneView;
+        sceneView.view = XMMatrixTranspose(view);
+        sceneView.proj = XMMatrixTranspose(proj);
+        sceneView.playerWorld = XMMatrixTranslation(0.0f, 0.0f, -radius);
+        XMStoreFloat3(&sceneView.eyePos, eyePos);
+        sceneView.drawPlayer = true;
+        return sceneView;
+    }
+}
+
+#endif
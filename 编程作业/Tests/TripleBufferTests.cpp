@@ -0,0 +1,209 @@
+//***************************************************************************************
+// TripleBufferTests.cpp
+//
+// TripleBuffer：没有新数据时 Acquire 返回 false 并继续读同一个槽位；连续发布时读到最后一次；
+// 写入方和读取方的槽位永远不同。再用一个写线程和一个读线程在随机的自旋/睡眠负载下运行，
+// 读到的快照必须完整（内容与序号和校验和一致）、序号不回退，
+// 并且不旧于读取前写入方已经发布完的那一份。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <thread>
+
+namespace
+{
+    const int kPayloadWords = 64;
+
+    struct Snapshot
+    {
+        uint64_t sequence = 0;
+        uint32_t payload[kPayloadWords] = {};
+        uint64_t checksum = 0;
+    };
+
+    uint32_t PayloadWord(uint64_t sequence, int index)
+    {
+        return static_cast<uint32_t>(sequence * 2654435761u) ^ static_cast<uint32_t>(index * 40503);
+    }
+
+    void Fill(Snapshot& snapshot, uint64_t sequence)
+    {
+        snapshot.sequence = sequence;
+        uint64_t checksum = sequence;
+        for (int i = 0; i < kPayloadWords; ++i)
+        {
+            snapshot.payload[i] = PayloadWord(sequence, i);
+            checksum = checksum * 31 + snapshot.payload[i];
+        }
+        snapshot.checksum = checksum;
+    }
+
+    bool IsIntact(const Snapshot& snapshot)
+    {
+        uint64_t checksum = snapshot.sequence;
+        for (int i = 0; i < kPayloadWords; ++i)
+        {
+            if (snapshot.payload[i] != PayloadWord(snapshot.sequence, i))
+                return false;
+            checksum = checksum * 31 + snapshot.payload[i];
+        }
+        return checksum == snapshot.checksum;
+    }
+
+    // 合成负载：大多数时候什么都不做，偶尔自旋一会儿或睡眠几十微秒，使两边的快慢不断交替
+    class SyntheticLoad
+    {
+    public:
+        explicit SyntheticLoad(uint32_t seed) : m_State(seed) {}
+
+        void Run()
+        {
+            const uint32_t r = Next() % 64;
+            if (r < 48)
+                return;
+            if (r < 60)
+            {
+                volatile uint32_t sink = 0;
+                for (uint32_t i = 0; i < (Next() % 2000); ++i)
+                    sink = sink + i;
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(Next() % 50));
+        }
+
+    private:
+        uint32_t Next()
+        {
+            m_State ^= m_State << 13;
+            m_State ^= m_State >> 17;
+            m_State ^= m_State << 5;
+            return m_State;
+        }
+
+        uint32_t m_State;
+    };
+}
+
+TEST_CASE(AcquireWithNothingNewKeepsTheSameSlot)
+{
+    TripleBuffer<int> buffer;
+    const int* initial = &buffer.GetReadBuffer();
+    CHECK(!buffer.Acquire());
+    CHECK(&buffer.GetReadBuffer() == initial);
+
+    buffer.GetWriteBuffer() = 7;
+    buffer.Publish();
+    CHECK(buffer.Acquire());
+    const int* slot = &buffer.GetReadBuffer();
+    CHECK(*slot == 7);
+    for (int i = 0; i < 3; ++i)
+    {
+        CHECK(!buffer.Acquire());
+        CHECK(&buffer.GetReadBuffer() == slot);
+        CHECK(buffer.GetReadBuffer() == 7);
+    }
+}
+
+TEST_CASE(LatestPublishWins)
+{
+    TripleBuffer<int> buffer;
+    for (int value = 1; value <= 5; ++value)
+    {
+        buffer.GetWriteBuffer() = value;
+        buffer.Publish();
+    }
+    CHECK(buffer.GetPublishCount() == 5);
+    CHECK(buffer.Acquire());
+    CHECK(buffer.GetReadBuffer() == 5);
+    CHECK(!buffer.Acquire());
+    CHECK(buffer.GetReadBuffer() == 5);
+
+    // 读取方拿着旧数据时继续发布，下一次 Acquire 仍然得到最新的
+    buffer.GetWriteBuffer() = 6;
+    buffer.Publish();
+    buffer.GetWriteBuffer() = 7;
+    buffer.Publish();
+    CHECK(buffer.GetReadBuffer() == 5);
+    CHECK(buffer.Acquire());
+    CHECK(buffer.GetReadBuffer() == 7);
+}
+
+TEST_CASE(WriterAndReaderNeverShareASlot)
+{
+    TripleBuffer<int> buffer;
+    for (int i = 0; i < 64; ++i)
+    {
+        // 按不同的节奏交替发布和获取
+        buffer.GetWriteBuffer() = i;
+        buffer.Publish();
+        CHECK(&buffer.GetWriteBuffer() != &buffer.GetReadBuffer());
+        if (i % 3 != 1)
+            buffer.Acquire();
+        CHECK(&buffer.GetWriteBuffer() != &buffer.GetReadBuffer());
+    }
+}
+
+// ==== 两个线程 ====
+TEST_CASE(ConcurrentReaderSeesIntactLatestSnapshots)
+{
+    const uint64_t kPublishes = 20000;
+    TripleBuffer<Snapshot> buffer;
+    std::atomic<uint64_t> lastPublished{ 0 };
+    std::atomic<bool> done{ false };
+
+    std::thread writer([&]()
+    {
+        SyntheticLoad load(12345);
+        for (uint64_t sequence = 1; sequence <= kPublishes; ++sequence)
+        {
+            Fill(buffer.GetWriteBuffer(), sequence);
+            buffer.Publish();
+            lastPublished.store(sequence, std::memory_order_release);
+            load.Run();
+        }
+        done = true;
+    });
+
+    SyntheticLoad load(67890);
+    uint64_t previous = 0;
+    uint64_t acquired = 0;
+    uint64_t torn = 0, backwards = 0, stale = 0, repeated = 0;
+    for (;;)
+    {
+        const bool finished = done.load();
+        // 在 Acquire 之前已经发布完的序号，读到的快照不能比它旧
+        const uint64_t published = lastPublished.load(std::memory_order_acquire);
+        const bool fresh = buffer.Acquire();
+        const Snapshot& snapshot = buffer.GetReadBuffer();
+        if (published > 0 && !IsIntact(snapshot))
+            ++torn;
+        if (snapshot.sequence < previous)
+            ++backwards;
+        if (snapshot.sequence < published)
+            ++stale;
+        if (fresh)
+        {
+            // 换到的一定是没读过的新数据
+            if (snapshot.sequence <= previous)
+                ++repeated;
+            ++acquired;
+        }
+        previous = snapshot.sequence;
+        if (finished)
+            break;
+        load.Run();
+    }
+    writer.join();
+
+    CHECK(torn == 0);
+    CHECK(backwards == 0);
+    CHECK(stale == 0);
+    CHECK(repeated == 0);
+    CHECK(acquired > 0);
+    CHECK(previous == kPublishes);      // 写线程结束后读到的是最后一次发布
+    CHECK(buffer.GetPublishCount() == kPublishes);
+}
+
+TEST_MAIN()
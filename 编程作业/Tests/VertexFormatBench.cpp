@@ -0,0 +1,75 @@
+//***************************************************************************************
+// VertexFormatBench.cpp
+//
+// Float 与 Packed 两种顶点格式的对比：经纬球网格（顶点缓存优化后）按 FIFO 缓存模拟估计
+// 每帧顶点着色器读取的字节数（未命中次数 × 步长 × 实例数），以及 CPU 压缩 / 还原的吞吐量和误差。
+// 用法：VertexFormatBench [-quick]
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "TestMesh.h"
+#include "MeshOptimizer.h"
+#include "VertexFormat.h"
+
+using namespace DirectX;
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestCommon::IsQuickRun(argc, argv);
+    // 与一个字形网格的规模相当；实例数对应 n = 10 和 n = 50 的字符立方体
+    const uint32_t stacks = 24;
+    const uint32_t slices = 48;
+    const uint32_t instanceCounts[] = { 1000, 125000 };
+    const int repeats = quick ? 1 : 2000;
+
+    std::vector<TestMesh::Position> positions;
+    std::vector<uint16_t> indices;
+    TestMesh::AppendSphere(0.0f, 0.0f, 0.0f, 1.0f, stacks, slices, positions, indices);
+    const uint32_t vertexCount = static_cast<uint32_t>(positions.size());
+    const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+    MeshOptimizer::OptimizeVertexCache(indices.data(), indices.data(), indexCount, vertexCount);
+    const VertexCacheStats cache = MeshOptimizer::AnalyzeVertexCache(indices.data(), indexCount, vertexCount);
+
+    // 球面上的法线就是位置方向，颜色取两位小数
+    std::vector<FloatVertex> vertices(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+        const TestMesh::Position& p = positions[i];
+        vertices[i].pos = XMFLOAT3(p.x, p.y, p.z);
+        vertices[i].normal = XMFLOAT3(p.x, p.y, p.z);
+        const float c = static_cast<float>(i % 101) / 100.0f;
+        vertices[i].color = XMFLOAT4(c, 1.0f - c, 0.5f, 1.0f);
+    }
+
+    printf("网格：%u 个顶点，%u 个三角形，ACMR %.3f\n", vertexCount, indexCount / 3, cache.acmr);
+    printf("%10s %16s %16s %8s\n", "实例数", "Float MB/帧", "Packed MB/帧", "比例");
+    for (uint32_t instances : instanceCounts)
+    {
+        const double floatBytes = double(cache.transformedVertices) * GetVertexStride(VertexFormat::Float) * instances;
+        const double packedBytes = double(cache.transformedVertices) * GetVertexStride(VertexFormat::Packed) * instances;
+        printf("%10u %16.1f %16.1f %8.2f\n", instances, floatBytes / 1048576.0, packedBytes / 1048576.0,
+            packedBytes / floatBytes);
+    }
+
+    std::vector<PackedVertex> packed;
+    PositionDecode decode;
+    TestCommon::BenchTimer packTimer;
+    for (int r = 0; r < repeats; ++r)
+        PackVertices(vertices.data(), vertexCount, packed, decode);
+    const double packSeconds = packTimer.GetSeconds() / repeats;
+
+    std::vector<FloatVertex> unpacked(vertexCount);
+    TestCommon::BenchTimer unpackTimer;
+    for (int r = 0; r < repeats; ++r)
+    {
+        for (uint32_t i = 0; i < vertexCount; ++i)
+            UnpackVertex(packed[i], decode, unpacked[i]);
+    }
+    const double unpackSeconds = unpackTimer.GetSeconds() / repeats;
+    TestCommon::KeepAlive(unpacked);
+
+    const PackError error = MeasurePackError(vertices.data(), packed.data(), vertexCount, decode);
+    printf("压缩 %.1f M 顶点/s，还原 %.1f M 顶点/s\n", vertexCount / packSeconds / 1e6, vertexCount / unpackSeconds / 1e6);
+    printf("误差：位置 %.2e，法线 %.4f°，颜色 %.4f\n", error.position, XMConvertToDegrees(error.normal), error.color);
+    return 0;
+}
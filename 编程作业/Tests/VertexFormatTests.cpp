@@ -0,0 +1,203 @@
+//***************************************************************************************
+// VertexFormatTests.cpp
+//
+// Packed 顶点格式的往返误差：位置不超过包围盒尺寸 / 65535 的一半（每轴），
+// 八面体编码的法线夹角误差有上界且坐标轴方向精确还原，颜色不超过 0.5 / 255（两位小数的颜色也一样）；
+// 以及不能压缩的网格保持 Float、包围盒某一轴厚度为 0 时的还原和两种格式的字节数。
+//***************************************************************************************
+
+#include "TestCommon.h"
+#include "VertexFormat.h"
+#include <cmath>
+#include <vector>
+
+using namespace DirectX;
+
+namespace
+{
+    // 16 位八面体编码的最大夹角误差约 3e-5 弧度，留出余量
+    const float kMaxNormalError = 1e-4f;
+    const float kMaxColorError = 0.5f / 255.0f + 1e-6f;
+
+    uint32_t g_Seed = 1;
+
+    float Random01()
+    {
+        g_Seed = g_Seed * 1664525u + 1013904223u;
+        return (g_Seed >> 8) / 16777216.0f;
+    }
+
+    XMFLOAT3 RandomUnitVector()
+    {
+        for (;;)
+        {
+            float x = Random01() * 2.0f - 1.0f, y = Random01() * 2.0f - 1.0f, z = Random01() * 2.0f - 1.0f;
+            float length = std::sqrt(x * x + y * y + z * z);
+            if (length > 0.1f && length <= 1.0f)
+                return XMFLOAT3(x / length, y / length, z / length);
+        }
+    }
+
+    float Angle(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        float cx = a.y * b.z - a.z * b.y, cy = a.z * b.x - a.x * b.z, cz = a.x * b.y - a.y * b.x;
+        return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), a.x * b.x + a.y * b.y + a.z * b.z);
+    }
+
+    std::vector<FloatVertex> RandomVertices(uint32_t count, float extent)
+    {
+        std::vector<FloatVertex> vertices(count);
+        for (FloatVertex& v : vertices)
+        {
+            v.pos = XMFLOAT3((Random01() - 0.5f) * extent, (Random01() - 0.5f) * extent * 0.5f, Random01() * extent * 0.1f);
+            v.normal = RandomUnitVector();
+            v.color = XMFLOAT4(Random01(), Random01(), Random01(), Random01());
+        }
+        return vertices;
+    }
+}
+
+// ==== 单个属性 ====
+TEST_CASE(OctahedralRoundTripErrorIsBounded)
+{
+    g_Seed = 11;
+    float maxError = 0.0f;
+    for (int i = 0; i < 100000; ++i)
+    {
+        XMFLOAT3 n = RandomUnitVector();
+        int16_t encoded[2];
+        EncodeOctahedral(n, encoded);
+        XMFLOAT3 decoded = DecodeOctahedral(encoded);
+        CHECK_NEAR(decoded.x * decoded.x + decoded.y * decoded.y + decoded.z * decoded.z, 1.0, 1e-5);
+        maxError = std::max(maxError, Angle(n, decoded));
+    }
+    CHECK(maxError <= kMaxNormalError);
+}
+
+TEST_CASE(OctahedralAxesAreExact)
+{
+    const XMFLOAT3 axes[] = { XMFLOAT3(1, 0, 0), XMFLOAT3(-1, 0, 0), XMFLOAT3(0, 1, 0),
+        XMFLOAT3(0, -1, 0), XMFLOAT3(0, 0, 1), XMFLOAT3(0, 0, -1) };
+    for (const XMFLOAT3& axis : axes)
+    {
+        int16_t encoded[2];
+        EncodeOctahedral(axis, encoded);
+        XMFLOAT3 decoded = DecodeOctahedral(encoded);
+        CHECK_NEAR(decoded.x, axis.x, 1e-6);
+        CHECK_NEAR(decoded.y, axis.y, 1e-6);
+        CHECK_NEAR(decoded.z, axis.z, 1e-6);
+    }
+}
+
+// ==== 整个网格 ====
+TEST_CASE(PackedMeshRoundTripErrorIsBounded)
+{
+    g_Seed = 5;
+    const float kExtent = 20.0f;
+    std::vector<FloatVertex> vertices = RandomVertices(5000, kExtent);
+    std::vector<PackedVertex> packed;
+    PositionDecode decode;
+    CHECK(PackVertices(vertices.data(), static_cast<uint32_t>(vertices.size()), packed, decode));
+    CHECK(packed.size() == vertices.size());
+
+    // 每轴误差不超过半个量化步长（加上浮点舍入）
+    float maxAxisError[3] = { 0.0f, 0.0f, 0.0f };
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        FloatVertex v;
+        UnpackVertex(packed[i], decode, v);
+        maxAxisError[0] = std::max(maxAxisError[0], std::fabs(v.pos.x - vertices[i].pos.x));
+        maxAxisError[1] = std::max(maxAxisError[1], std::fabs(v.pos.y - vertices[i].pos.y));
+        maxAxisError[2] = std::max(maxAxisError[2], std::fabs(v.pos.z - vertices[i].pos.z));
+    }
+    for (int axis = 0; axis < 3; ++axis)
+        CHECK(maxAxisError[axis] <= decode.scale[axis] / 65535.0f * 0.5f + 2e-6f * kExtent);
+
+    PackError error = MeasurePackError(vertices.data(), packed.data(), static_cast<uint32_t>(vertices.size()), decode);
+    const float step = std::sqrt(decode.scale[0] * decode.scale[0] + decode.scale[1] * decode.scale[1] +
+        decode.scale[2] * decode.scale[2]) / 65535.0f;
+    CHECK(error.position <= step * 0.5f + 4e-6f * kExtent);
+    CHECK(error.normal <= kMaxNormalError);
+    CHECK(error.color <= kMaxColorError);
+}
+
+TEST_CASE(TwoDecimalColorsRoundTrip)
+{
+    // 字形的颜色是两位小数
+    std::vector<FloatVertex> vertices;
+    for (int i = 0; i <= 100; ++i)
+    {
+        FloatVertex v;
+        v.pos = XMFLOAT3(static_cast<float>(i), 0.0f, 0.0f);
+        v.normal = XMFLOAT3(0.0f, 0.0f, 1.0f);
+        float c = i / 100.0f;
+        v.color = XMFLOAT4(c, 1.0f - c, c * 0.5f, 1.0f);
+        vertices.push_back(v);
+    }
+    std::vector<PackedVertex> packed;
+    PositionDecode decode;
+    CHECK(PackVertices(vertices.data(), static_cast<uint32_t>(vertices.size()), packed, decode));
+    PackError error = MeasurePackError(vertices.data(), packed.data(), static_cast<uint32_t>(vertices.size()), decode);
+    CHECK(error.color <= kMaxColorError);
+    CHECK(error.normal <= 1e-6f);
+}
+
+TEST_CASE(FlatAxisRoundTripsExactly)
+{
+    g_Seed = 3;
+    std::vector<FloatVertex> vertices = RandomVertices(100, 4.0f);
+    for (FloatVertex& v : vertices)
+        v.pos.z = 2.5f;
+    std::vector<PackedVertex> packed;
+    PositionDecode decode;
+    CHECK(PackVertices(vertices.data(), static_cast<uint32_t>(vertices.size()), packed, decode));
+    CHECK(decode.scale[2] == 0.0f);
+    CHECK(decode.offset[2] == 2.5f);
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        FloatVertex v;
+        UnpackVertex(packed[i], decode, v);
+        CHECK(v.pos.z == 2.5f);
+    }
+}
+
+TEST_CASE(UnpackableMeshesStayFloat)
+{
+    g_Seed = 9;
+    const std::vector<FloatVertex> good = RandomVertices(10, 1.0f);
+    CHECK(CanPackVertices(good.data(), 10));
+
+    std::vector<FloatVertex> brightColor = good;
+    brightColor[3].color.x = 1.5f;
+    std::vector<FloatVertex> shortNormal = good;
+    shortNormal[4].normal = XMFLOAT3(0.0f, 0.5f, 0.0f);
+    std::vector<FloatVertex> notFinite = good;
+    notFinite[5].pos.y = std::nanf("");
+    const std::vector<FloatVertex>* rejected[] = { &brightColor, &shortNormal, &notFinite };
+    for (const std::vector<FloatVertex>* pVertices : rejected)
+    {
+        std::vector<PackedVertex> packed(2);
+        PositionDecode decode;
+        CHECK(!CanPackVertices(pVertices->data(), 10));
+        CHECK(!PackVertices(pVertices->data(), 10, packed, decode));
+        CHECK(packed.size() == 2);
+    }
+
+    std::vector<PackedVertex> packed;
+    PositionDecode decode;
+    CHECK(!PackVertices(good.data(), 0, packed, decode));
+}
+
+// ==== 字节数 ====
+TEST_CASE(PackedVerticesAreFortyPercentOfFloat)
+{
+    CHECK(GetVertexStride(VertexFormat::Float) == 40);
+    CHECK(GetVertexStride(VertexFormat::Packed) == 16);
+    // 同一网格每帧读取的顶点字节数按步长成比例
+    const uint64_t vertices = 2000, instances = 1000;
+    const uint64_t floatBytes = vertices * instances * GetVertexStride(VertexFormat::Float);
+    const uint64_t packedBytes = vertices * instances * GetVertexStride(VertexFormat::Packed);
+    CHECK(packedBytes * 5 == floatBytes * 2);
+}
+
+TEST_MAIN()
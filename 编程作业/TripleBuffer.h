@@ -0,0 +1,61 @@
+//***************************************************************************************
+// TripleBuffer.h
+//
+// 无锁三缓冲：一个线程写入、另一个线程读取最新的一份完整数据。
+// 三个槽位分别归写入方、读取方和中间交换位所有，发布和获取都只是一次原子交换，
+// 双方都不会等待对方；写入方更快时，还没被取走的旧数据直接被新数据替换。
+//***************************************************************************************
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+template <class T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // ==== 写入方 ====
+    // 当前可写的槽位，内容是之前某次发布的旧数据，需要整体覆盖
+    T& GetWriteBuffer() { return m_Slots[m_WriteIndex]; }
+    // 把写好的槽位换到中间位并标记为新数据，换回来的槽位供下次写入
+    void Publish()
+    {
+        uint32_t previous = m_Middle.exchange(m_WriteIndex | kFreshBit, std::memory_order_acq_rel);
+        m_WriteIndex = previous & kIndexMask;
+        m_PublishCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // ==== 读取方 ====
+    // 有新数据时把中间位换过来，返回是否换到了新数据；没有新数据时继续读上一份
+    bool Acquire()
+    {
+        if ((m_Middle.load(std::memory_order_relaxed) & kFreshBit) == 0)
+            return false;
+        uint32_t previous = m_Middle.exchange(m_ReadIndex, std::memory_order_acq_rel);
+        m_ReadIndex = previous & kIndexMask;
+        return true;
+    }
+    const T& GetReadBuffer() const { return m_Slots[m_ReadIndex]; }
+
+    // 累计发布次数（统计用，任意线程可读）
+    uint64_t GetPublishCount() const { return m_PublishCount.load(std::memory_order_relaxed); }
+
+private:
+    static const uint32_t kIndexMask = 3;
+    static const uint32_t kFreshBit = 4;       // 中间位的数据还没被读取方取走
+
+    T m_Slots[3];
+    uint32_t m_WriteIndex = 0;                  // 只由写入方访问
+    uint32_t m_ReadIndex = 2;                   // 只由读取方访问
+    std::atomic<uint32_t> m_Middle{ 1 };
+    std::atomic<uint64_t> m_PublishCount{ 0 };
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include "VertexFormat.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace DirectX;
+
+static const float kUnorm16Max = 65535.0f;
+static const float kSnorm16Max = 32767.0f;
+static const float kUnorm8Max = 255.0f;
+// 法线长度与 1 相差超过这个值时视为不是单位向量
+static const float kNormalLengthTolerance = 1e-3f;
+
+// 0 按正号处理，八面体折叠时 0 分量也要落到确定的一侧
+static float SignNotZero(float v)
+{
+    return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+static int16_t ToSnorm16(float v)
+{
+    v = std::max(-1.0f, std::min(1.0f, v));
+    return static_cast<int16_t>(std::lround(v * kSnorm16Max));
+}
+
+static float FromSnorm16(int16_t v)
+{
+    // 与 D3D 的 SNORM 转换一致：-32768 和 -32767 都是 -1
+    return std::max(static_cast<float>(v) / kSnorm16Max, -1.0f);
+}
+
+static uint16_t ToUnorm16(float v)
+{
+    v = std::max(0.0f, std::min(1.0f, v));
+    return static_cast<uint16_t>(std::lround(v * kUnorm16Max));
+}
+
+static uint8_t ToUnorm8(float v)
+{
+    v = std::max(0.0f, std::min(1.0f, v));
+    return static_cast<uint8_t>(std::lround(v * kUnorm8Max));
+}
+
+// ==== 八面体编码：单位球投影到 |x|+|y|+|z|=1 的八面体，下半部分沿对角线折到上半部分 ====
+void EncodeOctahedral(const XMFLOAT3& normal, int16_t encoded[2])
+{
+    float l1 = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    float x = normal.x / l1;
+    float y = normal.y / l1;
+    if (normal.z < 0.0f)
+    {
+        float fx = (1.0f - std::fabs(y)) * SignNotZero(x);
+        float fy = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = fx;
+        y = fy;
+    }
+    encoded[0] = ToSnorm16(x);
+    encoded[1] = ToSnorm16(y);
+}
+
+XMFLOAT3 DecodeOctahedral(const int16_t encoded[2])
+{
+    // 与 Cube_VS_Packed.hlsl 中的 DecodeOctahedral 相同
+    float x = FromSnorm16(encoded[0]);
+    float y = FromSnorm16(encoded[1]);
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+    float length = std::sqrt(x * x + y * y + z * z);
+    return XMFLOAT3(x / length, y / length, z / length);
+}
+
+// ==== 整个网格 ====
+bool CanPackVertices(const FloatVertex* pVertices, uint32_t vertexCount)
+{
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+        const FloatVertex& v = pVertices[i];
+        if (!std::isfinite(v.pos.x) || !std::isfinite(v.pos.y) || !std::isfinite(v.pos.z))
+            return false;
+        // 取反的比较同时排除 NaN
+        float length = std::sqrt(v.normal.x * v.normal.x + v.normal.y * v.normal.y + v.normal.z * v.normal.z);
+        if (!(std::fabs(length - 1.0f) <= kNormalLengthTolerance))
+            return false;
+        const float color[4] = { v.color.x, v.color.y, v.color.z, v.color.w };
+        for (float c : color)
+        {
+            if (!(c >= 0.0f && c <= 1.0f))
+                return false;
+        }
+    }
+    return true;
+}
+
+bool PackVertices(const FloatVertex* pVertices, uint32_t vertexCount,
+    std::vector<PackedVertex>& packed, PositionDecode& decode)
+{
+    if (vertexCount == 0 || !CanPackVertices(pVertices, vertexCount))
+        return false;
+
+    float minPos[3] = { pVertices[0].pos.x, pVertices[0].pos.y, pVertices[0].pos.z };
+    float maxPos[3] = { minPos[0], minPos[1], minPos[2] };
+    for (uint32_t i = 1; i < vertexCount; ++i)
+    {
+        const float pos[3] = { pVertices[i].pos.x, pVertices[i].pos.y, pVertices[i].pos.z };
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            minPos[axis] = std::min(minPos[axis], pos[axis]);
+            maxPos[axis] = std::max(maxPos[axis], pos[axis]);
+        }
+    }
+
+    // 包围盒某一轴厚度为 0 时该轴的量化值都是 0，scale 为 0 也能还原
+    float invExtent[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        float extent = maxPos[axis] - minPos[axis];
+        decode.scale[axis] = extent;
+        decode.offset[axis] = minPos[axis];
+        invExtent[axis] = extent > 0.0f ? 1.0f / extent : 0.0f;
+    }
+    decode.scale[3] = 0.0f;
+    decode.offset[3] = 0.0f;
+
+    packed.resize(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+        const FloatVertex& v = pVertices[i];
+        PackedVertex& p = packed[i];
+        const float pos[3] = { v.pos.x, v.pos.y, v.pos.z };
+        for (int axis = 0; axis < 3; ++axis)
+            p.pos[axis] = ToUnorm16((pos[axis] - minPos[axis]) * invExtent[axis]);
+        p.pos[3] = 0;
+        EncodeOctahedral(v.normal, p.normal);
+        p.color[0] = ToUnorm8(v.color.x);
+        p.color[1] = ToUnorm8(v.color.y);
+        p.color[2] = ToUnorm8(v.color.z);
+        p.color[3] = ToUnorm8(v.color.w);
+    }
+    return true;
+}
+
+void UnpackVertex(const PackedVertex& packed, const PositionDecode& decode, FloatVertex& vertex)
+{
+    vertex.pos.x = packed.pos[0] / kUnorm16Max * decode.scale[0] + decode.offset[0];
+    vertex.pos.y = packed.pos[1] / kUnorm16Max * decode.scale[1] + decode.offset[1];
+    vertex.pos.z = packed.pos[2] / kUnorm16Max * decode.scale[2] + decode.offset[2];
+    vertex.normal = DecodeOctahedral(packed.normal);
+    vertex.color.x = packed.color[0] / kUnorm8Max;
+    vertex.color.y = packed.color[1] / kUnorm8Max;
+    vertex.color.z = packed.color[2] / kUnorm8Max;
+    vertex.color.w = packed.color[3] / kUnorm8Max;
+}
+
+PackError MeasurePackError(const FloatVertex* pVertices, const PackedVertex* pPacked,
+    uint32_t vertexCount, const PositionDecode& decode)
+{
+    PackError error;
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+        const FloatVertex& a = pVertices[i];
+        FloatVertex b;
+        UnpackVertex(pPacked[i], decode, b);
+
+        float dx = a.pos.x - b.pos.x, dy = a.pos.y - b.pos.y, dz = a.pos.z - b.pos.z;
+        error.position = std::max(error.position, std::sqrt(dx * dx + dy * dy + dz * dz));
+
+        // 小角度时 acos 精度不够，用 atan2(|a×b|, a·b)
+        XMFLOAT3 cross;
+        XMStoreFloat3(&cross, XMVector3Cross(XMLoadFloat3(&a.normal), XMLoadFloat3(&b.normal)));
+        float sinAngle = std::sqrt(cross.x * cross.x + cross.y * cross.y + cross.z * cross.z);
+        float cosAngle = a.normal.x * b.normal.x + a.normal.y * b.normal.y + a.normal.z * b.normal.z;
+        error.normal = std::max(error.normal, std::atan2(sinAngle, cosAngle));
+
+        error.color = std::max(error.color, std::fabs(a.color.x - b.color.x));
+        error.color = std::max(error.color, std::fabs(a.color.y - b.color.y));
+        error.color = std::max(error.color, std::fabs(a.color.z - b.color.z));
+        error.color = std::max(error.color, std::fabs(a.color.w - b.color.w));
+    }
+    return error;
+}
@@ -0,0 +1,45 @@
+//***************************************************************************************
+// VertexFormat.h
+//
+// 顶点格式：Float 为 40 字节的 float3 位置 + float3 法线 + float4 颜色，
+// Packed 为 16 字节的压缩格式：
+//   位置  R16G16B16A16_UNORM  相对网格包围盒量化，w 分量不用
+//   法线  R16G16_SNORM        八面体编码
+//   颜色  R8G8B8A8_UNORM
+// 着色器读到的位置在 [0, 1]，乘以 PositionDecode 的 scale 再加 offset 还原为模型空间坐标。
+// 网格在加载时选择格式：颜色超出 [0, 1]、法线不是单位向量或数据不是有限值时保持 Float。
+//***************************************************************************************
+
+#ifndef VERTEXFORMAT_H
+#define VERTEXFORMAT_H
+
+#include "VertexLayout.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// 与 GameApp::VertexPosColor 布局相同
+struct FloatVertex
+{
+    DirectX::XMFLOAT3 pos;
+    DirectX::XMFLOAT3 normal;
+    DirectX::XMFLOAT4 color;
+};
+
+static_assert(sizeof(FloatVertex) == kFloatVertexStride, "FloatVertex 需要与 VertexPosColor 保持一致");
+
+// ==== 单个属性的编码/解码 ====
+// 单位向量的八面体编码，分量为 SNORM16
+void EncodeOctahedral(const DirectX::XMFLOAT3& normal, int16_t encoded[2]);
+DirectX::XMFLOAT3 DecodeOctahedral(const int16_t encoded[2]);
+
+// 颜色都在 [0, 1]、法线都是单位向量且数据都是有限值时才能压缩
+bool CanPackVertices(const FloatVertex* pVertices, uint32_t vertexCount);
+// 按顶点的包围盒量化，packed 调整为 vertexCount 个；不能压缩时返回 false，packed 不变
+bool PackVertices(const FloatVertex* pVertices, uint32_t vertexCount,
+    std::vector<PackedVertex>& packed, PositionDecode& decode);
+void UnpackVertex(const PackedVertex& packed, const PositionDecode& decode, FloatVertex& vertex);
+PackError MeasurePackError(const FloatVertex* pVertices, const PackedVertex* pPacked,
+    uint32_t vertexCount, const PositionDecode& decode);
+
+#endif
@@ -0,0 +1,59 @@
+//***************************************************************************************
+// VertexLayout.h
+//
+// 顶点格式的枚举以及压缩顶点、位置反量化参数的内存布局和压缩误差。
+// 渲染设备接口、捕获回放、网格文件和后台加载只需要这些定义；编码/解码函数和使用 DirectXMath
+// 类型的 FloatVertex 在 VertexFormat.h 中。
+//***************************************************************************************
+
+#ifndef VERTEXLAYOUT_H
+#define VERTEXLAYOUT_H
+
+#include <cassert>
+#include <cstdint>
+
+enum class VertexFormat : uint32_t
+{
+    Float,
+    Packed,
+    Count
+};
+
+struct PackedVertex
+{
+    uint16_t pos[4];
+    int16_t normal[2];
+    uint8_t color[4];
+};
+
+// 位置反量化参数，布局与 HLSL 中的 CBMeshDecode（b2）一致
+struct PositionDecode
+{
+    float scale[4];     // 包围盒尺寸（w 不用）
+    float offset[4];    // 包围盒最小点
+};
+
+// 压缩前后的最大误差
+struct PackError
+{
+    float position = 0.0f;      // 模型空间距离
+    float normal = 0.0f;        // 法线夹角（弧度）
+    float color = 0.0f;         // 单个分量
+};
+
+static const uint32_t kFloatVertexStride = 40;      // float3 位置 + float3 法线 + float4 颜色
+
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex 需要与压缩输入布局保持一致");
+static_assert(sizeof(PositionDecode) % 16 == 0, "PositionDecode 大小需要 16 字节对齐");
+
+inline uint32_t GetVertexStride(VertexFormat format)
+{
+    switch (format)
+    {
+    case VertexFormat::Float: return kFloatVertexStride;
+    case VertexFormat::Packed: return sizeof(PackedVertex);
+    default: assert(false); return 0;
+    }
+}
+
+#endif
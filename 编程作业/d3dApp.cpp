@@ -34,11 +34,17 @@ D3DApp::D3DApp(HINSTANCE hInstance)
 	m_pd3dDevice(nullptr),
 	m_pd3dImmediateContext(nullptr),
 	m_pSwapChain(nullptr),
+	m_SwapChainBufferCount(1),
+	m_SwapChainFlags(0),
+	m_ResolveMsaa(false),
+	m_pBackBuffer(nullptr),
+	m_pMsaaRenderTarget(nullptr),
 	m_pDepthStencilBuffer(nullptr),
 	m_pRenderTargetView(nullptr),
 	m_pDepthStencilView(nullptr)
 {
 	ZeroMemory(&m_ScreenViewport, sizeof(D3D11_VIEWPORT));
+	m_FrameLimiter.SetTargetFrameRate(120.0);
 
 
 	// 让一个全局指针获取这个类，这样我们就可以在Windows消息处理的回调函数
@@ -90,10 +96,13 @@ int D3DApp::Run()
 				CalculateFrameStats();
 				UpdateScene(m_Timer.DeltaTime());
 				DrawScene();
+				// 睡眠加短暂自旋到下一帧的目标时刻，不再空转占满一个核心
+				m_FrameLimiter.Wait();
 			}
 			else
 			{
 				Sleep(100);
+				m_FrameLimiter.Reset();
 			}
 		}
 	}
@@ -101,6 +110,11 @@ int D3DApp::Run()
 	return (int)msg.wParam;
 }
 
+void D3DApp::SetTargetFrameRate(double fps)
+{
+	m_FrameLimiter.SetTargetFrameRate(fps);
+}
+
 bool D3DApp::Init()
 {
 	if (!InitMainWindow())
@@ -129,12 +143,32 @@ void D3DApp::OnResize()
 	m_pRenderTargetView.Reset();
 	m_pDepthStencilView.Reset();
 	m_pDepthStencilBuffer.Reset();
+	m_pMsaaRenderTarget.Reset();
+	m_pBackBuffer.Reset();
 
 	// 重设交换链并且重新创建渲染目标视图
 	ComPtr<ID3D11Texture2D> backBuffer;
-	HR(m_pSwapChain->ResizeBuffers(1, m_ClientWidth, m_ClientHeight, DXGI_FORMAT_R8G8B8A8_UNORM, 0));
+	HR(m_pSwapChain->ResizeBuffers(m_SwapChainBufferCount, m_ClientWidth, m_ClientHeight, DXGI_FORMAT_R8G8B8A8_UNORM, m_SwapChainFlags));
 	HR(m_pSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<void**>(backBuffer.GetAddressOf())));
-	HR(m_pd3dDevice->CreateRenderTargetView(backBuffer.Get(), nullptr, m_pRenderTargetView.GetAddressOf()));
+	if (m_ResolveMsaa)
+	{
+		// 翻转模型的后备缓冲只能是单采样的：渲染到多重采样纹理，Present 前解析到后备缓冲
+		// 翻转模型下 GetBuffer(0) 始终指向当前要写入的缓冲，保留这一个引用即可
+		D3D11_TEXTURE2D_DESC msaaDesc;
+		backBuffer->GetDesc(&msaaDesc);
+		msaaDesc.SampleDesc.Count = 4;
+		msaaDesc.SampleDesc.Quality = m_4xMsaaQuality - 1;
+		msaaDesc.BindFlags = D3D11_BIND_RENDER_TARGET;
+		msaaDesc.MiscFlags = 0;
+		HR(m_pd3dDevice->CreateTexture2D(&msaaDesc, nullptr, m_pMsaaRenderTarget.GetAddressOf()));
+		HR(m_pd3dDevice->CreateRenderTargetView(m_pMsaaRenderTarget.Get(), nullptr, m_pRenderTargetView.GetAddressOf()));
+		m_pBackBuffer = backBuffer;
+		D3D11SetDebugObjectName(m_pMsaaRenderTarget.Get(), "MsaaRenderTarget");
+	}
+	else
+	{
+		HR(m_pd3dDevice->CreateRenderTargetView(backBuffer.Get(), nullptr, m_pRenderTargetView.GetAddressOf()));
+	}
 	
 	// 设置调试对象名
 	D3D11SetDebugObjectName(backBuffer.Get(), "BackBuffer[0]");
@@ -472,8 +506,25 @@ bool D3DApp::InitDirect3D()
 		fd.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
 		fd.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED;
 		fd.Windowed = TRUE;
+		// 先尝试翻转模型的可等待交换链（需要 DXGI 1.3），用来控制帧延迟
+		// 翻转模型不支持多重采样的后备缓冲：后备缓冲用单采样，开启 4X MSAA 时由 OnResize 另建
+		// 多重采样渲染目标，Present 前解析过去。创建失败时退回原来的交换链
+		DXGI_SWAP_CHAIN_DESC1 flipDesc = sd;
+		flipDesc.SampleDesc.Count = 1;
+		flipDesc.SampleDesc.Quality = 0;
+		flipDesc.BufferCount = 2;
+		flipDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;
+		flipDesc.Flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+		hr = dxgiFactory2->CreateSwapChainForHwnd(m_pd3dDevice.Get(), m_hMainWnd, &flipDesc, &fd, nullptr, m_pSwapChain1.GetAddressOf());
+		if (SUCCEEDED(hr))
+		{
+			m_SwapChainBufferCount = flipDesc.BufferCount;
+			m_SwapChainFlags = flipDesc.Flags;
+			m_ResolveMsaa = m_Enable4xMsaa;
+		}
 		// 为当前窗口创建交换链
-		HR(dxgiFactory2->CreateSwapChainForHwnd(m_pd3dDevice.Get(), m_hMainWnd, &sd, &fd, nullptr, m_pSwapChain1.GetAddressOf()));
+		if (FAILED(hr))
+			HR(dxgiFactory2->CreateSwapChainForHwnd(m_pd3dDevice.Get(), m_hMainWnd, &sd, &fd, nullptr, m_pSwapChain1.GetAddressOf()));
 		HR(m_pSwapChain1.As(&m_pSwapChain));
 	}
 	else
@@ -526,11 +577,11 @@ void D3DApp::CalculateFrameStats()
 {
 	// 该代码计算每秒帧速，并计算每一帧渲染需要的时间，显示在窗口标题
 	static int frameCnt = 0;
-	static float timeElapsed = 0.0f;
+	static double timeElapsed = 0.0;
 
 	frameCnt++;
 
-	if ((m_Timer.TotalTime() - timeElapsed) >= 1.0f)
+	if ((m_Timer.TotalSeconds() - timeElapsed) >= 1.0)
 	{
 		float fps = (float)frameCnt; // fps = frameCnt / 1
 		float mspf = 1000.0f / fps;
@@ -544,7 +595,7 @@ void D3DApp::CalculateFrameStats()
 
 		// Reset for next average.
 		frameCnt = 0;
-		timeElapsed += 1.0f;
+		timeElapsed += 1.0;
 	}
 }
 
@@ -6,6 +6,7 @@
 #include <d3d11_1.h>
 #include <DirectXMath.h>
 #include "GameTimer.h"
+#include "FrameLimiter.h"
 
 // 添加所有要引用的库
 #pragma comment(lib, "d3d11.lib")
@@ -25,6 +26,7 @@ public:
 	float     AspectRatio()const;   // 获取屏幕宽高比
 
 	int Run();                      // 运行程序，进行游戏主循环
+	void SetTargetFrameRate(double fps);      // 帧率上限，fps <= 0 时不限制
 
 	// 框架方法。客户派生类需要重载这些方法以实现特定的应用需求
 	virtual bool Init();                      // 该父类方法需要初始化窗口和Direct3D部分
@@ -52,6 +54,7 @@ protected:
 
 
 	GameTimer m_Timer;           // 计时器
+	FrameLimiter m_FrameLimiter; // 帧率限制，每帧结束时等到下一帧的目标时刻
 
 	// 使用模板别名(C++11)简化类型名
 	template <class T>
@@ -64,7 +67,12 @@ protected:
 	ComPtr<ID3D11Device1>          m_pd3dDevice1;                        // D3D11.1设备
 	ComPtr<ID3D11DeviceContext1>   m_pd3dImmediateContext1;              // D3D11.1设备上下文
 	ComPtr<IDXGISwapChain1>        m_pSwapChain1;                        // D3D11.1交换链
+	UINT                           m_SwapChainBufferCount;               // 交换链缓冲区数，ResizeBuffers 时保持不变
+	UINT                           m_SwapChainFlags;                     // 交换链创建标志，ResizeBuffers 时保持不变
+	bool                           m_ResolveMsaa;                        // 翻转模型交换链 + 4X MSAA：先画到多重采样纹理，Present 前解析到后备缓冲
 	// 常用资源
+	ComPtr<ID3D11Texture2D>        m_pBackBuffer;                        // 解析目标（仅 m_ResolveMsaa 时持有）
+	ComPtr<ID3D11Texture2D>        m_pMsaaRenderTarget;                  // 多重采样渲染目标（仅 m_ResolveMsaa 时创建）
 	ComPtr<ID3D11Texture2D>        m_pDepthStencilBuffer;                // 深度模板缓冲区
 	ComPtr<ID3D11RenderTargetView> m_pRenderTargetView;                  // 渲染目标视图
 	ComPtr<ID3D11DepthStencilView> m_pDepthStencilView;                  // 深度模板视图
@@ -1,5 +1,52 @@
 #include "d3dUtil.h"
 
+namespace
+{
+	// 取文件的最后修改时间，文件不存在时返回 false
+	bool GetFileWriteTime(const WCHAR* fileName, ULARGE_INTEGER& writeTime)
+	{
+		WIN32_FILE_ATTRIBUTE_DATA data;
+		if (!GetFileAttributesExW(fileName, GetFileExInfoStandard, &data))
+			return false;
+		writeTime.LowPart = data.ftLastWriteTime.dwLowDateTime;
+		writeTime.HighPart = data.ftLastWriteTime.dwHighDateTime;
+		return true;
+	}
+
+	// ==== 着色器缓存：.hlsl 或同目录下的 .hlsli 比 .cso 新时缓存失效，需要重新编译 ====
+	bool IsShaderCacheValid(const WCHAR* csoFileName, const WCHAR* hlslFileName)
+	{
+		ULARGE_INTEGER csoTime, sourceTime;
+		if (!GetFileWriteTime(csoFileName, csoTime))
+			return false;
+		// 找不到源文件时只能使用缓存
+		if (!hlslFileName || !GetFileWriteTime(hlslFileName, sourceTime))
+			return true;
+		if (sourceTime.QuadPart > csoTime.QuadPart)
+			return false;
+
+		// 头文件的包含关系不做解析，同目录下任何 .hlsli 更新都重新编译
+		std::wstring directory(hlslFileName);
+		size_t slash = directory.find_last_of(L"\\/");
+		directory = slash == std::wstring::npos ? std::wstring() : directory.substr(0, slash + 1);
+		WIN32_FIND_DATAW findData;
+		HANDLE hFind = FindFirstFileW((directory + L"*.hlsli").c_str(), &findData);
+		if (hFind == INVALID_HANDLE_VALUE)
+			return true;
+		bool valid = true;
+		do
+		{
+			ULARGE_INTEGER includeTime;
+			includeTime.LowPart = findData.ftLastWriteTime.dwLowDateTime;
+			includeTime.HighPart = findData.ftLastWriteTime.dwHighDateTime;
+			if (includeTime.QuadPart > csoTime.QuadPart)
+				valid = false;
+		} while (valid && FindNextFileW(hFind, &findData));
+		FindClose(hFind);
+		return valid;
+	}
+}
+
 
 HRESULT CreateShaderFromFile(
 	const WCHAR* csoFileNameInOut,
@@ -10,8 +57,9 @@ HRESULT CreateShaderFromFile(
 {
 	HRESULT hr = S_OK;
 
-	// 寻找是否有已经编译好的顶点着色器
-	if (csoFileNameInOut && D3DReadFileToBlob(csoFileNameInOut, ppBlobOut) == S_OK)
+	// 寻找是否有已经编译好的顶点着色器，源文件更新过时重新编译
+	if (csoFileNameInOut && IsShaderCacheValid(csoFileNameInOut, hlslFileName) &&
+		D3DReadFileToBlob(csoFileNameInOut, ppBlobOut) == S_OK)
 	{
 		return hr;
 	}
@@ -39,10 +87,10 @@ HRESULT CreateShaderFromFile(
 			return hr;
 		}
 
-		// 若指定了输出文件名，则将着色器二进制信息输出
+		// 若指定了输出文件名，则将着色器二进制信息输出（覆盖过期的缓存）
 		if (csoFileNameInOut)
 		{
-			return D3DWriteBlobToFile(*ppBlobOut, csoFileNameInOut, FALSE);
+			return D3DWriteBlobToFile(*ppBlobOut, csoFileNameInOut, TRUE);
 		}
 	}
 
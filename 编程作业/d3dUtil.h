@@ -77,6 +77,7 @@ inline void DXGISetDebugObjectName(_In_ IDXGIObject* resource, _In_ const char(&
 // CreateShaderFromFile函数
 // ------------------------------
 // [In]csoFileNameInOut 编译好的着色器二进制文件(.cso)，若有指定则优先寻找该文件并读取
+//                      .hlsl 或同目录的 .hlsli 比它新时视为过期，重新编译并覆盖
 // [In]hlslFileName     着色器代码，若未找到着色器二进制文件则编译着色器代码
 // [In]entryPoint       入口点(指定开始的函数)
 // [In]shaderModel      着色器模型，格式为"*s_5_0"，*可以为c,d,g,h,p,v之一